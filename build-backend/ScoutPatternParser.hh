@@ -1,21 +1,22 @@
-/* A Bison parser, made by GNU Bison 2.5.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2011 Free Software Foundation, Inc.
-   
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -26,43 +27,64 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_SCOUTPATTERNPARSER_HH_INCLUDED
+# define YY_YY_SCOUTPATTERNPARSER_HH_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
 
-/* Tokens.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     STRING = 258,
-     TEXT = 259,
-     CALLBACKS = 260,
-     CLASS = 261,
-     CLEANUP = 262,
-     CONDITION = 263,
-     DATA = 264,
-     DESCR = 265,
-     DOCNAME = 266,
-     DIAGNOSIS = 267,
-     HIDDEN = 268,
-     INCLUDE = 269,
-     INFO = 270,
-     INIT = 271,
-     MODE = 272,
-     NAME = 273,
-     NODOCS = 274,
-     PARENT = 275,
-     PATTERN = 276,
-     PROLOG = 277,
-     STATICINIT = 278,
-     TYPE = 279,
-     UNIT = 280
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    STRING = 258,                  /* STRING  */
+    TEXT = 259,                    /* TEXT  */
+    CALLBACKS = 260,               /* CALLBACKS  */
+    CLASS = 261,                   /* CLASS  */
+    CLEANUP = 262,                 /* CLEANUP  */
+    CONDITION = 263,               /* CONDITION  */
+    DATA = 264,                    /* DATA  */
+    DESCR = 265,                   /* DESCR  */
+    DOCNAME = 266,                 /* DOCNAME  */
+    DIAGNOSIS = 267,               /* DIAGNOSIS  */
+    HIDDEN = 268,                  /* HIDDEN  */
+    INCLUDE = 269,                 /* INCLUDE  */
+    INFO = 270,                    /* INFO  */
+    INIT = 271,                    /* INIT  */
+    MODE = 272,                    /* MODE  */
+    NAME = 273,                    /* NAME  */
+    NODOCS = 274,                  /* NODOCS  */
+    PARENT = 275,                  /* PARENT  */
+    PATTERN = 276,                 /* PATTERN  */
+    PROLOG = 277,                  /* PROLOG  */
+    STATICINIT = 278,              /* STATICINIT  */
+    TYPE = 279,                    /* TYPE  */
+    UNIT = 280                     /* UNIT  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
 #define STRING 258
 #define TEXT 259
 #define CALLBACKS 260
@@ -87,16 +109,18 @@
 #define TYPE 279
 #define UNIT 280
 
-
-
-
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 typedef int YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
+
 extern YYSTYPE yylval;
 
 
+int yyparse (void);
+
+
+#endif /* !YY_YY_SCOUTPATTERNPARSER_HH_INCLUDED  */
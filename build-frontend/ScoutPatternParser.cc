@@ -1,21 +1,22 @@
-/* A Bison parser, made by GNU Bison 2.5.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2011 Free Software Foundation, Inc.
-   
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -26,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.5"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -58,14 +63,10 @@
 /* Pull parsers.  */
 #define YYPULL 1
 
-/* Using locations.  */
-#define YYLSP_NEEDED 0
 
 
 
-/* Copy the first part of user declarations.  */
-
-/* Line 268 of yacc.c  */
+/* First part of user prologue.  */
 #line 1 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
 
 /****************************************************************************
@@ -91,6 +92,7 @@
 #include <cctype>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <functional>
 #include <map>
 #include <string>
@@ -139,6 +141,8 @@ int    incLine;
 string prolog;
 string prefix("Patterns_gen");
 
+backend_t backend = BACKEND_CALLBACK;
+
 map<string,Pattern*> id2pattern;    // pattern id |-> pattern
 vector<Pattern*>     pattern;       // pattern list
 Pattern*             current;       // current pattern
@@ -150,6 +154,11 @@ int main(int argc, char** argv);
 
 void write_header();
 void write_impl();
+void write_fused_kernels(FILE* fp);
+vector<string> fused_groups();
+string fused_classname(const string& group);
+void fused_guards(const string& group, string& begin, string& end);
+void pattern_guards(const string& type, const char*& begin, const char*& end);
 void write_html();
 
 string uppercase(const string& str);
@@ -161,61 +170,81 @@ extern void include_file(const string& filename);
 
 
 
+#line 174 "ScoutPatternParser.cc"
 
-/* Line 268 of yacc.c  */
-#line 167 "ScoutPatternParser.cc"
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
 
-/* Enabling traces.  */
+/* Use api.header.include to #include this header
+   instead of duplicating it here.  */
+#ifndef YY_YY_SCOUTPATTERNPARSER_HH_INCLUDED
+# define YY_YY_SCOUTPATTERNPARSER_HH_INCLUDED
+/* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 0
 #endif
-
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
+#if YYDEBUG
+extern int yydebug;
 #endif
 
-
-/* Tokens.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     STRING = 258,
-     TEXT = 259,
-     CALLBACKS = 260,
-     CLASS = 261,
-     CLEANUP = 262,
-     CONDITION = 263,
-     DATA = 264,
-     DESCR = 265,
-     DOCNAME = 266,
-     DIAGNOSIS = 267,
-     HIDDEN = 268,
-     INCLUDE = 269,
-     INFO = 270,
-     INIT = 271,
-     MODE = 272,
-     NAME = 273,
-     NODOCS = 274,
-     PARENT = 275,
-     PATTERN = 276,
-     PROLOG = 277,
-     STATICINIT = 278,
-     TYPE = 279,
-     UNIT = 280
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    STRING = 258,                  /* STRING  */
+    TEXT = 259,                    /* TEXT  */
+    CALLBACKS = 260,               /* CALLBACKS  */
+    CLASS = 261,                   /* CLASS  */
+    CLEANUP = 262,                 /* CLEANUP  */
+    CONDITION = 263,               /* CONDITION  */
+    DATA = 264,                    /* DATA  */
+    DESCR = 265,                   /* DESCR  */
+    DOCNAME = 266,                 /* DOCNAME  */
+    DIAGNOSIS = 267,               /* DIAGNOSIS  */
+    HIDDEN = 268,                  /* HIDDEN  */
+    INCLUDE = 269,                 /* INCLUDE  */
+    INFO = 270,                    /* INFO  */
+    INIT = 271,                    /* INIT  */
+    MODE = 272,                    /* MODE  */
+    NAME = 273,                    /* NAME  */
+    NODOCS = 274,                  /* NODOCS  */
+    PARENT = 275,                  /* PARENT  */
+    PATTERN = 276,                 /* PATTERN  */
+    PROLOG = 277,                  /* PROLOG  */
+    STATICINIT = 278,              /* STATICINIT  */
+    TYPE = 279,                    /* TYPE  */
+    UNIT = 280                     /* UNIT  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
 #define STRING 258
 #define TEXT 259
 #define CALLBACKS 260
@@ -240,52 +269,187 @@ extern void include_file(const string& filename);
 #define TYPE 279
 #define UNIT 280
 
-
-
-
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 typedef int YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
 
-/* Copy the second part of user declarations.  */
+extern YYSTYPE yylval;
+
+
+int yyparse (void);
+
+
+#endif /* !YY_YY_SCOUTPATTERNPARSER_HH_INCLUDED  */
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_STRING = 3,                     /* STRING  */
+  YYSYMBOL_TEXT = 4,                       /* TEXT  */
+  YYSYMBOL_CALLBACKS = 5,                  /* CALLBACKS  */
+  YYSYMBOL_CLASS = 6,                      /* CLASS  */
+  YYSYMBOL_CLEANUP = 7,                    /* CLEANUP  */
+  YYSYMBOL_CONDITION = 8,                  /* CONDITION  */
+  YYSYMBOL_DATA = 9,                       /* DATA  */
+  YYSYMBOL_DESCR = 10,                     /* DESCR  */
+  YYSYMBOL_DOCNAME = 11,                   /* DOCNAME  */
+  YYSYMBOL_DIAGNOSIS = 12,                 /* DIAGNOSIS  */
+  YYSYMBOL_HIDDEN = 13,                    /* HIDDEN  */
+  YYSYMBOL_INCLUDE = 14,                   /* INCLUDE  */
+  YYSYMBOL_INFO = 15,                      /* INFO  */
+  YYSYMBOL_INIT = 16,                      /* INIT  */
+  YYSYMBOL_MODE = 17,                      /* MODE  */
+  YYSYMBOL_NAME = 18,                      /* NAME  */
+  YYSYMBOL_NODOCS = 19,                    /* NODOCS  */
+  YYSYMBOL_PARENT = 20,                    /* PARENT  */
+  YYSYMBOL_PATTERN = 21,                   /* PATTERN  */
+  YYSYMBOL_PROLOG = 22,                    /* PROLOG  */
+  YYSYMBOL_STATICINIT = 23,                /* STATICINIT  */
+  YYSYMBOL_TYPE = 24,                      /* TYPE  */
+  YYSYMBOL_UNIT = 25,                      /* UNIT  */
+  YYSYMBOL_26_ = 26,                       /* '='  */
+  YYSYMBOL_27_ = 27,                       /* '['  */
+  YYSYMBOL_28_ = 28,                       /* ']'  */
+  YYSYMBOL_29_ = 29,                       /* '('  */
+  YYSYMBOL_30_ = 30,                       /* ')'  */
+  YYSYMBOL_31_ = 31,                       /* '"'  */
+  YYSYMBOL_32_ = 32,                       /* '{'  */
+  YYSYMBOL_33_ = 33,                       /* '}'  */
+  YYSYMBOL_YYACCEPT = 34,                  /* $accept  */
+  YYSYMBOL_File = 35,                      /* File  */
+  YYSYMBOL_Body = 36,                      /* Body  */
+  YYSYMBOL_BodyItem = 37,                  /* BodyItem  */
+  YYSYMBOL_Include = 38,                   /* Include  */
+  YYSYMBOL_Prolog = 39,                    /* Prolog  */
+  YYSYMBOL_Pattern = 40,                   /* Pattern  */
+  YYSYMBOL_41_1 = 41,                      /* $@1  */
+  YYSYMBOL_PatternDef = 42,                /* PatternDef  */
+  YYSYMBOL_DefItem = 43,                   /* DefItem  */
+  YYSYMBOL_Name = 44,                      /* Name  */
+  YYSYMBOL_Classname = 45,                 /* Classname  */
+  YYSYMBOL_Docname = 46,                   /* Docname  */
+  YYSYMBOL_Parent = 47,                    /* Parent  */
+  YYSYMBOL_Type = 48,                      /* Type  */
+  YYSYMBOL_Hidden = 49,                    /* Hidden  */
+  YYSYMBOL_NoDocs = 50,                    /* NoDocs  */
+  YYSYMBOL_Info = 51,                      /* Info  */
+  YYSYMBOL_Description = 52,               /* Description  */
+  YYSYMBOL_Diagnosis = 53,                 /* Diagnosis  */
+  YYSYMBOL_Unit = 54,                      /* Unit  */
+  YYSYMBOL_Mode = 55,                      /* Mode  */
+  YYSYMBOL_Condition = 56,                 /* Condition  */
+  YYSYMBOL_Init = 57,                      /* Init  */
+  YYSYMBOL_StaticInit = 58,                /* StaticInit  */
+  YYSYMBOL_Cleanup = 59,                   /* Cleanup  */
+  YYSYMBOL_Data = 60,                      /* Data  */
+  YYSYMBOL_Callbacks = 61,                 /* Callbacks  */
+  YYSYMBOL_62_2 = 62,                      /* $@2  */
+  YYSYMBOL_63_3 = 63,                      /* $@3  */
+  YYSYMBOL_CbList = 64,                    /* CbList  */
+  YYSYMBOL_CbItem = 65,                    /* CbItem  */
+  YYSYMBOL_String = 66,                    /* String  */
+  YYSYMBOL_CodeBlock = 67,                 /* CodeBlock  */
+  YYSYMBOL_68_4 = 68,                      /* @4  */
+  YYSYMBOL_TextBlock = 69,                 /* TextBlock  */
+  YYSYMBOL_Text = 70                       /* Text  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
 
 
-/* Line 343 of yacc.c  */
-#line 259 "ScoutPatternParser.cc"
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
 typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef short int yytype_int8;
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -293,55 +457,106 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(e) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int yyi)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (yyi)
-    int yyi;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return yyi;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
 #endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -358,9 +573,9 @@ YYID (yyi)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
 #     ifndef EXIT_SUCCESS
 #      define EXIT_SUCCESS 0
 #     endif
@@ -370,8 +585,8 @@ YYID (yyi)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -387,7 +602,7 @@ YYID (yyi)
 #  endif
 #  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
 #   ifndef EXIT_SUCCESS
 #    define EXIT_SUCCESS 0
@@ -395,40 +610,37 @@ YYID (yyi)
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined EXIT_SUCCESS && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -438,35 +650,35 @@ union yyalloc
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack_alloc, Stack)				\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack_alloc, Stack, yysize);			\
-	Stack = &yyptr->Stack_alloc;					\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
 #if defined YYCOPY_NEEDED && YYCOPY_NEEDED
-/* Copy COUNT objects from FROM to TO.  The source and destination do
+/* Copy COUNT objects from SRC to DST.  The source and destination do
    not overlap.  */
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
 #  endif
 # endif
 #endif /* !YYCOPY_NEEDED */
@@ -482,18 +694,23 @@ union yyalloc
 #define YYNNTS  37
 /* YYNRULES -- Number of rules.  */
 #define YYNRULES  61
-/* YYNRULES -- Number of states.  */
+/* YYNSTATES -- Number of states.  */
 #define YYNSTATES  118
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   280
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -527,142 +744,63 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint8 yyprhs[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,     0,     3,     5,     7,    10,    12,    14,    16,    19,
-      22,    23,    31,    34,    36,    38,    40,    42,    44,    46,
-      48,    50,    52,    54,    56,    58,    60,    62,    64,    66,
-      68,    70,    72,    76,    80,    84,    88,    92,    94,    96,
-     100,   104,   108,   112,   116,   120,   124,   128,   132,   136,
-     137,   147,   148,   155,   158,   160,   164,   168,   169,   174,
-     178,   181
+       0,   113,   113,   117,   118,   122,   123,   124,   128,   135,
+     143,   142,   180,   181,   185,   186,   187,   188,   189,   190,
+     191,   192,   193,   194,   195,   196,   197,   198,   199,   200,
+     201,   202,   206,   216,   226,   233,   250,   265,   272,   279,
+     289,   299,   309,   319,   331,   341,   351,   361,   371,   382,
+     381,   387,   386,   394,   395,   399,   406,   414,   413,   429,
+     436,   440
 };
+#endif
 
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      35,     0,    -1,    36,    -1,    37,    -1,    36,    37,    -1,
-      38,    -1,    40,    -1,    39,    -1,    14,    66,    -1,    22,
-      67,    -1,    -1,    21,    66,    41,    26,    27,    42,    28,
-      -1,    42,    43,    -1,    43,    -1,    44,    -1,    45,    -1,
-      46,    -1,    47,    -1,    48,    -1,    49,    -1,    50,    -1,
-      51,    -1,    52,    -1,    53,    -1,    54,    -1,    55,    -1,
-      56,    -1,    57,    -1,    58,    -1,    59,    -1,    60,    -1,
-      61,    -1,    18,    26,    66,    -1,     6,    26,    66,    -1,
-      11,    26,    66,    -1,    20,    26,    66,    -1,    24,    26,
-      66,    -1,    13,    -1,    19,    -1,    15,    26,    66,    -1,
-      10,    26,    69,    -1,    12,    26,    69,    -1,    25,    26,
-      66,    -1,    17,    26,    66,    -1,     8,    26,    66,    -1,
-      16,    26,    67,    -1,    23,    26,    67,    -1,     7,    26,
-      67,    -1,     9,    26,    67,    -1,    -1,     5,    29,    66,
-      30,    62,    26,    27,    64,    28,    -1,    -1,     5,    63,
-      26,    27,    64,    28,    -1,    64,    65,    -1,    65,    -1,
-      66,    26,    67,    -1,    31,     3,    31,    -1,    -1,    32,
-      68,    70,    33,    -1,    32,    70,    33,    -1,    70,     4,
-      -1,     4,    -1
-};
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
 
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
-{
-       0,   105,   105,   109,   110,   114,   115,   116,   120,   127,
-     135,   134,   172,   173,   177,   178,   179,   180,   181,   182,
-     183,   184,   185,   186,   187,   188,   189,   190,   191,   192,
-     193,   194,   198,   208,   218,   225,   242,   257,   264,   271,
-     281,   291,   301,   311,   323,   333,   343,   353,   363,   374,
-     373,   379,   378,   386,   387,   391,   398,   406,   405,   421,
-     428,   432
-};
-#endif
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "STRING", "TEXT", "CALLBACKS", "CLASS",
-  "CLEANUP", "CONDITION", "DATA", "DESCR", "DOCNAME", "DIAGNOSIS",
-  "HIDDEN", "INCLUDE", "INFO", "INIT", "MODE", "NAME", "NODOCS", "PARENT",
-  "PATTERN", "PROLOG", "STATICINIT", "TYPE", "UNIT", "'='", "'['", "']'",
-  "'('", "')'", "'\"'", "'{'", "'}'", "$accept", "File", "Body",
-  "BodyItem", "Include", "Prolog", "Pattern", "$@1", "PatternDef",
-  "DefItem", "Name", "Classname", "Docname", "Parent", "Type", "Hidden",
-  "NoDocs", "Info", "Description", "Diagnosis", "Unit", "Mode",
-  "Condition", "Init", "StaticInit", "Cleanup", "Data", "Callbacks", "$@2",
-  "$@3", "CbList", "CbItem", "String", "CodeBlock", "@4", "TextBlock",
-  "Text", 0
+  "\"end of file\"", "error", "\"invalid token\"", "STRING", "TEXT",
+  "CALLBACKS", "CLASS", "CLEANUP", "CONDITION", "DATA", "DESCR", "DOCNAME",
+  "DIAGNOSIS", "HIDDEN", "INCLUDE", "INFO", "INIT", "MODE", "NAME",
+  "NODOCS", "PARENT", "PATTERN", "PROLOG", "STATICINIT", "TYPE", "UNIT",
+  "'='", "'['", "']'", "'('", "')'", "'\"'", "'{'", "'}'", "$accept",
+  "File", "Body", "BodyItem", "Include", "Prolog", "Pattern", "$@1",
+  "PatternDef", "DefItem", "Name", "Classname", "Docname", "Parent",
+  "Type", "Hidden", "NoDocs", "Info", "Description", "Diagnosis", "Unit",
+  "Mode", "Condition", "Init", "StaticInit", "Cleanup", "Data",
+  "Callbacks", "$@2", "$@3", "CbList", "CbItem", "String", "CodeBlock",
+  "@4", "TextBlock", "Text", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,    61,    91,    93,    40,
-      41,    34,   123,   125
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,    34,    35,    36,    36,    37,    37,    37,    38,    39,
-      41,    40,    42,    42,    43,    43,    43,    43,    43,    43,
-      43,    43,    43,    43,    43,    43,    43,    43,    43,    43,
-      43,    43,    44,    45,    46,    47,    48,    49,    50,    51,
-      52,    53,    54,    55,    56,    57,    58,    59,    60,    62,
-      61,    63,    61,    64,    64,    65,    66,    68,    67,    69,
-      70,    70
-};
+#define YYPACT_NINF (-100)
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
-{
-       0,     2,     1,     1,     2,     1,     1,     1,     2,     2,
-       0,     7,     2,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     3,     3,     3,     3,     3,     1,     1,     3,
-       3,     3,     3,     3,     3,     3,     3,     3,     3,     0,
-       9,     0,     6,     2,     1,     3,     3,     0,     4,     3,
-       2,     1
-};
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-/* YYDEFACT[STATE-NAME] -- Default reduction number in state STATE-NUM.
-   Performed when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const yytype_uint8 yydefact[] =
-{
-       0,     0,     0,     0,     0,     2,     3,     5,     7,     6,
-       0,     8,    10,    57,     9,     1,     4,     0,     0,     0,
-      56,     0,    61,     0,     0,    60,    58,    51,     0,     0,
-       0,     0,     0,     0,     0,    37,     0,     0,     0,     0,
-      38,     0,     0,     0,     0,     0,    13,    14,    15,    16,
-      17,    18,    19,    20,    21,    22,    23,    24,    25,    26,
-      27,    28,    29,    30,    31,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,    11,    12,     0,     0,    33,    47,    44,    48,
-       0,    40,    34,    41,    39,    45,    43,    32,    35,    46,
-      36,    42,    49,     0,     0,     0,     0,    54,     0,    59,
-       0,    52,    53,     0,     0,    55,     0,    50
-};
+#define YYTABLE_NINF (-1)
 
-/* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int8 yydefgoto[] =
-{
-      -1,     4,     5,     6,     7,     8,     9,    18,    45,    46,
-      47,    48,    49,    50,    51,    52,    53,    54,    55,    56,
-      57,    58,    59,    60,    61,    62,    63,    64,   105,    66,
-     106,   107,   108,    14,    19,    91,    23
-};
+#define yytable_value_is_error(Yyn) \
+  0
 
 /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
    STATE-NUM.  */
-#define YYPACT_NINF -100
 static const yytype_int8 yypact[] =
 {
      -11,   -23,   -23,   -18,    16,   -11,  -100,  -100,  -100,  -100,
@@ -679,6 +817,25 @@ static const yytype_int8 yypact[] =
       51,  -100,  -100,   -18,   -23,  -100,    11,  -100
 };
 
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       0,     0,     0,     0,     0,     2,     3,     5,     7,     6,
+       0,     8,    10,    57,     9,     1,     4,     0,     0,     0,
+      56,     0,    61,     0,     0,    60,    58,    51,     0,     0,
+       0,     0,     0,     0,     0,    37,     0,     0,     0,     0,
+      38,     0,     0,     0,     0,     0,    13,    14,    15,    16,
+      17,    18,    19,    20,    21,    22,    23,    24,    25,    26,
+      27,    28,    29,    30,    31,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    11,    12,     0,     0,    33,    47,    44,    48,
+       0,    40,    34,    41,    39,    45,    43,    32,    35,    46,
+      36,    42,    49,     0,     0,     0,     0,    54,     0,    59,
+       0,    52,    53,     0,     0,    55,     0,    50
+};
+
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
@@ -688,11 +845,19 @@ static const yytype_int8 yypgoto[] =
      -24,   -99,    -1,   -66,  -100,    44,     8
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int8 yydefgoto[] =
+{
+       0,     4,     5,     6,     7,     8,     9,    18,    45,    46,
+      47,    48,    49,    50,    51,    52,    53,    54,    55,    56,
+      57,    58,    59,    60,    61,    62,    63,    64,   105,    66,
+     106,   107,   108,    14,    19,    91,    23
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -1
-static const yytype_uint8 yytable[] =
+static const yytype_int8 yytable[] =
 {
       11,    12,    87,     1,    89,    25,    25,   112,    10,    95,
        2,     3,   111,    99,    13,    10,    15,   112,    27,    28,
@@ -708,12 +873,6 @@ static const yytype_uint8 yytable[] =
        0,     0,     0,     0,     0,     0,     0,    93
 };
 
-#define yypact_value_is_default(yystate) \
-  ((yystate) == (-100))
-
-#define yytable_value_is_error(yytable_value) \
-  YYID (0)
-
 static const yytype_int8 yycheck[] =
 {
        1,     2,    68,    14,    70,     4,     4,   106,    31,    75,
@@ -730,9 +889,9 @@ static const yytype_int8 yycheck[] =
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    73
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,    14,    21,    22,    35,    36,    37,    38,    39,    40,
       31,    66,    66,    32,    67,     0,    37,     3,    41,    68,
@@ -748,94 +907,65 @@ static const yytype_uint8 yystos[] =
       26,    28,    65,    26,    27,    67,    64,    28
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
-
-
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  However,
-   YYFAIL appears to be in use.  Nevertheless, it is formally deprecated
-   in Bison 2.4.2's NEWS entry, where a plan to phase it out is
-   discussed.  */
-
-#define YYFAIL		goto yyerrlab
-#if defined YYFAIL
-  /* This is here to suppress warnings from the GCC cpp's
-     -Wunused-macros.  Normally we don't worry about that warning, but
-     some users do, and we want to make it easy for users to remove
-     YYFAIL uses, which will produce warnings from Bison 2.5.  */
-#endif
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    34,    35,    36,    36,    37,    37,    37,    38,    39,
+      41,    40,    42,    42,    43,    43,    43,    43,    43,    43,
+      43,    43,    43,    43,    43,    43,    43,    43,    43,    43,
+      43,    43,    44,    45,    46,    47,    48,    49,    50,    51,
+      52,    53,    54,    55,    56,    57,    58,    59,    60,    62,
+      61,    63,    61,    64,    64,    65,    66,    68,    67,    69,
+      70,    70
+};
 
-#define YYRECOVERING()  (!!yyerrstatus)
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     1,     2,     1,     1,     1,     2,     2,
+       0,     7,     2,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     3,     3,     3,     3,     3,     1,     1,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     3,     0,
+       9,     0,     6,     2,     1,     3,     3,     0,     4,     3,
+       2,     1
+};
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
-   If N is 0, then set CURRENT to the empty location which ends
-   the previous symbol: RHS[0] (always defined).  */
-
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
-#ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
-#endif
 
+enum { YYENOMEM = -2 };
 
-/* This macro is provided for backward compatibility. */
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
+#define YYRECOVERING()  (!!yyerrstatus)
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -845,80 +975,58 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
-static void
-yy_symbol_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -926,16 +1034,8 @@ yy_symbol_print (yyoutput, yytype, yyvaluep)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
-#else
-static void
-yy_stack_print (yybottom, yytop)
-    yytype_int16 *yybottom;
-    yytype_int16 *yytop;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -946,63 +1046,56 @@ yy_stack_print (yybottom, yytop)
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_reduce_print (YYSTYPE *yyvsp, int yyrule)
-#else
-static void
-yy_reduce_print (yyvsp, yyrule)
-    YYSTYPE *yyvsp;
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       );
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
       YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -1018,365 +1111,77 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
 
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
 
-  if (! yyres)
-    return yystrlen (yystr);
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
-
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (0, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  YYSIZE_T yysize1;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = 0;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - Assume YYFAIL is not used.  It's too flawed to consider.  See
-       <http://lists.gnu.org/archive/html/bison-patches/2009-12/msg00024.html>
-       for details.  YYERROR is fine as it does not invoke this
-       function.
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-                if (! (yysize <= yysize1
-                       && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                  return 2;
-                yysize = yysize1;
-              }
-        }
-    }
-
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
-
-  yysize1 = yysize + yystrlen (yyformat);
-  if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-    return 2;
-  yysize = yysize1;
-
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
-
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
-#else
-static void
-yydestruct (yymsg, yytype, yyvaluep)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
 {
-  YYUSE (yyvaluep);
-
+  YY_USE (yyvaluep);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-  switch (yytype)
-    {
-
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/* Prevent warnings from -Wmissing-prototypes.  */
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
-
-
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 /* The semantic value of the lookahead symbol.  */
 YYSTYPE yylval;
-
 /* Number of syntax errors so far.  */
 int yynerrs;
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 int
 yyparse (void)
-#else
-int
-yyparse ()
-
-#endif
-#endif
 {
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
-
-    /* The stacks and their tools:
-       `yyss': related to states.
-       `yyvs': related to semantic values.
+    int yyerrstatus = 0;
 
-       Refer to the stacks thru separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1384,111 +1189,107 @@ yyparse ()
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yytoken = 0;
-  yyss = yyssa;
-  yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
 
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-  yyssp = yyss;
-  yyvsp = yyvs;
-
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss_alloc, yyss);
-	YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1499,18 +1300,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1538,13 +1350,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1559,14 +1371,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1579,43 +1391,38 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 8:
-
-/* Line 1806 of yacc.c  */
-#line 121 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
-                    include_file((yyvsp[(2) - (2)]));
+  case 8: /* Include: INCLUDE String  */
+#line 129 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
+                    include_file(yyvsp[0]);
                   }
+#line 1400 "ScoutPatternParser.cc"
     break;
 
-  case 9:
-
-/* Line 1806 of yacc.c  */
-#line 128 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
-                    prolog += (yyvsp[(2) - (2)]);
+  case 9: /* Prolog: PROLOG CodeBlock  */
+#line 136 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
+                    prolog += yyvsp[0];
                   }
+#line 1408 "ScoutPatternParser.cc"
     break;
 
-  case 10:
-
-/* Line 1806 of yacc.c  */
-#line 135 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
-                    if (id2pattern.find((yyvsp[(2) - (2)])) != id2pattern.end())
-                      yyerror("Pattern \"" + (yyvsp[(2) - (2)]) + "\" already defined!");
+  case 10: /* $@1: %empty  */
+#line 143 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
+                    if (id2pattern.find(yyvsp[0]) != id2pattern.end())
+                      yyerror("Pattern \"" + yyvsp[0] + "\" already defined!");
 
-                    current = new Pattern((yyvsp[(2) - (2)]));
+                    current = new Pattern(yyvsp[0]);
                     pattern.push_back(current);
-                    id2pattern.insert(make_pair((yyvsp[(2) - (2)]), current));
+                    id2pattern.insert(make_pair(yyvsp[0], current));
                   }
+#line 1421 "ScoutPatternParser.cc"
     break;
 
-  case 11:
-
-/* Line 1806 of yacc.c  */
-#line 144 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 11: /* Pattern: PATTERN String $@1 '=' '[' PatternDef ']'  */
+#line 152 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     bool error = true;
                     string msg = "Incomplete pattern definition!\n";
                     switch(current->is_valid()) {
@@ -1641,309 +1448,283 @@ yyreduce:
                     if (error)
                       yyerror(msg);
                   }
+#line 1452 "ScoutPatternParser.cc"
     break;
 
-  case 32:
-
-/* Line 1806 of yacc.c  */
-#line 199 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 32: /* Name: NAME '=' String  */
+#line 207 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     if (!current->get_name().empty())
                       yyerror("Only one NAME definition allowed!");
 
-                    current->set_name((yyvsp[(3) - (3)]));
+                    current->set_name(yyvsp[0]);
                   }
+#line 1463 "ScoutPatternParser.cc"
     break;
 
-  case 33:
-
-/* Line 1806 of yacc.c  */
-#line 209 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 33: /* Classname: CLASS '=' String  */
+#line 217 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     if (!current->get_classname().empty())
                       yyerror("Only one CLASS definition allowed!");
 
-                    current->set_classname((yyvsp[(3) - (3)]));
+                    current->set_classname(yyvsp[0]);
                   }
+#line 1474 "ScoutPatternParser.cc"
     break;
 
-  case 34:
-
-/* Line 1806 of yacc.c  */
-#line 219 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
-                    current->set_docname((yyvsp[(3) - (3)]));
+  case 34: /* Docname: DOCNAME '=' String  */
+#line 227 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
+                    current->set_docname(yyvsp[0]);
                   }
+#line 1482 "ScoutPatternParser.cc"
     break;
 
-  case 35:
-
-/* Line 1806 of yacc.c  */
-#line 226 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 35: /* Parent: PARENT '=' String  */
+#line 234 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     if (current->get_parent() != "NONE")
                       yyerror("Only one PARENT definition allowed!");
 
 
-                    map<string,Pattern*>::iterator it = id2pattern.find((yyvsp[(3) - (3)]));
+                    map<string,Pattern*>::iterator it = id2pattern.find(yyvsp[0]);
                     if (it == id2pattern.end())
-                      yyerror("Unknown pattern \"" + (yyvsp[(3) - (3)]) + "\"!");
+                      yyerror("Unknown pattern \"" + yyvsp[0] + "\"!");
                     if (it->second == current)
                       yyerror("A pattern cannot be its own parent!");
 
-                    current->set_parent((yyvsp[(3) - (3)]));
+                    current->set_parent(yyvsp[0]);
                   }
+#line 1500 "ScoutPatternParser.cc"
     break;
 
-  case 36:
-
-/* Line 1806 of yacc.c  */
-#line 243 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
-                    if ((yyvsp[(3) - (3)]) != "MPI" &&
-                        (yyvsp[(3) - (3)]) != "MPIDEP" &&
-                        (yyvsp[(3) - (3)]) != "MPI_RMA" &&
-                        (yyvsp[(3) - (3)]) != "OMP" &&
-                        (yyvsp[(3) - (3)]) != "OMPDEP" &&
-                        (yyvsp[(3) - (3)]) != "Generic")
-                      yyerror("Unknown pattern type \"" + (yyvsp[(3) - (3)]) + "\"");
-
-                    current->set_type((yyvsp[(3) - (3)]));
+  case 36: /* Type: TYPE '=' String  */
+#line 251 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
+                    if (yyvsp[0] != "MPI" &&
+                        yyvsp[0] != "MPIDEP" &&
+                        yyvsp[0] != "MPI_RMA" &&
+                        yyvsp[0] != "OMP" &&
+                        yyvsp[0] != "OMPDEP" &&
+                        yyvsp[0] != "Generic")
+                      yyerror("Unknown pattern type \"" + yyvsp[0] + "\"");
+
+                    current->set_type(yyvsp[0]);
                   }
+#line 1516 "ScoutPatternParser.cc"
     break;
 
-  case 37:
-
-/* Line 1806 of yacc.c  */
-#line 258 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 37: /* Hidden: HIDDEN  */
+#line 266 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     current->set_hidden();
                   }
+#line 1524 "ScoutPatternParser.cc"
     break;
 
-  case 38:
-
-/* Line 1806 of yacc.c  */
-#line 265 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 38: /* NoDocs: NODOCS  */
+#line 273 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     current->set_nodocs();
                   }
+#line 1532 "ScoutPatternParser.cc"
     break;
 
-  case 39:
-
-/* Line 1806 of yacc.c  */
-#line 272 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 39: /* Info: INFO '=' String  */
+#line 280 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     if (!current->get_info().empty())
                       yyerror("Only one INFO definition allowed!");
 
-                    current->set_info((yyvsp[(3) - (3)]));
+                    current->set_info(yyvsp[0]);
                   }
+#line 1543 "ScoutPatternParser.cc"
     break;
 
-  case 40:
-
-/* Line 1806 of yacc.c  */
-#line 282 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 40: /* Description: DESCR '=' TextBlock  */
+#line 290 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     if (!current->get_descr().empty())
                       yyerror("Only one DESCR definition allowed!");
 
-                    current->set_descr((yyvsp[(3) - (3)]));
+                    current->set_descr(yyvsp[0]);
                   }
+#line 1554 "ScoutPatternParser.cc"
     break;
 
-  case 41:
-
-/* Line 1806 of yacc.c  */
-#line 292 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 41: /* Diagnosis: DIAGNOSIS '=' TextBlock  */
+#line 300 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     if (!current->get_diagnosis().empty())
                       yyerror("Only one DIAGNOSIS definition allowed!");
 
-                    current->set_diagnosis((yyvsp[(3) - (3)]));
+                    current->set_diagnosis(yyvsp[0]);
                   }
+#line 1565 "ScoutPatternParser.cc"
     break;
 
-  case 42:
-
-/* Line 1806 of yacc.c  */
-#line 302 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 42: /* Unit: UNIT '=' String  */
+#line 310 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     if (!current->get_unit().empty())
                       yyerror("Only one UNIT definition allowed!");
 
-                    current->set_unit((yyvsp[(3) - (3)]));
+                    current->set_unit(yyvsp[0]);
                   }
+#line 1576 "ScoutPatternParser.cc"
     break;
 
-  case 43:
-
-/* Line 1806 of yacc.c  */
-#line 312 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 43: /* Mode: MODE '=' String  */
+#line 320 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     if (!current->get_mode().empty())
                       yyerror("Only one MODE definition allowed!");
-                    if ((yyvsp[(3) - (3)]) != "inclusive" &&
-                        (yyvsp[(3) - (3)]) != "exclusive")
-                      yyerror("Unknown pattern mode \"" + (yyvsp[(3) - (3)]) + "\"");
+                    if (yyvsp[0] != "inclusive" &&
+                        yyvsp[0] != "exclusive")
+                      yyerror("Unknown pattern mode \"" + yyvsp[0] + "\"");
 
-                    current->set_mode((yyvsp[(3) - (3)]));
+                    current->set_mode(yyvsp[0]);
                   }
+#line 1590 "ScoutPatternParser.cc"
     break;
 
-  case 44:
-
-/* Line 1806 of yacc.c  */
-#line 324 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 44: /* Condition: CONDITION '=' String  */
+#line 332 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     if (!current->get_condition().empty())
                       yyerror("Only one CONDITION definition allowed!");
 
-                    current->set_condition((yyvsp[(3) - (3)]));
+                    current->set_condition(yyvsp[0]);
                   }
+#line 1601 "ScoutPatternParser.cc"
     break;
 
-  case 45:
-
-/* Line 1806 of yacc.c  */
-#line 334 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 45: /* Init: INIT '=' CodeBlock  */
+#line 342 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     if (!current->get_init().empty())
                       yyerror("Only one INIT definition allowed!");
 
-                    current->set_init((yyvsp[(3) - (3)]));
+                    current->set_init(yyvsp[0]);
                   }
+#line 1612 "ScoutPatternParser.cc"
     break;
 
-  case 46:
-
-/* Line 1806 of yacc.c  */
-#line 344 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 46: /* StaticInit: STATICINIT '=' CodeBlock  */
+#line 352 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     if (!current->get_staticinit().empty())
                       yyerror("Only one STATICINIT definition allowed!");
 
-                    current->set_staticinit((yyvsp[(3) - (3)]));
+                    current->set_staticinit(yyvsp[0]);
                   }
+#line 1623 "ScoutPatternParser.cc"
     break;
 
-  case 47:
-
-/* Line 1806 of yacc.c  */
-#line 354 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 47: /* Cleanup: CLEANUP '=' CodeBlock  */
+#line 362 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     if (!current->get_cleanup().empty())
                       yyerror("Only one CLEANUP definition allowed!");
 
-                    current->set_cleanup((yyvsp[(3) - (3)]));
+                    current->set_cleanup(yyvsp[0]);
                   }
+#line 1634 "ScoutPatternParser.cc"
     break;
 
-  case 48:
-
-/* Line 1806 of yacc.c  */
-#line 364 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 48: /* Data: DATA '=' CodeBlock  */
+#line 372 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     if (!current->get_data().empty())
                       yyerror("Only one DATA definition allowed!");
 
-                    current->set_data((yyvsp[(3) - (3)]));
+                    current->set_data(yyvsp[0]);
                   }
+#line 1645 "ScoutPatternParser.cc"
     break;
 
-  case 49:
-
-/* Line 1806 of yacc.c  */
-#line 374 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
-                    callbackgroup = (yyvsp[(3) - (4)]);
+  case 49: /* $@2: %empty  */
+#line 382 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
+                    callbackgroup = yyvsp[-1];
                   }
+#line 1653 "ScoutPatternParser.cc"
     break;
 
-  case 51:
-
-/* Line 1806 of yacc.c  */
-#line 379 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 51: /* $@3: %empty  */
+#line 387 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     callbackgroup = "";
                   }
+#line 1661 "ScoutPatternParser.cc"
     break;
 
-  case 55:
-
-/* Line 1806 of yacc.c  */
-#line 392 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
-                    if (!current->add_callback(callbackgroup, (yyvsp[(1) - (3)]), (yyvsp[(3) - (3)])))
-                      yyerror("Callback \"" + (yyvsp[(1) - (3)]) + "\" already defined!");
+  case 55: /* CbItem: String '=' CodeBlock  */
+#line 400 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
+                    if (!current->add_callback(callbackgroup, yyvsp[-2], yyvsp[0]))
+                      yyerror("Callback \"" + yyvsp[-2] + "\" already defined!");
                   }
+#line 1670 "ScoutPatternParser.cc"
     break;
 
-  case 56:
-
-/* Line 1806 of yacc.c  */
-#line 399 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
-                    (yyval) = (yyvsp[(2) - (3)]);
+  case 56: /* String: '"' STRING '"'  */
+#line 407 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
+                    yyval = yyvsp[-1];
                   }
+#line 1678 "ScoutPatternParser.cc"
     break;
 
-  case 57:
-
-/* Line 1806 of yacc.c  */
-#line 406 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
+  case 57: /* @4: %empty  */
+#line 414 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
                     char line_str[32];
                     snprintf(line_str, 32, "\n#line %ld \"", lineno);
 
-                    (yyval) = line_str +
+                    yyval = line_str +
                          (incFilename.empty() ? inpFilename : incFilename) +
                          "\"\n";
                   }
+#line 1691 "ScoutPatternParser.cc"
     break;
 
-  case 58:
-
-/* Line 1806 of yacc.c  */
-#line 415 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
-                    (yyval) = (yyvsp[(2) - (4)]) + (yyvsp[(3) - (4)]);
+  case 58: /* CodeBlock: '{' @4 Text '}'  */
+#line 423 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
+                    yyval = yyvsp[-2] + yyvsp[-1];
                   }
+#line 1699 "ScoutPatternParser.cc"
     break;
 
-  case 59:
-
-/* Line 1806 of yacc.c  */
-#line 422 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
-                    (yyval) = (yyvsp[(2) - (3)]);
+  case 59: /* TextBlock: '{' Text '}'  */
+#line 430 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
+                    yyval = yyvsp[-1];
                   }
+#line 1707 "ScoutPatternParser.cc"
     break;
 
-  case 60:
-
-/* Line 1806 of yacc.c  */
-#line 429 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
-                    (yyval) = (yyvsp[(1) - (2)]) + (yyvsp[(2) - (2)]);
+  case 60: /* Text: Text TEXT  */
+#line 437 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
+                    yyval = yyvsp[-1] + yyvsp[0];
                   }
+#line 1715 "ScoutPatternParser.cc"
     break;
 
-  case 61:
-
-/* Line 1806 of yacc.c  */
-#line 433 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
-    {
-                    (yyval) = (yyvsp[(1) - (1)]);
+  case 61: /* Text: TEXT  */
+#line 441 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+                  {
+                    yyval = yyvsp[0];
                   }
+#line 1723 "ScoutPatternParser.cc"
     break;
 
 
+#line 1727 "ScoutPatternParser.cc"
 
-/* Line 1806 of yacc.c  */
-#line 1947 "ScoutPatternParser.cc"
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -1957,96 +1738,58 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
-	 error, discard it.  */
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
     }
 
   /* Else will try to reuse lookahead token after shifting the error
@@ -2058,14 +1801,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -2078,39 +1820,42 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
 
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2121,26 +1866,30 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
-#if !defined(yyoverflow) || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -2149,39 +1898,32 @@ yyreturn:
       yydestruct ("Cleanup: discarding lookahead",
                   yytoken, &yylval);
     }
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
-}
-
 
+  return yyresult;
+}
 
-/* Line 2067 of yacc.c  */
-#line 439 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
+#line 447 "../../build-backend/../src/scout/generator/ScoutPatternParser.yy"
 
 
 
 /*
  *---------------------------------------------------------------------------
  *
- * gen_pattern <description file>
+ * gen_pattern [-b callback|fused] <description file>
  *
  *---------------------------------------------------------------------------
  */
@@ -2189,13 +1931,26 @@ yyreturn:
 int main(int argc, char** argv)
 {
   /* Check command line arguments */
-  if (argc != 2) {
-    fprintf(stderr, "Usage: gen_patterns <description file>\n");
+  int argi = 1;
+  if (argc == 4 && string(argv[1]) == "-b") {
+    string name(argv[2]);
+    if (name == "callback")
+      backend = BACKEND_CALLBACK;
+    else if (name == "fused")
+      backend = BACKEND_FUSED;
+    else {
+      fprintf(stderr, "Unknown backend \"%s\".\n", name.c_str());
+      exit(EXIT_FAILURE);
+    }
+    argi += 2;
+  }
+  if (argc != argi + 1) {
+    fprintf(stderr, "Usage: gen_patterns [-b callback|fused] <description file>\n");
     exit(EXIT_FAILURE);
   }
 
   /* Store input filename */
-  inpFilename = argv[1];
+  inpFilename = argv[argi];
 
   /* Open input file */
   yyin = fopen(inpFilename.c_str(), "r");
@@ -2329,15 +2084,21 @@ void write_impl()
   /* Write class implementation */
   vector<Pattern*>::const_iterator it = pattern.begin();
   while (it != pattern.end()) {
-    (*it)->write_impl(fp);
+    (*it)->write_impl(fp, backend);
     ++it;
   }
 
+  /* Write fused replay kernels */
+  if (backend == BACKEND_FUSED)
+    write_fused_kernels(fp);
+
   /* Write function implementation */
   fprintf(fp, "//--- Implementation --------------------------------------------------------\n"
               "\n"
               "void scout::create_patterns(AnalyzeTask* analyzer)\n"
               "{\n");
+  if (backend == BACKEND_FUSED)
+    fprintf(fp, "  FusedPatterns patterns = FusedPatterns();\n\n");
   it = pattern.begin();
   while (it != pattern.end()) {
     if ((*it)->skip_impl()) {
@@ -2345,64 +2106,42 @@ void write_impl()
       continue;
     }
 
-    const struct guard {
-      const char *type, *begin, *end;
-    } guards[] = {
-      { "MPI",    
-        "#if defined(_MPI)\n", 
-        "#endif   /* _MPI */\n" 
-      },
-      { "MPIDEP", 
-        "#if defined(_MPI)\n", 
-        "#endif   /* _MPI */\n" 
-      },
-      { "MPI_RMA",
-        "#if defined(_MPI) && defined(HAS_MPI2_1SIDED)\n", 
-        "#endif   /* _MPI && HAS_MPI2_1SIDED */\n"
-      },
-      { "MPI_RMADEP",
-        "#if defined(_MPI) && defined(HAS_MPI2_1SIDED)\n", 
-        "#endif   /* _MPI && HAS_MPI2_1SIDED */\n"
-      },
-      { "OMP",
-        "#if defined(_OPENMP)\n",
-        "#endif   /* _OPENMP */\n"        
-      },
-      { "OMPDEP",
-        "#if defined(_OPENMP)\n",
-        "#endif   /* _OPENMP */\n"        
-      },
-      { "ARMCI",
-        "#if defined(HAS_ARMCI)\n",
-        "#endif   /* HAS_ARMCI */\n"
-      },
-      { "ARMCIDEP",
-        "#if defined(HAS_ARMCI)\n",
-        "#endif   /* HAS_ARMCI */\n"
-      },
-
-      { 0, 0, 0 }
-    };
-
-    const struct guard* g;
-
-    for (g = guards; g->type && (*it)->get_type() != g->type; ++g)
-      ;
-
-    if (g->begin)
-      fprintf(fp, "%s", g->begin);
+    const char* begin;
+    const char* end;
+    pattern_guards((*it)->get_type(), begin, end);
+
+    if (begin)
+      fprintf(fp, "%s", begin);
 
     if (!(*it)->get_condition().empty())
       fprintf(fp, "  if (%s)\n  ", (*it)->get_condition().c_str());
 
-    fprintf(fp, "  analyzer->addPattern(new %s());\n",
-                (*it)->get_classname().c_str());
+    if (backend == BACKEND_FUSED && (*it)->has_fused_callbacks())
+      fprintf(fp, "  analyzer->addPattern(patterns.%s = new %s());\n",
+                  (*it)->get_fused_member().c_str(),
+                  (*it)->get_classname().c_str());
+    else
+      fprintf(fp, "  analyzer->addPattern(new %s());\n",
+                  (*it)->get_classname().c_str());
 
-    if (g->end)
-      fprintf(fp, "%s", g->end);
+    if (end)
+      fprintf(fp, "%s", end);
 
     ++it;
   }
+  if (backend == BACKEND_FUSED) {
+    fprintf(fp, "\n  // Register fused replay kernels\n");
+    vector<string> groups = fused_groups();
+    for (vector<string>::const_iterator git = groups.begin(); git != groups.end(); ++git) {
+      string begin;
+      string end;
+      fused_guards(*git, begin, end);
+
+      fprintf(fp, "%s  register_kernel(analyzer, \"%s\", new %s(patterns));\n%s",
+                  begin.c_str(), git->c_str(), fused_classname(*git).c_str(),
+                  end.c_str());
+    }
+  }
   fprintf(fp, "}\n\n\n");
 
   /* Close file */
@@ -2410,6 +2149,300 @@ void write_impl()
 }
 
 
+void pattern_guards(const string& type, const char*& begin, const char*& end)
+{
+  const struct guard {
+    const char *type, *begin, *end;
+  } guards[] = {
+    { "MPI",    
+      "#if defined(_MPI)\n", 
+      "#endif   /* _MPI */\n" 
+    },
+    { "MPIDEP", 
+      "#if defined(_MPI)\n", 
+      "#endif   /* _MPI */\n" 
+    },
+    { "MPI_RMA",
+      "#if defined(_MPI) && defined(HAS_MPI2_1SIDED)\n", 
+      "#endif   /* _MPI && HAS_MPI2_1SIDED */\n"
+    },
+    { "MPI_RMADEP",
+      "#if defined(_MPI) && defined(HAS_MPI2_1SIDED)\n", 
+      "#endif   /* _MPI && HAS_MPI2_1SIDED */\n"
+    },
+    { "OMP",
+      "#if defined(_OPENMP)\n",
+      "#endif   /* _OPENMP */\n"        
+    },
+    { "OMPDEP",
+      "#if defined(_OPENMP)\n",
+      "#endif   /* _OPENMP */\n"        
+    },
+    { "ARMCI",
+      "#if defined(HAS_ARMCI)\n",
+      "#endif   /* HAS_ARMCI */\n"
+    },
+    { "ARMCIDEP",
+      "#if defined(HAS_ARMCI)\n",
+      "#endif   /* HAS_ARMCI */\n"
+    },
+
+    { 0, 0, 0 }
+  };
+
+  const struct guard* g;
+
+  for (g = guards; g->type && type != g->type; ++g)
+    ;
+
+  begin = g->begin;
+  end   = g->end;
+}
+
+
+vector<string> fused_groups()
+{
+  vector<string> groups;
+
+  vector<Pattern*>::const_iterator it = pattern.begin();
+  while (it != pattern.end()) {
+    if ((*it)->has_fused_callbacks()) {
+      vector<string> pgroups = (*it)->get_callback_groups();
+      for (vector<string>::const_iterator git = pgroups.begin(); git != pgroups.end(); ++git) {
+        if (find(groups.begin(), groups.end(), *git) != groups.end())
+          continue;
+
+        // Only consider groups with at least one trace-event callback
+        const vector<string>& types = trace_event_types();
+        for (vector<string>::const_iterator tit = types.begin(); tit != types.end(); ++tit) {
+          if ((*it)->has_fused_callbacks(*git, *tit)) {
+            groups.push_back(*git);
+            break;
+          }
+        }
+      }
+    }
+    ++it;
+  }
+  sort(groups.begin(), groups.end());
+
+  return groups;
+}
+
+
+string fused_classname(const string& group)
+{
+  if (group.empty())
+    return "FusedKernel";
+
+  return "FusedKernel_" + group;
+}
+
+
+/* Determines the preprocessor guard of the fused kernel for the given
+   replay group, i.e., the disjunction of the guards of all patterns it
+   dispatches to.  Both strings are empty if one of them is unguarded. */
+void fused_guards(const string& group, string& begin, string& end)
+{
+  const vector<string>& types = trace_event_types();
+  vector<string>        conditions;
+
+  begin.clear();
+  end.clear();
+
+  vector<Pattern*>::const_iterator it = pattern.begin();
+  for ( ; it != pattern.end(); ++it) {
+    vector<string>::const_iterator tit = types.begin();
+    while (tit != types.end() && !(*it)->has_fused_callbacks(group, *tit))
+      ++tit;
+    if (tit == types.end())
+      continue;
+
+    const char* pbegin;
+    const char* pend;
+    pattern_guards((*it)->get_type(), pbegin, pend);
+    if (!pbegin)
+      return;
+
+    // Strip "#if " and the trailing newline
+    string condition(pbegin + 4, strlen(pbegin) - 5);
+    if (find(conditions.begin(), conditions.end(), condition) == conditions.end()) {
+      conditions.push_back(condition);
+      end = pend;
+    }
+  }
+
+  if (conditions.empty())
+    return;
+
+  if (conditions.size() == 1) {
+    begin = "#if " + conditions.front() + "\n";
+    return;
+  }
+
+  begin = "#if (" + conditions.front() + ")";
+  for (vector<string>::const_iterator cit = conditions.begin() + 1; cit != conditions.end(); ++cit)
+    begin += " || (" + *cit + ")";
+  begin += "\n";
+  end    = "#endif\n";
+}
+
+
+void write_fused_kernels(FILE* fp)
+{
+  const vector<string>& types  = trace_event_types();
+  const vector<string>  groups = fused_groups();
+
+  fprintf(fp, "//--- Fused replay kernels --------------------------------------------------\n"
+              "\n"
+              "namespace\n"
+              "{\n"
+              "\n");
+
+  /***** Pattern instances *****/
+
+  fprintf(fp, "/*\n"
+              " *---------------------------------------------------------------------------\n"
+              " *\n"
+              " * struct FusedPatterns\n"
+              " *\n"
+              " *---------------------------------------------------------------------------\n"
+              " */\n"
+              "\n\n"
+              "// Pattern instances dispatched by the fused kernels (NULL if disabled)\n"
+              "struct FusedPatterns\n"
+              "{\n");
+  vector<Pattern*>::const_iterator it = pattern.begin();
+  while (it != pattern.end()) {
+    if ((*it)->has_fused_callbacks()) {
+      const char* begin;
+      const char* end;
+      pattern_guards((*it)->get_type(), begin, end);
+
+      if (begin)
+        fprintf(fp, "%s", begin);
+      fprintf(fp, "  %s* %s;\n",
+                  (*it)->get_classname().c_str(),
+                  (*it)->get_fused_member().c_str());
+      if (end)
+        fprintf(fp, "%s", end);
+    }
+    ++it;
+  }
+  fprintf(fp, "};\n\n\n");
+
+  /***** One kernel class per replay *****/
+
+  for (vector<string>::const_iterator git = groups.begin(); git != groups.end(); ++git) {
+    string classname = fused_classname(*git);
+
+    // Kernels only dispatching to guarded patterns are guarded as well;
+    // otherwise, their arguments would be unused in some configurations
+    string kbegin;
+    string kend;
+    fused_guards(*git, kbegin, kend);
+
+    fprintf(fp, "%s", kbegin.c_str());
+    fprintf(fp, "/*\n"
+                " *---------------------------------------------------------------------------\n"
+                " *\n"
+                " * class %s\n"
+                " *\n"
+                " *---------------------------------------------------------------------------\n"
+                " */\n"
+                "\n\n", classname.c_str());
+    fprintf(fp, "class %s : public pearl::Callback\n"
+                "{\n"
+                "  public:\n"
+                "    %s(const FusedPatterns& patterns)\n"
+                "      : m_patterns(patterns)\n"
+                "    {}\n\n"
+                "    bool handles(event_t type) const;\n\n"
+                "    virtual void execute(const pearl::CallbackManager& cbmanager, int user_event,\n"
+                "                         const pearl::Event& event, CallbackData* cdata);\n\n\n"
+                "  private:\n"
+                "    FusedPatterns m_patterns;\n"
+                "};\n\n\n",
+                classname.c_str(), classname.c_str());
+
+    /* handles() */
+    fprintf(fp, "bool %s::handles(event_t type) const\n"
+                "{\n"
+                "  switch (type) {\n", classname.c_str());
+    for (vector<string>::const_iterator tit = types.begin(); tit != types.end(); ++tit) {
+      bool found = false;
+      for (it = pattern.begin(); it != pattern.end(); ++it) {
+        if (!(*it)->has_fused_callbacks(*git, *tit))
+          continue;
+
+        if (!found)
+          fprintf(fp, "    case %s:\n", tit->c_str());
+        found = true;
+
+        const char* begin;
+        const char* end;
+        pattern_guards((*it)->get_type(), begin, end);
+
+        if (begin)
+          fprintf(fp, "%s", begin);
+        fprintf(fp, "      if (m_patterns.%s)\n"
+                    "        return true;\n",
+                    (*it)->get_fused_member().c_str());
+        if (end)
+          fprintf(fp, "%s", end);
+      }
+      if (found)
+        fprintf(fp, "      return false;\n\n");
+    }
+    fprintf(fp, "    default:\n"
+                "      return false;\n"
+                "  }\n"
+                "}\n\n\n");
+
+    /* execute() */
+    fprintf(fp, "void %s::execute(const pearl::CallbackManager& cbmanager, int user_event,\n"
+                "    const pearl::Event& event, CallbackData* cdata)\n"
+                "{\n"
+                "  switch (event->getType()) {\n", classname.c_str());
+    for (vector<string>::const_iterator tit = types.begin(); tit != types.end(); ++tit) {
+      bool found = false;
+      for (it = pattern.begin(); it != pattern.end(); ++it) {
+        if (!(*it)->has_fused_callbacks(*git, *tit))
+          continue;
+
+        if (!found)
+          fprintf(fp, "    case %s:\n", tit->c_str());
+        found = true;
+
+        (*it)->write_fused_calls(fp, *git, *tit);
+      }
+      if (found)
+        fprintf(fp, "      break;\n\n");
+    }
+    fprintf(fp, "    default:\n"
+                "      break;\n"
+                "  }\n"
+                "}\n");
+    fprintf(fp, "%s\n\n", kend.c_str());
+  }
+
+  /***** Registration helper *****/
+
+  fprintf(fp, "template<class KernelT>\n"
+              "void register_kernel(AnalyzeTask* analyzer, const string& replay, KernelT* kernel)\n"
+              "{\n"
+              "  CallbackPtr callback(kernel);\n"
+              "\n"
+              "  for (int type = 0; type < GROUP_ALL; ++type)\n"
+              "    if (kernel->handles(event_t(type)))\n"
+              "      analyzer->addCallback(replay, event_t(type), callback);\n"
+              "}\n"
+              "\n"
+              "}   // unnamed namespace\n"
+              "\n\n");
+}
+
+
 void write_html()
 {
   /* Open documentation file */
@@ -2470,4 +2503,3 @@ string uppercase(const string& str)
 
   return result;
 }
-
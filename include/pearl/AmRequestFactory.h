@@ -29,6 +29,7 @@
 #ifndef PEARL_AMREQUESTFACTORY_H
 #define PEARL_AMREQUESTFACTORY_H
 
+#include <cstddef>
 #include <map>
 
 #include <pearl/AmRequest.h>
@@ -63,6 +64,16 @@ class AmRequestFactory
         /// Container type for callback lists
         typedef std::map<Paradigm, CbFunction> CbContainer;
 
+        /// Completion test callback-function type. Tests the given
+        /// requests for completion at once, stores the indices of the
+        /// completed requests, and returns their number (cf. MPI_Testsome).
+        typedef std::size_t (*TestFunction)(AmRequest** requests,
+                                            std::size_t count,
+                                            int*        indices);
+
+        /// Container type for completion test callback lists
+        typedef std::map<Paradigm, TestFunction> TestCbContainer;
+
         /// @}
         /// @name Factory interface
         /// @{
@@ -71,15 +82,25 @@ class AmRequestFactory
         create(uint32_t            remote,
                const Communicator& comm,
                bool                ensureSynchronous=false);
+        static std::size_t
+        testsome(AmRequest** requests,
+                 std::size_t count,
+                 int*        indices);
 
         /// @}
         /// @name Callback interface
         /// @{
         static CbContainer&
         getCallbacks();
+        static TestCbContainer&
+        getTestCallbacks();
         static void
         registerCallback(Paradigm   paradigm,
                          CbFunction callback);
+        static void
+        registerCallback(Paradigm     paradigm,
+                         CbFunction   callback,
+                         TestFunction testCallback);
 
         /// @}
 };
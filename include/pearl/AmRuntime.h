@@ -18,6 +18,7 @@
 #define PEARL_AMRUNTIME_H
 
 #include <map>
+#include <utility>
 #include <set>
 #include <vector>
 
@@ -61,6 +62,11 @@ class Communicator;
  * origin side and to unpack and execute their business logic on
  * the target side.
  *
+ * Requests to the same target are coalesced into a single message until
+ * either the configured flush threshold is reached or the runtime is
+ * advanced, which reduces the number of (small) messages substantially.
+ * Synchronous requests are never delayed.
+ *
  * @note It is the users responsibility to register Listener objects
  * on the target location that are capable of receiving requests that
  * injected into the system on any of the origin locations.
@@ -83,6 +89,8 @@ class AmRuntime
         size_t
         advance();
         void
+        flush();
+        void
         wait();
         void
         wait(const Communicator& comm);
@@ -103,6 +111,10 @@ class AmRuntime
         setCbmanager(const CallbackManager& cbmanager);
         const CallbackManager&
         getCbmanager() const;
+        void
+        setFlushThreshold(size_t bytes);
+        size_t
+        getFlushThreshold() const;
 
         /// @}
         /// @name Message handling
@@ -152,6 +164,11 @@ class AmRuntime
         /// Container type for storing all active target sets
         typedef std::map<const pearl::Communicator*, TargetSet> TargetSetContainer;
 
+        /// Container type for requests not yet sent, i.e., the batch of
+        /// coalesced requests per (communicator, target) pair
+        typedef std::map<std::pair<const pearl::Communicator*, uint32_t>,
+                         AmRequest*> BatchContainer;
+
         RequestContainer&
         getRequests();
         ListenerContainer&
@@ -164,6 +181,15 @@ class AmRuntime
         getTargetsets();
         TargetSet&
         getTargetset(const Communicator& comm);
+        BatchContainer&
+        getBatches();
+
+        /// @}
+        /// @name Internal message handling
+        /// @{
+
+        void
+        start(AmRequest* request);
 
         /// @}
         /// @name Constructors & destructor
@@ -186,6 +212,15 @@ class AmRuntime
 
         /// Pointer to callback manager in use
         const CallbackManager* mCbmanager;
+
+        /// Message size (in bytes) triggering a batch to be sent
+        size_t mFlushThreshold;
+
+        /// Number of requests enqueued
+        size_t mNumRequests;
+
+        /// Number of messages sent
+        size_t mNumMessages;
 };
 } // namespace pearl
 
@@ -106,6 +106,8 @@ class Buffer
         put_event(const Event& event);
         void
         put_buffer(const Buffer& buffer);
+        void
+        append(const Buffer& buffer);
 
         /// @}
         /// @name Retrieving data values
@@ -132,6 +134,15 @@ class Buffer
 
 
     protected:
+        /// @name Constructors
+        /// @{
+
+        Buffer(const uint8_t* data,
+               std::size_t    size);
+
+        /// @}
+
+
         /// Current buffer capacity
         std::size_t m_capacity;
 
@@ -144,6 +155,9 @@ class Buffer
         /// Pointer to the actual data
         uint8_t* m_data;
 
+        /// Denotes whether the data is owned (and thus released) by the buffer
+        bool m_isOwner;
+
         /// @name Internal buffer handling
         /// @{
 
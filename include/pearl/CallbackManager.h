@@ -18,7 +18,9 @@
 #define PEARL_CALLBACKMANAGER_H
 
 
+#include <list>
 #include <map>
+#include <string>
 #include <vector>
 
 #include "Callback.h"
@@ -50,18 +52,56 @@ class CallbackData;
  *  @ingroup PEARL_replay
  *  @brief   Manages a set of callback objects and provides a simple
  *           notification mechanism.
+ *
+ *  Optionally, the callback manager can profile the registered callbacks.
+ *  If profiling is enabled, each callback registered afterwards is wrapped
+ *  by an object measuring the number of invocations and the cumulative
+ *  wall-clock time spent in it. The measured time is inclusive, i.e., it
+ *  also covers callbacks executed by nested notifications. If profiling is
+ *  disabled, no overhead is imposed on the notification routines.
  **/
 /*-------------------------------------------------------------------------*/
 
 class CallbackManager
 {
   public:
+    /// Profiling data of a registered callback
+    struct CallbackProfile
+    {
+      /// Label of the registering component
+      std::string m_label;
+
+      /// Trace event type or user event the callback is registered for
+      int m_event;
+
+      /// Flag indicating whether @a m_event denotes a user event
+      bool m_user_event;
+
+      /// Number of invocations
+      uint64_t m_count;
+
+      /// Cumulative execution time (in seconds)
+      double m_time;
+    };
+
+    /// Container type for callback profiles
+    typedef std::list<CallbackProfile> profile_container;
+
+
+    /// @name Constructors & destructor
+    /// @{
+
+    CallbackManager();
+
+    /// @}
     /// @name Registering callbacks
     /// @{
 
     void register_callback(event_t event_type, CallbackPtr callback);
     void register_callback(int     user_event, CallbackPtr callback);
 
+    event_mask_t get_event_mask() const;
+
     /// @{
     /// @name Notification routines
     /// @{
@@ -70,6 +110,15 @@ class CallbackManager
     void notify(int user_event, const Event& event, CallbackData* data) const;
 
     /// @}
+    /// @name Callback profiling
+    /// @{
+
+    void enable_profiling();
+    void set_profile_label(const std::string& label);
+
+    const profile_container& get_profile() const;
+
+    /// @}
 
 
   private:
@@ -88,6 +137,23 @@ class CallbackManager
 
     /// User event callback mapping
     user_cb_map m_user_cbs;
+
+    /// Flag indicating whether callbacks registered from now on are profiled
+    bool m_profiling;
+
+    /// Label assigned to the callbacks registered from now on
+    std::string m_profile_label;
+
+    /// Profiling data of the registered callbacks
+    profile_container m_profile;
+
+
+    /// @name Internal methods
+    /// @{
+
+    CallbackPtr make_profiled(int event, bool user_event, CallbackPtr callback);
+
+    /// @}
 };
 
 
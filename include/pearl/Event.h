@@ -46,6 +46,8 @@ namespace pearl
 //--- Forward declarations --------------------------------------------------
 
 class Buffer;
+class CallbackData;
+class CallbackManager;
 class Callpath;
 class LocalTrace;
 class Location;
@@ -160,6 +162,13 @@ class Event : public std::iterator<std::bidirectional_iterator_tag, Event_rep>
 
     friend struct EventKeyCompare;
 
+    friend uint64_t getTaskBlockId(const Event& event);
+
+    friend void PEARL_forward_replay(const LocalTrace&      trace,
+                                     const CallbackManager& cbmanager,
+                                     CallbackData*          data,
+                                     event_mask_t           mask);
+
     friend std::ostream& operator<<(std::ostream& stream, const Event& event);
 };
 
@@ -170,6 +179,8 @@ std::ostream& operator<<(std::ostream& stream, const Event& event);
 
 std::string event_typestr(event_t type);
 
+event_mask_t event_mask(event_t type);
+
 uint64_t getTaskBlockId(const Event& event);
 
 /*-------------------------------------------------------------------------*/
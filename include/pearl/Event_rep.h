@@ -18,6 +18,7 @@
 #define PEARL_EVENT_REP_H
 
 #include <iosfwd>
+#include <string>
 
 #include "pearl_padding.h"
 #include "pearl_types.h"
@@ -43,11 +44,17 @@ class Buffer;
 class Callsite;
 class GlobalDefs;
 class LocalTrace;
+class Location;
 class MpiComm;
 class MpiGroup;
 class MpiWindow;
 class Region;
 
+namespace detail
+{
+class RequestTable;
+}   // namespace detail
+
 
 /*-------------------------------------------------------------------------*/
 /**
@@ -196,9 +203,17 @@ class PEARL_NOPAD_ATTR Event_rep
         friend class Buffer;
         friend class Event;
         friend class RemoteEvent;
+        friend class detail::RequestTable;
 
         friend void PEARL_preprocess_trace(const GlobalDefs& defs,
                                            const LocalTrace& trace);
+        friend void PEARL_write_trace_cache(const GlobalDefs&  defs,
+                                            const LocalTrace&  trace,
+                                            const std::string& filename,
+                                            uint64_t           stamp);
+        friend LocalTrace* PEARL_read_trace_cache(GlobalDefs&        defs,
+                                                  const Location&    location,
+                                                  const std::string& filename);
 };
 
 
@@ -303,6 +303,8 @@ class GlobalDefs
     friend class DefsFactory;
     friend class MpiDefsFactory;
     friend class TraceArchive;
+
+    friend void PEARL_share_defs(GlobalDefs& defs);
 };
 
 
@@ -22,6 +22,7 @@
 
 
 #include <iterator>
+#include <string>
 #include <vector>
 
 #include "Event.h"
@@ -42,9 +43,12 @@ namespace pearl
 {
 //--- Forward declarations --------------------------------------------------
 
+class CallbackData;
+class CallbackManager;
 class Event_rep;
 class GlobalDefs;
 class Location;
+class MetricTable;
 
 
 /*-------------------------------------------------------------------------*/
@@ -112,12 +116,31 @@ class LocalTrace
         const GlobalDefs&
         get_definitions() const;
 
+        const MetricTable*
+        getMetricTable() const;
+        MetricTable*
+        getMetricTable();
+
+        /// @}
+        /// @name Event navigation index
+        /// @{
+
+        void
+        buildNavigationIndex() const;
+        void
+        releaseNavigationIndex() const;
+        bool
+        hasNavigationIndex() const;
+
         /// @}
         /// @name Store new events
         /// @{
 
         void
         add_event(Event_rep* event);
+        void
+        addMetricValues(const Event&    event,
+                        const uint64_t* values);
 
         /// @}
         /// @name Inserting & removing elements
@@ -145,6 +168,9 @@ class LocalTrace
 
 
     private:
+        /// Marker for undefined navigation index entries
+        static const uint32_t NO_INDEX = ~static_cast<uint32_t>(0);
+
         /// Associated global definitions
         const GlobalDefs& m_defs;
 
@@ -160,6 +186,30 @@ class LocalTrace
         /// Trace location
         Location* m_location;
 
+        /// Hardware counter values (NULL if none are stored)
+        MetricTable* m_metrics;
+
+        /// Navigation index: position of the matching LEAVE (for ENTER
+        /// events), ENTER (for LEAVE events), END (for BEGIN-type events),
+        /// or BEGIN (for END-type events), indexed by event position
+        mutable std::vector<uint32_t> m_matchIndex;
+
+        /// Navigation index: position of the ENTER event of the innermost
+        /// enclosing region, indexed by event position
+        mutable std::vector<uint32_t> m_parentIndex;
+
+        /// Navigation index: positions at which a new task block starts,
+        /// in ascending order
+        mutable std::vector<uint32_t> m_taskBlockStarts;
+
+        /// Navigation index: task identifiers of the task blocks starting
+        /// at the corresponding positions in m_taskBlockStarts
+        mutable std::vector<uint64_t> m_taskBlockIds;
+
+        /// Navigation index: positions of the events of each (non-group)
+        /// event type in trace order, indexed by event type
+        mutable std::vector< std::vector<uint32_t> > m_typeIndex;
+
 
         /* Private methods */
         LocalTrace(const GlobalDefs& defs,
@@ -170,6 +220,25 @@ class LocalTrace
         /* Declare friends */
         friend class Event;
         friend class TraceArchive;
+
+        friend uint64_t getTaskBlockId(const Event& event);
+        friend void PEARL_forward_replay(const LocalTrace&      trace,
+                                         const CallbackManager& cbmanager,
+                                         CallbackData*          data,
+                                         event_mask_t           mask);
+
+        friend void PEARL_write_trace_cache(const GlobalDefs&  defs,
+                                            const LocalTrace&  trace,
+                                            const std::string& filename,
+                                            uint64_t           stamp);
+        friend LocalTrace* PEARL_read_trace_cache(GlobalDefs&        defs,
+                                                  const Location&    location,
+                                                  const std::string& filename);
+        friend void PEARL_restrict_trace(const GlobalDefs&        defs,
+                                         LocalTrace&              trace,
+                                         timestamp_t              begin,
+                                         timestamp_t              end,
+                                         const std::vector<bool>& retained);
 };
 
 }   // namespace pearl
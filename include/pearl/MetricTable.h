@@ -0,0 +1,211 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file
+ *  @ingroup PEARL_base
+ *  @brief   Declaration of the class MetricTable.
+ *
+ *  This header file provides the declaration of the class MetricTable.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+#ifndef PEARL_METRICTABLE_H
+#define PEARL_METRICTABLE_H
+
+
+#include <stdint.h>
+
+#include <vector>
+
+
+namespace pearl
+{
+//--- Forward declarations --------------------------------------------------
+
+class Buffer;
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class   MetricTable
+ *  @ingroup PEARL_base
+ *  @brief   Compact storage of the hardware counter values of a local trace.
+ *
+ *  The MetricTable class stores the values of all metrics defined in the
+ *  global definitions (see GlobalDefs::num_metrics()) for a subset of the
+ *  events of a local trace, identified by their position in the trace. The
+ *  data is kept separate from the event objects in a columnar layout: the
+ *  event positions and the values of each metric are stored in individual
+ *  byte streams, encoding the differences between consecutive rows as
+ *  variable-length integers. As counter values usually change only slightly
+ *  between neighboring events, this typically requires only one or two
+ *  bytes per value.
+ *
+ *  Rows are grouped into blocks of fixed size whose first row is encoded
+ *  without reference to previous rows. The byte offsets of each block are
+ *  retained, allowing random access to the values of an arbitrary event
+ *  by decoding at most one block. Sequential access is provided by the
+ *  nested Cursor class.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class MetricTable
+{
+    public:
+        //--- Public classes -------------------------------
+
+        /*-----------------------------------------------------------------*/
+        /**
+         *  @class   Cursor
+         *  @ingroup PEARL_base
+         *  @brief   Sequential read access to the rows of a MetricTable.
+         **/
+        /*-----------------------------------------------------------------*/
+
+        class Cursor
+        {
+            public:
+                /// @name Constructors & destructor
+                /// @{
+
+                explicit
+                Cursor(const MetricTable& table);
+
+                /// @}
+                /// @name Iteration
+                /// @{
+
+                bool
+                next();
+
+                /// @}
+                /// @name Access to the current row
+                /// @{
+
+                uint32_t
+                getPosition() const;
+
+                uint64_t
+                getValue(uint32_t metric) const;
+
+                const uint64_t*
+                getValues() const;
+
+                /// @}
+
+
+            private:
+                /// Associated metric table
+                const MetricTable& mTable;
+
+                /// Index of the next row to be decoded
+                uint32_t mRow;
+
+                /// Read offsets of the position stream and all value streams
+                std::vector<uint32_t> mOffsets;
+
+                /// Event position of the current row
+                uint32_t mPosition;
+
+                /// Metric values of the current row
+                std::vector<uint64_t> mValues;
+        };
+
+
+        //--- Public methods -------------------------------
+
+        /// @name Constructors & destructor
+        /// @{
+
+        explicit
+        MetricTable(uint32_t numMetrics);
+
+        explicit
+        MetricTable(Buffer& buffer);
+
+        /// @}
+        /// @name Query functions
+        /// @{
+
+        uint32_t
+        numMetrics() const;
+
+        uint32_t
+        numRows() const;
+
+        bool
+        getValues(uint32_t  position,
+                  uint64_t* values) const;
+
+        /// @}
+        /// @name Storing values
+        /// @{
+
+        void
+        append(uint32_t        position,
+               const uint64_t* values);
+
+        void
+        remap(const std::vector<uint32_t>& oldPositions,
+              const std::vector<uint32_t>& newPositions);
+
+        /// @}
+        /// @name Serialization
+        /// @{
+
+        void
+        pack(Buffer& buffer) const;
+
+        /// @}
+
+
+    private:
+        //--- Data members ---------------------------------
+
+        /// Number of metric columns
+        uint32_t mNumMetrics;
+
+        /// Number of rows
+        uint32_t mNumRows;
+
+        /// Encoded byte streams: event positions followed by one stream per
+        /// metric
+        std::vector< std::vector<uint8_t> > mStreams;
+
+        /// Event position of the first row of each block
+        std::vector<uint32_t> mBlockPositions;
+
+        /// Start offsets of each block within the individual byte streams
+        std::vector<uint32_t> mBlockOffsets;
+
+        /// Event position of the last row appended
+        uint32_t mLastPosition;
+
+        /// Metric values of the last row appended
+        std::vector<uint64_t> mLastValues;
+
+
+        //--- Private methods & friends --------------------
+
+        void
+        decodeRow(std::vector<uint32_t>& offsets,
+                  uint32_t               row,
+                  uint32_t&              position,
+                  std::vector<uint64_t>& values) const;
+};
+}   // namespace pearl
+
+
+#endif   // !PEARL_METRICTABLE_H
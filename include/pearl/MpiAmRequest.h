@@ -18,6 +18,7 @@
 #define PEARL_MPI_AMREQUEST_H
 
 #include <inttypes.h>
+#include <cstddef>
 
 #include <pearl/AmRequest.h>
 
@@ -59,6 +60,15 @@ class MpiAmRequest
         virtual
         ~MpiAmRequest();
 
+        /// @}
+        /// @name Handling sets of requests
+        /// @{
+
+        static std::size_t
+        testsome(AmRequest** requests,
+                 std::size_t count,
+                 int*        indices);
+
         /// @}
         /// @name Handling requests on origin side
         /// @{
@@ -74,6 +84,9 @@ class MpiAmRequest
 
 
     private:
+        /// Flag whether the request is known to be completed
+        bool mCompleted;
+
         MpiAmRequest(uint32_t       remote,
                      const MpiComm& comm,
                      bool           ensureSynchronous);
@@ -18,6 +18,8 @@
 #define PEARL_MPICOMM_H
 
 
+#include <vector>
+
 #include <mpi.h>
 
 #include "Communicator.h"
@@ -38,6 +40,7 @@ namespace pearl
 {
 //--- Forward declarations --------------------------------------------------
 
+class GlobalDefs;
 class MpiGroup;
 
 
@@ -51,6 +54,12 @@ class MpiGroup;
  *  communicators. In addition to the functionality of the base class
  *  Communicator, they also provide a "real" MPI communicator handle
  *  resembling the one used in the target application.
+ *
+ *  The MPI communicator handles are not created when the definitions are
+ *  read. Instead, the handles of all communicators required by an analysis
+ *  should be created at once using PEARL_mpi_create_comms(), which uses a
+ *  single MPI_Comm_split for each set of disjoint communicators. Handles
+ *  of the remaining communicators are created on first access.
  **/
 /*-------------------------------------------------------------------------*/
 
@@ -93,9 +102,22 @@ class MpiComm
         /// @brief Get MPI communicator handle
         ///
         /// Returns the MPI communicator handle associated with this
-        /// communicator object.
+        /// communicator object. If the handle has not been created by
+        /// PEARL_mpi_create_comms(), it is created on first access. With
+        /// MPI 3.0 or later, this uses MPI_Comm_create_group and is thus
+        /// only collective over the members of the communicator, i.e., all
+        /// members have to call this method in the same order with respect
+        /// to other uncreated communicators. With older MPI versions, all
+        /// communicators except empty and self communicators have to be
+        /// created by PEARL_mpi_create_comms(). The lazy creation is
+        /// thread-safe, i.e., multiple threads of a process may access the
+        /// same communicator concurrently; no lock is held while calling MPI.
+        ///
+        /// @return MPI communicator handle (MPI_COMM_NULL if the calling
+        ///         process is not a member of the communicator)
         ///
-        /// @return MPI communicator handle
+        /// @exception FatalError
+        ///     if the handle has to be created on demand with MPI < 3.0
         ///
         MPI_Comm
         getComm() const;
@@ -134,13 +156,26 @@ class MpiComm
         //--- Data members ---------------------------------
 
         /// Corresponding MPI communicator
-        MPI_Comm mCommunicator;
+        mutable MPI_Comm mCommunicator;
+
+        /// Flag indicating whether the MPI communicator has been created
+        mutable bool mIsCreated;
+
+        /// Flag indicating whether a thread has started creating the MPI
+        /// communicator on demand
+        mutable bool mIsCreating;
 
 
         //--- Private methods & friends --------------------
 
         virtual std::ostream&
         print(std::ostream& stream) const;
+        void
+        createComm() const;
+
+        friend void
+        PEARL_mpi_create_comms(const GlobalDefs&            defs,
+                               const std::vector<uint32_t>& commIds);
 };
 }   // namespace pearl
 
@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2014                                                **
+**  Copyright (c) 1998-2016                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -43,8 +43,6 @@ namespace pearl
 
 //--- Forward declarations --------------------------------------------------
 
-class CallbackData;
-class CallbackManager;
 class Event;
 class GlobalDefs;
 class LocalTrace;
@@ -57,7 +55,8 @@ class LocalTrace;
  * @brief   Provides a writer class to generate OTF2 traces.
  *
  * The Otf2Writer class can be used to write in-memory trace data to an OTF2
- * archive on disk.
+ * archive on disk.  The OTF2 file substrate (e.g., POSIX or SIONlib) and
+ * compression used for the archive can be selected at construction time.
  *
  * @todo Hide references to OTF2 data types so that PEARL users don't need
  *       to care about providing the OTF2 include path.
@@ -70,7 +69,8 @@ class Otf2Writer
     /// @name Constructors & destructor
     /// @{
 
-    Otf2Writer();
+    Otf2Writer(OTF2_FileSubstrate substrate   = OTF2_SUBSTRATE_POSIX,
+               OTF2_Compression   compression = OTF2_COMPRESSION_NONE);
     ~Otf2Writer();
 
     /// @}
@@ -88,6 +88,12 @@ class Otf2Writer
     /// OTF2 archive handle
     OTF2_Archive* mArchive;
 
+    /// OTF2 file substrate
+    OTF2_FileSubstrate mSubstrate;
+
+    /// OTF2 compression
+    OTF2_Compression mCompression;
+
     /// Identifier of the next string definition record
     uint32_t mNextStringId;
 
@@ -109,72 +115,99 @@ class Otf2Writer
     /// Lookup table string definition |-@> string ID
     std::map<std::string, uint32_t> mStringMap;
 
-    /// %Callback manager instance for the replay
-    CallbackManager* mCbManager;
 
-
-    /// @name Replay callback routines
+    /// @name Event encoding routines
     /// @{
 
-    void enter(const CallbackManager& cbmanager, int user_event,
-               const Event& event, CallbackData* cdata);
-    void leave(const CallbackManager& cbmanager, int user_event,
-               const Event& event, CallbackData* cdata);
-
-    void mpisend     (const CallbackManager& cbmanager, int user_event,
-                      const Event& event, CallbackData* cdata);
-    void mpirecv     (const CallbackManager& cbmanager, int user_event,
-                      const Event& event, CallbackData* cdata);
-    void mpisendreq  (const CallbackManager& cbmanager, int user_event,
-                      const Event& event, CallbackData* cdata);
-    void mpisendcomp (const CallbackManager& cbmanager, int user_event,
-                      const Event& event, CallbackData* cdata);
-    void mpirecvreq  (const CallbackManager& cbmanager, int user_event,
-                      const Event& event, CallbackData* cdata);
-    void mpirecvcomp (const CallbackManager& cbmanager, int user_event,
-                      const Event& event, CallbackData* cdata);
-    void mpireqtested(const CallbackManager& cbmanager, int user_event,
-                      const Event& event, CallbackData* cdata);
-    void mpicancelled(const CallbackManager& cbmanager, int user_event,
-                      const Event& event, CallbackData* cdata);
-    void mpicollexit (const CallbackManager& cbmanager, int user_event,
-                      const Event& event, CallbackData* cdata);
-    void mpicollbegin(const CallbackManager& cbmanager, int user_event,
-                      const Event& event, CallbackData* cdata);
-    void mpicollend  (const CallbackManager& cbmanager, int user_event,
-                      const Event& event, CallbackData* cdata);
-
-    void threadBegin       (const CallbackManager& cbmanager, int user_event,
-                            const Event& event, CallbackData* cdata);
-    void threadEnd         (const CallbackManager& cbmanager, int user_event,
-                            const Event& event, CallbackData* cdata);
-    void threadWait        (const CallbackManager& cbmanager, int user_event,
-                            const Event& event, CallbackData* cdata);
-    void threadCreate      (const CallbackManager& cbmanager, int user_event,
-                            const Event& event, CallbackData* cdata);
-    void threadTeamBegin   (const CallbackManager& cbmanager, int user_event,
-                            const Event& event, CallbackData* cdata);
-    void threadTeamEnd     (const CallbackManager& cbmanager, int user_event,
-                            const Event& event, CallbackData* cdata);
-    void threadFork        (const CallbackManager& cbmanager, int user_event,
-                            const Event& event, CallbackData* cdata);
-    void threadJoin        (const CallbackManager& cbmanager, int user_event,
-                            const Event& event, CallbackData* cdata);
-    void threadAcquireLock (const CallbackManager& cbmanager, int user_event,
-                            const Event& event, CallbackData* cdata);
-    void threadReleaseLock (const CallbackManager& cbmanager, int user_event,
-                            const Event& event, CallbackData* cdata);
-    void threadTaskCreate  (const CallbackManager& cbmanager, int user_event,
-                            const Event& event, CallbackData* cdata);
-    void threadTaskComplete(const CallbackManager& cbmanager, int user_event,
-                            const Event& event, CallbackData* cdata);
-    void threadTaskSwitch  (const CallbackManager& cbmanager, int user_event,
-                            const Event& event, CallbackData* cdata);
+    void enter(OTF2_EvtWriter*   writer,
+               const GlobalDefs& defs,
+               const Event&      event);
+    void leave(OTF2_EvtWriter*   writer,
+               const GlobalDefs& defs,
+               const Event&      event);
+
+    void mpisend     (OTF2_EvtWriter*   writer,
+                      const GlobalDefs& defs,
+                      const Event&      event);
+    void mpirecv     (OTF2_EvtWriter*   writer,
+                      const GlobalDefs& defs,
+                      const Event&      event);
+    void mpisendreq  (OTF2_EvtWriter*   writer,
+                      const GlobalDefs& defs,
+                      const Event&      event);
+    void mpisendcomp (OTF2_EvtWriter*   writer,
+                      const GlobalDefs& defs,
+                      const Event&      event);
+    void mpirecvreq  (OTF2_EvtWriter*   writer,
+                      const GlobalDefs& defs,
+                      const Event&      event);
+    void mpirecvcomp (OTF2_EvtWriter*   writer,
+                      const GlobalDefs& defs,
+                      const Event&      event);
+    void mpireqtested(OTF2_EvtWriter*   writer,
+                      const GlobalDefs& defs,
+                      const Event&      event);
+    void mpicancelled(OTF2_EvtWriter*   writer,
+                      const GlobalDefs& defs,
+                      const Event&      event);
+    void mpicollbegin(OTF2_EvtWriter*   writer,
+                      const GlobalDefs& defs,
+                      const Event&      event);
+    void mpicollend  (OTF2_EvtWriter*   writer,
+                      const GlobalDefs& defs,
+                      const Event&      event);
+
+    void threadBegin       (OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event);
+    void threadEnd         (OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event);
+    void threadWait        (OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event);
+    void threadCreate      (OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event);
+    void threadTeamBegin   (OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event);
+    void threadTeamEnd     (OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event);
+    void threadFork        (OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event);
+    void threadJoin        (OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event);
+    void threadAcquireLock (OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event);
+    void threadReleaseLock (OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event);
+    void threadTaskCreate  (OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event);
+    void threadTaskComplete(OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event);
+    void threadTaskSwitch  (OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event);
 
     /// @}
     /// @name Internal I/O routines
     /// @{
 
+    void writeEvents     (OTF2_EvtWriter*   writer,
+                          const LocalTrace& trace,
+                          const GlobalDefs& defs);
+    void writeDefinitions(const GlobalDefs& defs,
+                          timestamp_t       earliest,
+                          timestamp_t       latest);
+
     uint32_t writeString   (OTF2_GlobalDefWriter* writer,
                             const std::string&    str);
     void writeSystemTree   (OTF2_GlobalDefWriter* writer,
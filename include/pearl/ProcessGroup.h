@@ -40,6 +40,7 @@ namespace pearl
 {
 //--- Forward declarations --------------------------------------------------
 
+class GlobalDefs;
 class String;
 
 
@@ -60,6 +61,16 @@ class String;
  *  communicator objects (see Comm and MpiComm). The numerical identifiers of
  *  the individual groups are globally defined and continuously enumerated,
  *  i.e., the ID is element of [0,@#process_groups-1].
+ *
+ *  To keep the memory footprint low and the rank translation fast also for
+ *  large groups, the membership is stored in a compressed representation
+ *  chosen automatically on construction: groups whose global ranks form an
+ *  arithmetic progression (e.g., 'WORLD', contiguous ranges, or strided
+ *  groups) only store the first rank and the stride, ascending groups with
+ *  a sufficiently dense rank range are indexed by a bitmap, and all other
+ *  groups fall back to an explicit rank list. Local/global rank translation
+ *  therefore takes constant time, except for sparse or unordered irregular
+ *  groups which require a binary search.
  **/
 /*-------------------------------------------------------------------------*/
 
@@ -205,21 +216,64 @@ class ProcessGroup
         /// %Process group name
         const String& mName;
 
-        /// Ordered list of global process identifiers (i.e., MPI ranks)
+        /// Ordered list of global process identifiers (i.e., MPI ranks);
+        /// empty for strided groups or once moved to shared memory by
+        /// PEARL_share_defs()
         RankContainer mRanks;
 
+        /// Pointer to the ordered list of global process identifiers, either
+        /// referring to @a mRanks or to a node-level shared memory segment
+        /// (NULL for strided groups)
+        const int* mRankData;
+
+        /// Number of global process identifiers
+        uint32_t mNumRanks;
+
+        /// Global process identifier of the first member (strided groups) or
+        /// of the lowest member (bitmap-indexed groups)
+        int mFirst;
+
+        /// Difference between the global process identifiers of consecutive
+        /// members (strided groups)
+        int mStride;
+
+        /// Membership bitmap relative to @a mFirst (bitmap-indexed groups)
+        std::vector<uint64_t> mBitmap;
+
+        /// Number of members preceding each bitmap word (bitmap-indexed
+        /// groups) or local ranks ordered by global process identifier
+        /// (unordered groups)
+        std::vector<uint32_t> mIndex;
+
+        /// Membership representation (strided, bitmap, sorted, unordered)
+        unsigned char mLayout;
+
         /// Group flags (SELF, WORLD, etc.)
         unsigned char mFlags;
 
 
         //--- Private methods & friends --------------------
 
+        void
+        initLayout();
+
         virtual std::ostream&
         print(std::ostream& stream) const;
 
         friend std::ostream&
         operator<<(std::ostream&       stream,
                    const ProcessGroup& item);
+        friend void
+        PEARL_share_defs(GlobalDefs& defs);
+
+
+        /// @name Copying (not allowed)
+        /// @{
+
+        ProcessGroup(const ProcessGroup& rhs);
+        ProcessGroup& operator=(const ProcessGroup& rhs);
+
+        /// @}
 };
 
 
@@ -0,0 +1,188 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#ifndef PEARL_REDUCTIONBUNDLE_H
+#define PEARL_REDUCTIONBUNDLE_H
+
+
+#include <vector>
+
+#include <stdint.h>
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file    ReductionBundle.h
+ *  @ingroup PEARL_base
+ *  @brief   Declaration of the class ReductionBundle.
+ *
+ *  This header file provides the declaration of the class ReductionBundle.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+namespace pearl
+{
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class   ReductionBundle
+ *  @ingroup PEARL_base
+ *  @brief   Combines multiple scalar reductions into a single operation.
+ *
+ *  The class ReductionBundle allows to register an arbitrary number of
+ *  scalar values, each with its own reduction operation (sum, minimum,
+ *  maximum, or minimum/maximum with location), which are then reduced
+ *  across all threads of the calling team and all processes by a single
+ *  call to flush(). This replaces sequences of individual reductions (each
+ *  requiring its own synchronization) by a single thread-level combination
+ *  followed by a single inter-process reduction.
+ *
+ *  All threads of all processes have to register the same sequence of
+ *  operations before calling flush(). Values added after a flush are
+ *  reduced by the subsequent one, i.e., a bundle can be used for multiple
+ *  dependent reduction phases. The results are identified by the handle
+ *  returned by add() and are available on all threads of all processes.
+ *  If multiple contributions share the same minimum/maximum value, the
+ *  lowest location is reported.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class ReductionBundle
+{
+    public:
+        //--- Type definitions -----------------------------
+
+        /// Reduction operations
+        enum Operation
+        {
+            SUM,       ///< Sum
+            MIN,       ///< Minimum
+            MAX,       ///< Maximum
+            MINLOC,    ///< Minimum and its location
+            MAXLOC     ///< Maximum and its location
+        };
+
+
+        //--- Public methods -------------------------------
+
+        /// @name Constructors & destructor
+        /// @{
+
+        /// @brief Default constructor.
+        ///
+        /// Creates a new, empty bundle.
+        ///
+        ReductionBundle();
+
+        /// @}
+        /// @name Registering values
+        /// @{
+
+        /// @brief Register a value.
+        ///
+        /// Registers the given @a value to be reduced using the operation
+        /// @a op by the next call to flush().
+        ///
+        /// @param op       Reduction operation
+        /// @param value    Local contribution
+        /// @param location Location associated with @a value (only used for
+        ///                 MINLOC and MAXLOC)
+        ///
+        /// @return Handle to query the result
+        ///
+        uint32_t
+        add(Operation op,
+            double    value,
+            uint64_t  location = 0);
+
+        /// @brief Remove all values.
+        ///
+        /// Removes all registered values and results from the bundle.
+        ///
+        void
+        clear();
+
+        /// @brief Get number of values.
+        ///
+        /// Returns the number of values registered since the last clear().
+        ///
+        /// @return Number of values
+        ///
+        uint32_t
+        size() const;
+
+        /// @}
+        /// @name Reduction
+        /// @{
+
+        /// @brief Reduce pending values.
+        ///
+        /// Reduces all values registered since the previous flush across all
+        /// threads of the calling team and all processes. This is a
+        /// collective operation which has to be called by all threads of all
+        /// processes.
+        ///
+        void
+        flush();
+
+        /// @}
+        /// @name Query results
+        /// @{
+
+        /// @brief Get reduced value.
+        ///
+        /// Returns the result of the reduction of the value identified by
+        /// @a handle. Before the corresponding flush(), the local
+        /// contribution is returned.
+        ///
+        /// @param handle Handle returned by add()
+        ///
+        /// @return Reduced value
+        ///
+        double
+        getValue(uint32_t handle) const;
+
+        /// @brief Get location of reduced value.
+        ///
+        /// Returns the location of the minimum/maximum value identified by
+        /// @a handle. For operations other than MINLOC and MAXLOC, the
+        /// result is undefined.
+        ///
+        /// @param handle Handle returned by add()
+        ///
+        /// @return Location
+        ///
+        uint64_t
+        getLocation(uint32_t handle) const;
+
+        /// @}
+
+
+    private:
+        //--- Data members ---------------------------------
+
+        /// Registered values (resp. results after a flush)
+        std::vector<double> mValues;
+
+        /// Associated locations
+        std::vector<uint64_t> mLocations;
+
+        /// Associated reduction operations
+        std::vector<Operation> mOperations;
+
+        /// Number of values already reduced
+        uint32_t mNumReduced;
+};
+}   // namespace pearl
+
+
+#endif   // !PEARL_REDUCTIONBUNDLE_H
@@ -18,6 +18,12 @@
 #define PEARL_PEARL_H
 
 
+#include <string>
+#include <vector>
+
+#include <pearl/pearl_types.h>
+
+
 /*-------------------------------------------------------------------------*/
 /**
  *  @file    pearl.h
@@ -39,6 +45,7 @@ namespace pearl
 
 class GlobalDefs;
 class LocalTrace;
+class Location;
 
 
 //--- Function prototypes ---------------------------------------------------
@@ -51,6 +58,12 @@ extern void PEARL_mpi_init();
 
 extern void PEARL_finalize();
 
+/// @}
+/// @name Definition sharing
+/// @{
+
+extern void PEARL_share_defs(GlobalDefs& defs);
+
 /// @}
 /// @name Call tree verification
 /// @{
@@ -64,6 +77,14 @@ extern void PEARL_verify_calltree(GlobalDefs& defs,
 
 extern void PEARL_mpi_unify_calltree(GlobalDefs& defs);
 
+/// @}
+/// @name Communicator creation
+/// @{
+
+extern void PEARL_mpi_create_comms(const GlobalDefs& defs);
+extern void PEARL_mpi_create_comms(const GlobalDefs&            defs,
+                                   const std::vector<uint32_t>& commIds);
+
 /// @}
 /// @name Trace preprocessing
 /// @{
@@ -72,6 +93,33 @@ extern void PEARL_preprocess_trace(const GlobalDefs& defs,
                                    const LocalTrace& trace);
 
 /// @}
+/// @name Preprocessed trace cache
+/// @{
+
+extern void PEARL_write_trace_cache(const GlobalDefs&  defs,
+                                    const LocalTrace&  trace,
+                                    const std::string& filename,
+                                    uint64_t           stamp);
+
+extern bool PEARL_check_trace_cache(const Location&    location,
+                                    const std::string& filename,
+                                    uint64_t           stamp);
+
+extern LocalTrace* PEARL_read_trace_cache(GlobalDefs&        defs,
+                                          const Location&    location,
+                                          const std::string& filename);
+
+/// @}
+/// @name Trace restriction
+/// @{
+
+extern void PEARL_restrict_trace(const GlobalDefs&        defs,
+                                 LocalTrace&              trace,
+                                 timestamp_t              begin,
+                                 timestamp_t              end,
+                                 const std::vector<bool>& retained);
+
+/// @}
 
 
 }   // namespace pearl
@@ -55,6 +55,10 @@ extern void PEARL_forward_replay (const LocalTrace&           trace,
 inline void PEARL_forward_replay (const LocalTrace&           trace,
                                   const CallbackManager&      cbmanager,
                                   CallbackData*               data);
+extern void PEARL_forward_replay (const LocalTrace&           trace,
+                                  const CallbackManager&      cbmanager,
+                                  CallbackData*               data,
+                                  event_mask_t                mask);
 
 
 extern void PEARL_backward_replay(const LocalTrace&                   trace,
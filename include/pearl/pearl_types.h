@@ -115,6 +115,10 @@ enum event_t {
   NUM_EVENT_TYPES   // symbolic name to retrieve the number of event types
 };
 
+/// Data type for sets of event types, using one bit per (non-group) event
+/// type (see event_mask())
+typedef uint64_t event_mask_t;
+
 
 //--- Constants -------------------------------------------------------------
 
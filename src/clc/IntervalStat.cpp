@@ -22,13 +22,8 @@
 #include <cstdio>
 #include <iostream>
 
-#include <mpi.h>
-#ifdef _OPENMP
-  #include "OmpCommunication.h"
-  #include "OmpData.h"
-#endif
-
-#include "Operator.h"
+#include <pearl/Location.h>
+#include <pearl/ReductionBundle.h>
 
 using namespace std;
 using namespace pearl;
@@ -206,262 +201,122 @@ void IntervalStat::calculate_data()
 
 void IntervalStat::calculate_relative_errors()
 {
-  timestamp_t sum_intervals = 0.0;
-  timestamp_t sum_abs       = 0.0;
-  timestamp_t sum_rel       = 0.0;
-  timestamp_t num_intervals = 0.0;
-  timestamp_t vec_size      = (timestamp_t) data_vec.size();
-
-#ifdef _OPENMP
+  const uint64_t        location = trace.get_location().getId();
+  const statistic_data* first    = data_vec.empty() ? NULL : &data_vec.front();
+  const statistic_data* last     = data_vec.empty() ? NULL : &data_vec.back();
+
+  // Reduce extrema & sums across threads and processes at once, then
+  // determine the companion values of the extremal intervals
+  ReductionBundle bundle;
+  uint32_t max_id  = add_extreme(bundle, last, STAT_REL, true, location);
+  uint32_t min_id  = add_extreme(bundle, first, STAT_REL, false, location);
+  uint32_t abs_id  = bundle.add(ReductionBundle::SUM, abs_sum);
+  uint32_t rel_id  = bundle.add(ReductionBundle::SUM, rel_sum);
+  uint32_t time_id = bundle.add(ReductionBundle::SUM, t_sum_time);
+  uint32_t num_id  = bundle.add(ReductionBundle::SUM, data_vec.size());
+  bundle.flush();
+
+  uint32_t max_data_id = add_companions(bundle, max_id, last, location);
+  uint32_t min_data_id = add_companions(bundle, min_id, first, location);
+  bundle.flush();
 
-  timestamp_t ex_data;
-
-  timestamp_t local_data = data_vec[((long)vec_size)-1].rel;
-  OMP_Allreduce_max(local_data, omp_global_max_timestamp);
-  local_data = omp_global_max_timestamp;
   #pragma omp master
   {
-    MPI_Allreduce(&local_data, &ex_data, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-    if (m_rank == 0) {
-      printf("\n\tGlobal maximum relative error\n");
-      printf("\t%.9f\n", ex_data);
-    }
-  }
-
-  local_data = data_vec[0].rel;
-  OMP_Allreduce_min(local_data, omp_global_min_timestamp);
-  local_data = omp_global_min_timestamp;
-  #pragma omp master  
-  {
-    MPI_Allreduce(&local_data, &ex_data, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
-    if (m_rank == 0) {
-      printf("\tGlobal minimum relative error\n");
-      printf("\t%.9f\n", ex_data);
-    }
-  }
-
-  OMP_Allreduce_sum(abs_sum, omp_global_sum_timestamp);
-  timestamp_t omp_sum_abs = omp_global_sum_timestamp;
-  #pragma omp master
-  {
-    MPI_Allreduce(&omp_sum_abs, &sum_abs, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  }
-
-  OMP_Allreduce_sum(rel_sum, omp_global_sum_timestamp);
-  timestamp_t omp_sum_rel = omp_global_sum_timestamp;
-  #pragma omp master
-  {
-    MPI_Allreduce(&omp_sum_rel, &sum_rel, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  }
-   
-  OMP_Allreduce_sum(t_sum_time, omp_global_sum_timestamp);
-  timestamp_t omp_sum_intervals = omp_global_sum_timestamp;
-  #pragma omp master
-  {
-    MPI_Allreduce(&omp_sum_intervals, &sum_intervals, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  }
-
-  OMP_Allreduce_sum(vec_size, omp_global_sum_timestamp);
-  timestamp_t omp_num_intervals = omp_global_sum_timestamp;
-  #pragma omp master
-  {
-    MPI_Allreduce(&omp_num_intervals, &num_intervals, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  }
-
-  #pragma omp master
-  {   
     if (m_rank == 0) {
+      statistic_data ex_data = get_companions(bundle, max_data_id);
+      printf("\n\tGlobal maximum relative error; abs. error; org. difference; synchronized difference\n");
+      printf("\t%.9f; %.9f; %.9f; %.9f\n", ex_data.rel, ex_data.abs, ex_data.org, ex_data.syn);
+
+      ex_data = get_companions(bundle, min_data_id);
+      printf("\tGlobal minimum relative error; abs. error; org. difference; synchronized difference\n");
+      printf("\t%.9f; %.9f; %.9f; %.9f\n", ex_data.rel, ex_data.abs, ex_data.org, ex_data.syn);
+
+      timestamp_t sum_abs       = bundle.getValue(abs_id);
+      timestamp_t sum_rel       = bundle.getValue(rel_id);
+      timestamp_t sum_intervals = bundle.getValue(time_id);
+      timestamp_t num_intervals = bundle.getValue(num_id);
       printf("\tGlobal average relative error (naive);\n\t%.9f\n", sum_rel/num_intervals);
       printf("\tGlobal average relative error (weighted);\n\t%.9f", (sum_abs/sum_intervals));
     }
   }
-
-#else   // !_OPENMP
-
-  statistic_data ex_data;
-
-  MPI_Allreduce(&data_vec[((long) vec_size) -1 ], &ex_data, 1, STAT_DATA, STAT_REL_MAX, MPI_COMM_WORLD);
-  if (m_rank == 0) {
-    printf("\n\tGlobal maximum relative error; abs. error; org. difference; synchronized difference\n");
-    printf("\t%.9f; %.9f; %.9f; %.9f\n", ex_data.rel, ex_data.abs, ex_data.org, ex_data.syn);
-  }
-  
-  MPI_Allreduce(&data_vec[0], &ex_data, 1, STAT_DATA, STAT_REL_MIN, MPI_COMM_WORLD);
-  if (m_rank == 0) {
-    printf("\tGlobal minimum relative error; abs. error; org. difference; synchronized difference\n");
-    printf("\t%.9f; %.9f; %.9f; %.9f\n", ex_data.rel, ex_data.abs, ex_data.org, ex_data.syn);
-  }
-
-  MPI_Allreduce(&abs_sum, &sum_abs, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  MPI_Allreduce(&rel_sum, &sum_rel, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  MPI_Allreduce(&t_sum_time, &sum_intervals, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  MPI_Allreduce(&vec_size, &num_intervals, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-   
-  if (m_rank == 0) {
-    printf("\tGlobal average relative error (naive);\n\t%.9f\n", sum_rel/num_intervals);
-    printf("\tGlobal average relative error (weighted);\n\t%.9f", (sum_abs/sum_intervals));
-  }
-
-#endif   // !_OPENMP
 }
 
 
 void IntervalStat::calculate_absolute_errors()
 {
-  timestamp_t sum_abs       = 0.0;
-  timestamp_t num_intervals = 0.0;
-  timestamp_t vec_size      = (timestamp_t) data_vec.size();
-
-#ifdef _OPENMP
+  const uint64_t        location = trace.get_location().getId();
+  const statistic_data* first    = data_vec.empty() ? NULL : &data_vec.front();
+  const statistic_data* last     = data_vec.empty() ? NULL : &data_vec.back();
+
+  // Reduce extrema & sums across threads and processes at once, then
+  // determine the companion values of the extremal intervals
+  ReductionBundle bundle;
+  uint32_t max_id = add_extreme(bundle, last, STAT_ABS, true, location);
+  uint32_t min_id = add_extreme(bundle, first, STAT_ABS, false, location);
+  uint32_t abs_id = bundle.add(ReductionBundle::SUM, abs_sum);
+  uint32_t num_id = bundle.add(ReductionBundle::SUM, data_vec.size());
+  bundle.flush();
+
+  uint32_t max_data_id = add_companions(bundle, max_id, last, location);
+  uint32_t min_data_id = add_companions(bundle, min_id, first, location);
+  bundle.flush();
 
-  timestamp_t ex_data;
-  
-  OMP_Allreduce_sum(abs_sum, omp_global_sum_timestamp);
-  timestamp_t omp_sum_abs = omp_global_sum_timestamp;
-  
-  OMP_Allreduce_sum(vec_size, omp_global_sum_timestamp);
-  timestamp_t omp_num_intervals = omp_global_sum_timestamp;
-  
-  #pragma omp master
-  { 
-    MPI_Allreduce(&omp_sum_abs, &sum_abs, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    MPI_Allreduce(&omp_num_intervals, &num_intervals, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    if (m_rank == 0)
-      printf("\n\tGlobal average absolute error,\n\t%.9f\n", (sum_abs/num_intervals));
-  }
-  
-  timestamp_t local_data = data_vec[((long)vec_size)-1].abs;
-  OMP_Allreduce_max(local_data, omp_global_max_timestamp);
-  local_data = omp_global_max_timestamp;
   #pragma omp master
   {
-    MPI_Allreduce(&local_data, &ex_data, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);   
     if (m_rank == 0) {
-      printf("\tGlobal maximum absolute error\n");
-      printf("\t%.9f\n", ex_data);
-    }
-  }
-
-  local_data = data_vec[0].abs;
-  OMP_Allreduce_min(local_data, omp_global_min_timestamp);
-  local_data = omp_global_min_timestamp;
-  #pragma omp master
-  { 
-    MPI_Allreduce(&local_data, &ex_data, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
-    if (m_rank == 0) {
-      printf("\tGlobal minimum absolute error\n");
-      printf("\t%.9f\n", ex_data);
-    }
-  }
+      statistic_data ex_data = get_companions(bundle, max_data_id);
+      printf("\t\nGlobal maximum absolute error; rel. error; org. difference; synchronized difference\n");
+      printf("\t%.9f; %.9f; %.9f; %.9f\n", ex_data.abs, ex_data.rel, ex_data.org, ex_data.syn);
 
-#else   // !_OPENMP
+      ex_data = get_companions(bundle, min_data_id);
+      printf("\tGlobal minimum absolute error; rel. error; org. difference; synchronized difference\n");
+      printf("\t%.9f; %.9f; %.9f; %.9f\n", ex_data.abs, ex_data.rel, ex_data.org, ex_data.syn);
 
-  statistic_data ex_data;
-    
-  MPI_Allreduce(&data_vec[((long)vec_size)-1], &ex_data, 1, STAT_DATA, STAT_ABS_MAX, MPI_COMM_WORLD);   
-  if (m_rank == 0) {
-    printf("\t\nGlobal maximum absolute error; rel. error; org. difference; synchronized difference\n");
-    printf("\t%.9f; %.9f; %.9f; %.9f\n", ex_data.abs, ex_data.rel, ex_data.org, ex_data.syn);
-  }
-
-  MPI_Allreduce(&data_vec[0], &ex_data, 1, STAT_DATA, STAT_ABS_MIN, MPI_COMM_WORLD);
-  if (m_rank == 0) {
-    printf("\tGlobal minimum absolute error; rel. error; org. difference; synchronized difference\n");
-    printf("\t%.9f; %.9f; %.9f; %.9f\n", ex_data.abs, ex_data.rel, ex_data.org, ex_data.syn);
+      timestamp_t sum_abs       = bundle.getValue(abs_id);
+      timestamp_t num_intervals = bundle.getValue(num_id);
+      printf("\tGlobal average absolute error,\n\t%.9f\n", (sum_abs/num_intervals));
+    }
   }
-
-  MPI_Allreduce(&abs_sum, &sum_abs, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  MPI_Allreduce(&vec_size, &num_intervals, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  if (m_rank == 0)
-    printf("\tGlobal average absolute error,\n\t%.9f\n", (sum_abs/num_intervals));
-   
-#endif   // !_OPENMP
 }
 
 
-void IntervalStat::calculate_histogram_class(statistic_data data, 
-					     timestamp_t    num_data,
-					     timestamp_t    num_interval, 
-					     timestamp_t    g_org_exe_time, 
-					     timestamp_t    g_sync_exe_time)
+uint32_t IntervalStat::add_histogram_class(ReductionBundle&      bundle,
+                                           const statistic_data& data,
+                                           timestamp_t           num_data)
 {
-  timestamp_t num_g    = 0.0;
-  timestamp_t sum_abso = 0.0;
-  timestamp_t sum_sync = 0.0;
-  timestamp_t sum_orig = 0.0;
-
-#ifdef _OPENMP
-  OMP_Allreduce_sum(data.abs, omp_global_sum_timestamp);
-  data.abs = omp_global_sum_timestamp;
-#endif   // _OPENMP
-
-  #pragma omp master
-  {
-    MPI_Allreduce(&data.abs, &sum_abso, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  }
-
-#ifdef _OPENMP
-  OMP_Allreduce_sum(data.syn, omp_global_sum_timestamp);
-  data.syn = omp_global_sum_timestamp;
-#endif   // _OPENMP
-
-  #pragma omp master
-  {
-    MPI_Allreduce(&data.syn, &sum_sync, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  }
-
-#ifdef _OPENMP
-  OMP_Allreduce_sum(data.org, omp_global_sum_timestamp);
-  data.org = omp_global_sum_timestamp;
-#endif   // _OPENMP
+  uint32_t handle = bundle.add(ReductionBundle::SUM, num_data);
+  bundle.add(ReductionBundle::SUM, data.org);
+  bundle.add(ReductionBundle::SUM, data.syn);
+  bundle.add(ReductionBundle::SUM, data.abs);
 
-  #pragma omp master
-  {
-    MPI_Allreduce(&data.org, &sum_orig, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  }
+  return handle;
+}
 
-#ifdef _OPENMP
-  OMP_Allreduce_sum(num_data, omp_global_sum_timestamp);
-  num_data = omp_global_sum_timestamp;
-  #pragma omp barrier
-#endif   // _OPENMP
 
-  #pragma omp master 
-  {
-    MPI_Allreduce(&num_data, &num_g, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    if (m_rank == 0) {
-      printf("%.9f ; %.9f; %.9f; %.0f; %.9f; %.9f; %.9f; %.9f; %.9f\n",
-             num_g/num_interval, sum_orig/g_org_exe_time, sum_sync/g_sync_exe_time,
-             num_g, sum_orig, sum_sync, sum_abso, g_org_exe_time, g_sync_exe_time);
-    }
- }
+void IntervalStat::calculate_histogram_class(const char*            label,
+                                             const ReductionBundle& bundle,
+                                             uint32_t               handle,
+                                             timestamp_t            num_interval,
+                                             timestamp_t            g_org_exe_time,
+                                             timestamp_t            g_sync_exe_time)
+{
+  timestamp_t num_g    = bundle.getValue(handle);
+  timestamp_t sum_orig = bundle.getValue(handle + 1);
+  timestamp_t sum_sync = bundle.getValue(handle + 2);
+  timestamp_t sum_abso = bundle.getValue(handle + 3);
+
+  printf("\t%s; ", label);
+  printf("%.9f ; %.9f; %.9f; %.0f; %.9f; %.9f; %.9f; %.9f; %.9f\n",
+         num_g/num_interval, sum_orig/g_org_exe_time, sum_sync/g_sync_exe_time,
+         num_g, sum_orig, sum_sync, sum_abso, g_org_exe_time, g_sync_exe_time);
 }
 
 
 void IntervalStat::calculate_histograms()
 {
-  timestamp_t num_interval = 0.0;
-  timestamp_t vec_size     = (timestamp_t) data_vec.size();
-  
+  long        vec_size      = data_vec.size();
   timestamp_t org_exe_time  = org_ts[num_events-1] - org_ts[0];
   timestamp_t sync_exe_time = tsa[num_events-1] - tsa[0];
-  
-#ifdef _OPENMP
-  OMP_Allreduce_sum(vec_size, omp_global_sum_timestamp);
-  timestamp_t local_vec_size = omp_global_sum_timestamp;
-#else   // !OPENMP
-  timestamp_t local_vec_size = vec_size;
-#endif   // !_OPENMP
-
-  #pragma omp master
-  {
-    MPI_Allreduce(&local_vec_size, &num_interval, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  }
-
-#ifdef _OPENMP
-  OMP_Bcast(num_interval, omp_global_sum_timestamp);
-  num_interval = omp_global_sum_timestamp;
-#endif   // _OPENMP
 
   long i = 0;
   statistic_data m_tmp;
@@ -532,6 +387,26 @@ void IntervalStat::calculate_histograms()
      }
   } 
 
+  statistic_data max_01 = max_1;
+  max_01.abs += max_0.abs;
+  max_01.syn += max_0.syn;
+  max_01.org += max_0.org;
+
+  // Reduce totals and all error classes across threads and processes at once
+  ReductionBundle bundle;
+  uint32_t num_id  = bundle.add(ReductionBundle::SUM, vec_size);
+  uint32_t org_id  = bundle.add(ReductionBundle::SUM, org_exe_time);
+  uint32_t sync_id = bundle.add(ReductionBundle::SUM, sync_exe_time);
+  uint32_t class_0  = add_histogram_class(bundle, max_0, num_0);
+  uint32_t class_1  = add_histogram_class(bundle, max_1, num_1);
+  uint32_t class_01 = add_histogram_class(bundle, max_01, num_0 + num_1);
+  uint32_t class_2  = add_histogram_class(bundle, max_2, num_2);
+  uint32_t class_3  = add_histogram_class(bundle, max_3, num_3);
+  uint32_t class_4  = add_histogram_class(bundle, max_4, num_4);
+  uint32_t class_5  = add_histogram_class(bundle, max_5, num_5);
+  uint32_t class_6  = add_histogram_class(bundle, max_6, num_6);
+  bundle.flush();
+
   #pragma omp master
   {
     if (m_rank == 0) {
@@ -563,106 +438,29 @@ void IntervalStat::calculate_histograms()
       printf("\tH;");
       printf("\tI;");
       printf("\tJ;\n");
-    }
-  }
-
-  timestamp_t g_org_exe_time = 0.0;
-  timestamp_t g_sync_exe_time = 0.0;
-
-  timestamp_t local_org_exe_time = org_exe_time;
-
-#ifdef _OPENMP
-  OMP_Allreduce_sum(local_org_exe_time, omp_global_sum_timestamp);
-  local_org_exe_time = omp_global_sum_timestamp;
-#endif   // _OPENMP
-
-  #pragma omp master
-  {
-    MPI_Allreduce(&local_org_exe_time, &g_org_exe_time, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  }
-
-#ifdef _OPENMP
-  OMP_Bcast(g_org_exe_time, omp_global_sum_timestamp);
-  g_org_exe_time = omp_global_sum_timestamp;
-#endif   // _OPENMP
-
-  timestamp_t local_sync_exe_time = sync_exe_time;
-
-#ifdef _OPENMP
-  OMP_Allreduce_sum(local_sync_exe_time, omp_global_sum_timestamp);
-  local_sync_exe_time = omp_global_sum_timestamp;
-#endif   // _OPENMP
-
-  #pragma omp master
-  {
-    MPI_Allreduce(&local_sync_exe_time, &g_sync_exe_time, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  }
-
-#ifdef _OPENMP
-  OMP_Bcast(g_sync_exe_time, omp_global_sum_timestamp);
-  g_sync_exe_time = omp_global_sum_timestamp;
-#endif   // _OPENMP
-
-  #pragma omp master
-  {
-    if (m_rank == 0)
-      printf("\t'=0.0%%; ");
-  }
-  calculate_histogram_class(max_0, num_0, num_interval, g_org_exe_time, g_sync_exe_time);
-
-  #pragma omp master
-  {
-    if (m_rank == 0)
-      printf("\t>0.0%% und <= 0.01%%; ");
-  }
-  calculate_histogram_class(max_1, num_1, num_interval, g_org_exe_time, g_sync_exe_time);
-
-  max_1.abs +=max_0.abs;
-  max_1.syn +=max_0.syn;
-  max_1.org +=max_0.org;
-  num_1 += num_0;
 
-  #pragma omp master
-  {
-    if (m_rank == 0)
-      printf("\t<= 0.01; ");
-  }
-  calculate_histogram_class(max_1, num_1, num_interval, g_org_exe_time, g_sync_exe_time);
-
-  #pragma omp master
-  {
-    if (m_rank == 0)
-      printf("\t> 0.01%% and <= 0.1%%; ");
-  }
-  calculate_histogram_class(max_2, num_2, num_interval, g_org_exe_time, g_sync_exe_time);
-
-  #pragma omp master
-  {
-    if (m_rank == 0)
-      printf("\t>0.1%% and <= 1%%; ");
-  }
-  calculate_histogram_class(max_3, num_3, num_interval, g_org_exe_time, g_sync_exe_time);
-
-  #pragma omp master
-  {
-    if (m_rank == 0)
-      printf("\t> 1%% and <= 10%%; ");
-  }
-  calculate_histogram_class(max_4, num_4, num_interval, g_org_exe_time, g_sync_exe_time);
-
-  #pragma omp master
-  {
-    if (m_rank == 0)
-      printf("\t> 10%% and <= 100%%; ");
-  }
-  calculate_histogram_class(max_5, num_5, num_interval, g_org_exe_time, g_sync_exe_time);
-
-  #pragma omp master
-  {
-    if (m_rank == 0)
-      printf("\t> 100%%; ");
+      timestamp_t num_interval    = bundle.getValue(num_id);
+      timestamp_t g_org_exe_time  = bundle.getValue(org_id);
+      timestamp_t g_sync_exe_time = bundle.getValue(sync_id);
+
+      calculate_histogram_class("'=0.0%", bundle, class_0,
+                                num_interval, g_org_exe_time, g_sync_exe_time);
+      calculate_histogram_class(">0.0% und <= 0.01%", bundle, class_1,
+                                num_interval, g_org_exe_time, g_sync_exe_time);
+      calculate_histogram_class("<= 0.01", bundle, class_01,
+                                num_interval, g_org_exe_time, g_sync_exe_time);
+      calculate_histogram_class("> 0.01% and <= 0.1%", bundle, class_2,
+                                num_interval, g_org_exe_time, g_sync_exe_time);
+      calculate_histogram_class(">0.1% and <= 1%", bundle, class_3,
+                                num_interval, g_org_exe_time, g_sync_exe_time);
+      calculate_histogram_class("> 1% and <= 10%", bundle, class_4,
+                                num_interval, g_org_exe_time, g_sync_exe_time);
+      calculate_histogram_class("> 10% and <= 100%", bundle, class_5,
+                                num_interval, g_org_exe_time, g_sync_exe_time);
+      calculate_histogram_class("> 100%", bundle, class_6,
+                                num_interval, g_org_exe_time, g_sync_exe_time);
+    }
   }
-  calculate_histogram_class(max_6, num_6, num_interval, g_org_exe_time, g_sync_exe_time);
 }
 
 
@@ -81,11 +81,15 @@ class IntervalStat
     void calculate_relative_errors();
     void calculate_absolute_errors();
     void calculate_histograms();
-    void calculate_histogram_class(statistic_data     data, 
-                                   pearl::timestamp_t num_data,
-                                   pearl::timestamp_t num_interval, 
-                                   pearl::timestamp_t g_org_exe_time,
-                                   pearl::timestamp_t g_sync_exe_time);
+    void calculate_histogram_class(const char*                   label,
+                                   const pearl::ReductionBundle& bundle,
+                                   uint32_t                      handle,
+                                   pearl::timestamp_t            num_interval,
+                                   pearl::timestamp_t            g_org_exe_time,
+                                   pearl::timestamp_t            g_sync_exe_time);
+    uint32_t add_histogram_class(pearl::ReductionBundle& bundle,
+                                 const statistic_data&   data,
+                                 pearl::timestamp_t      num_data);
 
     // Helper function
     void prepare_calculation(pearl::timestamp_t* t_array);
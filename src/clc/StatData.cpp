@@ -17,6 +17,10 @@
 #include <config.h>
 #include "StatData.h"
 
+#include <cfloat>
+
+#include <pearl/ReductionBundle.h>
+
 using namespace pearl;
 
 
@@ -37,3 +41,51 @@ bool operator<(const statistic_data& a, const statistic_data& b)
     return (a.abs < b.abs);
   return false;
 }
+
+
+uint32_t add_extreme(ReductionBundle&      bundle,
+                     const statistic_data* local,
+                     stat_t                att,
+                     bool                  maximum,
+                     uint64_t              location)
+{
+  // Use neutral element if no local data is available
+  timestamp_t value = maximum ? -DBL_MAX : DBL_MAX;
+  if (local)
+    value = (att == STAT_REL) ? local->rel : local->abs;
+
+  return bundle.add(maximum ? ReductionBundle::MAXLOC : ReductionBundle::MINLOC,
+                    value, location);
+}
+
+
+uint32_t add_companions(ReductionBundle&      bundle,
+                        uint32_t              extreme,
+                        const statistic_data* local,
+                        uint64_t              location)
+{
+  // Only the location holding the extremum contributes
+  statistic_data data = { 0.0, 0.0, 0.0, 0.0 };
+  if (local && bundle.getLocation(extreme) == location)
+    data = *local;
+
+  uint32_t handle = bundle.add(ReductionBundle::SUM, data.rel);
+  bundle.add(ReductionBundle::SUM, data.abs);
+  bundle.add(ReductionBundle::SUM, data.org);
+  bundle.add(ReductionBundle::SUM, data.syn);
+
+  return handle;
+}
+
+
+statistic_data get_companions(const ReductionBundle& bundle,
+                              uint32_t               handle)
+{
+  statistic_data data;
+  data.rel = bundle.getValue(handle);
+  data.abs = bundle.getValue(handle + 1);
+  data.org = bundle.getValue(handle + 2);
+  data.syn = bundle.getValue(handle + 3);
+
+  return data;
+}
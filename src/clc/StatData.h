@@ -22,6 +22,12 @@
 #include "clc_types.h"
 
 
+namespace pearl
+{
+class ReductionBundle;
+}   // namespace pearl
+
+
 struct statistic_data
 {
   pearl::timestamp_t rel; 
@@ -35,4 +41,22 @@ bool operator< (const statistic_data& a, const statistic_data& b);
 void set_sort_att (stat_t att); 
 
 
+// Global extrema including the companion values of the extremal entry;
+// determined by two flushes of the bundle: add_extreme() registers the
+// extremum of attribute 'att' (local == NULL if no data is available),
+// add_companions() the values of the winning entry after the first flush,
+// and get_companions() retrieves them after the second flush.
+uint32_t add_extreme(pearl::ReductionBundle& bundle,
+                     const statistic_data*   local,
+                     stat_t                  att,
+                     bool                    maximum,
+                     uint64_t                location);
+uint32_t add_companions(pearl::ReductionBundle& bundle,
+                        uint32_t                extreme,
+                        const statistic_data*   local,
+                        uint64_t                location);
+statistic_data get_companions(const pearl::ReductionBundle& bundle,
+                              uint32_t                      handle);
+
+
 #endif   // !CLC_STATDATA_H
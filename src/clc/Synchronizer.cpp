@@ -32,6 +32,7 @@
 #include <pearl/MpiCollEnd_rep.h>
 #include <pearl/MpiComm.h>
 #include <pearl/ProcessGroup.h>
+#include <pearl/ReductionBundle.h>
 #include <pearl/Region.h>
 #include <pearl/String.h>
 #include <pearl/pearl_replay.h>
@@ -902,43 +903,27 @@ void Synchronizer::print_statistics()
   timestamp_t gl_corr       = r_stat->get_num_clock_corr();
   timestamp_t gl_max_error  = r_stat->get_max_clock_error();
   timestamp_t gl_error      = r_stat->get_clock_error();
-  timestamp_t gl_num        = 0.0;
-  timestamp_t num           = (timestamp_t) trace.num_events ();
-  timestamp_t gl_violations = 0.0;
-  timestamp_t violations    = (timestamp_t) m_clc->get_num_viol();
-  timestamp_t gl_max_slope     = 0.0;
 
-  int sum_p2p_violation     = 0;
-  int p2p_violation         = m_clc->get_p2p_viol();
-  int sum_coll_violation    = 0;
-  int coll_violation        = m_clc->get_coll_viol();
-  int sum_omp_violation     = 0;
-  int omp_violation         =m_clc->get_omp_viol();
+  // Reduce all counters across threads and processes at once
+  ReductionBundle bundle;
+  uint32_t num_id        = bundle.add(ReductionBundle::SUM, trace.num_events());
+  uint32_t violations_id = bundle.add(ReductionBundle::SUM, m_clc->get_num_viol());
+  uint32_t max_slope_id  = bundle.add(ReductionBundle::MAX, m_max_slope);
+  uint32_t p2p_id        = bundle.add(ReductionBundle::SUM, m_clc->get_p2p_viol());
+  uint32_t coll_id       = bundle.add(ReductionBundle::SUM, m_clc->get_coll_viol());
+  uint32_t omp_id        = bundle.add(ReductionBundle::SUM, m_clc->get_omp_viol());
+  bundle.flush();
 
-#ifdef _OPENMP
-  OMP_Allreduce_sum(num, omp_global_sum_timestamp);
-  num = omp_global_sum_timestamp;
-  OMP_Allreduce_sum(violations, omp_global_sum_timestamp);
-  violations = omp_global_sum_timestamp;
-  OMP_Allreduce_max(m_max_slope, omp_global_max_timestamp);
-  m_max_slope = omp_global_max_timestamp;
-  OMP_Allreduce_sum(p2p_violation, omp_global_sum_count);
-  p2p_violation = omp_global_sum_count;
-  OMP_Allreduce_sum(coll_violation, omp_global_sum_count);
-  coll_violation = omp_global_sum_count;
-  OMP_Allreduce_sum(omp_violation, omp_global_sum_count);
-  omp_violation = omp_global_sum_count;
-#endif   // _OPENMP
+  timestamp_t gl_num        = bundle.getValue(num_id);
+  timestamp_t gl_violations = bundle.getValue(violations_id);
+  timestamp_t gl_max_slope  = bundle.getValue(max_slope_id);
+
+  int sum_p2p_violation     = (int) bundle.getValue(p2p_id);
+  int sum_coll_violation    = (int) bundle.getValue(coll_id);
+  int sum_omp_violation     = (int) bundle.getValue(omp_id);
 
   #pragma omp master
   {
-    MPI_Allreduce(&num, &gl_num, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    MPI_Allreduce(&violations, &gl_violations, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    MPI_Allreduce(&m_max_slope, &gl_max_slope, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-    MPI_Allreduce(&p2p_violation, &sum_p2p_violation, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-    MPI_Allreduce(&coll_violation, &sum_coll_violation, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-    MPI_Allreduce(&omp_violation, &sum_omp_violation, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-
     // Print statistics only on master rank
     int rank;
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
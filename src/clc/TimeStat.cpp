@@ -18,18 +18,12 @@
 #include "TimeStat.h"
 
 #include <algorithm>
-#include <cfloat>
 #include <cmath>
 #include <cstdio>
 #include <iostream>
 
-#include <mpi.h>
-#ifdef _OPENMP
-  #include "OmpData.h"
-  #include "OmpCommunication.h"
-#endif
-
-#include "Operator.h"
+#include <pearl/Location.h>
+#include <pearl/ReductionBundle.h>
 
 using namespace std;
 using namespace pearl;
@@ -181,195 +175,90 @@ void TimeStat::calculate_data()
 
 void TimeStat::calculate_relative_errors()
 {  
-  timestamp_t sum_intervals = 0.0;
-  timestamp_t sum_abs       = 0.0;
-  timestamp_t sum_rel       = 0.0;
-  timestamp_t num_intervals = 0.0;
-  timestamp_t vec_size      = (timestamp_t) data_vec.size();
-
-#ifdef _OPENMP
-
-  timestamp_t ex_data;
-
-  timestamp_t local_data = data_vec[((long)vec_size)-1].rel;
-  OMP_Allreduce_max(local_data, omp_global_max_timestamp);
-  local_data = omp_global_max_timestamp;
-  #pragma omp master
-  {
-    MPI_Allreduce(&local_data, &ex_data, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-    if (m_rank == 0) {
-      printf("\n\tGlobal maximum relative error\n");
-      printf("\t%.9f\n", ex_data);
-    }
-  }
-
-  local_data = data_vec[0].rel;
-  OMP_Allreduce_min(local_data, omp_global_min_timestamp);
-  local_data = omp_global_min_timestamp;
-  #pragma omp master
-  {
-    MPI_Allreduce(&local_data, &ex_data, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
-    if (m_rank == 0) {
-      printf("\tGlobal minimum relative error\n");
-      printf("\t%.9f\n", ex_data);
-    }
-  }
+  const uint64_t        location = trace.get_location().getId();
+  const statistic_data* first    = data_vec.empty() ? NULL : &data_vec.front();
+  const statistic_data* last     = data_vec.empty() ? NULL : &data_vec.back();
+
+  // Reduce extrema & sums across threads and processes at once, then
+  // determine the companion values of the extremal entries
+  ReductionBundle bundle;
+  uint32_t max_id  = add_extreme(bundle, last, STAT_REL, true, location);
+  uint32_t min_id  = add_extreme(bundle, first, STAT_REL, false, location);
+  uint32_t abs_id  = bundle.add(ReductionBundle::SUM, abs_sum);
+  uint32_t rel_id  = bundle.add(ReductionBundle::SUM, rel_sum);
+  uint32_t time_id = bundle.add(ReductionBundle::SUM, t_sum_time);
+  uint32_t num_id  = bundle.add(ReductionBundle::SUM, data_vec.size());
+  bundle.flush();
+
+  uint32_t max_data_id = add_companions(bundle, max_id, last, location);
+  uint32_t min_data_id = add_companions(bundle, min_id, first, location);
+  bundle.flush();
 
-  OMP_Allreduce_sum(abs_sum, omp_global_sum_timestamp);
-  timestamp_t omp_sum_abs = omp_global_sum_timestamp;
   #pragma omp master
   {
-    MPI_Allreduce(&omp_sum_abs, &sum_abs, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  }
-
-  OMP_Allreduce_sum(rel_sum, omp_global_sum_timestamp);
-  timestamp_t omp_sum_rel = omp_global_sum_timestamp;
-  #pragma omp master
-  {
-    MPI_Allreduce(&omp_sum_rel, &sum_rel, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  }
-
-  OMP_Allreduce_sum(t_sum_time, omp_global_sum_timestamp);
-  timestamp_t omp_sum_intervals = omp_global_sum_timestamp;
-  #pragma omp master
-  {
-    MPI_Allreduce(&omp_sum_intervals, &sum_intervals, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  }
-
-  OMP_Allreduce_sum(vec_size, omp_global_sum_timestamp);
-  timestamp_t omp_num_intervals = omp_global_sum_timestamp;
-  #pragma omp master
-  {
-    MPI_Allreduce(&omp_num_intervals, &num_intervals, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
     if (m_rank == 0) {
+      statistic_data ex_data = get_companions(bundle, max_data_id);
+      printf("\n\tGlobal maximum relative error; abs. error; org. difference; synchronized difference\n");
+      printf("\t%.9f; %.9f; %.9f; %.9f\n", ex_data.rel, ex_data.abs, ex_data.org, ex_data.syn);
+
+      ex_data = get_companions(bundle, min_data_id);
+      printf("\tGlobal minimum relative error; abs. error; org. difference; synchronized difference\n");
+      printf("\t%.9f; %.9f; %.9f; %.9f\n", ex_data.rel, ex_data.abs, ex_data.org, ex_data.syn);
+
+      timestamp_t sum_abs       = bundle.getValue(abs_id);
+      timestamp_t sum_rel       = bundle.getValue(rel_id);
+      timestamp_t sum_intervals = bundle.getValue(time_id);
+      timestamp_t num_intervals = bundle.getValue(num_id);
       printf("\tGlobal average relative error (naive);\n\t%.9f\n", sum_rel/num_intervals);
       printf("\tGlobal average relative error (weighted);\n\t%.9f", (sum_abs/sum_intervals));
     }
   }
-
-#else   // _!OPENMP
-
-  statistic_data ex_data;
-
-  MPI_Allreduce(&data_vec[((long)vec_size)-1], &ex_data, 1, STAT_DATA, STAT_REL_MAX, MPI_COMM_WORLD);
-  if (m_rank == 0) {
-    printf("\n\tGlobal maximum relative error; abs. error; org. difference; synchronized difference\n");
-    printf("\t%.9f; %.9f; %.9f; %.9f\n", ex_data.rel, ex_data.abs, ex_data.org, ex_data.syn);
-  }
-
-  MPI_Allreduce(&data_vec[0], &ex_data, 1, STAT_DATA, STAT_REL_MIN, MPI_COMM_WORLD);
-  if (m_rank == 0) {
-    printf("\tGlobal minimum relative error; abs. error; org. difference; synchronized difference\n");
-    printf("\t%.9f; %.9f; %.9f; %.9f\n", ex_data.rel, ex_data.abs, ex_data.org, ex_data.syn);
-  }
-
-  MPI_Allreduce(&abs_sum, &sum_abs, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  MPI_Allreduce(&rel_sum, &sum_rel, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  MPI_Allreduce(&t_sum_time, &sum_intervals, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  MPI_Allreduce(&vec_size, &num_intervals, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-   
-  if (m_rank == 0) {
-    printf("\tGlobal average relative error (naive);\n\t%.9f\n", sum_rel/num_intervals);
-    printf("\tGlobal average relative error (weighted);\n\t%.9f", (sum_abs/sum_intervals));
-  }
-
-#endif   // !_OPENMP
 }
 
 
 void TimeStat::calculate_absolute_errors()
 {
-  timestamp_t t_org         = -DBL_MAX; 
-  timestamp_t t_syn         = -DBL_MAX; 
-  timestamp_t sum_abs       = 0.0;
-  timestamp_t num_intervals = 0.0;
-  timestamp_t vec_size      = (timestamp_t) data_vec.size();
-
-#ifdef _OPENMP
+  const uint64_t        location = trace.get_location().getId();
+  const statistic_data* first    = data_vec.empty() ? NULL : &data_vec.front();
+  const statistic_data* last     = data_vec.empty() ? NULL : &data_vec.back();
+
+  // Reduce extrema, sums & overall execution times across threads and
+  // processes at once, then determine the companion values of the extremal
+  // entries
+  ReductionBundle bundle;
+  uint32_t max_id = add_extreme(bundle, last, STAT_ABS, true, location);
+  uint32_t min_id = add_extreme(bundle, first, STAT_ABS, false, location);
+  uint32_t abs_id = bundle.add(ReductionBundle::SUM, abs_sum);
+  uint32_t num_id = bundle.add(ReductionBundle::SUM, data_vec.size());
+  uint32_t org_id = bundle.add(ReductionBundle::MAX, org_ts[num_events-1]);
+  uint32_t syn_id = bundle.add(ReductionBundle::MAX, tsa[num_events-1]);
+  bundle.flush();
+
+  uint32_t max_data_id = add_companions(bundle, max_id, last, location);
+  uint32_t min_data_id = add_companions(bundle, min_id, first, location);
+  bundle.flush();
 
-  timestamp_t ex_data;
-
-  timestamp_t local_data = data_vec[((long)vec_size)-1].abs;
-  OMP_Allreduce_max(local_data, omp_global_max_timestamp);
-  local_data = omp_global_max_timestamp;
   #pragma omp master
   {
-    MPI_Allreduce(&local_data, &ex_data, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-    if (m_rank == 0) {
-      printf("\t\nGlobal maximum absolute error\n");
-      printf("\t%.9f\n", ex_data);
-    }
-  }
-
-  local_data = data_vec[0].abs;
-  OMP_Allreduce_min(local_data, omp_global_min_timestamp);
-  local_data = omp_global_min_timestamp;
-  #pragma omp master
-  { 
-    MPI_Allreduce(&local_data, &ex_data, 1, MPI_DOUBLE , MPI_MIN, MPI_COMM_WORLD);
     if (m_rank == 0) {
-      printf("\tGlobal minimum absolute error\n");
-      printf("\t%.9f\n", ex_data);
-    }
-  }
+      statistic_data ex_data = get_companions(bundle, max_data_id);
+      printf("\t\nGlobal maximum absolute error; rel. error; org. difference; synchronized difference\n");
+      printf("\t%.9f; %.9f; %.9f; %.9f\n", ex_data.abs, ex_data.rel, ex_data.org, ex_data.syn);
 
-  OMP_Allreduce_sum(abs_sum, omp_global_sum_timestamp);
-  timestamp_t omp_sum_abs = omp_global_sum_timestamp;
+      ex_data = get_companions(bundle, min_data_id);
+      printf("\tGlobal minimum absolute error; rel. error; org. difference; synchronized difference\n");
+      printf("\t%.9f; %.9f; %.9f; %.9f\n", ex_data.abs, ex_data.rel, ex_data.org, ex_data.syn);
 
-  OMP_Allreduce_sum(vec_size, omp_global_sum_timestamp);
-  timestamp_t omp_num_intervals = omp_global_sum_timestamp;
-
-  #pragma omp master
-  { 
-    MPI_Allreduce(&omp_sum_abs, &sum_abs, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    MPI_Allreduce(&omp_num_intervals, &num_intervals, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    if (m_rank == 0)
+      timestamp_t sum_abs       = bundle.getValue(abs_id);
+      timestamp_t num_intervals = bundle.getValue(num_id);
       printf("\tGlobal average absolute error,\n\t%.9f\n", (sum_abs/num_intervals));
-  }
-
-  /* Overall statistics */  
-  OMP_Allreduce_sum(org_ts[num_events-1], omp_global_sum_timestamp);
-  timestamp_t omp_sum_intervals_org = omp_global_sum_timestamp;
-
-  OMP_Allreduce_sum(tsa[num_events-1], omp_global_sum_timestamp);
-  timestamp_t omp_sum_intervals_sync = omp_global_sum_timestamp;
 
-  #pragma omp master
-  {
-    MPI_Allreduce(&omp_sum_intervals_org, &t_org, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-    MPI_Allreduce(&omp_sum_intervals_sync, &t_syn, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-    if (m_rank == 0)
+      /* Overall statistics */
+      timestamp_t t_org = bundle.getValue(org_id);
+      timestamp_t t_syn = bundle.getValue(syn_id);
       printf("\tRelative error of overall execution time\n\t%.9f\n", (fabs(t_org-t_syn)/t_org));
+    }
   }
-
-#else   // !_OPENMP
-
-  statistic_data ex_data;
-    
-  MPI_Allreduce(&data_vec[((long)vec_size)-1], &ex_data, 1, STAT_DATA, STAT_ABS_MAX, MPI_COMM_WORLD);   
-  if (m_rank == 0) {
-    printf("\t\nGlobal maximum absolute error; rel. error; org. difference; synchronized difference\n");
-    printf("\t%.9f; %.9f; %.9f; %.9f\n", ex_data.abs, ex_data.rel, ex_data.org, ex_data.syn);
-  }
-
-  MPI_Allreduce(&data_vec[0], &ex_data, 1, STAT_DATA, STAT_ABS_MIN, MPI_COMM_WORLD);
-  if (m_rank == 0) {
-    printf("\tGlobal minimum absolute error; rel. error; org. difference; synchronized difference\n");
-    printf("\t%.9f; %.9f; %.9f; %.9f\n", ex_data.abs, ex_data.rel, ex_data.org, ex_data.syn);
-  }
-
-  MPI_Allreduce(&abs_sum, &sum_abs, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  MPI_Allreduce(&vec_size, &num_intervals, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  if (m_rank == 0)
-    printf("\tGlobal average absolute error,\n\t%.9f\n", (sum_abs/num_intervals));
-   
-   /* Overall statistics */  
-  MPI_Allreduce(&org_ts[num_events-1], &t_org, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-  MPI_Allreduce(&tsa[num_events-1], &t_syn, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-  if (m_rank == 0)
-    printf("\tRelative error of overall execution time\n\t%.9f\n", (fabs(t_org-t_syn)/t_org));
-
-#endif   // !_OPENMP
 }
 
 
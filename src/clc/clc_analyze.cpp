@@ -133,9 +133,11 @@ int main(int argc, char** argv)
     PEARL_verify_calltree(*defs, *trace);
 
     // Generate global call tree is per-process call trees were incomplete
+    // and create the MPI communicator handles
     #pragma omp master
     {
       PEARL_mpi_unify_calltree(*defs);
+      PEARL_mpi_create_comms(*defs);
     }
     #pragma omp barrier
 
@@ -24,6 +24,7 @@
 #include <stdlib.h>
 #include <sys/stat.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <unistd.h>
 
 #include "elg_rw.h"
@@ -39,10 +40,18 @@
 #  include <sion.h>
 #endif   /* HAVE( SIONLIB ) */
 
+#if HAVE( PTHREAD )
+#  include <pthread.h>
+#endif   /* HAVE( PTHREAD ) */
+
 
 #define ELGIN_MODE_FILE      0
 #define ELGIN_MODE_BUFFER    1
 
+/* Read-ahead configuration: number of blocks and block size in bytes */
+#define ELGIN_AHEAD_BLOCKS      2
+#define ELGIN_AHEAD_BLOCK_SIZE  (1024 * 1024)
+
 
 /*
  *-----------------------------------------------------------------------------
@@ -177,6 +186,27 @@ char* ElgRec_read_string(ElgRec* rec)
 
 /* Data type */
 
+#if HAVE( PTHREAD )
+
+/* Read-ahead ring buffer, filled by a helper thread */
+typedef struct ElgAhead_struct
+{
+  pthread_t       thread;
+  pthread_mutex_t lock;
+  pthread_cond_t  cond;
+  elg_ui1*        data[ELGIN_AHEAD_BLOCKS];
+  size_t          size[ELGIN_AHEAD_BLOCKS];  /* valid bytes per block       */
+  int             filled;                    /* blocks ready to be consumed */
+  int             head;                      /* block currently consumed    */
+  int             tail;                      /* block to be filled next     */
+  int             eof;                       /* end of file (or error) seen */
+  int             stop;                      /* request to terminate thread */
+  size_t          pos;                       /* read position in head block */
+  size_t          limit;                     /* valid bytes in head block   */
+} ElgAhead;
+
+#endif   /* HAVE( PTHREAD ) */
+
 struct ElgIn_struct  
 {
   int            mode;
@@ -194,9 +224,223 @@ struct ElgIn_struct
   elg_ui1        minor_vnr; 
   elg_ui1        major_vnr; 
   elg_ui1        byte_order; 
+#if HAVE( PTHREAD )
+  ElgAhead*      ahead;
+#endif   /* HAVE( PTHREAD ) */
 };
 
 
+/* Advise the kernel that the file will be read sequentially */
+
+static void elg_advise_sequential(int fd)
+{
+#if defined(POSIX_FADV_SEQUENTIAL)
+  posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+}
+
+
+#if HAVE( PTHREAD )
+
+/*
+ * Read-ahead: a helper thread reads (and decompresses) large blocks of the
+ * file into a ring buffer, while the record parser consumes them from
+ * memory.  While active, the helper thread is the only one accessing
+ * in->file.  Not used for SION files, whose block structure is handled
+ * record by record.
+ */
+
+/* Synchronous read of a block of data from the underlying file */
+
+static size_t elg_read_block(ElgIn* in, void* buffer, size_t length)
+{
+#if !HAVE( LIBZ )
+  return fread(buffer, 1, length, in->file);
+#else   /* HAVE( LIBZ ) */
+  int result = gzread(in->file, buffer, length);
+
+  return (result < 0) ? 0 : result;
+#endif   /* HAVE( LIBZ ) */
+}
+
+
+static void* elg_ahead_main(void* arg)
+{
+  ElgIn*    in    = (ElgIn*)arg;
+  ElgAhead* ahead = in->ahead;
+  size_t    bytes;
+  int       block;
+
+  while (1)
+    {
+      /* wait for a free block */
+      pthread_mutex_lock(&ahead->lock);
+      while (ahead->filled == ELGIN_AHEAD_BLOCKS && !ahead->stop)
+        pthread_cond_wait(&ahead->cond, &ahead->lock);
+      if (ahead->stop)
+        {
+          pthread_mutex_unlock(&ahead->lock);
+          break;
+        }
+      block = ahead->tail;
+      pthread_mutex_unlock(&ahead->lock);
+
+      /* fill block outside of the critical section */
+      bytes = elg_read_block(in, ahead->data[block], ELGIN_AHEAD_BLOCK_SIZE);
+
+      /* publish block */
+      pthread_mutex_lock(&ahead->lock);
+      ahead->size[block] = bytes;
+      if (bytes > 0)
+        {
+          ahead->tail = (ahead->tail + 1) % ELGIN_AHEAD_BLOCKS;
+          ahead->filled++;
+        }
+      if (bytes < ELGIN_AHEAD_BLOCK_SIZE)
+        ahead->eof = 1;
+      pthread_cond_broadcast(&ahead->cond);
+      pthread_mutex_unlock(&ahead->lock);
+
+      if (bytes < ELGIN_AHEAD_BLOCK_SIZE)
+        break;
+    }
+
+  return NULL;
+}
+
+
+static void elg_ahead_start(ElgIn* in)
+{
+  ElgAhead* ahead;
+  int       i;
+
+  ahead = (ElgAhead*)calloc(1, sizeof(ElgAhead));
+  if (ahead == NULL)
+    return;
+  for (i = 0; i < ELGIN_AHEAD_BLOCKS; i++)
+    {
+      ahead->data[i] = (elg_ui1*)malloc(ELGIN_AHEAD_BLOCK_SIZE);
+      if (ahead->data[i] == NULL)
+        {
+          while (i > 0)
+            free(ahead->data[--i]);
+          free(ahead);
+          return;
+        }
+    }
+  pthread_mutex_init(&ahead->lock, NULL);
+  pthread_cond_init(&ahead->cond, NULL);
+
+  in->ahead = ahead;
+  if (pthread_create(&ahead->thread, NULL, elg_ahead_main, in) != 0)
+    {
+      /* fall back to synchronous reads */
+      in->ahead = NULL;
+      pthread_cond_destroy(&ahead->cond);
+      pthread_mutex_destroy(&ahead->lock);
+      for (i = 0; i < ELGIN_AHEAD_BLOCKS; i++)
+        free(ahead->data[i]);
+      free(ahead);
+    }
+}
+
+
+static void elg_ahead_stop(ElgIn* in)
+{
+  ElgAhead* ahead = in->ahead;
+  int       i;
+
+  if (ahead == NULL)
+    return;
+
+  pthread_mutex_lock(&ahead->lock);
+  ahead->stop = 1;
+  pthread_cond_broadcast(&ahead->cond);
+  pthread_mutex_unlock(&ahead->lock);
+  pthread_join(ahead->thread, NULL);
+
+  pthread_cond_destroy(&ahead->cond);
+  pthread_mutex_destroy(&ahead->lock);
+  for (i = 0; i < ELGIN_AHEAD_BLOCKS; i++)
+    free(ahead->data[i]);
+  free(ahead);
+  in->ahead = NULL;
+}
+
+
+/* Copy length bytes from the ring buffer; returns the number of bytes copied */
+
+static size_t elg_ahead_read(ElgAhead* ahead, void* buffer, size_t length)
+{
+  elg_ui1* dest = (elg_ui1*)buffer;
+  size_t   done = 0;
+  size_t   chunk;
+
+  while (done < length)
+    {
+      if (ahead->pos == ahead->limit)
+        {
+          pthread_mutex_lock(&ahead->lock);
+          if (ahead->limit > 0)
+            {
+              /* release exhausted block */
+              ahead->head = (ahead->head + 1) % ELGIN_AHEAD_BLOCKS;
+              ahead->filled--;
+              ahead->pos   = 0;
+              ahead->limit = 0;
+              pthread_cond_broadcast(&ahead->cond);
+            }
+
+          /* wait for data, unless the helper thread is done */
+          while (ahead->filled == 0 && !ahead->eof)
+            pthread_cond_wait(&ahead->cond, &ahead->lock);
+          if (ahead->filled == 0)
+            {
+              pthread_mutex_unlock(&ahead->lock);
+              break;
+            }
+          ahead->limit = ahead->size[ahead->head];
+          pthread_mutex_unlock(&ahead->lock);
+        }
+
+      chunk = ahead->limit - ahead->pos;
+      if (chunk > length - done)
+        chunk = length - done;
+      memcpy(dest + done, ahead->data[ahead->head] + ahead->pos, chunk);
+      ahead->pos += chunk;
+      done       += chunk;
+    }
+
+  return done;
+}
+
+#endif   /* HAVE( PTHREAD ) */
+
+
+/* Read exactly length bytes of record data; returns 1 on success */
+
+static int elg_read_data(ElgIn* in, void* buffer, size_t length)
+{
+#if HAVE( PTHREAD )
+  if (in->ahead)
+    return elg_ahead_read(in->ahead, buffer, length) == length;
+#endif   /* HAVE( PTHREAD ) */
+
+#if !HAVE( LIBZ )
+  return fread(buffer, length, 1, in->file) == 1;
+#else   /* HAVE( LIBZ ) */
+#if !HAVE( SIONLIB )
+  {
+    int result = gzread(in->file, buffer, length);
+    return result >= 0 && (size_t)result == length;
+  }
+#else   /* HAVE( SIONLIB ) */
+  return gzread_bs(in->file, buffer, length, &in->bytes_avail_in_block) == length;
+#endif   /* HAVE( SIONLIB ) */
+#endif   /* HAVE( LIBZ ) */
+}
+
+
 
 /* SION: check if gzread can read next bytes in sionfile */
 
@@ -265,6 +509,7 @@ ElgIn* ElgIn_open(const char* path_name)
   char     label[7];
   struct stat sbuf;
   int status; 
+  int fd;
 
 #if HAVE( SIONLIB )
   int   open_with_sion=0; 
@@ -319,6 +564,10 @@ ElgIn* ElgIn_open(const char* path_name)
   in = (ElgIn*)malloc(sizeof(ElgIn));
   if (in == NULL)
     elg_error();
+  in->sionid = -1;
+#if HAVE( PTHREAD )
+  in->ahead  = NULL;
+#endif   /* HAVE( PTHREAD ) */
 
 
 #if HAVE( SIONLIB )
@@ -369,11 +618,20 @@ ElgIn* ElgIn_open(const char* path_name)
 
   /* open file */
   in->mode = ELGIN_MODE_FILE;
+  in->file = NULL;
+  fd = open(path_name, O_RDONLY);
+  if (fd >= 0)
+    {
+      elg_advise_sequential(fd);
 #if !HAVE( LIBZ )
-  if ((in->file = fopen(path_name, "r")) == NULL)
+      in->file = fdopen(fd, "r");
 #else   /* HAVE( LIBZ ) */
-  if ((in->file = gzopen(path_name, "r")) == NULL)
+      in->file = gzdopen(fd, "r");
 #endif   /* HAVE( LIBZ ) */
+      if (in->file == NULL)
+        close(fd);
+    }
+  if (in->file == NULL)
     {
       elg_warning("Cannot open %s file %s", epk_archive_filetype(path_name), path_name);
       free(in);
@@ -428,6 +686,12 @@ ElgIn* ElgIn_open(const char* path_name)
 
 #endif   /* HAVE( LIBZ ) */
 
+#if HAVE( PTHREAD )
+  /* start reading ahead (not for SION files) */
+  if (in->sionid < 0)
+    elg_ahead_start(in);
+#endif   /* HAVE( PTHREAD ) */
+
   return in;  
 }
 
@@ -436,6 +700,10 @@ int ElgIn_close(ElgIn* in)
 {
   int result;
 
+#if HAVE( PTHREAD )
+  elg_ahead_stop(in);
+#endif   /* HAVE( PTHREAD ) */
+
   if (in->mode == ELGIN_MODE_FILE)
     {
 #if !HAVE( LIBZ )
@@ -485,15 +753,29 @@ int ElgIn_seek(ElgIn* in, long offset)
 {
   if (in->mode == ELGIN_MODE_FILE)
     {
+      int result;
+#if HAVE( PTHREAD )
+      int restart = (in->ahead != NULL);
+
+      /* discard data read ahead */
+      elg_ahead_stop(in);
+#endif   /* HAVE( PTHREAD ) */
+
 #if !HAVE( LIBZ )
-      return fseek(in->file, offset, SEEK_SET);
+      result = fseek(in->file, offset, SEEK_SET);
 #else   /* HAVE( LIBZ ) */
-      return gzseek(in->file, offset, SEEK_SET);
+      result = gzseek(in->file, offset, SEEK_SET);
 #endif   /* HAVE( LIBZ ) */
+
+#if HAVE( PTHREAD )
+      if (restart)
+        elg_ahead_start(in);
+#endif   /* HAVE( PTHREAD ) */
+      return result;
     }
 
   /* ELGIN_MODE_BUFFER */
-  if (offset < 0 || offset >= in->size)
+  if (offset < 0 || (size_t)offset >= in->size)
     return -1;
 
   in->offset = offset;
@@ -521,18 +803,8 @@ ElgRec* ElgIn_read_record(ElgIn* in)
           return NULL;
       }
 
-#if !HAVE( LIBZ )
-      if (fread(&rec->length, sizeof(rec->length), 1, in->file) != 1 ||
-          fread(&rec->type, sizeof(rec->type), 1, in->file)     != 1 )
-#else   /* HAVE( LIBZ ) */
-#if !HAVE( SIONLIB )
-      if (gzread(in->file, &rec->length, sizeof(rec->length)) != sizeof(rec->length) ||
-          gzread(in->file, &rec->type, sizeof(rec->type))     != sizeof(rec->type) )
-#else   /* HAVE( SIONLIB ) */
-      if (gzread_bs(in->file, &rec->length, sizeof(rec->length),&in->bytes_avail_in_block) != sizeof(rec->length) ||
-          gzread_bs(in->file, &rec->type, sizeof(rec->type),&in->bytes_avail_in_block)     != sizeof(rec->type) )
-#endif   /* HAVE( SIONLIB ) */
-#endif   /* HAVE( LIBZ ) */
+      if (!elg_read_data(in, &rec->length, sizeof(rec->length)) ||
+          !elg_read_data(in, &rec->type, sizeof(rec->type)))
         {
           free(rec);
 
@@ -568,15 +840,7 @@ ElgRec* ElgIn_read_record(ElgIn* in)
               return NULL;
 	  } 
 
-#if !HAVE( LIBZ )
-          if (fread(rec->body, rec->length, 1, in->file) != 1)
-#else   /* HAVE( LIBZ ) */
-#if !HAVE( SIONLIB )
-          if (gzread(in->file, rec->body, rec->length) != rec->length)
-#else   /* HAVE( SIONLIB ) */
-          if (gzread_bs(in->file, rec->body, rec->length, &in->bytes_avail_in_block) != rec->length)
-#endif   /* HAVE( SIONLIB ) */
-#endif   /* HAVE( LIBZ ) */
+          if (!elg_read_data(in, rec->body, rec->length))
             {
               ElgRec_free(rec);
               return NULL;
@@ -21,6 +21,9 @@
 #include <pearl/MpiAmRequest.h>
 
 #include <cassert>
+#include <vector>
+
+#include <mpi.h>
 
 #include <pearl/AmHandler.h>
 #include <pearl/MpiComm.h>
@@ -57,7 +60,8 @@ MpiAmRequest::create(uint32_t            remote,
 MpiAmRequest::MpiAmRequest(uint32_t       remote,
                            const MpiComm& comm,
                            bool           ensureSynchronous)
-    : AmRequest(new MpiMessage(comm), remote, comm, ensureSynchronous)
+    : AmRequest(new MpiMessage(comm), remote, comm, ensureSynchronous),
+      mCompleted(false)
 {
 }
 
@@ -70,7 +74,7 @@ MpiAmRequest::~MpiAmRequest()
     MpiMessage* message = static_cast<MpiMessage*>(getBuffer());
 
     // if the request is still active, cancel it to avoid memory corruption
-    if (!message->test()) {
+    if (!mCompleted && !message->test()) {
         message->cancel();
     }
 }
@@ -103,7 +107,11 @@ MpiAmRequest::test()
     // we know our buffer is an MpiMessage as we created it
     MpiMessage* message = static_cast<MpiMessage*>(getBuffer());
 
-    return (message->test());
+    if (!mCompleted) {
+        mCompleted = message->test();
+    }
+
+    return mCompleted;
 }
 
 
@@ -115,5 +123,55 @@ MpiAmRequest::cancel()
     // we know our buffer is an MpiMessage as we created it
     MpiMessage* message = static_cast<MpiMessage*>(getBuffer());
 
-    message->cancel();
+    if (!mCompleted) {
+        message->cancel();
+    }
+}
+
+
+/// Tests a set of MPI active message requests for completion using a
+/// single call to MPI_Testsome.
+///
+/// @param [in]  requests Array of %MpiAmRequest objects
+/// @param [in]  count    Number of requests in @a requests
+/// @param [out] indices  Indices of the completed requests (at least
+///                       @a count entries)
+///
+/// @return Number of completed requests
+///
+size_t
+MpiAmRequest::testsome(AmRequest** requests,
+                       size_t      count,
+                       int*        indices)
+{
+    vector<MPI_Request> handles(count);
+    vector<int>         completed(count);
+
+    size_t numCompleted = 0;
+    for (size_t i = 0; i < count; ++i) {
+        // we know these are MpiAmRequests as this callback is only
+        // registered for paradigms using them
+        MpiAmRequest* request = static_cast<MpiAmRequest*>(requests[i]);
+        if (request->mCompleted) {
+            handles[i]              = MPI_REQUEST_NULL;
+            indices[numCompleted++] = i;
+        } else {
+            MpiMessage* message = static_cast<MpiMessage*>(request->getBuffer());
+            handles[i] = message->get_request();
+        }
+    }
+
+    int outcount = 0;
+    MPI_Testsome(count, &handles[0], &outcount, &completed[0],
+                 MPI_STATUSES_IGNORE);
+    if (outcount == MPI_UNDEFINED) {
+        return numCompleted;
+    }
+
+    for (int i = 0; i < outcount; ++i) {
+        static_cast<MpiAmRequest*>(requests[completed[i]])->mCompleted = true;
+        indices[numCompleted++] = completed[i];
+    }
+
+    return numCompleted;
 }
@@ -30,15 +30,28 @@
 
 #include <iostream>
 
+#include <pearl/Error.h>
 #include <pearl/MpiGroup.h>
 #include <pearl/String.h>
 
+#include "Threading.h"
 #include "pearl_iomanip.h"
 
 using namespace std;
 using namespace pearl;
 
 
+//--- Local variables -------------------------------------------------------
+
+namespace
+{
+/// Mutex variable electing the thread lazily creating an MPI communicator
+/// handle, as the creation may be triggered concurrently by the
+/// thread-multiple replay
+Mutex commMutex;
+}   // unnamed namespace
+
+
 //--- Constructors & destructor ---------------------------------------------
 
 MpiComm::MpiComm(const IdType    id,
@@ -46,22 +59,23 @@ MpiComm::MpiComm(const IdType    id,
                  const MpiGroup& group,
                  MpiComm* const  parent)
     : Communicator(id, name, group, Paradigm::MPI, parent),
-      mCommunicator(MPI_COMM_NULL)
+      mCommunicator(MPI_COMM_NULL),
+      mIsCreated(false),
+      mIsCreating(false)
 {
-    MPI_Group group_handle;
-
-    // Create communicator
-    group_handle = group.createGroup();
-    MPI_Comm_create(MPI_COMM_WORLD, group_handle, &mCommunicator);
-    MPI_Group_free(&group_handle);
+    // MPI communicator handle will be created either by
+    // PEARL_mpi_create_comms() or lazily on first access by the
+    // getComm() method.
 }
 
 
 MpiComm::MpiComm(const MpiComm& comm)
     : Communicator(comm),
-      mCommunicator(MPI_COMM_NULL)
+      mCommunicator(MPI_COMM_NULL),
+      mIsCreated(true),
+      mIsCreating(true)
 {
-    MPI_Comm_dup(comm.mCommunicator, &mCommunicator);
+    MPI_Comm_dup(comm.getComm(), &mCommunicator);
 }
 
 
@@ -79,6 +93,27 @@ MpiComm::~MpiComm()
 MPI_Comm
 MpiComm::getComm() const
 {
+    // Handle published by PEARL_mpi_create_comms() or a previous call
+    if (PEARL_LoadAcquire(mIsCreated)) {
+        return mCommunicator;
+    }
+
+    // Lazy creation of MPI communicator handle at first access. The lock
+    // only elects the creating thread and is not held during the MPI calls,
+    // i.e., other threads are only delayed if they need the same handle.
+    commMutex.lock();
+    const bool isCreator = !mIsCreating;
+    mIsCreating = true;
+    commMutex.unlock();
+
+    if (isCreator) {
+        createComm();
+        PEARL_StoreRelease(mIsCreated, true);
+    } else {
+        while (!PEARL_LoadAcquire(mIsCreated)) {
+        }
+    }
+
     return mCommunicator;
 }
 
@@ -119,3 +154,48 @@ MpiComm::print(ostream& stream) const
     // Reset indentation
     return setIndent(stream, indent);
 }
+
+
+/// @brief Create corresponding MPI communicator.
+///
+/// Creates the MPI communicator handle of this communicator if the calling
+/// process is a member. With MPI 3.0 or later, only the members of the
+/// communicator are involved. Otherwise, only empty and self communicators
+/// can be created individually, as MPI_Comm_create would have to be called
+/// by all processes; all others have to be created by
+/// PEARL_mpi_create_comms(). The caller is responsible for marking the
+/// handle as created.
+///
+/// @exception FatalError
+///     if the communicator cannot be created individually (MPI < 3.0)
+///
+void
+MpiComm::createComm() const
+{
+    const MpiGroup& group = static_cast<const MpiGroup&>(getGroup());
+
+    if (0 == group.numRanks()) {
+        return;
+    }
+    if (group.isSelf()) {
+        MPI_Comm_dup(MPI_COMM_SELF, &mCommunicator);
+
+        return;
+    }
+
+    #if (MPI_VERSION < 3)
+        throw FatalError("MpiComm::createComm() -- Communicator "
+                         "has to be created by PEARL_mpi_create_comms() "
+                         "with MPI < 3.0!");
+    #else   // MPI_VERSION >= 3
+        MPI_Group group_handle = group.createGroup();
+
+        int rank;
+        MPI_Group_rank(group_handle, &rank);
+        if (MPI_UNDEFINED != rank) {
+            MPI_Comm_create_group(MPI_COMM_WORLD, group_handle, 0,
+                                  &mCommunicator);
+        }
+        MPI_Group_free(&group_handle);
+    #endif   // MPI_VERSION >= 3
+}
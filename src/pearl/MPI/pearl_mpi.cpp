@@ -17,12 +17,17 @@
 #include <config.h>
 #include <pearl/pearl.h>
 
+#include <algorithm>
+#include <map>
+
 #include <mpi.h>
 
 #include <elg_error.h>
 
 #include <pearl/GlobalDefs.h>
+#include <pearl/MpiComm.h>
 #include <pearl/MpiMessage.h>
+#include <pearl/ProcessGroup.h>
 
 #include "Calltree.h"
 #include "MpiDefsFactory.h"
@@ -153,3 +158,147 @@ void pearl::PEARL_mpi_unify_calltree(GlobalDefs& defs)
   Calltree* global_ctree = new Calltree(defs, message);
   defs.set_calltree(global_ctree);
 }
+
+
+//--- Communicator creation -------------------------------------------------
+
+/**
+ *  Creates the MPI communicator handles of all MPI communicators provided by
+ *  the global definitions object @a defs. This is a convenience function for
+ *  tools which do not track the communicators they actually use; see the
+ *  second variant for details.
+ *
+ *  @note This function is intended to be used in pure MPI-based or hybrid
+ *        OpenMP/MPI PEARL programs. In the case of a hybrid OpenMP/MPI
+ *        program, make sure to call this function <b>only from the master
+ *        thread.</b>
+ *
+ *  @param defs Global definitions object
+ **/
+void pearl::PEARL_mpi_create_comms(const GlobalDefs& defs)
+{
+  vector<uint32_t> commIds;
+  commIds.reserve(defs.numCommunicators());
+  for (uint32_t index = 0; index < defs.numCommunicators(); ++index)
+    commIds.push_back(defs.getCommunicatorByIndex(index).getId());
+
+  PEARL_mpi_create_comms(defs, commIds);
+}
+
+
+/**
+ *  Creates the MPI communicator handles of all communicators whose IDs are
+ *  given by @a commIds on any process. Instead of issuing one collective
+ *  MPI_Comm_create over MPI_COMM_WORLD per communicator, the communicators
+ *  are assigned to sets of communicators with disjoint process groups (e.g.,
+ *  all communicators resulting from a single MPI_Comm_split call in the
+ *  target application), and each set is created using a single
+ *  MPI_Comm_split. Self communicators are created locally. Handles of other
+ *  communicators are only created on first access (see MpiComm::getComm()),
+ *  i.e., communicators never used by an analysis are not created at all.
+ *
+ *  @note This function is intended to be used in pure MPI-based or hybrid
+ *        OpenMP/MPI PEARL programs. In the case of a hybrid OpenMP/MPI
+ *        program, make sure to call this function <b>only from the master
+ *        thread.</b>
+ *
+ *  @param defs    Global definitions object
+ *  @param commIds IDs of the communicators used by the calling process
+ **/
+void pearl::PEARL_mpi_create_comms(const GlobalDefs&       defs,
+                                   const vector<uint32_t>& commIds)
+{
+  const uint32_t numComms = defs.numCommunicators();
+
+  map<uint32_t, uint32_t> commIndex;
+  for (uint32_t index = 0; index < numComms; ++index)
+    commIndex[defs.getCommunicatorByIndex(index).getId()] = index;
+
+  // Determine communicators used on any process (bit 0) and those already
+  // created on their members (bit 1); the trailing element avoids an empty
+  // buffer
+  vector<int> local(numComms + 1, 0);
+  vector<int> global(numComms + 1);
+  for (vector<uint32_t>::const_iterator it = commIds.begin();
+       it != commIds.end();
+       ++it) {
+    map<uint32_t, uint32_t>::const_iterator entry = commIndex.find(*it);
+    if (entry != commIndex.end())
+      local[entry->second] |= 1;
+  }
+  int rank;
+  int size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  for (uint32_t index = 0; index < numComms; ++index) {
+    const MpiComm* comm =
+      dynamic_cast<const MpiComm*>(&defs.getCommunicatorByIndex(index));
+    if (comm && comm->mIsCreated && (MPI_COMM_NULL != comm->mCommunicator))
+      local[index] |= 2;
+  }
+  MPI_Allreduce(&local[0], &global[0], numComms + 1, MPI_INT, MPI_BOR,
+                MPI_COMM_WORLD);
+
+  // Assign each communicator to the first set following all sets which
+  // include one of its members, such that the communicators of a set are
+  // disjoint; for each set, only the communicator including the calling
+  // process (if any) and its rank in there are required
+  vector<uint32_t>       nextSet(size, 0);
+  vector<const MpiComm*> setComms;
+  vector<int>            setColors;
+  vector<int>            setKeys;
+  vector<const MpiComm*> created;
+  for (uint32_t index = 0; index < numComms; ++index) {
+    if (1 != global[index])
+      continue;
+
+    const MpiComm* comm =
+      dynamic_cast<const MpiComm*>(&defs.getCommunicatorByIndex(index));
+    if (!comm)
+      continue;
+
+    const ProcessGroup& group = comm->getGroup();
+    if ((0 == group.numRanks()) || group.isSelf()) {
+      if (!comm->mIsCreated) {
+        comm->createComm();
+        comm->mIsCreated  = true;
+        comm->mIsCreating = true;
+      }
+      continue;
+    }
+
+    uint32_t set = 0;
+    for (uint32_t i = 0; i < group.numRanks(); ++i)
+      set = max(set, nextSet[group.getGlobalRank(i)]);
+    if (set == setComms.size()) {
+      setComms.push_back(NULL);
+      setColors.push_back(MPI_UNDEFINED);
+      setKeys.push_back(0);
+    }
+    for (uint32_t i = 0; i < group.numRanks(); ++i) {
+      const int member = group.getGlobalRank(i);
+
+      nextSet[member] = set + 1;
+      if (member == rank) {
+        setComms[set]  = comm;
+        setColors[set] = index;
+        setKeys[set]   = i;
+      }
+    }
+    created.push_back(comm);
+  }
+
+  // Create communicators
+  for (size_t set = 0; set < setComms.size(); ++set) {
+    MPI_Comm handle;
+    MPI_Comm_split(MPI_COMM_WORLD, setColors[set], setKeys[set], &handle);
+    if (setComms[set])
+      setComms[set]->mCommunicator = handle;
+  }
+  for (vector<const MpiComm*>::iterator it = created.begin();
+       it != created.end();
+       ++it) {
+    (*it)->mIsCreated  = true;
+    (*it)->mIsCreating = true;
+  }
+}
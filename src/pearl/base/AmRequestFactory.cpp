@@ -52,6 +52,49 @@ AmRequestFactory::create(uint32_t            remote,
 }
 
 
+/// Tests the given set of requests for completion. If all requests use
+/// the same paradigm and a completion test callback has been registered
+/// for it, the requests are tested at once. Otherwise, each request is
+/// tested individually.
+///
+/// @param [in]  requests Array of requests
+/// @param [in]  count    Number of requests in @a requests
+/// @param [out] indices  Indices of the completed requests (at least
+///                       @a count entries)
+///
+/// @return Number of completed requests
+std::size_t
+AmRequestFactory::testsome(AmRequest** requests,
+                           std::size_t count,
+                           int*        indices)
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    Paradigm paradigm = requests[0]->getComm().getParadigm();
+    bool     uniform  = true;
+    for (size_t i = 1; uniform && (i < count); ++i) {
+        uniform = (requests[i]->getComm().getParadigm() == paradigm);
+    }
+    if (uniform) {
+        TestCbContainer::const_iterator it = getTestCallbacks().find(paradigm);
+        if (it != getTestCallbacks().end()) {
+            return (*it->second)(requests, count, indices);
+        }
+    }
+
+    size_t numCompleted = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (requests[i]->test()) {
+            indices[numCompleted++] = i;
+        }
+    }
+
+    return numCompleted;
+}
+
+
 /// Get static callback container
 ///
 /// @return Reference to static callback container
@@ -76,3 +119,33 @@ AmRequestFactory::registerCallback(Paradigm                     paradigm,
 {
     getCallbacks()[paradigm] = callback;
 }
+
+
+/// Get static completion test callback container
+///
+/// @return Reference to static completion test callback container
+///
+AmRequestFactory::TestCbContainer&
+AmRequestFactory::getTestCallbacks()
+{
+    static AmRequestFactory::TestCbContainer mTestCallbacks;
+
+    return mTestCallbacks;
+}
+
+
+/// Register a request factory callback together with a callback testing
+/// a set of requests of this paradigm for completion at once
+///
+/// @param [in] paradigm     Paradigm the callbacks should be used for
+/// @param [in] callback     Factory callback for request creation
+/// @param [in] testCallback Callback for batched completion tests
+///
+void
+AmRequestFactory::registerCallback(Paradigm                       paradigm,
+                                   AmRequestFactory::CbFunction   callback,
+                                   AmRequestFactory::TestFunction testCallback)
+{
+    getCallbacks()[paradigm]     = callback;
+    getTestCallbacks()[paradigm] = testCallback;
+}
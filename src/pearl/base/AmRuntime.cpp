@@ -43,6 +43,14 @@ using namespace pearl;
 // Forward declarations
 class CallbackManager;
 
+
+namespace
+{
+/// Default message size (in bytes) triggering a batch of coalesced
+/// requests to be sent
+const size_t DEFAULT_FLUSH_THRESHOLD = 8192;
+}   // unnamed namespace
+
 /*----------------------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
@@ -53,7 +61,10 @@ class CallbackManager;
  */
 AmRuntime::AmRuntime()
     : mCbdata(NULL),
-      mCbmanager(NULL)
+      mCbmanager(NULL),
+      mFlushThreshold(DEFAULT_FLUSH_THRESHOLD),
+      mNumRequests(0),
+      mNumMessages(0)
 {
 }
 
@@ -85,10 +96,16 @@ AmRuntime::getInstance()
 void
 AmRuntime::shutdown()
 {
-    if (getRequests().size() > 0) {
+    size_t numPending = getRequests().size() + getBatches().size();
+    if (numPending > 0) {
         cerr << "WARNING: Premature release of AmRuntime left "
-             << getRequests().size() << " requests unhandled!" << endl;
+             << numPending << " requests unhandled!" << endl;
     }
+    for (BatchContainer::iterator batch = getBatches().begin();
+         batch != getBatches().end(); ++batch) {
+        delete batch->second;
+    }
+    getBatches().clear();
     for (RequestContainer::iterator request = getRequests().begin();
          request != getRequests().end(); ++request) {
         (*request)->cancel();
@@ -109,6 +126,9 @@ AmRuntime::advance()
 {
     size_t numAdvanced = 0;
 
+    // send all pending batches of coalesced requests
+    flush();
+
     // receive and execute pending messages
     for (ListenerContainer::iterator it = getListeners().begin();
          it != getListeners().end(); ++it) {
@@ -128,32 +148,51 @@ AmRuntime::advance()
         }
     }
 
-    // test pending requests
-    for (RequestContainer::iterator it = getRequests().begin();
-         it != getRequests().end();
-         ++it) {
-        if ((*it)->test()) {
-            numAdvanced++;
+    // test all pending requests at once, then release completed ones
+    RequestContainer& requests = getRequests();
+    if (!requests.empty()) {
+        vector<int> indices(requests.size());
+        size_t      numCompleted = AmRequestFactory::testsome(&requests[0],
+                                                              requests.size(),
+                                                              &indices[0]);
+        for (size_t i = 0; i < numCompleted; ++i) {
+            delete requests[indices[i]];
+            requests[indices[i]] = NULL;
         }
+        if (numCompleted > 0) {
+            requests.erase(remove(requests.begin(), requests.end(),
+                                  static_cast<AmRequest*>(NULL)),
+                           requests.end());
+        }
+        numAdvanced += numCompleted;
     }
 
-    // erase completed requests
-    RequestContainer::iterator newEnd =
-        remove_if(getRequests().begin(),
-                  getRequests().end(),
-                  isFinished);
-    getRequests().erase(newEnd, getRequests().end());
-
     return numAdvanced;
 }
 
 
+/**
+ * Sends all batches of coalesced requests that are still pending,
+ * regardless of the flush threshold.
+ */
+void
+AmRuntime::flush()
+{
+    for (BatchContainer::iterator batch = getBatches().begin();
+         batch != getBatches().end(); ++batch) {
+        start(batch->second);
+    }
+    getBatches().clear();
+}
+
+
 /**
  * Blocks until all local requests have finished
  */
 void
 AmRuntime::wait()
 {
+    flush();
     while (getRequests().size() > 0) {
         advance();
     }
@@ -166,20 +205,18 @@ AmRuntime::wait()
 void
 AmRuntime::wait(const Communicator& comm)
 {
-    size_t count = 0;
+    bool pending = false;
 
     do {
-        count = getRequests().size();
+        advance();
 
+        pending = false;
         RequestContainer::iterator it = getRequests().begin();
-        while (it != getRequests().end()) {
-            if ((*it)->getComm().getId() != comm.getId()) {
-                --count;
-            }
+        while (!pending && (it != getRequests().end())) {
+            pending = ((*it)->getComm().getId() == comm.getId());
             ++it;
         }
-        advance();
-    } while (count > 0);
+    } while (pending);
 }
 
 
@@ -190,7 +227,7 @@ AmRuntime::wait(const Communicator& comm)
 void
 AmRuntime::allfence()
 {
-    TargetSetContainer targetSets = getTargetsets();
+    TargetSetContainer& targetSets = getTargetsets();
 
     for (TargetSetContainer::iterator tset = targetSets.begin();
          tset != targetSets.end(); ++tset) {
@@ -283,6 +320,32 @@ AmRuntime::getCbmanager() const
 }
 
 
+/**
+ * Sets the message size at which a batch of coalesced requests to the
+ * same target is sent. A threshold of zero disables coalescing.
+ *
+ * @param bytes Flush threshold in bytes
+ */
+void
+AmRuntime::setFlushThreshold(size_t bytes)
+{
+    mFlushThreshold = bytes;
+}
+
+
+/**
+ * Gets the message size at which a batch of coalesced requests to the
+ * same target is sent.
+ *
+ * @return Flush threshold in bytes
+ */
+size_t
+AmRuntime::getFlushThreshold() const
+{
+    return mFlushThreshold;
+}
+
+
 //--- Message handling ------------------------------------------------------
 
 /**
@@ -310,19 +373,48 @@ AmRuntime::attach(AmHandler& handler)
 /**
  * Insert request into the runtime system.
  *
+ * Asynchronous requests are appended to the batch of pending requests to
+ * the same target, which is sent once the flush threshold is reached or
+ * the runtime is advanced. Synchronous requests are sent immediately,
+ * after any pending batch to the same target to preserve the message
+ * order.
+ *
  * @param request Smart pointer to request object.
  */
 void
 AmRuntime::enqueue(AmRequest::Ptr request)
 {
-    // start sending
-    request->start();
+    const Communicator& comm   = request->getComm();
+    uint32_t            remote = request->getRemote();
 
     // add target to targetset of this request's communicator
-    getTargetsets()[&request->getComm()].insert(request->getRemote());
+    getTargetsets()[&comm].insert(remote);
+    ++mNumRequests;
 
-    // save pointer to request object
-    getRequests().push_back(request.release());
+    BatchContainer::key_type key(&comm, remote);
+    BatchContainer::iterator batch = getBatches().find(key);
+
+    if (request->ensureSynchronous() || (mFlushThreshold == 0)) {
+        if (batch != getBatches().end()) {
+            start(batch->second);
+            getBatches().erase(batch);
+        }
+        start(request.release());
+
+        return;
+    }
+
+    // open new batch or append message to pending one
+    if (batch == getBatches().end()) {
+        batch = getBatches().insert(make_pair(key, request.release())).first;
+    } else {
+        batch->second->getBuffer()->append(*request->getBuffer());
+    }
+
+    if (batch->second->getBuffer()->size() >= mFlushThreshold) {
+        start(batch->second);
+        getBatches().erase(batch);
+    }
 }
 
 
@@ -362,6 +454,25 @@ AmRuntime::stopListen(const Communicator& comm)
 }
 
 
+//--- Internal message handling ---------------------------------------------
+
+/**
+ * Starts sending the given request and hands it over to the set of
+ * pending requests.
+ *
+ * @param request Pointer to request object.
+ */
+void
+AmRuntime::start(AmRequest* request)
+{
+    request->start();
+    ++mNumMessages;
+
+    // save pointer to request object
+    getRequests().push_back(request);
+}
+
+
 //--- Access to static storage ----------------------------------------------
 
 /**
@@ -445,6 +556,19 @@ AmRuntime::getTargetset(const Communicator& comm)
 }
 
 
+/**
+ * Returns reference to the container of pending request batches.
+ *
+ * @return Reference to batch container.
+ */
+AmRuntime::BatchContainer&
+AmRuntime::getBatches()
+{
+    static BatchContainer mBatches;
+    return mBatches;
+}
+
+
 /**
  * Print runtime summary.
  */
@@ -463,5 +587,7 @@ AmRuntime::printSummary()
          it != getHandlers().end(); ++it) {
         message << (*it)->getName() << ": " << getStatistics()[(*it)->getId()] << "\n";
     }
+    message << "\nRequests: " << mNumRequests
+            << " (sent in " << mNumMessages << " messages)\n";
     cerr << message.str() << "\n" << endl;
 }
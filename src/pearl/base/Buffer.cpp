@@ -67,7 +67,8 @@ namespace
 Buffer::Buffer(std::size_t capacity)
     : m_capacity(capacity),
       m_size(1),
-      m_position(1)
+      m_position(1),
+      m_isOwner(true)
 {
     assert(capacity > 0);
 
@@ -84,18 +85,43 @@ Buffer::Buffer(std::size_t capacity)
  *  @param rhs Source operand
  **/
 Buffer::Buffer(const Buffer& rhs)
-    : m_data(NULL)
+    : m_data(NULL),
+      m_isOwner(true)
 {
     *this = rhs;
 }
 
 
+/**
+ *  Creates a new instance providing a read-only view of the @a size bytes
+ *  of serialized data at @a data, including the leading byte-order marker.
+ *  The data is neither copied nor released by the buffer, i.e., it has to
+ *  remain valid during the lifetime of the instance. Storing further values
+ *  transparently switches to a private copy.
+ *
+ *  @param data Serialized data
+ *  @param size Size of the serialized data in bytes
+ **/
+Buffer::Buffer(const uint8_t* const data,
+               const std::size_t    size)
+    : m_capacity(size),
+      m_size(size),
+      m_position(1),
+      m_data(const_cast<uint8_t*>(data)),
+      m_isOwner(false)
+{
+    assert(data && (size > 0));
+}
+
+
 /**
  *  Destructor. Destroys the instance and releases all occupied resources.
  **/
 Buffer::~Buffer()
 {
-    delete[] m_data;
+    if (m_isOwner) {
+        delete[] m_data;
+    }
 }
 
 
@@ -117,13 +143,16 @@ Buffer::operator=(const Buffer& rhs)
     }
 
     // Release memory
-    delete[] m_data;
+    if (m_isOwner) {
+        delete[] m_data;
+    }
 
     // Copy data
     m_capacity = rhs.m_capacity;
     m_size     = rhs.m_size;
     m_position = rhs.m_position;
     m_data     = new uint8_t[m_capacity];
+    m_isOwner  = true;
     memcpy(m_data, rhs.m_data, m_size);
 
     return *this;
@@ -284,6 +313,33 @@ Buffer::put_buffer(const Buffer& buffer)
 }
 
 
+/**
+ *  Appends the data values stored in the given @a buffer to this buffer,
+ *  i.e., without a size prefix and the leading byte order information.
+ *  This allows to concatenate several independently packed buffers into a
+ *  single one which can be unpacked sequentially. Both buffers have to use
+ *  the same byte order. If not enough buffer space is available, the buffer
+ *  will be automatically resized.
+ *
+ *  @param buffer Buffer whose data values should be appended
+ **/
+void
+Buffer::append(const Buffer& buffer)
+{
+    // self-assignment currently not allowed
+    assert(m_data != buffer.m_data);
+    assert(m_data[0] == buffer.m_data[0]);
+
+    size_t length = buffer.m_size - 1;
+
+    // Increase capacity if necessary
+    reserve(length);
+
+    memcpy(m_data + m_size, buffer.m_data + 1, length);
+    m_size += length;
+}
+
+
 //--- Retrieving data values ------------------------------------------------
 
 /**
@@ -478,7 +534,10 @@ Buffer::reserve(std::size_t nbytes)
         // Allocate new buffer memory and copy data
         uint8_t* tmp = new uint8_t[m_capacity];
         memcpy(tmp, m_data, m_size);
-        delete[] m_data;
-        m_data = tmp;
+        if (m_isOwner) {
+            delete[] m_data;
+        }
+        m_data    = tmp;
+        m_isOwner = true;
     }
 }
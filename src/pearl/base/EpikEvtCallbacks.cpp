@@ -243,6 +243,9 @@ elg_readcb_ENTER(elg_ui4  lid,         /* location identifier */
 
     if (event) {
         trace.add_event(event);
+        if (metc > 0) {
+            trace.addMetricValues(trace.end().prev(), metv);
+        }
     }
 
     // Special handling for MPI collectives
@@ -303,6 +306,9 @@ elg_readcb_EXIT(elg_ui4  lid,         /* location identifier */
 
     if (event) {
         trace.add_event(event);
+        if (metc > 0) {
+            trace.addMetricValues(trace.end().prev(), metv);
+        }
     }
 
     if (is_omp_parallel(region)) {
@@ -357,6 +363,9 @@ elg_readcb_ENTER_CS(elg_ui4  lid,         /* location identifier */
 
     if (event) {
         trace.add_event(event);
+        if (metc > 0) {
+            trace.addMetricValues(trace.end().prev(), metv);
+        }
     }
     CALLBACK_CLEANUP
 }
@@ -401,6 +410,7 @@ elg_readcb_MPI_SEND(elg_ui4 lid,         /* location identifier */
     }
     if (event) {
         trace.add_event(event);
+        data->mRequests.link(trace.end().prev());
     }
     CALLBACK_CLEANUP
 }
@@ -444,6 +454,7 @@ elg_readcb_MPI_RECV(elg_ui4 lid,         /* location identifier */
     }
     if (event) {
         trace.add_event(event);
+        data->mRequests.link(trace.end().prev());
     }
     CALLBACK_CLEANUP
 }
@@ -499,6 +510,9 @@ elg_readcb_MPI_COLLEXIT(elg_ui4  lid,           /* location identifier */
 
     if (event) {
         trace.add_event(event);
+        if (metc > 0) {
+            trace.addMetricValues(trace.end().prev(), metv);
+        }
     }
     CALLBACK_CLEANUP
 }
@@ -521,6 +535,7 @@ elg_readcb_MPI_SEND_COMPLETE(elg_ui4 lid,            /* location identifier
 
     if (event) {
         trace.add_event(event);
+        data->mRequests.link(trace.end().prev());
     }
     CALLBACK_CLEANUP
 }
@@ -543,6 +558,7 @@ elg_readcb_MPI_RECV_REQUEST(elg_ui4 lid,            /* location identifier
 
     if (event) {
         trace.add_event(event);
+        data->mRequests.link(trace.end().prev());
     }
     CALLBACK_CLEANUP
 }
@@ -565,6 +581,7 @@ elg_readcb_MPI_REQUEST_TESTED(elg_ui4 lid,            /* location identifier
 
     if (event) {
         trace.add_event(event);
+        data->mRequests.link(trace.end().prev());
     }
     CALLBACK_CLEANUP
 }
@@ -585,6 +602,7 @@ elg_readcb_MPI_CANCELLED(elg_ui4 lid,            /* location identifier
 
     if (event) {
         trace.add_event(event);
+        data->mRequests.link(trace.end().prev());
     }
     CALLBACK_CLEANUP
 }
@@ -780,6 +798,9 @@ elg_readcb_MPI_WINEXIT(elg_ui4  lid,          /* location identifier */
 
     if (event) {
         trace.add_event(event);
+        if (metc > 0) {
+            trace.addMetricValues(trace.end().prev(), metv);
+        }
     }
     CALLBACK_CLEANUP
 }
@@ -821,6 +842,9 @@ elg_readcb_MPI_WINCOLLEXIT(elg_ui4  lid,         /* location identifier */
 
     if (event) {
         trace.add_event(event);
+        if (metc > 0) {
+            trace.addMetricValues(trace.end().prev(), metv);
+        }
     }
     CALLBACK_CLEANUP
 }
@@ -1040,6 +1064,9 @@ elg_readcb_COLLEXIT(elg_ui4  lid,          /* location identifier */
 
     if (event) {
         trace.add_event(event);
+        if (metc > 0) {
+            trace.addMetricValues(trace.end().prev(), metv);
+        }
     }
     CALLBACK_CLEANUP
 }
@@ -1157,6 +1184,9 @@ elg_readcb_OMP_COLLEXIT(elg_ui4  lid,         /* location identifier */
 
     if (event) {
         trace.add_event(event);
+        if (metc > 0) {
+            trace.addMetricValues(trace.end().prev(), metv);
+        }
     }
 
     const Region& region = defs.getRegion(regionId);
@@ -1195,6 +1225,9 @@ elg_readcb_LOG_OFF(elg_ui4  lid,         /* location identifier */
 
     if (event) {
         trace.add_event(event);
+        if (metc > 0) {
+            trace.addMetricValues(trace.end().prev(), metv);
+        }
     }
     CALLBACK_CLEANUP
 }
@@ -1225,6 +1258,9 @@ elg_readcb_LOG_ON(elg_ui4  lid,         /* location identifier */
 
     if (event) {
         trace.add_event(event);
+        if (metc > 0) {
+            trace.addMetricValues(trace.end().prev(), metv);
+        }
     }
     CALLBACK_CLEANUP
 }
@@ -1251,6 +1287,9 @@ elg_readcb_ENTER_TRACING(elg_ui4  lid,         /* location identifier */
 
     if (event) {
         trace.add_event(event);
+        if (metc > 0) {
+            trace.addMetricValues(trace.end().prev(), metv);
+        }
     }
     CALLBACK_CLEANUP
 }
@@ -1281,6 +1320,9 @@ elg_readcb_EXIT_TRACING(elg_ui4  lid,         /* location identifier */
 
     if (event) {
         trace.add_event(event);
+        if (metc > 0) {
+            trace.addMetricValues(trace.end().prev(), metv);
+        }
     }
     CALLBACK_CLEANUP
 }
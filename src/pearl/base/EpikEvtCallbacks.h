@@ -37,6 +37,8 @@
 
 #include <pearl/Location.h>
 
+#include "RequestTable.h"
+
 
 namespace pearl
 {
@@ -108,6 +110,9 @@ struct EpikEvtCbData
     /// Callstack in terms of region IDs
     std::stack<uint32_t> mCallstack;
 
+    /// Pending non-blocking communication requests
+    RequestTable mRequests;
+
     /// %Error message of exceptions thrown (and caught) within callbacks
     std::string mErrorMessage;
 };
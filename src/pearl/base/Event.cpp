@@ -20,6 +20,8 @@
 #include <config.h>
 #include <pearl/Event.h>
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
 
 #include <pearl/Buffer.h>
@@ -145,6 +147,16 @@ Event::is_valid() const
 Event
 Event::enterptr() const
 {
+    // Look up associated ENTER event if the navigation index is available
+    if (m_trace->hasNavigationIndex()) {
+        const uint32_t index = ITEM->isOfType(LEAVE)
+                               ? m_trace->m_matchIndex[m_index]
+                               : m_trace->m_parentIndex[m_index];
+        if (index != LocalTrace::NO_INDEX) {
+            return Event(m_trace, index);
+        }
+    }
+
     // Search for associated ENTER event while keeping track of nested
     // ENTERs/LEAVEs (necessary because of possible buffer flushing)
     int   depth = 0;
@@ -204,6 +216,20 @@ Event::enterptr() const
 Event
 Event::leaveptr() const
 {
+    // Look up associated LEAVE event if the navigation index is available
+    if (m_trace->hasNavigationIndex()) {
+        uint32_t index = m_index;
+        if (!ITEM->isOfType(GROUP_ENTER)) {
+            index = m_trace->m_parentIndex[m_index];
+        }
+        if (index != LocalTrace::NO_INDEX) {
+            index = m_trace->m_matchIndex[index];
+        }
+        if (index != LocalTrace::NO_INDEX) {
+            return Event(m_trace, index);
+        }
+    }
+
     // Search for associated LEAVE event while keeping track of nested
     // ENTERs/LEAVEs (necessary because of possible buffer flushing)
     int   depth = 0;
@@ -266,6 +292,15 @@ Event::beginptr() const
                          "Method only allowed for END-type events!");
     }
 
+    // Look up associated BEGIN-type event if the navigation index is
+    // available
+    if (m_trace->hasNavigationIndex()) {
+        const uint32_t index = m_trace->m_matchIndex[m_index];
+        if (index != LocalTrace::NO_INDEX) {
+            return Event(m_trace, index);
+        }
+    }
+
     // Search associated BEGIN-type event
     // NOTE: This assumes that no other BEGIN/END pair can be in between
     Event result(*this);
@@ -286,6 +321,14 @@ Event::endptr() const
                          "Method only allowed for BEGIN-type events!");
     }
 
+    // Look up associated END-type event if the navigation index is available
+    if (m_trace->hasNavigationIndex()) {
+        const uint32_t index = m_trace->m_matchIndex[m_index];
+        if (index != LocalTrace::NO_INDEX) {
+            return Event(m_trace, index);
+        }
+    }
+
     // Search associated END-type event
     // NOTE: This assumes that no other BEGIN/END pair can be in between
     Event result(*this);
@@ -490,7 +533,7 @@ pearl::event_typestr(event_t type)
         "MPI_RMA_COLLECTIVE_BEGIN",
         "MPI_RMA_COLLECTIVE_END",
         "MPI_RMA_LOCK",
-        "MPI_RMA_UNLOCK"
+        "MPI_RMA_UNLOCK",
         "GROUP_ALL",
         "GROUP_ENTER",
         "GROUP_SEND",
@@ -503,9 +546,68 @@ pearl::event_typestr(event_t type)
     return type_strings[type];
 }
 
+
+/**
+ *  Returns the set of event types referred to by the given event @a type,
+ *  i.e., the type itself for non-group event types or all member types for
+ *  group event types. Sets can be combined using bitwise operators.
+ *
+ *  @param type  Event type
+ *
+ *  @return Set of event types
+ **/
+event_mask_t
+pearl::event_mask(event_t type)
+{
+    #define BIT(t)  (static_cast<event_mask_t>(1) << (t))
+
+    switch (type) {
+        case GROUP_ALL:
+            return BIT(GROUP_ALL) - 1;
+
+        case GROUP_ENTER:
+            return BIT(ENTER) | BIT(ENTER_CS);
+
+        case GROUP_SEND:
+            return BIT(MPI_SEND) | BIT(MPI_SEND_REQUEST);
+
+        case GROUP_RECV:
+            return BIT(MPI_RECV) | BIT(MPI_RECV_COMPLETE);
+
+        case GROUP_BEGIN:
+            return BIT(MPI_COLLECTIVE_BEGIN) | BIT(MPI_RMA_COLLECTIVE_BEGIN);
+
+        case GROUP_END:
+            return BIT(MPI_COLLECTIVE_END) | BIT(MPI_RMA_COLLECTIVE_END);
+
+        case GROUP_NONBLOCK:
+            return BIT(MPI_SEND_REQUEST)   | BIT(MPI_SEND_COMPLETE)
+                   | BIT(MPI_RECV_REQUEST) | BIT(MPI_RECV_COMPLETE)
+                   | BIT(MPI_REQUEST_TESTED) | BIT(MPI_CANCELLED);
+
+        default:
+            assert(type < GROUP_ALL);
+            return BIT(type);
+    }
+
+    #undef BIT
+}
+
+
 uint64_t
 pearl::getTaskBlockId(const Event& event)
 {
+   // Look up the enclosing task block if the navigation index is available
+   const LocalTrace* trace = event.m_trace;
+   if (trace->hasNavigationIndex()) {
+       const vector<uint32_t>& starts = trace->m_taskBlockStarts;
+       vector<uint32_t>::const_iterator it = upper_bound(starts.begin(),
+                                                         starts.end(),
+                                                         event.m_index);
+       assert(it != starts.begin());
+       return trace->m_taskBlockIds[(it - starts.begin()) - 1];
+   }
+
    Event iter(event);
    uint32_t startId = iter.get_id();
 
@@ -97,6 +97,30 @@ inline bool procGrpCmp(ProcessGroup* item, ProcessGroup::IdType id)
 }
 
 
+/// Returns the entry with the given @a id from a container sorted by
+/// identifiers, or NULL if no such entry exists. If the identifiers are dense
+/// (at least up to @a id), the entry is accessed by direct indexing;
+/// otherwise, a binary search using the comparison function @a cmp is used.
+template<class containerT, typename idT>
+inline typename containerT::value_type
+find_entry(const containerT& container,
+           idT               id,
+           bool              (*cmp)(typename containerT::value_type, idT))
+{
+  if (id < container.size() && container[id]->getId() == id)
+    return container[id];
+
+  typename containerT::const_iterator it = lower_bound(container.begin(),
+                                                       container.end(),
+                                                       id,
+                                                       ptr_fun(cmp));
+  if (container.end() == it || (*it)->getId() != id)
+    return NULL;
+
+  return *it;
+}
+
+
 }   // unnamed namespace
 
 
@@ -251,27 +275,21 @@ const Callsite& GlobalDefs::getCallsite(Callsite::IdType id) const
 
 const Communicator& GlobalDefs::getCommunicator(Communicator::IdType id) const
 {
-    communicator_container::const_iterator it = lower_bound(mCommunicators.begin(),
-                                                            mCommunicators.end(),
-                                                            id,
-                                                            ptr_fun(commCmp));
-    if (mCommunicators.end() == it || (*it)->getId() != id)
+    Communicator* entry = find_entry(mCommunicators, id, commCmp);
+    if (!entry)
         throw RuntimeError("GlobalDefs::getCommunicator(Communicator::IdType) -- Invalid ID.");
 
-    return *(*it);
+    return *entry;
 }
 
 
 const Location& GlobalDefs::getLocation(Location::IdType id) const
 {
-    location_container::const_iterator it = lower_bound(mLocations.begin(),
-                                                        mLocations.end(),
-                                                        id,
-                                                        ptr_fun(locCmp));
-    if (mLocations.end() == it || (*it)->getId() != id)
+    Location* entry = find_entry(mLocations, id, locCmp);
+    if (!entry)
         throw RuntimeError("GlobalDefs::getLocation(Location::IdType) -- Invalid ID.");
 
-    return *(*it);
+    return *entry;
 }
 
 
@@ -285,14 +303,11 @@ const LocationGroup& GlobalDefs::getLocationGroup(LocationGroup::IdType id) cons
 
 const ProcessGroup& GlobalDefs::getProcessGroup(ProcessGroup::IdType id) const
 {
-    pgroup_container::const_iterator it = lower_bound(mProcessGroups.begin(),
-                                                      mProcessGroups.end(),
-                                                      id,
-                                                      ptr_fun(procGrpCmp));
-    if (mProcessGroups.end() == it || (*it)->getId() != id)
+    ProcessGroup* entry = find_entry(mProcessGroups, id, procGrpCmp);
+    if (!entry)
         throw RuntimeError("GlobalDefs::getProcessGroup(ProcessGroup::IdType) -- Invalid ID.");
 
-    return *(*it);
+    return *entry;
 }
 
 
@@ -391,14 +406,13 @@ Communicator* GlobalDefs::get_comm(ident_t id) const
   if (Communicator::NO_ID == id)
     return NULL;
 
-  communicator_container::const_iterator it = lower_bound(mCommunicators.begin(),
-                                                          mCommunicators.end(),
-                                                          id,
-                                                          ptr_fun(commCmp));
-  if (mCommunicators.end() == it || (*it)->getId() != id)
+  Communicator* entry = find_entry(mCommunicators,
+                                   static_cast<Communicator::IdType>(id),
+                                   commCmp);
+  if (!entry)
       throw RuntimeError("GlobalDefs::get_comm(ident_t) -- Invalid ID.");
 
-  return (*it);
+  return entry;
 }
 
 
@@ -24,6 +24,7 @@
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <iomanip>
 #include <map>
 #include <sstream>
@@ -34,16 +35,58 @@
 #include <pearl/Error.h>
 #include <pearl/GlobalDefs.h>
 #include <pearl/LocalTrace.h>
+#include <pearl/MetricTable.h>
 #include <pearl/Region.h>
+#include <pearl/ThreadTaskComplete_rep.h>
+#include <pearl/ThreadTaskSwitch_rep.h>
 
 #include "Calltree.h"
 #include "Functors.h"
+#include "Threading.h"
 
 using namespace std;
 using namespace pearl;
 using namespace pearl::detail;
 
 
+//--- Local helper classes & functions --------------------------------------
+
+namespace
+{
+
+/// Open ENTER and BEGIN-type events of a task while building the
+/// navigation index
+struct TaskBrackets
+{
+  /// Positions of the ENTER events of all active regions
+  vector<uint32_t> enters;
+
+  /// Positions of the unmatched BEGIN-type events
+  vector<uint32_t> begins;
+};
+
+
+/// Records that a task block of the task @a taskId starts at position
+/// @a start, merging it with the preceding block if possible.
+void addTaskBlock(vector<uint32_t>& starts,
+                  vector<uint64_t>& ids,
+                  uint32_t          start,
+                  uint64_t          taskId)
+{
+  if (!ids.empty() && ids.back() == taskId)
+    return;
+
+  if (!starts.empty() && starts.back() == start) {
+    ids.back() = taskId;
+  } else {
+    starts.push_back(start);
+    ids.push_back(taskId);
+  }
+}
+
+}   // unnamed namespace
+
+
 //---------------------------------------------------------------------------
 //
 //  class LocalTrace
@@ -57,7 +100,8 @@ LocalTrace::LocalTrace(const GlobalDefs& defs,
   : m_defs(defs),
     m_omp_parallel(0),
     m_mpi_regions(0),
-    m_location(const_cast<Location*>(&location))
+    m_location(const_cast<Location*>(&location)),
+    m_metrics(NULL)
 {
 }
 
@@ -66,6 +110,8 @@ LocalTrace::~LocalTrace()
 {
   /* Delete events */
   for_each(m_events.begin(), m_events.end(), delete_ptr<Event_rep>());
+
+  delete m_metrics;
 }
 
 
@@ -137,10 +183,209 @@ const GlobalDefs& LocalTrace::get_definitions() const
 }
 
 
+/**
+ *  Returns the table storing the hardware counter values associated with
+ *  the events of this trace. As the table is only created when the first
+ *  values are stored, traces without counter data do not carry any extra
+ *  memory overhead.
+ *
+ *  @return Metric table (NULL if no counter values are available)
+ **/
+const MetricTable* LocalTrace::getMetricTable() const
+{
+  return m_metrics;
+}
+
+
+MetricTable* LocalTrace::getMetricTable()
+{
+  return m_metrics;
+}
+
+
+//--- Event navigation index -----------------------------------------------
+
+/**
+ *  Determines the positions of the matching ENTER/LEAVE and BEGIN/END events
+ *  as well as the position of the innermost enclosing ENTER event for all
+ *  events of this trace in a single forward pass. Afterwards, the navigation
+ *  functions Event::enterptr(), Event::leaveptr(), Event::beginptr(), and
+ *  Event::endptr() are simple table lookups instead of linear scans. Events
+ *  of different OpenMP tasks are matched separately, consistent with the
+ *  task-block handling of the linear scans. Moreover, the positions of the
+ *  events of each type are recorded, which allows replays to visit only
+ *  events of selected types (see PEARL_forward_replay()). The index requires
+ *  three 32-bit integers per event and is invalidated by any modification
+ *  of the trace.
+ *
+ *  In addition, the boundaries of the task blocks (i.e., the ranges of
+ *  events belonging to the same task) are recorded, such that getTaskBlockId()
+ *  becomes a binary search. The bookkeeping data of completed tasks is
+ *  recycled for subsequently created tasks, so that the temporary memory
+ *  requirements depend on the number of concurrently active tasks only.
+ *
+ *  This method has to be called by the thread owning the trace.
+ *
+ *  @see releaseNavigationIndex()
+ **/
+void LocalTrace::buildNavigationIndex() const
+{
+  const uint32_t   numEvents = m_events.size();
+  vector<uint32_t> matchIndex(numEvents, NO_INDEX);
+  vector<uint32_t> parentIndex(numEvents, NO_INDEX);
+  vector<uint32_t> taskBlockStarts;
+  vector<uint64_t> taskBlockIds;
+
+  // Per-type position lists are sized exactly to avoid over-allocation
+  vector< vector<uint32_t> > typeIndex(GROUP_ALL);
+  {
+    vector<uint32_t> typeCounts(GROUP_ALL, 0);
+    for (uint32_t index = 0; index < numEvents; ++index)
+      ++typeCounts[m_events[index]->getType()];
+    for (int type = 0; type < GROUP_ALL; ++type)
+      typeIndex[type].reserve(typeCounts[type]);
+  }
+
+  const uint64_t implicitTaskId =
+    static_cast<uint64_t>(PEARL_GetThreadNumber()) << 32;
+
+  // Task brackets are kept in recycled slots indexed by task identifier;
+  // slot 0 is reserved for the implicit task
+  deque<TaskBrackets>       slots(1);
+  vector<uint32_t>          freeSlots;
+  map<uint64_t, uint32_t>   taskSlots;
+  TaskBrackets*             current = &slots[0];
+
+  taskSlots[implicitTaskId] = 0;
+  addTaskBlock(taskBlockStarts, taskBlockIds, 0, implicitTaskId);
+
+  for (uint32_t index = 0; index < numEvents; ++index) {
+    const Event_rep* event = m_events[index];
+
+    typeIndex[event->getType()].push_back(index);
+
+    // Events following a task switch belong to the new task
+    if (event->isOfType(THREAD_TASK_SWITCH)) {
+      const ThreadTaskSwitch_rep* taskSwitch =
+        static_cast<const ThreadTaskSwitch_rep*>(event);
+      const uint64_t taskId = taskSwitch->getTaskId();
+
+      map<uint64_t, uint32_t>::iterator it = taskSlots.find(taskId);
+      if (it == taskSlots.end()) {
+        uint32_t slot;
+        if (freeSlots.empty()) {
+          slot = slots.size();
+          slots.push_back(TaskBrackets());
+        } else {
+          slot = freeSlots.back();
+          freeSlots.pop_back();
+        }
+        it = taskSlots.insert(make_pair(taskId, slot)).first;
+      }
+      current = &slots[it->second];
+
+      if (index > 0)
+        addTaskBlock(taskBlockStarts, taskBlockIds, index, taskId);
+    }
+    else if (event->isOfType(THREAD_TEAM_BEGIN) && index > 0) {
+      addTaskBlock(taskBlockStarts, taskBlockIds, index, implicitTaskId);
+    }
+
+    vector<uint32_t>& enters = current->enters;
+    if (event->isOfType(GROUP_ENTER)) {
+      if (!enters.empty())
+        parentIndex[index] = enters.back();
+      enters.push_back(index);
+    }
+    else if (event->isOfType(LEAVE)) {
+      if (!enters.empty()) {
+        matchIndex[index]          = enters.back();
+        matchIndex[enters.back()]  = index;
+        parentIndex[index]         = parentIndex[enters.back()];
+        enters.pop_back();
+      }
+    }
+    else {
+      if (!enters.empty())
+        parentIndex[index] = enters.back();
+
+      vector<uint32_t>& begins = current->begins;
+      if (event->isOfType(GROUP_BEGIN)) {
+        begins.push_back(index);
+      }
+      else if (event->isOfType(GROUP_END) && !begins.empty()) {
+        matchIndex[index]         = begins.back();
+        matchIndex[begins.back()] = index;
+        begins.pop_back();
+      }
+    }
+
+    // Completed tasks implicitly fall back to the implicit task; their
+    // slot is released for reuse
+    if (event->isOfType(THREAD_TASK_COMPLETE)) {
+      const ThreadTaskComplete_rep* taskComplete =
+        static_cast<const ThreadTaskComplete_rep*>(event);
+      const uint64_t taskId = taskComplete->getTaskId();
+      if (taskId != implicitTaskId) {
+        map<uint64_t, uint32_t>::iterator it = taskSlots.find(taskId);
+        if (it != taskSlots.end()) {
+          slots[it->second].enters.clear();
+          slots[it->second].begins.clear();
+          freeSlots.push_back(it->second);
+          taskSlots.erase(it);
+        }
+      }
+      current = &slots[0];
+
+      if (index > 0) {
+        addTaskBlock(taskBlockStarts, taskBlockIds, index, taskId);
+        addTaskBlock(taskBlockStarts, taskBlockIds, index + 1, implicitTaskId);
+      }
+    }
+  }
+
+  m_matchIndex.swap(matchIndex);
+  m_parentIndex.swap(parentIndex);
+  m_taskBlockStarts.swap(taskBlockStarts);
+  m_taskBlockIds.swap(taskBlockIds);
+  m_typeIndex.swap(typeIndex);
+}
+
+
+/**
+ *  Releases the memory occupied by the navigation index. Subsequent calls
+ *  to the navigation functions of the Event class fall back to linear scans.
+ *
+ *  @see buildNavigationIndex()
+ **/
+void LocalTrace::releaseNavigationIndex() const
+{
+  vector<uint32_t>().swap(m_matchIndex);
+  vector<uint32_t>().swap(m_parentIndex);
+  vector<uint32_t>().swap(m_taskBlockStarts);
+  vector<uint64_t>().swap(m_taskBlockIds);
+  vector< vector<uint32_t> >().swap(m_typeIndex);
+}
+
+
+/**
+ *  Returns whether a valid navigation index is currently available.
+ *
+ *  @return True if the navigation index is available, false otherwise
+ **/
+bool LocalTrace::hasNavigationIndex() const
+{
+  return !m_parentIndex.empty();
+}
+
+
 //--- Store new events ------------------------------------------------------
 
 void LocalTrace::add_event(Event_rep* event)
 {
+  if (hasNavigationIndex())
+    releaseNavigationIndex();
+
   // When entering an OpenMP parallel or MPI region, increment counter
   if (event->isOfType(GROUP_ENTER)) {
     Enter_rep*    enter  = static_cast<Enter_rep*>(event);
@@ -158,10 +403,29 @@ void LocalTrace::add_event(Event_rep* event)
 }
 
 
+/**
+ *  Associates the given hardware counter @a values with the given @a event
+ *  of this trace. The array has to provide one value for each metric defined
+ *  in the global definitions. Values have to be added in trace order.
+ *
+ *  @param event   Event the values belong to
+ *  @param values  Metric values
+ **/
+void LocalTrace::addMetricValues(const Event& event, const uint64_t* values)
+{
+  assert(event.m_trace == this && event.m_index < size());
+
+  if (!m_metrics)
+    m_metrics = new MetricTable(m_defs.num_metrics());
+  m_metrics->append(event.m_index, values);
+}
+
+
 //--- Inserting & removing elements -----------------------------------------
 
 LocalTrace::iterator LocalTrace::remove_if(bool (*predicate)(const Event_rep* event))
 {
+  releaseNavigationIndex();
   uint32_t index = std::remove_if(m_events.begin(),
                                   m_events.end(),
                                   predicate) - m_events.begin();
@@ -173,6 +437,7 @@ LocalTrace::iterator LocalTrace::remove_if(bool (*predicate)(const Event_rep* ev
 LocalTrace::iterator LocalTrace::insert(LocalTrace::iterator pos,
                                         Event_rep*           event)
 {
+  releaseNavigationIndex();
   m_events.insert(m_events.begin() + pos.m_index, event);
   m_defs.get_calltree()->setModified();
 
@@ -184,6 +449,7 @@ LocalTrace::iterator LocalTrace::erase(LocalTrace::iterator pos)
 {
   assert(pos.m_index < size());
 
+  releaseNavigationIndex();
   m_events.erase(m_events.begin() + pos.m_index);
   m_defs.get_calltree()->setModified();
 
@@ -196,6 +462,7 @@ LocalTrace::iterator LocalTrace::erase(LocalTrace::iterator begin,
 {
   assert(begin.m_index < size());
 
+  releaseNavigationIndex();
   m_events.erase(m_events.begin() + begin.m_index,
                  m_events.begin() + end.m_index);
   m_defs.get_calltree()->setModified();
@@ -206,6 +473,7 @@ LocalTrace::iterator LocalTrace::erase(LocalTrace::iterator begin,
 
 LocalTrace::iterator LocalTrace::replace(LocalTrace::iterator pos, Event_rep* event)
 {
+  releaseNavigationIndex();
   m_events[pos.m_index] = event;
   m_defs.get_calltree()->setModified();
 
@@ -215,6 +483,7 @@ LocalTrace::iterator LocalTrace::replace(LocalTrace::iterator pos, Event_rep* ev
 
 LocalTrace::iterator LocalTrace::swap(const LocalTrace::iterator& a, const LocalTrace::iterator& b)
 {
+  releaseNavigationIndex();
   std::iter_swap(m_events.begin()+a.m_index, m_events.begin()+b.m_index);
   m_defs.get_calltree()->setModified();
 
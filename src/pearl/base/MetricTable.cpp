@@ -0,0 +1,482 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file
+ *  @ingroup PEARL_base
+ *  @brief   Implementation of the class MetricTable.
+ *
+ *  This file provides the implementation of the class MetricTable and its
+ *  nested class MetricTable::Cursor.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+#include <config.h>
+#include <pearl/MetricTable.h>
+
+#include <algorithm>
+#include <cassert>
+
+#include <pearl/Buffer.h>
+#include <pearl/Error.h>
+
+using namespace std;
+using namespace pearl;
+
+
+//--- Local constants -------------------------------------------------------
+
+namespace
+{
+
+/// Number of rows per block, i.e., the maximum number of rows that needs to
+/// be decoded for random access
+const uint32_t BLOCK_SIZE = 64;
+
+}   // unnamed namespace
+
+
+//--- Local helper functions ------------------------------------------------
+
+namespace
+{
+
+/// @brief Append variable-length integer
+///
+/// Appends the given @a value to the byte @a stream using a variable-length
+/// encoding with seven payload bits per byte.
+///
+/// @param stream
+///     Byte stream
+/// @param value
+///     Value to be stored
+///
+inline void
+putVarint(vector<uint8_t>& stream,
+          uint64_t         value)
+{
+    while (value >= 0x80) {
+        stream.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    stream.push_back(static_cast<uint8_t>(value));
+}
+
+
+/// @brief Read variable-length integer
+///
+/// Decodes a variable-length integer from the byte @a stream starting at
+/// the given @a offset, which is advanced accordingly.
+///
+/// @param stream
+///     Byte stream
+/// @param offset
+///     Read offset (input/output parameter)
+/// @returns
+///     Decoded value
+///
+inline uint64_t
+getVarint(const vector<uint8_t>& stream,
+          uint32_t&              offset)
+{
+    uint64_t value = 0;
+    int      shift = 0;
+    uint8_t  byte;
+    do {
+        byte   = stream[offset++];
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+
+    return value;
+}
+
+
+/// @brief Map signed difference to unsigned value
+///
+/// Maps the (wrap-around) difference of two counter values to an unsigned
+/// value such that differences of small magnitude result in small values,
+/// regardless of their sign.
+///
+inline uint64_t
+zigzagEncode(uint64_t delta)
+{
+    return (delta << 1) ^ (0 - (delta >> 63));
+}
+
+
+/// @brief Inverse of zigzagEncode()
+///
+inline uint64_t
+zigzagDecode(uint64_t value)
+{
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+}   // unnamed namespace
+
+
+//---------------------------------------------------------------------------
+//
+//  class MetricTable
+//
+//---------------------------------------------------------------------------
+
+//--- Constructors & destructor ---------------------------------------------
+
+/**
+ *  Creates a new, empty table for storing the values of @a numMetrics
+ *  metrics per row.
+ *
+ *  @param  numMetrics  Number of metric columns
+ **/
+MetricTable::MetricTable(uint32_t numMetrics)
+    : mNumMetrics(numMetrics),
+      mNumRows(0),
+      mStreams(numMetrics + 1),
+      mLastPosition(0),
+      mLastValues(numMetrics, 0)
+{
+}
+
+
+/**
+ *  Creates a new table and initializes it with the data stored in
+ *  @a buffer, previously serialized using pack().
+ *
+ *  @param  buffer  Buffer holding the serialized table
+ **/
+MetricTable::MetricTable(Buffer& buffer)
+    : mNumMetrics(buffer.get_uint32()),
+      mNumRows(buffer.get_uint32()),
+      mStreams(mNumMetrics + 1),
+      mLastPosition(buffer.get_uint32()),
+      mLastValues(mNumMetrics)
+{
+    for (uint32_t metric = 0; metric < mNumMetrics; ++metric)
+        mLastValues[metric] = buffer.get_uint64();
+
+    for (uint32_t index = 0; index < mStreams.size(); ++index) {
+        vector<uint8_t>& stream = mStreams[index];
+
+        stream.resize(buffer.get_uint32());
+        for (uint32_t offset = 0; offset < stream.size(); ++offset)
+            stream[offset] = buffer.get_uint8();
+    }
+
+    const uint32_t numBlocks = (mNumRows + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    mBlockPositions.resize(numBlocks);
+    mBlockOffsets.resize(numBlocks * mStreams.size());
+    for (uint32_t index = 0; index < mBlockPositions.size(); ++index)
+        mBlockPositions[index] = buffer.get_uint32();
+    for (uint32_t index = 0; index < mBlockOffsets.size(); ++index)
+        mBlockOffsets[index] = buffer.get_uint32();
+}
+
+
+//--- Query functions -------------------------------------------------------
+
+/**
+ *  Returns the number of metric columns, i.e., the number of values stored
+ *  per event.
+ *
+ *  @return Number of metrics
+ **/
+uint32_t
+MetricTable::numMetrics() const
+{
+    return mNumMetrics;
+}
+
+
+/**
+ *  Returns the number of rows, i.e., the number of events for which metric
+ *  values are stored.
+ *
+ *  @return Number of rows
+ **/
+uint32_t
+MetricTable::numRows() const
+{
+    return mNumRows;
+}
+
+
+/**
+ *  Retrieves the metric values stored for the event at the given trace
+ *  @a position. The values are written to the array @a values, which has
+ *  to provide space for numMetrics() entries.
+ *
+ *  @param  position  Event position in the local trace
+ *  @param  values    Metric values (output parameter)
+ *
+ *  @return True if values are stored for the given event, false otherwise
+ **/
+bool
+MetricTable::getValues(uint32_t  position,
+                       uint64_t* values) const
+{
+    vector<uint32_t>::const_iterator it = upper_bound(mBlockPositions.begin(),
+                                                      mBlockPositions.end(),
+                                                      position);
+    if (it == mBlockPositions.begin())
+        return false;
+
+    const uint32_t block = (it - mBlockPositions.begin()) - 1;
+    const uint32_t last  = min(mNumRows, (block + 1) * BLOCK_SIZE);
+
+    vector<uint32_t> offsets(mBlockOffsets.begin() + block * mStreams.size(),
+                             mBlockOffsets.begin() + (block + 1) * mStreams.size());
+    vector<uint64_t> row(mNumMetrics);
+    uint32_t         rowPosition = 0;
+    for (uint32_t index = block * BLOCK_SIZE; index < last; ++index) {
+        decodeRow(offsets, index, rowPosition, row);
+        if (rowPosition == position) {
+            copy(row.begin(), row.end(), values);
+
+            return true;
+        }
+        if (rowPosition > position)
+            break;
+    }
+
+    return false;
+}
+
+
+//--- Storing values --------------------------------------------------------
+
+/**
+ *  Appends a new row storing the given metric @a values for the event at
+ *  trace @a position. Rows have to be appended in increasing order of
+ *  their event positions.
+ *
+ *  @param  position  Event position in the local trace
+ *  @param  values    Array of numMetrics() metric values
+ *
+ *  @throw  pearl::FatalError  if @a position is not increasing
+ **/
+void
+MetricTable::append(uint32_t        position,
+                    const uint64_t* values)
+{
+    if ((mNumRows > 0) && (position <= mLastPosition))
+        throw FatalError("MetricTable::append(uint32_t,const uint64_t*) -- "
+                         "Positions not increasing.");
+
+    // The first row of each block is encoded relative to zero
+    if (mNumRows % BLOCK_SIZE == 0) {
+        mBlockPositions.push_back(position);
+        for (uint32_t index = 0; index < mStreams.size(); ++index)
+            mBlockOffsets.push_back(mStreams[index].size());
+
+        mLastPosition = 0;
+        fill(mLastValues.begin(), mLastValues.end(), 0);
+    }
+
+    putVarint(mStreams[0], position - mLastPosition);
+    for (uint32_t metric = 0; metric < mNumMetrics; ++metric)
+        putVarint(mStreams[metric + 1],
+                  zigzagEncode(values[metric] - mLastValues[metric]));
+
+    mLastPosition = position;
+    copy(values, values + mNumMetrics, mLastValues.begin());
+    ++mNumRows;
+}
+
+
+/**
+ *  Updates the event positions of all rows after the events of the local
+ *  trace have been reordered. The sorted array @a oldPositions lists the
+ *  previous positions of all events potentially associated with metric
+ *  values, @a newPositions the corresponding positions after reordering.
+ *  The relative order of these events must not have changed. Rows of
+ *  events not listed in @a oldPositions are dropped.
+ *
+ *  @param  oldPositions  Event positions before reordering
+ *  @param  newPositions  Event positions after reordering
+ **/
+void
+MetricTable::remap(const vector<uint32_t>& oldPositions,
+                   const vector<uint32_t>& newPositions)
+{
+    assert(oldPositions.size() == newPositions.size());
+
+    MetricTable result(mNumMetrics);
+    Cursor      cursor(*this);
+    while (cursor.next()) {
+        vector<uint32_t>::const_iterator it = lower_bound(oldPositions.begin(),
+                                                          oldPositions.end(),
+                                                          cursor.getPosition());
+        if ((it == oldPositions.end()) || (*it != cursor.getPosition()))
+            continue;
+
+        result.append(newPositions[it - oldPositions.begin()],
+                      cursor.getValues());
+    }
+
+    mNumRows      = result.mNumRows;
+    mLastPosition = result.mLastPosition;
+    mStreams.swap(result.mStreams);
+    mBlockPositions.swap(result.mBlockPositions);
+    mBlockOffsets.swap(result.mBlockOffsets);
+    mLastValues.swap(result.mLastValues);
+}
+
+
+//--- Serialization ---------------------------------------------------------
+
+/**
+ *  Serializes the table data into the given @a buffer.
+ *
+ *  @param  buffer  Buffer storing the serialized table
+ **/
+void
+MetricTable::pack(Buffer& buffer) const
+{
+    buffer.put_uint32(mNumMetrics);
+    buffer.put_uint32(mNumRows);
+    buffer.put_uint32(mLastPosition);
+    for (uint32_t metric = 0; metric < mNumMetrics; ++metric)
+        buffer.put_uint64(mLastValues[metric]);
+
+    for (uint32_t index = 0; index < mStreams.size(); ++index) {
+        const vector<uint8_t>& stream = mStreams[index];
+
+        buffer.put_uint32(stream.size());
+        for (uint32_t offset = 0; offset < stream.size(); ++offset)
+            buffer.put_uint8(stream[offset]);
+    }
+
+    for (uint32_t index = 0; index < mBlockPositions.size(); ++index)
+        buffer.put_uint32(mBlockPositions[index]);
+    for (uint32_t index = 0; index < mBlockOffsets.size(); ++index)
+        buffer.put_uint32(mBlockOffsets[index]);
+}
+
+
+//--- Private methods -------------------------------------------------------
+
+/**
+ *  Decodes the given @a row, starting at the stream @a offsets which are
+ *  advanced accordingly. The @a position and @a values have to hold the
+ *  data of the preceding row, unless @a row is the first row of a block.
+ *
+ *  @param  offsets   Read offsets of all streams (input/output parameter)
+ *  @param  row       Row index
+ *  @param  position  Event position (input/output parameter)
+ *  @param  values    Metric values (input/output parameter)
+ **/
+void
+MetricTable::decodeRow(vector<uint32_t>& offsets,
+                       uint32_t          row,
+                       uint32_t&         position,
+                       vector<uint64_t>& values) const
+{
+    if (row % BLOCK_SIZE == 0) {
+        position = 0;
+        fill(values.begin(), values.end(), 0);
+    }
+
+    position += getVarint(mStreams[0], offsets[0]);
+    for (uint32_t metric = 0; metric < mNumMetrics; ++metric)
+        values[metric] += zigzagDecode(getVarint(mStreams[metric + 1],
+                                                 offsets[metric + 1]));
+}
+
+
+//---------------------------------------------------------------------------
+//
+//  class MetricTable::Cursor
+//
+//---------------------------------------------------------------------------
+
+//--- Constructors & destructor ---------------------------------------------
+
+/**
+ *  Creates a new cursor positioned before the first row of the given
+ *  @a table.
+ *
+ *  @param  table  Metric table
+ **/
+MetricTable::Cursor::Cursor(const MetricTable& table)
+    : mTable(table),
+      mRow(0),
+      mOffsets(table.mNumMetrics + 1, 0),
+      mPosition(0),
+      mValues(table.mNumMetrics, 0)
+{
+}
+
+
+//--- Iteration -------------------------------------------------------------
+
+/**
+ *  Advances the cursor to the next row.
+ *
+ *  @return True if successful, false if the end of the table was reached
+ **/
+bool
+MetricTable::Cursor::next()
+{
+    if (mRow >= mTable.mNumRows)
+        return false;
+
+    mTable.decodeRow(mOffsets, mRow, mPosition, mValues);
+    ++mRow;
+
+    return true;
+}
+
+
+//--- Access to the current row ---------------------------------------------
+
+/**
+ *  Returns the event position of the current row.
+ *
+ *  @return Event position in the local trace
+ **/
+uint32_t
+MetricTable::Cursor::getPosition() const
+{
+    return mPosition;
+}
+
+
+/**
+ *  Returns the value of the given @a metric stored in the current row.
+ *
+ *  @param  metric  Metric identifier
+ *
+ *  @return Metric value
+ **/
+uint64_t
+MetricTable::Cursor::getValue(uint32_t metric) const
+{
+    assert(metric < mValues.size());
+
+    return mValues[metric];
+}
+
+
+/**
+ *  Returns the array of all metric values stored in the current row.
+ *
+ *  @return Pointer to numMetrics() metric values
+ **/
+const uint64_t*
+MetricTable::Cursor::getValues() const
+{
+    return mValues.empty() ? NULL : &mValues[0];
+}
@@ -196,6 +196,9 @@ Otf2Archive::readDefinitions(GlobalDefs* defs)
     mTimerResolution = cbData.mTimerResolution;
     mGlobalOffset    = cbData.mGlobalOffset;
 
+    // Store metric class data
+    mMetricClasses.swap(cbData.mMetricClasses);
+
     // Close definition reader
     result = OTF2_Reader_CloseGlobalDefReader(mArchiveReader, defReader);
     if (result != OTF2_SUCCESS) {
@@ -374,7 +377,8 @@ Otf2Archive::readTrace(const GlobalDefs& defs,
     SET_EVT_CALLBACK(ThreadWait);
 
     // Install callbacks
-    Otf2EvtCbData  cbData(defs, *trace, mTimerResolution, mGlobalOffset);
+    Otf2EvtCbData  cbData(defs, *trace, mTimerResolution, mGlobalOffset,
+                          mMetricClasses);
     OTF2_ErrorCode result;
     result = OTF2_EvtReader_SetCallbacks(evtReader, callbacks, &cbData);
     if (result != OTF2_SUCCESS) {
@@ -34,6 +34,8 @@
 
 #include <pearl/TraceArchive.h>
 
+#include "Otf2DefCallbacks.h"
+
 
 namespace pearl
 {
@@ -98,6 +100,9 @@ class Otf2Archive
         /// Global time offset (approximate timestamp of first event)
         uint64_t mGlobalOffset;
 
+        /// Members of the synchronous OTF2 metric classes
+        Otf2MetricClassMap mMetricClasses;
+
 
         //--- Private member functions & friends -----------
 
@@ -34,6 +34,8 @@
 #include <exception>
 #include <string>
 
+#include <elg_defs.h>
+
 #include <pearl/Error.h>
 #include <pearl/GlobalDefs.h>
 
@@ -386,7 +388,7 @@ pearl::detail::otf2DefCbLocationProperty(void* const               userData,
 
 
 /// @todo
-///     Implement callback; MetricClass definitions are currently ignored
+///     Handle asynchronous metric classes
 OTF2_CallbackCode
 pearl::detail::otf2DefCbMetricClass(void* const                       userData,
                                     const OTF2_MetricRef              self,
@@ -395,6 +397,27 @@ pearl::detail::otf2DefCbMetricClass(void* const                       userData,
                                     const OTF2_MetricOccurrence       metricOccurrence,
                                     const OTF2_RecorderKind           recorderKind)
 {
+    CALLBACK_SETUP
+
+    // Only metrics recorded together with Enter/Leave events can be
+    // attributed to call paths
+    if (metricOccurrence == OTF2_METRIC_ASYNCHRONOUS) {
+        return OTF2_CALLBACK_SUCCESS;
+    }
+
+    vector<uint32_t>& members = data->mMetricClasses[self];
+    members.reserve(numberOfMetrics);
+    for (uint8_t index = 0; index < numberOfMetrics; ++index) {
+        map<uint32_t, uint32_t>::const_iterator it =
+            data->mMetricMembers.find(metricMembers[index]);
+        if (it == data->mMetricMembers.end()) {
+            throw FatalError("Unknown metric member.");
+        }
+        members.push_back(it->second);
+    }
+
+    CALLBACK_CLEANUP
+
     return OTF2_CALLBACK_SUCCESS;
 }
 
@@ -426,7 +449,7 @@ pearl::detail::otf2DefCbMetricInstance(void* const            userData,
 
 
 /// @todo
-///     Implement callback; MetricMember definitions are currently ignored
+///     Support metric modes other than accumulated counters
 OTF2_CallbackCode
 pearl::detail::otf2DefCbMetricMember(void* const                userData,
                                      const OTF2_MetricMemberRef self,
@@ -439,6 +462,26 @@ pearl::detail::otf2DefCbMetricMember(void* const                userData,
                                      const int64_t              exponent,
                                      const OTF2_StringRef       unit)
 {
+    CALLBACK_SETUP
+
+    // Only integer counters accumulated since the start of the measurement
+    // are supported; values of other metrics are ignored
+    uint32_t metricId = UNSUPPORTED_METRIC;
+    if ((metricMode == OTF2_METRIC_ACCUMULATED_START)
+        && ((valueType == OTF2_TYPE_UINT64) || (valueType == OTF2_TYPE_INT64))) {
+        metricId = defs.num_metrics();
+        DefsFactory::instance()->createMetric(defs,
+                                              metricId,
+                                              defs.getString(name).getString(),
+                                              defs.getString(description).getString(),
+                                              ELG_INTEGER,
+                                              ELG_COUNTER,
+                                              ELG_START);
+    }
+    data->mMetricMembers[self] = metricId;
+
+    CALLBACK_CLEANUP
+
     return OTF2_CALLBACK_SUCCESS;
 }
 
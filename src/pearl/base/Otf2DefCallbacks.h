@@ -30,7 +30,9 @@
 #define PEARL_OTF2DEFCALLBACKS_H
 
 
+#include <map>
 #include <string>
+#include <vector>
 
 #include <otf2/OTF2_AttributeValue.h>
 #include <otf2/OTF2_Definitions.h>
@@ -46,6 +48,19 @@ class LocalTrace;
 
 namespace detail
 {
+//--- Type definitions ------------------------------------------------------
+
+/// Mapping from OTF2 metric class identifiers to the PEARL metric IDs of
+/// the individual class members (UNSUPPORTED_METRIC for members ignored)
+typedef std::map<uint32_t, std::vector<uint32_t> > Otf2MetricClassMap;
+
+
+//--- Constants -------------------------------------------------------------
+
+/// PEARL metric ID used for OTF2 metric members that are not supported
+const uint32_t UNSUPPORTED_METRIC = ~static_cast<uint32_t>(0);
+
+
 /*-------------------------------------------------------------------------*/
 /**
  *  @struct  Otf2DefCbData
@@ -97,6 +112,12 @@ struct Otf2DefCbData
 
     /// Estimated timestamp of the first event
     uint64_t mGlobalOffset;
+
+    /// Mapping from OTF2 metric member identifiers to PEARL metric IDs
+    std::map<uint32_t, uint32_t> mMetricMembers;
+
+    /// Members of the synchronous OTF2 metric classes
+    Otf2MetricClassMap mMetricClasses;
 };
 
 
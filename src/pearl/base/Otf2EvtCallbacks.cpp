@@ -30,12 +30,15 @@
 #include "Otf2EvtCallbacks.h"
 #include "Otf2TypeHelpers.h"
 
+#include <algorithm>
+
 #include <pearl/GlobalDefs.h>
 #include <pearl/LocalTrace.h>
 #include <pearl/Region.h>
 
 #include "EventFactory.h"
 
+using namespace std;
 using namespace pearl;
 using namespace pearl::detail;
 
@@ -44,14 +47,20 @@ using namespace pearl::detail;
 
 namespace
 {
+void
+attachMetrics(Otf2EvtCbData* data,
+              OTF2_TimeStamp time);
 CallingContext*
 getContext(const GlobalDefs&      defs,
            OTF2_CallingContextRef contextId);
+uint32_t
+getContextDepth(Otf2EvtCbData*  data,
+                CallingContext* context);
 void
-processContext(const Otf2EvtCbData* data,
-               timestamp_t          time,
-               CallingContext*      context,
-               uint32_t             distance);
+processContext(Otf2EvtCbData*  data,
+               timestamp_t     time,
+               CallingContext* context,
+               uint32_t        distance);
 }   // unnamed namespace
 
 
@@ -63,7 +72,7 @@ processContext(const Otf2EvtCbData* data,
 Otf2EvtCbData::~Otf2EvtCbData()
 {
     // "Close" call stack after last sample of CCT traces
-    if (mPreviousContext != 0) {
+    if (!mContextStack.empty()) {
         processContext(this, mTrace.end().prev()->getTimestamp(), 0, 1);
     }
 }
@@ -131,7 +140,6 @@ pearl::detail::otf2EvtCbCallingContextEnter(const OTF2_LocationRef       locatio
     if (context != 0) {
         const timestamp_t timestamp = otf2ConvertTime(time, data);
         processContext(data, timestamp, context, unwindDistance);
-        data->mPreviousContext = context;
     }
     CALLBACK_CLEANUP
 
@@ -162,7 +170,7 @@ pearl::detail::otf2EvtCbCallingContextLeave(const OTF2_LocationRef       locatio
             data->mTrace.add_event(event);
         }
 
-        data->mPreviousContext = context->getParent();
+        data->mContextStack.pop_back();
     }
     CALLBACK_CLEANUP
 
@@ -185,7 +193,6 @@ pearl::detail::otf2EvtCbCallingContextSample(const OTF2_LocationRef           lo
     if (context != 0) {
         const timestamp_t timestamp = otf2ConvertTime(time, data);
         processContext(data, timestamp, context, unwindDistance);
-        data->mPreviousContext = context;
     }
     CALLBACK_CLEANUP
 
@@ -193,8 +200,6 @@ pearl::detail::otf2EvtCbCallingContextSample(const OTF2_LocationRef           lo
 }
 
 
-/// @todo
-///     Handle HWC metrics
 OTF2_CallbackCode
 pearl::detail::otf2EvtCbEnter(const OTF2_LocationRef    location,
                               const OTF2_TimeStamp      time,
@@ -211,6 +216,7 @@ pearl::detail::otf2EvtCbEnter(const OTF2_LocationRef    location,
                                               NULL);
     if (event) {
         trace.add_event(event);
+        attachMetrics(data, time);
     }
     CALLBACK_CLEANUP
 
@@ -218,8 +224,6 @@ pearl::detail::otf2EvtCbEnter(const OTF2_LocationRef    location,
 }
 
 
-/// @todo
-///     Handle HWC metrics
 OTF2_CallbackCode
 pearl::detail::otf2EvtCbLeave(const OTF2_LocationRef    location,
                               const OTF2_TimeStamp      time,
@@ -236,6 +240,7 @@ pearl::detail::otf2EvtCbLeave(const OTF2_LocationRef    location,
                                               NULL);
     if (event) {
         trace.add_event(event);
+        attachMetrics(data, time);
     }
     CALLBACK_CLEANUP
 
@@ -278,7 +283,7 @@ pearl::detail::otf2EvtCbMeasurementOnOff(const OTF2_LocationRef     location,
 
 
 /// @todo
-///     Implement callback; Metric events are currently ignored
+///     Handle metric instances and floating-point values
 OTF2_CallbackCode
 pearl::detail::otf2EvtCbMetric(const OTF2_LocationRef        location,
                                const OTF2_TimeStamp          time,
@@ -290,6 +295,40 @@ pearl::detail::otf2EvtCbMetric(const OTF2_LocationRef        location,
                                const OTF2_Type* const        typeIDs,
                                const OTF2_MetricValue* const metricValues)
 {
+    CALLBACK_SETUP
+    Otf2MetricClassMap::const_iterator it = data->mMetricClasses.find(metric);
+    if (it != data->mMetricClasses.end()) {
+        const vector<uint32_t>& members = it->second;
+
+        // Values are kept until the next Metric event, so that metrics not
+        // recorded there retain their previous values
+        if (data->mMetricValues.empty()) {
+            data->mMetricValues.resize(defs.num_metrics(), 0);
+        }
+
+        const uint8_t count = min<size_t>(numberOfMetrics, members.size());
+        for (uint8_t index = 0; index < count; ++index) {
+            const uint32_t metricId = members[index];
+            if (metricId == UNSUPPORTED_METRIC) {
+                continue;
+            }
+            if (typeIDs[index] == OTF2_TYPE_INT64) {
+                data->mMetricValues[metricId] = metricValues[index].signed_int;
+            } else {
+                data->mMetricValues[metricId] = metricValues[index].unsigned_int;
+            }
+        }
+
+        if (data->mCounterEventPending && (data->mCounterEventTime == time)) {
+            trace.addMetricValues(data->mCounterEvent, &data->mMetricValues[0]);
+            data->mCounterEventPending = false;
+        } else {
+            data->mMetricTime     = time;
+            data->mMetricsPending = true;
+        }
+    }
+    CALLBACK_CLEANUP
+
     return OTF2_CALLBACK_SUCCESS;
 }
 
@@ -367,6 +406,7 @@ pearl::detail::otf2EvtCbMpiIrecv(const OTF2_LocationRef    location,
                                                         requestID);
     if (event) {
         trace.add_event(event);
+        data->mRequests.link(trace.end().prev());
     }
     CALLBACK_CLEANUP
 
@@ -389,6 +429,7 @@ pearl::detail::otf2EvtCbMpiIrecvRequest(const OTF2_LocationRef    location,
                                                        requestID);
     if (event) {
         trace.add_event(event);
+        data->mRequests.link(trace.end().prev());
     }
     CALLBACK_CLEANUP
 
@@ -419,6 +460,7 @@ pearl::detail::otf2EvtCbMpiIsend(const OTF2_LocationRef    location,
                                                        requestID);
     if (event) {
         trace.add_event(event);
+        data->mRequests.link(trace.end().prev());
     }
     CALLBACK_CLEANUP
 
@@ -441,6 +483,7 @@ pearl::detail::otf2EvtCbMpiIsendComplete(const OTF2_LocationRef    location,
                                                         requestID);
     if (event) {
         trace.add_event(event);
+        data->mRequests.link(trace.end().prev());
     }
     CALLBACK_CLEANUP
 
@@ -491,6 +534,7 @@ pearl::detail::otf2EvtCbMpiRequestCancelled(const OTF2_LocationRef    location,
                                                      requestID);
     if (event) {
         trace.add_event(event);
+        data->mRequests.link(trace.end().prev());
     }
     CALLBACK_CLEANUP
 
@@ -513,6 +557,7 @@ pearl::detail::otf2EvtCbMpiRequestTest(const OTF2_LocationRef    location,
                                                          requestID);
     if (event) {
         trace.add_event(event);
+        data->mRequests.link(trace.end().prev());
     }
     CALLBACK_CLEANUP
 
@@ -1177,10 +1222,9 @@ pearl::detail::otf2EvtCbThreadTeamEnd(const OTF2_LocationRef    location,
     const timestamp_t timestamp = otf2ConvertTime(time, data);
 
     // CCT traces: "Close" call stack before leaving the thread team
-    if (data->mPreviousContext != 0) {
+    if (!data->mContextStack.empty()) {
         if (trace.get_location().getThreadId() != 0) {
             processContext(data, timestamp, 0, 1);
-            data->mPreviousContext = 0;
         }
     }
 
@@ -1225,6 +1269,41 @@ pearl::detail::otf2EvtCbThreadWait(const OTF2_LocationRef    location,
 
 namespace
 {
+/// @brief Attach metric values to the last Enter/Leave event.
+///
+/// Stores the values of the most recent Metric event in the metric table of
+/// the local trace, associating them with the Enter/Leave event added last.
+/// Synchronous metrics are recorded either directly before or directly
+/// after the Enter/Leave event they belong to, thus the values are only
+/// attached if their timestamps match.  Otherwise, the event is remembered
+/// as candidate for a subsequent Metric event.
+///
+/// @param data
+///     OTF2 event callback data
+/// @param time
+///     Timestamp of the last event in ticks
+///
+void
+attachMetrics(Otf2EvtCbData* const data,
+              const OTF2_TimeStamp time)
+{
+    if (data->mMetricClasses.empty()) {
+        return;
+    }
+
+    const Event event = data->mTrace.end().prev();
+    if (data->mMetricsPending && (data->mMetricTime == time)) {
+        data->mTrace.addMetricValues(event, &data->mMetricValues[0]);
+        data->mCounterEventPending = false;
+    } else {
+        data->mCounterEvent        = event;
+        data->mCounterEventTime    = time;
+        data->mCounterEventPending = true;
+    }
+    data->mMetricsPending = false;
+}
+
+
 /// @brief Get pointer of calling context definition object.
 ///
 /// Returns a pointer to the calling context definition object referenced by
@@ -1251,67 +1330,136 @@ getContext(const GlobalDefs&            defs,
 }
 
 
+/// @brief Get depth of a calling context node.
+///
+/// Returns the depth of the given calling context node @a context in the
+/// calling context tree, with root nodes having a depth of 1.  The depths are
+/// cached in @a data, i.e., only the path up to the closest ancestor with a
+/// known depth needs to be traversed.
+///
+/// @param data
+///     OTF2 event callback data
+/// @param context
+///     Calling context node
+/// @returns
+///     Depth of the calling context node
+///
+uint32_t
+getContextDepth(Otf2EvtCbData* const  data,
+                CallingContext* const context)
+{
+    vector<uint32_t>& depths = data->mContextDepths;
+    if (depths.empty()) {
+        depths.resize(data->mDefinitions.numCallingContexts(), 0);
+    }
+
+    // Determine depth relative to the closest ancestor with known depth
+    uint32_t        depth = 0;
+    CallingContext* node  = context;
+    while (node && (depths[node->getId()] == 0)) {
+        ++depth;
+        node = node->getParent();
+    }
+    if (node) {
+        depth += depths[node->getId()];
+    }
+
+    // Cache depths of all nodes along the path
+    node = context;
+    while (node && (depths[node->getId()] == 0)) {
+        depths[node->getId()] = depth--;
+        node                  = node->getParent();
+    }
+
+    return depths[context->getId()];
+}
+
+
 /// @brief Enter a calling context after leaving contexts of previous sample.
 ///
 /// Determines which calling context nodes have been left since the previous
-/// sample stored in @a data based on the given unwind @a distance and creates
-/// a corresponding sequence of LEAVE events as well as a sequence of ENTER
-/// events then leading to the current @a context, all with the timestamp
-/// @a time.
+/// calling context event stored in @a data and creates a corresponding
+/// sequence of LEAVE events as well as a sequence of ENTER events then
+/// leading to the current @a context, all with the timestamp @a time.  The
+/// nodes shared with the previous context are not revisited: based on the
+/// cached node depth and the given unwind @a distance, the common ancestor
+/// is looked up directly on the stack of active nodes.  If the unwind
+/// distance is unknown (i.e., zero), exceeds the depth of @a context, or is
+/// inconsistent with the active nodes, the common ancestor is determined by
+/// walking up the tree from @a context (or the assumed ancestor) until the
+/// node matches the active node at the same depth, i.e., both paths meet.
+/// Thus, the costs are proportional to the number of events generated, and
+/// consecutive samples in the same context do not create any events.
 ///
 /// @param data
 ///     OTF2 event callback data
 /// @param time
 ///     Timestamp to use for generated events
 /// @param context
-///     Current calling context
+///     Current calling context (`nullptr` to leave all active contexts)
 /// @param distance
 ///     Number of nodes in the calling context tree that have been left since
 ///     the previous sample
 ///
 void
-processContext(const Otf2EvtCbData* const data,
-               const timestamp_t          time,
-               CallingContext* const      context,
-               const uint32_t             distance)
+processContext(Otf2EvtCbData* const  data,
+               const timestamp_t     time,
+               CallingContext* const context,
+               const uint32_t        distance)
 {
-    if (distance == 1) {
-        CallingContext* current = data->mPreviousContext;
-        CallingContext* unwind  = context;
-        if (unwind) {
-            unwind = unwind->getParent();
+    vector<CallingContext*>& stack = data->mContextStack;
+    vector<CallingContext*>& path  = data->mContextPath;
+
+    // Collect nodes newly visited according to the unwind distance; without
+    // a usable distance, start at the context itself
+    uint32_t        level = 0;
+    CallingContext* node  = context;
+    path.clear();
+    if (context) {
+        level = getContextDepth(data, context);
+
+        const uint32_t shared = ((distance > 0) && (distance <= level))
+                                ? level - distance + 1
+                                : level;
+        while (level > shared) {
+            path.push_back(node);
+            node = node->getParent();
+            --level;
         }
-        while (current != unwind) {
-            CallingContext* parent = current->getParent();
-            if (context && (parent == unwind)) {
-                break;
-            }
+    }
 
-            const Region& region = current->getRegion();
-            Event_rep*    event  =
-                EventFactory::instance()->createLeave(data->mDefinitions,
-                                                      time,
-                                                      region.getId(),
-                                                      NULL);
-            if (event) {
-                data->mTrace.add_event(event);
-            }
+    // Verify common ancestor; continue walking up until the paths meet
+    while ((level > 0) && ((level > stack.size()) || (stack[level - 1] != node))) {
+        path.push_back(node);
+        node = node->getParent();
+        --level;
+    }
 
-            current = parent;
+    // Leave nodes below the common ancestor
+    while (stack.size() > level) {
+        Event_rep* event =
+            EventFactory::instance()->createLeave(data->mDefinitions,
+                                                  time,
+                                                  stack.back()->getRegion().getId(),
+                                                  NULL);
+        if (event) {
+            data->mTrace.add_event(event);
         }
-
-        return;
+        stack.pop_back();
     }
 
-    processContext(data, time, context->getParent(), distance - 1);
-
-    Event_rep* event =
-        EventFactory::instance()->createEnter(data->mDefinitions,
-                                              time,
-                                              context->getRegion().getId(),
-                                              NULL);
-    if (event) {
-        data->mTrace.add_event(event);
+    // Enter newly visited nodes
+    while (!path.empty()) {
+        Event_rep* event =
+            EventFactory::instance()->createEnter(data->mDefinitions,
+                                                  time,
+                                                  path.back()->getRegion().getId(),
+                                                  NULL);
+        if (event) {
+            data->mTrace.add_event(event);
+        }
+        stack.push_back(path.back());
+        path.pop_back();
     }
 }
 }   // unnamed namespace
@@ -31,10 +31,14 @@
 
 
 #include <string>
+#include <vector>
 
 #include <otf2/OTF2_AttributeList.h>
 #include <otf2/OTF2_Events.h>
 
+#include "Otf2DefCallbacks.h"
+#include "RequestTable.h"
+
 
 namespace pearl
 {
@@ -77,16 +81,23 @@ struct Otf2EvtCbData
     ///     Timer resolution in ticks per second
     /// @param globalOffset
     ///     Estimated timestamp of the first event
+    /// @param metricClasses
+    ///     Members of the synchronous OTF2 metric classes
     ///
-    Otf2EvtCbData(const GlobalDefs& defs,
-                  LocalTrace&       trace,
-                  uint64_t          timerResolution,
-                  uint64_t          globalOffset)
+    Otf2EvtCbData(const GlobalDefs&         defs,
+                  LocalTrace&               trace,
+                  uint64_t                  timerResolution,
+                  uint64_t                  globalOffset,
+                  const Otf2MetricClassMap& metricClasses)
         : mDefinitions(defs),
           mTrace(trace),
           mTimerResolution(timerResolution),
           mGlobalOffset(globalOffset),
-          mPreviousContext(0)
+          mMetricClasses(metricClasses),
+          mMetricTime(0),
+          mMetricsPending(false),
+          mCounterEventTime(0),
+          mCounterEventPending(false)
     {
     }
 
@@ -116,8 +127,43 @@ struct Otf2EvtCbData
     /// Estimated timestamp of the first event
     uint64_t mGlobalOffset;
 
-    /// Calling context of a previous sample event
-    CallingContext* mPreviousContext;
+    /// Calling context nodes currently active due to previous calling
+    /// context events, ordered from the root node to the most recent
+    /// context (i.e., indexed by depth - 1)
+    std::vector<CallingContext*> mContextStack;
+
+    /// Cached depths of the calling context nodes (root nodes have depth 1,
+    /// zero denotes unknown entries), indexed by calling context ID
+    std::vector<uint32_t> mContextDepths;
+
+    /// Scratch buffer for the calling context nodes entered by a calling
+    /// context event (avoids reallocation on every sample)
+    std::vector<CallingContext*> mContextPath;
+
+    /// Pending non-blocking communication requests
+    RequestTable mRequests;
+
+    /// Members of the synchronous OTF2 metric classes
+    const Otf2MetricClassMap& mMetricClasses;
+
+    /// Most recent values of all metrics (empty until the first Metric
+    /// event has been read)
+    std::vector<uint64_t> mMetricValues;
+
+    /// Timestamp of the most recent Metric event (in ticks)
+    uint64_t mMetricTime;
+
+    /// Whether the metric values still need to be attached to an event
+    bool mMetricsPending;
+
+    /// Most recent Enter/Leave event without metric values
+    Event mCounterEvent;
+
+    /// Timestamp of the most recent Enter/Leave event (in ticks)
+    uint64_t mCounterEventTime;
+
+    /// Whether metric values may still be attached to mCounterEvent
+    bool mCounterEventPending;
 };
 
 
@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <functional>
 #include <iostream>
 
 #include <pearl/Error.h>
@@ -35,6 +36,60 @@ using namespace pearl;
 static unsigned char GROUP_FLAG_SELF  = 1;
 static unsigned char GROUP_FLAG_WORLD = 2;
 
+static const unsigned char LAYOUT_STRIDED   = 0;
+static const unsigned char LAYOUT_BITMAP    = 1;
+static const unsigned char LAYOUT_SORTED    = 2;
+static const unsigned char LAYOUT_UNORDERED = 3;
+
+
+//--- Local helper functions ------------------------------------------------
+
+namespace
+{
+/// Returns the number of bits set in @a value.
+inline uint32_t
+countBits(uint64_t value)
+{
+    value = value - ((value >> 1) & 0x5555555555555555ULL);
+    value = (value & 0x3333333333333333ULL)
+            + ((value >> 2) & 0x3333333333333333ULL);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+
+    return (value * 0x0101010101010101ULL) >> 56;
+}
+
+
+/// Comparison functor ordering local ranks by their global process
+/// identifiers.
+class GlobalRankLess
+{
+    public:
+        explicit
+        GlobalRankLess(const int* ranks)
+            : mRanks(ranks)
+        {
+        }
+
+        bool
+        operator()(const uint32_t lhs,
+                   const uint32_t rhs) const
+        {
+            return (mRanks[lhs] < mRanks[rhs]);
+        }
+
+        bool
+        operator()(const uint32_t lhs,
+                   const int      rhs) const
+        {
+            return (mRanks[lhs] < rhs);
+        }
+
+
+    private:
+        const int* mRanks;
+};
+}   // unnamed namespace
+
 
 /*-------------------------------------------------------------------------*/
 /**
@@ -58,6 +113,11 @@ ProcessGroup::ProcessGroup(const IdType         id,
     : mIdentifier(id),
       mName(name),
       mRanks(ranks),
+      mRankData(0),
+      mNumRanks(mRanks.size()),
+      mFirst(0),
+      mStride(1),
+      mLayout(LAYOUT_STRIDED),
       mFlags(0)
 {
     assert(!ranks.empty()
@@ -70,6 +130,8 @@ ProcessGroup::ProcessGroup(const IdType         id,
     if (isWorld) {
         mFlags |= GROUP_FLAG_WORLD;
     }
+
+    initLayout();
 }
 
 
@@ -97,46 +159,78 @@ ProcessGroup::getName() const
 uint32_t
 ProcessGroup::numRanks() const
 {
-    return mRanks.size();
+    return mNumRanks;
 }
 
 
 int
 ProcessGroup::getLocalRank(const int globalRank) const
 {
-    // Special case: for WORLD groups, there is a 1:1 rank mapping
-    if (isWorld()) {
-        if (static_cast<size_t>(globalRank) >= mRanks.size()) {
-            throw RuntimeError("ProcessGroup::getLocalRank(int)"
-                               " -- Unknown identifier.");
-        }
-        return globalRank;
+    switch (mLayout) {
+        case LAYOUT_STRIDED:
+            {
+                const int64_t offset = static_cast<int64_t>(globalRank) - mFirst;
+                if (0 == offset % mStride) {
+                    const int64_t localRank = offset / mStride;
+                    if ((localRank >= 0) && (localRank < mNumRanks)) {
+                        return localRank;
+                    }
+                }
+            }
+            break;
+
+        case LAYOUT_BITMAP:
+            if (globalRank >= mFirst) {
+                const uint32_t offset = globalRank - mFirst;
+                const uint32_t word   = offset / 64;
+                if (word < mBitmap.size()) {
+                    const uint64_t mask = static_cast<uint64_t>(1) << (offset % 64);
+                    if (mBitmap[word] & mask) {
+                        return mIndex[word] + countBits(mBitmap[word] & (mask - 1));
+                    }
+                }
+            }
+            break;
+
+        case LAYOUT_SORTED:
+            {
+                const int* const end = mRankData + mNumRanks;
+                const int* const it  = lower_bound(mRankData, end, globalRank);
+                if ((end != it) && (*it == globalRank)) {
+                    return it - mRankData;
+                }
+            }
+            break;
+
+        case LAYOUT_UNORDERED:
+            {
+                vector<uint32_t>::const_iterator it =
+                    lower_bound(mIndex.begin(), mIndex.end(), globalRank,
+                                GlobalRankLess(mRankData));
+                if ((mIndex.end() != it) && (mRankData[*it] == globalRank)) {
+                    return *it;
+                }
+            }
+            break;
     }
 
-    // Search process identifier. This has to be a linear search since members
-    // are not ordered by their global process IDs.
-    RankContainer::const_iterator it;
-    it = find(mRanks.begin(), mRanks.end(), globalRank);
-
     // Not found...
-    if (mRanks.end() == it) {
-        throw RuntimeError("ProcessGroup::getLocalRank(int)"
-                           " -- Unknown identifier.");
-    }
-
-    // Found => Return local rank
-    return it - mRanks.begin();
+    throw RuntimeError("ProcessGroup::getLocalRank(int)"
+                       " -- Unknown identifier.");
 }
 
 
 int
 ProcessGroup::getGlobalRank(const int localRank) const
 {
-    if (static_cast<size_t>(localRank) >= mRanks.size()) {
+    if (static_cast<uint32_t>(localRank) >= mNumRanks) {
         throw RuntimeError("ProcessGroup::getGlobalRank(int)"
                            " -- Rank out of range.");
     }
-    return mRanks[localRank];
+    if (LAYOUT_STRIDED == mLayout) {
+        return mFirst + localRank * mStride;
+    }
+    return mRankData[localRank];
 }
 
 
@@ -156,6 +250,80 @@ ProcessGroup::isWorld() const
 
 //--- Private methods -------------------------------------------------------
 
+/// @brief Select membership representation.
+///
+/// Determines the most compact representation of the group members which
+/// still allows for a fast rank translation, and sets up the corresponding
+/// data structures. For strided groups (including 'WORLD'), the explicit
+/// rank list is released.
+///
+void
+ProcessGroup::initLayout()
+{
+    // Strided groups: store first rank and stride only; 'WORLD' groups map
+    // global ranks 1:1, regardless of the rank list
+    bool isStrided = true;
+    if (!isWorld() && !mRanks.empty()) {
+        mFirst = mRanks[0];
+        if (mNumRanks > 1) {
+            const int64_t stride = static_cast<int64_t>(mRanks[1]) - mRanks[0];
+
+            isStrided = (0 != stride) && (static_cast<int>(stride) == stride);
+            for (uint32_t i = 2; isStrided && (i < mNumRanks); ++i) {
+                isStrided = (static_cast<int64_t>(mRanks[i]) - mRanks[i - 1] == stride);
+            }
+            mStride = stride;
+        }
+    }
+    if (isStrided) {
+        RankContainer().swap(mRanks);
+
+        return;
+    }
+
+    mStride   = 1;
+    mRankData = &mRanks[0];
+
+    // Unordered groups: index local ranks by global process identifiers
+    if (adjacent_find(mRanks.begin(), mRanks.end(),
+                      greater_equal<int>()) != mRanks.end()) {
+        mLayout = LAYOUT_UNORDERED;
+        mIndex.resize(mNumRanks);
+        for (uint32_t i = 0; i < mNumRanks; ++i) {
+            mIndex[i] = i;
+        }
+        sort(mIndex.begin(), mIndex.end(), GlobalRankLess(mRankData));
+
+        return;
+    }
+
+    // Ascending groups: use a bitmap if it requires at most one word per
+    // member, otherwise search the rank list
+    mFirst = mRanks.front();
+
+    const uint64_t numWords = (static_cast<int64_t>(mRanks.back()) - mFirst) / 64 + 1;
+    if (numWords > mNumRanks) {
+        mLayout = LAYOUT_SORTED;
+
+        return;
+    }
+
+    mLayout = LAYOUT_BITMAP;
+    mBitmap.resize(numWords, 0);
+    for (uint32_t i = 0; i < mNumRanks; ++i) {
+        const uint32_t offset = mRanks[i] - mFirst;
+        mBitmap[offset / 64] |= static_cast<uint64_t>(1) << (offset % 64);
+    }
+    mIndex.resize(numWords);
+    uint32_t count = 0;
+    for (uint64_t word = 0; word < numWords; ++word) {
+        mIndex[word] = count;
+        count       += countBits(mBitmap[word]);
+    }
+}
+
+
+
 /// @brief Stream output helper function.
 ///
 /// Prints the instance data to the given @a stream in a human-readable form.
@@ -0,0 +1,155 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+#include <pearl/ReductionBundle.h>
+
+#include <cassert>
+
+#include "Threading.h"
+#include "pearl_ipc.h"
+
+using namespace std;
+using namespace pearl;
+using namespace pearl::detail;
+
+
+//--- Constructors & destructor ---------------------------------------------
+
+ReductionBundle::ReductionBundle()
+    : mNumReduced(0)
+{
+}
+
+
+//--- Registering values ----------------------------------------------------
+
+uint32_t
+ReductionBundle::add(const Operation op,
+                     const double    value,
+                     const uint64_t  location)
+{
+    mValues.push_back(value);
+    mLocations.push_back(location);
+    mOperations.push_back(op);
+
+    return (mValues.size() - 1);
+}
+
+
+void
+ReductionBundle::clear()
+{
+    mValues.clear();
+    mLocations.clear();
+    mOperations.clear();
+    mNumReduced = 0;
+}
+
+
+uint32_t
+ReductionBundle::size() const
+{
+    return mValues.size();
+}
+
+
+//--- Reduction -------------------------------------------------------------
+
+void
+ReductionBundle::flush()
+{
+    // Bundles of all threads in the team, indexed by thread number
+    static vector<ReductionBundle*> teamBundles;
+
+    // All threads/processes register the same values => consistent decision
+    if (mNumReduced == mValues.size()) {
+        return;
+    }
+
+    const int threadId   = PEARL_GetThreadNumber();
+    const int numThreads = PEARL_GetNumThreads();
+
+    if (threadId == 0) {
+        teamBundles.assign(numThreads, NULL);
+    }
+    PEARL_Barrier();
+    teamBundles[threadId] = this;
+    PEARL_Barrier();
+
+    // Combine thread contributions in thread order (to ensure deterministic
+    // results) and reduce across processes using a single collective
+    const uint32_t first = mNumReduced;
+    const uint32_t count = mValues.size() - first;
+    if (threadId == 0) {
+        vector<IpcReduceItem> items(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            items[i].mValue     = mValues[first + i];
+            items[i].mLocation  = mLocations[first + i];
+            // Enumerators of Operation and IpcOperation match
+            items[i].mOperation = static_cast<uint32_t>(mOperations[first + i]);
+        }
+
+        vector<IpcReduceItem> contrib(count);
+        for (int thread = 1; thread < numThreads; ++thread) {
+            const ReductionBundle* bundle = teamBundles[thread];
+            assert(bundle->mValues.size() == mValues.size());
+            assert(bundle->mNumReduced == first);
+
+            for (uint32_t i = 0; i < count; ++i) {
+                assert(bundle->mOperations[first + i] == mOperations[first + i]);
+                contrib[i]           = items[i];
+                contrib[i].mValue    = bundle->mValues[first + i];
+                contrib[i].mLocation = bundle->mLocations[first + i];
+            }
+            ipcCombineItems(&contrib[0], &items[0], count);
+        }
+        ipcAllreduce(&items[0], count);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            mValues[first + i]    = items[i].mValue;
+            mLocations[first + i] = items[i].mLocation;
+        }
+    }
+    PEARL_Barrier();
+
+    // Distribute results to other threads
+    if (threadId != 0) {
+        const ReductionBundle* master = teamBundles[0];
+        for (uint32_t i = first; i < mValues.size(); ++i) {
+            mValues[i]    = master->mValues[i];
+            mLocations[i] = master->mLocations[i];
+        }
+    }
+    mNumReduced = mValues.size();
+    PEARL_Barrier();
+}
+
+
+//--- Query results ---------------------------------------------------------
+
+double
+ReductionBundle::getValue(const uint32_t handle) const
+{
+    assert(handle < mValues.size());
+
+    return mValues[handle];
+}
+
+
+uint64_t
+ReductionBundle::getLocation(const uint32_t handle) const
+{
+    assert(handle < mLocations.size());
+
+    return mLocations[handle];
+}
@@ -0,0 +1,81 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file
+ *  @ingroup PEARL_base
+ *  @brief   Implementation of the class RequestTable.
+ *
+ *  This file provides the implementation of the class RequestTable and
+ *  related functions.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+#include <config.h>
+#include "RequestTable.h"
+
+#include <pearl/Event_rep.h>
+#include <pearl/LocalTrace.h>
+
+using namespace std;
+using namespace pearl;
+using namespace pearl::detail;
+
+
+//--- Linking request events ------------------------------------------------
+
+void
+RequestTable::link(const Event& event)
+{
+    link(*event, event.get_id());
+}
+
+
+void
+RequestTable::link(Event_rep&     event,
+                   const uint32_t position)
+{
+    if (!event.isOfType(GROUP_NONBLOCK))
+        return;
+
+    // Precompute next/previous request offset
+    const uint64_t requestId = event.getRequestId();
+
+    RequestContainer::iterator it = mRequests.find(requestId);
+    if (it != mRequests.end()) {
+        const uint32_t offset = position - it->second.first;
+
+        it->second.second->set_next_reqoffs(offset);
+        event.set_prev_reqoffs(offset);
+
+        if (event.isOfType(MPI_REQUEST_TESTED))
+            it->second = RequestEntry(position, &event);
+        else
+            mRequests.erase(it);
+    } else {
+        mRequests.insert(make_pair(requestId, RequestEntry(position, &event)));
+    }
+}
+
+
+//--- Related functions -----------------------------------------------------
+
+void
+pearl::detail::linkRequests(const LocalTrace& trace)
+{
+    RequestTable requests;
+
+    for (Event event = trace.begin(); event != trace.end(); ++event)
+        requests.link(event);
+}
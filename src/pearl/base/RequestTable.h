@@ -0,0 +1,134 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file
+ *  @ingroup PEARL_base
+ *  @brief   Declaration of the class RequestTable.
+ *
+ *  This header file provides the declaration of the class RequestTable.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+#ifndef PEARL_REQUESTTABLE_H
+#define PEARL_REQUESTTABLE_H
+
+
+#include <stdint.h>
+
+#include <map>
+#include <utility>
+
+#include <pearl/Event.h>
+
+
+namespace pearl
+{
+//--- Forward declarations --------------------------------------------------
+
+class Event_rep;
+class LocalTrace;
+
+
+namespace detail
+{
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class   RequestTable
+ *  @ingroup PEARL_base
+ *  @brief   Table of pending non-blocking communication requests.
+ *
+ *  The RequestTable class keeps track of the most recent event of each
+ *  active non-blocking communication request of a local trace. It is used
+ *  to link subsequent events referring to the same request by means of
+ *  their next/previous request offsets. As this only depends on the event
+ *  order, the linking is performed by the trace readers while the events
+ *  are created, avoiding a separate pass over the trace data.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class RequestTable
+{
+    public:
+        //--- Public methods -------------------------------
+
+        /// @name Linking request events
+        /// @{
+
+        /// @brief Link a request event.
+        ///
+        /// Links the given @a event with the previous event referring to the
+        /// same request (if any) and updates the table accordingly.  Events
+        /// not related to non-blocking communication requests are ignored.
+        ///
+        /// @param event
+        ///     Event to be linked
+        ///
+        void
+        link(const Event& event);
+
+        /// @brief Link a request event at a given trace position.
+        ///
+        /// Links the given @a event, located at @a position in the local
+        /// trace, with the previous event referring to the same request (if
+        /// any) and updates the table accordingly.  Events not related to
+        /// non-blocking communication requests are ignored.
+        ///
+        /// @param event
+        ///     Event representation to be linked
+        /// @param position
+        ///     Position of the event in the local trace
+        ///
+        void
+        link(Event_rep& event,
+             uint32_t   position);
+
+        /// @}
+
+
+    private:
+        //--- Type definitions -----------------------------
+
+        /// Most recent event of a pending request and its trace position
+        typedef std::pair<uint32_t, Event_rep*> RequestEntry;
+
+        /// Container type for pending requests
+        typedef std::map<uint64_t, RequestEntry> RequestContainer;
+
+
+        //--- Data members ---------------------------------
+
+        /// Pending requests: request ID |-@> most recent event
+        RequestContainer mRequests;
+};
+
+
+//--- Related functions -----------------------------------------------------
+
+/// @brief Link all request events of a trace.
+///
+/// (Re-)links all events related to non-blocking communication requests of
+/// the given @a trace. This is only necessary if the event order has been
+/// changed after reading the trace data.
+///
+/// @param trace
+///     Local trace data object
+///
+void
+linkRequests(const LocalTrace& trace);
+}   // namespace detail
+}   // namespace pearl
+
+
+#endif   // !PEARL_REQUESTTABLE_H
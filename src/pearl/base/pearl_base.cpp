@@ -17,8 +17,10 @@
 #include <config.h>
 #include <pearl/pearl.h>
 
+#include <algorithm>
 #include <cfloat>
 #include <map>
+#include <vector>
 
 #include <pearl/Callpath.h>
 #include <pearl/Callsite.h>
@@ -32,11 +34,14 @@
 #include <pearl/GlobalDefs.h>
 #include <pearl/Leave_rep.h>
 #include <pearl/LocalTrace.h>
+#include <pearl/MetricTable.h>
+#include <pearl/ProcessGroup.h>
 #include <pearl/Region.h>
 
 #include "Calltree.h"
 #include "DefsFactory.h"
 #include "EventFactory.h"
+#include "RequestTable.h"
 #include "Threading.h"
 #include "pearl_ipc.h"
 #include "pearl_memory.h"
@@ -54,6 +59,8 @@ namespace {
 
     // *INDENT-OFF*
     void determineTimeOffset(GlobalDefs& defs, const LocalTrace& trace);
+    void getUnflushedPositions(const GlobalDefs& defs, const LocalTrace& trace,
+                               vector<uint32_t>& positions);
     Callpath* mapCallpath(Calltree* calltree, const Callpath* callpath);
     // *INDENT-ON*
 }   // unnamed namespace
@@ -111,6 +118,65 @@ void pearl::PEARL_finalize()
 }
 
 
+//--- Definition sharing ----------------------------------------------------
+
+/**
+ *  Moves the member lists of all process groups provided by the global
+ *  definitions object @a defs into a memory segment shared by all processes
+ *  running on the same compute node. As the global definitions are identical
+ *  on all processes, the lists are stored only once per node in a single
+ *  array, written by one process and referenced by offset from all others,
+ *  instead of being kept as a private copy by each process. The segment is
+ *  released by PEARL_finalize(), i.e., @a defs must not be accessed after
+ *  PEARL has been finalized. Without node-level shared memory support, the
+ *  lists are merely compacted into a private array.
+ *
+ *  @note This function is a collective operation and has to be called by
+ *        all processes after the definitions have been read successfully.
+ *        In the case of a hybrid OpenMP/MPI program, make sure to call this
+ *        function <b>only from the master thread.</b>
+ *
+ *  @param defs Global definitions object
+ **/
+void pearl::PEARL_share_defs(GlobalDefs& defs)
+{
+  // Determine offsets of the member lists in the shared array
+  const GlobalDefs::pgroup_container& groups = defs.mProcessGroups;
+  vector<size_t> offsets;
+  offsets.reserve(groups.size() + 1);
+  offsets.push_back(0);
+  for (GlobalDefs::pgroup_container::const_iterator it = groups.begin();
+       it != groups.end();
+       ++it)
+    offsets.push_back(offsets.back() + ((*it)->mRankData ? (*it)->mNumRanks : 0));
+
+  bool       initialize;
+  int* const ranks = static_cast<int*>(ipcAllocShared(offsets.back() * sizeof(int),
+                                                      initialize));
+  if (!ranks)
+    return;
+
+  if (initialize) {
+    for (size_t index = 0; index < groups.size(); ++index)
+      if (groups[index]->mRankData)
+        copy(groups[index]->mRankData,
+             groups[index]->mRankData + groups[index]->mNumRanks,
+             ranks + offsets[index]);
+  }
+  ipcSyncShared(ranks);
+
+  // Release private member lists; strided groups do not store any
+  for (size_t index = 0; index < groups.size(); ++index) {
+    ProcessGroup* group = groups[index];
+    if (!group->mRankData)
+      continue;
+
+    ProcessGroup::RankContainer().swap(group->mRanks);
+    group->mRankData = ranks + offsets[index];
+  }
+}
+
+
 //--- Call tree verification ------------------------------------------------
 
 /**
@@ -131,9 +197,16 @@ void pearl::PEARL_verify_calltree(GlobalDefs& defs, LocalTrace& trace)
   // Determine process-local timestamp offset
   determineTimeOffset(defs, trace);
 
+  // Hardware counter values are associated with event positions, thus
+  // remember the positions of all events that may carry them
+  vector<uint32_t> metricPositions;
+  if (trace.getMetricTable())
+    getUnflushedPositions(defs, trace, metricPositions);
+
   // Rectify event order of buffer flush events
   LocalTrace::reverse_iterator rEvent = trace.rbegin();
-  bool isFlush = false;
+  bool isFlush     = false;
+  bool isReordered = false;
   while (rEvent != trace.rend()) {
     if (rEvent->getType() == ENTER) {
       Enter_rep&    enterRep = static_cast<Enter_rep&>(*rEvent);
@@ -159,12 +232,25 @@ void pearl::PEARL_verify_calltree(GlobalDefs& defs, LocalTrace& trace)
         trace.swap(current, next);
         ++current;
         ++next;
+        isReordered = true;
       }
       isFlush = false;
     }
     ++rEvent;
   }
 
+  // Request offsets and counter value positions determined while reading
+  // the trace data are invalidated by reordering the events
+  if (isReordered) {
+    linkRequests(trace);
+
+    if (trace.getMetricTable()) {
+      vector<uint32_t> newPositions;
+      getUnflushedPositions(defs, trace, newPositions);
+      trace.getMetricTable()->remap(metricPositions, newPositions);
+    }
+  }
+
   // These variables are shared!
   // Used to provide fork cnode on master thread to worker threads
   static Callpath* fork_cnode = NULL;
@@ -181,7 +267,10 @@ void pearl::PEARL_verify_calltree(GlobalDefs& defs, LocalTrace& trace)
   int       status   = BALANCED;
 
   // Tasking related
-  uint64_t    currentTaskId       = trace.get_location().getId();
+  // (the implicit task is identified consistently with the task switch
+  // events, i.e., creating thread and generation number 0)
+  const uint64_t implicitTaskId   = static_cast<uint64_t>(threadId) << 32;
+  uint64_t    currentTaskId       = implicitTaskId;
   uint64_t    previousTaskId      = 0;
   std::map < uint64_t,Callpath* > activeTasks;
   Callpath*   lastStubNodeParent  = NULL;
@@ -329,7 +418,8 @@ void pearl::PEARL_verify_calltree(GlobalDefs& defs, LocalTrace& trace)
        // store current callpath progress
        activeTasks[previousTaskId] = current;
 
-       if (activeTasks.count(currentTaskId) == 0)
+       std::map<uint64_t,Callpath*>::iterator it = activeTasks.find(currentTaskId);
+       if (it == activeTasks.end())
        {
          // get the region for the stubnode from the following task
          // advancing in the trace until the required event is found
@@ -352,7 +442,7 @@ void pearl::PEARL_verify_calltree(GlobalDefs& defs, LocalTrace& trace)
          const Region& nextTaskRegion = enter.getRegionEntered();
 
          // if on the implicit task - create the task node      
-         if (previousTaskId == trace.get_location().getId())
+         if (previousTaskId == implicitTaskId)
          {
             lastStubNodeParent = current;
          }
@@ -367,14 +457,14 @@ void pearl::PEARL_verify_calltree(GlobalDefs& defs, LocalTrace& trace)
        }
        else
          // continue the callpath stored for this taskId      
-         current = activeTasks[currentTaskId];
+         current = it->second;
     }
 
     // THREAD_TASK_COMPLETE:
     else if (event->isOfType(THREAD_TASK_COMPLETE))
     {
       // fall back to the implicit task 
-      currentTaskId = trace.get_location().getId(); //until the next task switch
+      currentTaskId = implicitTaskId; //until the next task switch
       current = activeTasks[currentTaskId];
 
       // task complete remove data to minimize resources
@@ -440,6 +530,14 @@ void pearl::PEARL_verify_calltree(GlobalDefs& defs, LocalTrace& trace)
  *  last step in setting up the data structures, i.e., after calling
  *  PEARL_verify_calltree() and PEARL_mpi_unify_calltree().
  *
+ *  Note that the next/previous request offsets of non-blocking communication
+ *  events are already determined while reading the trace data, as they only
+ *  depend on the event order.
+ *
+ *  In addition, the navigation index of the @a trace is built, providing
+ *  constant-time access to matching ENTER/LEAVE and BEGIN/END events (see
+ *  LocalTrace::buildNavigationIndex()).
+ *
  *  @param defs  Global definitions object
  *  @param trace Local trace data object
  *
@@ -463,10 +561,11 @@ void pearl::PEARL_preprocess_trace(const GlobalDefs& defs,
   Event       event   = trace.begin();
 
   // Tasking related
-  uint64_t    currentTaskId       = trace.get_location().getId();
+  const uint64_t implicitTaskId   =
+    static_cast<uint64_t>(PEARL_GetThreadNumber()) << 32;
+  uint64_t    currentTaskId       = implicitTaskId;
   uint64_t    previousTaskId      = 0;
   std::map <uint64_t, Callpath*> activeTasks;
-  std::map <uint64_t, Event>     requestMap;
 
   while (event != trace.end()) {
     // Perform global time offset shift
@@ -541,7 +640,8 @@ void pearl::PEARL_preprocess_trace(const GlobalDefs& defs,
        activeTasks[previousTaskId] = current;
 
        // unvisited task
-       if (activeTasks.count(currentTaskId) == 0) {
+       std::map<uint64_t, Callpath*>::iterator it = activeTasks.find(currentTaskId);
+       if (it == activeTasks.end()) {
          // store task_root node as parent for this task
          current = ctree->getCallpath(defs.getTaskRootRegion(),
                                       Callsite::UNDEFINED,
@@ -549,44 +649,113 @@ void pearl::PEARL_preprocess_trace(const GlobalDefs& defs,
        }
        else
          // continue the callpath stored for this taskId      
-         current = activeTasks[currentTaskId];
+         current = it->second;
     }
     else if (event->isOfType(THREAD_TASK_COMPLETE))
     {
       // fall back to the implicit task 
-      currentTaskId = trace.get_location().getId(); //until the next task switch
+      currentTaskId = implicitTaskId; //until the next task switch
       current = activeTasks[currentTaskId];
 
       //task complete remove data to minimize resources
       ThreadTaskComplete_rep& taskComplete = event_cast<ThreadTaskComplete_rep>(*event);
       activeTasks.erase(taskComplete.getTaskId());
     }
-    else if (event->isOfType(GROUP_NONBLOCK))
-    {
-      // Precompute next/previous request offset
-      uint64_t requestId = event->getRequestId();
-
-      std::map<uint64_t, Event>::iterator rmapit = requestMap.find(requestId);
-      if (rmapit != requestMap.end()) {
-        rmapit->second->set_next_reqoffs(event.get_id() - rmapit->second.get_id());
-        event         ->set_prev_reqoffs(event.get_id() - rmapit->second.get_id());
-
-        if (event->isOfType(MPI_REQUEST_TESTED))
-          rmapit->second = event;
-        else
-          requestMap.erase(rmapit);
-      } else {
-        requestMap.insert(std::make_pair(requestId, event));
-      }
-    }
     ++event;
   }
 
+  // Precompute matching ENTER/LEAVE and BEGIN/END events
+  trace.buildNavigationIndex();
+
   // Synchronize threads
   PEARL_Barrier();
 }
 
 
+//--- Trace restriction -----------------------------------------------------
+
+/**
+ *  Restricts the given @a trace to the events flagged in @a retained, which
+ *  provides one entry per event in trace order. All other events are
+ *  removed from the trace and released. The timestamps of the remaining
+ *  events are clamped to the interval [@a begin, @a end], i.e., regions
+ *  entered before or left after this interval are truncated accordingly.
+ *  The selection of events is left to the caller; however, it has to
+ *  retain matching ENTER/LEAVE and BEGIN/END pairs as well as complete
+ *  request chains of non-blocking communication events.
+ *
+ *  Afterwards, the event counters, the next/previous request offsets, the
+ *  hardware counter table, and the navigation index are updated. Counter
+ *  values are only kept for events whose timestamps did not have to be
+ *  clamped, as the recorded values do not apply to the modified timestamps.
+ *
+ *  @param defs      Global definitions object
+ *  @param trace     Local trace data object
+ *  @param begin     Begin of the retained time interval
+ *  @param end       End of the retained time interval
+ *  @param retained  Flags denoting the events to be retained
+ *
+ *  @see PEARL_preprocess_trace()
+ **/
+void pearl::PEARL_restrict_trace(const GlobalDefs&     defs,
+                                 LocalTrace&           trace,
+                                 timestamp_t           begin,
+                                 timestamp_t           end,
+                                 const vector<bool>&   retained)
+{
+  const uint32_t   numEvents = trace.m_events.size();
+  MetricTable*     metrics   = (defs.num_metrics() > 0)
+                               ? trace.getMetricTable()
+                               : NULL;
+  vector<uint32_t> oldPositions;
+  vector<uint32_t> newPositions;
+
+  trace.releaseNavigationIndex();
+  trace.m_omp_parallel = 0;
+  trace.m_mpi_regions  = 0;
+
+  uint32_t count = 0;
+  for (uint32_t index = 0; index < numEvents; ++index) {
+    Event_rep* event = trace.m_events[index];
+    if (!retained[index]) {
+      delete event;
+      continue;
+    }
+
+    // Truncate regions and events overlapping the interval boundaries
+    const timestamp_t timestamp = event->getTimestamp();
+    if (timestamp < begin)
+      event->setTimestamp(begin);
+    else if (timestamp > end)
+      event->setTimestamp(end);
+    else if (metrics) {
+      oldPositions.push_back(index);
+      newPositions.push_back(count);
+    }
+
+    // Update event counters (see LocalTrace::add_event())
+    if (event->isOfType(GROUP_ENTER)) {
+      const Region& region = event->getRegion();
+
+      if (is_omp_parallel(region))
+        trace.m_omp_parallel++;
+      if (is_mpi_api(region))
+        trace.m_mpi_regions++;
+    }
+
+    trace.m_events[count++] = event;
+  }
+  trace.m_events.resize(count);
+
+  if (metrics)
+    metrics->remap(oldPositions, newPositions);
+
+  // Request offsets and navigation index depend on the event positions
+  linkRequests(trace);
+  trace.buildNavigationIndex();
+}
+
+
 //--- Local helper functions ------------------------------------------------
 
 namespace
@@ -624,6 +793,40 @@ determineTimeOffset(GlobalDefs& defs, const LocalTrace& trace)
 }
 
 
+/// @brief Determine positions of all non-flush events
+///
+/// Collects the positions of all events in the local @a trace which are not
+/// related to buffer flushes in ascending order.  As buffer flush events are
+/// only moved relative to other events, the relative order of the events
+/// listed is not affected by PEARL_verify_calltree().
+///
+/// @param defs
+///     Global definitions object
+/// @param trace
+///     Local trace data object
+/// @param positions
+///     Event positions (output parameter)
+///
+void
+getUnflushedPositions(const GlobalDefs& defs,
+                      const LocalTrace& trace,
+                      vector<uint32_t>& positions)
+{
+    const Region& flushing = defs.getFlushingRegion();
+
+    positions.clear();
+    positions.reserve(trace.size());
+    for (Event event = trace.begin(); event != trace.end(); ++event) {
+        const event_t type = event->getType();
+        if (((type == ENTER) || (type == LEAVE))
+            && (event->getRegion() == flushing))
+            continue;
+
+        positions.push_back(event.get_id());
+    }
+}
+
+
 /// @brief Determine the corresponding call path object in another call tree
 ///
 /// Determines the call path object in @a calltree which corresponds to the
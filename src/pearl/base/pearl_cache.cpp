@@ -0,0 +1,468 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+#include <pearl/pearl.h>
+
+#include <cerrno>
+#include <cstdio>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <pearl/Buffer.h>
+#include <pearl/Error.h>
+#include <pearl/Event.h>
+#include <pearl/Event_rep.h>
+#include <pearl/GlobalDefs.h>
+#include <pearl/LocalTrace.h>
+#include <pearl/Location.h>
+#include <pearl/MetricTable.h>
+
+#include "Calltree.h"
+#include "EventFactory.h"
+#include "Threading.h"
+
+using namespace std;
+using namespace pearl;
+
+
+//--- Local constants -------------------------------------------------------
+
+namespace
+{
+
+/// Magic number identifying preprocessed trace cache files ("PTC1")
+const uint32_t CACHE_MAGIC = 0x50544331;
+
+/// Cache file format version
+const uint32_t CACHE_VERSION = 2;
+
+/// Size limit of the write buffer before it is flushed to disk
+const size_t CACHE_CHUNK_SIZE = 1024 * 1024;
+
+}   // unnamed namespace
+
+
+//--- Local helper classes --------------------------------------------------
+
+namespace
+{
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class   CacheBuffer
+ *  @brief   Memory buffer with raw access to the serialized data.
+ *
+ *  The CacheBuffer class extends the generic Buffer class to allow flushing
+ *  the serialized data to a file descriptor in chunks, and to deserialize
+ *  data directly from a memory-mapped cache file without copying it. The
+ *  byte-order marker of the Buffer class is only written once at the very
+ *  beginning of the file.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class CacheBuffer
+    : public Buffer
+{
+    public:
+        CacheBuffer()
+            : Buffer(2 * CACHE_CHUNK_SIZE),
+              mStart(0)
+        {
+        }
+
+        // The mapped memory is released by the owner of the mapping
+        CacheBuffer(const void* data,
+                    size_t      size)
+            : Buffer(static_cast<const uint8_t*>(data), size),
+              mStart(0)
+        {
+        }
+
+        bool
+        flush(int  fd,
+              bool force)
+        {
+            if (!force && (m_size < CACHE_CHUNK_SIZE))
+                return true;
+
+            const uint8_t* data   = m_data + mStart;
+            size_t         nbytes = m_size - mStart;
+            while (nbytes > 0) {
+                ssize_t count = ::write(fd, data, nbytes);
+                if (count < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    return false;
+                }
+                data   += count;
+                nbytes -= count;
+            }
+
+            // Keep byte-order marker, but never write it again
+            m_size = 1;
+            mStart = 1;
+
+            return true;
+        }
+
+        size_t
+        remaining() const
+        {
+            return m_size - m_position;
+        }
+
+        void
+        skip(size_t nbytes)
+        {
+            m_position += nbytes;
+        }
+
+
+    private:
+        /// Offset of the first byte to be written on the next flush
+        size_t mStart;
+};
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class   CacheFile
+ *  @brief   Read-only memory mapping of a cache file.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class CacheFile
+{
+    public:
+        explicit
+        CacheFile(const string& filename)
+            : mData(MAP_FAILED),
+              mSize(0)
+        {
+            int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd < 0)
+                return;
+
+            struct stat info;
+            if ((fstat(fd, &info) == 0) && (info.st_size > 0)) {
+                mSize = info.st_size;
+                mData = mmap(NULL, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            ::close(fd);
+        }
+
+        ~CacheFile()
+        {
+            if (mData != MAP_FAILED)
+                munmap(mData, mSize);
+        }
+
+        bool
+        isMapped() const
+        {
+            return (mData != MAP_FAILED);
+        }
+
+        void*
+        getData() const
+        {
+            return mData;
+        }
+
+        size_t
+        getSize() const
+        {
+            return mSize;
+        }
+
+
+    private:
+        /// Start address of the mapping
+        void* mData;
+
+        /// Size of the mapping in bytes
+        size_t mSize;
+};
+
+
+/// @brief Cache file header
+///
+/// Header information stored at the beginning of each preprocessed trace
+/// cache file.
+///
+struct CacheHeader
+{
+    uint32_t    magic;
+    uint32_t    version;
+    uint64_t    stamp;
+    uint64_t    location;
+    timestamp_t offset;
+    uint32_t    numOmpParallel;
+    uint32_t    numMpiRegions;
+    uint32_t    numEvents;
+};
+
+
+// *INDENT-OFF*
+bool readHeader(CacheBuffer& buffer, CacheHeader& header);
+// *INDENT-ON*
+}   // unnamed namespace
+
+
+//--- Preprocessed trace cache ----------------------------------------------
+
+/**
+ *  Writes a compact binary image of the fully preprocessed @a trace data to
+ *  the file @a filename. Besides the process-local call tree stored in the
+ *  global definitions @a defs, the image holds the corrected timestamps and
+ *  the call path identifiers of all events, the request offsets of
+ *  non-blocking communication events, as well as the encoded hardware
+ *  counter values (if available). The opaque validation @a stamp is
+ *  stored in the header and has to match when reading the image. This
+ *  function has to be called after PEARL_preprocess_trace().
+ *
+ *  The image is first written to a temporary file which is then atomically
+ *  renamed, i.e., concurrent readers either see a complete image or none.
+ *
+ *  @param defs     Global definitions object
+ *  @param trace    Local trace data object
+ *  @param filename Name of the cache file
+ *  @param stamp    Validation stamp
+ *
+ *  @throw RuntimeError if the cache file cannot be written
+ *
+ *  @see PEARL_check_trace_cache(), PEARL_read_trace_cache()
+ **/
+void pearl::PEARL_write_trace_cache(const GlobalDefs& defs,
+                                    const LocalTrace& trace,
+                                    const string&     filename,
+                                    uint64_t          stamp)
+{
+  const string tmpname = filename + ".tmp";
+  int          fd      = ::open(tmpname.c_str(),
+                                O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+    throw RuntimeError("Cannot create trace cache file \"" + tmpname + "\".");
+
+  // Header & call tree
+  CacheBuffer buffer;
+  buffer.put_uint32(CACHE_MAGIC);
+  buffer.put_uint32(CACHE_VERSION);
+  buffer.put_uint64(stamp);
+  buffer.put_uint64(trace.get_location().getId());
+  buffer.putTimestamp(defs.getGlobalOffset());
+  buffer.put_uint32(trace.num_omp_parallel());
+  buffer.put_uint32(trace.num_mpi_regions());
+  buffer.put_uint32(trace.size());
+
+  // The call tree is prefixed by its size, which allows skipping it without
+  // unpacking
+  Buffer calltree;
+  defs.get_calltree()->pack(calltree);
+  buffer.put_uint64(calltree.size() - 1);
+  buffer.append(calltree);
+
+  // Event data
+  bool ok = true;
+  for (uint32_t index = 0; ok && index < trace.size(); ++index) {
+    const Event_rep* event = trace[index];
+
+    buffer.put_uint32(static_cast<uint32_t>(event->getType()));
+    event->pack(buffer);
+    if (event->isOfType(GROUP_NONBLOCK)) {
+      buffer.put_uint64(event->getRequestId());
+      buffer.put_uint32(event->get_prev_reqoffs());
+      buffer.put_uint32(event->get_next_reqoffs());
+    }
+
+    ok = buffer.flush(fd, false);
+  }
+
+  // Hardware counter values
+  const MetricTable* metrics = trace.getMetricTable();
+  buffer.put_uint8(metrics ? 1 : 0);
+  if (metrics)
+    metrics->pack(buffer);
+  ok = ok && buffer.flush(fd, true);
+  ok = (::close(fd) == 0) && ok;
+
+  if (!ok || (rename(tmpname.c_str(), filename.c_str()) != 0)) {
+    unlink(tmpname.c_str());
+    throw RuntimeError("Cannot write trace cache file \"" + filename + "\".");
+  }
+}
+
+
+/**
+ *  Checks whether the file @a filename holds a preprocessed trace image of
+ *  the given @a location which has been written with the validation
+ *  @a stamp. Only the header information is examined.
+ *
+ *  @param location Location whose trace data is requested
+ *  @param filename Name of the cache file
+ *  @param stamp    Validation stamp
+ *
+ *  @return True if the cache file can be used, false otherwise
+ *
+ *  @see PEARL_write_trace_cache(), PEARL_read_trace_cache()
+ **/
+bool pearl::PEARL_check_trace_cache(const Location& location,
+                                    const string&   filename,
+                                    uint64_t        stamp)
+{
+  CacheFile file(filename);
+  if (!file.isMapped())
+    return false;
+
+  CacheBuffer buffer(file.getData(), file.getSize());
+  CacheHeader header;
+
+  return (readHeader(buffer, header)
+          && (header.stamp == stamp)
+          && (header.location == location.getId()));
+}
+
+
+/**
+ *  Reads the preprocessed trace image of the given @a location from the
+ *  memory-mapped file @a filename and reconstructs the corresponding local
+ *  trace data object. As all locations of a process store the same call
+ *  tree, only the master thread of each process unpacks it and replaces
+ *  the call tree and the timestamp offset stored in the global definitions
+ *  object @a defs by the cached versions, while all other threads skip it
+ *  and wait until the shared call tree is available. The resulting trace
+ *  can be analyzed right away, i.e., neither PEARL_verify_calltree(),
+ *  PEARL_mpi_unify_calltree() nor PEARL_preprocess_trace() must be called.
+ *
+ *  This function has to be called by all threads of a process, and only
+ *  after the validity of the cache files has been agreed upon using
+ *  PEARL_check_trace_cache().
+ *
+ *  @param defs     Global definitions object
+ *  @param location Location whose trace data is requested
+ *  @param filename Name of the cache file
+ *
+ *  @return Local trace data object
+ *
+ *  @throw FatalError if the cache file is inconsistent
+ *
+ *  @see PEARL_write_trace_cache(), PEARL_check_trace_cache()
+ **/
+LocalTrace* pearl::PEARL_read_trace_cache(GlobalDefs&     defs,
+                                          const Location& location,
+                                          const string&   filename)
+{
+  CacheFile file(filename);
+  if (!file.isMapped())
+    throw FatalError("Cannot map trace cache file \"" + filename + "\".");
+
+  CacheBuffer buffer(file.getData(), file.getSize());
+  CacheHeader header;
+  if (!readHeader(buffer, header) || (header.location != location.getId()))
+    throw FatalError("Invalid trace cache file \"" + filename + "\".");
+
+  // All locations of a process store the same call tree, thus only the
+  // master thread needs to unpack and replace it
+  const uint64_t calltreeSize = buffer.get_uint64();
+  const bool     valid        = (calltreeSize <= buffer.remaining());
+  if (valid && (PEARL_GetThreadNumber() == 0)) {
+    defs.set_calltree(new Calltree(defs, buffer));
+    defs.setGlobalOffset(header.offset);
+  } else if (valid) {
+    buffer.skip(calltreeSize);
+  }
+  PEARL_Barrier();
+  if (!valid)
+    throw FatalError("Truncated trace cache file \"" + filename + "\".");
+
+  LocalTrace* trace = new LocalTrace(defs, location);
+  trace->m_events.reserve(header.numEvents);
+  trace->m_omp_parallel = header.numOmpParallel;
+  trace->m_mpi_regions  = header.numMpiRegions;
+
+  const EventFactory* factory = EventFactory::instance();
+  for (uint32_t index = 0; index < header.numEvents; ++index) {
+    if (buffer.remaining() < sizeof(uint32_t)) {
+      delete trace;
+      throw FatalError("Truncated trace cache file \"" + filename + "\".");
+    }
+
+    event_t    type  = static_cast<event_t>(buffer.get_uint32());
+    Event_rep* event = factory->createEvent(type, defs, buffer);
+    if (event->isOfType(GROUP_NONBLOCK)) {
+      event->setRequestId(buffer.get_uint64());
+      event->set_prev_reqoffs(buffer.get_uint32());
+      event->set_next_reqoffs(buffer.get_uint32());
+    }
+    trace->m_events.push_back(event);
+  }
+
+  if (buffer.remaining() < sizeof(uint8_t)) {
+    delete trace;
+    throw FatalError("Truncated trace cache file \"" + filename + "\".");
+  }
+  if (buffer.get_uint8())
+    trace->m_metrics = new MetricTable(buffer);
+
+  // The navigation index only depends on the event order, thus it is
+  // cheaper to rebuild it than to store it
+  trace->buildNavigationIndex();
+
+  return trace;
+}
+
+
+//--- Local helper functions ------------------------------------------------
+
+namespace
+{
+
+/// @brief Read and validate cache file header
+///
+/// Reads the header information from the cache file data stored in
+/// @a buffer into @a header and checks the file format.
+///
+/// @param buffer
+///     Buffer referencing the cache file data
+/// @param header
+///     Header information (output parameter)
+/// @returns
+///     True if the file format is supported, false otherwise
+///
+bool
+readHeader(CacheBuffer& buffer, CacheHeader& header)
+{
+    if (buffer.remaining() < (5 * sizeof(uint32_t)
+                              + 2 * sizeof(uint64_t)
+                              + sizeof(timestamp_t)))
+        return false;
+
+    header.magic = buffer.get_uint32();
+    if (header.magic != CACHE_MAGIC)
+        return false;
+
+    header.version        = buffer.get_uint32();
+    header.stamp          = buffer.get_uint64();
+    header.location       = buffer.get_uint64();
+    header.offset         = buffer.getTimestamp();
+    header.numOmpParallel = buffer.get_uint32();
+    header.numMpiRegions  = buffer.get_uint32();
+    header.numEvents      = buffer.get_uint32();
+
+    return (header.version == CACHE_VERSION);
+}
+
+}   // unnamed namespace
@@ -204,10 +204,12 @@ int main(int argc, char** argv)
     PEARL_verify_calltree(*defs, *trace);
 
     // Generate global call tree if per-process call trees were incomplete
+    // and create the MPI communicator handles
 #ifdef _MPI
     #pragma omp master
     {
       PEARL_mpi_unify_calltree(*defs);
+      PEARL_mpi_create_comms(*defs);
     }
     #pragma omp barrier
 #endif 
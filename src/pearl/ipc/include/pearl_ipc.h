@@ -32,6 +32,8 @@
 #define PEARL_IPC_H
 
 
+#include <cstddef>
+
 #include <stdint.h>
 
 
@@ -66,6 +68,38 @@ enum IpcDatatype
 };
 
 
+/// @brief Reduction operations used for inter-process communication.
+///
+/// The %IpcOperation enumeration defines the possible reduction operations
+/// of an IpcReduceItem. For PEARL_MINLOC and PEARL_MAXLOC, the location of
+/// the minimum/maximum value is determined as well; if multiple items have
+/// the same value, the lowest location is chosen.
+///
+enum IpcOperation
+{
+    PEARL_SUM,       ///< Sum
+    PEARL_MIN,       ///< Minimum
+    PEARL_MAX,       ///< Maximum
+    PEARL_MINLOC,    ///< Minimum and its location
+    PEARL_MAXLOC     ///< Maximum and its location
+};
+
+
+/// @brief Data item of a combined reduction.
+///
+/// The %IpcReduceItem struct stores a single scalar value to be reduced
+/// with ipcAllreduce(), together with its location and its reduction
+/// operation. As each item carries its own operation, values requiring
+/// different reduction operations can be reduced in a single call.
+///
+struct IpcReduceItem
+{
+    double   mValue;        ///< Value to be reduced
+    uint64_t mLocation;     ///< Location of the value (*LOC operations only)
+    uint32_t mOperation;    ///< Reduction operation (see IpcOperation)
+};
+
+
 //--- Function prototypes ---------------------------------------------------
 
 /// @name IPC layer: Environmental management
@@ -272,6 +306,136 @@ ipcScatterv(const void*     sendBuffer,
             IpcDatatype     datatype,
             uint32_t        root);
 
+/// @brief Combined reduction of scalar values.
+///
+/// Combines the @a count data items given in @a items element-wise across
+/// all processes according to their individual reduction operations, and
+/// stores the results in @a items on all processes. All processes have to
+/// provide the same @a count as well as the same sequence of operations.
+///
+/// @param items
+///     Pointer to send/receive buffer of @a count items
+/// @param count
+///     Number of data items
+///
+void
+ipcAllreduce(IpcReduceItem* items,
+             uint32_t       count);
+
+/// @}
+/// @name IPC layer: Node-level shared memory
+/// @{
+
+/// @brief Allocate a node-level shared memory segment.
+///
+/// Allocates a memory segment of @a size bytes which is shared by all
+/// processes running on the same compute node, if supported by the
+/// communication layer. Otherwise, each process gets a private segment. On
+/// return, @a initialize is set to @em true on exactly one process per
+/// segment, which is responsible for initializing its contents. The other
+/// processes must not access the segment before ipcSyncShared() has been
+/// called. This is a collective operation, i.e., all processes have to
+/// provide the same @a size. Segments not released by ipcFreeShared() are
+/// released by ipcFinalize().
+///
+/// @param size
+///     Size of the segment in bytes
+/// @param initialize
+///     Set to @em true if the calling process has to initialize the segment
+/// @returns
+///     Pointer to the segment (NULL if @a size is zero)
+///
+void*
+ipcAllocShared(size_t size,
+               bool&  initialize);
+
+/// @brief Synchronize a node-level shared memory segment.
+///
+/// Makes the contents of the shared memory @a segment written by the
+/// initializing process visible to all processes sharing the segment.
+/// This is a collective operation.
+///
+/// @param segment
+///     Pointer to the segment as returned by ipcAllocShared()
+///
+void
+ipcSyncShared(void* segment);
+
+/// @brief Release a node-level shared memory segment.
+///
+/// Releases the shared memory @a segment allocated by ipcAllocShared().
+/// This is a collective operation.
+///
+/// @param segment
+///     Pointer to the segment as returned by ipcAllocShared()
+///
+void
+ipcFreeShared(void* segment);
+
+/// @}
+/// @name IPC layer: Helper functions
+/// @{
+
+/// @brief Combine reduction items.
+///
+/// Combines the @a count data items given in @a in with the corresponding
+/// items given in @a inout according to their reduction operations, storing
+/// the results in @a inout.
+///
+/// @param in
+///     Pointer to input items
+/// @param inout
+///     Pointer to input/output items
+/// @param count
+///     Number of data items
+///
+inline void
+ipcCombineItems(const IpcReduceItem* in,
+                IpcReduceItem*       inout,
+                uint32_t             count)
+{
+    for (uint32_t i = 0; i < count; ++i) {
+        const IpcReduceItem& lhs = in[i];
+        IpcReduceItem&       rhs = inout[i];
+
+        switch (rhs.mOperation) {
+            case PEARL_SUM:
+                rhs.mValue += lhs.mValue;
+                break;
+
+            case PEARL_MIN:
+                if (lhs.mValue < rhs.mValue) {
+                    rhs.mValue = lhs.mValue;
+                }
+                break;
+
+            case PEARL_MAX:
+                if (lhs.mValue > rhs.mValue) {
+                    rhs.mValue = lhs.mValue;
+                }
+                break;
+
+            case PEARL_MINLOC:
+                if ((lhs.mValue < rhs.mValue)
+                    || ((lhs.mValue == rhs.mValue)
+                        && (lhs.mLocation < rhs.mLocation))) {
+                    rhs.mValue    = lhs.mValue;
+                    rhs.mLocation = lhs.mLocation;
+                }
+                break;
+
+            case PEARL_MAXLOC:
+                if ((lhs.mValue > rhs.mValue)
+                    || ((lhs.mValue == rhs.mValue)
+                        && (lhs.mLocation < rhs.mLocation))) {
+                    rhs.mValue    = lhs.mValue;
+                    rhs.mLocation = lhs.mLocation;
+                }
+                break;
+        }
+    }
+}
+
 /// @}
 }   // namespace detail
 }   // namespace pearl
@@ -33,15 +33,20 @@
 
 #include <cassert>
 #include <cstring>
+#include <set>
 
 using namespace std;
 using namespace pearl::detail;
 
 
-//--- Local helper functions ------------------------------------------------
+//--- Local variables & helper functions ------------------------------------
 
 namespace
 {
+/// Allocated memory segments
+set<void*> ipcSegments;
+
+
 /// @brief Map PEARL IPC datatype to element size in bytes
 ///
 /// Returns the size of a single element of the given PEARL IPC @a datatype
@@ -83,6 +88,9 @@ pearl::detail::ipcInit()
 void
 pearl::detail::ipcFinalize()
 {
+    while (!ipcSegments.empty()) {
+        ipcFreeShared(*ipcSegments.begin());
+    }
 }
 
 
@@ -196,3 +204,54 @@ pearl::detail::ipcScatterv(const void* const     sendBuffer,
     const size_t numBytes = recvCount * getElementSize(datatype);
     memcpy(recvBuffer, sendBuffer, numBytes);
 }
+
+
+void
+pearl::detail::ipcAllreduce(IpcReduceItem* const items,
+                            const uint32_t       count)
+{
+    assert(items || (count == 0));
+
+    // Single process => results stay in buffer
+}
+
+
+//--- IPC layer: Node-level shared memory -----------------------------------
+
+void*
+pearl::detail::ipcAllocShared(const size_t size,
+                              bool&        initialize)
+{
+    // Single process => private segment
+    initialize = (size > 0);
+    if (0 == size) {
+        return 0;
+    }
+
+    void* segment = new char[size];
+    ipcSegments.insert(segment);
+
+    return segment;
+}
+
+
+void
+pearl::detail::ipcSyncShared(void* const segment)
+{
+    assert((segment == 0) || (ipcSegments.count(segment) == 1));
+
+    // Single process => no synchronization necessary
+}
+
+
+void
+pearl::detail::ipcFreeShared(void* const segment)
+{
+    if (0 == segment) {
+        return;
+    }
+
+    assert(ipcSegments.count(segment) == 1);
+    ipcSegments.erase(segment);
+    delete[] static_cast<char*>(segment);
+}
@@ -33,6 +33,7 @@
 
 #include <cassert>
 #include <climits>
+#include <map>
 #include <vector>
 
 #include <mpi.h>
@@ -48,6 +49,36 @@ namespace
 /// MPI communicator used for internal communication
 MPI_Comm ipcCommunicator = MPI_COMM_NULL;
 
+/// MPI communicator including all processes on the same compute node
+MPI_Comm ipcNodeCommunicator = MPI_COMM_NULL;
+
+/// MPI windows of the allocated node-level shared memory segments
+/// (MPI_WIN_NULL for private segments)
+map<void*, MPI_Win> ipcSharedWindows;
+
+/// MPI datatype corresponding to IpcReduceItem
+MPI_Datatype ipcReduceItemType = MPI_DATATYPE_NULL;
+
+/// MPI operation combining IpcReduceItem elements
+MPI_Op ipcReduceItemOp = MPI_OP_NULL;
+
+
+/// @brief MPI user function combining reduction items
+///
+/// Wrapper around ipcCombineItems() matching the MPI_User_function
+/// signature.
+///
+void
+combineReduceItems(void*         in,
+                   void*         inout,
+                   int*          len,
+                   MPI_Datatype* datatype)
+{
+    ipcCombineItems(static_cast<IpcReduceItem*>(in),
+                    static_cast<IpcReduceItem*>(inout),
+                    *len);
+}
+
 
 /// @brief Map PEARL IPC datatype to MPI datatype
 ///
@@ -171,6 +202,13 @@ pearl::detail::ipcInit()
 
     // Create internal resources
     MPI_Comm_dup(MPI_COMM_WORLD, &ipcCommunicator);
+    MPI_Type_contiguous(sizeof(IpcReduceItem), MPI_BYTE, &ipcReduceItemType);
+    MPI_Type_commit(&ipcReduceItemType);
+    MPI_Op_create(combineReduceItems, 1, &ipcReduceItemOp);
+#if (MPI_VERSION >= 3)
+    MPI_Comm_split_type(ipcCommunicator, MPI_COMM_TYPE_SHARED, 0,
+                        MPI_INFO_NULL, &ipcNodeCommunicator);
+#endif
 }
 
 
@@ -180,6 +218,14 @@ pearl::detail::ipcFinalize()
     assert(ipcCommunicator != MPI_COMM_NULL);
 
     // Release internal resources
+    while (!ipcSharedWindows.empty()) {
+        ipcFreeShared(ipcSharedWindows.begin()->first);
+    }
+    if (ipcNodeCommunicator != MPI_COMM_NULL) {
+        MPI_Comm_free(&ipcNodeCommunicator);
+    }
+    MPI_Op_free(&ipcReduceItemOp);
+    MPI_Type_free(&ipcReduceItemType);
     MPI_Comm_free(&ipcCommunicator);
 }
 
@@ -420,3 +466,108 @@ pearl::detail::ipcScatterv(const void* const     sendBuffer,
                  recvBuffer, recvCount, mpiDatatype,
                  root, ipcCommunicator);
 }
+
+
+void
+pearl::detail::ipcAllreduce(IpcReduceItem* const items,
+                            const uint32_t       count)
+{
+    assert(ipcCommunicator != MPI_COMM_NULL);
+    assert(items || (count == 0));
+    assert(count <= INT_MAX);
+
+    if (0 == count) {
+        return;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, items, count, ipcReduceItemType,
+                  ipcReduceItemOp, ipcCommunicator);
+}
+
+
+//--- IPC layer: Node-level shared memory -----------------------------------
+
+void*
+pearl::detail::ipcAllocShared(const size_t size,
+                              bool&        initialize)
+{
+    assert(ipcCommunicator != MPI_COMM_NULL);
+
+    initialize = false;
+    if (0 == size) {
+        return 0;
+    }
+
+#if (MPI_VERSION < 3)
+    // No shared memory windows => private segment
+    void* segment = new char[size];
+    initialize = true;
+    ipcSharedWindows[segment] = MPI_WIN_NULL;
+#else
+    assert(ipcNodeCommunicator != MPI_COMM_NULL);
+
+    // The first process on each node allocates the entire segment
+    int nodeRank;
+    MPI_Comm_rank(ipcNodeCommunicator, &nodeRank);
+    initialize = (0 == nodeRank);
+
+    void*   segment;
+    MPI_Win window;
+    MPI_Win_allocate_shared(initialize ? size : 0, 1, MPI_INFO_NULL,
+                            ipcNodeCommunicator, &segment, &window);
+
+    MPI_Aint segmentSize;
+    int      dispUnit;
+    MPI_Win_shared_query(window, 0, &segmentSize, &dispUnit, &segment);
+
+    // Open a passive-target epoch, required for MPI_Win_sync
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, window);
+    ipcSharedWindows[segment] = window;
+#endif
+
+    return segment;
+}
+
+
+void
+pearl::detail::ipcSyncShared(void* const segment)
+{
+    assert(ipcCommunicator != MPI_COMM_NULL);
+
+    if (0 == segment) {
+        return;
+    }
+
+    map<void*, MPI_Win>::iterator it = ipcSharedWindows.find(segment);
+    assert(it != ipcSharedWindows.end());
+
+#if (MPI_VERSION >= 3)
+    MPI_Win_sync(it->second);
+    MPI_Barrier(ipcNodeCommunicator);
+    MPI_Win_sync(it->second);
+#endif
+}
+
+
+void
+pearl::detail::ipcFreeShared(void* const segment)
+{
+    assert(ipcCommunicator != MPI_COMM_NULL);
+
+    if (0 == segment) {
+        return;
+    }
+
+    map<void*, MPI_Win>::iterator it = ipcSharedWindows.find(segment);
+    assert(it != ipcSharedWindows.end());
+
+    MPI_Win window = it->second;
+    ipcSharedWindows.erase(it);
+    if (MPI_WIN_NULL == window) {
+        delete[] static_cast<char*>(segment);
+    } else {
+#if (MPI_VERSION >= 3)
+        MPI_Win_unlock_all(window);
+#endif
+        MPI_Win_free(&window);
+    }
+}
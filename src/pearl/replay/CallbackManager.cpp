@@ -17,6 +17,10 @@
 #include <config.h>
 #include <pearl/CallbackManager.h>
 
+#include <cstddef>
+
+#include <sys/time.h>
+
 #include <pearl/Event.h>
 
 using namespace std;
@@ -28,6 +32,42 @@ using namespace pearl;
 namespace
 {
 
+/// Returns the current wall-clock time in seconds.
+double get_wtime()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+
+  return tv.tv_sec + tv.tv_usec * 1.0e-6;
+}
+
+
+/// Callback wrapper measuring the invocations of another callback.
+class ProfiledCallback : public Callback
+{
+  public:
+    ProfiledCallback(CallbackPtr                         callback,
+                     CallbackManager::CallbackProfile& profile)
+      : m_callback(callback),
+        m_profile(profile)
+    {
+    }
+
+    virtual void execute(const CallbackManager& cbmanager, int user_event,
+                         const Event& event, CallbackData* data)
+    {
+      const double start = get_wtime();
+      m_callback->execute(cbmanager, user_event, event, data);
+      m_profile.m_time += get_wtime() - start;
+      ++m_profile.m_count;
+    }
+
+  private:
+    CallbackPtr                       m_callback;
+    CallbackManager::CallbackProfile& m_profile;
+};
+
+
 template<class containerT>
 void execute_callbacks(const containerT&             cbmap,
                        typename containerT::key_type key,
@@ -58,11 +98,22 @@ void execute_callbacks(const containerT&             cbmap,
 //
 //---------------------------------------------------------------------------
 
+//--- Constructors & destructor ---------------------------------------------
+
+CallbackManager::CallbackManager()
+  : m_profiling(false)
+{
+}
+
+
 //--- Registering callbacks -------------------------------------------------
 
 void CallbackManager::register_callback(event_t     event_type,
                                         CallbackPtr callback)
 {
+  if (m_profiling)
+    callback = make_profiled(event_type, false, callback);
+
   switch (event_type) {
     case GROUP_ALL:
       m_event_cbs[ENTER                   ].push_back(callback);
@@ -149,10 +200,35 @@ void CallbackManager::register_callback(event_t     event_type,
 
 void CallbackManager::register_callback(int user_event, CallbackPtr callback)
 {
+  if (m_profiling)
+    callback = make_profiled(user_event, true, callback);
+
   m_user_cbs[user_event].push_back(callback);
 }
 
 
+/**
+ *  Returns the set of trace event types for which at least one callback is
+ *  registered. It can be passed to the filtered PEARL_forward_replay() to
+ *  skip all events that would not trigger any callback.
+ *
+ *  @return Set of event types with registered callbacks
+ **/
+event_mask_t CallbackManager::get_event_mask() const
+{
+  event_mask_t result = 0;
+
+  event_cb_map::const_iterator it = m_event_cbs.begin();
+  while (it != m_event_cbs.end()) {
+    if (!it->second.empty())
+      result |= event_mask(it->first);
+    ++it;
+  }
+
+  return result;
+}
+
+
 //--- Notification routines -------------------------------------------------
 
 void CallbackManager::notify(const Event& event, CallbackData* data) const
@@ -167,3 +243,57 @@ void CallbackManager::notify(int           user_event,
 {
   execute_callbacks(m_user_cbs, user_event, *this, user_event, event, data);
 }
+
+
+//--- Callback profiling ----------------------------------------------------
+
+/**
+ *  Enables the profiling of all callbacks registered afterwards. Callbacks
+ *  registered before are not affected.
+ **/
+void CallbackManager::enable_profiling()
+{
+  m_profiling = true;
+}
+
+
+/**
+ *  Sets the label used to identify the callbacks registered afterwards in
+ *  the profiling data, usually the name of the registering component.
+ *
+ *  @param  label  Callback label
+ **/
+void CallbackManager::set_profile_label(const string& label)
+{
+  m_profile_label = label;
+}
+
+
+/**
+ *  Returns the profiling data of all callbacks registered while profiling
+ *  was enabled, in registration order.
+ *
+ *  @return Callback profiles
+ **/
+const CallbackManager::profile_container& CallbackManager::get_profile() const
+{
+  return m_profile;
+}
+
+
+//--- Internal methods ------------------------------------------------------
+
+CallbackPtr CallbackManager::make_profiled(int         event,
+                                           bool        user_event,
+                                           CallbackPtr callback)
+{
+  CallbackProfile profile;
+  profile.m_label      = m_profile_label;
+  profile.m_event      = event;
+  profile.m_user_event = user_event;
+  profile.m_count      = 0;
+  profile.m_time       = 0.0;
+  m_profile.push_back(profile);
+
+  return CallbackPtr(new ProfiledCallback(callback, m_profile.back()));
+}
@@ -17,12 +17,39 @@
 #include <config.h>
 #include <pearl/pearl_replay.h>
 
+#include <cstddef>
+#include <vector>
+
 #include <pearl/CallbackData.h>
 #include <pearl/CallbackManager.h>
 
+using namespace std;
 using namespace pearl;
 
 
+//--- Utility functions -----------------------------------------------------
+
+namespace
+{
+
+/// Replays a single @a event, including the pre- and postprocessing of the
+/// callback @a data object (if given).
+inline void replay_event(const CallbackManager& cbmanager,
+                         CallbackData*          data,
+                         const Event&           event)
+{
+  if (data) {
+    data->preprocess(event);
+    cbmanager.notify(event, data);
+    data->postprocess(event);
+  } else {
+    cbmanager.notify(event, data);
+  }
+}
+
+}   // unnamed namespace
+
+
 //--- Replay functionality --------------------------------------------------
 
 void pearl::PEARL_forward_replay(const LocalTrace&           trace,
@@ -51,6 +78,78 @@ void pearl::PEARL_forward_replay(const LocalTrace&           trace,
 }
 
 
+/**
+ *  Performs a forward replay of the given @a trace which only visits the
+ *  events whose types are included in @a mask (see event_mask()), in trace
+ *  order. The callback manager's get_event_mask() method provides the set
+ *  of event types for which callbacks are registered. Note that the
+ *  pre- and postprocessing of the callback @a data object is also only
+ *  performed for the selected events.
+ *
+ *  If the navigation index of the @a trace is available, the selected
+ *  events are determined from its per-type position lists, i.e., all other
+ *  events are skipped without being accessed. Otherwise, the event types are
+ *  checked while scanning the entire trace.
+ *
+ *  @param trace      Local trace data object
+ *  @param cbmanager  Callback manager
+ *  @param data       Callback data object (may be NULL)
+ *  @param mask       Set of event types to be replayed
+ *
+ *  @see LocalTrace::buildNavigationIndex()
+ **/
+void pearl::PEARL_forward_replay(const LocalTrace&      trace,
+                                 const CallbackManager& cbmanager,
+                                 CallbackData*          data,
+                                 event_mask_t           mask)
+{
+  // Without navigation index, scan the entire trace
+  if (!trace.hasNavigationIndex()) {
+    for (LocalTrace::iterator it = trace.begin(); it != trace.end(); ++it)
+      if (mask & event_mask(it->getType()))
+        replay_event(cbmanager, data, it);
+
+    return;
+  }
+
+  // Collect position lists of the selected event types
+  vector<const vector<uint32_t>*> lists;
+  for (int type = 0; type < GROUP_ALL; ++type) {
+    const vector<uint32_t>& positions = trace.m_typeIndex[type];
+    if ((mask & event_mask(event_t(type))) && !positions.empty())
+      lists.push_back(&positions);
+  }
+
+  // Single event type: replay position list directly
+  if (lists.size() == 1) {
+    const vector<uint32_t>& positions = *lists[0];
+    for (size_t i = 0; i < positions.size(); ++i)
+      replay_event(cbmanager, data, Event(&trace, positions[i]));
+
+    return;
+  }
+
+  // Multiple event types: merge position lists in trace order
+  vector<size_t> heads(lists.size(), 0);
+  while (true) {
+    size_t   next     = lists.size();
+    uint32_t position = 0;
+    for (size_t i = 0; i < lists.size(); ++i) {
+      if (heads[i] < lists[i]->size() &&
+          (next == lists.size() || (*lists[i])[heads[i]] < position)) {
+        next     = i;
+        position = (*lists[i])[heads[i]];
+      }
+    }
+    if (next == lists.size())
+      break;
+
+    ++heads[next];
+    replay_event(cbmanager, data, Event(&trace, position));
+  }
+}
+
+
 void pearl::PEARL_backward_replay(const LocalTrace&                   trace,
                                   const CallbackManager&              cbmanager,
                                   CallbackData*                       data,
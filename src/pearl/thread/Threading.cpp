@@ -66,4 +66,37 @@ PEARL_Barrier()
 #endif   // _OPENMP
 }
 
+bool
+PEARL_LoadAcquire(const bool& flag)
+{
+    bool value;
+
+#if defined(_OPENMP) && (_OPENMP >= 201107)
+#pragma omp atomic read
+    value = flag;
+#else
+    value = flag;
+#endif
+#ifdef _OPENMP
+#pragma omp flush
+#endif   // _OPENMP
+
+    return value;
+}
+
+void
+PEARL_StoreRelease(bool&      flag,
+                   const bool value)
+{
+#ifdef _OPENMP
+#pragma omp flush
+#endif   // _OPENMP
+#if defined(_OPENMP) && (_OPENMP >= 201107)
+#pragma omp atomic write
+    flag = value;
+#else
+    flag = value;
+#endif
+}
+
 }   // namespace pearl
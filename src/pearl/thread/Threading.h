@@ -129,6 +129,31 @@ PEARL_GetNumThreads();
 void
 PEARL_Barrier();
 
+/// @brief Read a flag with acquire semantics.
+///
+/// Atomically reads the given @a flag. Memory accesses following the call
+/// are not performed before the read, i.e., data published by another
+/// thread using PEARL_StoreRelease() is visible if the flag is set.
+///
+/// @param  flag  Flag to read
+///
+/// @return Value of the flag
+///
+bool
+PEARL_LoadAcquire(const bool& flag);
+
+/// @brief Write a flag with release semantics.
+///
+/// Atomically sets the given @a flag to @a value, after all preceding
+/// memory accesses of the calling thread have been completed.
+///
+/// @param  flag   Flag to write
+/// @param  value  New value
+///
+void
+PEARL_StoreRelease(bool&      flag,
+                   const bool value);
+
 /// @}
 
 }   // namespace pearl
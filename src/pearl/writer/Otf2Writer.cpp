@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2015                                                **
+**  Copyright (c) 1998-2016                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -29,11 +29,13 @@
 #include <mpi.h>
 
 #include <otf2/OTF2_Callbacks.h>
+#ifdef _OPENMP
+  #include <otf2/OTF2_OpenMP_Locks.h>
+#endif
 
-#include <pearl/CallbackData.h>
-#include <pearl/CallbackManager.h>
 #include <pearl/Callpath.h>
 #include <pearl/Communicator.h>
+#include <pearl/Error.h>
 #include <pearl/Event_rep.h>
 #include <pearl/GlobalDefs.h>
 #include <pearl/LocalTrace.h>
@@ -46,7 +48,6 @@
 #include <pearl/Region.h>
 #include <pearl/String.h>
 #include <pearl/SystemNode.h>
-#include <pearl/pearl_replay.h>
 
 #include <pearl/ThreadAcquireLock_rep.h>
 #include <pearl/ThreadFork_rep.h>
@@ -54,8 +55,6 @@
 #include <pearl/ThreadEnd_rep.h>
 #include <pearl/ThreadWait_rep.h>
 #include <pearl/ThreadCreate_rep.h>
-#include <pearl/ThreadTeamBegin_rep.h>
-#include <pearl/ThreadTeamEnd_rep.h>
 #include <pearl/ThreadReleaseLock_rep.h>
 #include <pearl/ThreadTaskCreate_rep.h>
 #include <pearl/ThreadTaskComplete_rep.h>
@@ -106,27 +105,6 @@ OTF2_CollectiveCallbacks collective_callbacks = {
 }   /* unnamed namespace */
 
 
-/*
- *---------------------------------------------------------------------------
- *
- * struct CbData
- *
- *---------------------------------------------------------------------------
- */
-
-struct CbData : public CallbackData
-{
-  CbData(const GlobalDefs& defs, OTF2_EvtWriter* evtWriter)
-    : m_defs(defs),
-      m_evtWriter(evtWriter)
-  {
-  }
-
-  const GlobalDefs& m_defs;
-  OTF2_EvtWriter*   m_evtWriter;
-};
-
-
 /*
  *---------------------------------------------------------------------------
  *
@@ -137,107 +115,39 @@ struct CbData : public CallbackData
 
 //--- Constructors & destructor ---------------------------------------------
 
-Otf2Writer::Otf2Writer()
-    : mNextStringId(0),
+/// @param substrate    OTF2 file substrate used for the archive (e.g.,
+///                     OTF2_SUBSTRATE_POSIX or OTF2_SUBSTRATE_SION)
+/// @param compression  OTF2 compression used for the archive files
+Otf2Writer::Otf2Writer(OTF2_FileSubstrate substrate,
+                       OTF2_Compression   compression)
+    : mArchive(NULL),
+      mSubstrate(substrate),
+      mCompression(compression),
+      mNextStringId(0),
       mNextSystemTreeNodeId(0),
       mGroupOffset(0),
       mThreadGroupOffset(0),
       mThreadCommOffset(0),
       mRank(0)
 {
-  // Create callback manager for replay
-  mCbManager = new CallbackManager();
-
-  // Register callback methods
-  mCbManager->register_callback(GROUP_ENTER,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::enter));
-  mCbManager->register_callback(LEAVE,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::leave));
-
-  mCbManager->register_callback(MPI_SEND,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::mpisend));
-  mCbManager->register_callback(MPI_RECV,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::mpirecv));
-  mCbManager->register_callback(MPI_SEND_REQUEST,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::mpisendreq));
-  mCbManager->register_callback(MPI_SEND_COMPLETE,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::mpisendcomp));
-  mCbManager->register_callback(MPI_RECV_REQUEST,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::mpirecvreq));
-  mCbManager->register_callback(MPI_RECV_COMPLETE,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::mpirecvcomp));
-  mCbManager->register_callback(MPI_REQUEST_TESTED,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::mpireqtested));
-  mCbManager->register_callback(MPI_CANCELLED,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::mpicancelled));
-  mCbManager->register_callback(MPI_COLLECTIVE_BEGIN,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::mpicollbegin));
-  mCbManager->register_callback(MPI_COLLECTIVE_END,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::mpicollend));
-
-  mCbManager->register_callback(THREAD_BEGIN,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::threadBegin));
-  mCbManager->register_callback(THREAD_END,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::threadEnd));
-  mCbManager->register_callback(THREAD_WAIT,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::threadWait));
-  mCbManager->register_callback(THREAD_CREATE,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::threadCreate));
-  mCbManager->register_callback(THREAD_TEAM_BEGIN,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::threadTeamBegin));
-  mCbManager->register_callback(THREAD_TEAM_END,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::threadTeamEnd));
-  mCbManager->register_callback(THREAD_FORK,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::threadFork));
-  mCbManager->register_callback(THREAD_JOIN,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::threadJoin));
-  mCbManager->register_callback(THREAD_ACQUIRE_LOCK,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::threadAcquireLock));
-  mCbManager->register_callback(THREAD_RELEASE_LOCK,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::threadReleaseLock));
-  mCbManager->register_callback(THREAD_TASK_CREATE,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::threadTaskCreate));
-  mCbManager->register_callback(THREAD_TASK_COMPLETE,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::threadTaskComplete));
-  mCbManager->register_callback(THREAD_TASK_SWITCH,
-                                PEARL_create_callback(this,
-                                                      &Otf2Writer::threadTaskSwitch));
 }
 
 
 Otf2Writer::~Otf2Writer()
 {
-  // Destroy callback manager
-  delete mCbManager;
 }
 
 
 //--- Writing experiment data -----------------------------------------------
 
+/// Writes the trace data of the calling thread's location as well as the
+/// global definitions to the OTF2 archive @a archive_name.  Events are
+/// encoded directly from the local trace data, and the global definitions
+/// are written by the master thread of rank 0 as soon as its own events are
+/// written, i.e., while the other locations are still flushing their event
+/// data.  This function has to be called collectively by all locations.
+///
+/// @throw pearl::RuntimeError  if the archive cannot be created
 void Otf2Writer::write(const string&     archive_name,
                        const LocalTrace& trace,
                        const GlobalDefs& defs)
@@ -264,15 +174,14 @@ void Otf2Writer::write(const string&     archive_name,
 
   static OTF2_Archive* tmp_archive;
   static int           tmp_rank;
-  static uint32_t      tmp_comm_offset;
+  timestamp_t          global_earliest = 0.0;
+  timestamp_t          global_latest   = 0.0;
   #pragma omp master
   {
     // Determine rank of calling process
     MPI_Comm_rank(MPI_COMM_WORLD, &mRank);
 
     // Determine earliest and latest timestamp (global)
-    timestamp_t global_earliest;
-    timestamp_t global_latest;
     MPI_Reduce(&earliest, &global_earliest, 1, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
     MPI_Reduce(&latest,   &global_latest, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
 
@@ -282,50 +191,35 @@ void Otf2Writer::write(const string&     archive_name,
                                  OTF2_FILEMODE_WRITE,
                                  OTF2_CHUNK_SIZE_EVENTS_DEFAULT,
                                  OTF2_CHUNK_SIZE_DEFINITIONS_DEFAULT,
-                                 OTF2_SUBSTRATE_POSIX,
-                                 OTF2_COMPRESSION_NONE);
-    OTF2_Archive_SetFlushCallbacks(mArchive, &flush_callbacks, NULL);
-    OTF2_Archive_SetCollectiveCallbacks(mArchive, &collective_callbacks,
-                                        NULL, NULL, NULL);
-    OTF2_Archive_SetCreator(mArchive, "PEARL trace writer");
-
-    // Write global definitions
-    if (mRank == 0) {
-      OTF2_GlobalDefWriter* writer = OTF2_Archive_GetGlobalDefWriter(mArchive);
-
-      // Write clock properties
-      OTF2_GlobalDefWriter_WriteClockProperties(writer,
-                                                UINT64_C(10000000000),
-                                                getTimestamp(global_earliest),
-                                                getTimestamp(global_latest - global_earliest));
-
-      // Write other definitions
-      writeSystemTree(writer, defs);
-      writeLocations(writer, defs);
-      writeRegions(writer, defs);
-      writeGroups(writer, defs);
-      #ifdef PEARL_ENABLE_METRICS
-        // Metric definitions should only be written if events provide values
-        writeMetrics(writer, defs);
+                                 mSubstrate,
+                                 mCompression);
+    if (mArchive) {
+      OTF2_Archive_SetFlushCallbacks(mArchive, &flush_callbacks, NULL);
+      OTF2_Archive_SetCollectiveCallbacks(mArchive, &collective_callbacks,
+                                          NULL, NULL, NULL);
+      #ifdef _OPENMP
+        OTF2_OpenMP_Archive_SetLockingCallbacks(mArchive);
       #endif
-      writeCallpaths(writer, defs);
-      writeCommunicators(writer, defs);
+      OTF2_Archive_SetCreator(mArchive, "PEARL trace writer");
+      OTF2_Archive_OpenEvtFiles(mArchive);
     }
 
-    MPI_Barrier(MPI_COMM_WORLD);
-    MPI_Bcast(&mThreadCommOffset, 1, SCALASCA_MPI_UINT32_T, 0, MPI_COMM_WORLD);
-  }
-  #pragma omp barrier
-  #pragma omp master
-  {
-    tmp_archive     = mArchive;
-    tmp_rank        = mRank;
-    tmp_comm_offset = mThreadCommOffset;
+    tmp_archive = mArchive;
+    tmp_rank    = mRank;
   }
   #pragma omp barrier
-  mArchive          = tmp_archive;
-  mRank             = tmp_rank;
-  mThreadCommOffset = tmp_comm_offset;
+  mArchive = tmp_archive;
+  mRank    = tmp_rank;
+  if (NULL == mArchive)
+    throw RuntimeError("Otf2Writer::write(const std::string&, ...) -- "
+                       "Cannot create OTF2 archive \"" + archive_name + "\".");
+
+  // The thread team communicators are numbered consecutively following the
+  // MPI communicators, so their offset can be determined locally
+  uint32_t numComms = defs.numCommunicators();
+  mThreadCommOffset = (numComms > 0)
+                        ? defs.getCommunicatorByIndex(numComms - 1).getId() + 1
+                        : 0;
 
   // Create local event writer
   OTF2_EvtWriter* evt_writer;
@@ -336,33 +230,42 @@ void Otf2Writer::write(const string&     archive_name,
     evt_writer = OTF2_Archive_GetEvtWriter(mArchive, locId);
   }
 
-  // Replay trace to write event data
-  CbData data(defs, evt_writer);
-  PEARL_forward_replay(trace, *mCbManager, &data);
+  // Write event data
+  writeEvents(evt_writer, trace, defs);
+  #pragma omp critical
+  {
+    OTF2_Archive_CloseEvtWriter(mArchive, evt_writer);
+  }
+
+  // Write global definitions while remaining locations are still busy
+  #pragma omp master
+  {
+    if (mRank == 0)
+      writeDefinitions(defs, global_earliest, global_latest);
+  }
 
   #pragma omp barrier
   #pragma omp master
   {
     // Close OTF2 archive
+    OTF2_Archive_CloseEvtFiles(mArchive);
     OTF2_Archive_Close(mArchive);
   }
 }
 
 
-//--- Replay callback routines (private) ------------------------------------
+//--- Event encoding routines (private) -------------------------------------
 
-void Otf2Writer::enter(const CallbackManager& cbManager,
-                       int                    userEvent,
-                       const Event&           event,
-                       CallbackData*          cbData)
+void Otf2Writer::enter(OTF2_EvtWriter*   writer,
+                       const GlobalDefs& defs,
+                       const Event&      event)
 {
-  CbData*  data   = static_cast<CbData*>(cbData);
   Region*  region = const_cast<Region*>(&event.get_cnode()->getRegion());
   uint64_t time   = getTimestamp(event->getTimestamp());
 
   // Handle buffer flush regions
-  if (*region == data->m_defs.getFlushingRegion()) {
-    OTF2_EvtWriter_BufferFlush(data->m_evtWriter,
+  if (*region == defs.getFlushingRegion()) {
+    OTF2_EvtWriter_BufferFlush(writer,
                                NULL,
                                time,
                                getTimestamp(event.leaveptr()->getTimestamp()));
@@ -370,8 +273,8 @@ void Otf2Writer::enter(const CallbackManager& cbManager,
   }
 
   // Handle regions where measurement was turned off
-  if (*region == data->m_defs.getPausingRegion()) {
-    OTF2_EvtWriter_MeasurementOnOff(data->m_evtWriter,
+  if (*region == defs.getPausingRegion()) {
+    OTF2_EvtWriter_MeasurementOnOff(writer,
                                     NULL,
                                     time,
                                     OTF2_MEASUREMENT_OFF);
@@ -379,32 +282,30 @@ void Otf2Writer::enter(const CallbackManager& cbManager,
   }
 
   #ifdef PEARL_ENABLE_METRICS
-    writeMetricValues(data->m_evtWriter, data->m_defs, event);
+    writeMetricValues(writer, defs, event);
   #endif
 
-  OTF2_EvtWriter_Enter(data->m_evtWriter,
+  OTF2_EvtWriter_Enter(writer,
                        NULL,
                        time,
                        region->getId());
 }
 
 
-void Otf2Writer::leave(const CallbackManager& cbManager,
-                       int                    userEvent,
-                       const Event&           event,
-                       CallbackData*          cbData)
+void Otf2Writer::leave(OTF2_EvtWriter*   writer,
+                       const GlobalDefs& defs,
+                       const Event&      event)
 {
-  CbData*  data   = static_cast<CbData*>(cbData);
   Region*  region = const_cast<Region*>(&event.get_cnode()->getRegion());
   uint64_t time   = getTimestamp(event->getTimestamp());
 
-  // Leaving buffer flush regions was already handled in enter() callback
-  if (*region == data->m_defs.getFlushingRegion())
+  // Leaving buffer flush regions was already handled in enter()
+  if (*region == defs.getFlushingRegion())
     return;
 
   // Handle regions where measurement was turned off
-  if (*region == data->m_defs.getPausingRegion()) {
-    OTF2_EvtWriter_MeasurementOnOff(data->m_evtWriter,
+  if (*region == defs.getPausingRegion()) {
+    OTF2_EvtWriter_MeasurementOnOff(writer,
                                     NULL,
                                     time,
                                     OTF2_MEASUREMENT_ON);
@@ -412,10 +313,10 @@ void Otf2Writer::leave(const CallbackManager& cbManager,
   }
 
   #ifdef PEARL_ENABLE_METRICS
-    writeMetricValues(data->m_evtWriter, data->m_defs, event);
+    writeMetricValues(writer, defs, event);
   #endif
 
-  OTF2_EvtWriter_Leave(data->m_evtWriter,
+  OTF2_EvtWriter_Leave(writer,
                        NULL,
                        time,
                        region->getId());
@@ -423,16 +324,14 @@ void Otf2Writer::leave(const CallbackManager& cbManager,
 
 
 /// @todo Remove sending of size message once available in the receive event
-void Otf2Writer::mpisend(const CallbackManager& cbManager,
-                         int                    userEvent,
-                         const Event&           event,
-                         CallbackData*          cbData)
+void Otf2Writer::mpisend(OTF2_EvtWriter*   writer,
+                         const GlobalDefs& defs,
+                         const Event&      event)
 {
-  CbData*  data = static_cast<CbData*>(cbData);
   uint64_t time = getTimestamp(event->getTimestamp());
   uint64_t size = event->getBytesSent();
 
-  OTF2_EvtWriter_MpiSend(data->m_evtWriter,
+  OTF2_EvtWriter_MpiSend(writer,
                          NULL,
                          time,
                          event->getDestination(),
@@ -451,12 +350,10 @@ void Otf2Writer::mpisend(const CallbackManager& cbManager,
 
 /// @todo Use getBytesReceived() call to determine message length once
 ///       available in the receive event
-void Otf2Writer::mpirecv(const CallbackManager& cbManager,
-                         int                    userEvent,
-                         const Event&           event,
-                         CallbackData*          cbData)
+void Otf2Writer::mpirecv(OTF2_EvtWriter*   writer,
+                         const GlobalDefs& defs,
+                         const Event&      event)
 {
-  CbData*  data = static_cast<CbData*>(cbData);
   uint64_t time = getTimestamp(event->getTimestamp());
 
   // Receive the message size from the sender
@@ -465,7 +362,7 @@ void Otf2Writer::mpirecv(const CallbackManager& cbManager,
   MPI_Recv(&size, 1, SCALASCA_MPI_UINT64_T, event->getSource(), event->getTag(),
            event->getComm()->getComm(), &status);
 
-  OTF2_EvtWriter_MpiRecv(data->m_evtWriter,
+  OTF2_EvtWriter_MpiRecv(writer,
                          NULL,
                          time,
                          event->getSource(),
@@ -476,16 +373,14 @@ void Otf2Writer::mpirecv(const CallbackManager& cbManager,
 
 
 /// @todo Remove sending of size message once available in the receive event
-void Otf2Writer::mpisendreq(const CallbackManager& cbManager,
-                            int                    userEvent,
-                            const Event&           event,
-                            CallbackData*          cbData)
+void Otf2Writer::mpisendreq(OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event)
 {
-  CbData*  data = static_cast<CbData*>(cbData);
   uint64_t time = getTimestamp(event->getTimestamp());
   uint64_t size = event->getBytesSent();
 
-  OTF2_EvtWriter_MpiIsend(data->m_evtWriter,
+  OTF2_EvtWriter_MpiIsend(writer,
                           NULL,
                           time,
                           event->getDestination(),
@@ -503,30 +398,26 @@ void Otf2Writer::mpisendreq(const CallbackManager& cbManager,
 }
 
 
-void Otf2Writer::mpisendcomp(const CallbackManager& cbManager,
-                             int                    userEvent,
-                             const Event&           event,
-                             CallbackData*          cbData)
+void Otf2Writer::mpisendcomp(OTF2_EvtWriter*   writer,
+                             const GlobalDefs& defs,
+                             const Event&      event)
 {
-  CbData*  data = static_cast<CbData*>(cbData);
   uint64_t time = getTimestamp(event->getTimestamp());
 
-  OTF2_EvtWriter_MpiIsendComplete(data->m_evtWriter,
+  OTF2_EvtWriter_MpiIsendComplete(writer,
                                   NULL,
                                   time,
                                   event->getRequestId());
 }
 
 
-void Otf2Writer::mpirecvreq(const CallbackManager& cbManager,
-                            int                    userEvent,
-                            const Event&           event,
-                            CallbackData*          cbData)
+void Otf2Writer::mpirecvreq(OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event)
 {
-  CbData*  data = static_cast<CbData*>(cbData);
   uint64_t time = getTimestamp(event->getTimestamp());
 
-  OTF2_EvtWriter_MpiIrecvRequest(data->m_evtWriter,
+  OTF2_EvtWriter_MpiIrecvRequest(writer,
                                  NULL,
                                  time,
                                  event->getRequestId());
@@ -535,12 +426,10 @@ void Otf2Writer::mpirecvreq(const CallbackManager& cbManager,
 
 /// @todo Use getBytesReceived() call to determine message length once
 ///       available in the receive event
-void Otf2Writer::mpirecvcomp(const CallbackManager& cbManager,
-                             int                    userEvent,
-                             const Event&           event,
-                             CallbackData*          cbData)
+void Otf2Writer::mpirecvcomp(OTF2_EvtWriter*   writer,
+                             const GlobalDefs& defs,
+                             const Event&      event)
 {
-  CbData*  data = static_cast<CbData*>(cbData);
   uint64_t time = getTimestamp(event->getTimestamp());
 
   // Receive the message size from the sender
@@ -549,7 +438,7 @@ void Otf2Writer::mpirecvcomp(const CallbackManager& cbManager,
   MPI_Recv(&size, 1, SCALASCA_MPI_UINT64_T, event->getSource(), event->getTag(),
            event->getComm()->getComm(), &status);
 
-   OTF2_EvtWriter_MpiIrecv(data->m_evtWriter,
+   OTF2_EvtWriter_MpiIrecv(writer,
                            NULL,
                            time,
                            event->getSource(),
@@ -560,60 +449,52 @@ void Otf2Writer::mpirecvcomp(const CallbackManager& cbManager,
 }
 
 
-void Otf2Writer::mpireqtested(const CallbackManager& cbManager,
-                              int                    userEvent,
-                              const Event&           event,
-                              CallbackData*          cbData)
+void Otf2Writer::mpireqtested(OTF2_EvtWriter*   writer,
+                              const GlobalDefs& defs,
+                              const Event&      event)
 {
-  CbData*  data = static_cast<CbData*>(cbData);
   uint64_t time = getTimestamp(event->getTimestamp());
 
-  OTF2_EvtWriter_MpiRequestTest(data->m_evtWriter,
+  OTF2_EvtWriter_MpiRequestTest(writer,
                                 NULL,
                                 time,
                                 event->getRequestId());
 }
 
 
-void Otf2Writer::mpicancelled(const CallbackManager& cbManager,
-                              int                    userEvent,
-                              const Event&           event,
-                              CallbackData*          cbData)
+void Otf2Writer::mpicancelled(OTF2_EvtWriter*   writer,
+                              const GlobalDefs& defs,
+                              const Event&      event)
 {
-  CbData*  data = static_cast<CbData*>(cbData);
   uint64_t time = getTimestamp(event->getTimestamp());
 
-  OTF2_EvtWriter_MpiRequestCancelled(data->m_evtWriter,
+  OTF2_EvtWriter_MpiRequestCancelled(writer,
                                      NULL,
                                      time,
                                      event->getRequestId());
 }
 
 
-void Otf2Writer::mpicollbegin(const CallbackManager& cbManager,
-                              int                    userEvent,
-                              const Event&           event,
-                              CallbackData*          cbData)
+void Otf2Writer::mpicollbegin(OTF2_EvtWriter*   writer,
+                              const GlobalDefs& defs,
+                              const Event&      event)
 {
-  CbData*  data = static_cast<CbData*>(cbData);
   uint64_t time = getTimestamp(event->getTimestamp());
 
-  OTF2_EvtWriter_MpiCollectiveBegin(data->m_evtWriter,
+  OTF2_EvtWriter_MpiCollectiveBegin(writer,
                                     NULL,
                                     time);
 }
 
 
-void Otf2Writer::mpicollend(const CallbackManager& cbManager,
-                            int                    userEvent,
-                            const Event&           event,
-                            CallbackData*          cbData)
+void Otf2Writer::mpicollend(OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event)
 {
-  CbData*         data     = static_cast<CbData*>(cbData);
   uint64_t        time     = getTimestamp(event->getTimestamp());
   MpiCollEnd_rep& eventRep = event_cast<MpiCollEnd_rep>(*event);
 
-  OTF2_EvtWriter_MpiCollectiveEnd(data->m_evtWriter,
+  OTF2_EvtWriter_MpiCollectiveEnd(writer,
                                   NULL,
                                   time,
                                   getMpiCollectiveType(eventRep.getCollType()),
@@ -626,16 +507,14 @@ void Otf2Writer::mpicollend(const CallbackManager& cbManager,
 }
 
 
-void Otf2Writer::threadBegin(const CallbackManager& cbManager,
-                             int                    userEvent,
-                             const Event&           event,
-                             CallbackData*          cbData)
+void Otf2Writer::threadBegin(OTF2_EvtWriter*   writer,
+                             const GlobalDefs& defs,
+                             const Event&      event)
 {
-  CbData*          data     = static_cast<CbData*>(cbData);
   uint64_t         time     = getTimestamp(event->getTimestamp());
   ThreadBegin_rep& eventRep = event_cast<ThreadBegin_rep>(*event);
 
-  OTF2_EvtWriter_ThreadBegin(data->m_evtWriter,
+  OTF2_EvtWriter_ThreadBegin(writer,
                              NULL,
                              time,
                              eventRep.getThreadContingent(),
@@ -643,16 +522,14 @@ void Otf2Writer::threadBegin(const CallbackManager& cbManager,
 }
 
 
-void Otf2Writer::threadEnd(const CallbackManager& cbManager,
-                           int                    userEvent,
-                           const Event&           event,
-                           CallbackData*          cbData)
+void Otf2Writer::threadEnd(OTF2_EvtWriter*   writer,
+                           const GlobalDefs& defs,
+                           const Event&      event)
 {
-  CbData*        data     = static_cast<CbData*>(cbData);
   uint64_t       time     = getTimestamp(event->getTimestamp());
   ThreadEnd_rep& eventRep = event_cast<ThreadEnd_rep>(*event);
 
-  OTF2_EvtWriter_ThreadEnd(data->m_evtWriter,
+  OTF2_EvtWriter_ThreadEnd(writer,
                            NULL,
                            time,
                            eventRep.getThreadContingent(),
@@ -660,16 +537,14 @@ void Otf2Writer::threadEnd(const CallbackManager& cbManager,
 }
 
 
-void Otf2Writer::threadWait(const CallbackManager& cbManager,
-                            int                    userEvent,
-                            const Event&           event,
-                            CallbackData*          cbData)
+void Otf2Writer::threadWait(OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event)
 {
-  CbData*         data     = static_cast<CbData*>(cbData);
   uint64_t        time     = getTimestamp(event->getTimestamp());
   ThreadWait_rep& eventRep = event_cast<ThreadWait_rep>(*event);
 
-  OTF2_EvtWriter_ThreadWait(data->m_evtWriter,
+  OTF2_EvtWriter_ThreadWait(writer,
                             NULL,
                             time,
                             eventRep.getThreadContingent(),
@@ -677,16 +552,14 @@ void Otf2Writer::threadWait(const CallbackManager& cbManager,
 }
 
 
-void Otf2Writer::threadCreate(const CallbackManager& cbManager,
-                              int                    userEvent,
-                              const Event&           event,
-                              CallbackData*          cbData)
+void Otf2Writer::threadCreate(OTF2_EvtWriter*   writer,
+                              const GlobalDefs& defs,
+                              const Event&      event)
 {
-  CbData*           data     = static_cast<CbData*>(cbData);
   uint64_t          time     = getTimestamp(event->getTimestamp());
   ThreadCreate_rep& eventRep = event_cast<ThreadCreate_rep>(*event);
 
-  OTF2_EvtWriter_ThreadCreate(data->m_evtWriter,
+  OTF2_EvtWriter_ThreadCreate(writer,
                             NULL,
                             time,
                             eventRep.getThreadContingent(),
@@ -694,48 +567,40 @@ void Otf2Writer::threadCreate(const CallbackManager& cbManager,
 }
 
 
-void Otf2Writer::threadTeamBegin(const CallbackManager& cbManager,
-                                 int                    userEvent,
-                                 const Event&           event,
-                                 CallbackData*          cbData)
+void Otf2Writer::threadTeamBegin(OTF2_EvtWriter*   writer,
+                                 const GlobalDefs& defs,
+                                 const Event&      event)
 {
-  CbData*              data     = static_cast<CbData*>(cbData);
-  uint64_t             time     = getTimestamp(event->getTimestamp());
-  ThreadTeamBegin_rep& eventRep = event_cast<ThreadTeamBegin_rep>(*event);
+  uint64_t time = getTimestamp(event->getTimestamp());
 
-  OTF2_EvtWriter_ThreadTeamBegin(data->m_evtWriter,
+  OTF2_EvtWriter_ThreadTeamBegin(writer,
                                  NULL,
                                  time,
                                  mThreadCommOffset + mRank);
 }
 
 
-void Otf2Writer::threadTeamEnd(const CallbackManager& cbManager,
-                                 int                    userEvent,
-                                 const Event&           event,
-                                 CallbackData*          cbData)
+void Otf2Writer::threadTeamEnd(OTF2_EvtWriter*   writer,
+                               const GlobalDefs& defs,
+                               const Event&      event)
 {
-  CbData*            data     = static_cast<CbData*>(cbData);
-  uint64_t           time     = getTimestamp(event->getTimestamp());
-  ThreadTeamEnd_rep& eventRep = event_cast<ThreadTeamEnd_rep>(*event);
+  uint64_t time = getTimestamp(event->getTimestamp());
 
-  OTF2_EvtWriter_ThreadTeamBegin(data->m_evtWriter,
-                                 NULL,
-                                 time,
-                                 mThreadCommOffset + mRank);
+  OTF2_EvtWriter_ThreadTeamEnd(writer,
+                               NULL,
+                               time,
+                               mThreadCommOffset + mRank);
 }
 
 /// @todo Fix number of locations, does not consider non-CPU locations yet
-void Otf2Writer::threadFork(const CallbackManager& cbManager,
-                            int                    userEvent,
-                            const Event&           event,
-                            CallbackData*          cbData)
+void Otf2Writer::threadFork(OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event)
 {
-  CbData*         data     = static_cast<CbData*>(cbData);
   uint64_t        time     = getTimestamp(event->getTimestamp());
   ThreadFork_rep& eventRep = event_cast<ThreadFork_rep>(*event);
 
-  OTF2_EvtWriter_ThreadFork(data->m_evtWriter,
+  OTF2_EvtWriter_ThreadFork(writer,
                             NULL,
                             time,
                             OTF2_PARADIGM_OPENMP,
@@ -743,31 +608,27 @@ void Otf2Writer::threadFork(const CallbackManager& cbManager,
 }
 
 
-void Otf2Writer::threadJoin(const CallbackManager& cbManager,
-                            int                    userEvent,
-                            const Event&           event,
-                            CallbackData*          cbData)
+void Otf2Writer::threadJoin(OTF2_EvtWriter*   writer,
+                            const GlobalDefs& defs,
+                            const Event&      event)
 {
-  CbData*  data = static_cast<CbData*>(cbData);
   uint64_t time = getTimestamp(event->getTimestamp());
 
-  OTF2_EvtWriter_ThreadJoin(data->m_evtWriter,
+  OTF2_EvtWriter_ThreadJoin(writer,
                             NULL,
                             time,
                             OTF2_PARADIGM_OPENMP);
 }
 
 
-void Otf2Writer::threadAcquireLock(const CallbackManager& cbManager,
-                                   int                    userEvent,
-                                   const Event&           event,
-                                   CallbackData*          cbData)
+void Otf2Writer::threadAcquireLock(OTF2_EvtWriter*   writer,
+                                   const GlobalDefs& defs,
+                                   const Event&      event)
 {
-  CbData*                data     = static_cast<CbData*>(cbData);
   uint64_t               time     = getTimestamp(event->getTimestamp());
   ThreadAcquireLock_rep& eventRep = event_cast<ThreadAcquireLock_rep>(*event);
 
-  OTF2_EvtWriter_ThreadAcquireLock(data->m_evtWriter,
+  OTF2_EvtWriter_ThreadAcquireLock(writer,
                                    NULL,
                                    time,
                                    OTF2_PARADIGM_OPENMP,
@@ -776,16 +637,14 @@ void Otf2Writer::threadAcquireLock(const CallbackManager& cbManager,
 }
 
 
-void Otf2Writer::threadReleaseLock(const CallbackManager& cbManager,
-                                   int                    userEvent,
-                                   const Event&           event,
-                                   CallbackData*          cbData)
+void Otf2Writer::threadReleaseLock(OTF2_EvtWriter*   writer,
+                                   const GlobalDefs& defs,
+                                   const Event&      event)
 {
-  CbData*                data     = static_cast<CbData*>(cbData);
   uint64_t               time     = getTimestamp(event->getTimestamp());
   ThreadReleaseLock_rep& eventRep = event_cast<ThreadReleaseLock_rep>(*event);
 
-  OTF2_EvtWriter_ThreadReleaseLock(data->m_evtWriter,
+  OTF2_EvtWriter_ThreadReleaseLock(writer,
                                    NULL,
                                    time,
                                    OTF2_PARADIGM_OPENMP,
@@ -794,16 +653,14 @@ void Otf2Writer::threadReleaseLock(const CallbackManager& cbManager,
 }
 
 
-void Otf2Writer::threadTaskCreate(const CallbackManager& cbManager,
-                                  int                    userEvent,
-                                  const Event&           event,
-                                  CallbackData*          cbData)
+void Otf2Writer::threadTaskCreate(OTF2_EvtWriter*   writer,
+                                  const GlobalDefs& defs,
+                                  const Event&      event)
 {
-  CbData*               data     = static_cast<CbData*>(cbData);
   uint64_t              time     = getTimestamp(event->getTimestamp());
   ThreadTaskCreate_rep& eventRep = event_cast<ThreadTaskCreate_rep>(*event);
 
-  OTF2_EvtWriter_ThreadTaskCreate(data->m_evtWriter,
+  OTF2_EvtWriter_ThreadTaskCreate(writer,
                                   NULL,
                                   time,
                                   eventRep.getThreadTeam(),
@@ -811,16 +668,14 @@ void Otf2Writer::threadTaskCreate(const CallbackManager& cbManager,
 }
 
 
-void Otf2Writer::threadTaskComplete(const CallbackManager& cbManager,
-                                    int                    userEvent,
-                                    const Event&           event,
-                                    CallbackData*          cbData)
+void Otf2Writer::threadTaskComplete(OTF2_EvtWriter*   writer,
+                                    const GlobalDefs& defs,
+                                    const Event&      event)
 {
-  CbData*                 data     = static_cast<CbData*>(cbData);
   uint64_t                time     = getTimestamp(event->getTimestamp());
   ThreadTaskComplete_rep& eventRep = event_cast<ThreadTaskComplete_rep>(*event);
 
-  OTF2_EvtWriter_ThreadTaskComplete(data->m_evtWriter,
+  OTF2_EvtWriter_ThreadTaskComplete(writer,
                                  NULL,
                                  time,
                                  eventRep.getThreadTeam(),
@@ -828,16 +683,14 @@ void Otf2Writer::threadTaskComplete(const CallbackManager& cbManager,
 }
 
 
-void Otf2Writer::threadTaskSwitch(const CallbackManager& cbManager,
-                                  int                    userEvent,
-                                  const Event&           event,
-                                  CallbackData*          cbData)
+void Otf2Writer::threadTaskSwitch(OTF2_EvtWriter*   writer,
+                                  const GlobalDefs& defs,
+                                  const Event&      event)
 {
-  CbData*               data     = static_cast<CbData*>(cbData);
   uint64_t              time     = getTimestamp(event->getTimestamp());
   ThreadTaskSwitch_rep& eventRep = event_cast<ThreadTaskSwitch_rep>(*event);
 
-  OTF2_EvtWriter_ThreadTaskSwitch(data->m_evtWriter,
+  OTF2_EvtWriter_ThreadTaskSwitch(writer,
                                   NULL,
                                   time,
                                   eventRep.getThreadTeam(),
@@ -847,6 +700,154 @@ void Otf2Writer::threadTaskSwitch(const CallbackManager& cbManager,
 
 //--- Internal I/O routines (private) ---------------------------------------
 
+/// Encodes all events of the given local @a trace in a single sequential
+/// pass, dispatching directly on the event type instead of using a replay
+/// with one callback per event type.
+void Otf2Writer::writeEvents(OTF2_EvtWriter*   writer,
+                             const LocalTrace& trace,
+                             const GlobalDefs& defs)
+{
+  LocalTrace::iterator it  = trace.begin();
+  LocalTrace::iterator end = trace.end();
+  while (it != end) {
+    switch (it->getType()) {
+      case ENTER:
+      case ENTER_CS:
+        enter(writer, defs, it);
+        break;
+
+      case LEAVE:
+        leave(writer, defs, it);
+        break;
+
+      case MPI_SEND:
+        mpisend(writer, defs, it);
+        break;
+
+      case MPI_RECV:
+        mpirecv(writer, defs, it);
+        break;
+
+      case MPI_SEND_REQUEST:
+        mpisendreq(writer, defs, it);
+        break;
+
+      case MPI_SEND_COMPLETE:
+        mpisendcomp(writer, defs, it);
+        break;
+
+      case MPI_RECV_REQUEST:
+        mpirecvreq(writer, defs, it);
+        break;
+
+      case MPI_RECV_COMPLETE:
+        mpirecvcomp(writer, defs, it);
+        break;
+
+      case MPI_REQUEST_TESTED:
+        mpireqtested(writer, defs, it);
+        break;
+
+      case MPI_CANCELLED:
+        mpicancelled(writer, defs, it);
+        break;
+
+      case MPI_COLLECTIVE_BEGIN:
+        mpicollbegin(writer, defs, it);
+        break;
+
+      case MPI_COLLECTIVE_END:
+        mpicollend(writer, defs, it);
+        break;
+
+      case THREAD_BEGIN:
+        threadBegin(writer, defs, it);
+        break;
+
+      case THREAD_END:
+        threadEnd(writer, defs, it);
+        break;
+
+      case THREAD_WAIT:
+        threadWait(writer, defs, it);
+        break;
+
+      case THREAD_CREATE:
+        threadCreate(writer, defs, it);
+        break;
+
+      case THREAD_TEAM_BEGIN:
+        threadTeamBegin(writer, defs, it);
+        break;
+
+      case THREAD_TEAM_END:
+        threadTeamEnd(writer, defs, it);
+        break;
+
+      case THREAD_FORK:
+        threadFork(writer, defs, it);
+        break;
+
+      case THREAD_JOIN:
+        threadJoin(writer, defs, it);
+        break;
+
+      case THREAD_ACQUIRE_LOCK:
+        threadAcquireLock(writer, defs, it);
+        break;
+
+      case THREAD_RELEASE_LOCK:
+        threadReleaseLock(writer, defs, it);
+        break;
+
+      case THREAD_TASK_CREATE:
+        threadTaskCreate(writer, defs, it);
+        break;
+
+      case THREAD_TASK_COMPLETE:
+        threadTaskComplete(writer, defs, it);
+        break;
+
+      case THREAD_TASK_SWITCH:
+        threadTaskSwitch(writer, defs, it);
+        break;
+
+      // Other event types are not (yet) supported
+      default:
+        break;
+    }
+
+    ++it;
+  }
+}
+
+
+void Otf2Writer::writeDefinitions(const GlobalDefs& defs,
+                                  timestamp_t       earliest,
+                                  timestamp_t       latest)
+{
+  OTF2_GlobalDefWriter* writer = OTF2_Archive_GetGlobalDefWriter(mArchive);
+
+  // Write clock properties
+  OTF2_GlobalDefWriter_WriteClockProperties(writer,
+                                            UINT64_C(10000000000),
+                                            getTimestamp(earliest),
+                                            getTimestamp(latest - earliest));
+
+  // Write other definitions
+  writeSystemTree(writer, defs);
+  writeLocations(writer, defs);
+  writeRegions(writer, defs);
+  writeGroups(writer, defs);
+  #ifdef PEARL_ENABLE_METRICS
+    // Metric definitions should only be written if events provide values
+    writeMetrics(writer, defs);
+  #endif
+  writeCallpaths(writer, defs);
+  writeCommunicators(writer, defs);
+}
+
+
 uint32_t Otf2Writer::writeString(OTF2_GlobalDefWriter* writer,
                                  const string& str)
 {
@@ -826,6 +826,7 @@ int main(int argc, char** argv) {
 	  // Initialize PEARL
 	  PEARL_verify_calltree(*defs, *trace);
 	  PEARL_mpi_unify_calltree(*defs);
+	  PEARL_mpi_create_comms(*defs);
 	  PEARL_preprocess_trace(*defs, *trace);
   } catch (const Error& error) {
 	  if(rank == 0) {
@@ -134,7 +134,8 @@ AmLockContention::pack(ident_t    key,
 }
 
 
-/// Executes handler on target side
+/// Executes handler on target side. The sort keys of the received lock
+/// epoch are determined once before it is added to the queue.
 ///
 /// @param [in,out] buffer Buffer with handler information
 ///
@@ -145,10 +146,12 @@ AmLockContention::execute(Buffer& buffer)
     uint32_t size   = buffer.get_uint32();
     CbData*  cbdata = static_cast<CbData*>(AmRuntime::getInstance().getCbdata());
 
-    RemoteRmaEpochPtr remoteRmaEpoch(new RemoteRmaEpoch());
+    LockEpoch epoch;
 
+    epoch.mEvents.reserve(size);
     for (uint32_t i = 0; i < size; ++i) {
-        remoteRmaEpoch->push_back(buffer.get_event(*(cbdata->mDefs)));
+        epoch.mEvents.push_back(buffer.get_event(*(cbdata->mDefs)));
     }
-    mQueues[key]->push(remoteRmaEpoch);
+    epoch.setKeys();
+    mQueues[key]->push(epoch);
 }
@@ -41,6 +41,14 @@ public:
   virtual ~AnalysisHandler() 
     { }
 
+  /// @name Identification
+  /// @{
+
+  /// Returns the handler name (e.g., used to label its callbacks)
+  virtual const char* get_name() const = 0;
+
+  /// @}
+
   /// @name Callback registration
   /// @{
 
@@ -26,15 +26,22 @@
 #include <cubew_cube.h>
 #include "TaskData.h"
 
+#include <pearl/Buffer.h>
+#include <pearl/Error.h>
+#include <pearl/GlobalDefs.h>
 #include <pearl/pearl_replay.h>
 #include <pearl/ReplayTask.h>
 
+#include "CounterPattern.h"
+#include "Logging.h"
 #include "MpiCommunicationHandler.h"
 #include "OmpEventHandler.h"
 #include "Pattern.h"
 #include "Patterns_gen.h"
+#include "ProfileTask.h"
 #include "ReplayControlHandler.h"
 #include "ReportData.h"
+#include "SelfProfile.h"
 #include "StatisticsTask.h"
 #include "SynchpointHandler.h"
 #include "TimedPhase.h"
@@ -48,7 +55,9 @@ using namespace scout;
 
 extern bool enableCriticalPath;
 extern bool enableDelayAnalysis;
+extern bool enableProfileOnly;
 extern bool enableSinglePass;
+extern bool enableThreadMultiple;
 
 
 //---------------------------------------------------------------------------
@@ -71,14 +80,20 @@ private:
   direction_t      mDirection;
   int              mPrepareEvent;
   int              mFinishEvent;
+  std::string      mName;
+  SelfProfile*     mProfile;
 
   bool prepare() {
+    if (mProfile)
+      mProfile->setPass(mName);
     m_cbmanager->notify(mPrepareEvent, m_trace.end(), m_cbdata);
     return true;
   }
 
   bool finish() {
     m_cbmanager->notify(mFinishEvent,  m_trace.end(), m_cbdata);
+    if (mProfile)
+      mProfile->addCallbacks(*m_cbmanager);
     return true;
   }
 
@@ -96,18 +111,21 @@ private:
 
 
 public:
-  AnalysisReplayTask(AnalyzeTask*     parent,
-                     CallbackManager* cbmgr,
-                     direction_t      direction,
-                     int              prepevt,
-                     int              finevt)
+  AnalysisReplayTask(AnalyzeTask*       parent,
+                     CallbackManager*   cbmgr,
+                     direction_t        direction,
+                     int                prepevt,
+                     int                finevt,
+                     const std::string& name)
     : ReplayTask(*(parent->mSharedData.mDefinitions),
                  *(parent->mPrivateData.mTrace),
                  &(parent->mCallbackData),
                  cbmgr),
       mDirection(direction),
       mPrepareEvent(prepevt),
-      mFinishEvent(finevt)
+      mFinishEvent(finevt),
+      mName(name),
+      mProfile(parent->mPrivateData.mSelfProfile)
   { }
 };
 
@@ -135,7 +153,8 @@ AnalyzeTask::AnalyzeTask(const TaskDataShared&  sharedData,
   : CompoundTask(),
     mSharedData(sharedData),
     mPrivateData(privateData),
-    mStatistics(NULL)
+    mStatistics(NULL),
+    mSkipReplay(false)
 {
 }
 
@@ -147,6 +166,8 @@ AnalyzeTask::~AnalyzeTask()
 {
   for (PatternList::iterator it = mPatterns.begin(); it != mPatterns.end(); ++it)
     delete *it;
+  for (PatternList::iterator it = mUnreportedPatterns.begin(); it != mUnreportedPatterns.end(); ++it)
+    delete *it;
 }
 
 //--- Adding performance patterns -------------------------------------------
@@ -162,9 +183,30 @@ void AnalyzeTask::addPattern(Pattern* pattern)
 {
   // Add pattern to list and register callbacks
   mPatterns.push_back(pattern);
+  setProfileLabel(pattern->get_unique_name());
   pattern->reg_cb(mCallbackManagers);
 }
 
+/**
+ *  @brief Registers a trace-event callback for a given replay.
+ *
+ *  This method registers the given @a callback for the event type @a event
+ *  with the callback manager of the replay identified by @a replay. It is
+ *  used by the fused replay kernels generated for the patterns, which
+ *  dispatch all pattern callbacks of a replay through a single object.
+ **/
+void AnalyzeTask::addCallback(const std::string& replay,
+                              pearl::event_t     event,
+                              pearl::CallbackPtr callback)
+{
+  CallbackManagerMap::iterator it = mCallbackManagers.find(replay);
+  assert(it != mCallbackManagers.end());
+
+  if (mPrivateData.mSelfProfile)
+    (it->second)->set_profile_label("fused kernel");
+  (it->second)->register_callback(event, callback);
+}
+
 //--- Register statistics task ----------------------------------------------
 
 /**
@@ -185,6 +227,69 @@ void AnalyzeTask::register_statistics_cbs(StatisticsTask* sttask)
 }
 
 
+//--- Checkpointing ---------------------------------------------------------
+
+/**
+ *  @brief Skips the trace replay.
+ *
+ *  Configures the task to only create the pattern objects, but not to
+ *  perform the trace replay (or profile computation). This is used when
+ *  the analysis results are restored from a checkpoint via unpackState()
+ *  afterwards.
+ **/
+void AnalyzeTask::skipReplay()
+{
+  mSkipReplay = true;
+}
+
+
+/**
+ *  @brief Stores the local analysis results in a buffer.
+ *
+ *  Packs the local state of all reported patterns, followed by the event
+ *  counters of the registered statistics task, into the given @a buffer.
+ *  Together with the preprocessed trace data, this state is sufficient to
+ *  generate the analysis report without repeating the trace replay.
+ *
+ *  @param  buffer  Buffer to store the state in
+ **/
+void AnalyzeTask::packState(Buffer& buffer) const
+{
+  buffer.put_uint32(mPatterns.size());
+  for (PatternList::const_iterator it = mPatterns.begin(); it != mPatterns.end(); ++it) {
+    buffer.put_uint32((*it)->get_id());
+    (*it)->pack_state(buffer);
+  }
+  mStatistics->packState(buffer);
+}
+
+
+/**
+ *  @brief Restores the local analysis results from a buffer.
+ *
+ *  Unpacks the state previously stored by packState() from the given
+ *  @a buffer. The task has to be executed beforehand (usually with the
+ *  replay being skipped), so that the pattern objects are available.
+ *
+ *  @param  buffer  Buffer to retrieve the state from
+ *
+ *  @throw  pearl::RuntimeError  if the stored patterns do not match
+ **/
+void AnalyzeTask::unpackState(Buffer& buffer)
+{
+  const GlobalDefs& defs = *mSharedData.mDefinitions;
+
+  if (buffer.get_uint32() != mPatterns.size())
+    throw RuntimeError("Checkpoint data does not match analysis settings.");
+  for (PatternList::iterator it = mPatterns.begin(); it != mPatterns.end(); ++it) {
+    if (buffer.get_uint32() != static_cast<uint32_t>((*it)->get_id()))
+      throw RuntimeError("Checkpoint data does not match analysis settings.");
+    (*it)->unpack_state(buffer, defs);
+  }
+  mStatistics->unpackState(buffer);
+}
+
+
 //--- Retrieve report data --------------------------------------------------
 
 /**
@@ -234,6 +339,8 @@ void AnalyzeTask::genCubeMetrics(ReportData& data) const
  *
  *  Generates the severity section of the CUBE report for all patterns. The
  *  actual collation and writing is done by the individual pattern classes.
+ *  The severities of the hardware counter patterns are determined from the
+ *  local metric table beforehand.
  *
  *  @param  data   Temporary data used for report writing
  *  @param  rank   Global process rank (MPI rank or 0)
@@ -241,6 +348,8 @@ void AnalyzeTask::genCubeMetrics(ReportData& data) const
 void AnalyzeTask::genCubeSeverities(ReportData& data,
                                     int         rank) const
 {
+  CollectCounterSeverities(*mPrivateData.mTrace, mCounterPatterns);
+
   for (PatternList::const_iterator it = mPatterns.begin(); it != mPatterns.end(); ++it)
     if (!(*it)->is_hidden() || (*it)->get_name() == "STATISTICS")
       (*it)->gen_severities(data, rank, *mPrivateData.mTrace);
@@ -254,7 +363,10 @@ void AnalyzeTask::genCubeSeverities(ReportData& data,
  *
  *  The prepare() callback method is called before execution of the subtasks
  *  starts. In case of an analyze task, the sub-tasks are created, initialized
- *  and added to the analysis task.
+ *  and added to the analysis task. In profile-only mode, a single ProfileTask
+ *  replaces the replay tasks and only the patterns it is able to compute are
+ *  included in the report. If the replay is skipped, only the patterns are
+ *  created.
  *
  *  @return @em true if all sub-tasks could be initialized, @em false otherwise
  **/
@@ -286,22 +398,44 @@ bool AnalyzeTask::prepare()
     { 0, 0, AnalysisReplayTask::forward },
   };
 
+  // --- Check whether the profile-only analysis can be used
+
+  const GlobalDefs& defs        = *mSharedData.mDefinitions;
+  const bool        profileOnly = enableProfileOnly
+                                  && ProfileTask::isSupported(defs);
+
+  if (enableProfileOnly && !profileOnly)
+    LogMsg(0, "\nProfile-only analysis not supported for traces with tasks or"
+              " threads,\nusing regular analysis instead.\n");
+
   // --- Setup callback manager map
 
-  for (const struct replay* r = full_replays; r->name; ++r)
-    mCallbackManagers[r->name] = new CallbackManager;
+  for (const struct replay* r = full_replays; r->name; ++r) {
+    CallbackManager* cbmanager = new CallbackManager;
+    if (mPrivateData.mSelfProfile)
+      cbmanager->enable_profiling();
+    mCallbackManagers[r->name] = cbmanager;
+  }
+  mCallbackData.mSelfProfile = mPrivateData.mSelfProfile;
 
   // --- Create pattern-orthogonal callback handlers. Note: the order is important!
 
-  mHandlers.push_back(new ReplayControlHandler);
+  if (!profileOnly) {
+    mHandlers.push_back(new ReplayControlHandler);
 
 #ifdef _MPI
+    if (enableThreadMultiple) {
+      // MPI communication is handled by each thread for its location
+      mHandlers.push_back(new MpiCommunicationHandler(true));
+    } else {
 #pragma omp master
-  {
-    // MPI communication is only handled on the master thread
-    mHandlers.push_back(new MpiCommunicationHandler);
-  }
+      {
+        // MPI communication is only handled on the master thread
+        mHandlers.push_back(new MpiCommunicationHandler);
+      }
+    }
 #endif
+  }
 #ifdef _OPENMP
   mCallbackData.mOmpEventHandler = new OmpEventHandler;
   mHandlers.push_back(mCallbackData.mOmpEventHandler);
@@ -320,17 +454,77 @@ bool AnalyzeTask::prepare()
   // --- Register patterns and handlers
 
   // Register pre-pattern callbacks
-  for (HandlerList::iterator it = mHandlers.begin(); it != mHandlers.end(); ++it)
+  for (HandlerList::iterator it = mHandlers.begin(); it != mHandlers.end(); ++it) {
+      setProfileLabel((*it)->get_name());
       (*it)->register_pre_pattern_callbacks(mCallbackManagers);
+  }
 
   // Register pattern callbacks  
   create_patterns(this);
 
+  // Create report metrics for the hardware counters recorded in the trace,
+  // using pattern IDs following the ones of the generated patterns
+  long nextId = 0;
+  for (PatternList::iterator it = mPatterns.begin(); it != mPatterns.end(); ++it)
+    nextId = max(nextId, (*it)->get_id() + 1);
+  for (uint32_t id = 0; id < defs.num_metrics(); ++id) {
+    CounterPattern* pattern = new CounterPattern(nextId++, *defs.get_metric(id));
+
+    addPattern(pattern);
+    mCounterPatterns.push_back(pattern);
+  }
+
+  // --- Setup profile task
+
+  if (profileOnly) {
+    // Patterns requiring a replay are excluded from the report, but have to
+    // be retained as the fused callback kernels refer to them
+    PatternList reported;
+    for (PatternList::iterator it = mPatterns.begin(); it != mPatterns.end(); ++it) {
+      if (ProfileTask::isProfilePattern((*it)->get_id())
+          || (find(mCounterPatterns.begin(), mCounterPatterns.end(), *it)
+              != mCounterPatterns.end()))
+        reported.push_back(*it);
+      else
+        mUnreportedPatterns.push_back(*it);
+    }
+    mPatterns.swap(reported);
+
+    // No replay tasks take ownership of the callback managers
+    for (CallbackManagerMap::iterator it = mCallbackManagers.begin(); it != mCallbackManagers.end(); ++it)
+      delete it->second;
+    mCallbackManagers.clear();
+
+    if (mSkipReplay)
+      return true;
+
+    ProfileTask* task = new ProfileTask(defs,
+                                        *mPrivateData.mTrace,
+                                        mPatterns,
+                                        mCallbackData.mOmpEventHandler);
+    TimedPhase* phase = TimedPhase::make_timed(task, "\n  Profile computation            ", 1, true);
+    phase->set_profile(mPrivateData.mSelfProfile);
+    add_task(phase);
+
+    return true;
+  }
+
+  if (mSkipReplay) {
+    for (CallbackManagerMap::iterator it = mCallbackManagers.begin(); it != mCallbackManagers.end(); ++it)
+      delete it->second;
+    mCallbackManagers.clear();
+
+    return true;
+  }
+
+  setProfileLabel("StatisticsTask");
   mStatistics->registerAnalysisCallbacks(mCallbackManagers);
 
   // Register post-pattern callbacks
-  for (HandlerList::iterator it = mHandlers.begin(); it != mHandlers.end(); ++it)
+  for (HandlerList::iterator it = mHandlers.begin(); it != mHandlers.end(); ++it) {
+      setProfileLabel((*it)->get_name());
       (*it)->register_post_pattern_callbacks(mCallbackManagers);
+  }
 
   // --- Setup replay tasks
 
@@ -346,11 +540,13 @@ bool AnalyzeTask::prepare()
     assert(cbmgrIt != mCallbackManagers.end());
 
     AnalysisReplayTask* rpltask =
-      new AnalysisReplayTask(this, cbmgrIt->second, r->direction, PREPARE, FINISHED);
+      new AnalysisReplayTask(this, cbmgrIt->second, r->direction, PREPARE, FINISHED, r->descr);
 
     assert(rpltask != 0);
 
-    add_task(TimedPhase::make_timed(rpltask, r->descr, 1, true));
+    TimedPhase* phase = TimedPhase::make_timed(rpltask, r->descr, 1, true);
+    phase->set_profile(mPrivateData.mSelfProfile);
+    add_task(phase);
   }
 
   return true;
@@ -372,6 +568,7 @@ bool AnalyzeTask::finish()
   mCallbackData.mSynchpointHandler = 0;
   mCallbackData.mTmapCacheHandler  = 0;
   mCallbackData.mOmpEventHandler   = 0;
+  mCallbackData.mSelfProfile       = 0;
 
   for (HandlerList::iterator it = mHandlers.begin(); it != mHandlers.end(); ++it)
     delete *it;
@@ -380,3 +577,23 @@ bool AnalyzeTask::finish()
 
   return true;
 }
+
+
+//--- Internal methods ------------------------------------------------------
+
+/**
+ *  @brief Sets the self-profiling label of subsequently registered callbacks.
+ *
+ *  Assigns the given @a label to all callbacks registered afterwards with
+ *  any of the callback managers, if self-profiling is enabled.
+ *
+ *  @param  label  Callback label (e.g., the name of the registering object)
+ **/
+void AnalyzeTask::setProfileLabel(const std::string& label)
+{
+  if (!mPrivateData.mSelfProfile)
+    return;
+
+  for (CallbackManagerMap::iterator it = mCallbackManagers.begin(); it != mCallbackManagers.end(); ++it)
+    (it->second)->set_profile_label(label);
+}
@@ -18,6 +18,9 @@
 #define SCOUT_ANALYZETASK_H
 
 
+#include <string>
+
+#include <pearl/Callback.h>
 #include <pearl/CompoundTask.h>
 
 #include "CbData.h"
@@ -34,6 +37,16 @@
 /*-------------------------------------------------------------------------*/
 
 
+//--- Forward declarations --------------------------------------------------
+
+namespace pearl
+{
+
+class Buffer;
+
+}   // namespace pearl
+
+
 namespace scout
 {
 
@@ -41,6 +54,7 @@ namespace scout
 
 
 class  AnalysisHandler;
+class  CounterPattern;
 class  Pattern;
 class  StatisticsTask;
 
@@ -78,6 +92,9 @@ class AnalyzeTask : public pearl::CompoundTask
     /// @{
 
     void addPattern(Pattern* pattern);
+    void addCallback(const std::string&  replay,
+                     pearl::event_t      event,
+                     pearl::CallbackPtr  callback);
 
     /// @}
     /// @name Register statistics task
@@ -85,6 +102,14 @@ class AnalyzeTask : public pearl::CompoundTask
 
     void register_statistics_cbs(StatisticsTask* sttask);
 
+    /// @}
+    /// @name Checkpointing
+    /// @{
+
+    void skipReplay();
+    void packState(pearl::Buffer& buffer) const;
+    void unpackState(pearl::Buffer& buffer);
+
     /// @}
     /// @name Retrieve report data
     /// @{
@@ -126,12 +151,30 @@ class AnalyzeTask : public pearl::CompoundTask
     /// List of Patterns
     PatternList           mPatterns;
 
+    /// Patterns excluded from the report in profile-only mode
+    PatternList           mUnreportedPatterns;
+
+    /// Hardware counter patterns indexed by metric ID (also in mPatterns)
+    std::vector<CounterPattern*> mCounterPatterns;
+
     /// List of Handlers
     HandlerList           mHandlers;
 
     /// Pointer to the statistics task object
     StatisticsTask*       mStatistics;
 
+    /// Denotes whether the replay is skipped as the analysis results are
+    /// restored from a checkpoint
+    bool                  mSkipReplay;
+
+
+    /// @name Internal methods
+    /// @{
+
+    void setProfileLabel(const std::string& label);
+
+    /// @}
+
   // 
   friend class AnalysisReplayTask;
 };
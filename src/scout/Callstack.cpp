@@ -38,9 +38,19 @@ using namespace scout;
 
 
 Callstack::Callstack()
-         : mUpdateCallstack(true),
-           mCurrentTaskBlockId(( static_cast<uint64_t>(PEARL_GetThreadNumber()) << 32))
+         : mTasks(1),
+           mCurrentTask(&mTasks[0]),
+           mImplicitTaskId(( static_cast<uint64_t>(PEARL_GetThreadNumber()) << 32)),
+           mCurrentTaskBlockId(mImplicitTaskId),
+           mOrigin(NULL),
+           mUpdateCallstack(true)
 {
+  mTaskSlots[mImplicitTaskId] = 0;
+  mCurrentTask->mStartTime          = 0;
+  mCurrentTask->mSwitchOutTime      = 0;
+  mCurrentTask->mTotalOutOfTaskTime = 0;
+  mCurrentTask->mStubNodeCallpathId = 0;
+  mCurrentTask->mStarted            = false;
 }
 
 
@@ -54,18 +64,21 @@ void Callstack::update(const Event& event)
         pop();
 	
       } else if (event->isOfType(THREAD_TEAM_BEGIN)) {
-          mStartTime[mCurrentTaskBlockId] = event->getTimestamp();
+          mCurrentTask->mStartTime = event->getTimestamp();
+          mCurrentTask->mStarted   = true;
 
-          mTotalOutOfTaskTime[mCurrentTaskBlockId] = 0;
-          mSwitchOutTime[mCurrentTaskBlockId]      = 0;
+          mCurrentTask->mTotalOutOfTaskTime = 0;
+          mCurrentTask->mSwitchOutTime      = 0;
         
       } else if (event->isOfType(THREAD_TASK_SWITCH)) {
         // task handling
         ThreadTaskSwitch_rep& taskSwitch = event_cast<ThreadTaskSwitch_rep>(*event);
         uint64_t switchToTaskId = taskSwitch.getTaskId();
+
+        TaskState* switchToTask = acquireTask(switchToTaskId);
             
         // only if this is the first time we switch to this new task
-        if (mStartTime.count(switchToTaskId) == 0)   
+        if (!switchToTask->mStarted)
         {
           // select the region for the stub node from the begining of the
           // chosen task region
@@ -88,7 +101,7 @@ void Callstack::update(const Event& event)
           const Region& nextTaskRegion = enter.getRegion();
         
           // stub node handling only on the implicit task 0
-          if (mCurrentTaskBlockId == ( static_cast<uint64_t>(PEARL_GetThreadNumber()) << 32))
+          if (mCurrentTaskBlockId == mImplicitTaskId)
           {
             Event eOrigin = event.prev();
             if (!eOrigin->isOfType(THREAD_TASK_COMPLETE))
@@ -105,51 +118,49 @@ void Callstack::update(const Event& event)
             if (mOrigin->getChild(i).getRegion() == nextTaskRegion)
             {
               // store the ID for use in the patterns to generate the time and visits
-              mStubNodeCallpathIds[switchToTaskId] = mOrigin->getChild(i).getId();
+              switchToTask->mStubNodeCallpathId = mOrigin->getChild(i).getId();
               break;
             }
           }
               
         }
         // store the time you left the current task 
-        mSwitchOutTime[mCurrentTaskBlockId] = event->getTimestamp();
+        mCurrentTask->mSwitchOutTime = event->getTimestamp();
 
         // switch to new task id
         mCurrentTaskBlockId = switchToTaskId;
+        mCurrentTask        = switchToTask;
         
-        if (mStacks[mCurrentTaskBlockId].empty())
+        if (mCurrentTask->mStack.empty())
         {  
           // first time on this task
           // first task switch time, needed later for total task time calculation
-          mStartTime[mCurrentTaskBlockId] = event->getTimestamp();
+          mCurrentTask->mStartTime = event->getTimestamp();
+          mCurrentTask->mStarted   = true;
 
-          mTotalOutOfTaskTime[mCurrentTaskBlockId] = 0;
-          mSwitchOutTime[mCurrentTaskBlockId]      = 0;
+          mCurrentTask->mTotalOutOfTaskTime = 0;
+          mCurrentTask->mSwitchOutTime      = 0;
         }
         else  // aka been there before and there is a usable reference time stored
         {
           // calc last switch out time
-          double currentOutTime = event->getTimestamp() - mSwitchOutTime[mCurrentTaskBlockId];
+          double currentOutTime = event->getTimestamp() - mCurrentTask->mSwitchOutTime;
           // add this to every element on this stack
-          for (std::vector<double>::iterator it = mOutOfTaskTimes[mCurrentTaskBlockId].begin();
-                   it != mOutOfTaskTimes[mCurrentTaskBlockId].end(); ++it)
+          for (std::vector<double>::iterator it = mCurrentTask->mOutOfTaskTimes.begin();
+                   it != mCurrentTask->mOutOfTaskTimes.end(); ++it)
                   *it += currentOutTime;
               
               // for stubnode correction also the total sum
-              mTotalOutOfTaskTime[mCurrentTaskBlockId] += currentOutTime;
+              mCurrentTask->mTotalOutOfTaskTime += currentOutTime;
         }
       } else if (event->isOfType(THREAD_TASK_COMPLETE)) {
         // switch to the implicit task 0 and clean up 
-        mCurrentTaskBlockId = ( static_cast<uint64_t>(PEARL_GetThreadNumber()) << 32); 
+        mCurrentTaskBlockId = mImplicitTaskId;
+        mCurrentTask        = &mTasks[0];
 
-        // remove the unneeded slots connected to this task
+        // recycle the slot connected to this task
         ThreadTaskComplete_rep& taskComplete = event_cast<ThreadTaskComplete_rep>(*event);
-        uint64_t eventId = taskComplete.getTaskId();
-        mStacks.erase(eventId);
-        mOutOfTaskTimes.erase(eventId);
-        mTotalOutOfTaskTime.erase(eventId);
-        mStartTime.erase(eventId);
-        mSwitchOutTime.erase(eventId);
+        releaseTask(taskComplete.getTaskId());
       }
   }
 }
@@ -157,34 +168,34 @@ void Callstack::update(const Event& event)
  
 Event Callstack::top()
 {
-   assert(mStacks[mCurrentTaskBlockId].top()->isOfType(GROUP_ENTER));
+   assert(mCurrentTask->mStack.back()->isOfType(GROUP_ENTER));
    // return the top ENTER element from the current stack
-   return mStacks[mCurrentTaskBlockId].top();
+   return mCurrentTask->mStack.back();
 }
 
 
 void Callstack::push(const pearl::Event& event)
 {
   // push event on current stack
-  mStacks[mCurrentTaskBlockId].push(event);
+  mCurrentTask->mStack.push_back(event);
   // initialize the offset with 0
-  mOutOfTaskTimes[mCurrentTaskBlockId].push_back(0);
+  mCurrentTask->mOutOfTaskTimes.push_back(0);
 }
 
 
 void Callstack::pop()
 {
-   assert(mStacks[mCurrentTaskBlockId].top()->isOfType(GROUP_ENTER));
+   assert(mCurrentTask->mStack.back()->isOfType(GROUP_ENTER));
    // remove the top element from the current stack
-   mStacks[mCurrentTaskBlockId].pop();
-   mOutOfTaskTimes[mCurrentTaskBlockId].pop_back();
+   mCurrentTask->mStack.pop_back();
+   mCurrentTask->mOutOfTaskTimes.pop_back();
    
 }
 
 
 uint32_t Callstack::getStubNodeId()
 {
-   return mStubNodeCallpathIds[mCurrentTaskBlockId];
+   return mCurrentTask->mStubNodeCallpathId;
 }  
 
 
@@ -196,19 +207,63 @@ void Callstack::setUpdate(bool update)
 
 double Callstack::getCurrentTimeOffset()
 {
-  if (mOutOfTaskTimes[mCurrentTaskBlockId].size() == 0)
+  if (mCurrentTask->mOutOfTaskTimes.size() == 0)
    return 0;
-  return mOutOfTaskTimes[mCurrentTaskBlockId].back();
+  return mCurrentTask->mOutOfTaskTimes.back();
 }  
 
 
 double Callstack::getTotalTimeOffset()
 {
-  return mTotalOutOfTaskTime[mCurrentTaskBlockId];
+  return mCurrentTask->mTotalOutOfTaskTime;
 }  
 
 
 double Callstack::getStartTime()
 {
-   return mStartTime[mCurrentTaskBlockId];
-}  
+   return mCurrentTask->mStartTime;
+}
+
+
+Callstack::TaskState* Callstack::acquireTask(uint64_t taskId)
+{
+  map<uint64_t, uint32_t>::iterator it = mTaskSlots.find(taskId);
+  if (it != mTaskSlots.end())
+    return &mTasks[it->second];
+
+  // reuse a slot of a completed task if possible
+  uint32_t slot;
+  if (mFreeSlots.empty()) {
+    slot = mTasks.size();
+    mTasks.push_back(TaskState());
+  } else {
+    slot = mFreeSlots.back();
+    mFreeSlots.pop_back();
+  }
+  mTaskSlots.insert(make_pair(taskId, slot));
+
+  TaskState* task = &mTasks[slot];
+  task->mStartTime          = 0;
+  task->mSwitchOutTime      = 0;
+  task->mTotalOutOfTaskTime = 0;
+  task->mStubNodeCallpathId = 0;
+  task->mStarted            = false;
+
+  return task;
+}
+
+
+void Callstack::releaseTask(uint64_t taskId)
+{
+  map<uint64_t, uint32_t>::iterator it = mTaskSlots.find(taskId);
+  if (it == mTaskSlots.end() || it->second == 0)
+    return;
+
+  // keep the allocated capacity for the next task using this slot
+  TaskState& task = mTasks[it->second];
+  task.mStack.clear();
+  task.mOutOfTaskTimes.clear();
+
+  mFreeSlots.push_back(it->second);
+  mTaskSlots.erase(it);
+}
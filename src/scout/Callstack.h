@@ -18,8 +18,8 @@
 #define SCOUT_CALLSTACK_H
 
 
+#include <deque>
 #include <map>
-#include <stack>
 #include <vector>
 
 #include <pearl/Event.h>
@@ -123,20 +123,53 @@ public:
   /// @}
   
 private:
-    /// task tracking, time correction
-    std::map < uint64_t, std::stack<pearl::Event> > mStacks;
-    std::map < uint64_t, std::vector<double> >      mOutOfTaskTimes;
-    std::map < uint64_t, double >                   mStartTime;
-    std::map < uint64_t, double >                   mSwitchOutTime;
-    
+    /// Bookkeeping data of a single task
+    struct TaskState
+    {
+      /// callstack of the task
+      std::vector<pearl::Event> mStack;
+
+      /// time correction per callstack entry
+      std::vector<double>       mOutOfTaskTimes;
+
+      /// first switch time (valid if mStarted is set)
+      double                    mStartTime;
+
+      /// time of the last switch out of this task
+      double                    mSwitchOutTime;
+
+      /// total time spent outside this task (stub nodes)
+      double                    mTotalOutOfTaskTime;
+
+      /// callpath ID of the task stub node
+      uint32_t                  mStubNodeCallpathId;
+
+      /// flag indicating whether the start time has been recorded
+      bool                      mStarted;
+    };
+
+    /// task registry, time correction
+    ///
+    /// The bookkeeping data of live tasks is kept in dense slots which are
+    /// recycled once a task completes, so that the memory requirements
+    /// depend on the number of concurrently live tasks only. Slot 0 holds
+    /// the implicit task.
+    std::deque<TaskState>                           mTasks;
+    std::vector<uint32_t>                           mFreeSlots;
+    std::map < uint64_t, uint32_t >                 mTaskSlots;
+    TaskState*                                      mCurrentTask;
+
     /// stub nodes
-    std::map < uint64_t, double >                   mTotalOutOfTaskTime;
-    std::map < uint64_t, uint32_t >                 mStubNodeCallpathIds;
+    uint64_t                                        mImplicitTaskId;
     uint64_t                                        mCurrentTaskBlockId;
     pearl::Callpath*                                mOrigin;
 
     /// enable/disable callstack updates
     bool                                            mUpdateCallstack;
+
+    /// task registry handling
+    TaskState* acquireTask(uint64_t taskId);
+    void releaseTask(uint64_t taskId);
 };
 
 }
@@ -62,7 +62,8 @@ CbData::CbData()
       mTrace(NULL),
       mSynchpointHandler(NULL),
       mTmapCacheHandler(NULL),
-      mOmpEventHandler(NULL) 
+      mOmpEventHandler(NULL),
+      mSelfProfile(NULL)
 {
     mCallstack = new Callstack;
   #if defined(_MPI)
@@ -55,6 +55,7 @@ namespace scout
 /*-------------------------------------------------------------------------*/
 
 class OmpEventHandler;
+class SelfProfile;
 class SynchpointHandler;
 class TmapCacheHandler;
 class Callstack;
@@ -107,6 +108,9 @@ struct CbData
     TmapCacheHandler*     mTmapCacheHandler;
     OmpEventHandler*      mOmpEventHandler;
 
+    /// Self-profiling data (NULL if disabled)
+    SelfProfile*          mSelfProfile;
+
     /// Container for Information on collective operations
     CollectiveInfo mCollinfo;
 
@@ -0,0 +1,581 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+#include "CheckpointTask.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#if HAVE( PTHREAD )
+  #include <pthread.h>
+#endif   // HAVE( PTHREAD )
+
+#if defined(_MPI)
+  #include <mpi.h>
+#endif   // _MPI
+#if defined(_OPENMP)
+  #include <omp.h>
+#endif   // _OPENMP
+
+#include <pearl/Buffer.h>
+#include <pearl/Error.h>
+#include <pearl/GlobalDefs.h>
+#include <pearl/LocalTrace.h>
+#include <pearl/Location.h>
+#include <pearl/LocationGroup.h>
+
+#include <elg_error.h>
+
+#include "AnalyzeTask.h"
+#include "TaskData.h"
+
+using namespace std;
+using namespace pearl;
+using namespace scout;
+
+
+//--- Constants -------------------------------------------------------------
+
+namespace
+{
+
+/// Magic number identifying checkpoint files ("SCKP")
+const uint32_t CHECKPOINT_MAGIC = 0x53434b50;
+
+/// Checkpoint file format version
+const uint32_t CHECKPOINT_VERSION = 1;
+
+/// Size of the checkpoint file header in bytes (incl. byte-order marker)
+const size_t CHECKPOINT_HEADER_SIZE = 1 + 2 * sizeof(uint32_t)
+                                      + 3 * sizeof(uint64_t);
+
+/// Offset of the file size entry in the checkpoint file header
+const size_t CHECKPOINT_SIZE_OFFSET = CHECKPOINT_HEADER_SIZE
+                                      - sizeof(uint64_t);
+
+}   // unnamed namespace
+
+
+//--- Local helper classes --------------------------------------------------
+
+namespace
+{
+
+/// @brief Checkpoint file header
+///
+/// Header information stored at the beginning of each checkpoint file.
+///
+struct CheckpointHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint64_t stamp;
+  uint64_t location;
+  uint64_t size;
+};
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class CheckpointBuffer
+ *  @brief Memory buffer with raw access to the serialized data.
+ *
+ *  The CheckpointBuffer class extends the generic Buffer class to allow
+ *  reading and writing the serialized data from/to a file descriptor, and
+ *  to store the total data size in the checkpoint file header.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class CheckpointBuffer
+  : public Buffer
+{
+  public:
+    CheckpointBuffer()
+      : Buffer(64 * 1024)
+    {
+    }
+
+    void writeHeader(uint64_t stamp, uint64_t location)
+    {
+      put_uint32(CHECKPOINT_MAGIC);
+      put_uint32(CHECKPOINT_VERSION);
+      put_uint64(stamp);
+      put_uint64(location);
+      put_uint64(0);
+    }
+
+    bool readHeader(CheckpointHeader& header)
+    {
+      if (m_size < CHECKPOINT_HEADER_SIZE)
+        return false;
+
+      header.magic    = get_uint32();
+      header.version  = get_uint32();
+      header.stamp    = get_uint64();
+      header.location = get_uint64();
+      header.size     = get_uint64();
+
+      return true;
+    }
+
+    void finalize()
+    {
+      // The size is stored in native byte order, which is also the one
+      // recorded by the byte-order marker
+      const uint64_t size = m_size;
+      memcpy(m_data + CHECKPOINT_SIZE_OFFSET, &size, sizeof(size));
+    }
+
+    bool read(int fd, size_t nbytes)
+    {
+      m_size     = 0;
+      m_position = 1;
+      reserve(nbytes);
+
+      while (m_size < nbytes) {
+        ssize_t count = ::read(fd, m_data + m_size, nbytes - m_size);
+        if (count < 0) {
+          if (errno == EINTR)
+            continue;
+          return false;
+        }
+        if (count == 0)
+          return false;
+        m_size += count;
+      }
+
+      return true;
+    }
+
+    bool write(int fd) const
+    {
+      const uint8_t* data   = m_data;
+      size_t         nbytes = m_size;
+      while (nbytes > 0) {
+        ssize_t count = ::write(fd, data, nbytes);
+        if (count < 0) {
+          if (errno == EINTR)
+            continue;
+          return false;
+        }
+        data   += count;
+        nbytes -= count;
+      }
+
+      return true;
+    }
+
+    bool atEnd() const
+    {
+      return (m_position == m_size);
+    }
+};
+
+}   // unnamed namespace
+
+
+//--- Local helper functions ------------------------------------------------
+
+namespace
+{
+
+/**
+ *  @brief Determines the location handled by the calling thread.
+ *
+ *  @param  defs  Global definitions object
+ *  @return Location of the calling thread
+ **/
+const Location& GetLocation(const GlobalDefs& defs)
+{
+  // Determine thread ID
+  int tid = 0;
+  #if defined(_OPENMP)
+    tid = omp_get_thread_num();
+  #endif   // _OPENMP
+
+  // Determine process rank
+  int rank = 0;
+  #if defined(_MPI)
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  #endif   // _MPI
+
+  return defs.getLocationGroup(rank).getLocation(tid);
+}
+
+
+/**
+ *  @brief Determines the name of the checkpoint file for a given location.
+ *
+ *  @param  directory  Checkpoint directory
+ *  @param  location   Location
+ *  @return Checkpoint file name
+ **/
+string GetCheckpointFilename(const string& directory, const Location& location)
+{
+  ostringstream filename;
+  filename << directory << "/" << location.getId() << ".ckpt";
+
+  return filename.str();
+}
+
+
+/**
+ *  @brief Reads a checkpoint file.
+ *
+ *  Reads the contents of the checkpoint file @a filename into @a buffer and
+ *  validates its header against the given @a stamp and @a location. If
+ *  @a headerOnly is set, only the header is read.
+ *
+ *  @param  filename    Checkpoint file name
+ *  @param  buffer      Buffer receiving the file contents
+ *  @param  stamp       Validation stamp
+ *  @param  location    Location
+ *  @param  headerOnly  Whether only the header should be read
+ *  @return Returns true if the checkpoint file is valid, false otherwise
+ **/
+bool ReadCheckpointFile(const string&     filename,
+                        CheckpointBuffer& buffer,
+                        uint64_t          stamp,
+                        const Location&   location,
+                        bool              headerOnly)
+{
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat      info;
+  CheckpointHeader header;
+  bool             valid = (fstat(fd, &info) == 0)
+                           && (static_cast<size_t>(info.st_size)
+                               >= CHECKPOINT_HEADER_SIZE)
+                           && buffer.read(fd, headerOnly
+                                              ? CHECKPOINT_HEADER_SIZE
+                                              : info.st_size)
+                           && buffer.readHeader(header)
+                           && (header.magic == CHECKPOINT_MAGIC)
+                           && (header.version == CHECKPOINT_VERSION)
+                           && (header.stamp == stamp)
+                           && (header.location == location.getId())
+                           && (header.size
+                               == static_cast<uint64_t>(info.st_size));
+  ::close(fd);
+
+  return valid;
+}
+
+
+/**
+ *  @brief Writes a checkpoint file.
+ *
+ *  Writes the contents of @a buffer to a temporary file which is renamed to
+ *  @a filename once all data has been written successfully. Thus, a
+ *  checkpoint file is never observed in an incomplete state.
+ *
+ *  @param  filename  Checkpoint file name
+ *  @param  buffer    Buffer holding the serialized data
+ *  @return Returns true if successful, false otherwise
+ **/
+bool WriteCheckpointFile(const string&           filename,
+                         const CheckpointBuffer& buffer)
+{
+  const string tmpname = filename + ".tmp";
+
+  int fd = ::open(tmpname.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+    return false;
+
+  bool success = buffer.write(fd) && (fsync(fd) == 0);
+  success = (::close(fd) == 0) && success;
+  success = success && (rename(tmpname.c_str(), filename.c_str()) == 0);
+  if (!success)
+    unlink(tmpname.c_str());
+
+  return success;
+}
+
+}   // unnamed namespace
+
+
+//---------------------------------------------------------------------------
+//
+//  class ReadCheckpointTask
+//
+//---------------------------------------------------------------------------
+
+//--- Constructors & destructor ---------------------------------------------
+
+/**
+ *  @brief Constructor. Creates a new ReadCheckpointTask instance.
+ *
+ *  This constructor creates a new task instance for restoring the results
+ *  of the given @a analyzer from the checkpoint in @a directory.
+ *
+ *  @param  privateData  Private task data object
+ *  @param  analyzer     Analyze task whose results are restored
+ *  @param  directory    Checkpoint directory
+ *  @param  stamp        Validation stamp
+ **/
+ReadCheckpointTask::ReadCheckpointTask(const TaskDataPrivate& privateData,
+                                       AnalyzeTask&           analyzer,
+                                       const string&          directory,
+                                       uint64_t               stamp)
+  : Task(),
+    mPrivateData(privateData),
+    mAnalyzer(analyzer),
+    mDirectory(directory),
+    mStamp(stamp)
+{
+}
+
+
+//--- Execution control -----------------------------------------------------
+
+/**
+ *  @brief Executes the task.
+ *
+ *  Reads the checkpoint file of the calling thread's location and restores
+ *  the analysis results.
+ *
+ *  @return Returns true if successful, false otherwise.
+ *  @throw  pearl::RuntimeError  if the checkpoint data is inconsistent
+ **/
+bool ReadCheckpointTask::execute()
+{
+  const Location& location = mPrivateData.mTrace->get_location();
+  const string    filename = GetCheckpointFilename(mDirectory, location);
+
+  CheckpointBuffer buffer;
+  if (!ReadCheckpointFile(filename, buffer, mStamp, location, false))
+    throw RuntimeError("Cannot read checkpoint file \"" + filename + "\".");
+
+  mAnalyzer.unpackState(buffer);
+  if (!buffer.atEnd())
+    throw RuntimeError("Checkpoint file \"" + filename + "\" is corrupted.");
+
+  return true;
+}
+
+
+//---------------------------------------------------------------------------
+//
+//  class WriteCheckpointTask
+//
+//---------------------------------------------------------------------------
+
+/// @brief Asynchronous checkpoint write request
+///
+/// Holds the serialized analysis results of a location while they are
+/// written to the checkpoint file by a helper thread.
+///
+struct WriteCheckpointTask::WriteRequest
+{
+  /// Serialized analysis results
+  CheckpointBuffer buffer;
+
+  /// Checkpoint file name
+  string filename;
+
+  /// Denotes whether the file has been written successfully
+  bool success;
+
+  #if HAVE( PTHREAD )
+    /// Helper thread writing the file
+    pthread_t thread;
+
+    /// Denotes whether the helper thread was started
+    bool started;
+  #endif   // HAVE( PTHREAD )
+};
+
+
+//--- Constructors & destructor ---------------------------------------------
+
+/**
+ *  @brief Constructor. Creates a new WriteCheckpointTask instance.
+ *
+ *  This constructor creates a new task instance for storing the results of
+ *  the given @a analyzer in the checkpoint @a directory.
+ *
+ *  @param  privateData  Private task data object
+ *  @param  analyzer     Analyze task whose results are stored
+ *  @param  directory    Checkpoint directory
+ *  @param  stamp        Validation stamp
+ **/
+WriteCheckpointTask::WriteCheckpointTask(const TaskDataPrivate& privateData,
+                                         const AnalyzeTask&     analyzer,
+                                         const string&          directory,
+                                         uint64_t               stamp)
+  : Task(),
+    mPrivateData(privateData),
+    mAnalyzer(analyzer),
+    mDirectory(directory),
+    mStamp(stamp),
+    mRequest(NULL)
+{
+}
+
+
+/**
+ *  @brief Destructor.
+ *
+ *  Waits for a pending asynchronous write to complete and reports a warning
+ *  if the checkpoint file could not be written.
+ **/
+WriteCheckpointTask::~WriteCheckpointTask()
+{
+  if (!mRequest)
+    return;
+
+  #if HAVE( PTHREAD )
+    if (mRequest->started)
+      pthread_join(mRequest->thread, NULL);
+  #endif   // HAVE( PTHREAD )
+
+  if (!mRequest->success)
+    elg_warning("SCOUT: Cannot write checkpoint file \"%s\".",
+                mRequest->filename.c_str());
+  delete mRequest;
+}
+
+
+//--- Execution control -----------------------------------------------------
+
+/**
+ *  @brief Executes the task.
+ *
+ *  Serializes the analysis results of the calling thread's location and
+ *  writes them to the checkpoint directory, which is created if necessary.
+ *  The file is written asynchronously if possible, such that it overlaps
+ *  with the subsequent report generation.
+ *
+ *  @return Always returns true.
+ **/
+bool WriteCheckpointTask::execute()
+{
+  if ((mkdir(mDirectory.c_str(), 0755) != 0) && (errno != EEXIST)) {
+    elg_warning("SCOUT: Cannot create checkpoint directory \"%s\".",
+                mDirectory.c_str());
+    return true;
+  }
+
+  const Location& location = mPrivateData.mTrace->get_location();
+
+  mRequest = new WriteRequest;
+  mRequest->filename = GetCheckpointFilename(mDirectory, location);
+  mRequest->success  = false;
+  mRequest->buffer.writeHeader(mStamp, location.getId());
+  mAnalyzer.packState(mRequest->buffer);
+  mRequest->buffer.finalize();
+
+  #if HAVE( PTHREAD )
+    mRequest->started = (pthread_create(&mRequest->thread, NULL,
+                                        writeThread,
+                                        mRequest) == 0);
+    if (mRequest->started)
+      return true;
+  #endif   // HAVE( PTHREAD )
+
+  // Fall back to synchronous write
+  mRequest->success = WriteCheckpointFile(mRequest->filename,
+                                          mRequest->buffer);
+
+  return true;
+}
+
+
+//--- Internal methods (private) --------------------------------------------
+
+/**
+ *  @brief Entry point of the checkpoint writer thread.
+ *
+ *  @param  arg  Pointer to the write request to be processed
+ *  @return Always NULL
+ **/
+void* WriteCheckpointTask::writeThread(void* arg)
+{
+  WriteRequest* request = static_cast<WriteRequest*>(arg);
+
+  request->success = WriteCheckpointFile(request->filename, request->buffer);
+
+  return NULL;
+}
+
+
+//--- Related functions -----------------------------------------------------
+
+/**
+ *  @brief Computes the validation stamp of an analysis checkpoint.
+ *
+ *  Computes a stamp identifying the preprocessed trace data and analysis
+ *  settings the checkpointed results are valid for. It combines the
+ *  validation stamp of the trace cache with a textual description of all
+ *  options affecting the analysis results.
+ *
+ *  @param  cacheStamp  Validation stamp of the trace cache
+ *  @param  settings    Description of the analysis settings
+ *  @return Validation stamp (zero if the trace cache stamp is zero)
+ **/
+uint64_t scout::GetCheckpointStamp(uint64_t      cacheStamp,
+                                   const string& settings)
+{
+  if (cacheStamp == 0)
+    return 0;
+
+  // FNV-1a hash of the stamp components
+  uint64_t stamp = 14695981039346656037ULL;
+  for (int byte = 0; byte < 8; ++byte) {
+    stamp ^= (cacheStamp >> (8 * byte)) & 0xff;
+    stamp *= 1099511628211ULL;
+  }
+  for (string::const_iterator it = settings.begin(); it != settings.end(); ++it) {
+    stamp ^= static_cast<unsigned char>(*it);
+    stamp *= 1099511628211ULL;
+  }
+
+  return stamp;
+}
+
+
+/**
+ *  @brief Checks whether the checkpointed analysis results can be used.
+ *
+ *  Checks whether the checkpoint @a directory holds a complete checkpoint
+ *  file of the calling thread's location which matches the given validation
+ *  @a stamp. As all locations have to agree on resuming from the checkpoint,
+ *  the result needs to be reduced globally (e.g., using CheckGlobalError()).
+ *
+ *  @param  sharedData  Shared task data object
+ *  @param  directory   Checkpoint directory
+ *  @param  stamp       Validation stamp
+ *  @return Returns true if the checkpoint can be used, false otherwise
+ **/
+bool scout::CheckCheckpoint(const TaskDataShared& sharedData,
+                            const string&         directory,
+                            uint64_t              stamp)
+{
+  const Location& location = GetLocation(*sharedData.mDefinitions);
+
+  CheckpointBuffer buffer;
+
+  return ((stamp != 0)
+          && ReadCheckpointFile(GetCheckpointFilename(directory, location),
+                                buffer, stamp, location, true));
+}
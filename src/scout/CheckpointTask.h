@@ -0,0 +1,175 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#ifndef SCOUT_CHECKPOINTTASK_H
+#define SCOUT_CHECKPOINTTASK_H
+
+
+#include <string>
+
+#include <pearl/Task.h>
+#include <pearl/pearl_types.h>
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file  CheckpointTask.h
+ *  @brief Declaration of the ReadCheckpointTask and WriteCheckpointTask
+ *         classes.
+ *
+ *  This header file provides the declaration of the ReadCheckpointTask and
+ *  WriteCheckpointTask classes which are used to restore and store the
+ *  per-location analysis results from/to a checkpoint, as well as related
+ *  helper functions.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+namespace scout
+{
+
+//--- Forward declarations --------------------------------------------------
+
+class AnalyzeTask;
+
+struct TaskDataPrivate;
+struct TaskDataShared;
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class ReadCheckpointTask
+ *  @brief Task restoring the analysis results from a checkpoint.
+ *
+ *  The ReadCheckpointTask class replaces the trace replay by loading the
+ *  analysis results of the calling thread's location (i.e., the pattern
+ *  severities and statistics) written by a previous analysis run. The
+ *  associated analyze task has to be executed beforehand with the replay
+ *  being skipped, such that the pattern objects are available.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class ReadCheckpointTask : public pearl::Task
+{
+  public:
+    /// @name Constructors & destructor
+    /// @{
+
+    ReadCheckpointTask(const TaskDataPrivate& privateData,
+                       AnalyzeTask&           analyzer,
+                       const std::string&     directory,
+                       uint64_t               stamp);
+
+    /// @}
+    /// @name Execution control
+    /// @{
+
+    virtual bool execute();
+
+    /// @}
+
+
+  private:
+    /// Private task data object
+    const TaskDataPrivate& mPrivateData;
+
+    /// Analyze task whose results are restored
+    AnalyzeTask& mAnalyzer;
+
+    /// Checkpoint directory
+    std::string mDirectory;
+
+    /// Validation stamp
+    uint64_t mStamp;
+};
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class WriteCheckpointTask
+ *  @brief Task storing the analysis results in a checkpoint.
+ *
+ *  The WriteCheckpointTask class stores the analysis results of the calling
+ *  thread's location in a checkpoint, so that a subsequent run can skip the
+ *  trace replay if the current one is aborted while writing the report. The
+ *  results are serialized into memory when the task is executed, while the
+ *  file is written asynchronously by a helper thread (if available). The
+ *  destructor waits for its completion. Failures are reported as warnings,
+ *  but do not abort the analysis.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class WriteCheckpointTask : public pearl::Task
+{
+  public:
+    /// @name Constructors & destructor
+    /// @{
+
+    WriteCheckpointTask(const TaskDataPrivate& privateData,
+                        const AnalyzeTask&     analyzer,
+                        const std::string&     directory,
+                        uint64_t               stamp);
+
+    ~WriteCheckpointTask();
+
+    /// @}
+    /// @name Execution control
+    /// @{
+
+    virtual bool execute();
+
+    /// @}
+
+
+  private:
+    struct WriteRequest;
+
+
+    /// Private task data object
+    const TaskDataPrivate& mPrivateData;
+
+    /// Analyze task whose results are stored
+    const AnalyzeTask& mAnalyzer;
+
+    /// Checkpoint directory
+    std::string mDirectory;
+
+    /// Validation stamp
+    uint64_t mStamp;
+
+    /// Pending write request (or NULL)
+    WriteRequest* mRequest;
+
+
+    /// @name Internal methods
+    /// @{
+
+    static void* writeThread(void* arg);
+
+    /// @}
+};
+
+
+//--- Related functions -----------------------------------------------------
+
+uint64_t GetCheckpointStamp(uint64_t           cacheStamp,
+                            const std::string& settings);
+
+bool CheckCheckpoint(const TaskDataShared& sharedData,
+                     const std::string&    directory,
+                     uint64_t              stamp);
+
+
+}   // namespace scout
+
+
+#endif   // !SCOUT_CHECKPOINTTASK_H
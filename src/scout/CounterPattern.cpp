@@ -0,0 +1,209 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+#include "CounterPattern.h"
+
+#include <cassert>
+
+#include <pearl/Event.h>
+#include <pearl/GlobalDefs.h>
+#include <pearl/LocalTrace.h>
+#include <pearl/Metric.h>
+#include <pearl/MetricTable.h>
+
+using namespace std;
+using namespace pearl;
+using namespace scout;
+
+
+//--- Local helper classes --------------------------------------------------
+
+namespace
+{
+
+/// Call stack frame used while collecting the counter severities
+struct CounterFrame
+{
+  /// Call path of the active region
+  Callpath* cnode;
+
+  /// Index of the innermost enclosing frame with counter values (or -1)
+  long valued;
+
+  /// Denotes whether counter values were recorded at ENTER
+  bool hasValues;
+};
+
+}   // unnamed namespace
+
+
+//---------------------------------------------------------------------------
+//
+//  class CounterPattern
+//
+//---------------------------------------------------------------------------
+
+//--- Constructors & destructor ---------------------------------------------
+
+/**
+ *  @brief Constructor. Creates a new counter pattern.
+ *
+ *  Creates a new pattern instance with the given pattern identifier @a id
+ *  representing the hardware counter @a metric.
+ *
+ *  @param  id      Pattern identifier (unique across all patterns)
+ *  @param  metric  Counter metric definition
+ **/
+CounterPattern::CounterPattern(long id, const Metric& metric)
+  : mId(id),
+    mMetric(metric)
+{
+}
+
+
+//--- Retrieving pattern information ----------------------------------------
+
+long CounterPattern::get_id() const
+{
+  return mId;
+}
+
+
+string CounterPattern::get_name() const
+{
+  return mMetric.get_name();
+}
+
+
+string CounterPattern::get_unique_name() const
+{
+  return mMetric.get_name();
+}
+
+
+string CounterPattern::get_descr() const
+{
+  const string descr = mMetric.get_description();
+
+  return descr.empty() ? mMetric.get_name() : descr;
+}
+
+
+string CounterPattern::get_unit() const
+{
+  return "occ";
+}
+
+
+CubeMetricType CounterPattern::get_mode() const
+{
+  return CUBE_METRIC_EXCLUSIVE;
+}
+
+
+/**
+ *  @brief Returns the pattern description URL.
+ *
+ *  Counter metrics are not covered by the pattern documentation, thus no
+ *  URL is provided.
+ *
+ *  @return Empty string
+ **/
+string CounterPattern::get_url() const
+{
+  return "";
+}
+
+
+//--- Related functions -----------------------------------------------------
+
+/**
+ *  @brief Determines the per-callpath counter severities of a local trace.
+ *
+ *  Traverses the local @a trace in a single pass along with its metric table
+ *  and attributes the counter increments between matching ENTER and LEAVE
+ *  events to the corresponding call paths. The increment of a region is
+ *  subtracted from the innermost enclosing region with counter values,
+ *  yielding exclusive values. Regions whose ENTER or LEAVE event carries no
+ *  counter values are skipped, i.e., their increments are attributed to the
+ *  enclosing region. The @a patterns container holds the pattern objects
+ *  indexed by metric ID, with NULL entries for metrics not reported.
+ *
+ *  @param  trace     Local trace data object
+ *  @param  patterns  Counter patterns indexed by metric ID
+ *
+ *  @todo Handle interleaved call stacks of OpenMP tasks
+ **/
+void scout::CollectCounterSeverities(const LocalTrace&              trace,
+                                     const vector<CounterPattern*>& patterns)
+{
+  const MetricTable* table = trace.get_definitions().num_metrics() > 0
+                             ? trace.getMetricTable()
+                             : NULL;
+  if (!table)
+    return;
+
+  const uint32_t numMetrics = table->numMetrics();
+  assert(patterns.size() == numMetrics);
+
+  // The counter values at ENTER are stored in a separate stack for the
+  // frames carrying values
+  vector<CounterFrame> frames;
+  vector<uint64_t>     values;
+  long                 innermost = -1;
+
+  MetricTable::Cursor cursor(*table);
+  bool                valid = cursor.next();
+  for (Event event = trace.begin(); valid && event != trace.end(); ++event) {
+    const bool hasValues = (cursor.getPosition() == event.get_id());
+
+    if (event->isOfType(GROUP_ENTER)) {
+      CounterFrame frame = { event.get_cnode(), innermost, hasValues };
+      if (hasValues) {
+        values.insert(values.end(),
+                      cursor.getValues(), cursor.getValues() + numMetrics);
+        innermost = frames.size();
+      }
+      frames.push_back(frame);
+    }
+    else if (event->isOfType(LEAVE) && !frames.empty()) {
+      const CounterFrame frame = frames.back();
+      frames.pop_back();
+
+      if (frame.hasValues) {
+        const uint64_t* enterValues = &values[values.size() - numMetrics];
+        if (hasValues) {
+          Callpath* parent = (frame.valued >= 0)
+                             ? frames[frame.valued].cnode
+                             : NULL;
+          for (uint32_t metric = 0; metric < numMetrics; ++metric) {
+            CounterPattern* pattern = patterns[metric];
+            if (!pattern)
+              continue;
+
+            const double delta = static_cast<double>(cursor.getValue(metric)
+                                                     - enterValues[metric]);
+            pattern->add_severity(frame.cnode, delta);
+            if (parent)
+              pattern->add_severity(parent, -delta);
+          }
+        }
+        values.resize(values.size() - numMetrics);
+        innermost = frame.valued;
+      }
+    }
+
+    if (hasValues)
+      valid = cursor.next();
+  }
+}
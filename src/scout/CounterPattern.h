@@ -0,0 +1,104 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#ifndef SCOUT_COUNTERPATTERN_H
+#define SCOUT_COUNTERPATTERN_H
+
+
+#include <vector>
+
+#include "Pattern.h"
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file  CounterPattern.h
+ *  @brief Declaration of the CounterPattern class.
+ *
+ *  This header file provides the declaration of the CounterPattern class
+ *  which exposes the hardware counter values recorded in the trace as
+ *  additional metrics in the analysis report, as well as related functions.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+//--- Forward declarations --------------------------------------------------
+
+namespace pearl
+{
+
+class Metric;
+
+}   // namespace pearl
+
+
+namespace scout
+{
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class CounterPattern
+ *  @brief Report metric for a hardware counter recorded in the trace.
+ *
+ *  In contrast to the generated pattern classes, instances of this class
+ *  are created dynamically for each counter metric defined in the trace
+ *  archive. The severity of a call path is the counter increment between
+ *  entering and leaving the corresponding region, excluding the increments
+ *  attributed to its callees. As the values are stored as exclusive metric,
+ *  CUBE provides both the inclusive and exclusive per-callpath values.
+ *  The severities are determined from the per-location metric table using
+ *  CollectCounterSeverities() rather than during the trace replay.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class CounterPattern : public Pattern
+{
+  public:
+    /// @name Constructors & destructor
+    /// @{
+
+    CounterPattern(long id, const pearl::Metric& metric);
+
+    /// @}
+    /// @name Retrieving pattern information
+    /// @{
+
+    virtual long get_id() const;
+    virtual std::string get_name() const;
+    virtual std::string get_unique_name() const;
+    virtual std::string get_descr() const;
+    virtual std::string get_unit() const;
+    virtual CubeMetricType get_mode() const;
+    virtual std::string get_url() const;
+
+    /// @}
+
+
+  private:
+    /// Pattern identifier
+    long mId;
+
+    /// Associated counter metric
+    const pearl::Metric& mMetric;
+};
+
+
+//--- Related functions -----------------------------------------------------
+
+void CollectCounterSeverities(const pearl::LocalTrace&            trace,
+                              const std::vector<CounterPattern*>& patterns);
+
+
+}   // namespace scout
+
+
+#endif   // !SCOUT_COUNTERPATTERN_H
@@ -102,6 +102,9 @@ CalculateWaitMap(const SynchpointInfoMap& s)
 
 
 /// @brief Calulate delay map 
+///
+/// As all timemaps are sorted by call-path ID, the lookups in the wait and
+/// remote maps are performed by a single linear merge pass.
 
 TimeMapSum
 CalculateDelay(const timemap_t& ltmap,
@@ -114,17 +117,23 @@ CalculateDelay(const timemap_t& ltmap,
     m.mSum = 0.0;
 
     timemap_t::const_iterator ltmend = ltmap.end();
+    timemap_t::const_iterator lwmit  = lwmap.begin();
+    timemap_t::const_iterator lwmend = lwmap.end();
+    timemap_t::const_iterator rtmit  = rtmap.begin();
+    timemap_t::const_iterator rtmend = rtmap.end();
 
     for (timemap_t::const_iterator it = ltmap.begin(); it != ltmend; ++it) {
-        timemap_t::const_iterator fit;
+        while (lwmit != lwmend && lwmit->first < it->first)
+            ++lwmit;
+        while (rtmit != rtmend && rtmit->first < it->first)
+            ++rtmit;
 
-        fit       = lwmap.find(it->first);
-        double pw = fit == lwmap.end() ? 0.0 : fit->second;
-        fit       = rtmap.find(it->first);
-        double rt = fit == rtmap.end() ? 0.0 : fit->second;
+        double pw = (lwmit != lwmend && lwmit->first == it->first) ? lwmit->second : 0.0;
+        double rt = (rtmit != rtmend && rtmit->first == it->first) ? rtmit->second : 0.0;
 
         double  d = it->second - pw - rt;
 
+        // Keys are visited in ascending order, i.e., insertion appends
         if (d > 0.0) {
             m.mMap[it->first] = d;
             m.mSum           += d;
@@ -144,13 +153,14 @@ CalculateDiff(const timemap_t& ltmap,
     m.mSum = 0.0;
 
     timemap_t::const_iterator ltmapend = ltmap.end();
+    timemap_t::const_iterator rtmapit  = rtmap.begin();
     timemap_t::const_iterator rtmapend = rtmap.end();
 
     for (timemap_t::const_iterator it = ltmap.begin(); it != ltmapend; ++it) {
-        timemap_t::const_iterator fit;
+        while (rtmapit != rtmapend && rtmapit->first < it->first)
+            ++rtmapit;
 
-        fit       = rtmap.find(it->first);
-        double rt = fit == rtmapend ? 0.0 : fit->second;
+        double rt = (rtmapit != rtmapend && rtmapit->first == it->first) ? rtmapit->second : 0.0;
         double  d = it->second - rt;
 
         if (d > 0.0) {
@@ -166,28 +176,7 @@ TimeMapSum
 CalculateDiff(const TimeMapSum& ltmap,
               const timemap_t&  rtmap)
 {
-    TimeMapSum m;
-
-    m.mMap.clear();
-    m.mSum = 0.0;
-
-    timemap_t::const_iterator ltmapend = ltmap.mMap.end();
-    timemap_t::const_iterator rtmapend = rtmap.end();
-
-    for (timemap_t::const_iterator it = ltmap.mMap.begin(); it != ltmapend; ++it) {
-        timemap_t::const_iterator fit;
-
-        fit       = rtmap.find(it->first);
-        double rt = fit == rtmapend ? 0.0 : fit->second;
-        double  d = it->second - rt;
-
-        if (d > 0.0) {
-            m.mMap[it->first] = d;
-            m.mSum           += d;
-        }
-    }
-
-    return m;
+    return CalculateDiff(ltmap.mMap, rtmap);
 }
 
 void
@@ -197,10 +186,39 @@ AddScaledTimemap(const TimeMapSum& from,
 {
     timemap_t::const_iterator end = from.mMap.end();
 
+    // If the result may exceed the map capacity, the eviction order depends
+    // on the insertion order; stick to element-wise updates in this case
+    if (from.mMap.size() + to.mMap.size() > timemap_t::max_size()) {
+        for (timemap_t::const_iterator it = from.mMap.begin(); it != end; ++it) {
+            to.mMap[it->first] += scale * it->second;
+            to.mSum            += scale * it->second;
+        }
+
+        return;
+    }
+
+    // Otherwise, merge both sorted maps in a single pass
+    timemap_t                 result;
+    timemap_t::const_iterator toit  = to.mMap.begin();
+    timemap_t::const_iterator toend = to.mMap.end();
+
     for (timemap_t::const_iterator it = from.mMap.begin(); it != end; ++it) {
-        to.mMap[it->first] += scale * it->second;
-        to.mSum            += scale * it->second;
+        for ( ; toit != toend && toit->first < it->first; ++toit)
+            result[toit->first] = toit->second;
+
+        double value = 0.0;
+        if (toit != toend && toit->first == it->first) {
+            value = toit->second;
+            ++toit;
+        }
+
+        result[it->first]  = value + scale * it->second;
+        to.mSum           += scale * it->second;
     }
+    for ( ; toit != toend; ++toit)
+        result[toit->first] = toit->second;
+
+    to.mMap = result;
 }
 
 } // namespace scout
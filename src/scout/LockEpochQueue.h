@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2013                                                **
+**  Copyright (c) 1998-2016                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -17,58 +17,159 @@
 #ifndef SCOUT_LOCKEPOCHQUEUE_H
 #define SCOUT_LOCKEPOCHQUEUE_H
 
+#include <algorithm>
 #include <cassert>
-#include <queue>
+#include <cstddef>
+#include <map>
 
-#include <pearl/CountedPtr.h>
 #include <pearl/RemoteEvent.h>
 #include <pearl/RemoteRmaEpoch.h>
+#include <pearl/pearl_types.h>
 
 namespace scout
 {
-typedef pearl::CountedPtr<pearl::RemoteRmaEpoch> RemoteRmaEpochPtr;
-class LockEpochCompare
+/**
+ * @struct LockEpoch
+ * @brief  Remote RMA lock epoch with precomputed sort keys.
+ *
+ * A LockEpoch stores the events of a lock epoch received from an origin
+ * process together with the timestamps of its lock and unlock events and
+ * the type of the lock. The keys are determined once by setKeys() when
+ * the epoch is received, such that ordering epochs does not require to
+ * search the event list.
+ */
+struct LockEpoch
+{
+    /// Timestamp of the MPI_RMA_LOCK event
+    pearl::timestamp_t mLockTime;
+
+    /// Timestamp of the MPI_RMA_UNLOCK event
+    pearl::timestamp_t mUnlockTime;
+
+    /// Flag indicating whether the lock is exclusive
+    bool mExclusive;
+
+    /// Events of the epoch
+    pearl::RemoteRmaEpoch mEvents;
+
+
+    /// Determines the sort keys from the epoch events.
+    void
+    setKeys()
+    {
+        mLockTime   = 0.0;
+        mUnlockTime = 0.0;
+        mExclusive  = false;
+
+        bool hasUnlock = false;
+        for (pearl::RemoteRmaEpoch::const_iterator it = mEvents.begin();
+             it != mEvents.end();
+             ++it) {
+            if ((*it)->isOfType(pearl::MPI_RMA_LOCK)) {
+                mLockTime  = (*it)->getTimestamp();
+                mExclusive = (*it)->is_exclusive();
+            } else if ((*it)->isOfType(pearl::MPI_RMA_UNLOCK)) {
+                mUnlockTime = (*it)->getTimestamp();
+                hasUnlock   = true;
+            }
+        }
+        assert(hasUnlock);
+    }
+
+    /// Exchanges the contents with @a rhs in constant time.
+    void
+    swap(LockEpoch& rhs)
+    {
+        std::swap(mLockTime, rhs.mLockTime);
+        std::swap(mUnlockTime, rhs.mUnlockTime);
+        std::swap(mExclusive, rhs.mExclusive);
+        mEvents.swap(rhs.mEvents);
+    }
+};
+
+
+/**
+ * @class LockEpochQueue
+ * @brief Queue of pending lock epochs ordered by unlock time.
+ *
+ * The LockEpochQueue class stores the pending lock epochs of a window
+ * (with the calling process as the target) ordered by unlock time. It
+ * provides the interface of a priority queue, where top() refers to the
+ * epoch with the latest unlock time. Epochs with equal unlock times are
+ * kept in insertion order. Inserting an epoch takes logarithmic time, and
+ * amortized constant time if it is unlocked last (the common case, as
+ * epochs usually arrive almost in order).
+ */
+class LockEpochQueue
 {
     public:
-        LockEpochCompare(const bool& reverse=false)
+        /// @name Queue interface
+        /// @{
+
+        bool
+        empty() const
+        {
+            return mEpochs.empty();
+        }
+
+        std::size_t
+        size() const
         {
-            mReverse = reverse;
+            return mEpochs.size();
         }
 
+        /// Inserts the given epoch, whose keys have to be set. The epoch
+        /// events are moved into the queue, i.e., @a epoch is left empty.
+        void
+        push(LockEpoch& epoch)
+        {
+            EpochMap::iterator it =
+                mEpochs.insert(mEpochs.end(),
+                               EpochMap::value_type(epoch.mUnlockTime,
+                                                    LockEpoch()));
+            it->second.swap(epoch);
+        }
 
-        bool
-        operator()(const RemoteRmaEpochPtr& lhs,
-                   const RemoteRmaEpochPtr& rhs) const
+        /// Returns the epoch with the latest unlock time.
+        const LockEpoch&
+        top() const
         {
-            // Retrieve Unlock event from first epoch
-            pearl::RemoteRmaEpoch::const_reverse_iterator lhsIt  = lhs->rbegin();
-            pearl::RemoteRmaEpoch::const_reverse_iterator lhsEnd = lhs->rend();
-            while (lhsIt != lhsEnd
-                   && !(*lhsIt)->isOfType(pearl::MPI_RMA_UNLOCK)) {
-                ++lhsIt;
-            }
-            assert(lhsIt != lhsEnd);
-
-            // Retrieve Unlock event from second epoch
-            pearl::RemoteRmaEpoch::const_reverse_iterator rhsIt  = rhs->rbegin();
-            pearl::RemoteRmaEpoch::const_reverse_iterator rhsEnd = rhs->rend();
-            while (rhsIt != rhsEnd
-                   && !(*rhsIt)->isOfType(pearl::MPI_RMA_UNLOCK)) {
-                ++rhsIt;
-            }
-            assert(rhsIt != rhsEnd);
+            assert(!mEpochs.empty());
 
-            return ((*lhsIt)->getTimestamp() < (*rhsIt)->getTimestamp());
+            return mEpochs.rbegin()->second;
         }
 
+        /// Removes the epoch with the latest unlock time.
+        void
+        pop()
+        {
+            assert(!mEpochs.empty());
+            mEpochs.erase(--mEpochs.end());
+        }
+
+        /// Removes the epoch with the latest unlock time and moves it into
+        /// @a epoch.
+        void
+        pop(LockEpoch& epoch)
+        {
+            assert(!mEpochs.empty());
+
+            EpochMap::iterator it = --mEpochs.end();
+            epoch.swap(it->second);
+            mEpochs.erase(it);
+        }
+
+        /// @}
+
 
     private:
-        bool mReverse;
-};
+        /// Container type mapping unlock times to epochs
+        typedef std::multimap<pearl::timestamp_t, LockEpoch> EpochMap;
 
-typedef std::priority_queue<RemoteRmaEpochPtr,
-                            std::vector<RemoteRmaEpochPtr>,
-                            LockEpochCompare> LockEpochQueue;
+
+        /// Pending epochs sorted by unlock time
+        EpochMap mEpochs;
+};
 } // namespace scout
 
 #endif
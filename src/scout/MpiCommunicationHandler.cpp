@@ -21,6 +21,7 @@
 #include "Callstack.h"
 #include "SynchpointHandler.h"
 #include "Roles.h"
+#include "SelfProfile.h"
 #include "scout_types.h"
 #include "user_events.h"
 
@@ -45,6 +46,7 @@
 #include <cassert>
 #include <limits>
 #include <map>
+#include <set>
 #include <vector>
 
 using namespace scout;
@@ -68,11 +70,21 @@ struct MpiCommunicationHandler:: MpiCHImpl
     vector<int>         mIndices;
 
     communicator_map_t  mInvComms;
+    bool                mOwnsInvComms;      ///< Whether inverse communicators are owned
 
     pearl::Event        mInitEnd;
     pearl::Event        mFinalizeEnd;
 
+    bool                mThreadMultiple;    ///< Used by all threads?
+
+    MpiCHImpl(bool threadMultiple)
+        : mOwnsInvComms(true),
+          mThreadMultiple(threadMultiple)
+    { }
+
     ~MpiCHImpl() {
+        if (!mOwnsInvComms)
+            return;
         for (communicator_map_t::iterator it = mInvComms.begin(); it != mInvComms.end(); ++it)
             delete it->second;
     }
@@ -120,12 +132,98 @@ struct MpiCommunicationHandler:: MpiCHImpl
     }
 
 
+    void
+    sendMessage(CbData*          data,
+                const LocalData* local,
+                const MpiComm&   comm,
+                int              dest,
+                int              tag)
+    {
+        MpiMessage* msg = local->isend(comm, dest, tag);
+
+        mPendingMsgs.push_back(msg);
+        mPendingReqs.push_back(msg->get_request());
+
+        if (data->mSelfProfile) {
+            data->mSelfProfile->addSentMessage(msg->size());
+        }
+    }
+
+    void
+    recvMessage(CbData*        data,
+                RemoteData*    remote,
+                const MpiComm& comm,
+                int            source,
+                int            tag)
+    {
+        BlockingTimer timer(data->mSelfProfile);
+
+        remote->recv(*data->mDefs, comm, source, tag);
+
+        if (data->mSelfProfile) {
+            data->mSelfProfile->addReceivedMessage();
+        }
+    }
+
+    /// Synchronizes all processes. In thread-multiple mode, this has to be
+    /// called by all threads of a process, and the MPI barrier is only
+    /// entered after all local threads have arrived.
+    void
+    globalBarrier(CbData* data)
+    {
+        BlockingTimer timer(data->mSelfProfile);
+
+        if (mThreadMultiple) {
+            #pragma omp barrier
+            #pragma omp master
+            {
+                MPI_Barrier(MPI_COMM_WORLD);
+            }
+            #pragma omp barrier
+        } else {
+            MPI_Barrier(MPI_COMM_WORLD);
+        }
+    }
+
+    /// Creates duplicates for inverse communication of all communicators
+    /// whose IDs are given in the sorted list @a lcomms on any process.
+    static void
+    createInvComms(const GlobalDefs&            defs,
+                   const std::vector<uint32_t>& lcomms,
+                   communicator_map_t&          invComms)
+    {
+        std::vector<uint32_t>::const_iterator lcit = lcomms.begin();
+
+        for (uint32_t c = 0; c < defs.numCommunicators(); ++c) {
+            uint32_t lid = (lcit == lcomms.end() ? Communicator::NO_ID : *lcit);
+            uint32_t gid;
+
+            MPI_Allreduce(&lid, &gid, 1, SCALASCA_MPI_UINT32_T, MPI_MIN, MPI_COMM_WORLD);
+
+            // FIXME: This assumes that Communicator::NO_ID is the max element!
+            if (gid == Communicator::NO_ID)
+                break;
+
+            // Create communicator duplicate
+            const MpiComm& comm = static_cast<const MpiComm&>(defs.getCommunicator(gid));
+
+            if (comm.getComm() != MPI_COMM_NULL)
+                invComms[gid] = comm.duplicate();
+
+            if (lcit != lcomms.end() && gid == *lcit)
+                ++lcit;
+        }
+    }
+
+
     //
     // --- main replay callbacks -----------------------------------------
     //
 
     SCOUT_CALLBACK(cb_finished) {
-        MPI_Barrier(MPI_COMM_WORLD);
+        CbData* data = static_cast<CbData*>(cdata);
+
+        globalBarrier(data);
 
         processPendingMsgs();
 
@@ -168,6 +266,9 @@ struct MpiCommunicationHandler:: MpiCHImpl
     }
 
     SCOUT_CALLBACK(cb_pre_init) {
+        CbData*       data = static_cast<CbData*>(cdata);
+        BlockingTimer timer(data->mSelfProfile);
+
         mInitEnd = event.leaveptr();
 
         CollectiveInfo ci;
@@ -190,6 +291,9 @@ struct MpiCommunicationHandler:: MpiCHImpl
     }
 
     SCOUT_CALLBACK(cb_pre_finalize) {
+        CbData*       data = static_cast<CbData*>(cdata);
+        BlockingTimer timer(data->mSelfProfile);
+
         mFinalizeEnd = event.leaveptr();
 
         CollectiveInfo ci;
@@ -234,13 +338,8 @@ struct MpiCommunicationHandler:: MpiCHImpl
 
         // --- transfer message
 
-        MpiComm*    comm = event->getComm();
-        MpiMessage* msg;
-
-        msg = data->mLocal->isend(*comm, event->getDestination(), event->getTag());
-
-        mPendingMsgs.push_back(msg);
-        mPendingReqs.push_back(msg->get_request());
+        MpiComm* comm = event->getComm();
+        sendMessage(data, data->mLocal, *comm, event->getDestination(), event->getTag());
 
         // --- run post-send callbacks
 
@@ -261,7 +360,7 @@ struct MpiCommunicationHandler:: MpiCHImpl
         // --- receive message
 
         MpiComm* comm = event->getComm();
-        data->mRemote->recv(*data->mDefs, *comm, event->getSource(), event->getTag());
+        recvMessage(data, data->mRemote, *comm, event->getSource(), event->getTag());
 
         // --- run post-recv callbacks
 
@@ -329,6 +428,8 @@ struct MpiCommunicationHandler:: MpiCHImpl
         CbData*  data = static_cast<CbData*>(cdata);
         MpiComm* comm = event->getComm();
 
+        BlockingTimer timer(data->mSelfProfile);
+
         CollectiveInfo& ci(data->mCollinfo);
 
         // distribute root enter time
@@ -342,6 +443,8 @@ struct MpiCommunicationHandler:: MpiCHImpl
         CbData*  data = static_cast<CbData*>(cdata);
         MpiComm* comm = event->getComm();
 
+        BlockingTimer timer(data->mSelfProfile);
+
         CollectiveInfo& ci(data->mCollinfo);
 
         // --- root rank and time
@@ -378,6 +481,8 @@ struct MpiCommunicationHandler:: MpiCHImpl
         CbData*  data = static_cast<CbData*>(cdata);
         MpiComm* comm = event->getComm();
 
+        BlockingTimer timer(data->mSelfProfile);
+
         CollectiveInfo& ci(data->mCollinfo);
 
         // get latest begin of ranks 0..n
@@ -389,6 +494,8 @@ struct MpiCommunicationHandler:: MpiCHImpl
         CbData*  data = static_cast<CbData*>(cdata);
         MpiComm* comm = event->getComm();
 
+        BlockingTimer timer(data->mSelfProfile);
+
         CollectiveInfo& ci(data->mCollinfo);
 
         uint64_t bytesSent     = event->getBytesSent();
@@ -418,6 +525,8 @@ struct MpiCommunicationHandler:: MpiCHImpl
         CbData*  data = static_cast<CbData*>(cdata);
         MpiComm* comm = event->getComm();
 
+        BlockingTimer timer(data->mSelfProfile);
+
         CollectiveInfo& ci(data->mCollinfo);
 
         TimeRank trbuf;
@@ -442,6 +551,9 @@ struct MpiCommunicationHandler:: MpiCHImpl
     SCOUT_CALLBACK(cb_progress_barrier) {
         // In p2p-only replays (bws, fws, fwc), add artificial barriers 
         // at collective events to prevent p2p overload
+        CbData*       data = static_cast<CbData*>(cdata);
+        BlockingTimer timer(data->mSelfProfile);
+
         MPI_Barrier(event->getComm()->getComm());
     }
 
@@ -462,7 +574,7 @@ struct MpiCommunicationHandler:: MpiCHImpl
         // --- receive message
 
         MpiComm* comm = event->getComm();
-        data->mRemote->recv(*data->mDefs, *comm, event->getDestination(), event->getTag());
+        recvMessage(data, data->mRemote, *comm, event->getDestination(), event->getTag());
 
         // --- run post-recv callbacks
 
@@ -484,13 +596,8 @@ struct MpiCommunicationHandler:: MpiCHImpl
 
         // --- transfer message
 
-        MpiComm*    comm = event->getComm();
-        MpiMessage* msg;
-
-        msg = data->mLocal->isend(*comm, event->getSource(), event->getTag());
-
-        mPendingMsgs.push_back(msg);
-        mPendingReqs.push_back(msg->get_request());
+        MpiComm* comm = event->getComm();
+        sendMessage(data, data->mLocal, *comm, event->getSource(), event->getTag());
 
         // --- run post-send callbacks
 
@@ -516,13 +623,8 @@ struct MpiCommunicationHandler:: MpiCHImpl
 
         // --- transfer message
 
-        MpiComm*    comm = event->getComm();
-        MpiMessage* msg;
-
-        msg = data->mLocal->isend(*comm, event->getDestination(), event->getTag());
-
-        mPendingMsgs.push_back(msg);
-        mPendingReqs.push_back(msg->get_request());
+        MpiComm* comm = event->getComm();
+        sendMessage(data, data->mLocal, *comm, event->getDestination(), event->getTag());
 
         mInvComms.insert(make_pair(comm->getId(), static_cast<MpiComm*>(0)));
 
@@ -544,7 +646,7 @@ struct MpiCommunicationHandler:: MpiCHImpl
         // --- receive message
 
         MpiComm* comm = event->getComm();
-        data->mRemote->recv(*data->mDefs, *comm, event->getSource(), event->getTag());
+        recvMessage(data, data->mRemote, *comm, event->getSource(), event->getTag());
 
         mInvComms.insert(make_pair(comm->getId(), static_cast<MpiComm*>(0)));
 
@@ -573,10 +675,8 @@ struct MpiCommunicationHandler:: MpiCHImpl
 
         assert(cit != mInvComms.end() && cit->second != 0);
 
-        data->mInvRemote->recv(*data->mDefs,
-                               *(cit->second),
-                               sendevt->getDestination(),
-                               sendevt->getTag());
+        recvMessage(data, data->mInvRemote, *(cit->second),
+                    sendevt->getDestination(), sendevt->getTag());
 
         // --- run post-recv callbacks
 
@@ -608,14 +708,8 @@ struct MpiCommunicationHandler:: MpiCHImpl
 
         assert(cit != mInvComms.end() && cit->second != 0);
 
-        MpiMessage* msg;
-
-        msg = data->mInvLocal->isend(*(cit->second),
-                                     recvevt->getSource(),
-                                     recvevt->getTag());
-
-        mPendingMsgs.push_back(msg);
-        mPendingReqs.push_back(msg->get_request());
+        sendMessage(data, data->mInvLocal, *(cit->second),
+                    recvevt->getSource(), recvevt->getTag());
     }
 
 
@@ -626,6 +720,8 @@ struct MpiCommunicationHandler:: MpiCHImpl
     SCOUT_CALLBACK(cb_bwc_prepare) {
         CbData* data  = static_cast<CbData*>(cdata);
 
+        BlockingTimer timer(data->mSelfProfile);
+
         // --- duplicate communicators for inverse communication
 
         // Find out which communicators were used for p2p
@@ -635,26 +731,46 @@ struct MpiCommunicationHandler:: MpiCHImpl
         for (communicator_map_t::const_iterator it = mInvComms.begin(); it != mInvComms.end(); ++it)
             lcomms.push_back(it->first);
 
-        std::vector<uint32_t>::iterator lcit = lcomms.begin();
+        if (!mThreadMultiple) {
+            createInvComms(*data->mDefs, lcomms, mInvComms);
+            return;
+        }
 
-        for (uint32_t c = 0; c < data->mDefs->numCommunicators(); ++c) {
-            uint32_t lid = (lcit == lcomms.end() ? Communicator::NO_ID : *lcit);
-            uint32_t gid;
+        // In thread-multiple mode, the duplicates are created by the master
+        // thread for all local threads and owned by its handler, as the
+        // required collective operations must not be issued concurrently
 
-            MPI_Allreduce(&lid, &gid, 1, SCALASCA_MPI_UINT32_T, MPI_MIN, MPI_COMM_WORLD);
+        // These variables are implicitly shared!
+        static std::set<uint32_t> usedComms;
+        static communicator_map_t invComms;
 
-            // FIXME: This assumes that Communicator::NO_ID is the max element!
-            if (gid == Communicator::NO_ID)
-                break;
+        #pragma omp critical
+        {
+            usedComms.insert(lcomms.begin(), lcomms.end());
+        }
+        #pragma omp barrier
+        #pragma omp master
+        {
+            createInvComms(*data->mDefs,
+                           std::vector<uint32_t>(usedComms.begin(), usedComms.end()),
+                           invComms);
+            usedComms.clear();
+        }
+        #pragma omp barrier
 
-            // Create communicator duplicate
-            const MpiComm& comm = static_cast<const MpiComm&>(data->mDefs->getCommunicator(gid));
+        for (std::vector<uint32_t>::iterator it = lcomms.begin(); it != lcomms.end(); ++it) {
+            communicator_map_t::const_iterator cit = invComms.find(*it);
 
-            if (comm.getComm() != MPI_COMM_NULL)
-                mInvComms[gid] = comm.duplicate();
+            mInvComms[*it] = (cit != invComms.end()) ? cit->second : 0;
+        }
+        mOwnsInvComms = false;
 
-            if (lcit != lcomms.end() && gid == *lcit)
-                ++lcit;
+        #pragma omp barrier
+        #pragma omp master
+        {
+            mInvComms     = invComms;
+            mOwnsInvComms = true;
+            invComms.clear();
         }
     }
 
@@ -712,14 +828,8 @@ struct MpiCommunicationHandler:: MpiCHImpl
 
         assert(cit != mInvComms.end() && cit->second != 0);
 
-        MpiMessage* msg;
-
-        msg = data->mInvLocal->isend(*(cit->second),
-                                       sendevt->getDestination(),
-                                       sendevt->getTag());
-
-        mPendingMsgs.push_back(msg);
-        mPendingReqs.push_back(msg->get_request());        
+        sendMessage(data, data->mInvLocal, *(cit->second),
+                    sendevt->getDestination(), sendevt->getTag());
     }
 
     SCOUT_CALLBACK(cb_bw_pre_recvreq) {
@@ -743,10 +853,8 @@ struct MpiCommunicationHandler:: MpiCHImpl
 
         assert(cit != mInvComms.end() && cit->second != 0);
 
-        data->mInvRemote->recv(*data->mDefs,
-                               *(cit->second),
-                               recvevt->getSource(),
-                               recvevt->getTag());
+        recvMessage(data, data->mInvRemote, *(cit->second),
+                    recvevt->getSource(), recvevt->getTag());
 
         // --- run post-recv callbacks
 
@@ -939,9 +1047,9 @@ struct MpiCommunicationHandler:: MpiCHImpl
 };
 
 
-MpiCommunicationHandler::MpiCommunicationHandler()
+MpiCommunicationHandler::MpiCommunicationHandler(bool threadMultiple)
     : AnalysisHandler(),
-      mP(new MpiCHImpl)
+      mP(new MpiCHImpl(threadMultiple))
 {
 }
 
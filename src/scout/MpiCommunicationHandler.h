@@ -34,7 +34,15 @@ namespace scout
  * @brief   MPI Communication management callback routines
  * 
  * The MpiCommunicationHandler updates handles collective and point-to-point
- * MPI message exchanges
+ * MPI message exchanges. By default, it is only used on the master thread of
+ * each process. In thread-multiple mode, every analysis thread uses its own
+ * instance to perform the exchanges of its location, and process-wide
+ * synchronization is carried out jointly by all threads. As MPI forbids
+ * concurrent collectives on the same communicator, and messages are only
+ * matched by communicator, peer, and tag, this mode requires the collectives
+ * of each communicator as well as the messages of each such channel to be
+ * issued by a single thread per process. This is verified by CheckTraceData
+ * before the replay.
  */
 // --------------------------------------------------------------------------
 
@@ -46,10 +54,13 @@ class MpiCommunicationHandler : public AnalysisHandler
 
 public:
 
-  MpiCommunicationHandler();
+  explicit MpiCommunicationHandler(bool threadMultiple = false);
 
   ~MpiCommunicationHandler();
 
+  const char* get_name() const
+    { return "MpiCommunicationHandler"; }
+
   virtual void register_pre_pattern_callbacks (const CallbackManagerMap& cbm);
 };
 
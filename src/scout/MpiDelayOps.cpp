@@ -66,7 +66,31 @@ static TimeMapSum GetSynchpointTimes(const Event& from,
 }
 
 
+///@brief Look up the times of a sorted list of call-path IDs in a timemap
+
+static void GatherTimes(const timemap_t&   tmap,
+                        const vector<int>& cpIdVec,
+                        double*            timeVec)
+{
+    timemap_t::const_iterator it  = tmap.begin();
+    timemap_t::const_iterator end = tmap.end();
+
+    for (vector<int>::size_type i = 0; i < cpIdVec.size(); ++i) {
+        const Callpath::IdType id = cpIdVec[i];
+
+        while (it != end && it->first < id)
+            ++it;
+        timeVec[i] = (it != end && it->first == id) ? it->second : 0.0;
+    }
+}
+
+
 ///@brief Transfer data for collective delay calculation
+///
+/// The propagating wait time and the group callpath ID map and times are
+/// broadcast in a single packed message, preceded by its size. Ranks which
+/// synchronized after the group synchpoint receive their propagating wait
+/// time and callpath times in a single point-to-point message.
 
 static void TransferData(const TimeRank&             my,
                          const TimeRank&             root,
@@ -80,8 +104,10 @@ static void TransferData(const TimeRank&             my,
 {
     // --- setup
 
-    vector<int> prevSpVec(comm->getGroup().numRanks(), 0);
-    int         cpVecSize = 0;
+    vector<int>  prevSpVec(comm->getGroup().numRanks(), 0);
+    vector<char> packVec;
+    int          cpVecSize = 0;
+    int          packSize  = 0;
 
     if (my.rank == root.rank) {
         for (map<int, TimeMapSum>::const_iterator it = prevSpTmaps.begin(); it != prevSpTmaps.end(); ++it)
@@ -99,6 +125,29 @@ static void TransferData(const TimeRank&             my,
 
         propWait  = groupTmap.mSum;
         cpVecSize = groupTmap.mMap.size();
+
+        // pack propagating wait time, group callpath IDs and times
+        int size;
+        MPI_Pack_size(1,         MPI_DOUBLE, comm->getComm(), &size);
+        packSize += size;
+        MPI_Pack_size(1,         MPI_INT,    comm->getComm(), &size);
+        packSize += size;
+        MPI_Pack_size(cpVecSize, MPI_INT,    comm->getComm(), &size);
+        packSize += size;
+        MPI_Pack_size(cpVecSize, MPI_DOUBLE, comm->getComm(), &size);
+        packSize += size;
+
+        packVec.resize(packSize);
+
+        int position = 0;
+        MPI_Pack(&propWait, 1, MPI_DOUBLE,
+                 &packVec[0], packSize, &position, comm->getComm());
+        MPI_Pack(&cpVecSize, 1, MPI_INT,
+                 &packVec[0], packSize, &position, comm->getComm());
+        MPI_Pack(cpIdVec.empty() ? 0 : &cpIdVec[0], cpVecSize, MPI_INT,
+                 &packVec[0], packSize, &position, comm->getComm());
+        MPI_Pack(timeVec.empty() ? 0 : &timeVec[0], cpVecSize, MPI_DOUBLE,
+                 &packVec[0], packSize, &position, comm->getComm());
     }
 
     // --- transfer
@@ -107,41 +156,47 @@ static void TransferData(const TimeRank&             my,
     MPI_Scatter(&prevSpVec[0], 1, MPI_INT,
                 &prevSp,       1, MPI_INT, root.rank, comm->getComm());
 
-    // propagating wait time
-    MPI_Bcast(&propWait,  1, MPI_DOUBLE, root.rank, comm->getComm());
-    // group callpath ID map and times
-    MPI_Bcast(&cpVecSize, 1, MPI_INT,    root.rank, comm->getComm());
+    // propagating wait time, group callpath ID map and times
+    MPI_Bcast(&packSize, 1, MPI_INT, root.rank, comm->getComm());
+
+    packVec.resize(packSize);
+    MPI_Bcast(&packVec[0], packSize, MPI_PACKED, root.rank, comm->getComm());
+
+    if (my.rank != root.rank) {
+        int position = 0;
+        MPI_Unpack(&packVec[0], packSize, &position,
+                   &propWait, 1, MPI_DOUBLE, comm->getComm());
+        MPI_Unpack(&packVec[0], packSize, &position,
+                   &cpVecSize, 1, MPI_INT, comm->getComm());
 
-    if (cpIdVec.size() == 0)
         cpIdVec.resize(cpVecSize);
-    if (timeVec.size() == 0)
         timeVec.resize(cpVecSize);
 
-    MPI_Bcast(&cpIdVec[0], cpVecSize, MPI_INT,    root.rank, comm->getComm());
-    MPI_Bcast(&timeVec[0], cpVecSize, MPI_DOUBLE, root.rank, comm->getComm());
+        MPI_Unpack(&packVec[0], packSize, &position,
+                   cpIdVec.empty() ? 0 : &cpIdVec[0], cpVecSize, MPI_INT,
+                   comm->getComm());
+        MPI_Unpack(&packVec[0], packSize, &position,
+                   timeVec.empty() ? 0 : &timeVec[0], cpVecSize, MPI_DOUBLE,
+                   comm->getComm());
+    }
 
     // point-to-point exchange for ranks after group synchpoint
-    if (my.rank == root.rank) {
-        vector<double> vec(cpVecSize);
+    // (propagating wait time followed by callpath times)
+    vector<double> vec(cpVecSize + 1);
 
+    if (my.rank == root.rank) {
         for (map<int, TimeMapSum>::const_iterator it = prevSpTmaps.begin(); it != prevSpTmaps.end(); ++it) {
-            MPI_Send(const_cast<double*>(&(it->second.mSum)), 1, MPI_DOUBLE,
-                     it->first, 0, comm->getComm());
-
-            int i = 0;
-            const timemap_t& gtmap(groupTmap.mMap);
-            for (timemap_t::const_iterator git = gtmap.begin(); git != gtmap.end(); ++git, ++i) {
-                timemap_t::const_iterator pspit = it->second.mMap.find(git->first);
-                vec[i] = (pspit == it->second.mMap.end() ? 0.0 : pspit->second);
-            }
+            vec[0] = it->second.mSum;
+            GatherTimes(it->second.mMap, cpIdVec, &vec[1]);
 
-            MPI_Send(&vec[0], cpVecSize, MPI_DOUBLE, it->first, 0, comm->getComm());
+            MPI_Send(&vec[0], cpVecSize + 1, MPI_DOUBLE, it->first, 0, comm->getComm());
         }
     } else if (prevSp > 0) {
-        MPI_Recv(&propWait,   1,         MPI_DOUBLE, root.rank, 0,
-                 comm->getComm(), MPI_STATUS_IGNORE);
-        MPI_Recv(&timeVec[0], cpVecSize, MPI_DOUBLE, root.rank, 0,
+        MPI_Recv(&vec[0], cpVecSize + 1, MPI_DOUBLE, root.rank, 0,
                  comm->getComm(), MPI_STATUS_IGNORE);
+
+        propWait = vec[0];
+        std::copy(vec.begin() + 1, vec.end(), timeVec.begin());
     }
 }
 
@@ -320,11 +375,13 @@ void CalculateCollectiveDelay(const TimeRank& my,
     double dsum = 0.0;
 
     if (isSynchpoint) {
-        for (vector<int>::size_type i = 0; i < cpVecSize; ++i) {
-            timemap_t::const_iterator fit = localTmap.find(cpIdVec[i]);
+        vector<double> localTimeVec(cpVecSize);
 
-            double lt = (fit == localTmap.end() ? 0.0 : fit->second);
-            double d  = std::max(diffTimeVec[i] - lt, 0.0);
+        if (cpVecSize > 0)
+            GatherTimes(localTmap, cpIdVec, &localTimeVec[0]);
+
+        for (vector<int>::size_type i = 0; i < cpVecSize; ++i) {
+            double d = std::max(diffTimeVec[i] - localTimeVec[i], 0.0);
 
             diffTimeVec[i]  = d;
             dsum           += d;
@@ -338,45 +395,56 @@ void CalculateCollectiveDelay(const TimeRank& my,
     data->mCollDelayInfo.clear();
     data->mInputScales.insert(std::make_pair(KEY_WAITTIME, std::max(root.time - my.time, 0.0)));
 
-    for (map<uint32_t, double>::iterator inpIt = data->mInputScales.begin(); inpIt != data->mInputScales.end(); ++inpIt) {
-        vector<double> timeVec(diffTimeVec);
-        double         scale = dsum;
+    // calculate scaling factors and local delays for all input scales, which
+    // are then reduced in a single operation
+    const map<uint32_t, double>::size_type numScales = data->mInputScales.size();
+
+    vector<double> timeVec(numScales * cpVecSize);
+    vector<double> scaleVec(numScales);
+
+    map<uint32_t, double>::iterator inpIt;
+    map<uint32_t, double>::size_type k;
+
+    for (inpIt = data->mInputScales.begin(), k = 0; inpIt != data->mInputScales.end(); ++inpIt, ++k) {
+        double  scale = dsum;
+        double* times = timeVec.empty() ? 0 : &timeVec[k * cpVecSize];
 
-        // calculate scaling factor and local delays
         if (scale + propWait > 0)
             scale = std::min(inpIt->second / (scale + propWait), 1.0);
-        for (int i = 0; i < cpVecSize; ++i)
-            timeVec[i] *= scale;
+        for (vector<int>::size_type i = 0; i < cpVecSize; ++i)
+            times[i] = scale * diffTimeVec[i];
+
+        scaleVec[k] = scale;
+    }
+
+    const int count  = timeVec.size();
+    double*   buffer = timeVec.empty() ? 0 : &timeVec[0];
 
 #ifndef MVAPICH2_VERSION
-        MPI_Reduce((my.rank == root.rank ? MPI_IN_PLACE : &timeVec[0]),
-                   &timeVec[0], cpVecSize, MPI_DOUBLE, MPI_SUM, root.rank, comm->getComm());
+    MPI_Reduce((my.rank == root.rank ? MPI_IN_PLACE : buffer),
+               buffer, count, MPI_DOUBLE, MPI_SUM, root.rank, comm->getComm());
 #else   // MVAPICH2_VERSION
-        // MVAPICH2's MPI_Reduce implementation may fail with a segmentation
-        // fault when using MPI_IN_PLACE, root != 0, and all processes in
-        // comm residing on the same node.
-        vector<double> recvVec;
-        recvVec.reserve(cpVecSize);
-        MPI_Reduce(&timeVec[0], &recvVec[0], cpVecSize, MPI_DOUBLE, MPI_SUM,
-                   root.rank, comm->getComm());
+    // MVAPICH2's MPI_Reduce implementation may fail with a segmentation
+    // fault when using MPI_IN_PLACE, root != 0, and all processes in
+    // comm residing on the same node.
+    vector<double> recvVec(timeVec.size());
+    MPI_Reduce(buffer, recvVec.empty() ? 0 : &recvVec[0], count, MPI_DOUBLE,
+               MPI_SUM, root.rank, comm->getComm());
+    timeVec.swap(recvVec);
 #endif   // MVAPICH2_VERSION
 
+    for (inpIt = data->mInputScales.begin(), k = 0; inpIt != data->mInputScales.end(); ++inpIt, ++k) {
         TimeMapSum delayInfo;
 
         if (my.rank == root.rank && isSynchpoint) {
             for (vector<int>::size_type i = 0; i < cpVecSize; ++i) {
-#ifndef MVAPICH2_VERSION
-                delayInfo.mMap[cpIdVec[i]]  = timeVec[i];
-                delayInfo.mSum             += timeVec[i];
-#else   // MVAPICH2_VERSION
-                delayInfo.mMap[cpIdVec[i]]  = recvVec[i];
-                delayInfo.mSum             += recvVec[i];
-#endif   // MVAPICH2_VERSION
+                delayInfo.mMap[cpIdVec[i]]  = timeVec[k * cpVecSize + i];
+                delayInfo.mSum             += timeVec[k * cpVecSize + i];
             }
         }
 
         data->mCollDelayInfo.insert(std::make_pair(inpIt->first, delayInfo));
-        inpIt->second = scale;
+        inpIt->second = scaleVec[k];
     }
 
     // --- get scaling factors for long-term cost and propagating wait-state calculation
@@ -18,8 +18,7 @@
 #include "MpiOperators.h"
 
 #include <algorithm>
-#include <cstring>
-
+#include "TopMostSevereHeap.h"
 #include "scout_types.h"
 
 using namespace std;
@@ -116,10 +115,12 @@ void scout_minmax(TimeVec2* in, TimeVec2* inout, int* len,
 
 /**
  *  @internal
- *  @brief Performs sorting reduction.
+ *  @brief Performs most-severe instance reduction.
  *
- *  This function finds most severe instances among detected,
- *  this array is kept sorted in descending order
+ *  This function merges the most severe instances of both input arrays,
+ *  which consist of @a len blocks of TOP_SEVERE_INSTANCES entries each
+ *  (one block per pattern). Each block of the result is sorted in
+ *  descending order of idle time and padded with empty instances.
  *
  *  @param  in     First input array
  *  @param  inout  Second input array, also storing the result
@@ -131,68 +132,20 @@ void top_severe(TopMostSevere* in,
                 int*           len,
                 MPI_Datatype*  dtype)
 {
-  bool flag;
-  int j,k,l;
-  int offset, length;
-
-  for (int i=0; i < *len; i++) {
-    // compute offset and length of the array
-    // where the reduction should be applied
-    offset = i * TOP_SEVERE_INSTANCES;
-    length = offset + TOP_SEVERE_INSTANCES;
-    for (int m=offset; m < length; m++) {
-      // flag shows if we found the value
-      // with identical cnode
-      flag = false;
-
-      // find position of element
-      for (j=offset, k=-1; j < length; j++) {
-        // the value with the same cnode value and
-        // greater idletime is necessary to insert at once
-        if ((in[m].cnode == inout[j].cnode) &&
-            (in[m].idletime > inout[j].idletime)) {
-          flag = true;
-          break;
-        }
-        // the value with the same cnode value and
-        // smaller idletime will be skipped
-        else if ((in[m].cnode == inout[j].cnode) &&
-                 (in[m].idletime < inout[j].idletime)) {
-          flag = true;
-          j = -1;
-          break;
-        }
-        // find the position of smallest element
-        // that is is bigger than initial one
-        else if ((in[m].idletime > inout[j].idletime) &&
-                 (in[m].cnode != inout[j].cnode) && (k < 0)) {
-          k = j;
-        }
-      }
-
-      if ((flag == true) && (j != -1)) {
-        // insert the element into correct position
-        inout[j] = in[m];
-        // sort the vector
-        TopMostSevere tmp;
-        for (int t = offset + 1; t < length; t++) {
-          l = t;
-          while (l > offset && inout[l - 1].idletime < inout[l].idletime) {
-            tmp        = inout[l];
-            inout[l]     = inout[l - 1];
-            inout[l - 1] = tmp;
-            l--;
-          }
-        }
-      }
-      // insert the value and shift the rest values
-      else if ((flag == false) && (k >= 0)) {
-        //shift
-        std::memmove(&inout[k + 1], &inout[k], (length - k - 1) * sizeof(TopMostSevere));
-        //insert
-        inout[k] = in[m];
-      }
+  TopMostSevereHeap::InstanceList sorted;
+
+  for (int i = 0; i < *len; ++i) {
+    const int offset = i * TOP_SEVERE_INSTANCES;
+
+    TopMostSevereHeap heap;
+    for (int j = offset; j < offset + TOP_SEVERE_INSTANCES; ++j) {
+      heap.insert(inout[j]);
+      heap.insert(in[j]);
     }
+
+    heap.getSorted(sorted);
+    sorted.resize(TOP_SEVERE_INSTANCES);
+    copy(sorted.begin(), sorted.end(), inout + offset);
   }
 }
 
@@ -204,7 +157,8 @@ void top_severe(TopMostSevere* in,
 *  This function finds MAX and SUM for idletime
 *  for detected statistical collective patterns,
 *  it finds MIN time of enter event
-*  and MAX time for exit event
+*  and MAX time for exit event (element-wise
+*  for all instances of the input arrays)
 *
 *  @param  in     First input array
 *  @param  inout  Second input array, also storing the result
@@ -216,19 +170,21 @@ void top_severe_coll_maxsum(TopMostSevereMaxSum* in,
                              int*                  len,
                              MPI_Datatype*         dtype)
 {
-  // max
-  if (inout[0].idletime_max < in[0].idletime_max){
-    inout[0].idletime_max = in[0].idletime_max;
-    inout[0].rank = in[0].rank;
-  }
-  // sum
-  inout[0].idletime += in[0].idletime;
-  // min
-  if (inout[0].entertime > in[0].entertime) {
-    inout[0].entertime = in[0].entertime;
-  }
-  // max
-  if (inout[0].exittime < in[0].exittime) {
-    inout[0].exittime = in[0].exittime;
+  for (int i = 0; i < *len; ++i) {
+    // max
+    if (inout[i].idletime_max < in[i].idletime_max) {
+      inout[i].idletime_max = in[i].idletime_max;
+      inout[i].rank = in[i].rank;
+    }
+    // sum
+    inout[i].idletime += in[i].idletime;
+    // min
+    if (inout[i].entertime > in[i].entertime) {
+      inout[i].entertime = in[i].entertime;
+    }
+    // max
+    if (inout[i].exittime < in[i].exittime) {
+      inout[i].exittime = in[i].exittime;
+    }
   }
 }
@@ -23,16 +23,123 @@
 
 #include <pearl/CallbackManager.h>
 #include <pearl/Event.h>
+#include <pearl/LocalTrace.h>
+#include <pearl/Region.h>
 
 #include <omp.h>
 
 #include <set>
+#include <vector>
 
 using namespace scout;
 using namespace pearl;
 using namespace std;
 
 
+namespace
+{
+    // Team-wide results of the OpenMP synchronization pre-pass, indexed by
+    // the instance number of the parallel region or barrier. They are shared
+    // by all threads and computed once before the main replay.
+    vector<timestamp_t> teamForkTimes;
+    vector<timestamp_t> teamJoinTimes;
+    vector<TimeRank>    teamBarriers;
+
+    // Per-thread barrier enter timestamps used as input for the reduction
+    vector<const vector<timestamp_t>*> teamEnterTimes;
+
+
+/// @brief Determine team-wide OpenMP synchronization data.
+///
+/// Collects the fork/join timestamps of all parallel regions and the enter
+/// timestamps of all barriers from the local @a trace in a single pre-pass
+/// and reduces them across the thread team.  Has to be called by all threads
+/// of the team.
+///
+/// @param trace
+///     Local trace data object
+///
+void
+collectTeamData(const LocalTrace& trace)
+{
+    // Local pre-pass: collect the enter timestamps of all barriers
+    // executed inside parallel regions as well as the fork/join
+    // timestamps of all parallel regions (only available on the master
+    // thread) in execution order
+    vector<timestamp_t> enterTimes;
+    vector<timestamp_t> forkTimes;
+    vector<timestamp_t> joinTimes;
+    timestamp_t         forkTime = 0;
+    int                 depth    = 0;
+
+    for (Event event = trace.begin(); event != trace.end(); ++event) {
+        if (event->isOfType(THREAD_FORK)) {
+            forkTime = event->getTimestamp();
+        } else if (event->isOfType(THREAD_JOIN)) {
+            joinTimes.resize(forkTimes.size() - depth,
+                             event->getTimestamp());
+        } else if (event->isOfType(GROUP_ENTER)) {
+            const Region& region = event->getRegion();
+            if (is_omp_parallel(region)) {
+                forkTimes.push_back(forkTime);
+                ++depth;
+            } else if (depth > 0 && is_omp_barrier(region)) {
+                enterTimes.push_back(event->getTimestamp());
+            }
+        } else if (event->isOfType(LEAVE)) {
+            if (is_omp_parallel(event->getRegion()))
+                --depth;
+        }
+    }
+    joinTimes.resize(forkTimes.size() - depth, 0);
+
+    // Team-wide max/argmax reduction over all barrier instances at once
+    const int numThreads = omp_get_num_threads();
+
+#pragma omp single
+    {
+        teamEnterTimes.assign(numThreads, NULL);
+    }
+    teamEnterTimes[omp_get_thread_num()] = &enterTimes;
+#pragma omp master
+    {
+        teamForkTimes.swap(forkTimes);
+        teamJoinTimes.swap(joinTimes);
+    }
+#pragma omp barrier
+    { }
+#pragma omp single
+    {
+        size_t count = 0;
+        for (int thread = 0; thread < numThreads; ++thread)
+            count = std::max(count, teamEnterTimes[thread]->size());
+
+        teamBarriers.resize(count);
+    }
+
+    const long count = teamBarriers.size();
+
+#pragma omp for
+    for (long index = 0; index < count; ++index) {
+        TimeRank latest;
+
+        latest.time = 0;
+        latest.rank = -1;
+        for (int thread = 0; thread < numThreads; ++thread) {
+            const vector<timestamp_t>& times = *teamEnterTimes[thread];
+
+            if (index < static_cast<long>(times.size())
+                && latest.time < times[index]) {
+                latest.time = times[index];
+                latest.rank = thread;
+            }
+        }
+        teamBarriers[index] = latest;
+    }
+}
+}   // unnamed namespace
+
+
 struct OmpEventHandler::OmpEvtHImpl
 {
     //
@@ -65,6 +172,12 @@ struct OmpEventHandler::OmpEvtHImpl
     // --- main replay callbacks
     //
 
+    SCOUT_CALLBACK(cb_pre_prepare) {
+        CbData* data = static_cast<CbData*>(cdata);
+
+        collectTeamData(*data->mTrace);
+    }
+
     SCOUT_CALLBACK(cb_pre_omp_forkjoin) {
         CbData* data = static_cast<CbData*>(cdata);
 
@@ -74,36 +187,9 @@ struct OmpEventHandler::OmpEvtHImpl
     SCOUT_CALLBACK(cb_pre_omp_barrier) {
         CbData* data = static_cast<CbData*>(cdata);
 
-        TimeRank        my;
-
-        my.time = data->mCallstack->top()->getTimestamp();
-        my.rank = omp_get_thread_num();
-
-        static TimeRank latest;
-
-#pragma omp barrier
-        { }
-#pragma omp master
-        {
-            latest.time = 0;
-            latest.rank = -1;
-        }
-#pragma omp barrier
-        { }
-#pragma omp critical
-        {
-            if (latest.time < my.time)
-                latest = my;
-        }
-#pragma omp barrier
-        { }
-
-        CollectiveInfo ci;
-
-        ci.my     = my;
-        ci.latest = latest;
-
-        mCollInfo.insert(make_pair(event, ci));
+        // The team-wide information has already been determined by the
+        // OpenMP barrier pattern using the results of the pre-pass
+        mCollInfo.insert(make_pair(event, data->mCollinfo));
         mBarriers.insert(event);
     }
 
@@ -166,6 +252,7 @@ struct OmpEventHandler::OmpEvtHImpl
 
         const struct cb_uevt_table_t main_uevt_tbl[] = {
 #ifdef _OPENMP
+            { PREPARE,       &OmpEvtHImpl::cb_pre_prepare      },
             { OMP_MGMT_FORK, &OmpEvtHImpl::cb_pre_omp_forkjoin },
             { OMP_MGMT_JOIN, &OmpEvtHImpl::cb_pre_omp_forkjoin },
             { OMP_EBARRIER,  &OmpEvtHImpl::cb_pre_omp_barrier  },
@@ -354,6 +441,36 @@ OmpEventHandler::getForkJoinTime(const pearl::Event& e) const
     return mP->getForkJoinTime(e);
 }
 
+void
+OmpEventHandler::prepareTeamData(const pearl::LocalTrace& trace)
+{
+    collectTeamData(trace);
+}
+
+pearl::timestamp_t
+OmpEventHandler::getTeamForkTime(uint32_t index) const
+{
+    assert(index < teamForkTimes.size());
+
+    return teamForkTimes[index];
+}
+
+pearl::timestamp_t
+OmpEventHandler::getTeamJoinTime(uint32_t index) const
+{
+    assert(index < teamJoinTimes.size());
+
+    return teamJoinTimes[index];
+}
+
+const TimeRank&
+OmpEventHandler::getTeamBarrier(uint32_t index) const
+{
+    assert(index < teamBarriers.size());
+
+    return teamBarriers[index];
+}
+
 void
 OmpEventHandler::register_pre_pattern_callbacks(const CallbackManagerMap& cbm)
 {
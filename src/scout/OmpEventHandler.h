@@ -18,6 +18,7 @@
 #define SCOUT_OMPEVENTHANDLER_H
 
 #include "AnalysisHandler.h"
+#include "scout_types.h"
 
 #include <memory>
 
@@ -26,6 +27,7 @@
 namespace pearl
 {
     class Event;
+    class LocalTrace;
 }
 
 namespace scout
@@ -38,7 +40,12 @@ namespace scout
  * @brief   OpenMP event dispatch
  * 
  * The OmpEventHandler handles OpenMP information (fork time, join time) and
- * event dispatch for fork, join, and barrier regions
+ * event dispatch for fork, join, and barrier regions. Before the main
+ * replay, it determines the fork/join timestamps of all parallel regions
+ * and the latest enter time of all barriers in a single team-wide pre-pass,
+ * so that the OpenMP patterns do not need to synchronize the threads during
+ * the replay. The pre-pass can also be triggered explicitly via
+ * prepareTeamData() if no replay is performed.
  */
 // --------------------------------------------------------------------------
 
@@ -54,8 +61,17 @@ public:
 
   ~OmpEventHandler();
 
+  const char* get_name() const
+    { return "OmpEventHandler"; }
+
   pearl::timestamp_t getForkJoinTime(const pearl::Event& e) const; 
 
+  void prepareTeamData(const pearl::LocalTrace& trace);
+
+  pearl::timestamp_t getTeamForkTime(uint32_t index) const;
+  pearl::timestamp_t getTeamJoinTime(uint32_t index) const;
+  const TimeRank&    getTeamBarrier(uint32_t index) const;
+
   void register_pre_pattern_callbacks (const CallbackManagerMap& cbm);
   void register_post_pattern_callbacks (const CallbackManagerMap& cbm);
 
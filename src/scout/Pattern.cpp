@@ -28,6 +28,9 @@
   #include <omp.h>
 #endif   // _OPENMP
 
+#include <pearl/Buffer.h>
+#include <pearl/Callpath.h>
+#include <pearl/Error.h>
 #include <pearl/GlobalDefs.h>
 #include <pearl/LocalTrace.h>
 #include <pearl/LocationGroup.h>
@@ -180,6 +183,23 @@ bool Pattern::is_hidden() const
 }
 
 
+//--- Updating severity values ----------------------------------------------
+
+/**
+ *  @brief Adds a value to the severity of a call path.
+ *
+ *  Allows severities to be determined outside of the pattern's replay
+ *  callbacks, e.g., from per-location data collected by other means.
+ *
+ *  @param  cnode  Call path
+ *  @param  value  Severity value to be added (may be negative)
+ **/
+void Pattern::add_severity(Callpath* cnode, double value)
+{
+  m_severity[cnode] += value;
+}
+
+
 //--- Writing severity values -----------------------------------------------
 
 /**
@@ -356,6 +376,58 @@ void Pattern::gen_severities(ReportData&              data,
 }
 
 
+//--- Checkpointing ---------------------------------------------------------
+
+/**
+ *  @brief Stores the pattern's local state in a buffer.
+ *
+ *  Packs the local severity values into the given @a buffer, such that the
+ *  report can be generated later without repeating the trace replay (e.g.,
+ *  when resuming an analysis from a checkpoint). Patterns keeping additional
+ *  state which is only evaluated in gen_severities() have to overwrite this
+ *  method and the corresponding unpack_state() method.
+ *
+ *  @param  buffer  Buffer to store the state in
+ **/
+void Pattern::pack_state(Buffer& buffer) const
+{
+  buffer.put_uint32(m_severity.size());
+  for (map<Callpath*,double>::const_iterator it = m_severity.begin();
+       it != m_severity.end();
+       ++it) {
+    buffer.put_id(it->first->getId());
+    buffer.put_double(it->second);
+  }
+}
+
+
+/**
+ *  @brief Restores the pattern's local state from a buffer.
+ *
+ *  Unpacks the local severity values previously stored by pack_state()
+ *  from the given @a buffer, replacing the current values.
+ *
+ *  @param  buffer  Buffer to retrieve the state from
+ *  @param  defs    Global definitions object
+ *
+ *  @throw  pearl::RuntimeError  if an invalid call path is encountered
+ **/
+void Pattern::unpack_state(Buffer& buffer, const GlobalDefs& defs)
+{
+  m_severity.clear();
+
+  uint32_t count = buffer.get_uint32();
+  while (count--) {
+    const ident_t id    = buffer.get_id();
+    const double  value = buffer.get_double();
+    if (id >= defs.numCallpaths())
+      throw RuntimeError("Invalid call path in checkpoint data.");
+
+    m_severity[defs.get_cnode(id)] = value;
+  }
+}
+
+
 //--- Pattern management ----------------------------------------------------
 
 /**
@@ -42,6 +42,7 @@
 namespace pearl
 {
 
+class Buffer;
 class CallbackManager;
 class Callpath;
 class GlobalDefs;
@@ -95,9 +96,15 @@ class Pattern
     virtual std::string get_descr() const = 0;
     virtual std::string get_unit() const = 0;
     virtual CubeMetricType get_mode() const = 0;
-    std::string get_url() const;
+    virtual std::string get_url() const;
     virtual bool is_hidden() const;
 
+    /// @}
+    /// @name Updating severity values
+    /// @{
+
+    void add_severity(pearl::Callpath* cnode, double value);
+
     /// @}
     /// @name Writing severity values
     /// @{
@@ -106,6 +113,14 @@ class Pattern
                                 const pearl::LocalTrace& trace);
 
     /// @}
+    /// @name Checkpointing
+    /// @{
+
+    virtual void pack_state(pearl::Buffer& buffer) const;
+    virtual void unpack_state(pearl::Buffer&           buffer,
+                              const pearl::GlobalDefs& defs);
+
+    /// @}
 
 
   protected:
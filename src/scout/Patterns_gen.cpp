@@ -100,8 +100,12 @@ using namespace scout;
 #line 19 "OMP.pattern"
 
 #if defined(_OPENMP)
+#include "OmpEventHandler.h"
+
 namespace {
+    // Nesting level of parallel regions on the calling thread
     int omp_nest_level = 0;
+    #pragma omp threadprivate(omp_nest_level)
 }   // unnamed namespace
 #endif
 
@@ -136,12 +140,16 @@ namespace {
 
   #include <cstdio>
   #include <cstring>
+  #include <map>
+  #include <pearl/Buffer.h>
+  #include <pearl/ReductionBundle.h>
   #include <pearl/pearl_replay.h>
   #include <sys/stat.h>
   #include "LockTracking.h"
 
   #include "Quantile.h"
   #include "ReportData.h"
+  #include "TopMostSevereHeap.h"
 
   #if defined(_MPI)
     #include "MpiDatatypes.h"
@@ -251,9 +259,6 @@ class PatternTime : public Pattern
 
         assert(it != cbmgrs.end());
 
-        (it->second)->register_callback(LEAVE, PEARL_create_callback(this, &PatternTime::leave__cb));
-        (it->second)->register_callback(THREAD_END, PEARL_create_callback(this, &PatternTime::thread_end__cb));
-        (it->second)->register_callback(THREAD_TASK_COMPLETE, PEARL_create_callback(this, &PatternTime::thread_task_complete__cb));
         (it->second)->register_callback(OMP_MGMT_FORK, PEARL_create_callback(this, &PatternTime::omp_mgmt_fork__cb));
         (it->second)->register_callback(OMP_MGMT_JOIN, PEARL_create_callback(this, &PatternTime::omp_mgmt_join__cb));
         (it->second)->register_callback(FINISHED, PEARL_create_callback(this, &PatternTime::finished__cb));
@@ -451,19 +456,10 @@ class PatternVisits : public Pattern
 {
   public:
     /* Registering callbacks */
-    virtual void reg_cb(CallbackManagerMap& cbmgrs)
+    virtual void reg_cb(CallbackManagerMap&)
     {
       init();
 
-      {
-        CallbackManagerMap::iterator it = cbmgrs.find("");
-
-        assert(it != cbmgrs.end());
-
-        (it->second)->register_callback(GROUP_ENTER, PEARL_create_callback(this, &PatternVisits::group_enter__cb));
-        (it->second)->register_callback(THREAD_TASK_COMPLETE, PEARL_create_callback(this, &PatternVisits::thread_task_complete__cb));
-        (it->second)->register_callback(THREAD_END, PEARL_create_callback(this, &PatternVisits::thread_end__cb));
-      }
     }
 
     /* Get pattern information */
@@ -635,7 +631,7 @@ class PatternAsync : public MpiPattern
 void PatternAsync::finished__cb(const pearl::CallbackManager& cbmanager, int user_event, const pearl::Event& event, CallbackData* cdata)
 {
 
-#line 85 "Async.pattern"
+#line 87 "Async.pattern"
 
             AmRuntime::getInstance().shutdown();
         
@@ -659,7 +655,8 @@ void PatternAsync::prepare__cb(const pearl::CallbackManager& cbmanager, int user
             #if defined(_MPI)
             // Register MPI specific factory callbacks
             pearl::AmRequestFactory::registerCallback(Paradigm::MPI,
-                                                      &MpiAmRequest::create);
+                                                      &MpiAmRequest::create,
+                                                      &MpiAmRequest::testsome);
             pearl::AmListenerFactory::registerCallback(Paradigm::MPI,
                                                       &MpiAmListener::create);
             #endif
@@ -667,7 +664,8 @@ void PatternAsync::prepare__cb(const pearl::CallbackManager& cbmanager, int user
             #if defined(_ARMCI)
             // Register ARMCI specific factory callbacks
             pearl::AmRequestFactory::registerCallback(Paradigm::ARMCI,
-                                                      &MpiAmRequest::create);
+                                                      &MpiAmRequest::create,
+                                                      &MpiAmRequest::testsome);
             pearl::AmListenerFactory::registerCallback(Paradigm::ARMCI,
                                                       &MpiAmListener::create);
             #endif
@@ -692,17 +690,10 @@ class PatternMPI_Init : public MpiPattern
 {
   public:
     /* Registering callbacks */
-    virtual void reg_cb(CallbackManagerMap& cbmgrs)
+    virtual void reg_cb(CallbackManagerMap&)
     {
       init();
 
-      {
-        CallbackManagerMap::iterator it = cbmgrs.find("");
-
-        assert(it != cbmgrs.end());
-
-        (it->second)->register_callback(GROUP_ENTER, PEARL_create_callback(this, &PatternMPI_Init::group_enter__cb));
-      }
     }
 
     /* Get pattern information */
@@ -1316,7 +1307,6 @@ class PatternMPI_LateSender : public MpiPattern
         (it->second)->register_callback(PRE_SEND, PEARL_create_callback(this, &PatternMPI_LateSender::pre_send__cb));
         (it->second)->register_callback(PRE_RECV, PEARL_create_callback(this, &PatternMPI_LateSender::pre_recv__cb));
         (it->second)->register_callback(POST_RECV, PEARL_create_callback(this, &PatternMPI_LateSender::post_recv__cb));
-        (it->second)->register_callback(LEAVE, PEARL_create_callback(this, &PatternMPI_LateSender::leave__cb));
       }
     }
 
@@ -1841,7 +1831,6 @@ class PatternMPI_LateReceiver : public MpiPattern
 
         (it->second)->register_callback(PRE_SEND, PEARL_create_callback(this, &PatternMPI_LateReceiver::pre_send_bws_cb));
         (it->second)->register_callback(POST_SEND, PEARL_create_callback(this, &PatternMPI_LateReceiver::post_send_bws_cb));
-        (it->second)->register_callback(MPI_SEND_COMPLETE, PEARL_create_callback(this, &PatternMPI_LateReceiver::mpi_send_complete_bws_cb));
         (it->second)->register_callback(PRE_RECV, PEARL_create_callback(this, &PatternMPI_LateReceiver::pre_recv_bws_cb));
       }
     }
@@ -2590,20 +2579,10 @@ class PatternOMP_Mgmt : public OmpPattern
 {
   public:
     /* Registering callbacks */
-    virtual void reg_cb(CallbackManagerMap& cbmgrs)
+    virtual void reg_cb(CallbackManagerMap&)
     {
       init();
 
-      {
-        CallbackManagerMap::iterator it = cbmgrs.find("");
-
-        assert(it != cbmgrs.end());
-
-        (it->second)->register_callback(THREAD_FORK, PEARL_create_callback(this, &PatternOMP_Mgmt::thread_fork__cb));
-        (it->second)->register_callback(THREAD_JOIN, PEARL_create_callback(this, &PatternOMP_Mgmt::thread_join__cb));
-        (it->second)->register_callback(GROUP_ENTER, PEARL_create_callback(this, &PatternOMP_Mgmt::group_enter__cb));
-        (it->second)->register_callback(LEAVE, PEARL_create_callback(this, &PatternOMP_Mgmt::leave__cb));
-      }
     }
 
     /* Get pattern information */
@@ -2645,8 +2624,27 @@ class PatternOMP_Mgmt : public OmpPattern
     /* Callback methods */
     void group_enter__cb(const pearl::CallbackManager& cbmanager, int user_event, const pearl::Event& event, CallbackData* cdata);
     void leave__cb(const pearl::CallbackManager& cbmanager, int user_event, const pearl::Event& event, CallbackData* cdata);
-    void thread_fork__cb(const pearl::CallbackManager& cbmanager, int user_event, const pearl::Event& event, CallbackData* cdata);
-    void thread_join__cb(const pearl::CallbackManager& cbmanager, int user_event, const pearl::Event& event, CallbackData* cdata);
+  protected:
+    /* Protected methods */
+
+    virtual void init()
+    {
+
+#line 159 "OMP.pattern"
+
+    mForkCount = 0;
+    mJoinCount = 0;
+  
+    }
+
+
+  private:
+
+#line 155 "OMP.pattern"
+
+    uint32_t mForkCount;
+    uint32_t mJoinCount;
+  
 };
 
 
@@ -2656,29 +2654,24 @@ void PatternOMP_Mgmt::group_enter__cb(const pearl::CallbackManager& cbmanager, i
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 162 "OMP.pattern"
+#line 164 "OMP.pattern"
 
       // Are we entering an OpenMP parallel region?
       const Region& region = event->getRegion();
       if (!is_omp_parallel(region))
         return;
 
-      // Determine timestamp of FORK event
-      static timestamp_t forkTimestamp;
-      #pragma omp master
-      {
-        Event fork = event.prev();
-        while (fork->getType() != THREAD_FORK)
-          --fork;
-        forkTimestamp = fork->getTimestamp();
-      }
+      // Increment nesting level
+      omp_nest_level++;
+
+      // Determine timestamp of FORK event (precomputed before the replay)
+      timestamp_t forkTimestamp =
+        data->mOmpEventHandler->getTeamForkTime(mForkCount++);
 
       // Calculate thread fork time
-      #pragma omp barrier
       data->mIdle = std::max(0.0, event->getTimestamp() - forkTimestamp);
       m_severity[event.get_cnode()] += data->mIdle;
       cbmanager.notify(OMP_MGMT_FORK, event, data);
-      #pragma omp barrier
     
 }
 
@@ -2686,7 +2679,7 @@ void PatternOMP_Mgmt::leave__cb(const pearl::CallbackManager& cbmanager, int use
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 186 "OMP.pattern"
+#line 183 "OMP.pattern"
 
       // Are we leaving an OpenMP parallel region?
       Event   enter  = data->mCallstack->top();
@@ -2694,43 +2687,17 @@ void PatternOMP_Mgmt::leave__cb(const pearl::CallbackManager& cbmanager, int use
       if (!is_omp_parallel(region))
         return;
 
-      // Determine timestamp of JOIN event
-      static timestamp_t joinTimestamp;
-      #pragma omp master
-      {
-        Event join = event.next();
-        while (join->getType() != THREAD_JOIN)
-          ++join;
+      // Decrement nesting level
+      omp_nest_level--;
 
-        joinTimestamp = join->getTimestamp();
-      }
+      // Determine timestamp of JOIN event (precomputed before the replay)
+      timestamp_t joinTimestamp =
+        data->mOmpEventHandler->getTeamJoinTime(mJoinCount++);
 
       // Calculate thread join time
-      #pragma omp barrier
       data->mIdle = std::max(0.0, joinTimestamp - event->getTimestamp());
       m_severity[enter.get_cnode()] += data->mIdle;
       cbmanager.notify(OMP_MGMT_JOIN, event, data);
-      #pragma omp barrier
-    
-}
-
-void PatternOMP_Mgmt::thread_fork__cb(const pearl::CallbackManager& cbmanager, int user_event, const pearl::Event& event, CallbackData* cdata)
-{
-
-#line 152 "OMP.pattern"
-
-      // Increment nesting level
-      omp_nest_level++;
-    
-}
-
-void PatternOMP_Mgmt::thread_join__cb(const pearl::CallbackManager& cbmanager, int user_event, const pearl::Event& event, CallbackData* cdata)
-{
-
-#line 157 "OMP.pattern"
-
-      // Decrement nesting level
-      omp_nest_level--;
     
 }
 
@@ -2810,7 +2777,7 @@ void PatternOMP_Mgmt_Fork::omp_mgmt_fork__cb(const pearl::CallbackManager& cbman
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 230 "OMP.pattern"
+#line 221 "OMP.pattern"
 
       m_severity[event.get_cnode()] += data->mIdle;
     
@@ -2842,8 +2809,6 @@ class PatternOMP_Sync_Barrier : public OmpPattern
         assert(it != cbmgrs.end());
 
         (it->second)->register_callback(TASK_CORRECTION, PEARL_create_callback(this, &PatternOMP_Sync_Barrier::task_correction__cb));
-        (it->second)->register_callback(ENTER, PEARL_create_callback(this, &PatternOMP_Sync_Barrier::enter__cb));
-        (it->second)->register_callback(LEAVE, PEARL_create_callback(this, &PatternOMP_Sync_Barrier::leave__cb));
       }
     }
 
@@ -2892,13 +2857,25 @@ class PatternOMP_Sync_Barrier : public OmpPattern
     void enter__cb(const pearl::CallbackManager& cbmanager, int user_event, const pearl::Event& event, CallbackData* cdata);
     void leave__cb(const pearl::CallbackManager& cbmanager, int user_event, const pearl::Event& event, CallbackData* cdata);
     void task_correction__cb(const pearl::CallbackManager& cbmanager, int user_event, const pearl::Event& event, CallbackData* cdata);
+  protected:
+    /* Protected methods */
+
+    virtual void init()
+    {
+
+#line 271 "OMP.pattern"
+
+    mBarrierCount = 0;
+  
+    }
 
 
   private:
 
-#line 276 "OMP.pattern"
+#line 267 "OMP.pattern"
 
-    double mTaskExecutionTime;
+    double   mTaskExecutionTime;
+    uint32_t mBarrierCount;
   
 };
 
@@ -2908,7 +2885,7 @@ class PatternOMP_Sync_Barrier : public OmpPattern
 void PatternOMP_Sync_Barrier::enter__cb(const pearl::CallbackManager& cbmanager, int user_event, const pearl::Event& event, CallbackData* cdata)
 {
 
-#line 284 "OMP.pattern"
+#line 279 "OMP.pattern"
 
       const Region& region = event.get_cnode()->getRegion();
       if (!is_omp_barrier(region))
@@ -2923,7 +2900,7 @@ void PatternOMP_Sync_Barrier::leave__cb(const pearl::CallbackManager& cbmanager,
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 293 "OMP.pattern"
+#line 288 "OMP.pattern"
 
       // Are we leaving an (implicit or explicit) OpenMP barrier?
       Event         enter  = data->mCallstack->top();
@@ -2932,27 +2909,21 @@ void PatternOMP_Sync_Barrier::leave__cb(const pearl::CallbackManager& cbmanager,
         return;
 
       // Skip OpenMP barrier waiting time calculation when running serially
-      // (the barriers called in the algorithm cause ill side effects...)
+      // (such barriers are not part of the team-wide pre-pass)
       if (0 == omp_nest_level)
         return;
 
-      // Determine latest enter time
+      // Determine latest enter time (precomputed before the replay)
       timestamp_t enterTime = enter->getTimestamp();
-      // Implicitly shared timestamp for reduction
-      static timestamp_t latestEnter;
-      #pragma omp barrier
-      #pragma omp master
-      latestEnter = 0;
-      #pragma omp barrier
-      #pragma omp critical
-      {
-        if(latestEnter < enterTime)
-          latestEnter = enterTime;
-      }
-      #pragma omp barrier
+
+      data->mCollinfo.my.time = enterTime;
+      data->mCollinfo.my.rank = omp_get_thread_num();
+      data->mCollinfo.latest  =
+        data->mOmpEventHandler->getTeamBarrier(mBarrierCount++);
 
       // Calculate waiting time
-      data->mIdle = latestEnter - enterTime - mTaskExecutionTime;
+      data->mIdle = data->mCollinfo.latest.time - enterTime
+                    - mTaskExecutionTime;
 
       // Notify sub-patterns
       if (is_omp_ebarrier(region)) {
@@ -2967,7 +2938,7 @@ void PatternOMP_Sync_Barrier::task_correction__cb(const pearl::CallbackManager&
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 280 "OMP.pattern"
+#line 275 "OMP.pattern"
 
        mTaskExecutionTime += data->mIdle; 
      
@@ -3049,7 +3020,7 @@ void PatternOMP_Sync_Ebarrier_Wait::omp_ebarrier__cb(const pearl::CallbackManage
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 381 "OMP.pattern"
+#line 370 "OMP.pattern"
 
       Event enter = data->mCallstack->top();
 
@@ -3138,7 +3109,7 @@ void PatternOMP_Sync_Ibarrier_Wait::omp_ibarrier__cb(const pearl::CallbackManage
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 442 "OMP.pattern"
+#line 431 "OMP.pattern"
 
       Event enter = data->mCallstack->top();
 
@@ -3227,7 +3198,7 @@ void PatternOMP_Lock_Contention_Critical::omp_contention_critical__cb(const pear
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 501 "OMP.pattern"
+#line 490 "OMP.pattern"
 
       if (data->mIdle > 0) { 
         m_severity[event.get_cnode()] += data->mIdle;
@@ -3313,7 +3284,7 @@ void PatternOMP_Lock_Contention_API::omp_contention_api__cb(const pearl::Callbac
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 556 "OMP.pattern"
+#line 545 "OMP.pattern"
 
       if (data->mIdle > 0) { 
         m_severity[event.get_cnode()] += data->mIdle;
@@ -3521,18 +3492,10 @@ class PatternThread_LockContention : public OmpPattern
   
     }
     /* Registering callbacks */
-    virtual void reg_cb(CallbackManagerMap& cbmgrs)
+    virtual void reg_cb(CallbackManagerMap&)
     {
       init();
 
-      {
-        CallbackManagerMap::iterator it = cbmgrs.find("");
-
-        assert(it != cbmgrs.end());
-
-        (it->second)->register_callback(THREAD_ACQUIRE_LOCK, PEARL_create_callback(this, &PatternThread_LockContention::thread_acquire_lock__cb));
-        (it->second)->register_callback(THREAD_RELEASE_LOCK, PEARL_create_callback(this, &PatternThread_LockContention::thread_release_lock__cb));
-      }
     }
 
     /* Get pattern information */
@@ -3709,17 +3672,10 @@ class PatternMPI_SyncsSend : public MpiPattern
 {
   public:
     /* Registering callbacks */
-    virtual void reg_cb(CallbackManagerMap& cbmgrs)
+    virtual void reg_cb(CallbackManagerMap&)
     {
       init();
 
-      {
-        CallbackManagerMap::iterator it = cbmgrs.find("");
-
-        assert(it != cbmgrs.end());
-
-        (it->second)->register_callback(GROUP_SEND, PEARL_create_callback(this, &PatternMPI_SyncsSend::group_send__cb));
-      }
     }
 
     /* Get pattern information */
@@ -3876,17 +3832,10 @@ class PatternMPI_SyncsColl : public MpiPattern
 {
   public:
     /* Registering callbacks */
-    virtual void reg_cb(CallbackManagerMap& cbmgrs)
+    virtual void reg_cb(CallbackManagerMap&)
     {
       init();
 
-      {
-        CallbackManagerMap::iterator it = cbmgrs.find("");
-
-        assert(it != cbmgrs.end());
-
-        (it->second)->register_callback(MPI_COLLECTIVE_END, PEARL_create_callback(this, &PatternMPI_SyncsColl::mpi_collective_end__cb));
-      }
     }
 
     /* Get pattern information */
@@ -3958,17 +3907,10 @@ class PatternMPI_CommsSend : public MpiPattern
 {
   public:
     /* Registering callbacks */
-    virtual void reg_cb(CallbackManagerMap& cbmgrs)
+    virtual void reg_cb(CallbackManagerMap&)
     {
       init();
 
-      {
-        CallbackManagerMap::iterator it = cbmgrs.find("");
-
-        assert(it != cbmgrs.end());
-
-        (it->second)->register_callback(GROUP_SEND, PEARL_create_callback(this, &PatternMPI_CommsSend::group_send__cb));
-      }
     }
 
     /* Get pattern information */
@@ -4125,17 +4067,10 @@ class PatternMPI_CommsExch : public MpiPattern
 {
   public:
     /* Registering callbacks */
-    virtual void reg_cb(CallbackManagerMap& cbmgrs)
+    virtual void reg_cb(CallbackManagerMap&)
     {
       init();
 
-      {
-        CallbackManagerMap::iterator it = cbmgrs.find("");
-
-        assert(it != cbmgrs.end());
-
-        (it->second)->register_callback(MPI_COLLECTIVE_END, PEARL_create_callback(this, &PatternMPI_CommsExch::mpi_collective_end__cb));
-      }
     }
 
     /* Get pattern information */
@@ -4207,17 +4142,10 @@ class PatternMPI_CommsSrc : public MpiPattern
 {
   public:
     /* Registering callbacks */
-    virtual void reg_cb(CallbackManagerMap& cbmgrs)
+    virtual void reg_cb(CallbackManagerMap&)
     {
       init();
 
-      {
-        CallbackManagerMap::iterator it = cbmgrs.find("");
-
-        assert(it != cbmgrs.end());
-
-        (it->second)->register_callback(MPI_COLLECTIVE_END, PEARL_create_callback(this, &PatternMPI_CommsSrc::mpi_collective_end__cb));
-      }
     }
 
     /* Get pattern information */
@@ -4289,17 +4217,10 @@ class PatternMPI_CommsDst : public MpiPattern
 {
   public:
     /* Registering callbacks */
-    virtual void reg_cb(CallbackManagerMap& cbmgrs)
+    virtual void reg_cb(CallbackManagerMap&)
     {
       init();
 
-      {
-        CallbackManagerMap::iterator it = cbmgrs.find("");
-
-        assert(it != cbmgrs.end());
-
-        (it->second)->register_callback(MPI_COLLECTIVE_END, PEARL_create_callback(this, &PatternMPI_CommsDst::mpi_collective_end__cb));
-      }
     }
 
     /* Get pattern information */
@@ -4371,17 +4292,10 @@ class PatternMPI_BytesSent : public MpiPattern
 {
   public:
     /* Registering callbacks */
-    virtual void reg_cb(CallbackManagerMap& cbmgrs)
+    virtual void reg_cb(CallbackManagerMap&)
     {
       init();
 
-      {
-        CallbackManagerMap::iterator it = cbmgrs.find("");
-
-        assert(it != cbmgrs.end());
-
-        (it->second)->register_callback(GROUP_SEND, PEARL_create_callback(this, &PatternMPI_BytesSent::group_send__cb));
-      }
     }
 
     /* Get pattern information */
@@ -4538,17 +4452,10 @@ class PatternMPI_BytesCout : public MpiPattern
 {
   public:
     /* Registering callbacks */
-    virtual void reg_cb(CallbackManagerMap& cbmgrs)
+    virtual void reg_cb(CallbackManagerMap&)
     {
       init();
 
-      {
-        CallbackManagerMap::iterator it = cbmgrs.find("");
-
-        assert(it != cbmgrs.end());
-
-        (it->second)->register_callback(MPI_COLLECTIVE_END, PEARL_create_callback(this, &PatternMPI_BytesCout::mpi_collective_end__cb));
-      }
     }
 
     /* Get pattern information */
@@ -4621,17 +4528,10 @@ class PatternMPI_BytesCin : public MpiPattern
 {
   public:
     /* Registering callbacks */
-    virtual void reg_cb(CallbackManagerMap& cbmgrs)
+    virtual void reg_cb(CallbackManagerMap&)
     {
       init();
 
-      {
-        CallbackManagerMap::iterator it = cbmgrs.find("");
-
-        assert(it != cbmgrs.end());
-
-        (it->second)->register_callback(MPI_COLLECTIVE_END, PEARL_create_callback(this, &PatternMPI_BytesCin::mpi_collective_end__cb));
-      }
     }
 
     /* Get pattern information */
@@ -4704,17 +4604,10 @@ class PatternMPI_BytesPut : public MpiPattern
 {
   public:
     /* Registering callbacks */
-    virtual void reg_cb(CallbackManagerMap& cbmgrs)
+    virtual void reg_cb(CallbackManagerMap&)
     {
       init();
 
-      {
-        CallbackManagerMap::iterator it = cbmgrs.find("");
-
-        assert(it != cbmgrs.end());
-
-        (it->second)->register_callback(MPI_RMA_PUT_START, PEARL_create_callback(this, &PatternMPI_BytesPut::mpi_rma_put_start__cb));
-      }
     }
 
     /* Get pattern information */
@@ -4785,17 +4678,10 @@ class PatternMPI_BytesGet : public MpiPattern
 {
   public:
     /* Registering callbacks */
-    virtual void reg_cb(CallbackManagerMap& cbmgrs)
+    virtual void reg_cb(CallbackManagerMap&)
     {
       init();
 
-      {
-        CallbackManagerMap::iterator it = cbmgrs.find("");
-
-        assert(it != cbmgrs.end());
-
-        (it->second)->register_callback(MPI_RMA_GET_START, PEARL_create_callback(this, &PatternMPI_BytesGet::mpi_rma_get_start__cb));
-      }
     }
 
     /* Get pattern information */
@@ -5551,10 +5437,6 @@ class PatternMPI_RmaSync : public MpiPattern
 
         assert(it != cbmgrs.end());
 
-        (it->second)->register_callback(MPI_RMA_LOCK, PEARL_create_callback(this, &PatternMPI_RmaSync::mpi_rma_lock__cb));
-        (it->second)->register_callback(MPI_RMA_UNLOCK, PEARL_create_callback(this, &PatternMPI_RmaSync::mpi_rma_unlock__cb));
-        (it->second)->register_callback(MPI_RMA_GATS, PEARL_create_callback(this, &PatternMPI_RmaSync::mpi_rma_gats__cb));
-        (it->second)->register_callback(MPI_RMA_COLLECTIVE_END, PEARL_create_callback(this, &PatternMPI_RmaSync::mpi_rma_collective_end__cb));
         (it->second)->register_callback(MPI_RMA_LC_COMPUTE, PEARL_create_callback(this, &PatternMPI_RmaSync::mpi_rma_lc_compute__cb));
         (it->second)->register_callback(MPI_RMA_POST_COMPLETE, PEARL_create_callback(this, &PatternMPI_RmaSync::mpi_rma_post_complete__cb));
       }
@@ -5788,54 +5670,34 @@ void PatternMPI_RmaSync::mpi_rma_lc_compute__cb(const pearl::CallbackManager& cb
 
         while (entry.epochQueue.size() >= 2)
         {
-            // Priority queue of epochs to be processed
+            // Queue of epochs to be processed
             LockEpochQueue scheduled_epochs;
 
             // Remove next epoch from queue and schedule it
-            RemoteRmaEpochPtr current_epoch(entry.epochQueue.top());
-            entry.epochQueue.pop();
+            LockEpoch current_epoch;
+            entry.epochQueue.pop(current_epoch);
 
             // check if current_epoch is exclusive
-            RemoteRmaEpoch::const_iterator lock_it = current_epoch->begin();
-            while (lock_it != current_epoch->end()
-                    && (*lock_it)->isOfType(MPI_RMA_LOCK))
-                ++lock_it;
-
-            if ((*lock_it)->is_exclusive())
-                current_exclusive_epoch = true;
-            else
-                current_exclusive_epoch = false;
-
-            scheduled_epochs.push(current_epoch);
+            current_exclusive_epoch = current_epoch.mExclusive;
 
 #ifdef DEBUG_LOCK_CONTENTION
-            RemoteRmaEpoch::const_iterator ex_it = current_epoch->begin();
-            while (ex_it != current_epoch->end()
-                    && (*ex_it)->isOfType(MPI_RMA_UNLOCK))
-                ++ex_it;
-
-            cerr << "Unlock Time: " << (*ex_it)->getTimestamp() << endl;
+            cerr << "Unlock Time: " << current_epoch.mUnlockTime << endl;
 #endif
 
-            RemoteRmaEpochPtr reference_epoch(entry.epochQueue.top());
-            bool               exclusive_epoch_found = false;
+            scheduled_epochs.push(current_epoch);
+
+            bool exclusive_epoch_found = false;
 
             if (!current_exclusive_epoch)
             {
                 do
                 {
-                    reference_epoch = entry.epochQueue.top();
-                    // get lock event
-                    RemoteRmaEpoch::const_iterator lock_it = reference_epoch->begin();
-                    while (lock_it != reference_epoch->end()
-                        && (*lock_it)->isOfType(MPI_RMA_LOCK))
-                        ++lock_it;
-
                     // if lock is shared, schedule epoch and get next
-                    if (!(*lock_it)->is_exclusive())
+                    if (!entry.epochQueue.top().mExclusive)
                     {
-                        scheduled_epochs.push(reference_epoch);
-                        entry.epochQueue.pop();
+                        LockEpoch shared_epoch;
+                        entry.epochQueue.pop(shared_epoch);
+                        scheduled_epochs.push(shared_epoch);
                     }
                     else
                     {
@@ -5847,16 +5709,18 @@ void PatternMPI_RmaSync::mpi_rma_lc_compute__cb(const pearl::CallbackManager& cb
 
             if (current_exclusive_epoch || exclusive_epoch_found)
             {
+                // previous exclusive lock owner's epoch remains in the queue
+                const LockEpoch& reference_epoch = entry.epochQueue.top();
+
+                // get previous exclusive lock owner's unlock event
+                RemoteRmaEpoch::const_reverse_iterator ref_it = reference_epoch.mEvents.rbegin();
+                while ((*ref_it)->isOfType(MPI_RMA_UNLOCK))
+                    ++ref_it;
+
                 while (scheduled_epochs.size() > 0)
                 {
-                    current_epoch = scheduled_epochs.top();
-                    scheduled_epochs.pop();
-                    RemoteRmaEpoch::reverse_iterator ce_it = current_epoch->rbegin();
-
-                    // get previous exclusive lock owner's unlock event
-                    RemoteRmaEpoch::reverse_iterator ref_it = reference_epoch->rbegin();
-                    while ((*ref_it)->isOfType(MPI_RMA_UNLOCK))
-                        ++ref_it;
+                    scheduled_epochs.pop(current_epoch);
+                    RemoteRmaEpoch::reverse_iterator ce_it = current_epoch.mEvents.rbegin();
 
 #ifdef DEBUG_LOCK_CONTENTION
                     cerr << "ref_it: " << (*ref_it)->getTimestamp() << "  " << ref_it->get_location()->get_id()
@@ -5864,13 +5728,13 @@ void PatternMPI_RmaSync::mpi_rma_lc_compute__cb(const pearl::CallbackManager& cb
                          << endl;
 #endif
                     // Search event of current lock owner preceeding previous owners unlock
-                    while (ce_it != current_epoch->rend()
+                    while (ce_it != current_epoch.mEvents.rend()
                           && (*ce_it)->getTimestamp() > (*ref_it)->getTimestamp())
                     {
                         ++ce_it;
                     }
 
-                    if ((ce_it != current_epoch->rend())
+                    if ((ce_it != current_epoch.mEvents.rend())
                         && ((*ce_it)->isOfType(ENTER)
                             || (*ce_it)->isOfType(MPI_RMA_LOCK)
                             || (*ce_it)->isOfType(MPI_RMA_PUT_START) // FIXME: this may have to be PUT_END!
@@ -5897,13 +5761,13 @@ void PatternMPI_RmaSync::mpi_rma_lc_compute__cb(const pearl::CallbackManager& cb
                             if((*ce_it)->isOfType(ENTER))
                             {
                                 //set iterator to ce_it
-                                RemoteRmaEpoch::iterator it = current_epoch->begin();
-                                while (it != current_epoch->end()
+                                RemoteRmaEpoch::iterator it = current_epoch.mEvents.begin();
+                                while (it != current_epoch.mEvents.end()
                                         && (*it)->getTimestamp() <= (*ce_it)->getTimestamp())
                                     ++it;
 
                                 //set it to MPI_RMA_LOCK, MPI_RMA_PUT_START or MPI_RMA_GET_START or MPI_RMA_UNLOCK
-                                while (it != current_epoch->end()
+                                while (it != current_epoch.mEvents.end()
                                         && !((*it)->isOfType(MPI_RMA_LOCK)
                                             || (*it)->isOfType(MPI_RMA_PUT_START)
                                             || (*it)->isOfType(MPI_RMA_GET_START)
@@ -6020,7 +5884,7 @@ void PatternMPI_RmaSync::mpi_rma_post_complete__cb(const pearl::CallbackManager&
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 500 "MPI_RMA.pattern"
+#line 482 "MPI_RMA.pattern"
 
       Event       enter       = event.enterptr();
       timestamp_t enter_time  = enter->getTimestamp();
@@ -6230,7 +6094,7 @@ void PatternMPI_RmaSyncLatePost::mpi_rma_late_post__cb(const pearl::CallbackMana
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 635 "MPI_RMA.pattern"
+#line 617 "MPI_RMA.pattern"
 
         Callpath* callpath = data->mDefs->get_cnode(data->mCallpathId);
 
@@ -6317,7 +6181,7 @@ void PatternMPI_RmaEarlyWait::mpi_rma_post_wait__cb(const pearl::CallbackManager
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 663 "MPI_RMA.pattern"
+#line 645 "MPI_RMA.pattern"
 
       Event       enter      = event.enterptr();
       timestamp_t enter_time = enter->getTimestamp();
@@ -6426,7 +6290,7 @@ void PatternMPI_RmaLateComplete::mpi_rma_early_wait__cb(const pearl::CallbackMan
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 715 "MPI_RMA.pattern"
+#line 697 "MPI_RMA.pattern"
 
       Event       enter      = event.enterptr();
       timestamp_t enter_time = enter->getTimestamp();
@@ -6515,7 +6379,7 @@ void PatternMPI_RmaWaitAtFence::mpi_rma_wait_at_fence__cb(const pearl::CallbackM
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 745 "MPI_RMA.pattern"
+#line 727 "MPI_RMA.pattern"
 
       m_severity[event.get_cnode()] += data->mIdle;
     
@@ -6597,7 +6461,7 @@ void PatternMPI_RmaEarlyFence::mpi_rma_early_fence__cb(const pearl::CallbackMana
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 768 "MPI_RMA.pattern"
+#line 750 "MPI_RMA.pattern"
 
       m_severity[event.get_cnode()] += data->mIdle;
     
@@ -6679,7 +6543,7 @@ void PatternMpi_RmaSyncLockContention::mpi_rma_lock_competition__cb(const pearl:
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 805 "MPI_RMA.pattern"
+#line 787 "MPI_RMA.pattern"
 
         Callpath* callpath = data->mDefs->get_cnode(data->mCallpathId);
 
@@ -6767,7 +6631,7 @@ void PatternMpi_RmaSyncWaitForProgress::mpi_rma_wait_for_progress__cb(const pear
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 833 "MPI_RMA.pattern"
+#line 815 "MPI_RMA.pattern"
 
         Callpath* callpath = data->mDefs->get_cnode(data->mCallpathId);
 
@@ -6854,7 +6718,7 @@ void PatternMPI_RmaCommLatePost::mpi_rma_late_post__cb(const pearl::CallbackMana
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 878 "MPI_RMA.pattern"
+#line 860 "MPI_RMA.pattern"
 
         Callpath* callpath = data->mDefs->get_cnode(data->mCallpathId);
 
@@ -6941,7 +6805,7 @@ void PatternMpi_RmaCommLockContention::mpi_rma_lock_competition__cb(const pearl:
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 904 "MPI_RMA.pattern"
+#line 886 "MPI_RMA.pattern"
 
         Callpath* callpath = data->mDefs->get_cnode(data->mCallpathId);
 
@@ -7029,7 +6893,7 @@ void PatternMpi_RmaCommWaitForProgress::mpi_rma_wait_for_progress__cb(const pear
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 932 "MPI_RMA.pattern"
+#line 914 "MPI_RMA.pattern"
 
         Callpath* callpath = data->mDefs->get_cnode(data->mCallpathId);
 
@@ -7116,7 +6980,7 @@ void PatternMPI_RmaPairsyncCount::mpi_rma_pws_count__cb(const pearl::CallbackMan
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 969 "MPI_RMA.pattern"
+#line 951 "MPI_RMA.pattern"
 
         m_severity[event.get_cnode()] += data->mCount;
     
@@ -7198,7 +7062,7 @@ void PatternMPI_RmaPairsyncUnneededCount::mpi_rma_pws_unneeded_count__cb(const p
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1000 "MPI_RMA.pattern"
+#line 982 "MPI_RMA.pattern"
 
         m_severity[event.get_cnode()] += data->mCount;
     
@@ -7223,7 +7087,7 @@ class PatternStatistics : public Pattern
     virtual ~PatternStatistics()
     {
 
-#line 1189 "Statistics.pattern"
+#line 1185 "Statistics.pattern"
 
     // Release statistics objects
 #if defined(_MPI)
@@ -7350,7 +7214,7 @@ class PatternStatistics : public Pattern
     virtual void init()
     {
 
-#line 1164 "Statistics.pattern"
+#line 1160 "Statistics.pattern"
 
     // Create statistics objects for MPI metrics
 #if defined(_MPI)
@@ -7380,7 +7244,7 @@ class PatternStatistics : public Pattern
 
   private:
 
-#line 68 "Statistics.pattern"
+#line 67 "Statistics.pattern"
 
     /// Symbolic names for entries in arrays storing upper bounds of metric
     /// durations
@@ -7403,6 +7267,28 @@ class PatternStatistics : public Pattern
       MAX_DURATION_ENTRIES
     };
 
+    /// Symbolic names for entries in the array storing the most severe
+    /// instances of individual patterns
+    enum instance_t {
+      LS_INSTANCES = 0,
+      LSW_INSTANCES,
+      LR_INSTANCES,
+      ER_INSTANCES,
+      WNXN_INSTANCES,
+      WB_INSTANCES,
+      NXNC_INSTANCES,
+      BC_INSTANCES,
+      LB_INSTANCES,
+      ES_INSTANCES,
+      OMP_EB_INSTANCES,
+      OMP_IB_INSTANCES,
+      THREAD_LC_OL_INSTANCES,
+      THREAD_LC_OC_INSTANCES,
+      THREAD_LC_PM_INSTANCES,
+      THREAD_LC_PC_INSTANCES,
+      INSTANCE_ENTRIES
+    };
+
     /// CallbackData struct used for preparation replay
     struct MaxDurations : public pearl::CallbackData
     {
@@ -7425,42 +7311,70 @@ class PatternStatistics : public Pattern
       }
     };
 
-    // returns the position with first identical cnode
-    class find_cnode_position
+    /// Instances of collective patterns recorded during the replay, whose
+    /// idle times still have to be combined across all participants
+    struct PendingCollectives
     {
-      public:
-        find_cnode_position (pearl::ident_t n)
-        : cnode(n)
-        {}
+      vector<TopMostSevereMaxSum> m_instances;
+      vector<uint32_t>            m_targets;
 
-        bool operator() (TopMostSevere element) const
-        {
-          return element.cnode == cnode;
-        }
+      void add(instance_t target, const TopMostSevereMaxSum& instance)
+      {
+        m_instances.push_back(instance);
+        m_targets.push_back(target);
+      }
 
-      private:
-        pearl::ident_t cnode;
-    };
+      void clear()
+      {
+        m_instances.clear();
+        m_targets.clear();
+      }
 
-    // returns the position of first element with cnode not in this list and 
-    // bigger idletime
-    class find_idletime_position
-    {
-      public:
-        find_idletime_position (pearl::ident_t n, pearl::timestamp_t m)
-        : cnode(n), idle (m)
-        {}
+      // merges the instances recorded by another thread of the same
+      // process, preserving the order of the enter timestamps (i.e., the
+      // order in which the collective operations have been called)
+      void merge(const PendingCollectives& other)
+      {
+        vector<TopMostSevereMaxSum> instances;
+        vector<uint32_t>            targets;
+        instances.reserve(m_instances.size() + other.m_instances.size());
+        targets.reserve(m_targets.size() + other.m_targets.size());
 
-        bool operator() (TopMostSevere element) const
-        {
-          return ((element.cnode != cnode) && (element.idletime < idle));
+        size_t i = 0;
+        size_t j = 0;
+        while (i < m_instances.size() || j < other.m_instances.size()) {
+          if (j == other.m_instances.size()
+              || (i < m_instances.size()
+                  && m_instances[i].entertime <= other.m_instances[j].entertime)) {
+            instances.push_back(m_instances[i]);
+            targets.push_back(m_targets[i]);
+            ++i;
+          } else {
+            instances.push_back(other.m_instances[j]);
+            targets.push_back(other.m_targets[j]);
+            ++j;
+          }
         }
+        m_instances.swap(instances);
+        m_targets.swap(targets);
+      }
+    };
+
+#if defined(_MPI)
+    /// Pending collective instances of a particular MPI communicator
+    struct PendingMpiCollectives : public PendingCollectives
+    {
+      pearl::MpiComm* m_comm;
 
-      private:
-        pearl::ident_t cnode;
-        pearl::timestamp_t idle;
+      PendingMpiCollectives()
+        : m_comm(NULL)
+      {
+      }
     };
 
+    typedef map<pearl::ident_t, PendingMpiCollectives> PendingMpiMap;
+#endif // _MPI
+
     void mpicollective_cb(const pearl::CallbackManager& cbmanager,
                           int                           user_event,
                           const pearl::Event&           event,
@@ -7596,255 +7510,87 @@ class PatternStatistics : public Pattern
     Quantile* thread_lc_pc_quant;
 #endif // (_OPENMP)
 
-    // define deques for most severe instances
+    // most severe instances per pattern
+    TopMostSevereHeap most_severe[INSTANCE_ENTRIES];
+
 #if defined(_MPI)
-    vector<TopMostSevere> LateSender, LateSenderWO, LateReceiver, EarlyReduce;
-    vector<TopMostSevere> BarrierNxN, Barrier, NxnCompl, BarrierCompl, LateBcast, EarlyScan;
+    // collective instances to be resolved per communicator (ordered by ID)
+    PendingMpiMap pending_mpi;
 #endif // _MPI
 
     static MaxDurations sharedDurations;
 
 #if defined(_OPENMP)
-    vector<TopMostSevere> OmpEBarrier, OmpIBarrier;
-    vector<TopMostSevere> ThreadLockContentionOMPLockAPI;
-    vector<TopMostSevere> ThreadLockContentionOMPCritical;
-    vector<TopMostSevere> ThreadLockContentionPthreadMutex;
-    vector<TopMostSevere> ThreadLockContentionPthreadCondition;
-
-    static vector<TopMostSevere> sharedLC_OL;
-    static vector<TopMostSevere> sharedLC_OC;
-    static vector<TopMostSevere> sharedLC_PM;
-    static vector<TopMostSevere> sharedLC_PC;
-
-    static TopMostSevereMaxSum sharedMaxSum;
-
+    // OpenMP barrier instances to be resolved across the thread team
+    PendingCollectives pending_omp;
 
-    // merges thread local TopMostSevere vectors into a shared one using the stat_collector method
-    void result_merge_thread_topmost(vector<TopMostSevere> &sharedInst,  vector<TopMostSevere> inst)
-    {
-        #pragma omp critical
-        {
-          for (size_t i=0; i< inst.size();i++)
-          {
-            stat_collector(sharedInst,inst[i].idletime,
-                                      inst[i].entertime,
-                                      inst[i].exittime,
-                                      inst[i].cnode,
-                                      inst[i].rank);
-          }
-        }
-    }
+    static vector<PatternStatistics*> sharedTeam;
 #endif // _OPENMP
     
     // merge results of found patterns
-    // from all processes and threads 
-    // static variables used here as an implicit shared variables
-    // to perform reduction for OpenMP threads
-    void result_merge(Quantile* quant)
-    {
-      // Determine global number of instances
-      // (The 'static' variable 'shared_n' is implicitly shared!)
-      double n, global_n;
-      static double shared_n;
-      #pragma omp master
-      {
-        shared_n = 0.0;
-      }
-      
-      // Determine global coefficients for collecting statistics
-      // (The 'static' array 'shared_coeff' is implicitly shared!)
-      double coeff[NUMBER_COEFF], global_coeff[NUMBER_COEFF];
-      static double shared_coeff[NUMBER_COEFF];
-
-      #pragma omp master
-      {
+    // from all processes and threads, reducing the values of all
+    // statistics collectors at once
+    void result_merge(const vector<Quantile*>& quants)
+    {
+      const size_t num_quants = quants.size();
+
+      // Determine global number of instances (required to weight the
+      // coefficients)
+      ReductionBundle bundle;
+      for (size_t q = 0; q < num_quants; ++q) {
+        bundle.add(ReductionBundle::SUM, quants[q]->get_n());
+      }
+      bundle.flush();
+
+      // Determine global coefficients, control values, max, min, sum, and
+      // squared sum
+      vector<uint32_t> handles(num_quants);
+      for (size_t q = 0; q < num_quants; ++q) {
+        Quantile* quant    = quants[q];
+        double    n        = quant->get_n();
+        double    global_n = bundle.getValue(q);
+
+        handles[q] = bundle.add(ReductionBundle::MAX, quant->get_max_val());
+        bundle.add(ReductionBundle::MIN, quant->get_min_val());
+        bundle.add(ReductionBundle::SUM, quant->get_sum());
+        bundle.add(ReductionBundle::SUM, quant->get_squared_sum());
         for (int i = 0; i < NUMBER_COEFF; i++) {
-          shared_coeff[i] = 0.0;
+          bundle.add(ReductionBundle::SUM, (n/global_n) * quant->get_coeff(i));
         }
-      }
-
 #ifdef ADAPTIVE_APPROACH
-      // Determine global coefficients for control values
-      // (The 'static' array 'shared_control_val' is implicitly shared!)
-      double control_val[NUMBER_COEFF], global_control_val[NUMBER_COEFF];
-      static double shared_control_val[NUMBER_COEFF];
-    
-      #pragma omp master
-      {
         for (int i = 0; i < NUMBER_COEFF; i++) {
-          shared_control_val[i] = 0.0;
+          bundle.add(ReductionBundle::SUM, (n/global_n) * quant->get_control_val(i));
         }
-      }
 #endif
-
-      // Determine global max
-      // (The 'static' variable 'shared_max' is implicitly shared!)
-      double max_val, global_max;
-      static double shared_max;
-      #pragma omp master
-      {
-        shared_max = -DBL_MAX;
-      }
-      
-      // Determine global min
-      // (The 'static' variable 'shared_min' is implicitly shared!)
-      double min_val, global_min;
-      static double shared_min;
-      #pragma omp master
-      {
-        shared_min = DBL_MAX;
       }
+      bundle.flush();
 
-      // Determine global sum
-      // (The 'static' variable 'shared_sum' is implicitly shared!)
-      double sum, global_sum;
-      static double shared_sum;
-      #pragma omp master
-      {
-        shared_sum = 0.0;
-      }
+      for (size_t q = 0; q < num_quants; ++q) {
+        uint32_t handle             = handles[q];
+        double   global_n           = bundle.getValue(q);
+        double   global_max         = bundle.getValue(handle++);
+        double   global_min         = bundle.getValue(handle++);
+        double   global_sum         = bundle.getValue(handle++);
+        double   global_squared_sum = bundle.getValue(handle++);
 
-      // Determine global squared sum
-      // (The 'static' variable 'shared_squared_sum' is implicitly shared!)
-      double squared_sum, global_squared_sum;
-      static double shared_squared_sum;
-      #pragma omp master
-      {
-        shared_squared_sum = 0.0;
-      }
-      
-      n = quant->get_n();
-      
-      #pragma omp barrier
-      #pragma omp critical
-      {
-        shared_n += n;
+        double global_coeff[NUMBER_COEFF];
+        for (int i = 0; i < NUMBER_COEFF; i++) {
+          global_coeff[i] = bundle.getValue(handle++);
+        }
+#ifdef ADAPTIVE_APPROACH
+        double global_control_val[NUMBER_COEFF];
+        for (int i = 0; i < NUMBER_COEFF; i++) {
+          global_control_val[i] = bundle.getValue(handle++);
+        }
+
+        quants[q]->set_global_values(global_n, global_sum, global_squared_sum, global_min, global_max, global_coeff, global_control_val);
+#else
+        quants[q]->set_global_values(global_n, global_sum, global_squared_sum, global_min, global_max, global_coeff);
+#endif
       }
-      #pragma omp barrier
-      
-#if defined(_MPI)
-      #pragma omp master
-      {
-        MPI_Allreduce(&shared_n, &global_n, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-        shared_n = global_n;
-      }
-#endif // _MPI
-      
-      #pragma omp barrier
-      global_n = shared_n;
-      #pragma omp barrier
-
-      for(int i=0; i<NUMBER_COEFF; i++) {
-        coeff[i] = (n/global_n) * quant->get_coeff(i);
-      }
-      
-      #pragma omp barrier
-      #pragma omp critical
-      {
-        for (int i = 0; i < NUMBER_COEFF; i++) {
-          shared_coeff[i] += coeff[i];
-        }
-      }
-      #pragma omp barrier
-      
-#if defined(_MPI)
-      #pragma omp master
-      {
-        MPI_Allreduce(shared_coeff, global_coeff, NUMBER_COEFF, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-        for (int i = 0; i < NUMBER_COEFF; i++) {
-          shared_coeff[i] = global_coeff[i];
-        }
-      }
-#endif // _MPI
-
-      #pragma omp barrier
-      for (int i = 0; i < NUMBER_COEFF; i++) {
-        global_coeff[i] = shared_coeff[i];
-      }
-
-#ifdef ADAPTIVE_APPROACH    
-      for(int i=0; i<NUMBER_COEFF; i++) {
-        control_val[i] = (n/global_n) * quant->get_control_val(i);
-      }
-      
-      #pragma omp barrier
-      #pragma omp critical
-      {
-        for (int i = 0; i < NUMBER_COEFF; i++) {
-          shared_control_val[i] += control_val[i];
-        }
-      }
-      #pragma omp barrier
-#if defined(_MPI)
-      #pragma omp master
-      {
-        MPI_Allreduce(shared_control_val, global_control_val, NUMBER_COEFF, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-        for (int i = 0; i < NUMBER_COEFF; i++) {
-          shared_control_val[i] = global_control_val[i];
-        }
-      }
-#endif // _MPI
-
-      #pragma omp barrier
-      for (int i = 0; i < NUMBER_COEFF; i++) {
-        global_control_val[i] = shared_control_val[i];
-      }
-
-#endif    
-
-      max_val     = quant->get_max_val();
-      min_val     = quant->get_min_val();
-      sum         = quant->get_sum();
-      squared_sum = quant->get_squared_sum();
-
-      #pragma omp barrier
-      
-      #pragma omp critical
-      {
-        if(shared_max < max_val)
-        {
-          shared_max = max_val;
-        }
-      
-        if(shared_min > min_val)
-        {
-          shared_min = min_val;
-        }
-      
-        shared_sum += sum;
-        shared_squared_sum += squared_sum;
-      }
-      #pragma omp barrier
-      
-#if defined(_MPI)
-      #pragma omp master
-      {
-        MPI_Allreduce(&shared_max, &global_max, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-        MPI_Allreduce(&shared_min, &global_min, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
-        MPI_Allreduce(&shared_sum, &global_sum, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-        MPI_Allreduce(&shared_squared_sum, &global_squared_sum, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-        shared_max = global_max;
-        shared_min = global_min;
-        shared_sum = global_sum;
-        shared_squared_sum = global_squared_sum;
-      }
-#endif // _MPI
-
-      #pragma omp barrier
-      global_max = shared_max;
-      global_min = shared_min;
-      global_sum = shared_sum;
-      global_squared_sum = shared_squared_sum;
-      #pragma omp barrier
-      
-#ifdef ADAPTIVE_APPROACH
-      quant->set_global_values(global_n, global_sum, global_squared_sum, global_min, global_max, global_coeff, global_control_val);
-#else      
-      quant->set_global_values(global_n, global_sum, global_squared_sum, global_min, global_max, global_coeff);
-#endif
     }
 
-    void write_cube_file(Quantile* quant, vector<TopMostSevere>& instance, ReportData& data, FILE* cube_fp)
+    void write_cube_file(Quantile* quant, const TopMostSevereHeap& heap, ReportData& data, FILE* cube_fp)
     {
       string patternName     = quant->get_metric();
       double number_obs      = quant->get_n();
@@ -7865,12 +7611,12 @@ class PatternStatistics : public Pattern
         if (number_obs >= 5)
           fprintf(cube_fp, " %1.10f %1.10f", lower_quant, upper_quant);
 
-        unsigned int i = 0;
-        if (instance[i].idletime > 0.0)
+        TopMostSevereHeap::InstanceList instance;
+        heap.getSorted(instance);
+        if (!instance.empty())
           fprintf(cube_fp, "\n");
-        while (i < instance.size() && instance[i].idletime > 0.0) {
+        for (size_t i = 0; i < instance.size(); ++i) {
             fprintf(cube_fp, "- cnode %d enter: %1.10f exit: %1.10f duration: %1.10f rank: %d\n",data.cnodes[instance[i].cnode]->id, instance[i].entertime, instance[i].exittime, instance[i].idletime, instance[i].rank);
-          i++;
         }
 
         fprintf(cube_fp, "\n");
@@ -7938,239 +7684,268 @@ class PatternStatistics : public Pattern
 
 #endif
 
-    // This function performs insertion
-    // sort of array of structs, where 
-    // arr - input array to be sorted
-    // len - length of the array to be sorted
-    void insertionSort(TopMostSevere* arr, int len)
-    {
-      int j;
-      TopMostSevere tmp;
-      for (int i = 1; i < len; i++) {
-        j = i;
-        while (j > 0 && arr[j - 1].idletime < arr[j].idletime) {
-          tmp        = arr[j];
-          arr[j]     = arr[j - 1];
-          arr[j - 1] = tmp;
-          j--;
-        }
-      }
-    }
-
-    // This function inserts an element 
-    // into the sorted vector of structures
-    // and shifts the rest elements, where
-    // in    - First input array
-    // inout - Second input array, also storing the result
-    // i     - the id of the element which should be inserted
-    // j     - pointer to the position where the structure should be inserted
-    // len   - length of the vestor os structures
-    void insertAndShift(TopMostSevere* invec, TopMostSevere* inoutvec, int i, int& j, int& len)
-    {
-      //shift
-      std::memmove(&inoutvec[j + 1], &inoutvec[j], (len - j - 1) * sizeof(TopMostSevere));
-      //insert
-      inoutvec[j] = invec[i];
-    }
-
 #if defined(_MPI)
-    // performs reduction to compute
-    // the top most severe instsnces
-    void result_top_most(vector<TopMostSevere>& instance, TopMostSevere  * tmpRecv)
+    // merges the most severe instances of all patterns from all processes
+    // on rank 0 using a single reduction
+    void result_merge_most_severe()
     {
-      int len_sum;
-      int len = instance.size();
-      // check if one needs to make reduction
-      MPI_Allreduce(&len, &len_sum, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-      if (len_sum > 0) {
-        if (instance.size() < TOP_SEVERE_INSTANCES) {
-          if (len > 1) {
-            insertionSort(&instance[0], len);
-          }
-          for (int i = TOP_SEVERE_INSTANCES - instance.size(); i > 0; i--) {
-            instance.push_back(TopMostSevere());
-          }
-        }
+      vector<TopMostSevere> sendBuf(INSTANCE_ENTRIES * TOP_SEVERE_INSTANCES);
+      vector<TopMostSevere> recvBuf(INSTANCE_ENTRIES * TOP_SEVERE_INSTANCES);
+      for (int idx = 0; idx < INSTANCE_ENTRIES; ++idx) {
+        const TopMostSevereHeap::InstanceList& inst = most_severe[idx].getInstances();
+        copy(inst.begin(), inst.end(), sendBuf.begin() + idx * TOP_SEVERE_INSTANCES);
+      }
 
-        // define global rank
-        int rank;
-        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Reduce(&sendBuf[0], &recvBuf[0], INSTANCE_ENTRIES, TOPSEVEREARRAY,
+                 MAX_TOPSEVEREARRAY, 0, MPI_COMM_WORLD);
 
-        MPI_Reduce(&instance[0], &tmpRecv[0], 1, TOPSEVEREARRAY,
-                   MAX_TOPSEVEREARRAY, 0, MPI_COMM_WORLD);
-        
-        if (rank == 0) {
+      int rank;
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      if (rank == 0) {
+        for (int idx = 0; idx < INSTANCE_ENTRIES; ++idx) {
+          most_severe[idx].clear();
           for (int i = 0; i < TOP_SEVERE_INSTANCES; ++i) {
-            instance[i] = tmpRecv[i];
+            most_severe[idx].insert(recvBuf[idx * TOP_SEVERE_INSTANCES + i]);
           }
         }
       }
     }
 #endif // _MPI
 
-    // collects and keep sorted
-    // most severe instances
+    // collects most severe instances
     // with different cnodes
-    void stat_collector(vector<TopMostSevere> &instance, pearl::timestamp_t idle, pearl::timestamp_t enter, pearl::timestamp_t exit, pearl::ident_t cnode, pearl::ident_t rank)
+    void stat_collector(instance_t idx, pearl::timestamp_t idle, pearl::timestamp_t enter, pearl::timestamp_t exit, pearl::ident_t cnode, pearl::ident_t rank)
     {
-      TopMostSevere tmp;
-      vector<TopMostSevere>::iterator iter_cnode, iter_idle;
-      int pos_cnode, pos_idle, len;
-      tmp = TopMostSevere(idle, enter, exit, cnode, rank);
-      
-      // if our vector buffer is not full
-      if (instance.size() < TOP_SEVERE_INSTANCES) {
-        // first severity data is inserted without any conditions
-        if (instance.empty()) {
-          instance.push_back(TopMostSevere(idle,enter,exit,cnode, rank));
-        }
-        // if it is not the first one, we have to check further conditions
-        else {
-          // find the position of the severity item with an identical "cnode" value
-          iter_cnode = find_if(instance.begin(), instance.end(), find_cnode_position(cnode));
-          pos_cnode = (int) (iter_cnode - instance.begin());
-          
-          // if we have severity with such "cnode" value and greater "idletime"
-          // then we update data with new values of time
-          if (((unsigned int)pos_cnode != instance.size()) && (idle > instance[pos_cnode].idletime)) {
-            instance[pos_cnode] = tmp;
-          }
-          // if we've not found any sevirity item with identical "cnode" value
-          // it will be inserted into the vector
-          else if ((unsigned int)pos_cnode == instance.size()) {
-            instance.push_back(TopMostSevere(idle,enter,exit,cnode,rank));
-            // if the maximum value of severities was reached, sort the vector due to "idletime"
-            if (instance.size() == TOP_SEVERE_INSTANCES) {
-              insertionSort(&instance[0], instance.size());
-            }
-          }
-        }
-      }
-      // now our vector buffer is full
-      else {
-        len = instance.size();
-        
-        // find the position of the severity item with an identical "cnode" value
-        iter_cnode = find_if(instance.begin(), instance.end(), find_cnode_position(cnode));
-        pos_cnode = (int) (iter_cnode - instance.begin());
-        
-        // find the position of the severity item with not identical "cnode" and greater "idletime"
-        iter_idle = find_if(instance.begin(), instance.end(), find_idletime_position(cnode, idle));
-        pos_idle = (int) (iter_idle - instance.begin());
-        
-        // update the values if our next item with the same "cnode" has greater "idletime"
-        // and sort it afterwards due to "idletime"
-        if (((unsigned int)pos_cnode != instance.size()) && (idle > instance[pos_cnode].idletime)) {
-          instance[pos_cnode] = tmp;
-          insertionSort(&instance[0], len);
-        }
-        // if we found the severity with a new "cnode" vlue and greater "idletime"
-        // then the vector will be shifted
-        else if (((unsigned int)pos_idle != instance.size()) && ((unsigned int)pos_cnode == instance.size())) {  
-          insertAndShift(&tmp, &instance[0], 0, pos_idle, len);
-        }
-      }
+      most_severe[idx].insert(TopMostSevere(idle, enter, exit, cnode, rank));
     }
-    
-#if defined(_MPI)
-    // performs MPI reduction of idletime, enter and exit times
-    // of most severe instances for collective operations
-    void stat_collective(vector<TopMostSevere> &inst, pearl::timestamp_t idle, pearl::timestamp_t enter, pearl::timestamp_t exit, pearl::ident_t cnode, pearl::ident_t global_rank, MpiComm* comm)
+
+    // collects the combined instance of a collective operation
+    void stat_collector(instance_t idx, const TopMostSevereMaxSum& inst)
     {
-      // define local rank
-      int local_rank;
-      MPI_Comm_rank(comm->getComm(), &local_rank);
-      
-      TopMostSevereMaxSum tmpSend, tmpRecv;
-      tmpSend = TopMostSevereMaxSum(idle, idle, enter, exit, cnode, global_rank);
-      
-      MPI_Reduce(&tmpSend, &tmpRecv, 1, TOPSEVERECOLL, MAXSUM_TOPSEVERECOLL, 0, comm->getComm());
-      
-      if (local_rank == 0) {
 #if !defined(MOST_SEVERE_MAX)
-        stat_collector(inst, tmpRecv.idletime, tmpRecv.entertime, tmpRecv.exittime, tmpRecv.cnode, tmpRecv.rank);
+      stat_collector(idx, inst.idletime, inst.entertime, inst.exittime, inst.cnode, inst.rank);
 #else
-        stat_collector(inst, tmpRecv.idletime_max, tmpRecv.entertime, tmpRecv.exittime, tmpRecv.cnode, tmpRecv.rank);
+      stat_collector(idx, inst.idletime_max, inst.entertime, inst.exittime, inst.cnode, inst.rank);
 #endif
+    }
+
+#if defined(_MPI)
+    // records the idletime, enter and exit times of an instance of a
+    // collective operation; the values are combined across the
+    // communicator by resolve_mpi_collectives() after the replay (in
+    // hybrid analyses, the instances recorded by other threads are first
+    // gathered on the master thread by resolve_omp_collectives())
+    void stat_collective(instance_t idx, pearl::timestamp_t idle, pearl::timestamp_t enter, pearl::timestamp_t exit, pearl::ident_t cnode, pearl::ident_t global_rank, MpiComm* comm)
+    {
+      PendingMpiCollectives& pending = pending_mpi[comm->getId()];
+      pending.m_comm = comm;
+      pending.add(idx, TopMostSevereMaxSum(idle, idle, enter, exit, cnode, global_rank));
+    }
+
+    // performs MPI reduction of idletime, enter and exit times of all
+    // recorded instances of collective operations, using a single
+    // reduction per communicator
+    void resolve_mpi_collectives()
+    {
+      // All processes visit their communicators in the same (global ID)
+      // order, thus the reductions cannot deadlock
+      for (PendingMpiMap::iterator it = pending_mpi.begin(); it != pending_mpi.end(); ++it) {
+        PendingMpiCollectives& pending = it->second;
+        MPI_Comm comm  = pending.m_comm->getComm();
+        int      count = pending.m_instances.size();
+
+        int local_rank;
+        MPI_Comm_rank(comm, &local_rank);
+
+        vector<TopMostSevereMaxSum> result(count);
+        MPI_Reduce(&pending.m_instances[0], &result[0], count, TOPSEVERECOLL,
+                   MAXSUM_TOPSEVERECOLL, 0, comm);
+
+        if (local_rank == 0) {
+          for (int i = 0; i < count; ++i) {
+            stat_collector(instance_t(pending.m_targets[i]), result[i]);
+          }
+        }
       }
+      pending_mpi.clear();
     }
 #endif // _MPI
 
 #if defined(_OPENMP)
-    // performs OpenMP reduction of idletime, enter and exit times
-    // of most severe instances for collective operations
-    void stat_collective(vector<TopMostSevere> &inst, pearl::timestamp_t idle, pearl::timestamp_t enter, pearl::timestamp_t exit, pearl::ident_t cnode, pearl::ident_t rank)
+    // records the idletime, enter and exit times of an instance of an
+    // OpenMP barrier; the values are combined across the thread team by
+    // resolve_omp_collectives() after the replay
+    void stat_collective(instance_t idx, pearl::timestamp_t idle, pearl::timestamp_t enter, pearl::timestamp_t exit, pearl::ident_t cnode, pearl::ident_t rank)
+    {
+      pending_omp.add(idx, TopMostSevereMaxSum(idle, idle, enter, exit, cnode, rank));
+    }
+
+    // performs OpenMP reduction of idletime, enter and exit times of all
+    // recorded barrier instances (in thread order) and merges the most
+    // severe instances of all threads; in hybrid analyses, also gathers
+    // the pending MPI collective instances of all threads on the master
+    // thread; has to be called by all threads
+    void resolve_omp_collectives()
     {
-      #pragma omp barrier
       #pragma omp master
       {
-        sharedMaxSum = TopMostSevereMaxSum(-DBL_MAX,0.0,DBL_MAX,-DBL_MAX,cnode,rank);
+        sharedTeam.assign(omp_get_num_threads(), NULL);
       }
       #pragma omp barrier
-      #pragma omp critical
-      {
-        sharedMaxSum.idletime += idle;
-        
-        if(sharedMaxSum.entertime > enter)
-          sharedMaxSum.entertime = enter;
-        
-        if(sharedMaxSum.exittime < exit)
-          sharedMaxSum.exittime = exit;
-          
-        if(sharedMaxSum.idletime_max < idle) {
-          sharedMaxSum.idletime_max = idle;
-          sharedMaxSum.rank = rank;
-        }
-      }      
+      sharedTeam[omp_get_thread_num()] = this;
       #pragma omp barrier
-      
+
       #pragma omp master
       {
-#if !defined(MOST_SEVERE_MAX)
-        stat_collector(inst, sharedMaxSum.idletime, sharedMaxSum.entertime, sharedMaxSum.exittime, sharedMaxSum.cnode, sharedMaxSum.rank);
-#else
-        stat_collector(inst, sharedMaxSum.idletime_max, sharedMaxSum.entertime, sharedMaxSum.exittime, sharedMaxSum.cnode, sharedMaxSum.rank);
-#endif
+        vector<TopMostSevereMaxSum>& result = pending_omp.m_instances;
+        for (size_t t = 1; t < sharedTeam.size(); ++t) {
+          const vector<TopMostSevereMaxSum>& contrib = sharedTeam[t]->pending_omp.m_instances;
+          assert(contrib.size() == result.size());
+
+          for (size_t i = 0; i < result.size(); ++i) {
+            result[i].idletime += contrib[i].idletime;
+
+            if (result[i].entertime > contrib[i].entertime)
+              result[i].entertime = contrib[i].entertime;
+
+            if (result[i].exittime < contrib[i].exittime)
+              result[i].exittime = contrib[i].exittime;
+
+            if (result[i].idletime_max < contrib[i].idletime_max) {
+              result[i].idletime_max = contrib[i].idletime_max;
+              result[i].rank = contrib[i].rank;
+            }
+          }
+        }
+        for (size_t i = 0; i < result.size(); ++i) {
+          stat_collector(instance_t(pending_omp.m_targets[i]), result[i]);
+        }
+
+        // merge thread-local most severe instances
+        for (size_t t = 1; t < sharedTeam.size(); ++t) {
+          for (int idx = 0; idx < INSTANCE_ENTRIES; ++idx) {
+            most_severe[idx].merge(sharedTeam[t]->most_severe[idx]);
+          }
+        }
+
+#if defined(_MPI)
+        // gather MPI collective instances replayed by other threads (i.e.,
+        // with '--thread-multiple'), such that all instances of a
+        // communicator are reduced by the master in call order
+        for (size_t t = 1; t < sharedTeam.size(); ++t) {
+          PendingMpiMap& contrib = sharedTeam[t]->pending_mpi;
+          for (PendingMpiMap::iterator it = contrib.begin(); it != contrib.end(); ++it) {
+            PendingMpiCollectives& pending = pending_mpi[it->first];
+            pending.m_comm = it->second.m_comm;
+            pending.merge(it->second);
+          }
+          contrib.clear();
+        }
+#endif // _MPI
       }
-      
+      #pragma omp barrier
+
+      pending_omp.clear();
     }
 #endif // _OPENMP
 
+    // stores the most severe instances in a checkpoint buffer
+    void pack_instances(pearl::Buffer& buffer, const TopMostSevereHeap& heap) const
+    {
+      const TopMostSevereHeap::InstanceList& inst = heap.getInstances();
+      buffer.put_uint32(inst.size());
+      for (size_t i = 0; i < inst.size(); ++i) {
+        buffer.putTimestamp(inst[i].idletime);
+        buffer.putTimestamp(inst[i].entertime);
+        buffer.putTimestamp(inst[i].exittime);
+        buffer.put_id(inst[i].cnode);
+        buffer.put_id(inst[i].rank);
+      }
+    }
+
+    // restores the most severe instances from a checkpoint buffer
+    void unpack_instances(pearl::Buffer& buffer, TopMostSevereHeap& heap)
+    {
+      heap.clear();
+
+      uint32_t count = buffer.get_uint32();
+      for (uint32_t i = 0; i < count; ++i) {
+        TopMostSevere inst;
+        inst.idletime  = buffer.getTimestamp();
+        inst.entertime = buffer.getTimestamp();
+        inst.exittime  = buffer.getTimestamp();
+        inst.cnode     = buffer.get_id();
+        inst.rank      = buffer.get_id();
+        heap.insert(inst);
+      }
+    }
+
+    // stores unresolved collective instances in a checkpoint buffer
+    void pack_pending(pearl::Buffer& buffer, const PendingCollectives& pending) const
+    {
+      buffer.put_uint32(pending.m_instances.size());
+      for (size_t i = 0; i < pending.m_instances.size(); ++i) {
+        const TopMostSevereMaxSum& inst = pending.m_instances[i];
+        buffer.put_uint32(pending.m_targets[i]);
+        buffer.putTimestamp(inst.idletime_max);
+        buffer.putTimestamp(inst.idletime);
+        buffer.putTimestamp(inst.entertime);
+        buffer.putTimestamp(inst.exittime);
+        buffer.put_id(inst.cnode);
+        buffer.put_id(inst.rank);
+      }
+    }
+
+    // restores unresolved collective instances from a checkpoint buffer
+    void unpack_pending(pearl::Buffer& buffer, PendingCollectives& pending)
+    {
+      pending.clear();
+
+      uint32_t count = buffer.get_uint32();
+      for (uint32_t i = 0; i < count; ++i) {
+        instance_t          target = instance_t(buffer.get_uint32());
+        TopMostSevereMaxSum inst;
+        inst.idletime_max = buffer.getTimestamp();
+        inst.idletime     = buffer.getTimestamp();
+        inst.entertime    = buffer.getTimestamp();
+        inst.exittime     = buffer.getTimestamp();
+        inst.cnode        = buffer.get_id();
+        inst.rank         = buffer.get_id();
+        pending.add(target, inst);
+      }
+    }
+
 
     public:
       void gen_severities(ReportData&              data,
                           int                      rank,
                           const pearl::LocalTrace& trace)
       {
-#if defined(_MPI)
-        result_merge(ls_quant);
-        result_merge(lsw_quant);
-        result_merge(lr_quant);
-        result_merge(wnxn_quant);
-        result_merge(wb_quant);
-        result_merge(er_quant);
-        result_merge(es_quant);
-        result_merge(lb_quant);
-        result_merge(bc_quant);
-        result_merge(nxnc_quant);
+        vector<Quantile*> quants;
+#if defined(_MPI)
+        quants.push_back(ls_quant);
+        quants.push_back(lsw_quant);
+        quants.push_back(lr_quant);
+        quants.push_back(wnxn_quant);
+        quants.push_back(wb_quant);
+        quants.push_back(er_quant);
+        quants.push_back(es_quant);
+        quants.push_back(lb_quant);
+        quants.push_back(bc_quant);
+        quants.push_back(nxnc_quant);
 #endif // _MPI
 #if defined(_OPENMP)
-        result_merge(omp_eb_quant);
-        result_merge(omp_ib_quant);
-        result_merge(thread_lc_ol_quant);
-        result_merge(thread_lc_oc_quant);
-        result_merge(thread_lc_pm_quant);
-        result_merge(thread_lc_pc_quant);
+        quants.push_back(omp_eb_quant);
+        quants.push_back(omp_ib_quant);
+        quants.push_back(thread_lc_ol_quant);
+        quants.push_back(thread_lc_oc_quant);
+        quants.push_back(thread_lc_pm_quant);
+        quants.push_back(thread_lc_pc_quant);
 #endif
+        result_merge(quants);
 
 #if defined(_OPENMP)
-        #pragma omp barrier
-        result_merge_thread_topmost(sharedLC_OL, ThreadLockContentionOMPLockAPI);
-        result_merge_thread_topmost(sharedLC_OC, ThreadLockContentionOMPCritical);
-        result_merge_thread_topmost(sharedLC_PM, ThreadLockContentionPthreadMutex);
-        result_merge_thread_topmost(sharedLC_PC, ThreadLockContentionPthreadCondition);
-
-        #pragma omp barrier
+        resolve_omp_collectives();
 #endif // _OPENMP
 
         #pragma omp master
@@ -8337,30 +8112,8 @@ class PatternStatistics : public Pattern
 
           // Merge results for each pattern
 #if defined(_MPI)
-          // define temporary receive buffer 
-          TopMostSevere * tmpRecv;
-          tmpRecv = new TopMostSevere[TOP_SEVERE_INSTANCES];
-
-          result_top_most(LateSender, tmpRecv);
-          result_top_most(LateSenderWO, tmpRecv);
-          result_top_most(LateReceiver, tmpRecv);
-          result_top_most(EarlyReduce, tmpRecv);
-          result_top_most(BarrierNxN, tmpRecv);
-          result_top_most(Barrier, tmpRecv);
-          result_top_most(NxnCompl, tmpRecv);
-          result_top_most(BarrierCompl, tmpRecv);
-          result_top_most(LateBcast, tmpRecv);
-          result_top_most(EarlyScan, tmpRecv);
-#if defined(_OPENMP)
-          result_top_most(OmpEBarrier, tmpRecv);
-          result_top_most(OmpIBarrier, tmpRecv);
-          result_top_most(sharedLC_OL, tmpRecv);
-          result_top_most(sharedLC_OC, tmpRecv);
-          result_top_most(sharedLC_PM, tmpRecv);
-          result_top_most(sharedLC_PC, tmpRecv);
-#endif // _OPENMP
-          // free temporary receive buffer 
-          delete [] tmpRecv;
+          resolve_mpi_collectives();
+          result_merge_most_severe();
 #endif // _MPI
 
           if (rank == 0) {
@@ -8378,69 +8131,69 @@ class PatternStatistics : public Pattern
 #if defined(_MPI)
               ls_quant->set_metric("mpi_latesender");
               ls_quant->calc_quantiles();
-              write_cube_file(ls_quant, LateSender, data, cube_fp);
+              write_cube_file(ls_quant, most_severe[LS_INSTANCES], data, cube_fp);
 
               lsw_quant->set_metric("mpi_latesender_wo");
               lsw_quant->calc_quantiles();
-              write_cube_file(lsw_quant, LateSenderWO, data, cube_fp);
+              write_cube_file(lsw_quant, most_severe[LSW_INSTANCES], data, cube_fp);
 
               lr_quant->set_metric("mpi_latereceiver");
               lr_quant->calc_quantiles();
-              write_cube_file(lr_quant, LateReceiver, data, cube_fp);
+              write_cube_file(lr_quant, most_severe[LR_INSTANCES], data, cube_fp);
 
               wnxn_quant->set_metric("mpi_wait_nxn");
               wnxn_quant->calc_quantiles();
-              write_cube_file(wnxn_quant, BarrierNxN, data, cube_fp);
+              write_cube_file(wnxn_quant, most_severe[WNXN_INSTANCES], data, cube_fp);
 
               wb_quant->set_metric("mpi_barrier_wait");
               wb_quant->calc_quantiles();
-              write_cube_file(wb_quant, Barrier, data, cube_fp);
+              write_cube_file(wb_quant, most_severe[WB_INSTANCES], data, cube_fp);
 
               er_quant->set_metric("mpi_earlyreduce");
               er_quant->calc_quantiles();
-              write_cube_file(er_quant, EarlyReduce, data, cube_fp);
+              write_cube_file(er_quant, most_severe[ER_INSTANCES], data, cube_fp);
 
               es_quant->set_metric("mpi_earlyscan");
               es_quant->calc_quantiles();
-              write_cube_file(es_quant, EarlyScan, data, cube_fp);
+              write_cube_file(es_quant, most_severe[ES_INSTANCES], data, cube_fp);
 
               lb_quant->set_metric("mpi_latebroadcast");
               lb_quant->calc_quantiles();
-              write_cube_file(lb_quant, LateBcast, data, cube_fp);
+              write_cube_file(lb_quant, most_severe[LB_INSTANCES], data, cube_fp);
 
               bc_quant->set_metric("mpi_barrier_completion");
               bc_quant->calc_quantiles();
-              write_cube_file(bc_quant, BarrierCompl, data, cube_fp);
+              write_cube_file(bc_quant, most_severe[BC_INSTANCES], data, cube_fp);
 
               nxnc_quant->set_metric("mpi_nxn_completion");
               nxnc_quant->calc_quantiles();
-              write_cube_file(nxnc_quant, NxnCompl, data, cube_fp);
+              write_cube_file(nxnc_quant, most_severe[NXNC_INSTANCES], data, cube_fp);
 #endif // _MPI
 
 #if defined(_OPENMP)
               omp_eb_quant->set_metric("omp_ebarrier_wait");
               omp_eb_quant->calc_quantiles();
-              write_cube_file(omp_eb_quant, OmpEBarrier, data, cube_fp);
+              write_cube_file(omp_eb_quant, most_severe[OMP_EB_INSTANCES], data, cube_fp);
 
               omp_ib_quant->set_metric("omp_ibarrier_wait");
               omp_ib_quant->calc_quantiles();
-              write_cube_file(omp_ib_quant, OmpIBarrier, data, cube_fp);
+              write_cube_file(omp_ib_quant, most_severe[OMP_IB_INSTANCES], data, cube_fp);
 
               thread_lc_ol_quant->set_metric("omp_lock_contention_api");
               thread_lc_ol_quant->calc_quantiles();
-              write_cube_file(thread_lc_ol_quant, sharedLC_OL, data, cube_fp);
+              write_cube_file(thread_lc_ol_quant, most_severe[THREAD_LC_OL_INSTANCES], data, cube_fp);
 
               thread_lc_oc_quant->set_metric("omp_lock_contention_critical");
               thread_lc_oc_quant->calc_quantiles();
-              write_cube_file(thread_lc_oc_quant, sharedLC_OC, data, cube_fp);
+              write_cube_file(thread_lc_oc_quant, most_severe[THREAD_LC_OC_INSTANCES], data, cube_fp);
 
               thread_lc_pm_quant->set_metric("pthread_lock_contention_mutex_lock");
               thread_lc_pm_quant->calc_quantiles();
-              write_cube_file(thread_lc_pm_quant, sharedLC_PM, data, cube_fp);
+              write_cube_file(thread_lc_pm_quant, most_severe[THREAD_LC_PM_INSTANCES], data, cube_fp);
 
               thread_lc_pc_quant->set_metric("pthread_lock_contention_conditional");
               thread_lc_pc_quant->calc_quantiles();
-              write_cube_file(thread_lc_pc_quant, sharedLC_PC, data, cube_fp);
+              write_cube_file(thread_lc_pc_quant, most_severe[THREAD_LC_PC_INSTANCES], data, cube_fp);
 #endif // _OPENMP
 
               // Close statistics file
@@ -8475,6 +8228,114 @@ class PatternStatistics : public Pattern
           }
         }
       }
+
+      void pack_state(pearl::Buffer& buffer) const
+      {
+        Pattern::pack_state(buffer);
+
+#if defined(_MPI)
+        ls_quant->pack(buffer);
+        lsw_quant->pack(buffer);
+        lr_quant->pack(buffer);
+        wnxn_quant->pack(buffer);
+        wb_quant->pack(buffer);
+        er_quant->pack(buffer);
+        es_quant->pack(buffer);
+        lb_quant->pack(buffer);
+        bc_quant->pack(buffer);
+        nxnc_quant->pack(buffer);
+
+        pack_instances(buffer, most_severe[LS_INSTANCES]);
+        pack_instances(buffer, most_severe[LSW_INSTANCES]);
+        pack_instances(buffer, most_severe[LR_INSTANCES]);
+        pack_instances(buffer, most_severe[ER_INSTANCES]);
+        pack_instances(buffer, most_severe[WNXN_INSTANCES]);
+        pack_instances(buffer, most_severe[WB_INSTANCES]);
+        pack_instances(buffer, most_severe[NXNC_INSTANCES]);
+        pack_instances(buffer, most_severe[BC_INSTANCES]);
+        pack_instances(buffer, most_severe[LB_INSTANCES]);
+        pack_instances(buffer, most_severe[ES_INSTANCES]);
+
+        buffer.put_uint32(pending_mpi.size());
+        for (PendingMpiMap::const_iterator it = pending_mpi.begin(); it != pending_mpi.end(); ++it) {
+          buffer.put_id(it->first);
+          pack_pending(buffer, it->second);
+        }
+#endif // _MPI
+#if defined(_OPENMP)
+        omp_eb_quant->pack(buffer);
+        omp_ib_quant->pack(buffer);
+        thread_lc_ol_quant->pack(buffer);
+        thread_lc_oc_quant->pack(buffer);
+        thread_lc_pm_quant->pack(buffer);
+        thread_lc_pc_quant->pack(buffer);
+
+        pack_instances(buffer, most_severe[OMP_EB_INSTANCES]);
+        pack_instances(buffer, most_severe[OMP_IB_INSTANCES]);
+        pack_instances(buffer, most_severe[THREAD_LC_OL_INSTANCES]);
+        pack_instances(buffer, most_severe[THREAD_LC_OC_INSTANCES]);
+        pack_instances(buffer, most_severe[THREAD_LC_PM_INSTANCES]);
+        pack_instances(buffer, most_severe[THREAD_LC_PC_INSTANCES]);
+
+        pack_pending(buffer, pending_omp);
+#endif // _OPENMP
+      }
+
+      void unpack_state(pearl::Buffer&           buffer,
+                        const pearl::GlobalDefs& defs)
+      {
+        Pattern::unpack_state(buffer, defs);
+
+#if defined(_MPI)
+        ls_quant->unpack(buffer);
+        lsw_quant->unpack(buffer);
+        lr_quant->unpack(buffer);
+        wnxn_quant->unpack(buffer);
+        wb_quant->unpack(buffer);
+        er_quant->unpack(buffer);
+        es_quant->unpack(buffer);
+        lb_quant->unpack(buffer);
+        bc_quant->unpack(buffer);
+        nxnc_quant->unpack(buffer);
+
+        unpack_instances(buffer, most_severe[LS_INSTANCES]);
+        unpack_instances(buffer, most_severe[LSW_INSTANCES]);
+        unpack_instances(buffer, most_severe[LR_INSTANCES]);
+        unpack_instances(buffer, most_severe[ER_INSTANCES]);
+        unpack_instances(buffer, most_severe[WNXN_INSTANCES]);
+        unpack_instances(buffer, most_severe[WB_INSTANCES]);
+        unpack_instances(buffer, most_severe[NXNC_INSTANCES]);
+        unpack_instances(buffer, most_severe[BC_INSTANCES]);
+        unpack_instances(buffer, most_severe[LB_INSTANCES]);
+        unpack_instances(buffer, most_severe[ES_INSTANCES]);
+
+        pending_mpi.clear();
+        uint32_t num_comms = buffer.get_uint32();
+        for (uint32_t i = 0; i < num_comms; ++i) {
+          ident_t                id      = buffer.get_id();
+          PendingMpiCollectives& pending = pending_mpi[id];
+          pending.m_comm = dynamic_cast<MpiComm*>(defs.get_comm(id));
+          unpack_pending(buffer, pending);
+        }
+#endif // _MPI
+#if defined(_OPENMP)
+        omp_eb_quant->unpack(buffer);
+        omp_ib_quant->unpack(buffer);
+        thread_lc_ol_quant->unpack(buffer);
+        thread_lc_oc_quant->unpack(buffer);
+        thread_lc_pm_quant->unpack(buffer);
+        thread_lc_pc_quant->unpack(buffer);
+
+        unpack_instances(buffer, most_severe[OMP_EB_INSTANCES]);
+        unpack_instances(buffer, most_severe[OMP_IB_INSTANCES]);
+        unpack_instances(buffer, most_severe[THREAD_LC_OL_INSTANCES]);
+        unpack_instances(buffer, most_severe[THREAD_LC_OC_INSTANCES]);
+        unpack_instances(buffer, most_severe[THREAD_LC_PM_INSTANCES]);
+        unpack_instances(buffer, most_severe[THREAD_LC_PC_INSTANCES]);
+
+        unpack_pending(buffer, pending_omp);
+#endif // _OPENMP
+      }
   
 };
 
@@ -8482,15 +8343,10 @@ class PatternStatistics : public Pattern
 /*----- Static class data -----*/
 
 
-#line 56 "Statistics.pattern"
+#line 60 "Statistics.pattern"
 
 #if defined(_OPENMP)
-    vector<TopMostSevere> PatternStatistics::sharedLC_OL;
-    vector<TopMostSevere> PatternStatistics::sharedLC_OC;
-    vector<TopMostSevere> PatternStatistics::sharedLC_PM;
-    vector<TopMostSevere> PatternStatistics::sharedLC_PC;
-
-    TopMostSevereMaxSum PatternStatistics::sharedMaxSum;
+    vector<PatternStatistics*> PatternStatistics::sharedTeam;
 #endif // (_OPENMP)
 
     PatternStatistics::MaxDurations PatternStatistics::sharedDurations;
@@ -8503,7 +8359,7 @@ void PatternStatistics::barrier_compl__cb(const pearl::CallbackManager& cbmanage
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1520 "Statistics.pattern"
+#line 1518 "Statistics.pattern"
 
 #if defined(_MPI)
       if (data->mIdle > 0)
@@ -8515,7 +8371,7 @@ void PatternStatistics::barrier_compl__cb(const pearl::CallbackManager& cbmanage
 
       Event begin = data->mLocal->get_event(ROLE_BEGIN_COLL);
 
-      stat_collective(BarrierCompl, data->mIdle,
+      stat_collective(BC_INSTANCES, data->mIdle,
                       begin->getTimestamp(),
                       event->getTimestamp(),
                       event.get_cnode()->getId(),
@@ -8537,13 +8393,13 @@ void PatternStatistics::early_reduce__cb(const pearl::CallbackManager& cbmanager
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1410 "Statistics.pattern"
+#line 1408 "Statistics.pattern"
 
 #if defined(_MPI)
       er_quant->add_value(data->mIdle);
 
       Event begin = data->mLocal->get_event(ROLE_BEGIN_COLL);
-      stat_collector(EarlyReduce,
+      stat_collector(ER_INSTANCES,
                      data->mIdle,
                      begin->getTimestamp(),
                      event->getTimestamp(),
@@ -8565,7 +8421,7 @@ void PatternStatistics::early_scan__cb(const pearl::CallbackManager& cbmanager,
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1433 "Statistics.pattern"
+#line 1431 "Statistics.pattern"
 
 #if defined(_MPI)
       if (data->mIdle > 0)
@@ -8577,7 +8433,7 @@ void PatternStatistics::early_scan__cb(const pearl::CallbackManager& cbmanager,
       
       Event begin = data->mLocal->get_event(ROLE_BEGIN_COLL);
 
-      stat_collective(EarlyScan, data->mIdle,
+      stat_collective(ES_INSTANCES, data->mIdle,
                       begin->getTimestamp(),
                       event->getTimestamp(),
                       event.get_cnode()->getId(),
@@ -8599,7 +8455,7 @@ void PatternStatistics::late_bcast__cb(const pearl::CallbackManager& cbmanager,
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1462 "Statistics.pattern"
+#line 1460 "Statistics.pattern"
 
 #if defined(_MPI)
       if (data->mIdle > 0)
@@ -8611,7 +8467,7 @@ void PatternStatistics::late_bcast__cb(const pearl::CallbackManager& cbmanager,
 
       Event begin = data->mLocal->get_event(ROLE_BEGIN_COLL);
       
-      stat_collective(LateBcast, data->mIdle,
+      stat_collective(LB_INSTANCES, data->mIdle,
                       begin->getTimestamp(),
                       event->getTimestamp(),
                       event.get_cnode()->getId(),
@@ -8633,14 +8489,14 @@ void PatternStatistics::late_receiver_bws_cb(const pearl::CallbackManager& cbman
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1726 "Statistics.pattern"
+#line 1724 "Statistics.pattern"
 
 #if defined(_MPI)
       lr_quant->add_value(data->mIdle);
       
       Event enter = data->mLocal->get_event(ROLE_ENTER_SEND_LR);
       
-      stat_collector(LateReceiver,
+      stat_collector(LR_INSTANCES,
                      data->mIdle,
                      enter->getTimestamp(),
                      event->getTimestamp(),
@@ -8661,14 +8517,14 @@ void PatternStatistics::late_sender__cb(const pearl::CallbackManager& cbmanager,
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1309 "Statistics.pattern"
+#line 1307 "Statistics.pattern"
 
 #if defined(_MPI)
       ls_quant->add_value(data->mIdle);
 
       Event enter = data->mLocal->get_event(ROLE_RECV_LS);
 
-      stat_collector(LateSender,
+      stat_collector(LS_INSTANCES,
                      data->mIdle,
                      enter.enterptr()->getTimestamp(),
                      event->getTimestamp(),
@@ -8689,7 +8545,7 @@ void PatternStatistics::late_sender_wo__cb(const pearl::CallbackManager& cbmanag
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1332 "Statistics.pattern"
+#line 1330 "Statistics.pattern"
 
 #if defined(_MPI)
       lsw_quant->add_value(data->mIdle);
@@ -8697,7 +8553,7 @@ void PatternStatistics::late_sender_wo__cb(const pearl::CallbackManager& cbmanag
       RemoteEvent enter = data->mRemote->get_event(ROLE_SEND);
       Event exit = data->mLocal->get_event(ROLE_RECV_LSWO);
       
-      stat_collector(LateSenderWO,
+      stat_collector(LSW_INSTANCES,
                      data->mIdle,
                      enter->getTimestamp(),
                      event->getTimestamp(),
@@ -8718,7 +8574,7 @@ void PatternStatistics::nxn_compl__cb(const pearl::CallbackManager& cbmanager, i
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1491 "Statistics.pattern"
+#line 1489 "Statistics.pattern"
 
 #if defined(_MPI)
       if (data->mIdle > 0)
@@ -8730,7 +8586,7 @@ void PatternStatistics::nxn_compl__cb(const pearl::CallbackManager& cbmanager, i
 
       Event begin = data->mLocal->get_event(ROLE_BEGIN_COLL);
 
-      stat_collective(NxnCompl, data->mIdle,
+      stat_collective(NXNC_INSTANCES, data->mIdle,
                       begin->getTimestamp(),
                       event->getTimestamp(),
                       event.get_cnode()->getId(),
@@ -8752,7 +8608,7 @@ void PatternStatistics::omp_ebarrier_wait__cb(const pearl::CallbackManager& cbma
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1549 "Statistics.pattern"
+#line 1547 "Statistics.pattern"
 
 #if defined(_OPENMP)
       if (data->mIdle > 0)
@@ -8761,13 +8617,13 @@ void PatternStatistics::omp_ebarrier_wait__cb(const pearl::CallbackManager& cbma
         data->mIdle = 0.0;
 
 #if defined(_MPI)
-      stat_collective(OmpEBarrier, data->mIdle,
+      stat_collective(OMP_EB_INSTANCES, data->mIdle,
                       data->mCallstack->top()->getTimestamp(),
                       event->getTimestamp(),
                       event.get_cnode()->getId(),
                       event.get_location().getRank());
 #else   // set rank 0 for pure OpenMP case
-      stat_collective(OmpEBarrier, data->mIdle,
+      stat_collective(OMP_EB_INSTANCES, data->mIdle,
                       data->mCallstack->top()->getTimestamp(),
                       event->getTimestamp(),
                       event.get_cnode()->getId(),
@@ -8789,7 +8645,7 @@ void PatternStatistics::omp_ibarrier_wait__cb(const pearl::CallbackManager& cbma
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1581 "Statistics.pattern"
+#line 1579 "Statistics.pattern"
 
 #if defined(_OPENMP)
       if (data->mIdle > 0)
@@ -8798,13 +8654,13 @@ void PatternStatistics::omp_ibarrier_wait__cb(const pearl::CallbackManager& cbma
         data->mIdle = 0.0;
 
 #if defined(_MPI)
-      stat_collective(OmpIBarrier, data->mIdle,
+      stat_collective(OMP_IB_INSTANCES, data->mIdle,
                       data->mCallstack->top()->getTimestamp(),
                       event->getTimestamp(),
                       event.get_cnode()->getId(),
                       event.get_location().getRank());
 #else   // set rank 0 for pure OpenMP case
-      stat_collective(OmpIBarrier, data->mIdle,
+      stat_collective(OMP_IB_INSTANCES, data->mIdle,
                       data->mCallstack->top()->getTimestamp(),
                       event->getTimestamp(),
                       event.get_cnode()->getId(),
@@ -8826,7 +8682,7 @@ void PatternStatistics::prepare__cb(const pearl::CallbackManager& cbmanager, int
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1215 "Statistics.pattern"
+#line 1211 "Statistics.pattern"
 
       // Determine local upper bounds for pattern durations
       CallbackManager cb;
@@ -8843,7 +8699,9 @@ void PatternStatistics::prepare__cb(const pearl::CallbackManager& cbmanager, int
       cb.register_callback(THREAD_ACQUIRE_LOCK, PEARL_create_callback(this, &PatternStatistics::acquire_cb));
 #endif // _OPENMP
       
-      PEARL_forward_replay(*(data->mTrace), cb, &durations);
+      // Only visit the events handled by the callbacks above
+      PEARL_forward_replay(*(data->mTrace), cb, &durations,
+                           cb.get_event_mask());
       
       // Determine global upper bounds for pattern durations
       #pragma omp master
@@ -8925,19 +8783,19 @@ void PatternStatistics::thread_lock_contention_ompcritical_wait__cb(const pearl:
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1641 "Statistics.pattern"
+#line 1639 "Statistics.pattern"
 
 #if defined(_OPENMP)
       thread_lc_oc_quant->add_value(data->mIdle);
 
 #if defined(_MPI)
-      stat_collector(ThreadLockContentionOMPCritical, data->mIdle,
+      stat_collector(THREAD_LC_OC_INSTANCES, data->mIdle,
                       event.enterptr()->getTimestamp(),
                       event->getTimestamp(), 
                       event.get_cnode()->getId(),
                       event.get_location().getRank());
 #else   // set rank 0 for pure OpenMP case
-      stat_collector(ThreadLockContentionOMPCritical, data->mIdle,
+      stat_collector(THREAD_LC_OC_INSTANCES, data->mIdle,
                       event.enterptr()->getTimestamp(), 
                       event->getTimestamp(),
                       event.get_cnode()->getId(),
@@ -8958,19 +8816,19 @@ void PatternStatistics::thread_lock_contention_omplock_wait__cb(const pearl::Cal
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1613 "Statistics.pattern"
+#line 1611 "Statistics.pattern"
 
 #if defined(_OPENMP)
       thread_lc_ol_quant->add_value(data->mIdle);
 
 #if defined(_MPI)
-      stat_collector(ThreadLockContentionOMPLockAPI, data->mIdle,
+      stat_collector(THREAD_LC_OL_INSTANCES, data->mIdle,
                       event.enterptr()->getTimestamp(),
                       event->getTimestamp(), 
                       event.get_cnode()->getId(),
                       event.get_location().getRank());
 #else   // set rank 0 for pure OpenMP case
-      stat_collector(ThreadLockContentionOMPLockAPI, data->mIdle,
+      stat_collector(THREAD_LC_OL_INSTANCES, data->mIdle,
                       event.enterptr()->getTimestamp(), 
                       event->getTimestamp(),
                       event.get_cnode()->getId(),
@@ -8991,19 +8849,19 @@ void PatternStatistics::thread_lock_contention_pthreadcondition_wait__cb(const p
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1697 "Statistics.pattern"
+#line 1695 "Statistics.pattern"
 
 #if defined(_OPENMP)
       thread_lc_pc_quant->add_value(data->mIdle);
 
 #if defined(_MPI)
-      stat_collector(ThreadLockContentionPthreadCondition, data->mIdle,
+      stat_collector(THREAD_LC_PC_INSTANCES, data->mIdle,
                       event.enterptr()->getTimestamp(),
                       event->getTimestamp(), 
                       event.get_cnode()->getId(),
                       event.get_location().getRank());
 #else   // set rank 0 for pure OpenMP case
-      stat_collector(ThreadLockContentionPthreadCondition, data->mIdle,
+      stat_collector(THREAD_LC_PC_INSTANCES, data->mIdle,
                       event.enterptr()->getTimestamp(), 
                       event->getTimestamp(),
                       event.get_cnode()->getId(),
@@ -9024,19 +8882,19 @@ void PatternStatistics::thread_lock_contention_pthreadmutex_wait__cb(const pearl
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1669 "Statistics.pattern"
+#line 1667 "Statistics.pattern"
 
 #if defined(_OPENMP)
       thread_lc_pm_quant->add_value(data->mIdle);
 
 #if defined(_MPI)
-      stat_collector(ThreadLockContentionPthreadMutex, data->mIdle,
+      stat_collector(THREAD_LC_PM_INSTANCES, data->mIdle,
                       event.enterptr()->getTimestamp(),
                       event->getTimestamp(), 
                       event.get_cnode()->getId(),
                       event.get_location().getRank());
 #else   // set rank 0 for pure OpenMP case
-      stat_collector(ThreadLockContentionPthreadMutex, data->mIdle,
+      stat_collector(THREAD_LC_PM_INSTANCES, data->mIdle,
                       event.enterptr()->getTimestamp(), 
                       event->getTimestamp(),
                       event.get_cnode()->getId(),
@@ -9057,7 +8915,7 @@ void PatternStatistics::wait_barrier__cb(const pearl::CallbackManager& cbmanager
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1382 "Statistics.pattern"
+#line 1380 "Statistics.pattern"
 
 #if defined(_MPI)
       if (data->mIdle > 0)
@@ -9068,7 +8926,7 @@ void PatternStatistics::wait_barrier__cb(const pearl::CallbackManager& cbmanager
       MpiComm* comm = event->getComm();
       Event begin   = data->mLocal->get_event(ROLE_BEGIN_COLL);
 
-      stat_collective(Barrier, data->mIdle,
+      stat_collective(WB_INSTANCES, data->mIdle,
                       begin->getTimestamp(),
                       event->getTimestamp(),
                       event.get_cnode()->getId(),
@@ -9090,7 +8948,7 @@ void PatternStatistics::wait_nxn__cb(const pearl::CallbackManager& cbmanager, in
 {
   CbData* data = static_cast<CbData*>(cdata);
 
-#line 1355 "Statistics.pattern"
+#line 1353 "Statistics.pattern"
 
 #if defined(_MPI)
       if (data->mIdle > 0)
@@ -9100,7 +8958,7 @@ void PatternStatistics::wait_nxn__cb(const pearl::CallbackManager& cbmanager, in
       
       MpiComm* comm = event->getComm();
 
-      stat_collective(BarrierNxN, data->mIdle,
+      stat_collective(WNXN_INSTANCES, data->mIdle,
                       data->mCallstack->top()->getTimestamp(),
                       event->getTimestamp(),
                       event.get_cnode()->getId(),
@@ -13687,15 +13545,6 @@ class PatternMPI_Wait_PT : public MpiPattern
         (it->second)->register_callback(DELAY_LATE_SENDER, PEARL_create_callback(this, &PatternMPI_Wait_PT::delay_late_sender_bwc_cb));
         (it->second)->register_callback(DELAY_LATE_RECEIVER, PEARL_create_callback(this, &PatternMPI_Wait_PT::delay_late_receiver_bwc_cb));
       }
-      {
-        CallbackManagerMap::iterator it = cbmgrs.find("fwc");
-
-        assert(it != cbmgrs.end());
-
-        (it->second)->register_callback(GROUP_RECV, PEARL_create_callback(this, &PatternMPI_Wait_PT::group_recv_fwc_cb));
-        (it->second)->register_callback(MPI_SEND, PEARL_create_callback(this, &PatternMPI_Wait_PT::mpi_send_fwc_cb));
-        (it->second)->register_callback(MPI_SEND_COMPLETE, PEARL_create_callback(this, &PatternMPI_Wait_PT::mpi_send_complete_fwc_cb));
-      }
     }
 
     /* Get pattern information */
@@ -14047,72 +13896,766 @@ void Pattern_Wait_PropagatingLR::waitstate_prop_lr_fwc_cb(const pearl::CallbackM
 
 #endif   /* _MPI */
 
-//--- Implementation --------------------------------------------------------
+//--- Fused replay kernels --------------------------------------------------
 
-void scout::create_patterns(AnalyzeTask* analyzer)
+namespace
+{
+
+/*
+ *---------------------------------------------------------------------------
+ *
+ * struct FusedPatterns
+ *
+ *---------------------------------------------------------------------------
+ */
+
+
+// Pattern instances dispatched by the fused kernels (NULL if disabled)
+struct FusedPatterns
 {
-  analyzer->addPattern(new PatternTime());
-  analyzer->addPattern(new PatternVisits());
+  PatternTime* p_time;
+  PatternVisits* p_visits;
 #if defined(_MPI)
-  if (enableAsynchronous)
-    analyzer->addPattern(new PatternAsync());
+  PatternMPI_Init* p_mpi_init_exit;
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_Init());
+  PatternMPI_LateSender* p_mpi_latesender;
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_InitCompletion());
+  PatternMPI_LateReceiver* p_mpi_latereceiver;
 #endif   /* _MPI */
+#if defined(_OPENMP)
+  PatternOMP_Mgmt* p_omp_management;
+#endif   /* _OPENMP */
+#if defined(_OPENMP)
+  PatternOMP_Sync_Barrier* p_omp_barrier;
+#endif   /* _OPENMP */
+#if defined(_OPENMP)
+  PatternThread_LockContention* p_thread_lock_contention;
+#endif   /* _OPENMP */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_FinalizeWait());
+  PatternMPI_SyncsSend* p_syncs_send;
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_BarrierWait());
+  PatternMPI_SyncsColl* p_syncs_coll;
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_BarrierCompletion());
+  PatternMPI_CommsSend* p_comms_send;
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_P2P());
+  PatternMPI_CommsExch* p_comms_cxch;
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_LateSender());
+  PatternMPI_CommsSrc* p_comms_csrc;
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_LateSenderWO());
+  PatternMPI_CommsDst* p_comms_cdst;
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_LswoDifferent());
+  PatternMPI_BytesSent* p_bytes_sent;
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_LswoSame());
+  PatternMPI_BytesCout* p_bytes_cout;
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_LateReceiver());
+  PatternMPI_BytesCin* p_bytes_cin;
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_EarlyReduce());
+  PatternMPI_BytesPut* p_bytes_put;
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_EarlyScan());
+  PatternMPI_BytesGet* p_bytes_get;
 #endif   /* _MPI */
+#if defined(_MPI) && defined(HAS_MPI2_1SIDED)
+  PatternMPI_RmaSync* p_mpi_rma_synchronization;
+#endif   /* _MPI && HAS_MPI2_1SIDED */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_LateBroadcast());
+  PatternMPI_Wait_PT* p_mpi_wait_propagating;
 #endif   /* _MPI */
+};
+
+
+/*
+ *---------------------------------------------------------------------------
+ *
+ * class FusedKernel
+ *
+ *---------------------------------------------------------------------------
+ */
+
+
+class FusedKernel : public pearl::Callback
+{
+  public:
+    FusedKernel(const FusedPatterns& patterns)
+      : m_patterns(patterns)
+    {}
+
+    bool handles(event_t type) const;
+
+    virtual void execute(const pearl::CallbackManager& cbmanager, int user_event,
+                         const pearl::Event& event, CallbackData* cdata);
+
+
+  private:
+    FusedPatterns m_patterns;
+};
+
+
+bool FusedKernel::handles(event_t type) const
+{
+  switch (type) {
+    case ENTER:
+      if (m_patterns.p_visits)
+        return true;
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_WaitNxN());
+      if (m_patterns.p_mpi_init_exit)
+        return true;
 #endif   /* _MPI */
-#if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_NxNCompletion());
+#if defined(_OPENMP)
+      if (m_patterns.p_omp_management)
+        return true;
+#endif   /* _OPENMP */
+#if defined(_OPENMP)
+      if (m_patterns.p_omp_barrier)
+        return true;
+#endif   /* _OPENMP */
+      return false;
+
+    case ENTER_CS:
+      if (m_patterns.p_visits)
+        return true;
+#if defined(_MPI)
+      if (m_patterns.p_mpi_init_exit)
+        return true;
+#endif   /* _MPI */
+#if defined(_OPENMP)
+      if (m_patterns.p_omp_management)
+        return true;
+#endif   /* _OPENMP */
+      return false;
+
+    case LEAVE:
+      if (m_patterns.p_time)
+        return true;
+#if defined(_MPI)
+      if (m_patterns.p_mpi_latesender)
+        return true;
+#endif   /* _MPI */
+#if defined(_OPENMP)
+      if (m_patterns.p_omp_management)
+        return true;
+#endif   /* _OPENMP */
+#if defined(_OPENMP)
+      if (m_patterns.p_omp_barrier)
+        return true;
+#endif   /* _OPENMP */
+      return false;
+
+    case MPI_COLLECTIVE_END:
+#if defined(_MPI)
+      if (m_patterns.p_syncs_coll)
+        return true;
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_comms_cxch)
+        return true;
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_comms_csrc)
+        return true;
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_comms_cdst)
+        return true;
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_bytes_cout)
+        return true;
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_bytes_cin)
+        return true;
+#endif   /* _MPI */
+      return false;
+
+    case MPI_SEND:
+#if defined(_MPI)
+      if (m_patterns.p_syncs_send)
+        return true;
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_comms_send)
+        return true;
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_bytes_sent)
+        return true;
+#endif   /* _MPI */
+      return false;
+
+    case MPI_SEND_REQUEST:
+#if defined(_MPI)
+      if (m_patterns.p_syncs_send)
+        return true;
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_comms_send)
+        return true;
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_bytes_sent)
+        return true;
+#endif   /* _MPI */
+      return false;
+
+    case THREAD_ACQUIRE_LOCK:
+#if defined(_OPENMP)
+      if (m_patterns.p_thread_lock_contention)
+        return true;
+#endif   /* _OPENMP */
+      return false;
+
+    case THREAD_RELEASE_LOCK:
+#if defined(_OPENMP)
+      if (m_patterns.p_thread_lock_contention)
+        return true;
+#endif   /* _OPENMP */
+      return false;
+
+    case THREAD_TASK_COMPLETE:
+      if (m_patterns.p_time)
+        return true;
+      if (m_patterns.p_visits)
+        return true;
+      return false;
+
+    case THREAD_END:
+      if (m_patterns.p_time)
+        return true;
+      if (m_patterns.p_visits)
+        return true;
+      return false;
+
+    case MPI_RMA_PUT_START:
+#if defined(_MPI)
+      if (m_patterns.p_bytes_put)
+        return true;
+#endif   /* _MPI */
+      return false;
+
+    case MPI_RMA_GET_START:
+#if defined(_MPI)
+      if (m_patterns.p_bytes_get)
+        return true;
+#endif   /* _MPI */
+      return false;
+
+    case MPI_RMA_GATS:
+#if defined(_MPI) && defined(HAS_MPI2_1SIDED)
+      if (m_patterns.p_mpi_rma_synchronization)
+        return true;
+#endif   /* _MPI && HAS_MPI2_1SIDED */
+      return false;
+
+    case MPI_RMA_COLLECTIVE_END:
+#if defined(_MPI) && defined(HAS_MPI2_1SIDED)
+      if (m_patterns.p_mpi_rma_synchronization)
+        return true;
+#endif   /* _MPI && HAS_MPI2_1SIDED */
+      return false;
+
+    case MPI_RMA_LOCK:
+#if defined(_MPI) && defined(HAS_MPI2_1SIDED)
+      if (m_patterns.p_mpi_rma_synchronization)
+        return true;
+#endif   /* _MPI && HAS_MPI2_1SIDED */
+      return false;
+
+    case MPI_RMA_UNLOCK:
+#if defined(_MPI) && defined(HAS_MPI2_1SIDED)
+      if (m_patterns.p_mpi_rma_synchronization)
+        return true;
+#endif   /* _MPI && HAS_MPI2_1SIDED */
+      return false;
+
+    default:
+      return false;
+  }
+}
+
+
+void FusedKernel::execute(const pearl::CallbackManager& cbmanager, int user_event,
+    const pearl::Event& event, CallbackData* cdata)
+{
+  switch (event->getType()) {
+    case ENTER:
+      if (m_patterns.p_visits) {
+        m_patterns.p_visits->group_enter__cb(cbmanager, user_event, event, cdata);
+      }
+#if defined(_MPI)
+      if (m_patterns.p_mpi_init_exit) {
+        m_patterns.p_mpi_init_exit->group_enter__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+#if defined(_OPENMP)
+      if (m_patterns.p_omp_management) {
+        m_patterns.p_omp_management->group_enter__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _OPENMP */
+#if defined(_OPENMP)
+      if (m_patterns.p_omp_barrier) {
+        m_patterns.p_omp_barrier->enter__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _OPENMP */
+      break;
+
+    case ENTER_CS:
+      if (m_patterns.p_visits) {
+        m_patterns.p_visits->group_enter__cb(cbmanager, user_event, event, cdata);
+      }
+#if defined(_MPI)
+      if (m_patterns.p_mpi_init_exit) {
+        m_patterns.p_mpi_init_exit->group_enter__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+#if defined(_OPENMP)
+      if (m_patterns.p_omp_management) {
+        m_patterns.p_omp_management->group_enter__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _OPENMP */
+      break;
+
+    case LEAVE:
+      if (m_patterns.p_time) {
+        m_patterns.p_time->leave__cb(cbmanager, user_event, event, cdata);
+      }
+#if defined(_MPI)
+      if (m_patterns.p_mpi_latesender) {
+        m_patterns.p_mpi_latesender->leave__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+#if defined(_OPENMP)
+      if (m_patterns.p_omp_management) {
+        m_patterns.p_omp_management->leave__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _OPENMP */
+#if defined(_OPENMP)
+      if (m_patterns.p_omp_barrier) {
+        m_patterns.p_omp_barrier->leave__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _OPENMP */
+      break;
+
+    case MPI_COLLECTIVE_END:
+#if defined(_MPI)
+      if (m_patterns.p_syncs_coll) {
+        m_patterns.p_syncs_coll->mpi_collective_end__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_comms_cxch) {
+        m_patterns.p_comms_cxch->mpi_collective_end__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_comms_csrc) {
+        m_patterns.p_comms_csrc->mpi_collective_end__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_comms_cdst) {
+        m_patterns.p_comms_cdst->mpi_collective_end__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_bytes_cout) {
+        m_patterns.p_bytes_cout->mpi_collective_end__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_bytes_cin) {
+        m_patterns.p_bytes_cin->mpi_collective_end__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+      break;
+
+    case MPI_SEND:
+#if defined(_MPI)
+      if (m_patterns.p_syncs_send) {
+        m_patterns.p_syncs_send->group_send__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_comms_send) {
+        m_patterns.p_comms_send->group_send__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_bytes_sent) {
+        m_patterns.p_bytes_sent->group_send__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+      break;
+
+    case MPI_SEND_REQUEST:
+#if defined(_MPI)
+      if (m_patterns.p_syncs_send) {
+        m_patterns.p_syncs_send->group_send__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_comms_send) {
+        m_patterns.p_comms_send->group_send__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+#if defined(_MPI)
+      if (m_patterns.p_bytes_sent) {
+        m_patterns.p_bytes_sent->group_send__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+      break;
+
+    case THREAD_ACQUIRE_LOCK:
+#if defined(_OPENMP)
+      if (m_patterns.p_thread_lock_contention) {
+        m_patterns.p_thread_lock_contention->thread_acquire_lock__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _OPENMP */
+      break;
+
+    case THREAD_RELEASE_LOCK:
+#if defined(_OPENMP)
+      if (m_patterns.p_thread_lock_contention) {
+        m_patterns.p_thread_lock_contention->thread_release_lock__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _OPENMP */
+      break;
+
+    case THREAD_TASK_COMPLETE:
+      if (m_patterns.p_time) {
+        m_patterns.p_time->thread_task_complete__cb(cbmanager, user_event, event, cdata);
+      }
+      if (m_patterns.p_visits) {
+        m_patterns.p_visits->thread_task_complete__cb(cbmanager, user_event, event, cdata);
+      }
+      break;
+
+    case THREAD_END:
+      if (m_patterns.p_time) {
+        m_patterns.p_time->thread_end__cb(cbmanager, user_event, event, cdata);
+      }
+      if (m_patterns.p_visits) {
+        m_patterns.p_visits->thread_end__cb(cbmanager, user_event, event, cdata);
+      }
+      break;
+
+    case MPI_RMA_PUT_START:
+#if defined(_MPI)
+      if (m_patterns.p_bytes_put) {
+        m_patterns.p_bytes_put->mpi_rma_put_start__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+      break;
+
+    case MPI_RMA_GET_START:
+#if defined(_MPI)
+      if (m_patterns.p_bytes_get) {
+        m_patterns.p_bytes_get->mpi_rma_get_start__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+      break;
+
+    case MPI_RMA_GATS:
+#if defined(_MPI) && defined(HAS_MPI2_1SIDED)
+      if (m_patterns.p_mpi_rma_synchronization) {
+        m_patterns.p_mpi_rma_synchronization->mpi_rma_gats__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI && HAS_MPI2_1SIDED */
+      break;
+
+    case MPI_RMA_COLLECTIVE_END:
+#if defined(_MPI) && defined(HAS_MPI2_1SIDED)
+      if (m_patterns.p_mpi_rma_synchronization) {
+        m_patterns.p_mpi_rma_synchronization->mpi_rma_collective_end__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI && HAS_MPI2_1SIDED */
+      break;
+
+    case MPI_RMA_LOCK:
+#if defined(_MPI) && defined(HAS_MPI2_1SIDED)
+      if (m_patterns.p_mpi_rma_synchronization) {
+        m_patterns.p_mpi_rma_synchronization->mpi_rma_lock__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI && HAS_MPI2_1SIDED */
+      break;
+
+    case MPI_RMA_UNLOCK:
+#if defined(_MPI) && defined(HAS_MPI2_1SIDED)
+      if (m_patterns.p_mpi_rma_synchronization) {
+        m_patterns.p_mpi_rma_synchronization->mpi_rma_unlock__cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI && HAS_MPI2_1SIDED */
+      break;
+
+    default:
+      break;
+  }
+}
+
+
+#if defined(_MPI)
+/*
+ *---------------------------------------------------------------------------
+ *
+ * class FusedKernel_bws
+ *
+ *---------------------------------------------------------------------------
+ */
+
+
+class FusedKernel_bws : public pearl::Callback
+{
+  public:
+    FusedKernel_bws(const FusedPatterns& patterns)
+      : m_patterns(patterns)
+    {}
+
+    bool handles(event_t type) const;
+
+    virtual void execute(const pearl::CallbackManager& cbmanager, int user_event,
+                         const pearl::Event& event, CallbackData* cdata);
+
+
+  private:
+    FusedPatterns m_patterns;
+};
+
+
+bool FusedKernel_bws::handles(event_t type) const
+{
+  switch (type) {
+    case MPI_SEND_COMPLETE:
+#if defined(_MPI)
+      if (m_patterns.p_mpi_latereceiver)
+        return true;
+#endif   /* _MPI */
+      return false;
+
+    default:
+      return false;
+  }
+}
+
+
+void FusedKernel_bws::execute(const pearl::CallbackManager& cbmanager, int user_event,
+    const pearl::Event& event, CallbackData* cdata)
+{
+  switch (event->getType()) {
+    case MPI_SEND_COMPLETE:
+#if defined(_MPI)
+      if (m_patterns.p_mpi_latereceiver) {
+        m_patterns.p_mpi_latereceiver->mpi_send_complete_bws_cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+      break;
+
+    default:
+      break;
+  }
+}
+#endif   /* _MPI */
+
+
+#if defined(_MPI)
+/*
+ *---------------------------------------------------------------------------
+ *
+ * class FusedKernel_fwc
+ *
+ *---------------------------------------------------------------------------
+ */
+
+
+class FusedKernel_fwc : public pearl::Callback
+{
+  public:
+    FusedKernel_fwc(const FusedPatterns& patterns)
+      : m_patterns(patterns)
+    {}
+
+    bool handles(event_t type) const;
+
+    virtual void execute(const pearl::CallbackManager& cbmanager, int user_event,
+                         const pearl::Event& event, CallbackData* cdata);
+
+
+  private:
+    FusedPatterns m_patterns;
+};
+
+
+bool FusedKernel_fwc::handles(event_t type) const
+{
+  switch (type) {
+    case MPI_SEND:
+#if defined(_MPI)
+      if (m_patterns.p_mpi_wait_propagating)
+        return true;
+#endif   /* _MPI */
+      return false;
+
+    case MPI_SEND_COMPLETE:
+#if defined(_MPI)
+      if (m_patterns.p_mpi_wait_propagating)
+        return true;
+#endif   /* _MPI */
+      return false;
+
+    case MPI_RECV:
+#if defined(_MPI)
+      if (m_patterns.p_mpi_wait_propagating)
+        return true;
+#endif   /* _MPI */
+      return false;
+
+    case MPI_RECV_COMPLETE:
+#if defined(_MPI)
+      if (m_patterns.p_mpi_wait_propagating)
+        return true;
+#endif   /* _MPI */
+      return false;
+
+    default:
+      return false;
+  }
+}
+
+
+void FusedKernel_fwc::execute(const pearl::CallbackManager& cbmanager, int user_event,
+    const pearl::Event& event, CallbackData* cdata)
+{
+  switch (event->getType()) {
+    case MPI_SEND:
+#if defined(_MPI)
+      if (m_patterns.p_mpi_wait_propagating) {
+        m_patterns.p_mpi_wait_propagating->mpi_send_fwc_cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+      break;
+
+    case MPI_SEND_COMPLETE:
+#if defined(_MPI)
+      if (m_patterns.p_mpi_wait_propagating) {
+        m_patterns.p_mpi_wait_propagating->mpi_send_complete_fwc_cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+      break;
+
+    case MPI_RECV:
+#if defined(_MPI)
+      if (m_patterns.p_mpi_wait_propagating) {
+        m_patterns.p_mpi_wait_propagating->group_recv_fwc_cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+      break;
+
+    case MPI_RECV_COMPLETE:
+#if defined(_MPI)
+      if (m_patterns.p_mpi_wait_propagating) {
+        m_patterns.p_mpi_wait_propagating->group_recv_fwc_cb(cbmanager, user_event, event, cdata);
+      }
+#endif   /* _MPI */
+      break;
+
+    default:
+      break;
+  }
+}
+#endif   /* _MPI */
+
+
+template<class KernelT>
+void register_kernel(AnalyzeTask* analyzer, const string& replay, KernelT* kernel)
+{
+  CallbackPtr callback(kernel);
+
+  for (int type = 0; type < GROUP_ALL; ++type)
+    if (kernel->handles(event_t(type)))
+      analyzer->addCallback(replay, event_t(type), callback);
+}
+
+}   // unnamed namespace
+
+
+//--- Implementation --------------------------------------------------------
+
+void scout::create_patterns(AnalyzeTask* analyzer)
+{
+  FusedPatterns patterns = FusedPatterns();
+
+  analyzer->addPattern(patterns.p_time = new PatternTime());
+  analyzer->addPattern(patterns.p_visits = new PatternVisits());
+#if defined(_MPI)
+  if (enableAsynchronous)
+    analyzer->addPattern(new PatternAsync());
+#endif   /* _MPI */
+#if defined(_MPI)
+  analyzer->addPattern(patterns.p_mpi_init_exit = new PatternMPI_Init());
+#endif   /* _MPI */
+#if defined(_MPI)
+  analyzer->addPattern(new PatternMPI_InitCompletion());
+#endif   /* _MPI */
+#if defined(_MPI)
+  analyzer->addPattern(new PatternMPI_FinalizeWait());
+#endif   /* _MPI */
+#if defined(_MPI)
+  analyzer->addPattern(new PatternMPI_BarrierWait());
+#endif   /* _MPI */
+#if defined(_MPI)
+  analyzer->addPattern(new PatternMPI_BarrierCompletion());
+#endif   /* _MPI */
+#if defined(_MPI)
+  analyzer->addPattern(new PatternMPI_P2P());
+#endif   /* _MPI */
+#if defined(_MPI)
+  analyzer->addPattern(patterns.p_mpi_latesender = new PatternMPI_LateSender());
+#endif   /* _MPI */
+#if defined(_MPI)
+  analyzer->addPattern(new PatternMPI_LateSenderWO());
+#endif   /* _MPI */
+#if defined(_MPI)
+  analyzer->addPattern(new PatternMPI_LswoDifferent());
+#endif   /* _MPI */
+#if defined(_MPI)
+  analyzer->addPattern(new PatternMPI_LswoSame());
+#endif   /* _MPI */
+#if defined(_MPI)
+  analyzer->addPattern(patterns.p_mpi_latereceiver = new PatternMPI_LateReceiver());
+#endif   /* _MPI */
+#if defined(_MPI)
+  analyzer->addPattern(new PatternMPI_EarlyReduce());
+#endif   /* _MPI */
+#if defined(_MPI)
+  analyzer->addPattern(new PatternMPI_EarlyScan());
+#endif   /* _MPI */
+#if defined(_MPI)
+  analyzer->addPattern(new PatternMPI_LateBroadcast());
+#endif   /* _MPI */
+#if defined(_MPI)
+  analyzer->addPattern(new PatternMPI_WaitNxN());
+#endif   /* _MPI */
+#if defined(_MPI)
+  analyzer->addPattern(new PatternMPI_NxNCompletion());
 #endif   /* _MPI */
 #if defined(_OPENMP)
-  analyzer->addPattern(new PatternOMP_Mgmt());
+  analyzer->addPattern(patterns.p_omp_management = new PatternOMP_Mgmt());
 #endif   /* _OPENMP */
 #if defined(_OPENMP)
   analyzer->addPattern(new PatternOMP_Mgmt_Fork());
 #endif   /* _OPENMP */
 #if defined(_OPENMP)
-  analyzer->addPattern(new PatternOMP_Sync_Barrier());
+  analyzer->addPattern(patterns.p_omp_barrier = new PatternOMP_Sync_Barrier());
 #endif   /* _OPENMP */
 #if defined(_OPENMP)
   analyzer->addPattern(new PatternOMP_Sync_Ebarrier_Wait());
@@ -14129,49 +14672,49 @@ void scout::create_patterns(AnalyzeTask* analyzer)
   analyzer->addPattern(new PatternPthread_Lock_Contention_Mutex_Lock());
   analyzer->addPattern(new PatternPthread_Lock_Contention_Conditional());
 #if defined(_OPENMP)
-  analyzer->addPattern(new PatternThread_LockContention());
+  analyzer->addPattern(patterns.p_thread_lock_contention = new PatternThread_LockContention());
 #endif   /* _OPENMP */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_SyncsSend());
+  analyzer->addPattern(patterns.p_syncs_send = new PatternMPI_SyncsSend());
 #endif   /* _MPI */
 #if defined(_MPI)
   analyzer->addPattern(new PatternMPI_SyncsRecv());
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_SyncsColl());
+  analyzer->addPattern(patterns.p_syncs_coll = new PatternMPI_SyncsColl());
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_CommsSend());
+  analyzer->addPattern(patterns.p_comms_send = new PatternMPI_CommsSend());
 #endif   /* _MPI */
 #if defined(_MPI)
   analyzer->addPattern(new PatternMPI_CommsRecv());
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_CommsExch());
+  analyzer->addPattern(patterns.p_comms_cxch = new PatternMPI_CommsExch());
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_CommsSrc());
+  analyzer->addPattern(patterns.p_comms_csrc = new PatternMPI_CommsSrc());
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_CommsDst());
+  analyzer->addPattern(patterns.p_comms_cdst = new PatternMPI_CommsDst());
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_BytesSent());
+  analyzer->addPattern(patterns.p_bytes_sent = new PatternMPI_BytesSent());
 #endif   /* _MPI */
 #if defined(_MPI)
   analyzer->addPattern(new PatternMPI_BytesRcvd());
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_BytesCout());
+  analyzer->addPattern(patterns.p_bytes_cout = new PatternMPI_BytesCout());
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_BytesCin());
+  analyzer->addPattern(patterns.p_bytes_cin = new PatternMPI_BytesCin());
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_BytesPut());
+  analyzer->addPattern(patterns.p_bytes_put = new PatternMPI_BytesPut());
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_BytesGet());
+  analyzer->addPattern(patterns.p_bytes_get = new PatternMPI_BytesGet());
 #endif   /* _MPI */
 #if defined(_MPI)
   analyzer->addPattern(new PatternMPI_SLR_Count());
@@ -14198,7 +14741,7 @@ void scout::create_patterns(AnalyzeTask* analyzer)
   analyzer->addPattern(new PatternMPI_RmaWaitAtFree());
 #endif   /* _MPI && HAS_MPI2_1SIDED */
 #if defined(_MPI) && defined(HAS_MPI2_1SIDED)
-  analyzer->addPattern(new PatternMPI_RmaSync());
+  analyzer->addPattern(patterns.p_mpi_rma_synchronization = new PatternMPI_RmaSync());
 #endif   /* _MPI && HAS_MPI2_1SIDED */
 #if defined(_MPI) && defined(HAS_MPI2_1SIDED)
   analyzer->addPattern(new PatternMPI_RmaSyncLatePost());
@@ -14307,7 +14850,7 @@ void scout::create_patterns(AnalyzeTask* analyzer)
   analyzer->addPattern(new PatternMPI_Wait_Indirect_LR());
 #endif   /* _MPI */
 #if defined(_MPI)
-  analyzer->addPattern(new PatternMPI_Wait_PT());
+  analyzer->addPattern(patterns.p_mpi_wait_propagating = new PatternMPI_Wait_PT());
 #endif   /* _MPI */
 #if defined(_MPI)
   analyzer->addPattern(new Pattern_Wait_PropagatingLS());
@@ -14315,6 +14858,15 @@ void scout::create_patterns(AnalyzeTask* analyzer)
 #if defined(_MPI)
   analyzer->addPattern(new Pattern_Wait_PropagatingLR());
 #endif   /* _MPI */
+
+  // Register fused replay kernels
+  register_kernel(analyzer, "", new FusedKernel(patterns));
+#if defined(_MPI)
+  register_kernel(analyzer, "bws", new FusedKernel_bws(patterns));
+#endif   /* _MPI */
+#if defined(_MPI)
+  register_kernel(analyzer, "fwc", new FusedKernel_fwc(patterns));
+#endif   /* _MPI */
 }
 
 
@@ -17,12 +17,24 @@
 #include <config.h>
 #include "PreprocessTask.h"
 
+#include <set>
+#include <vector>
+
+#include <pearl/Event.h>
+#include <pearl/GlobalDefs.h>
+#include <pearl/LocalTrace.h>
 #include <pearl/pearl.h>
 
+#if defined(_MPI)
+  #include <pearl/MpiComm.h>
+  #include <pearl/MpiWindow.h>
+#endif   // _MPI
+
 #include "CheckedTask.h"
 #include "TaskData.h"
 #include "TimedPhase.h"
 
+using namespace std;
 using namespace pearl;
 using namespace scout;
 
@@ -178,6 +190,10 @@ PreprocessTask::PreprocessTask(const TaskDataShared&  sharedData,
   #endif   //_MPI
   SUBTASK(new PreprocessTrace(sharedData, privateData),
           "  Preprocessing trace data       ");
+  #if defined(_MPI)
+    SUBTASK(new CreateCommsTask(sharedData, privateData),
+          "  Creating communicators         ");
+  #endif   //_MPI
 }
 
 
@@ -318,3 +334,82 @@ bool PreprocessTrace::execute()
 
   return true;
 }
+
+
+//---------------------------------------------------------------------------
+//
+//  class CreateCommsTask
+//
+//---------------------------------------------------------------------------
+
+#if defined(_MPI)
+
+//--- Constructors & destructor ---------------------------------------------
+
+/**
+ *  @brief Constructor. Creates a new CreateCommsTask instance.
+ *
+ *  This constructor creates a new task instance for creating the MPI
+ *  communicators used by the analysis using the given parameters.
+ *
+ *  @param  sharedData   Shared task data object
+ *  @param  privateData  Private task data object
+ **/
+CreateCommsTask::CreateCommsTask(const TaskDataShared&  sharedData,
+                                 const TaskDataPrivate& privateData)
+  : Task(),
+    mSharedData(sharedData),
+    mPrivateData(privateData)
+{
+}
+
+
+//--- Execution control -----------------------------------------------------
+
+/**
+ *  @brief Executes the task.
+ *
+ *  Collects the IDs of the communicators referenced by the local trace data
+ *  of all threads and creates the corresponding MPI communicators on the
+ *  master thread.
+ *
+ *  @return Always @em true
+ **/
+bool CreateCommsTask::execute()
+{
+  // This variable is implicitly shared!
+  static set<uint32_t> commIds;
+
+  const LocalTrace& trace = *mPrivateData.mTrace;
+  set<uint32_t>     local;
+  for (Event event = trace.begin(); event != trace.end(); ++event) {
+    if (event->isOfType(GROUP_SEND)
+        || event->isOfType(GROUP_RECV)
+        || event->isOfType(MPI_COLLECTIVE_END))
+      local.insert(event->getComm()->getId());
+    else if (event->isOfType(MPI_RMA_PUT_START)
+             || event->isOfType(MPI_RMA_GET_START)
+             || event->isOfType(MPI_RMA_GATS)
+             || event->isOfType(MPI_RMA_COLLECTIVE_END)
+             || event->isOfType(MPI_RMA_LOCK)
+             || event->isOfType(MPI_RMA_UNLOCK))
+      local.insert(event->get_window()->get_comm()->getId());
+  }
+
+  #pragma omp critical
+  {
+    commIds.insert(local.begin(), local.end());
+  }
+  #pragma omp barrier
+  #pragma omp master
+  {
+    PEARL_mpi_create_comms(*mSharedData.mDefinitions,
+                           vector<uint32_t>(commIds.begin(), commIds.end()));
+    commIds.clear();
+  }
+  #pragma omp barrier
+
+  return true;
+}
+
+#endif   // _MPI
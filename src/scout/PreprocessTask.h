@@ -19,16 +19,18 @@
 
 
 #include <pearl/CompoundTask.h>
+#include <pearl/Task.h>
 
 
 /*-------------------------------------------------------------------------*/
 /**
  *  @file  PreprocessTask.h
- *  @brief Declaration of the PreprocessTask class.
+ *  @brief Declaration of the PreprocessTask and CreateCommsTask classes.
  *
  *  This header file provides the declaration of the PreprocessTask class
  *  which performs all necessary preprocessing steps before the analysis can
- *  take place.
+ *  take place, as well as the CreateCommsTask class which creates the MPI
+ *  communicators used by the analysis.
  **/
 /*-------------------------------------------------------------------------*/
 
@@ -66,6 +68,48 @@ class PreprocessTask : public pearl::CompoundTask
 };
 
 
+#if defined(_MPI)
+  /*-----------------------------------------------------------------------*/
+  /**
+   *  @class CreateCommsTask
+   *  @brief Task creating the MPI communicators used by the analysis.
+   *
+   *  This task determines the communicators referenced by the MPI events of
+   *  the local trace data and creates the corresponding MPI communicator
+   *  handles at once (see pearl::PEARL_mpi_create_comms()). Communicators
+   *  not used on any process are not created at all. It has to be executed
+   *  after the trace data has been loaded, but before any replay.
+   **/
+  /*-----------------------------------------------------------------------*/
+
+  class CreateCommsTask : public pearl::Task
+  {
+    public:
+      /// @name Constructors & destructor
+      /// @{
+
+      CreateCommsTask(const TaskDataShared&  sharedData,
+                      const TaskDataPrivate& privateData);
+
+      /// @}
+      /// @name Execution control
+      /// @{
+
+      virtual bool execute();
+
+      /// @}
+
+
+    private:
+      /// Shared task data object
+      const TaskDataShared& mSharedData;
+
+      /// Private task data object
+      const TaskDataPrivate& mPrivateData;
+  };
+#endif   // _MPI
+
+
 }   // namespace scout
 
 
@@ -0,0 +1,439 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+#include "ProfileTask.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#include <pearl/Callpath.h>
+#include <pearl/Event.h>
+#include <pearl/GlobalDefs.h>
+#include <pearl/LocalTrace.h>
+#include <pearl/Location.h>
+#include <pearl/Region.h>
+
+#include "OmpEventHandler.h"
+#include "Pattern.h"
+#include "Patterns_gen.h"
+
+using namespace std;
+using namespace pearl;
+using namespace scout;
+
+
+//--- Local helper classes & constants --------------------------------------
+
+namespace
+{
+
+/// Profile metrics determined by the linear scan
+enum ProfileMetric
+{
+  PM_TIME,
+  PM_VISITS,
+  PM_OMP_MANAGEMENT,
+  PM_OMP_FORK,
+  PM_SYNCS_SEND,
+  PM_SYNCS_RECV,
+  PM_SYNCS_COLL,
+  PM_COMMS_SEND,
+  PM_COMMS_RECV,
+  PM_COMMS_CXCH,
+  PM_COMMS_CSRC,
+  PM_COMMS_CDST,
+  PM_BYTES_SENT,
+  PM_BYTES_RCVD,
+  PM_BYTES_COUT,
+  PM_BYTES_CIN,
+  PM_BYTES_PUT,
+  PM_BYTES_GET,
+
+  NUM_PROFILE_METRICS
+};
+
+
+/// Pattern identifiers of the profile metrics
+const long profilePatternIds[NUM_PROFILE_METRICS] = {
+  PAT_TIME,
+  PAT_VISITS,
+  PAT_OMP_MANAGEMENT,
+  PAT_OMP_FORK,
+  PAT_SYNCS_SEND,
+  PAT_SYNCS_RECV,
+  PAT_SYNCS_COLL,
+  PAT_COMMS_SEND,
+  PAT_COMMS_RECV,
+  PAT_COMMS_CXCH,
+  PAT_COMMS_CSRC,
+  PAT_COMMS_CDST,
+  PAT_BYTES_SENT,
+  PAT_BYTES_RCVD,
+  PAT_BYTES_COUT,
+  PAT_BYTES_CIN,
+  PAT_BYTES_PUT,
+  PAT_BYTES_GET
+};
+
+
+/**
+ *  @brief Dense per-callpath severity values of a single profile metric.
+ *
+ *  Besides the values, it is recorded which call paths have been updated,
+ *  as the set of call paths with data is reported separately from the
+ *  values themselves.
+ **/
+struct ProfileColumn
+{
+  /// Accumulated values indexed by callpath ID
+  vector<double> values;
+
+  /// Update flags indexed by callpath ID
+  vector<uint8_t> touched;
+
+
+  void add(uint32_t id, double value)
+  {
+    values[id] += value;
+    touched[id] = 1;
+  }
+};
+
+
+/// Call stack frame of the linear scan
+struct ProfileFrame
+{
+  /// Timestamp of the ENTER event
+  timestamp_t time;
+
+  /// Callpath ID of the ENTER event
+  uint32_t cnode;
+
+  /// Denotes whether the region is an MPI API function
+  bool isMpi;
+
+  /// Denotes whether the region is an OpenMP parallel region
+  bool isParallel;
+};
+
+}   // unnamed namespace
+
+
+//---------------------------------------------------------------------------
+//
+//  class ProfileTask
+//
+//---------------------------------------------------------------------------
+
+//--- Constructors & destructor ---------------------------------------------
+
+/**
+ *  @brief Constructor. Creates a new profile task.
+ *
+ *  Creates a new profile task instance updating those patterns in the
+ *  given list whose metrics can be determined by the linear scan. The
+ *  OpenMP event handler @a ompHandler is required to determine the thread
+ *  management times in OpenMP-enabled builds; otherwise NULL may be passed.
+ *
+ *  @param  defs        Global definitions object
+ *  @param  trace       Local trace data object
+ *  @param  patterns    List of patterns to be reported
+ *  @param  ompHandler  OpenMP event handler (or NULL)
+ **/
+ProfileTask::ProfileTask(const GlobalDefs&      defs,
+                         const LocalTrace&      trace,
+                         const vector<Pattern*>& patterns,
+                         OmpEventHandler*       ompHandler)
+  : Task(),
+    mDefs(defs),
+    mTrace(trace),
+    mPatterns(NUM_PROFILE_METRICS, static_cast<Pattern*>(NULL)),
+    mOmpHandler(ompHandler)
+{
+  for (vector<Pattern*>::const_iterator it = patterns.begin();
+       it != patterns.end();
+       ++it) {
+    const long id = (*it)->get_id();
+    for (int metric = 0; metric < NUM_PROFILE_METRICS; ++metric)
+      if (profilePatternIds[metric] == id)
+        mPatterns[metric] = *it;
+  }
+}
+
+
+//--- Execution control -----------------------------------------------------
+
+/**
+ *  @brief Determines the profile metrics of the local trace.
+ *
+ *  Scans the local trace once, maintaining a lightweight call stack of the
+ *  enter timestamps and call paths, and accumulates the severities in the
+ *  same order as the corresponding pattern callbacks of the trace replay.
+ *  Receive-side message and byte counts are based on the message sizes
+ *  recorded locally, thus no communication is required.
+ *
+ *  @return @em true (always)
+ **/
+bool ProfileTask::execute()
+{
+  const uint32_t numCallpaths = mDefs.numCallpaths();
+
+  vector<ProfileColumn> columns(NUM_PROFILE_METRICS);
+  for (int metric = 0; metric < NUM_PROFILE_METRICS; ++metric) {
+    if (mPatterns[metric]) {
+      columns[metric].values.resize(numCallpaths, 0.0);
+      columns[metric].touched.resize(numCallpaths, 0);
+    }
+  }
+
+  // Determine the team-wide fork/join times (collective across the team)
+  #if defined(_OPENMP)
+    const bool hasMgmt   = (mPatterns[PM_OMP_MANAGEMENT] != NULL);
+    const bool hasFork   = (mPatterns[PM_OMP_FORK] != NULL);
+    uint32_t   forkCount = 0;
+    uint32_t   joinCount = 0;
+    if (mOmpHandler)
+      mOmpHandler->prepareTeamData(mTrace);
+  #endif   // _OPENMP
+
+  const bool hasTime  = (mPatterns[PM_TIME] != NULL);
+  const bool hasSend  = mPatterns[PM_SYNCS_SEND] || mPatterns[PM_COMMS_SEND]
+                        || mPatterns[PM_BYTES_SENT];
+  const bool hasRecv  = mPatterns[PM_SYNCS_RECV] || mPatterns[PM_COMMS_RECV]
+                        || mPatterns[PM_BYTES_RCVD];
+  const bool hasColl  = mPatterns[PM_SYNCS_COLL] || mPatterns[PM_COMMS_CXCH]
+                        || mPatterns[PM_COMMS_CSRC] || mPatterns[PM_COMMS_CDST]
+                        || mPatterns[PM_BYTES_COUT] || mPatterns[PM_BYTES_CIN];
+
+  vector<ProfileFrame> stack;
+  for (Event event = mTrace.begin(); event != mTrace.end(); ++event) {
+    const Event_rep& rep = *event;
+
+    switch (rep.getType()) {
+      case ENTER:
+      case ENTER_CS:
+        {
+          const Region& region = rep.getRegion();
+          ProfileFrame  frame;
+
+          frame.time       = rep.getTimestamp();
+          frame.cnode      = event.get_cnode()->getId();
+          frame.isMpi      = is_mpi_api(region);
+          frame.isParallel = mOmpHandler && is_omp_parallel(region);
+          stack.push_back(frame);
+
+          if (mPatterns[PM_VISITS])
+            columns[PM_VISITS].add(frame.cnode, 1.0);
+
+          #if defined(_OPENMP)
+            if (frame.isParallel) {
+              const double idle =
+                max(0.0, frame.time - mOmpHandler->getTeamForkTime(forkCount++));
+
+              if (hasMgmt)
+                columns[PM_OMP_MANAGEMENT].add(frame.cnode, idle);
+              if (hasFork)
+                columns[PM_OMP_FORK].add(frame.cnode, idle);
+              if (hasTime)
+                columns[PM_TIME].add(frame.cnode, idle);
+            }
+          #endif   // _OPENMP
+        }
+        break;
+
+      case LEAVE:
+        if (!stack.empty()) {
+          const ProfileFrame frame = stack.back();
+          stack.pop_back();
+
+          const timestamp_t time = rep.getTimestamp();
+          if (hasTime)
+            columns[PM_TIME].add(frame.cnode, time - frame.time);
+
+          #if defined(_OPENMP)
+            if (frame.isParallel) {
+              const double idle =
+                max(0.0, mOmpHandler->getTeamJoinTime(joinCount++) - time);
+
+              if (hasMgmt)
+                columns[PM_OMP_MANAGEMENT].add(frame.cnode, idle);
+              if (hasTime)
+                columns[PM_TIME].add(frame.cnode, idle);
+            }
+          #endif   // _OPENMP
+        }
+        break;
+
+      case MPI_SEND:
+      case MPI_SEND_REQUEST:
+        if (hasSend) {
+          const uint32_t cnode = stack.empty()
+                                 ? event.get_cnode()->getId()
+                                 : stack.back().cnode;
+          const uint64_t bytes = rep.getBytesSent();
+
+          if (bytes == 0) {
+            if (mPatterns[PM_SYNCS_SEND])
+              columns[PM_SYNCS_SEND].add(cnode, 1.0);
+          } else {
+            if (mPatterns[PM_COMMS_SEND])
+              columns[PM_COMMS_SEND].add(cnode, 1.0);
+            if (mPatterns[PM_BYTES_SENT])
+              columns[PM_BYTES_SENT].add(cnode, bytes);
+          }
+        }
+        break;
+
+      case MPI_RECV:
+      case MPI_RECV_COMPLETE:
+        // Only receives issued from within MPI are considered
+        if (hasRecv && !stack.empty() && stack.back().isMpi) {
+          const uint32_t cnode = stack.back().cnode;
+          const uint64_t bytes = rep.getBytesReceived();
+
+          if (bytes == 0) {
+            if (mPatterns[PM_SYNCS_RECV])
+              columns[PM_SYNCS_RECV].add(cnode, 1.0);
+          } else {
+            if (mPatterns[PM_COMMS_RECV])
+              columns[PM_COMMS_RECV].add(cnode, 1.0);
+            if (mPatterns[PM_BYTES_RCVD])
+              columns[PM_BYTES_RCVD].add(cnode, bytes);
+          }
+        }
+        break;
+
+      case MPI_COLLECTIVE_END:
+        if (hasColl) {
+          const uint32_t cnode = stack.empty()
+                                 ? event.get_cnode()->getId()
+                                 : stack.back().cnode;
+          const uint64_t sent     = rep.getBytesSent();
+          const uint64_t received = rep.getBytesReceived();
+
+          ProfileMetric counted = PM_SYNCS_COLL;
+          if (sent != 0 && received != 0)
+            counted = PM_COMMS_CXCH;
+          else if (sent != 0)
+            counted = PM_COMMS_CSRC;
+          else if (received != 0)
+            counted = PM_COMMS_CDST;
+          if (mPatterns[counted])
+            columns[counted].add(cnode, 1.0);
+
+          if (sent > 0 && mPatterns[PM_BYTES_COUT])
+            columns[PM_BYTES_COUT].add(cnode, sent);
+          if (received > 0 && mPatterns[PM_BYTES_CIN])
+            columns[PM_BYTES_CIN].add(cnode, received);
+        }
+        break;
+
+      case MPI_RMA_PUT_START:
+        if (mPatterns[PM_BYTES_PUT])
+          columns[PM_BYTES_PUT].add(event.get_cnode()->getId(),
+                                    rep.getBytesSent());
+        break;
+
+      case MPI_RMA_GET_START:
+        if (mPatterns[PM_BYTES_GET])
+          columns[PM_BYTES_GET].add(event.get_cnode()->getId(),
+                                    rep.getBytesReceived());
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  // Inclusify the time profile of worker threads outside of parallel
+  // regions, processing the call paths in the same order as the replay
+  if (hasTime && (mTrace.get_location().getThreadId() != 0)) {
+    ProfileColumn& time = columns[PM_TIME];
+
+    for (uint32_t id = 0; id < numCallpaths; ++id) {
+      Callpath* callpath = mDefs.get_cnode(id);
+      if (!is_omp_parallel(callpath->getRegion()))
+        continue;
+
+      const double value = time.values[id];
+      time.touched[id] = 1;
+
+      Callpath* parent = callpath->getParent();
+      while (parent) {
+        time.add(parent->getId(), value);
+        parent = parent->getParent();
+      }
+    }
+  }
+
+  // Transfer severities
+  for (int metric = 0; metric < NUM_PROFILE_METRICS; ++metric) {
+    Pattern* pattern = mPatterns[metric];
+    if (!pattern)
+      continue;
+
+    const ProfileColumn& column = columns[metric];
+    for (uint32_t id = 0; id < numCallpaths; ++id)
+      if (column.touched[id])
+        pattern->add_severity(mDefs.get_cnode(id), column.values[id]);
+  }
+
+  return true;
+}
+
+
+//--- Query functions -------------------------------------------------------
+
+/**
+ *  @brief Checks whether a pattern can be computed by the profile task.
+ *
+ *  @param  id  Pattern identifier
+ *  @return @em true if the pattern's severities are determined by the
+ *          linear scan, @em false otherwise
+ **/
+bool ProfileTask::isProfilePattern(long id)
+{
+  for (int metric = 0; metric < NUM_PROFILE_METRICS; ++metric)
+    if (profilePatternIds[metric] == id)
+      return true;
+
+  return false;
+}
+
+
+/**
+ *  @brief Checks whether the profile task supports the given trace.
+ *
+ *  The linear scan does not handle the interleaved call stacks of OpenMP
+ *  tasks as well as the thread stub nodes of POSIX threads. As the check
+ *  is based on the global call tree, all processes and threads come to the
+ *  same conclusion.
+ *
+ *  @param  defs  Global definitions object
+ *  @return @em true if no task or thread root call paths exist, @em false
+ *          otherwise
+ **/
+bool ProfileTask::isSupported(const GlobalDefs& defs)
+{
+  const Region& taskRoot   = defs.getTaskRootRegion();
+  const Region& threadRoot = defs.getThreadRootRegion();
+
+  const uint32_t count = defs.numCallpaths();
+  for (uint32_t id = 0; id < count; ++id) {
+    const Region& region = defs.get_cnode(id)->getRegion();
+    if ((region == taskRoot) || (region == threadRoot))
+      return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,119 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#ifndef SCOUT_PROFILETASK_H
+#define SCOUT_PROFILETASK_H
+
+
+#include <vector>
+
+#include <pearl/Task.h>
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file  ProfileTask.h
+ *  @brief Declaration of the ProfileTask class.
+ *
+ *  This header file provides the declaration of the ProfileTask class which
+ *  determines the basic profile metrics of a local trace without performing
+ *  a trace replay.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+//--- Forward declarations --------------------------------------------------
+
+namespace pearl
+{
+
+class GlobalDefs;
+class LocalTrace;
+
+}   // namespace pearl
+
+
+namespace scout
+{
+
+//--- Forward declarations --------------------------------------------------
+
+class OmpEventHandler;
+class Pattern;
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class ProfileTask
+ *  @brief Task computing the profile metrics in a single linear scan.
+ *
+ *  The ProfileTask class determines the severities of the metrics which
+ *  only depend on local information, i.e., execution time, visits, and
+ *  the message/byte counts, by scanning the local trace once from begin to
+ *  end. In contrast to the trace replay, no callbacks are dispatched and
+ *  no communication is performed (except for the team-wide pre-pass of
+ *  the OpenMP fork/join times). The values are accumulated in dense
+ *  per-callpath arrays and transferred to the corresponding pattern objects
+ *  afterwards, yielding the same severities as the replay-based analysis.
+ *
+ *  Metrics requiring remote information, e.g., the wait-state counts, are
+ *  not supported; see isProfilePattern(). Moreover, traces containing
+ *  OpenMP tasks or POSIX threads are not supported; see isSupported().
+ **/
+/*-------------------------------------------------------------------------*/
+
+class ProfileTask : public pearl::Task
+{
+  public:
+    /// @name Constructors & destructor
+    /// @{
+
+    ProfileTask(const pearl::GlobalDefs&    defs,
+                const pearl::LocalTrace&    trace,
+                const std::vector<Pattern*>& patterns,
+                OmpEventHandler*            ompHandler);
+
+    /// @}
+    /// @name Execution control
+    /// @{
+
+    virtual bool execute();
+
+    /// @}
+    /// @name Query functions
+    /// @{
+
+    static bool isProfilePattern(long id);
+    static bool isSupported(const pearl::GlobalDefs& defs);
+
+    /// @}
+
+
+  private:
+    /// Global definitions object
+    const pearl::GlobalDefs& mDefs;
+
+    /// Local trace data object
+    const pearl::LocalTrace& mTrace;
+
+    /// Patterns to be updated, indexed by profile metric
+    std::vector<Pattern*> mPatterns;
+
+    /// OpenMP event handler providing the fork/join times (or NULL)
+    OmpEventHandler* mOmpHandler;
+};
+
+
+}   // namespace scout
+
+
+#endif   // !SCOUT_PROFILETASK_H
@@ -17,7 +17,10 @@
 #include <config.h>
 #include "Quantile.h"
 
+#include <pearl/Buffer.h>
+
 using namespace std;
+using namespace pearl;
 using namespace scout;
 
 
@@ -247,6 +250,60 @@ void Quantile::set_global_values(int number_obs, double sum_obs, double squared_
 }
 
 
+//--- Serialization ---------------------------------------------------------
+
+/**
+ *  @brief Stores the collected data in a buffer.
+ *
+ *  Packs the standardisation factor, the observation counters and the
+ *  coefficients of the approximated density function into the given
+ *  @a buffer, such that the statistics can be continued or merged later
+ *  (e.g., when resuming an analysis from a checkpoint).
+ *
+ *  @param  buffer  Buffer to store the data in
+ **/
+void Quantile::pack(Buffer& buffer) const
+{
+  buffer.put_double(m_factor);
+  buffer.put_double(m_number_obs);
+  buffer.put_double(m_sum_obs);
+  buffer.put_double(m_squared_sum_obs);
+  buffer.put_double(m_min_val);
+  buffer.put_double(m_max_val);
+  for (int i = 0; i < m_number_coeff; ++i) {
+    buffer.put_double(m_coeff[i]);
+#ifdef ADAPTIVE_APPROACH
+    buffer.put_double(m_control_val[i]);
+#endif
+  }
+}
+
+
+/**
+ *  @brief Restores the collected data from a buffer.
+ *
+ *  Unpacks the data previously stored by pack() from the given @a buffer.
+ *  The number of coefficients has to match the one of the packing instance.
+ *
+ *  @param  buffer  Buffer to retrieve the data from
+ **/
+void Quantile::unpack(Buffer& buffer)
+{
+  m_factor          = buffer.get_double();
+  m_number_obs      = buffer.get_double();
+  m_sum_obs         = buffer.get_double();
+  m_squared_sum_obs = buffer.get_double();
+  m_min_val         = buffer.get_double();
+  m_max_val         = buffer.get_double();
+  for (int i = 0; i < m_number_coeff; ++i) {
+    m_coeff[i] = buffer.get_double();
+#ifdef ADAPTIVE_APPROACH
+    m_control_val[i] = buffer.get_double();
+#endif
+  }
+}
+
+
 //--- Modify and calculate the density --------------------------------------
 
 /**
@@ -23,6 +23,16 @@
 #define ADAPTIVE_APPROACH
 
 
+//--- Forward declarations --------------------------------------------------
+
+namespace pearl
+{
+
+class Buffer;
+
+}   // namespace pearl
+
+
 /*-------------------------------------------------------------------------*/
 /**
  *  @file  Quantile.h
@@ -86,6 +96,13 @@ class Quantile
     void set_global_values(int number_obs, double sum_obs, double squared_sum_obs, double min_val, double max_val, double *coeff);
 #endif
 
+    /// @}
+    /// @name Serialization
+    /// @{
+
+    void pack(pearl::Buffer& buffer) const;
+    void unpack(pearl::Buffer& buffer);
+
     /// @}
     /// @name Modify and calculate the density
     /// @{
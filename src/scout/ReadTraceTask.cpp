@@ -18,6 +18,8 @@
 #include "ReadTraceTask.h"
 
 #include <cstddef>
+#include <map>
+#include <set>
 
 #if defined(_MPI)
   #include <mpi.h>
@@ -27,10 +29,16 @@
 #endif
 
 #include <pearl/Error.h>
+#include <pearl/Event.h>
 #include <pearl/GlobalDefs.h>
 #include <pearl/LocalTrace.h>
 #include <pearl/TraceArchive.h>
 
+#if defined(_MPI)
+  #include <pearl/MpiComm.h>
+  #include <pearl/MpiWindow.h>
+#endif   // _MPI
+
 #include "CheckedTask.h"
 #include "TaskData.h"
 #include "TimedPhase.h"
@@ -38,6 +46,8 @@
 using namespace pearl;
 using namespace scout;
 
+extern bool enableThreadMultiple;
+
 
 //--- Local helper macros ---------------------------------------------------
 
@@ -179,39 +189,6 @@ class CloseTraceContainer : public pearl::Task
     const TaskDataShared& mSharedData;
 };
 
-
-#if defined(_OPENMP)
-  /**
-   *  @class CheckTraceData
-   *  @brief Task verifying some consistency requirements for OpenMP.
-   *
-   *  This task verifies whether some consietency requirements for OpenMP
-   *  traces (no varying number of threads, MPI only on master thread, etc.)
-   *  are fulfilled.
-   **/
-  class CheckTraceData : public pearl::Task
-  {
-    public:
-      /// @name Constructors & destructor
-      /// @{
-
-      CheckTraceData(const TaskDataPrivate& privateData);
-
-      /// @}
-      /// @name Execution control
-      /// @{
-
-      virtual bool execute();
-
-      /// @}
-
-
-    private:
-      /// Private task data object
-      const TaskDataPrivate& mPrivateData;
-  };
-#endif   // _OPENMP
-
 }   // unnamed namespace
 
 
@@ -485,6 +462,68 @@ bool CloseTraceContainer::execute()
 
 #if defined(_OPENMP)
 
+//--- Local helper functions ------------------------------------------------
+
+#if defined(_MPI)
+namespace
+{
+/// Point-to-point message channel (direction, communicator, global peer
+/// rank, tag) from the local process' point of view
+struct ChannelKey
+{
+  uint32_t direction;
+  uint32_t comm;
+  uint32_t peer;
+  uint32_t tag;
+
+  bool operator<(const ChannelKey& rhs) const
+  {
+    if (direction != rhs.direction)
+      return direction < rhs.direction;
+    if (comm != rhs.comm)
+      return comm < rhs.comm;
+    if (peer != rhs.peer)
+      return peer < rhs.peer;
+
+    return tag < rhs.tag;
+  }
+};
+
+
+/**
+ *  @brief Claims the given keys for the calling thread.
+ *
+ *  Records the thread @a threadId as the owner of all entries in @a keys
+ *  not yet found in @a owners. Has to be called inside a critical section.
+ *
+ *  @param  owners    Mapping from keys to owning threads
+ *  @param  keys      Keys used by the calling thread
+ *  @param  threadId  Thread identifier of the calling thread
+ *
+ *  @return True if none of the keys is owned by another thread, false
+ *          otherwise
+ **/
+template<typename KeyT>
+bool claimKeys(std::map<KeyT, int>&  owners,
+               const std::set<KeyT>& keys,
+               int                   threadId)
+{
+  bool result = true;
+
+  typename std::set<KeyT>::const_iterator it = keys.begin();
+  while (it != keys.end()) {
+    typename std::map<KeyT, int>::iterator entry =
+      owners.insert(std::make_pair(*it, threadId)).first;
+    result = result && (entry->second == threadId);
+    ++it;
+  }
+
+  return result;
+}
+}   // unnamed namespace
+#endif   // _MPI
+
+
 //--- Constructors & destructor ---------------------------------------------
 
 /**
@@ -508,7 +547,8 @@ CheckTraceData::CheckTraceData(const TaskDataPrivate& privateData)
  *  @brief Executes the task.
  *
  *  Verifies whether some consistency requirements for OpenMP (no varying
- *  number of threads, MPI only on master thread, etc.) are fulfilled.
+ *  number of threads, MPI only on master thread unless the thread-multiple
+ *  replay is enabled, etc.) are fulfilled.
  *
  *  @return Always true
  *  @throw  pearl::FatalError  if the OpenMP consistency requirements are not
@@ -547,19 +587,97 @@ bool CheckTraceData::execute()
                        "not supported!");
 
     //--- Ensure that MPI calls only occur on master thread ---
-    // Compare MPI region count on each thread and update status
-    #pragma omp barrier
-    #pragma omp critical
-    {
-      if (0 != omp_get_thread_num())
-        is_ok = is_ok && (0 == trace.num_mpi_regions());
+    // (not required by the thread-multiple replay)
+    if (!enableThreadMultiple) {
+      // Compare MPI region count on each thread and update status
+      #pragma omp barrier
+      #pragma omp critical
+      {
+        if (0 != omp_get_thread_num())
+          is_ok = is_ok && (0 == trace.num_mpi_regions());
+      }
+      #pragma omp barrier
+
+      // Check status and abort if MPI calls found on non-master thread
+      if (!is_ok)
+        throw FatalError("MPI calls on threads other than the master thread "
+                         "require the '--thread-multiple' option!");
     }
-    #pragma omp barrier
-
-    // Check status and abort if MPI calls found on non-master thread
-    if (!is_ok)
-      throw FatalError("MPI calls on threads other than the master thread "
-                       "not supported!");
+    #if defined(_MPI)
+      else {
+        //--- Ensure that communicators and channels are used by one thread ---
+        // MPI forbids concurrent collectives on the same communicator, and
+        // point-to-point messages are only matched by communicator, peer and
+        // tag. The replay can thus neither reproduce the order of collectives
+        // issued by different threads consistently across processes, nor
+        // the matching of messages on a channel shared by several threads.
+
+        // These variables are implicitly shared
+        static std::map<uint32_t, int>   collThread;
+        static std::map<ChannelKey, int> channelThread;
+        static bool                      isChannelOk;
+
+        std::set<uint32_t>   comms;
+        std::set<ChannelKey> channels;
+        for (Event event = trace.begin(); event != trace.end(); ++event) {
+          if (event->isOfType(MPI_COLLECTIVE_END)) {
+            comms.insert(event->getComm()->getId());
+          }
+          else if (event->isOfType(MPI_RMA_COLLECTIVE_END)) {
+            comms.insert(event->get_window()->get_comm()->getId());
+          }
+          else if (event->isOfType(GROUP_SEND)
+                   || event->isOfType(GROUP_RECV)) {
+            const bool isSend = event->isOfType(GROUP_SEND);
+
+            // Cancelled sends are not transferred during the replay
+            if (isSend && event.completion()->isOfType(MPI_CANCELLED))
+              continue;
+
+            const MpiComm* comm   = event->getComm();
+            const uint32_t rank   = isSend ? event->getDestination()
+                                           : event->getSource();
+            ChannelKey     key    = { isSend ? 0u : 1u,
+                                      comm->getId(),
+                                      static_cast<uint32_t>(
+                                        comm->getGroup().getGlobalRank(rank)),
+                                      event->getTag() };
+            channels.insert(key);
+          }
+        }
+
+        // Record the thread using each communicator and channel
+        const int threadId = omp_get_thread_num();
+        #pragma omp master
+        {
+          isChannelOk = true;
+        }
+        #pragma omp barrier
+        #pragma omp critical
+        {
+          is_ok       = claimKeys(collThread, comms, threadId) && is_ok;
+          isChannelOk = claimKeys(channelThread, channels, threadId)
+                        && isChannelOk;
+        }
+        #pragma omp barrier
+        #pragma omp master
+        {
+          collThread.clear();
+          channelThread.clear();
+        }
+
+        // Check status and abort if a communicator or channel is shared
+        if (!is_ok)
+          throw FatalError("Collective MPI operations on the same communicator "
+                           "from multiple threads are not supported by the "
+                           "'--thread-multiple' replay!");
+        if (!isChannelOk)
+          throw FatalError("Point-to-point messages with the same "
+                           "communicator, peer, and tag on multiple threads "
+                           "are not supported by the '--thread-multiple' "
+                           "replay!");
+      }
+    #endif   // _MPI
   }
 
   return true;
@@ -24,10 +24,11 @@
 /*-------------------------------------------------------------------------*/
 /**
  *  @file  ReadTraceTask.h
- *  @brief Declaration of the ReadTraceTask class.
+ *  @brief Declaration of the ReadTraceTask and CheckTraceData classes.
  *
  *  This header file provides the declaration of the ReadTraceTask class
- *  which is used to read in the trace data per location.
+ *  which is used to read in the trace data per location, as well as the
+ *  CheckTraceData class verifying the OpenMP consistency requirements.
  **/
 /*-------------------------------------------------------------------------*/
 
@@ -64,6 +65,44 @@ class ReadTraceTask : public pearl::CompoundTask
 };
 
 
+#if defined(_OPENMP)
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class CheckTraceData
+ *  @brief Task verifying some consistency requirements for OpenMP.
+ *
+ *  This task verifies whether some consistency requirements for OpenMP
+ *  traces (no varying number of threads, MPI only on master thread, etc.)
+ *  are fulfilled. It is run as part of ReadTraceTask, but also on trace
+ *  data loaded from the trace cache, as the requirements are not covered
+ *  by the cache stamp.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class CheckTraceData : public pearl::Task
+{
+  public:
+    /// @name Constructors & destructor
+    /// @{
+
+    CheckTraceData(const TaskDataPrivate& privateData);
+
+    /// @}
+    /// @name Execution control
+    /// @{
+
+    virtual bool execute();
+
+    /// @}
+
+
+  private:
+    /// Private task data object
+    const TaskDataPrivate& mPrivateData;
+};
+#endif   // _OPENMP
+
+
 }   // namespace scout
 
 
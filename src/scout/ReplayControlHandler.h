@@ -50,6 +50,9 @@ public:
 
   ~ReplayControlHandler();
 
+  const char* get_name() const
+    { return "ReplayControlHandler"; }
+
   virtual void register_pre_pattern_callbacks (const CallbackManagerMap& cbm);
 };
 
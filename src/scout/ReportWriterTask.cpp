@@ -1,7 +1,7 @@
 /****************************************************************************
 **  SCALASCA    http://www.scalasca.org/                                   **
 *****************************************************************************
-**  Copyright (c) 1998-2015                                                **
+**  Copyright (c) 1998-2016                                                **
 **  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
 **                                                                         **
 **  Copyright (c) 2009-2013                                                **
@@ -15,13 +15,15 @@
 
 
 #define __STDC_CONSTANT_MACROS
+#define __STDC_FORMAT_MACROS
 
 #include <config.h>
 #include "ReportWriterTask.h"
 
 #include <cassert>
 #include <cstdio>
-#include <sstream>
+#include <inttypes.h>
+#include <string>
 #include <vector>
 
 #if defined(_MPI)
@@ -54,6 +56,63 @@ using namespace scout;
 #define PRIMARY_MIRROR     "http://apps.fz-juelich.de/scalasca/releases/scalasca/2.0/help/"
 
 
+//---------------------------------------------------------------------------
+//
+//  struct ReportWriterTask::DefinitionTables
+//
+//---------------------------------------------------------------------------
+
+/**
+ *  @brief Definition data prepared for the CUBE report.
+ *
+ *  The DefinitionTables struct stores all data derived from the global
+ *  definitions which is required to define the CUBE metadata, i.e., object
+ *  names, converted attributes, and topology coordinates. This data is
+ *  computed upfront, such that the actual definition of the CUBE objects
+ *  (which is not thread-safe) only needs to pass the prepared values.
+ **/
+struct ReportWriterTask::DefinitionTables
+{
+    /// Prepared data of a Cartesian topology
+    struct Cartesian
+    {
+        /// Number of locations per dimension
+        vector<long> mDims;
+
+        /// Periodicity per dimension
+        vector<int> mPeriods;
+
+        /// IDs of the locations with a coordinate
+        vector<Location::IdType> mLocations;
+
+        /// Location coordinates (number of dimensions entries per location)
+        vector<long> mCoords;
+    };
+
+
+    /// System tree node names, indexed by node ID
+    vector<string> mSystemNodeNames;
+
+    /// Location group names, indexed by location group ID
+    vector<string> mLocationGroupNames;
+
+    /// Location names, in order of location groups and locations therein
+    vector<string> mLocationNames;
+
+    /// Region paradigm names, indexed by region ID
+    vector<string> mRegionParadigms;
+
+    /// Region role names, indexed by region ID
+    vector<string> mRegionRoles;
+
+    /// Flags indicating dummy call paths, indexed by call path ID
+    vector<bool> mDummyCallpaths;
+
+    /// Cartesian topologies, indexed by topology ID
+    vector<Cartesian> mCartesians;
+};
+
+
 //---------------------------------------------------------------------------
 //
 //  class ReportWriterTask
@@ -93,7 +152,9 @@ ReportWriterTask::ReportWriterTask(const TaskDataShared& sharedData,
  *
  *  The writer task first creates the CUBE output file, writes the static
  *  definition data (meta data) to it, and incrementally collates and writes
- *  the per-pattern severity data.
+ *  the per-pattern severity data. The definition data is prepared in bulk
+ *  beforehand, distributing the independent parts across the available
+ *  threads.
  *
  *  @return Returns @em true if the execution was successful, @em false
  *          otherwise
@@ -102,8 +163,9 @@ ReportWriterTask::ReportWriterTask(const TaskDataShared& sharedData,
 bool
 ReportWriterTask::execute()
 {
-    // This variable is implicitly shared!
-    static int error = 0;
+    // These variables are implicitly shared!
+    static int               error  = 0;
+    static DefinitionTables* tables = NULL;
 
     ReportData data(*mSharedData.mDefinitions, mRank);
     if (0 == mRank) {
@@ -118,22 +180,42 @@ ReportWriterTask::execute()
       #if defined(_MPI)
             MPI_Bcast(&error, 1, MPI_INT, 0, MPI_COMM_WORLD);
       #endif   // _MPI
+
+            if (!error) {
+                tables = new DefinitionTables;
+            }
         }
     #pragma omp barrier
         if (error) {
             throw FatalError("Could not create CUBE report!");
         }
+
+        // Prepare definition data
+    #pragma omp sections
+        {
+        #pragma omp section
+            prepare_sysinfo(*tables);
+        #pragma omp section
+            prepare_regions(*tables);
+        #pragma omp section
+            prepare_cnodes(*tables);
+        #pragma omp section
+            prepare_cartesians(*tables);
+        }
     #pragma omp master
         {
             // Write static definition data
             cube_def_mirror(data.cb, PRIMARY_MIRROR);
             cube_def_attr(data.cb, "CUBE_CT_AGGR", "SUM");
 
-            gen_sysinfo(data);
-            gen_regions(data);
-            gen_cnodes(data);
-            gen_cartesians(data);
+            gen_sysinfo(data, *tables);
+            gen_regions(data, *tables);
+            gen_cnodes(data, *tables);
+            gen_cartesians(data, *tables);
             mAnalyzer->genCubeMetrics(data);
+
+            delete tables;
+            tables = NULL;
         }
 
         // Collate severity data
@@ -165,6 +247,198 @@ ReportWriterTask::execute()
 }
 
 
+//--- Report data preparation -----------------------------------------------
+
+/**
+ *  @brief Prepares the system hierarchy information.
+ *
+ *  This method determines the names of all system tree nodes, location
+ *  groups, and locations based on the information available in the global
+ *  definitions object and stores them in @a tables. Unknown location
+ *  (group) types are reported later by gen_sysinfo().
+ *
+ *  @param  tables  Definition tables
+ **/
+void
+ReportWriterTask::prepare_sysinfo(DefinitionTables& tables) const
+{
+    const GlobalDefs& defs = *mSharedData.mDefinitions;
+
+    // System tree node names
+    uint32_t count = defs.numSystemNodes();
+    tables.mSystemNodeNames.resize(count);
+    for (uint32_t index = 0; index < count; ++index) {
+        const SystemNode& snode = defs.getSystemNode(index);
+        string&           name  = tables.mSystemNodeNames[index];
+
+        const string& className = snode.getClassName().getString();
+        const string& nodeName  = snode.getName().getString();
+        name.reserve(className.length() + nodeName.length() + 1);
+        name.append(className).append(1, ' ').append(nodeName);
+    }
+
+    // Location group & location names
+    count = defs.numLocationGroups();
+    tables.mLocationGroupNames.resize(count);
+    tables.mLocationNames.resize(defs.numLocations());
+
+    uint32_t locIndex = 0;
+    char     buffer[64];
+    for (uint32_t index = 0; index < count; ++index) {
+        const LocationGroup& lgroup = defs.getLocationGroup(index);
+
+        if (lgroup.getName().getString().empty()) {
+            if (LocationGroup::TYPE_PROCESS == lgroup.getType()) {
+                snprintf(buffer, sizeof(buffer), "MPI rank %" PRIu32,
+                         lgroup.getId());
+                tables.mLocationGroupNames[index] = buffer;
+            }
+        } else {
+            tables.mLocationGroupNames[index] = lgroup.getName().getString();
+        }
+
+        uint32_t numLocs = lgroup.numLocations();
+        for (uint32_t locIdx = 0; locIdx < numLocs; ++locIdx, ++locIndex) {
+            const Location& location = lgroup.getLocation(locIdx);
+
+            if (!location.getName().getString().empty()) {
+                tables.mLocationNames[locIndex] = location.getName().getString();
+                continue;
+            }
+
+            const char* prefix = NULL;
+            switch (location.getType()) {
+                case Location::TYPE_CPU_THREAD:
+                    prefix = "CPU thread";
+                    break;
+
+                case Location::TYPE_GPU:
+                    prefix = "GPU";
+                    break;
+
+                case Location::TYPE_METRIC:
+                    prefix = "metric location";
+                    break;
+
+                default:
+                    break;
+            }
+            if (prefix) {
+                snprintf(buffer, sizeof(buffer), "%s %" PRIu32,
+                         prefix, location.getThreadId());
+                tables.mLocationNames[locIndex] = buffer;
+            }
+        }
+    }
+}
+
+
+/**
+ *  @brief Prepares the source-code region information.
+ *
+ *  This method converts the paradigm and role attributes of all source-code
+ *  regions available in the global definitions object to their string
+ *  representations and stores them in @a tables.
+ *
+ *  @param  tables  Definition tables
+ **/
+void
+ReportWriterTask::prepare_regions(DefinitionTables& tables) const
+{
+    const GlobalDefs& defs = *mSharedData.mDefinitions;
+
+    uint32_t count = defs.numRegions();
+    tables.mRegionParadigms.resize(count);
+    tables.mRegionRoles.resize(count);
+    for (ident_t id = 0; id < count; ++id) {
+        const Region& region = defs.getRegion(id);
+
+        tables.mRegionParadigms[id] = pearl::toString(region.getParadigm());
+        tables.mRegionRoles[id]     = pearl::toString(region.getRole());
+    }
+}
+
+
+/**
+ *  @brief Prepares the call tree information.
+ *
+ *  This method determines which call paths available in the global
+ *  definitions object are dummy entries that must not be defined in the
+ *  report, and stores the corresponding flags in @a tables.
+ *
+ *  @param  tables  Definition tables
+ **/
+void
+ReportWriterTask::prepare_cnodes(DefinitionTables& tables) const
+{
+    const GlobalDefs& defs = *mSharedData.mDefinitions;
+
+    uint32_t count = defs.numCallpaths();
+    tables.mDummyCallpaths.resize(count);
+    for (ident_t id = 0; id < count; ++id) {
+        const Region& region = defs.get_cnode(id)->getRegion();
+
+        // Special case: "UNKNOWN" callpath found in EPIK traces
+        tables.mDummyCallpaths[id] =
+            ("UNKNOWN" == region.getDisplayName().getString())
+            && ("EPIK" == region.getFilename().getString())
+            && ("EPIK" == region.getDescription().getString());
+    }
+}
+
+
+/**
+ *  @brief Prepares the topology information.
+ *
+ *  This method converts the Cartesian topologies available in the global
+ *  definitions object, including the coordinates of all locations mapped
+ *  onto them, to the CUBE-conforming format and stores them in @a tables.
+ *
+ *  @param  tables  Definition tables
+ **/
+void
+ReportWriterTask::prepare_cartesians(DefinitionTables& tables) const
+{
+    const GlobalDefs& defs = *mSharedData.mDefinitions;
+
+    uint32_t ncarts = defs.num_cartesians();
+    uint32_t nlocs  = defs.numLocations();
+    tables.mCartesians.resize(ncarts);
+    for (ident_t cid = 0; cid < ncarts; ++cid) {
+        const pearl::Cartesian*      cart   = defs.get_cartesian(cid);
+        DefinitionTables::Cartesian& ccart  = tables.mCartesians[cid];
+        uint32_t                     ndims  = cart->num_dimensions();
+
+        // Query topology information
+        vector<uint32_t> dimv;
+        vector<bool>     periodv;
+        cart->get_dimensionv(dimv);
+        cart->get_periodv(periodv);
+
+        // Transform topology information to CUBE-conforming format
+        ccart.mDims.assign(dimv.begin(), dimv.end());
+        ccart.mPeriods.assign(periodv.begin(), periodv.end());
+
+        // Transform the coordinates
+        ccart.mLocations.reserve(nlocs);
+        ccart.mCoords.reserve(static_cast<size_t>(nlocs) * ndims);
+        vector<uint32_t> coordv;
+        for (uint32_t index = 0; index < nlocs; ++index) {
+            const Location& location = defs.getLocationByIndex(index);
+
+            try {
+                cart->get_coords(location, coordv);
+            }
+            catch (const Error&) {
+                continue;
+            }
+            ccart.mLocations.push_back(location.getId());
+            ccart.mCoords.insert(ccart.mCoords.end(), coordv.begin(), coordv.end());
+        }
+    }
+}
+
+
 //--- Report data generation ------------------------------------------------
 
 /**
@@ -172,15 +446,17 @@ ReportWriterTask::execute()
  *
  *  This method defines the CUBE system hierarchy in the CUBE object passed
  *  via @a data based on the information available in the global definitions
- *  object.
+ *  object and the names prepared in @a tables.
  *
- *  @param  data  Report data structure
+ *  @param  data    Report data structure
+ *  @param  tables  Definition tables
  *
  *  @todo
  *    - Fix implicit assumption that location group ID == MPI rank
  **/
 void
-ReportWriterTask::gen_sysinfo(ReportData& data) const
+ReportWriterTask::gen_sysinfo(ReportData&             data,
+                              const DefinitionTables& tables) const
 {
     const GlobalDefs& defs = *mSharedData.mDefinitions;
 
@@ -192,6 +468,7 @@ ReportWriterTask::gen_sysinfo(ReportData& data) const
 
     // Create system tree nodes
     uint32_t count = defs.numSystemNodes();
+    snodes.reserve(count);
     for (uint32_t index = 0; index < count; ++index) {
         const SystemNode& snode = defs.getSystemNode(index);
 
@@ -202,14 +479,10 @@ ReportWriterTask::gen_sysinfo(ReportData& data) const
             cparent = snodes[parent->getId()];
         }
 
-        // Construct node name
-        string name = snode.getClassName().getString() + " "
-                      + snode.getName().getString();
-
         // Create node
         cube_system_tree_node* csnode;
         csnode = cube_def_system_tree_node(data.cb,
-                                           name.c_str(),
+                                           tables.mSystemNodeNames[index].c_str(),
                                            "",
                                            snode.getClassName().getCString(),
                                            cparent);
@@ -219,16 +492,17 @@ ReportWriterTask::gen_sysinfo(ReportData& data) const
 
     // Create location groups
     count = defs.numLocationGroups();
+    lgroups.reserve(count);
+
+    uint32_t locIndex = 0;
     for (uint32_t index = 0; index < count; ++index) {
         const LocationGroup& lgroup = defs.getLocationGroup(index);
 
         // Convert location group type
         cube_location_group_type ctype;
-        ostringstream            lgname;
         switch (lgroup.getType()) {
             case LocationGroup::TYPE_PROCESS:
                 ctype = CUBE_LOCATION_GROUP_TYPE_PROCESS;
-                lgname << "MPI rank " << lgroup.getId();
                 break;
 
             default:
@@ -238,9 +512,7 @@ ReportWriterTask::gen_sysinfo(ReportData& data) const
         // Create location group
         cube_location_group* clgroup;
         clgroup = cube_def_location_group(data.cb,
-                                          (lgroup.getName().getString().empty()
-                                           ? lgname.str().c_str()
-                                           : lgroup.getName().getCString()),
+                                          tables.mLocationGroupNames[index].c_str(),
                                           lgroup.getId(),
                                           ctype,
                                           snodes[lgroup.getParent()->getId()]);
@@ -248,26 +520,22 @@ ReportWriterTask::gen_sysinfo(ReportData& data) const
 
         // Create locations
         uint32_t numLocs = lgroup.numLocations();
-        for (uint32_t locIdx = 0; locIdx < numLocs; ++locIdx) {
+        for (uint32_t locIdx = 0; locIdx < numLocs; ++locIdx, ++locIndex) {
             const Location& location = lgroup.getLocation(locIdx);
 
             // Convert location type
             cube_location_type ctype;
-            ostringstream      lname;
             switch (location.getType()) {
                 case Location::TYPE_CPU_THREAD:
                     ctype = CUBE_LOCATION_TYPE_CPU_THREAD;
-                    lname << "CPU thread " << location.getThreadId();
                     break;
 
                 case Location::TYPE_GPU:
                     ctype = CUBE_LOCATION_TYPE_GPU;
-                    lname << "GPU " << location.getThreadId();
                     break;
 
                 case Location::TYPE_METRIC:
                     ctype = CUBE_LOCATION_TYPE_METRIC;
-                    lname << "metric location " << location.getThreadId();
                     break;
 
                 default:
@@ -277,9 +545,7 @@ ReportWriterTask::gen_sysinfo(ReportData& data) const
             // Create location
             cube_location* clocation;
             clocation = cube_def_location(data.cb,
-                                          (location.getName().getString().empty()
-                                           ? lname.str().c_str()
-                                           : location.getName().getCString()),
+                                          tables.mLocationNames[locIndex].c_str(),
                                           location.getThreadId(),
                                           ctype,
                                           lgroups[location.getParent()->getId()]);
@@ -295,26 +561,29 @@ ReportWriterTask::gen_sysinfo(ReportData& data) const
  *
  *  This method defines the CUBE source-code regions in the CUBE object passed
  *  via @a data based on the information available in the global definitions
- *  object.
+ *  object and the attributes prepared in @a tables.
  *
- *  @param  data  Report data structure
+ *  @param  data    Report data structure
+ *  @param  tables  Definition tables
  *
  *  @todo Add support for canonical names.
  **/
 void
-ReportWriterTask::gen_regions(ReportData& data) const
+ReportWriterTask::gen_regions(ReportData&             data,
+                              const DefinitionTables& tables) const
 {
     const GlobalDefs& defs = *mSharedData.mDefinitions;
 
     // Create regions
     uint32_t count = defs.numRegions();
+    data.regions.reserve(count);
     for (ident_t id = 0; id < count; ++id) {
         const Region& region  = defs.getRegion(id);
         cube_region*  cregion = cube_def_region(data.cb,
                                                 region.getDisplayName().getCString(),
                                                 region.getCanonicalName().getCString(),
-                                                pearl::toString(region.getParadigm()).c_str(),
-                                                pearl::toString(region.getRole()).c_str(),
+                                                tables.mRegionParadigms[id].c_str(),
+                                                tables.mRegionRoles[id].c_str(),
                                                 region.getStartLine(),
                                                 region.getEndLine(),
                                                 "",
@@ -329,30 +598,30 @@ ReportWriterTask::gen_regions(ReportData& data) const
  *  @brief Generates the call tree information.
  *
  *  This method defines the CUBE call tree in the CUBE object passed via @a
- *  data based on the information available in the global definitions object.
+ *  data based on the information available in the global definitions object
+ *  and the dummy call path flags prepared in @a tables.
  *
- *  @param  data  Report data structure
+ *  @param  data    Report data structure
+ *  @param  tables  Definition tables
  **/
 void
-ReportWriterTask::gen_cnodes(ReportData& data) const
+ReportWriterTask::gen_cnodes(ReportData&             data,
+                             const DefinitionTables& tables) const
 {
     const GlobalDefs& defs = *mSharedData.mDefinitions;
 
     // Create call-tree nodes
     uint32_t count = defs.numCallpaths();
+    data.cnodes.reserve(count);
     for (ident_t id = 0; id < count; ++id) {
-        Callpath* callpath = defs.get_cnode(id);
-
-        // Special case: "UNKNOWN" callpath found in EPIK traces
-        const Region& region = callpath->getRegion();
-        if (("UNKNOWN" == region.getDisplayName().getString())
-            && ("EPIK" == region.getFilename().getString())
-            && ("EPIK" == region.getDescription().getString())) {
-            // Create dummy entry
+        // Create dummy entry for "UNKNOWN" callpaths found in EPIK traces
+        if (tables.mDummyCallpaths[id]) {
             data.cnodes.push_back(NULL);
             continue;
         }
 
+        Callpath* callpath = defs.get_cnode(id);
+
         // Determine parent
         Callpath*   parent  = callpath->getParent();
         cube_cnode* cparent = NULL;
@@ -365,7 +634,7 @@ ReportWriterTask::gen_cnodes(ReportData& data) const
         const Callsite& csite = callpath->getCallsite();
         if (Callsite::UNDEFINED == csite) {
             ccallpath = cube_def_cnode(data.cb,
-                                       data.regions[region.getId()],
+                                       data.regions[callpath->getRegion().getId()],
                                        cparent);
         } else {
             ccallpath = cube_def_cnode_cs(data.cb,
@@ -383,67 +652,35 @@ ReportWriterTask::gen_cnodes(ReportData& data) const
  *  @brief Generates the topology information.
  *
  *  This method defines the CUBE cartesian topology in the CUBE object passed
- *  via @a data based on the information available in the global definitions
- *  object.
+ *  via @a data based on the topology information prepared in @a tables.
  *
- *  @param  data  Report data structure
+ *  @param  data    Report data structure
+ *  @param  tables  Definition tables
  **/
 void
-ReportWriterTask::gen_cartesians(ReportData& data) const
+ReportWriterTask::gen_cartesians(ReportData&             data,
+                                 const DefinitionTables& tables) const
 {
-    const GlobalDefs& defs = *mSharedData.mDefinitions;
-
     // Create topologies
-    uint32_t ncarts = defs.num_cartesians();
-    for (ident_t cid = 0; cid < ncarts; ++cid) {
-        Cartesian* cart  = defs.get_cartesian(cid);
-        uint32_t   ndims = cart->num_dimensions();
-
-        // Query topology information
-        vector<uint32_t> dimv;
-        vector<bool>     periodv;
-        cart->get_dimensionv(dimv);
-        cart->get_periodv(periodv);
-
-        // Transform topology information to CUBE-conforming format
-        long* dim    = new long[ndims];
-        int*  period = new int[ndims];
-        for (uint32_t index = 0; index < ndims; ++index) {
-            dim[index]    = dimv[index];
-            period[index] = periodv[index];
-        }
+    vector<DefinitionTables::Cartesian>::const_iterator it = tables.mCartesians.begin();
+    while (it != tables.mCartesians.end()) {
+        const long ndims = it->mDims.size();
 
         // Create cartesian
-        cube_cartesian* ccart = cube_def_cart(data.cb, ndims, dim, period);
-
-        // Release memory
-        delete[] dim;
-        delete[] period;
+        cube_cartesian* ccart = cube_def_cart(data.cb,
+                                              ndims,
+                                              const_cast<long*>(&it->mDims[0]),
+                                              const_cast<int*>(&it->mPeriods[0]));
 
         // Define the coordinates
-        long*    coord = new long[ndims];
-        uint32_t nlocs = defs.numLocations();
-        for (uint32_t index = 0; index < nlocs; ++index) {
-            const Location& location = defs.getLocationByIndex(index);
-
-            try {
-                // Query coordinate information
-                vector<uint32_t> coordv;
-                cart->get_coords(location, coordv);
-
-                // Transform coordinate to CUBE-conforming format
-                for (uint32_t index = 0; index < ndims; ++index) {
-                    coord[index] = coordv[index];
-                }
-
-                // Define coordinate
-                cube_def_coords(data.cb, ccart, data.locs[location.getId()], coord);
-            }
-            catch (const Error&) {
-            }
+        const size_t count = it->mLocations.size();
+        for (size_t index = 0; index < count; ++index) {
+            cube_def_coords(data.cb,
+                            ccart,
+                            data.locs[it->mLocations[index]],
+                            const_cast<long*>(&it->mCoords[index * ndims]));
         }
 
-        // Release memory
-        delete[] coord;
+        ++it;
     }
 }
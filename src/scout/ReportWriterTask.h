@@ -52,7 +52,9 @@ struct TaskDataShared;
  *  This class provides a pearl::Task object which is used to write the final
  *  trace analysis report to disk. This includes the generation of the common
  *  CUBE file header as well as the collation and writing of the distributed
- *  severity data.
+ *  severity data. The data required to define the CUBE metadata is prepared
+ *  in bulk from the global definitions, with independent parts (system tree,
+ *  regions, call tree, and topologies) being processed by separate threads.
  **/
 /*-------------------------------------------------------------------------*/
 
@@ -77,13 +79,29 @@ class ReportWriterTask : public pearl::Task
 
 
   private:
+    struct DefinitionTables;
+
+
+    /// @name Report data preparation
+    /// @{
+
+    void prepare_sysinfo(DefinitionTables& tables) const;
+    void prepare_regions(DefinitionTables& tables) const;
+    void prepare_cnodes(DefinitionTables& tables) const;
+    void prepare_cartesians(DefinitionTables& tables) const;
+
+    /// @}
     /// @name Report data generation
     /// @{
 
-    void gen_sysinfo(ReportData& data) const;
-    void gen_regions(ReportData& data) const;
-    void gen_cnodes(ReportData& data) const;
-    void gen_cartesians(ReportData& data) const;
+    void gen_sysinfo(ReportData&             data,
+                     const DefinitionTables& tables) const;
+    void gen_regions(ReportData&             data,
+                     const DefinitionTables& tables) const;
+    void gen_cnodes(ReportData&             data,
+                    const DefinitionTables& tables) const;
+    void gen_cartesians(ReportData&             data,
+                        const DefinitionTables& tables) const;
 
     /// @}
 
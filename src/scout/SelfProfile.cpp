@@ -0,0 +1,480 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#define __STDC_FORMAT_MACROS
+
+#include <config.h>
+#include "SelfProfile.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <inttypes.h>
+#include <sstream>
+
+#if defined(_MPI)
+  #include <mpi.h>
+#endif   // _MPI
+
+#include <pearl/CallbackManager.h>
+#include <pearl/Event.h>
+#include <pearl/LocalTrace.h>
+#include <pearl/Location.h>
+
+#include <elg_error.h>
+
+#include "TaskData.h"
+
+using namespace std;
+using namespace pearl;
+using namespace scout;
+
+
+//--- Utility functions -----------------------------------------------------
+
+namespace
+{
+
+/// Section names in report order
+const char* const sections[] = {
+  "phases",
+  "callbacks",
+  "messages_sent",
+  "messages_received",
+  "blocking",
+  0
+};
+
+
+/// Summary of a record across locations
+struct Summary
+{
+  /// Record section
+  string mSection;
+
+  /// Record name
+  string mName;
+
+  /// Number of contributing locations
+  uint32_t mLocations;
+
+  /// Total count
+  uint64_t mCount;
+
+  /// Total, minimum, and maximum value
+  double mTotal;
+  double mMin;
+  double mMax;
+
+  /// Location with maximum value
+  uint64_t mMaxLocation;
+};
+
+
+/// Removes leading and trailing whitespace from the given string.
+string trim(const string& str)
+{
+  const string::size_type first = str.find_first_not_of(" \t\n");
+  if (first == string::npos)
+    return string();
+
+  const string::size_type last = str.find_last_not_of(" \t\n");
+
+  return str.substr(first, last - first + 1);
+}
+
+
+/// Returns the given string as a quoted JSON string literal.
+string quote(const string& str)
+{
+  string result("\"");
+  for (string::size_type i = 0; i < str.length(); ++i) {
+    const char c = str[i];
+    if (c == '"' || c == '\\')
+      result += '\\';
+    result += c;
+  }
+  result += '"';
+
+  return result;
+}
+
+
+/// Summarizes the serialized self profiles given in @a data across
+/// locations, preserving the order in which the records are encountered.
+void summarize(const string& data, vector<Summary>& summaries)
+{
+  map<pair<string, string>, size_t> index;
+
+  istringstream input(data);
+  string        line;
+  while (getline(input, line)) {
+    istringstream fields(line);
+    string        location, section, name, count, value;
+    if (!getline(fields, location, '\t') ||
+        !getline(fields, section, '\t') ||
+        !getline(fields, name, '\t') ||
+        !getline(fields, count, '\t') ||
+        !getline(fields, value))
+      continue;
+
+    const uint64_t locId = strtoull(location.c_str(), NULL, 10);
+    const uint64_t num   = strtoull(count.c_str(), NULL, 10);
+    const double   val   = strtod(value.c_str(), NULL);
+
+    const pair<string, string> key(section, name);
+    map<pair<string, string>, size_t>::iterator it = index.find(key);
+    if (it == index.end()) {
+      Summary entry;
+      entry.mSection     = section;
+      entry.mName        = name;
+      entry.mLocations   = 1;
+      entry.mCount       = num;
+      entry.mTotal       = val;
+      entry.mMin         = val;
+      entry.mMax         = val;
+      entry.mMaxLocation = locId;
+
+      index.insert(make_pair(key, summaries.size()));
+      summaries.push_back(entry);
+    } else {
+      Summary& entry = summaries[it->second];
+      entry.mLocations += 1;
+      entry.mCount     += num;
+      entry.mTotal     += val;
+      if (val < entry.mMin)
+        entry.mMin = val;
+      if (val > entry.mMax) {
+        entry.mMax         = val;
+        entry.mMaxLocation = locId;
+      }
+    }
+  }
+}
+
+
+/// Writes the summarized self profiles given in @a data to the file
+/// @a filename in JSON format.
+void writeReport(const string& data, const string& filename)
+{
+  vector<Summary> summaries;
+  summarize(data, summaries);
+
+  // Determine number of locations
+  uint32_t numLocations = 0;
+  for (vector<Summary>::const_iterator it = summaries.begin(); it != summaries.end(); ++it)
+    if (it->mLocations > numLocations)
+      numLocations = it->mLocations;
+
+  FILE* fp = fopen(filename.c_str(), "w");
+  if (!fp) {
+    elg_warning("SCOUT: Cannot write self-profiling report \"%s\".",
+                filename.c_str());
+
+    return;
+  }
+
+  fprintf(fp, "{\n  \"locations\": %" PRIu32, numLocations);
+  for (const char* const* section = sections; *section; ++section) {
+    fprintf(fp, ",\n  \"%s\": [", *section);
+
+    const char* separator = "";
+    for (vector<Summary>::const_iterator it = summaries.begin(); it != summaries.end(); ++it) {
+      if (it->mSection != *section)
+        continue;
+
+      fprintf(fp, "%s\n    { \"name\": %s, \"locations\": %" PRIu32
+                  ", \"count\": %" PRIu64 ", \"total\": %.9g"
+                  ", \"min\": %.9g, \"avg\": %.9g, \"max\": %.9g"
+                  ", \"max_location\": %" PRIu64 " }",
+              separator, quote(it->mName).c_str(), it->mLocations,
+              it->mCount, it->mTotal, it->mMin,
+              it->mTotal / it->mLocations, it->mMax, it->mMaxLocation);
+      separator = ",";
+    }
+    fprintf(fp, "%s]", (*separator ? "\n  " : ""));
+  }
+  fprintf(fp, "\n}\n");
+
+  if (fclose(fp) != 0)
+    elg_warning("SCOUT: Cannot write self-profiling report \"%s\".",
+                filename.c_str());
+}
+
+}   // unnamed namespace
+
+
+//---------------------------------------------------------------------------
+//
+//  class SelfProfile
+//
+//---------------------------------------------------------------------------
+
+//--- Recording performance data --------------------------------------------
+
+/**
+ *  @brief Sets the current replay pass.
+ *
+ *  Sets the name of the replay pass to which subsequently recorded message
+ *  and blocking time data is attributed.
+ *
+ *  @param  pass  Replay pass name
+ **/
+void SelfProfile::setPass(const string& pass)
+{
+  mPass = trim(pass);
+}
+
+
+/**
+ *  @brief Records the duration of an analysis phase.
+ *
+ *  @param  name      Phase name
+ *  @param  duration  Wall-clock duration in seconds
+ **/
+void SelfProfile::addPhase(const string& name,
+                           double        duration)
+{
+  addRecord("phases", trim(name), 1, duration);
+}
+
+
+/**
+ *  @brief Records the callback profiles of the current replay pass.
+ *
+ *  Adds the profiling data of all callbacks registered with the given
+ *  callback manager which have been invoked at least once. The callbacks
+ *  are identified by the current pass, their label, and their event type.
+ *
+ *  @param  cbmanager  Callback manager with profiling enabled
+ **/
+void SelfProfile::addCallbacks(const CallbackManager& cbmanager)
+{
+  const CallbackManager::profile_container& profile = cbmanager.get_profile();
+
+  CallbackManager::profile_container::const_iterator it = profile.begin();
+  while (it != profile.end()) {
+    if (it->m_count > 0) {
+      ostringstream name;
+      name << mPass << " / " << it->m_label << " / ";
+      if (it->m_user_event)
+        name << "user event " << it->m_event;
+      else
+        name << event_typestr(event_t(it->m_event));
+
+      addRecord("callbacks", name.str(), it->m_count, it->m_time);
+    }
+    ++it;
+  }
+}
+
+
+/**
+ *  @brief Records a message sent in the current replay pass.
+ *
+ *  @param  bytes  Message size in bytes
+ **/
+void SelfProfile::addSentMessage(size_t bytes)
+{
+  addRecord("messages_sent", mPass, 1, bytes);
+}
+
+
+/**
+ *  @brief Records a message received in the current replay pass.
+ **/
+void SelfProfile::addReceivedMessage()
+{
+  addRecord("messages_received", mPass, 1, 0.0);
+}
+
+
+/**
+ *  @brief Records a blocking communication operation of the current pass.
+ *
+ *  @param  duration  Wall-clock time spent blocking in seconds
+ **/
+void SelfProfile::addBlockingTime(double duration)
+{
+  addRecord("blocking", mPass, 1, duration);
+}
+
+
+//--- Serialization ---------------------------------------------------------
+
+/**
+ *  @brief Serializes the performance data.
+ *
+ *  Returns the performance data records as text, using one line per record
+ *  with tab-separated fields (location, section, name, count, value).
+ *
+ *  @param  location  Global location identifier
+ *
+ *  @return Serialized records
+ **/
+string SelfProfile::serialize(uint64_t location) const
+{
+  ostringstream result;
+  result.precision(17);
+
+  for (RecordList::const_iterator it = mRecords.begin(); it != mRecords.end(); ++it)
+    result << location          << '\t'
+           << it->mKey.first    << '\t'
+           << it->mKey.second   << '\t'
+           << it->mCount        << '\t'
+           << it->mValue        << '\n';
+
+  return result.str();
+}
+
+
+//--- Internal methods ------------------------------------------------------
+
+void SelfProfile::addRecord(const string& section,
+                            const string& name,
+                            uint64_t      count,
+                            double        value)
+{
+  const RecordKey key(section, name);
+
+  RecordIndex::iterator it = mIndex.find(key);
+  if (it == mIndex.end()) {
+    Record record;
+    record.mKey   = key;
+    record.mCount = 0;
+    record.mValue = 0.0;
+
+    it = mIndex.insert(make_pair(key, mRecords.size())).first;
+    mRecords.push_back(record);
+  }
+
+  Record& record = mRecords[it->second];
+  record.mCount += count;
+  record.mValue += value;
+}
+
+
+//---------------------------------------------------------------------------
+//
+//  class BlockingTimer
+//
+//---------------------------------------------------------------------------
+
+//--- Constructors & destructor ---------------------------------------------
+
+/**
+ *  @brief Starts measuring blocking time.
+ *
+ *  @param  profile  Self profile to be updated (or NULL)
+ **/
+BlockingTimer::BlockingTimer(SelfProfile* profile)
+  : mProfile(profile)
+{
+  if (mProfile)
+    mTimer.start();
+}
+
+
+/**
+ *  @brief Stops measuring and records the blocking time.
+ **/
+BlockingTimer::~BlockingTimer()
+{
+  if (mProfile) {
+    mTimer.stop();
+    mProfile->addBlockingTime(mTimer.value());
+  }
+}
+
+
+//---------------------------------------------------------------------------
+//
+//  class SelfProfileTask
+//
+//---------------------------------------------------------------------------
+
+//--- Constructors & destructor ---------------------------------------------
+
+/**
+ *  @brief Constructor.
+ *
+ *  Creates a new self-profiling report task.
+ *
+ *  @param  privateData  Private task data object
+ *  @param  filename     Name of the report file
+ **/
+SelfProfileTask::SelfProfileTask(const TaskDataPrivate& privateData,
+                                 const string&          filename)
+  : Task(),
+    mPrivateData(privateData),
+    mFilename(filename)
+{
+}
+
+
+//--- Execution control -----------------------------------------------------
+
+/**
+ *  @brief Writes the self-profiling report.
+ *
+ *  Collects the serialized self profiles of all threads on the master
+ *  thread, gathers them on rank 0 using a single collective operation, and
+ *  writes the summary report. Errors are reported as warnings only.
+ *
+ *  @return Always @em true
+ **/
+bool SelfProfileTask::execute()
+{
+  static string data;
+
+  const Location& location = mPrivateData.mTrace->get_location();
+  const string    local    = mPrivateData.mSelfProfile->serialize(location.getId());
+
+  #pragma omp critical
+  {
+    data += local;
+  }
+
+  #pragma omp barrier
+  #pragma omp master
+  {
+    int rank = 0;
+
+    #if defined(_MPI)
+      int size;
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+      int         length = data.length();
+      vector<int> lengths(size);
+      MPI_Gather(&length, 1, MPI_INT, &lengths[0], 1, MPI_INT,
+                 0, MPI_COMM_WORLD);
+
+      vector<int> displs(size, 0);
+      for (int i = 1; i < size; ++i)
+        displs[i] = displs[i - 1] + lengths[i - 1];
+
+      vector<char> buffer(displs[size - 1] + lengths[size - 1] + 1);
+      MPI_Gatherv(const_cast<char*>(data.data()), length, MPI_CHAR,
+                  &buffer[0], &lengths[0], &displs[0], MPI_CHAR,
+                  0, MPI_COMM_WORLD);
+      if (rank == 0)
+        data.assign(&buffer[0], buffer.size() - 1);
+    #endif   // _MPI
+
+    if (rank == 0)
+      writeReport(data, mFilename);
+    data.clear();
+  }
+  #pragma omp barrier
+
+  return true;
+}
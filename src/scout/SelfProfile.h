@@ -0,0 +1,232 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#ifndef SCOUT_SELFPROFILE_H
+#define SCOUT_SELFPROFILE_H
+
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pearl/Task.h>
+#include <pearl/pearl_types.h>
+
+#include "Timer.h"
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file  SelfProfile.h
+ *  @brief Declaration of the SelfProfile, BlockingTimer, and
+ *         SelfProfileTask classes.
+ *
+ *  This header file provides the declaration of the classes used to profile
+ *  the SCOUT trace analyzer itself, i.e., to determine where the analysis
+ *  time is spent.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+//--- Forward declarations --------------------------------------------------
+
+namespace pearl
+{
+
+class CallbackManager;
+
+}   // namespace pearl
+
+
+namespace scout
+{
+
+//--- Forward declarations --------------------------------------------------
+
+struct TaskDataPrivate;
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class SelfProfile
+ *  @brief Performance data of the analysis of a single location.
+ *
+ *  The SelfProfile class collects performance data about the analysis of
+ *  a single location: the durations of the individual analysis phases, the
+ *  number of invocations and the (inclusive) time of the replay callbacks,
+ *  as well as the number and volume of messages sent and received during
+ *  the individual replay passes and the time spent in blocking MPI calls.
+ *  Each data item is stored as a record consisting of a count and a value,
+ *  and identified by a section and a name. Records are kept in the order
+ *  they were first encountered.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class SelfProfile
+{
+  public:
+    /// @name Recording performance data
+    /// @{
+
+    void setPass(const std::string& pass);
+    void addPhase(const std::string& name,
+                  double             duration);
+    void addCallbacks(const pearl::CallbackManager& cbmanager);
+    void addSentMessage(std::size_t bytes);
+    void addReceivedMessage();
+    void addBlockingTime(double duration);
+
+    /// @}
+    /// @name Serialization
+    /// @{
+
+    std::string serialize(uint64_t location) const;
+
+    /// @}
+
+
+  private:
+    /// Record key type (section, name)
+    typedef std::pair<std::string, std::string> RecordKey;
+
+    /// Performance data record
+    struct Record
+    {
+      /// Record key
+      RecordKey mKey;
+
+      /// Number of occurrences
+      uint64_t mCount;
+
+      /// Accumulated value (e.g., time in seconds)
+      double mValue;
+    };
+
+    /// Container type for records
+    typedef std::vector<Record> RecordList;
+
+    /// Container type for record key |-@> index mapping
+    typedef std::map<RecordKey, std::size_t> RecordIndex;
+
+
+    /// Performance data records
+    RecordList mRecords;
+
+    /// Index of the records
+    RecordIndex mIndex;
+
+    /// Name of the current replay pass
+    std::string mPass;
+
+
+    /// @name Internal methods
+    /// @{
+
+    void addRecord(const std::string& section,
+                   const std::string& name,
+                   uint64_t           count,
+                   double             value);
+
+    /// @}
+};
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class BlockingTimer
+ *  @brief Scoped timer accounting blocking communication time.
+ *
+ *  A BlockingTimer measures the time from its construction to its
+ *  destruction and adds it as blocking time to the given self profile.
+ *  If no profile is given (i.e., self-profiling is disabled), it does
+ *  nothing.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class BlockingTimer
+{
+  public:
+    /// @name Constructors & destructor
+    /// @{
+
+    explicit BlockingTimer(SelfProfile* profile);
+
+    ~BlockingTimer();
+
+    /// @}
+
+
+  private:
+    /// Self profile to be updated (or NULL)
+    SelfProfile* mProfile;
+
+    /// %Timer object used to determine the blocking time
+    Timer mTimer;
+
+
+    /// @name Copying (not allowed)
+    /// @{
+
+    BlockingTimer(const BlockingTimer& rhs);
+    BlockingTimer& operator=(const BlockingTimer& rhs);
+
+    /// @}
+};
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class SelfProfileTask
+ *  @brief Task writing the self-profiling report.
+ *
+ *  The SelfProfileTask class collects the self profiles of all locations
+ *  on the first process and writes a summary report in JSON format. For
+ *  each record, it provides the number of contributing locations, the
+ *  total count, as well as the minimum, average, and maximum value across
+ *  locations together with the location showing the maximum (i.e., the
+ *  straggler).
+ **/
+/*-------------------------------------------------------------------------*/
+
+class SelfProfileTask : public pearl::Task
+{
+  public:
+    /// @name Constructors & destructor
+    /// @{
+
+    SelfProfileTask(const TaskDataPrivate& privateData,
+                    const std::string&     filename);
+
+    /// @}
+    /// @name Execution control
+    /// @{
+
+    virtual bool execute();
+
+    /// @}
+
+
+  private:
+    /// Private task data object
+    const TaskDataPrivate& mPrivateData;
+
+    /// Name of the report file
+    std::string mFilename;
+};
+
+
+}   // namespace scout
+
+
+#endif   // !SCOUT_SELFPROFILE_H
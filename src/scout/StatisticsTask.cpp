@@ -25,6 +25,7 @@
 
 #include <epk_memory.h>
 
+#include <pearl/Buffer.h>
 #include <pearl/Callback.h>
 #include <pearl/CallbackManager.h>
 #include <pearl/LocalTrace.h>
@@ -90,6 +91,38 @@ void StatisticsTask::registerAnalysisCallbacks(const CallbackManagerMap& cbmgrs)
 }
 
 
+//--- Checkpointing ---------------------------------------------------------
+
+/**
+ *  @brief Stores the event counters in a buffer.
+ *
+ *  Packs the clock-condition violation counters collected during the trace
+ *  analysis phase into the given @a buffer.
+ *
+ *  @param  buffer  Buffer to store the counters in
+ **/
+void StatisticsTask::packState(Buffer& buffer) const
+{
+  buffer.put_uint64(mCCV_p2p);
+  buffer.put_uint64(mCCV_coll);
+}
+
+
+/**
+ *  @brief Restores the event counters from a buffer.
+ *
+ *  Unpacks the clock-condition violation counters previously stored by
+ *  packState() from the given @a buffer.
+ *
+ *  @param  buffer  Buffer to retrieve the counters from
+ **/
+void StatisticsTask::unpackState(Buffer& buffer)
+{
+  mCCV_p2p  = buffer.get_uint64();
+  mCCV_coll = buffer.get_uint64();
+}
+
+
 //--- Executing the task ----------------------------------------------------
 
 /**
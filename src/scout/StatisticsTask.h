@@ -40,6 +40,7 @@
 namespace pearl
 {
 
+class Buffer;
 class CallbackData;
 class CallbackManager;
 class Event;
@@ -86,6 +87,13 @@ class StatisticsTask : public pearl::Task
 
     void registerAnalysisCallbacks(const CallbackManagerMap& cbmgrs);
 
+    /// @}
+    /// @name Checkpointing
+    /// @{
+
+    void packState(pearl::Buffer& buffer) const;
+    void unpackState(pearl::Buffer& buffer);
+
     /// @}
     /// @name  Executing the task
     /// @{
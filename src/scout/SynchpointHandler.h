@@ -56,6 +56,9 @@ public:
 
   ~SynchpointHandler();
 
+  const char* get_name() const
+    { return "SynchpointHandler"; }
+
   bool              isSynchpoint         (const pearl::Event& e   ) const;
   bool              isWaitstate          (const pearl::Event& e   ) const;
 
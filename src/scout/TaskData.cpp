@@ -22,6 +22,8 @@
 #include <pearl/LocalTrace.h>
 #include <pearl/TraceArchive.h>
 
+#include "SelfProfile.h"
+
 using namespace std;
 using namespace pearl;
 using namespace scout;
@@ -60,7 +62,8 @@ TaskDataShared::~TaskDataShared()
 TaskDataPrivate::TaskDataPrivate()
     : mIdMaps(NULL),
       mTrace(NULL),
-      mSynchronizer(NULL)
+      mSynchronizer(NULL),
+      mSelfProfile(NULL)
 {
 }
 
@@ -68,4 +71,5 @@ TaskDataPrivate::TaskDataPrivate()
 TaskDataPrivate::~TaskDataPrivate()
 {
     delete mTrace;
+    delete mSelfProfile;
 }
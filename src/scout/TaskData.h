@@ -48,6 +48,11 @@ class TraceArchive;
 namespace scout
 {
 
+//--- Forward declarations --------------------------------------------------
+
+class SelfProfile;
+
+
 /*-------------------------------------------------------------------------*/
 /**
  *  @struct TaskDataShared
@@ -141,6 +146,9 @@ struct TaskDataPrivate
 
     /// Timestamp synchronization object
     Synchronizer* mSynchronizer;
+
+    /// Self-profiling data (NULL if disabled)
+    SelfProfile* mSelfProfile;
 };
 
 }   // namespace scout
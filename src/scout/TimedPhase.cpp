@@ -19,9 +19,11 @@
 #include <config.h>
 #include "TimedPhase.h"
 
+#include <cstddef>
 #include <inttypes.h>
 
 #include "Logging.h"
+#include "SelfProfile.h"
 
 using namespace std;
 using namespace pearl;
@@ -53,7 +55,8 @@ TimedPhase::TimedPhase(const string& message,
   : CompoundTask(),
     m_message(message),
     m_logLevel(logLevel),
-    m_showSteps(showSteps)
+    m_showSteps(showSteps),
+    m_profile(NULL)
 {
 }
 
@@ -84,6 +87,22 @@ TimedPhase* TimedPhase::make_timed(pearl::Task* const task,
   return phase;
 }
 
+//--- Self-profiling --------------------------------------------------------
+
+/**
+ *  @brief Enables recording the phase duration.
+ *
+ *  Sets the self profile in which the wall-clock duration of the phase is
+ *  recorded on completion, using the log message as phase name.
+ *
+ *  @param  profile  Self profile (or NULL to disable recording)
+ **/
+void TimedPhase::set_profile(SelfProfile* profile)
+{
+  m_profile = profile;
+}
+
+
 //--- Execution control (protected) -----------------------------------------
 
 /**
@@ -126,6 +145,8 @@ bool TimedPhase::finish()
 {
   m_timer.stop();
   LogMsg(m_logLevel, "done (%.3fs).\n", m_timer.value());
+  if (m_profile)
+    m_profile->addPhase(m_message, m_timer.value());
 
   return true;
 }
@@ -38,6 +38,11 @@
 namespace scout
 {
 
+//--- Forward declarations --------------------------------------------------
+
+class SelfProfile;
+
+
 /*-------------------------------------------------------------------------*/
 /**
  *  @class TimedPhase
@@ -48,6 +53,7 @@ namespace scout
  *  consists of a user-defined string and three dots. After all component
  *  tasks have finished successfully, the message "done (?.???s)." is printed,
  *  where the question marks represent the wall-clock duration of the phase.
+ *  Optionally, the duration is also recorded in a self profile.
  **/
 /*-------------------------------------------------------------------------*/
 
@@ -71,6 +77,12 @@ class TimedPhase : public pearl::CompoundTask
                                   bool               showSteps=false);
 
     /// @}
+    /// @name Self-profiling
+    /// @{
+
+    void set_profile(SelfProfile* profile);
+
+    /// @}
 
 
   protected:
@@ -95,6 +107,9 @@ class TimedPhase : public pearl::CompoundTask
 
     /// Flag indicating whether step numbers should be added to message
     bool m_showSteps;
+
+    /// Self profile recording the phase duration (or NULL)
+    SelfProfile* m_profile;
 };
 
 
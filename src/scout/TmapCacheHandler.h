@@ -58,6 +58,9 @@ public:
 
   ~TmapCacheHandler();
 
+  const char* get_name() const
+    { return "TmapCacheHandler"; }
+
   timemap_t getRuntimes(const pearl::Event& from, const pearl::Event& to) const;
 
   void register_pre_pattern_callbacks (const CallbackManagerMap& cbm);
@@ -0,0 +1,168 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#ifndef SCOUT_TOPMOSTSEVEREHEAP_H
+#define SCOUT_TOPMOSTSEVEREHEAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "scout_types.h"
+
+namespace scout
+{
+/**
+ * @class TopMostSevereHeap
+ * @brief Bounded collection of the most severe instances of a pattern.
+ *
+ * The TopMostSevereHeap class keeps track of the (at most)
+ * TOP_SEVERE_INSTANCES instances with the largest idle times, where each
+ * call path is represented at most once by its most severe instance. The
+ * instances are stored in a flat array organized as a min-heap w.r.t. the
+ * idle time, i.e., the least severe instance is available in constant time
+ * and an insertion requires at most a logarithmic number of exchanges.
+ * Instances without idle time are never reported and thus ignored.
+ */
+class TopMostSevereHeap
+{
+    public:
+        /// Instance container type
+        typedef std::vector<TopMostSevere> InstanceList;
+
+
+        /// @name Query functions
+        /// @{
+
+        bool
+        empty() const
+        {
+            return mInstances.empty();
+        }
+
+        std::size_t
+        size() const
+        {
+            return mInstances.size();
+        }
+
+        /// Returns the stored instances in heap order.
+        const InstanceList&
+        getInstances() const
+        {
+            return mInstances;
+        }
+
+        /// Stores the instances in order of decreasing idle time in
+        /// @a result. Instances with equal idle times are ordered by call
+        /// path identifier.
+        void
+        getSorted(InstanceList& result) const
+        {
+            result = mInstances;
+            std::sort(result.begin(), result.end(), MoreSevere());
+        }
+
+        /// @}
+        /// @name Modification
+        /// @{
+
+        void
+        clear()
+        {
+            mInstances.clear();
+        }
+
+        /// Inserts the given @a instance if it is among the most severe ones.
+        void
+        insert(const TopMostSevere& instance)
+        {
+            if (instance.idletime <= 0.0) {
+                return;
+            }
+
+            // Call path already present => keep most severe instance only
+            for (InstanceList::iterator it = mInstances.begin();
+                 it != mInstances.end();
+                 ++it) {
+                if (it->cnode == instance.cnode) {
+                    if (instance.idletime > it->idletime) {
+                        *it = instance;
+                        std::make_heap(mInstances.begin(), mInstances.end(),
+                                       IdleTimeGreater());
+                    }
+
+                    return;
+                }
+            }
+
+            if (mInstances.size() < TOP_SEVERE_INSTANCES) {
+                mInstances.push_back(instance);
+                std::push_heap(mInstances.begin(), mInstances.end(),
+                               IdleTimeGreater());
+            } else if (instance.idletime > mInstances.front().idletime) {
+                std::pop_heap(mInstances.begin(), mInstances.end(),
+                              IdleTimeGreater());
+                mInstances.back() = instance;
+                std::push_heap(mInstances.begin(), mInstances.end(),
+                               IdleTimeGreater());
+            }
+        }
+
+        /// Inserts all instances stored in @a rhs.
+        void
+        merge(const TopMostSevereHeap& rhs)
+        {
+            for (InstanceList::const_iterator it = rhs.mInstances.begin();
+                 it != rhs.mInstances.end();
+                 ++it) {
+                insert(*it);
+            }
+        }
+
+        /// @}
+
+
+    private:
+        /// Comparison functor establishing the min-heap property
+        struct IdleTimeGreater
+        {
+            bool
+            operator()(const TopMostSevere& lhs,
+                       const TopMostSevere& rhs) const
+            {
+                return lhs.idletime > rhs.idletime;
+            }
+        };
+
+        /// Comparison functor defining the report order
+        struct MoreSevere
+        {
+            bool
+            operator()(const TopMostSevere& lhs,
+                       const TopMostSevere& rhs) const
+            {
+                if (lhs.idletime != rhs.idletime) {
+                    return lhs.idletime > rhs.idletime;
+                }
+
+                return lhs.cnode < rhs.cnode;
+            }
+        };
+
+
+        /// Most severe instances (min-heap w.r.t. idle time)
+        InstanceList mInstances;
+};
+} // namespace scout
+
+#endif
@@ -0,0 +1,347 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+#include "TraceCacheTask.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <sstream>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#if defined(_MPI)
+  #include <mpi.h>
+#endif   // _MPI
+#if defined(_OPENMP)
+  #include <omp.h>
+#endif   // _OPENMP
+
+#include <pearl/Error.h>
+#include <pearl/GlobalDefs.h>
+#include <pearl/LocalTrace.h>
+#include <pearl/Location.h>
+#include <pearl/LocationGroup.h>
+#include <pearl/TraceArchive.h>
+#include <pearl/pearl.h>
+
+#include <elg_error.h>
+#include <epk_archive.h>
+
+#include "TaskData.h"
+
+using namespace std;
+using namespace pearl;
+using namespace scout;
+
+
+//--- Local helper functions ------------------------------------------------
+
+namespace
+{
+
+/**
+ *  @brief Determines the location handled by the calling thread.
+ *
+ *  @param  defs  Global definitions object
+ *  @return Location of the calling thread
+ **/
+const Location& GetLocation(const GlobalDefs& defs)
+{
+  // Determine thread ID
+  int tid = 0;
+  #if defined(_OPENMP)
+    tid = omp_get_thread_num();
+  #endif   // _OPENMP
+
+  // Determine process rank
+  int rank = 0;
+  #if defined(_MPI)
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  #endif   // _MPI
+
+  return defs.getLocationGroup(rank).getLocation(tid);
+}
+
+
+/**
+ *  @brief Determines the name of the cache file for a given location.
+ *
+ *  @param  directory  Cache directory
+ *  @param  location   Location
+ *  @return Cache file name
+ **/
+string GetCacheFilename(const string& directory, const Location& location)
+{
+  ostringstream filename;
+  filename << directory << "/" << location.getId() << ".cache";
+
+  return filename.str();
+}
+
+
+/**
+ *  @brief Adds a value to a FNV-1a hash.
+ *
+ *  @param  hash   Hash value to be updated
+ *  @param  value  Value to be hashed
+ **/
+void HashValue(uint64_t& hash, uint64_t value)
+{
+  for (int byte = 0; byte < 8; ++byte) {
+    hash ^= (value >> (8 * byte)) & 0xff;
+    hash *= 1099511628211ULL;
+  }
+}
+
+
+/**
+ *  @brief Adds the modification time and size of a file to a hash.
+ *
+ *  @param  hash  Hash value to be updated
+ *  @param  info  File status information
+ **/
+void HashFileInfo(uint64_t& hash, const struct stat& info)
+{
+  HashValue(hash, static_cast<uint64_t>(info.st_mtime));
+  HashValue(hash, static_cast<uint64_t>(info.st_size));
+}
+
+
+/**
+ *  @brief Adds the modification time and size of a named file to a hash.
+ *
+ *  Missing files (e.g., locations without local definitions) only add a
+ *  marker value, so that creating the file later still changes the hash.
+ *
+ *  @param  hash      Hash value to be updated
+ *  @param  filename  Name of the file
+ **/
+void HashFile(uint64_t& hash, const string& filename)
+{
+  struct stat info;
+  if (stat(filename.c_str(), &info) != 0) {
+    HashValue(hash, 0);
+    return;
+  }
+  HashValue(hash, 1);
+  HashFileInfo(hash, info);
+}
+
+}   // unnamed namespace
+
+
+//---------------------------------------------------------------------------
+//
+//  class ReadCacheTask
+//
+//---------------------------------------------------------------------------
+
+//--- Constructors & destructor ---------------------------------------------
+
+/**
+ *  @brief Constructor. Creates a new ReadCacheTask instance.
+ *
+ *  This constructor creates a new task instance for loading the
+ *  preprocessed trace data from the given cache @a directory.
+ *
+ *  @param  sharedData   Shared task data object
+ *  @param  privateData  Private task data object
+ *  @param  directory    Cache directory
+ **/
+ReadCacheTask::ReadCacheTask(const TaskDataShared& sharedData,
+                             TaskDataPrivate&      privateData,
+                             const string&         directory)
+  : Task(),
+    mSharedData(sharedData),
+    mPrivateData(privateData),
+    mDirectory(directory)
+{
+}
+
+
+//--- Execution control -----------------------------------------------------
+
+/**
+ *  @brief Executes the task.
+ *
+ *  Loads the preprocessed trace data of the calling thread's location from
+ *  the memory-mapped cache file.
+ *
+ *  @return Returns true if successful, false otherwise.
+ *  @throw  pearl::FatalError  if the cache file is inconsistent
+ **/
+bool ReadCacheTask::execute()
+{
+  GlobalDefs&     defs     = *mSharedData.mDefinitions;
+  const Location& location = GetLocation(defs);
+
+  mPrivateData.mTrace =
+    PEARL_read_trace_cache(defs, location,
+                           GetCacheFilename(mDirectory, location));
+
+  return (NULL != mPrivateData.mTrace);
+}
+
+
+//---------------------------------------------------------------------------
+//
+//  class WriteCacheTask
+//
+//---------------------------------------------------------------------------
+
+//--- Constructors & destructor ---------------------------------------------
+
+/**
+ *  @brief Constructor. Creates a new WriteCacheTask instance.
+ *
+ *  This constructor creates a new task instance for storing the
+ *  preprocessed trace data in the given cache @a directory.
+ *
+ *  @param  sharedData   Shared task data object
+ *  @param  privateData  Private task data object
+ *  @param  directory    Cache directory
+ *  @param  stamp        Validation stamp
+ **/
+WriteCacheTask::WriteCacheTask(const TaskDataShared&  sharedData,
+                               const TaskDataPrivate& privateData,
+                               const string&          directory,
+                               uint64_t               stamp)
+  : Task(),
+    mSharedData(sharedData),
+    mPrivateData(privateData),
+    mDirectory(directory),
+    mStamp(stamp)
+{
+}
+
+
+//--- Execution control -----------------------------------------------------
+
+/**
+ *  @brief Executes the task.
+ *
+ *  Writes the preprocessed trace data of the calling thread's location to
+ *  the cache directory, which is created if necessary. As the cache is only
+ *  an optimization for subsequent runs, errors are reported as warnings.
+ *
+ *  @return Always returns true.
+ **/
+bool WriteCacheTask::execute()
+{
+  const GlobalDefs& defs  = *mSharedData.mDefinitions;
+  const LocalTrace& trace = *mPrivateData.mTrace;
+
+  if ((mkdir(mDirectory.c_str(), 0755) != 0) && (errno != EEXIST)) {
+    elg_warning("SCOUT: Cannot create trace cache directory \"%s\".",
+                mDirectory.c_str());
+    return true;
+  }
+
+  try {
+    PEARL_write_trace_cache(defs, trace,
+                            GetCacheFilename(mDirectory, trace.get_location()),
+                            mStamp);
+  }
+  catch (const Error& ex) {
+    elg_warning("SCOUT: %s", ex.what());
+  }
+
+  return true;
+}
+
+
+//--- Related functions -----------------------------------------------------
+
+/**
+ *  @brief Computes the validation stamp of the trace cache.
+ *
+ *  Computes a stamp identifying the trace data of the calling thread's
+ *  location and the analysis settings the cached trace data is valid for.
+ *  It combines the modification time and size of the archive anchor (or
+ *  the EPIK definitions file, if the anchor is a directory) and of the
+ *  location's event and local definition files with all options affecting
+ *  the preprocessed trace data. Thus, the cache is invalidated if any of
+ *  the files read for this location is rewritten.
+ *
+ *  @param  sharedData     Shared task data object
+ *  @param  timeCorrected  Whether timestamp correction is applied
+ *  @return Validation stamp (zero if the anchor cannot be examined)
+ **/
+uint64_t scout::GetTraceCacheStamp(const TaskDataShared& sharedData,
+                                   bool                  timeCorrected)
+{
+  const string    anchorName = sharedData.mArchive->getAnchorName();
+  const Location& location   = GetLocation(*sharedData.mDefinitions);
+
+  struct stat info;
+  if (stat(anchorName.c_str(), &info) != 0)
+    return 0;
+
+  uint64_t stamp = 14695981039346656037ULL;
+  if (S_ISDIR(info.st_mode)) {
+    // EPIK archive: definitions file & per-rank event trace file
+    const string filename = anchorName + "/epik.esd";
+    if (stat(filename.c_str(), &info) != 0)
+      return 0;
+    HashFileInfo(stamp, info);
+
+    char* tmp_str = epk_archive_rankname(EPK_TYPE_ELG, anchorName.c_str(),
+                                         location.getRank());
+    HashFile(stamp, tmp_str);
+    free(tmp_str);
+  } else {
+    // OTF2 archive: anchor file & per-location event/definition files
+    HashFileInfo(stamp, info);
+
+    string traceDir = anchorName;
+    const string::size_type suffix = traceDir.rfind(".otf2");
+    if (suffix != string::npos)
+      traceDir.erase(suffix);
+
+    ostringstream basename;
+    basename << traceDir << "/" << location.getId();
+    HashFile(stamp, basename.str() + ".evt");
+    HashFile(stamp, basename.str() + ".def");
+  }
+  HashValue(stamp, timeCorrected ? 1u : 0u);
+
+  return stamp;
+}
+
+
+/**
+ *  @brief Checks whether the cached trace data can be used.
+ *
+ *  Checks whether the cache @a directory holds a valid preprocessed trace
+ *  image of the calling thread's location which matches the given
+ *  validation @a stamp. As all locations have to agree on using the cache,
+ *  the result needs to be reduced globally (e.g., using CheckGlobalError()).
+ *
+ *  @param  sharedData  Shared task data object
+ *  @param  directory   Cache directory
+ *  @param  stamp       Validation stamp
+ *  @return Returns true if the cache can be used, false otherwise
+ **/
+bool scout::CheckTraceCache(const TaskDataShared& sharedData,
+                            const string&         directory,
+                            uint64_t              stamp)
+{
+  const Location& location = GetLocation(*sharedData.mDefinitions);
+
+  return ((stamp != 0)
+          && PEARL_check_trace_cache(location,
+                                     GetCacheFilename(directory, location),
+                                     stamp));
+}
@@ -0,0 +1,147 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#ifndef SCOUT_TRACECACHETASK_H
+#define SCOUT_TRACECACHETASK_H
+
+
+#include <string>
+
+#include <pearl/Task.h>
+#include <pearl/pearl_types.h>
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file  TraceCacheTask.h
+ *  @brief Declaration of the ReadCacheTask and WriteCacheTask classes.
+ *
+ *  This header file provides the declaration of the ReadCacheTask and
+ *  WriteCacheTask classes which are used to load and store the fully
+ *  preprocessed per-location trace data from/to a persistent cache, as
+ *  well as related helper functions.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+namespace scout
+{
+
+//--- Forward declarations --------------------------------------------------
+
+struct TaskDataPrivate;
+struct TaskDataShared;
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class ReadCacheTask
+ *  @brief Task loading the preprocessed trace data from the cache.
+ *
+ *  The ReadCacheTask class replaces the trace reading, preprocessing and
+ *  timestamp correction phases by loading the preprocessed trace data and
+ *  the unified call tree written by a previous analysis run.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class ReadCacheTask : public pearl::Task
+{
+  public:
+    /// @name Constructors & destructor
+    /// @{
+
+    ReadCacheTask(const TaskDataShared& sharedData,
+                  TaskDataPrivate&      privateData,
+                  const std::string&    directory);
+
+    /// @}
+    /// @name Execution control
+    /// @{
+
+    virtual bool execute();
+
+    /// @}
+
+
+  private:
+    /// Shared task data object
+    const TaskDataShared& mSharedData;
+
+    /// Private task data object
+    TaskDataPrivate& mPrivateData;
+
+    /// Cache directory
+    std::string mDirectory;
+};
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class WriteCacheTask
+ *  @brief Task storing the preprocessed trace data in the cache.
+ *
+ *  The WriteCacheTask class stores the preprocessed trace data of the
+ *  calling thread's location in the cache, so that subsequent analysis
+ *  runs can skip straight to the analysis phase. Failures are reported
+ *  as warnings, but do not abort the analysis.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class WriteCacheTask : public pearl::Task
+{
+  public:
+    /// @name Constructors & destructor
+    /// @{
+
+    WriteCacheTask(const TaskDataShared&  sharedData,
+                   const TaskDataPrivate& privateData,
+                   const std::string&     directory,
+                   uint64_t               stamp);
+
+    /// @}
+    /// @name Execution control
+    /// @{
+
+    virtual bool execute();
+
+    /// @}
+
+
+  private:
+    /// Shared task data object
+    const TaskDataShared& mSharedData;
+
+    /// Private task data object
+    const TaskDataPrivate& mPrivateData;
+
+    /// Cache directory
+    std::string mDirectory;
+
+    /// Validation stamp
+    uint64_t mStamp;
+};
+
+
+//--- Related functions -----------------------------------------------------
+
+uint64_t GetTraceCacheStamp(const TaskDataShared& sharedData,
+                            bool                  timeCorrected);
+
+bool CheckTraceCache(const TaskDataShared& sharedData,
+                     const std::string&    directory,
+                     uint64_t              stamp);
+
+
+}   // namespace scout
+
+
+#endif   // !SCOUT_TRACECACHETASK_H
@@ -0,0 +1,822 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+#include "WindowTask.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cstdlib>
+#include <map>
+
+#if defined(_MPI)
+  #include <mpi.h>
+#endif   // _MPI
+
+#include <pearl/Callpath.h>
+#include <pearl/Error.h>
+#include <pearl/Event.h>
+#include <pearl/GlobalDefs.h>
+#include <pearl/LocalTrace.h>
+#include <pearl/Region.h>
+#include <pearl/String.h>
+#include <pearl/pearl.h>
+
+#if defined(_MPI)
+  #include <pearl/MpiComm.h>
+  #include <pearl/ProcessGroup.h>
+#endif   // _MPI
+
+#include "Logging.h"
+#include "TaskData.h"
+
+using namespace std;
+using namespace pearl;
+using namespace scout;
+
+
+//--- Local helper functions & classes --------------------------------------
+
+namespace
+{
+
+/**
+ *  @brief Checks whether the analysis window can be applied.
+ *
+ *  The interleaved call stacks of OpenMP tasks and the cross-thread
+ *  dependencies of POSIX threads are not tracked when selecting events;
+ *  the same applies to MPI one-sided communication. As the check is based
+ *  on the global definitions, all processes and threads come to the same
+ *  conclusion.
+ *
+ *  @param  defs  Global definitions object
+ *  @return @em true if the trace can be restricted, @em false otherwise
+ **/
+bool isSupported(const GlobalDefs& defs)
+{
+  if (defs.num_windows() > 0)
+    return false;
+
+  const Region& taskRoot   = defs.getTaskRootRegion();
+  const Region& threadRoot = defs.getThreadRootRegion();
+
+  const uint32_t count = defs.numCallpaths();
+  for (uint32_t id = 0; id < count; ++id) {
+    const Region& region = defs.get_cnode(id)->getRegion();
+    if ((region == taskRoot) || (region == threadRoot))
+      return false;
+  }
+
+  return true;
+}
+
+
+/**
+ *  @brief Determines the union of the given time intervals.
+ *
+ *  Determines the smallest time interval enclosing the intervals given by
+ *  @a begin and @a end on all threads and processes. Empty intervals (i.e.,
+ *  @a begin > @a end) do not contribute to the result.
+ *
+ *  @param  begin  Begin of the interval (input/output parameter)
+ *  @param  end    End of the interval (input/output parameter)
+ **/
+void reduceInterval(timestamp_t& begin, timestamp_t& end)
+{
+  // These variables are shared!
+  static timestamp_t sharedBegin;
+  static timestamp_t sharedEnd;
+
+  #pragma omp barrier
+  #pragma omp master
+  {
+    sharedBegin = DBL_MAX;
+    sharedEnd   = -DBL_MAX;
+  }
+  #pragma omp barrier
+  #pragma omp critical
+  {
+    sharedBegin = min(sharedBegin, begin);
+    sharedEnd   = max(sharedEnd, end);
+  }
+  #pragma omp barrier
+  #if defined(_MPI)
+    #pragma omp master
+    {
+      timestamp_t local[2] = { sharedBegin, -sharedEnd };
+      timestamp_t global[2];
+      MPI_Allreduce(local, global, 2, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+
+      sharedBegin = global[0];
+      sharedEnd   = -global[1];
+    }
+    #pragma omp barrier
+  #endif   // _MPI
+
+  begin = sharedBegin;
+  end   = sharedEnd;
+}
+
+
+/**
+ *  @brief Parses an optional floating-point value.
+ *
+ *  Converts the string @a text to a floating-point value. An empty string
+ *  leaves @a value unchanged.
+ *
+ *  @param  text   String to parse
+ *  @param  value  Parsed value (output parameter)
+ *  @return @em true if successful, @em false otherwise
+ **/
+bool parseTimestamp(const string& text, timestamp_t& value)
+{
+  if (text.empty())
+    return true;
+
+  char* endptr;
+  value = strtod(text.c_str(), &endptr);
+
+  return (*endptr == '\0');
+}
+
+
+/**
+ *  @brief Parses a region instance number.
+ *
+ *  Converts the string @a text to a positive instance number.
+ *
+ *  @param  text   String to parse
+ *  @param  value  Parsed value (output parameter)
+ *  @return @em true if successful, @em false otherwise
+ **/
+bool parseInstance(const string& text, uint32_t& value)
+{
+  if (text.empty() || (text[0] < '0') || (text[0] > '9'))
+    return false;
+
+  char*               endptr;
+  const unsigned long number = strtoul(text.c_str(), &endptr, 10);
+  if ((*endptr != '\0') || (number == 0) || (number > UINT_MAX))
+    return false;
+
+  value = static_cast<uint32_t>(number);
+
+  return true;
+}
+
+
+#if defined(_MPI)
+  /**
+   *  @brief Determines the range of consecutively retained events.
+   *
+   *  Determines the range [@a first, @a last) of indices into @a positions
+   *  starting at the first retained event, up to (but excluding) the next
+   *  event which is not retained.
+   *
+   *  @param  positions  Event positions in trace order
+   *  @param  retained   Flags denoting the retained events
+   *  @param  first      First index of the range (output parameter)
+   *  @param  last       Index following the range (output parameter)
+   **/
+  void findRetainedRange(const vector<uint32_t>& positions,
+                         const vector<bool>&     retained,
+                         uint32_t&               first,
+                         uint32_t&               last)
+  {
+    const uint32_t count = positions.size();
+
+    first = 0;
+    while ((first < count) && !retained[positions[first]])
+      ++first;
+
+    last = first;
+    while ((last < count) && retained[positions[last]])
+      ++last;
+  }
+
+
+  /// Point-to-point message channel from the local process' point of view
+  struct ChannelKey
+  {
+    /// Communicator identifier
+    uint32_t comm;
+
+    /// Global rank of the peer process
+    uint32_t peer;
+
+    /// Message tag
+    uint32_t tag;
+
+    bool operator<(const ChannelKey& rhs) const
+    {
+      if (comm != rhs.comm)
+        return comm < rhs.comm;
+      if (peer != rhs.peer)
+        return peer < rhs.peer;
+
+      return tag < rhs.tag;
+    }
+  };
+
+
+  /// Messages transferred through a single channel, in matching order
+  struct Channel
+  {
+    /// Positions of the send or receive events
+    vector<uint32_t> positions;
+
+    /// First retained message
+    uint32_t first;
+
+    /// Index following the last retained message
+    uint32_t last;
+  };
+
+
+  /// Container type for message channels
+  typedef map<ChannelKey, Channel> ChannelMap;
+#endif   // _MPI
+
+}   // unnamed namespace
+
+
+//---------------------------------------------------------------------------
+//
+//  class WindowTask
+//
+//---------------------------------------------------------------------------
+
+//--- Constructors & destructor ---------------------------------------------
+
+/**
+ *  @brief Constructor. Creates a new window task.
+ *
+ *  This constructor creates a new task instance restricting the trace data
+ *  to the given analysis @a window.
+ *
+ *  @param  sharedData   Shared task data object
+ *  @param  privateData  Private task data object
+ *  @param  window       Analysis window specification
+ **/
+WindowTask::WindowTask(const TaskDataShared&  sharedData,
+                       const TaskDataPrivate& privateData,
+                       const AnalysisWindow&  window)
+  : Task(),
+    mSharedData(sharedData),
+    mPrivateData(privateData),
+    mWindow(window)
+{
+}
+
+
+//--- Execution control -----------------------------------------------------
+
+/**
+ *  @brief Restricts the local trace data to the analysis window.
+ *
+ *  Determines the time interval of the analysis window, selects the events
+ *  to be retained consistently across all processes and threads, and
+ *  removes all other events from the local trace.
+ *
+ *  @return Always @em true
+ *  @throw  pearl::RuntimeError if the specified region instances could not
+ *          be found
+ **/
+bool WindowTask::execute()
+{
+  const GlobalDefs& defs  = *mSharedData.mDefinitions;
+  LocalTrace&       trace = *mPrivateData.mTrace;
+
+  if (!isSupported(defs)) {
+    LogMsg(0, "\nAnalysis window not supported for traces with tasks, threads,"
+              " or one-sided\ncommunication, analyzing the entire trace.\n");
+
+    return true;
+  }
+
+  // Determine time interval
+  timestamp_t begin = mWindow.mBegin;
+  timestamp_t end   = mWindow.mEnd;
+  if (!mWindow.mRegion.empty()) {
+    findInstances(begin, end);
+    reduceInterval(begin, end);
+    if (begin > end)
+      throw RuntimeError("Instances of region '" + mWindow.mRegion
+                         + "' not found.");
+  }
+  snapToThreadTeams(begin, end);
+  if ((begin > -DBL_MAX) && (end < DBL_MAX))
+    LogMsg(1, "\n  Analysis window: %.6fs - %.6fs\n", begin, end);
+
+  // Select events to be retained
+  selectEvents(begin, end);
+  #if defined(_MPI)
+    #pragma omp master
+    {
+      restrictMessages();
+      restrictCollectives();
+    }
+  #endif   // _MPI
+  dropIncompleteRequests();
+
+  PEARL_restrict_trace(defs, trace, begin, end, mRetained);
+
+  // Release resources
+  vector<bool>().swap(mRetained);
+  vector< vector<uint32_t> >().swap(mRequests);
+
+  return true;
+}
+
+
+//--- Internal methods ------------------------------------------------------
+
+/**
+ *  @brief Determines the time interval of the local region instances.
+ *
+ *  Determines the time interval spanning from entering the first to leaving
+ *  the last region instance of the analysis window in the local trace. If
+ *  the local trace provides fewer instances, the interval ends with the last
+ *  available instance. If not even the first instance is available, an
+ *  empty interval is returned.
+ *
+ *  @param  begin  Begin of the interval (output parameter)
+ *  @param  end    End of the interval (output parameter)
+ **/
+void WindowTask::findInstances(timestamp_t& begin, timestamp_t& end) const
+{
+  const LocalTrace& trace = *mPrivateData.mTrace;
+
+  begin = DBL_MAX;
+  end   = -DBL_MAX;
+
+  uint32_t instance = 0;
+  for (Event event = trace.begin(); event != trace.end(); ++event) {
+    if (!event->isOfType(GROUP_ENTER)
+        || (mWindow.mRegion != event->getRegion().getDisplayName().getCString()))
+      continue;
+
+    ++instance;
+    if (instance < mWindow.mFirstInstance)
+      continue;
+
+    if (instance == mWindow.mFirstInstance)
+      begin = event->getTimestamp();
+    end = event.leaveptr()->getTimestamp();
+
+    if (instance == mWindow.mLastInstance)
+      break;
+  }
+}
+
+
+/**
+ *  @brief Extends the time interval to cover entire OpenMP thread teams.
+ *
+ *  Thread teams are either retained or removed as a whole, as the OpenMP
+ *  analysis relies on consistent fork/join and team events on all threads.
+ *  Therefore, the interval is extended by the master thread to cover all
+ *  fork/join pairs overlapping the interval boundaries, and then shared
+ *  with the worker threads. As the extended interval may overlap further
+ *  thread teams on other processes, the union of the intervals of all
+ *  processes is determined and snapped again, until the interval no longer
+ *  changes. This way, all processes use the same analysis window.
+ *
+ *  @param  begin  Begin of the interval (input/output parameter)
+ *  @param  end    End of the interval (input/output parameter)
+ **/
+void WindowTask::snapToThreadTeams(timestamp_t& begin, timestamp_t& end) const
+{
+  // These variables are shared!
+  static timestamp_t sharedBegin;
+  static timestamp_t sharedEnd;
+
+  // Only used by the master thread
+  vector< pair<timestamp_t, timestamp_t> > teams;
+
+  #pragma omp master
+  {
+    const LocalTrace& trace = *mPrivateData.mTrace;
+
+    vector<timestamp_t> forks;
+    for (Event event = trace.begin(); event != trace.end(); ++event) {
+      if (event->isOfType(THREAD_FORK)) {
+        forks.push_back(event->getTimestamp());
+      }
+      else if (event->isOfType(THREAD_JOIN) && !forks.empty()) {
+        teams.push_back(make_pair(forks.back(), event->getTimestamp()));
+        forks.pop_back();
+      }
+    }
+  }
+
+  timestamp_t prevBegin;
+  timestamp_t prevEnd;
+  do {
+    prevBegin = begin;
+    prevEnd   = end;
+
+    #pragma omp master
+    {
+      bool extended = true;
+      while (extended) {
+        extended = false;
+
+        vector< pair<timestamp_t, timestamp_t> >::const_iterator it = teams.begin();
+        while (it != teams.end()) {
+          if ((it->first <= end) && (it->second >= begin)
+              && ((it->first < begin) || (it->second > end))) {
+            begin    = min(begin, it->first);
+            end      = max(end, it->second);
+            extended = true;
+          }
+          ++it;
+        }
+      }
+
+      sharedBegin = begin;
+      sharedEnd   = end;
+    }
+    #pragma omp barrier
+
+    begin = sharedBegin;
+    end   = sharedEnd;
+    reduceInterval(begin, end);
+  } while ((begin != prevBegin) || (end != prevEnd));
+}
+
+
+/**
+ *  @brief Selects the local events to be retained.
+ *
+ *  Flags all events within the time interval [@a begin, @a end] as well as
+ *  the ENTER/LEAVE pairs of all regions overlapping this interval and of
+ *  @c MPI_Init and @c MPI_Finalize. BEGIN/END
+ *  pairs and non-blocking request chains are only retained if they are
+ *  entirely included in the interval.
+ *
+ *  @param  begin  Begin of the time interval
+ *  @param  end    End of the time interval
+ **/
+void WindowTask::selectEvents(timestamp_t begin, timestamp_t end)
+{
+  const LocalTrace& trace = *mPrivateData.mTrace;
+
+  mRetained.assign(trace.size(), false);
+  mRequests.clear();
+
+  // Request chains are linked the same way as by PEARL, i.e., a chain ends
+  // with the first non-tested event following the initial request event
+  map<uint64_t, uint32_t> pending;
+  for (Event event = trace.begin(); event != trace.end(); ++event) {
+    const uint32_t    index     = event.get_id();
+    const timestamp_t timestamp = event->getTimestamp();
+
+    if (event->isOfType(GROUP_ENTER)) {
+      // MPI initialization and finalization are always retained (truncated
+      // to the window boundaries if necessary), as they provide global
+      // synchronization points for the replay
+      const Region& region   = event->getRegion();
+      const Event   leave    = event.leaveptr();
+      const bool    overlaps = ((timestamp <= end)
+                                && (leave->getTimestamp() >= begin))
+                               || is_mpi_init(region)
+                               || is_mpi_finalize(region);
+
+      mRetained[index]          = overlaps;
+      mRetained[leave.get_id()] = overlaps;
+    }
+    else if (event->isOfType(GROUP_BEGIN)) {
+      const Event last   = event.endptr();
+      const bool  inside = (timestamp >= begin)
+                           && (last->getTimestamp() <= end);
+
+      mRetained[index]         = inside;
+      mRetained[last.get_id()] = inside;
+    }
+    else if (event->isOfType(GROUP_NONBLOCK)) {
+      const uint64_t requestId = event->getRequestId();
+
+      map<uint64_t, uint32_t>::iterator it = pending.find(requestId);
+      if (it != pending.end()) {
+        mRequests[it->second].push_back(index);
+        if (!event->isOfType(MPI_REQUEST_TESTED))
+          pending.erase(it);
+      } else {
+        pending.insert(make_pair(requestId, mRequests.size()));
+        mRequests.push_back(vector<uint32_t>(1, index));
+      }
+    }
+    else if (!event->isOfType(LEAVE) && !event->isOfType(GROUP_END)) {
+      mRetained[index] = (timestamp >= begin) && (timestamp <= end);
+    }
+  }
+
+  vector< vector<uint32_t> >::const_iterator it = mRequests.begin();
+  while (it != mRequests.end()) {
+    const bool inside = (trace.at(it->front())->getTimestamp() >= begin)
+                        && (trace.at(it->back())->getTimestamp() <= end);
+
+    vector<uint32_t>::const_iterator pos = it->begin();
+    while (pos != it->end()) {
+      mRetained[*pos] = inside;
+      ++pos;
+    }
+    ++it;
+  }
+}
+
+
+/**
+ *  @brief Removes partially retained request chains.
+ *
+ *  Non-blocking request chains are either retained or removed as a whole.
+ *  Thus, if any event of a chain has been removed (e.g., by the selection
+ *  of the point-to-point messages), all other events of the chain are
+ *  removed as well.
+ **/
+void WindowTask::dropIncompleteRequests()
+{
+  vector< vector<uint32_t> >::const_iterator it = mRequests.begin();
+  while (it != mRequests.end()) {
+    vector<uint32_t>::const_iterator pos = it->begin();
+    while ((pos != it->end()) && mRetained[*pos])
+      ++pos;
+
+    if (pos != it->end()) {
+      for (pos = it->begin(); pos != it->end(); ++pos)
+        mRetained[*pos] = false;
+    }
+    ++it;
+  }
+}
+
+
+#if defined(_MPI)
+
+/**
+ *  @brief Restricts point-to-point messages consistently.
+ *
+ *  The messages of each channel (i.e., communicator, peer, and tag) are
+ *  numbered in matching order on both the sender and the receiver side.
+ *  Each side determines the range of consecutive messages it would retain,
+ *  and exchanges it with the peer process. Only messages in the
+ *  intersection of both ranges are retained on both sides, ensuring that
+ *  every retained send is matched by a retained receive during the replay.
+ **/
+void WindowTask::restrictMessages()
+{
+  const LocalTrace& trace = *mPrivateData.mTrace;
+
+  // 1st map: sends, 2nd map: receives
+  ChannelMap channels[2];
+  for (Event event = trace.begin(); event != trace.end(); ++event) {
+    int      direction;
+    uint32_t rank;
+    if (event->isOfType(GROUP_SEND)) {
+      // Cancelled sends are not transferred during the replay
+      if (event.completion()->isOfType(MPI_CANCELLED))
+        continue;
+
+      direction = 0;
+      rank      = event->getDestination();
+    }
+    else if (event->isOfType(GROUP_RECV)) {
+      direction = 1;
+      rank      = event->getSource();
+    }
+    else {
+      continue;
+    }
+
+    const MpiComm* comm = event->getComm();
+    ChannelKey     key  = { comm->getId(),
+                            static_cast<uint32_t>(
+                              comm->getGroup().getGlobalRank(rank)),
+                            event->getTag() };
+    channels[direction][key].positions.push_back(event.get_id());
+  }
+
+  // Collect local message ranges by peer
+  int numProcs;
+  MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+
+  vector< vector<uint32_t> > outgoing(numProcs);
+  for (int direction = 0; direction < 2; ++direction) {
+    ChannelMap::iterator it = channels[direction].begin();
+    while (it != channels[direction].end()) {
+      Channel& channel = it->second;
+      findRetainedRange(channel.positions, mRetained,
+                        channel.first, channel.last);
+
+      vector<uint32_t>& entry = outgoing[it->first.peer];
+      entry.push_back(direction);
+      entry.push_back(it->first.comm);
+      entry.push_back(it->first.tag);
+      entry.push_back(channel.first);
+      entry.push_back(channel.last);
+      ++it;
+    }
+  }
+
+  // Exchange message ranges with peers
+  vector<int>      sendCounts(numProcs);
+  vector<int>      sendDispls(numProcs);
+  vector<int>      recvCounts(numProcs);
+  vector<int>      recvDispls(numProcs);
+  vector<uint32_t> sendBuffer;
+  for (int peer = 0; peer < numProcs; ++peer) {
+    sendDispls[peer] = sendBuffer.size();
+    sendCounts[peer] = outgoing[peer].size();
+    sendBuffer.insert(sendBuffer.end(),
+                      outgoing[peer].begin(), outgoing[peer].end());
+  }
+  vector< vector<uint32_t> >().swap(outgoing);
+
+  MPI_Alltoall(&sendCounts[0], 1, MPI_INT,
+               &recvCounts[0], 1, MPI_INT, MPI_COMM_WORLD);
+
+  int recvTotal = 0;
+  for (int peer = 0; peer < numProcs; ++peer) {
+    recvDispls[peer] = recvTotal;
+    recvTotal       += recvCounts[peer];
+  }
+  vector<uint32_t> recvBuffer(recvTotal);
+
+  // Avoid taking the address of the first element of empty vectors
+  sendBuffer.push_back(0);
+  recvBuffer.push_back(0);
+  MPI_Alltoallv(&sendBuffer[0], &sendCounts[0], &sendDispls[0], MPI_UNSIGNED,
+                &recvBuffer[0], &recvCounts[0], &recvDispls[0], MPI_UNSIGNED,
+                MPI_COMM_WORLD);
+
+  // Intersect with the peer ranges; the peer's sends are the local receives
+  // and vice versa
+  for (int peer = 0; peer < numProcs; ++peer) {
+    const uint32_t* entry = &recvBuffer[recvDispls[peer]];
+    const uint32_t* last  = entry + recvCounts[peer];
+    for ( ; entry < last; entry += 5) {
+      const ChannelKey key = { entry[1], static_cast<uint32_t>(peer), entry[2] };
+
+      ChannelMap&          peerChannels = channels[1 - entry[0]];
+      ChannelMap::iterator it           = peerChannels.find(key);
+      if (it == peerChannels.end())
+        continue;
+
+      it->second.first = max(it->second.first, entry[3]);
+      it->second.last  = min(it->second.last, entry[4]);
+    }
+  }
+
+  // Remove all messages outside of the common range
+  for (int direction = 0; direction < 2; ++direction) {
+    ChannelMap::const_iterator it = channels[direction].begin();
+    while (it != channels[direction].end()) {
+      const Channel& channel = it->second;
+
+      const uint32_t count = channel.positions.size();
+      for (uint32_t index = 0; index < count; ++index)
+        if ((index < channel.first) || (index >= channel.last))
+          mRetained[channel.positions[index]] = false;
+      ++it;
+    }
+  }
+}
+
+
+/**
+ *  @brief Restricts collective operations consistently.
+ *
+ *  The collective operations of each communicator are numbered in trace
+ *  order. Only operations retained on all members of the communicator are
+ *  retained, which is determined by a single global reduction over the
+ *  per-communicator ranges of retained operations.
+ **/
+void WindowTask::restrictCollectives()
+{
+  const GlobalDefs& defs  = *mSharedData.mDefinitions;
+  const LocalTrace& trace = *mPrivateData.mTrace;
+
+  const uint32_t            numComms = defs.numCommunicators();
+  map<uint32_t, uint32_t>   commIndex;
+  for (uint32_t index = 0; index < numComms; ++index)
+    commIndex[defs.getCommunicatorByIndex(index).getId()] = index;
+
+  vector< vector<uint32_t> > operations(numComms);
+  for (Event event = trace.begin(); event != trace.end(); ++event)
+    if (event->isOfType(MPI_COLLECTIVE_END))
+      operations[commIndex[event->getComm()->getId()]].push_back(event.get_id());
+
+  // Determine maximum first and minimum last index at once by reducing the
+  // complement of the last index; communicators without local operations
+  // contribute the neutral element
+  vector<uint32_t> local(2 * numComms, 0);
+  vector<uint32_t> global(2 * numComms);
+  for (uint32_t index = 0; index < numComms; ++index) {
+    if (operations[index].empty())
+      continue;
+
+    uint32_t first;
+    uint32_t last;
+    findRetainedRange(operations[index], mRetained, first, last);
+
+    local[2 * index]     = first;
+    local[2 * index + 1] = UINT_MAX - last;
+  }
+  local.push_back(0);
+  global.push_back(0);
+  MPI_Allreduce(&local[0], &global[0], 2 * numComms, MPI_UNSIGNED, MPI_MAX,
+                MPI_COMM_WORLD);
+
+  // Remove all operations outside of the common range
+  for (uint32_t index = 0; index < numComms; ++index) {
+    const uint32_t first = global[2 * index];
+    const uint32_t last  = UINT_MAX - global[2 * index + 1];
+
+    const uint32_t count = operations[index].size();
+    for (uint32_t pos = 0; pos < count; ++pos) {
+      if ((pos < first) || (pos >= last)) {
+        const Event end = trace.at(operations[index][pos]);
+
+        mRetained[end.get_id()]            = false;
+        mRetained[end.beginptr().get_id()] = false;
+      }
+    }
+  }
+}
+
+#endif   // _MPI
+
+
+//--- Related functions -----------------------------------------------------
+
+/**
+ *  @brief Parses a time window specification.
+ *
+ *  Parses the time window specification @a spec of the form
+ *  <tt>&lt;t0&gt;:&lt;t1&gt;</tt> (in seconds relative to the begin of the
+ *  trace) and stores it in @a window. Either bound may be omitted.
+ *
+ *  @param  spec    Time window specification
+ *  @param  window  Analysis window (output parameter)
+ *  @return @em true if successful, @em false otherwise
+ **/
+bool scout::ParseTimeWindow(const string& spec, AnalysisWindow& window)
+{
+  const string::size_type colon = spec.find(':');
+  if (colon == string::npos)
+    return false;
+
+  window.mBegin = -DBL_MAX;
+  window.mEnd   = DBL_MAX;
+  window.mRegion.clear();
+  if (!parseTimestamp(spec.substr(0, colon), window.mBegin)
+      || !parseTimestamp(spec.substr(colon + 1), window.mEnd))
+    return false;
+
+  return (window.mBegin <= window.mEnd);
+}
+
+
+/**
+ *  @brief Parses a region instance specification.
+ *
+ *  Parses the region instance specification @a spec of the form
+ *  <tt>&lt;region&gt;:&lt;n0&gt;[-&lt;n1&gt;]</tt> (1-based, inclusive)
+ *  and stores it in @a window.
+ *
+ *  @param  spec    Region instance specification
+ *  @param  window  Analysis window (output parameter)
+ *  @return @em true if successful, @em false otherwise
+ **/
+bool scout::ParseRegionInstances(const string& spec, AnalysisWindow& window)
+{
+  const string::size_type colon = spec.rfind(':');
+  if ((colon == string::npos) || (colon == 0))
+    return false;
+
+  const string            range = spec.substr(colon + 1);
+  const string::size_type dash  = range.find('-');
+  if (!parseInstance(range.substr(0, dash), window.mFirstInstance))
+    return false;
+  if (dash == string::npos)
+    window.mLastInstance = window.mFirstInstance;
+  else if (!parseInstance(range.substr(dash + 1), window.mLastInstance))
+    return false;
+
+  window.mRegion = spec.substr(0, colon);
+  window.mBegin  = -DBL_MAX;
+  window.mEnd    = DBL_MAX;
+
+  return (window.mFirstInstance <= window.mLastInstance);
+}
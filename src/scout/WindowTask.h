@@ -0,0 +1,166 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#ifndef SCOUT_WINDOWTASK_H
+#define SCOUT_WINDOWTASK_H
+
+
+#include <string>
+#include <vector>
+
+#include <pearl/Task.h>
+#include <pearl/pearl_types.h>
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @file  WindowTask.h
+ *  @brief Declaration of the WindowTask class.
+ *
+ *  This header file provides the declaration of the WindowTask class which
+ *  restricts the trace data to a user-specified analysis window, as well as
+ *  related functions.
+ **/
+/*-------------------------------------------------------------------------*/
+
+
+namespace scout
+{
+
+//--- Forward declarations --------------------------------------------------
+
+struct TaskDataPrivate;
+struct TaskDataShared;
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @struct AnalysisWindow
+ *  @brief  Specification of the part of the trace to be analyzed.
+ *
+ *  The analysis window is either given as a time interval relative to the
+ *  begin of the trace, or as a range of instances of a particular region.
+ *  In the latter case, the time interval spans from entering the first to
+ *  leaving the last instance (across all processes and threads).
+ **/
+/*-------------------------------------------------------------------------*/
+
+struct AnalysisWindow
+{
+  /// Begin of the time interval
+  pearl::timestamp_t mBegin;
+
+  /// End of the time interval
+  pearl::timestamp_t mEnd;
+
+  /// Name of the region whose instances define the window (or empty)
+  std::string mRegion;
+
+  /// First region instance (1-based)
+  uint32_t mFirstInstance;
+
+  /// Last region instance (1-based, inclusive)
+  uint32_t mLastInstance;
+};
+
+
+/*-------------------------------------------------------------------------*/
+/**
+ *  @class WindowTask
+ *  @brief Task restricting the trace data to the analysis window.
+ *
+ *  The WindowTask class removes all events outside of a given analysis
+ *  window from the local trace, such that the subsequent replay-based
+ *  analysis only examines the events in this window. Regions overlapping
+ *  the window boundaries are truncated. The event selection is coordinated
+ *  across processes and threads: point-to-point messages, collective
+ *  operations, and OpenMP parallel regions are either retained or removed
+ *  on all participating locations, as otherwise the replay would deadlock
+ *  or yield incorrect wait states.
+ *
+ *  The task operates on the trace data already read into memory, i.e., it
+ *  reduces the replay time, but neither the I/O time nor the memory
+ *  requirements of the analysis.
+ *
+ *  Traces with OpenMP tasks, POSIX threads, or MPI one-sided communication
+ *  are not supported; in this case, the entire trace is analyzed.
+ **/
+/*-------------------------------------------------------------------------*/
+
+class WindowTask : public pearl::Task
+{
+  public:
+    /// @name Constructors & destructor
+    /// @{
+
+    WindowTask(const TaskDataShared&  sharedData,
+               const TaskDataPrivate& privateData,
+               const AnalysisWindow&  window);
+
+    /// @}
+    /// @name Execution control
+    /// @{
+
+    virtual bool execute();
+
+    /// @}
+
+
+  private:
+    /// Shared task data object
+    const TaskDataShared& mSharedData;
+
+    /// Private task data object
+    const TaskDataPrivate& mPrivateData;
+
+    /// Analysis window specification
+    const AnalysisWindow& mWindow;
+
+    /// Flags denoting the events to be retained, indexed by event position
+    std::vector<bool> mRetained;
+
+    /// Event positions of the local non-blocking request chains
+    std::vector< std::vector<uint32_t> > mRequests;
+
+
+    /// @name Internal methods
+    /// @{
+
+    void findInstances(pearl::timestamp_t& begin,
+                       pearl::timestamp_t& end) const;
+    void snapToThreadTeams(pearl::timestamp_t& begin,
+                           pearl::timestamp_t& end) const;
+    void selectEvents(pearl::timestamp_t begin,
+                      pearl::timestamp_t end);
+    void dropIncompleteRequests();
+
+    #if defined(_MPI)
+      void restrictMessages();
+      void restrictCollectives();
+    #endif   // _MPI
+
+    /// @}
+};
+
+
+//--- Related functions -----------------------------------------------------
+
+bool ParseTimeWindow(const std::string& spec,
+                     AnalysisWindow&    window);
+bool ParseRegionInstances(const std::string& spec,
+                          AnalysisWindow&    window);
+
+
+}   // namespace scout
+
+
+#endif   // !SCOUT_WINDOWTASK_H
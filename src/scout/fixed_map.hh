@@ -71,6 +71,10 @@ public:
         return count;
     }
 
+    static int max_size() {
+        return maxsize;
+    }
+
     bool is_empty() const {
         return count == 0;
     }
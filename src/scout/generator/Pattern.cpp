@@ -57,9 +57,180 @@ string lowercase(const string& str)
   return result;
 }
 
+
+/* Pattern types & corresponding preprocessor guards */
+const struct patterntype {
+  const char *type, *begin, *end, *baseclass;
+} patterntypes[] = {
+  { "Generic", 0, 0, "Pattern" },
+  { "MPI",
+    "#if defined(_MPI)\n",
+    "#endif   /* _MPI */\n",
+    "MpiPattern"
+  },
+  { "MPIDEP",
+    "#if defined(_MPI)\n",
+    "#endif   /* _MPI */\n",
+    "Pattern",
+  },
+  { "MPI_RMA",
+    "#if defined(_MPI) && defined(HAS_MPI2_1SIDED)\n",
+    "#endif   /* _MPI && HAS_MPI2_1SIDED */\n",
+    "MpiPattern",
+  },
+  { "MPI_RMADEP",
+    "#if defined(_MPI) && defined(HAS_MPI2_1SIDED)\n",
+    "#endif   /* _MPI && HAS_MPI2_1SIDED */\n",
+    "Pattern",
+  },
+  { "OMP",
+    "#if defined(_OPENMP)\n",
+    "#endif   /* _OPENMP */\n",
+    "OmpPattern",
+  },
+  { "OMPDEP",
+    "#if defined(_OPENMP)\n",
+    "#endif   /* _OPENMP */\n",
+    "Pattern",
+  },
+  { "ARMCI",
+    "#if defined(HAS_ARMCI)\n",
+    "#endif   /* HAS_ARMCI */\n",
+    "ArmciPattern"
+  },
+  { "ARMCIDEP",
+    "#if defined(HAS_ARMCI)\n",
+    "#endif   /* HAS_ARMCI */\n",
+    "Pattern"
+  },
+
+  { 0, 0, 0, 0 }
+};
+
+
+const struct patterntype* find_patterntype(const string& type)
+{
+  const struct patterntype* pt;
+
+  for (pt = patterntypes; pt->type && type != pt->type; ++pt)
+    ;
+
+  return pt;
+}
+
+
+/* Event types as defined by pearl::event_t (excluding groups) */
+const char* const event_types[] = {
+  "ENTER",
+  "ENTER_CS",
+  "LEAVE",
+  "MPI_COLLECTIVE_BEGIN",
+  "MPI_COLLECTIVE_END",
+  "MPI_SEND",
+  "MPI_SEND_REQUEST",
+  "MPI_SEND_COMPLETE",
+  "MPI_RECV",
+  "MPI_RECV_REQUEST",
+  "MPI_RECV_COMPLETE",
+  "MPI_REQUEST_TESTED",
+  "MPI_CANCELLED",
+  "THREAD_ACQUIRE_LOCK",
+  "THREAD_RELEASE_LOCK",
+  "THREAD_TASK_CREATE",
+  "THREAD_TASK_COMPLETE",
+  "THREAD_TASK_SWITCH",
+  "THREAD_BEGIN",
+  "THREAD_END",
+  "THREAD_CREATE",
+  "THREAD_WAIT",
+  "THREAD_FORK",
+  "THREAD_JOIN",
+  "THREAD_TEAM_BEGIN",
+  "THREAD_TEAM_END",
+  "RMA_PUT_START",
+  "RMA_PUT_END",
+  "RMA_GET_START",
+  "RMA_GET_END",
+  "MPI_RMA_PUT_START",
+  "MPI_RMA_PUT_END",
+  "MPI_RMA_GET_START",
+  "MPI_RMA_GET_END",
+  "MPI_RMA_GATS",
+  "MPI_RMA_COLLECTIVE_BEGIN",
+  "MPI_RMA_COLLECTIVE_END",
+  "MPI_RMA_LOCK",
+  "MPI_RMA_UNLOCK",
+  0
+};
+
+
+/* Event groups as expanded by pearl::CallbackManager::register_callback() */
+const struct eventgroup {
+  const char *group, *types[7];
+} eventgroups[] = {
+  { "GROUP_NONBLOCK",
+    { "MPI_SEND_REQUEST", "MPI_SEND_COMPLETE", "MPI_RECV_REQUEST",
+      "MPI_RECV_COMPLETE", "MPI_REQUEST_TESTED", "MPI_CANCELLED", 0 }
+  },
+  { "GROUP_ENTER", { "ENTER", "ENTER_CS", 0 } },
+  { "GROUP_SEND",  { "MPI_SEND", "MPI_SEND_REQUEST", 0 } },
+  { "GROUP_RECV",  { "MPI_RECV", "MPI_RECV_COMPLETE", 0 } },
+  { "GROUP_BEGIN", { "MPI_COLLECTIVE_BEGIN", "MPI_RMA_COLLECTIVE_BEGIN", 0 } },
+  { "GROUP_END",   { "MPI_COLLECTIVE_END", "MPI_RMA_COLLECTIVE_END", 0 } },
+
+  { 0, { 0 } }
+};
+
 }   // unnamed namespace
 
 
+//--- Event type helpers ----------------------------------------------------
+
+const vector<string>& trace_event_types()
+{
+  static vector<string> types;
+
+  if (types.empty())
+    for (const char* const* type = event_types; *type; ++type)
+      types.push_back(*type);
+
+  return types;
+}
+
+
+bool is_trace_event(const string& event)
+{
+  if (event == "GROUP_ALL")
+    return true;
+
+  for (const struct eventgroup* eg = eventgroups; eg->group; ++eg)
+    if (event == eg->group)
+      return true;
+
+  const vector<string>& types = trace_event_types();
+
+  return find(types.begin(), types.end(), event) != types.end();
+}
+
+
+bool event_matches(const string& event, const string& type)
+{
+  if (event == type || event == "GROUP_ALL")
+    return true;
+
+  for (const struct eventgroup* eg = eventgroups; eg->group; ++eg) {
+    if (event != eg->group)
+      continue;
+
+    for (const char* const* t = eg->types; *t; ++t)
+      if (type == *t)
+        return true;
+  }
+
+  return false;
+}
+
+
 //---------------------------------------------------------------------------
 //
 //  class Pattern
@@ -83,6 +254,66 @@ bool Pattern::add_callback(const std::string& group, const string& event, const
 }
 
 
+/*--- Retrieving callback information ------------------------------------*/
+
+vector<string> Pattern::get_callback_groups() const
+{
+  vector<string> result;
+
+  map< string, vector<string> >::const_iterator it = m_callbackgroups.begin();
+  while (it != m_callbackgroups.end()) {
+    result.push_back(lowercase(it->first));
+    ++it;
+  }
+
+  return result;
+}
+
+
+bool Pattern::has_fused_callbacks() const
+{
+  if (skip_impl())
+    return false;
+
+  map< string, vector<string> >::const_iterator git = m_callbackgroups.begin();
+  while (git != m_callbackgroups.end()) {
+    vector<string>::const_iterator it = git->second.begin();
+    for ( ; it != git->second.end(); ++it)
+      if (is_trace_event(*it))
+        return true;
+    ++git;
+  }
+
+  return false;
+}
+
+
+bool Pattern::has_fused_callbacks(const string& group, const string& type) const
+{
+  if (skip_impl())
+    return false;
+
+  map< string, vector<string> >::const_iterator git = m_callbackgroups.begin();
+  while (git != m_callbackgroups.end()) {
+    if (lowercase(git->first) == group) {
+      vector<string>::const_iterator it = git->second.begin();
+      for ( ; it != git->second.end(); ++it)
+        if (event_matches(*it, type))
+          return true;
+    }
+    ++git;
+  }
+
+  return false;
+}
+
+
+string Pattern::get_fused_member() const
+{
+  return "p_" + lowercase(m_id);
+}
+
+
 /*--- Checking validity ---------------------------------------------------*/
 
 missing_t Pattern::is_valid() const
@@ -104,63 +335,12 @@ missing_t Pattern::is_valid() const
 
 /*--- Writing output ------------------------------------------------------*/
 
-void Pattern::write_impl(FILE* fp) const
+void Pattern::write_impl(FILE* fp, backend_t backend) const
 {
   if (skip_impl())
     return;
 
-  const struct patterntype {
-    const char *type, *begin, *end, *baseclass;
-  } patterntypes[] = {
-    { "Generic", 0, 0, "Pattern" },
-    { "MPI",
-      "#if defined(_MPI)\n",
-      "#endif   /* _MPI */\n",
-      "MpiPattern"
-    },
-    { "MPIDEP",
-      "#if defined(_MPI)\n",
-      "#endif   /* _MPI */\n",
-      "Pattern",
-    },
-    { "MPI_RMA",
-      "#if defined(_MPI) && defined(HAS_MPI2_1SIDED)\n",
-      "#endif   /* _MPI && HAS_MPI2_1SIDED */\n",
-      "MpiPattern",
-    },
-    { "MPI_RMADEP",
-      "#if defined(_MPI) && defined(HAS_MPI2_1SIDED)\n",
-      "#endif   /* _MPI && HAS_MPI2_1SIDED */\n",
-      "Pattern",
-    },
-    { "OMP",
-      "#if defined(_OPENMP)\n",
-      "#endif   /* _OPENMP */\n",
-      "OmpPattern",
-    },
-    { "OMPDEP",
-      "#if defined(_OPENMP)\n",
-      "#endif   /* _OPENMP */\n",
-      "Pattern",
-    },
-    { "ARMCI",
-      "#if defined(HAS_ARMCI)\n",
-      "#endif   /* HAS_ARMCI */\n",
-      "ArmciPattern"
-    },
-    { "ARMCIDEP",
-      "#if defined(HAS_ARMCI)\n",
-      "#endif   /* HAS_ARMCI */\n",
-      "Pattern"
-    },
-
-    { 0, 0, 0, 0 }
-  };
-
-  const struct patterntype* pt;
-
-  for (pt = patterntypes; pt->type && m_type != pt->type; ++pt)
-    ;
+  const struct patterntype* pt = find_patterntype(m_type);
 
   /***** Header *****/
 
@@ -195,18 +375,28 @@ void Pattern::write_impl(FILE* fp) const
   /***** reg_cb() *****/
 
   if (!m_callbacks.empty()) {
+    // Trace-event callbacks are dispatched by the fused replay kernels
+    map< string, vector<string> > registered;
+    for (map< string, vector<string> >::const_iterator git = m_callbackgroups.begin(); git != m_callbackgroups.end(); ++git)
+      for (vector<string>::const_iterator cit = git->second.begin(); cit != git->second.end(); ++cit)
+        if (backend != BACKEND_FUSED || !is_trace_event(*cit))
+          registered[git->first].push_back(*cit);
+
     fprintf(fp, "    /* Registering callbacks */\n"
-                "    virtual void reg_cb(CallbackManagerMap& cbmgrs)\n"
-                "    {\n");
+                "    virtual void reg_cb(CallbackManagerMap&%s)\n"
+                "    {\n",
+                registered.empty() ? "" : " cbmgrs");
     fprintf(fp, "      init();\n\n");
 
-    for (map< string, vector<string> >::const_iterator git = m_callbackgroups.begin(); git != m_callbackgroups.end(); ++git) {
+    for (map< string, vector<string> >::const_iterator git = registered.begin(); git != registered.end(); ++git) {
+      const vector<string>& events = git->second;
+
       fprintf(fp, "      {\n"
                   "        CallbackManagerMap::iterator it = cbmgrs.find(\"%s\");\n\n"
                   "        assert(it != cbmgrs.end());\n\n",
               lowercase(git->first).c_str());
 
-      for (vector<string>::const_iterator cit = git->second.begin(); cit != git->second.end(); ++cit) {
+      for (vector<string>::const_iterator cit = events.begin(); cit != events.end(); ++cit) {
         fprintf(fp, "        (it->second)->register_callback(%s, PEARL_create_callback(this, &%s::%s_%s_cb));\n",
                 (*cit).c_str(),
                 m_class.c_str(),
@@ -357,6 +547,41 @@ void Pattern::write_impl(FILE* fp) const
 }
 
 
+void Pattern::write_fused_calls(FILE* fp, const string& group, const string& type) const
+{
+  if (!has_fused_callbacks(group, type))
+    return;
+
+  const struct patterntype* pt = find_patterntype(m_type);
+
+  if (pt->begin)
+    fprintf(fp, "%s", pt->begin);
+
+  fprintf(fp, "      if (m_patterns.%s) {\n", get_fused_member().c_str());
+
+  // Callbacks are invoked in registration order, matching the semantics
+  // of pearl::CallbackManager::notify()
+  map< string, vector<string> >::const_iterator git = m_callbackgroups.begin();
+  while (git != m_callbackgroups.end()) {
+    if (lowercase(git->first) == group) {
+      vector<string>::const_iterator it = git->second.begin();
+      for ( ; it != git->second.end(); ++it)
+        if (event_matches(*it, type))
+          fprintf(fp, "        m_patterns.%s->%s_%s_cb(cbmanager, user_event, event, cdata);\n",
+                      get_fused_member().c_str(),
+                      lowercase(*it).c_str(),
+                      lowercase(git->first).c_str());
+    }
+    ++git;
+  }
+
+  fprintf(fp, "      }\n");
+
+  if (pt->end)
+    fprintf(fp, "%s", pt->end);
+}
+
+
 void Pattern::write_html(FILE* fp, bool isFirst)
 {
   if (m_nodocs)
@@ -34,6 +34,18 @@ enum missing_t {
   DEF_MODE
 };
 
+enum backend_t {
+  BACKEND_CALLBACK,   // per-pattern dynamic callback registration
+  BACKEND_FUSED       // per-replay fused dispatch of trace-event callbacks
+};
+
+
+/*--- Function prototypes -------------------------------------------------*/
+
+const std::vector<std::string>& trace_event_types();
+bool is_trace_event(const std::string& event);
+bool event_matches(const std::string& event, const std::string& type);
+
 
 //---------------------------------------------------------------------------
 //
@@ -95,6 +107,13 @@ class Pattern
 
     bool skip_impl() const { return m_hidden && m_callbacks.empty(); }
 
+    /* Retrieving callback information */
+    std::vector<std::string> get_callback_groups() const;
+    bool has_fused_callbacks() const;
+    bool has_fused_callbacks(const std::string& group,
+                             const std::string& type) const;
+    std::string get_fused_member() const;
+
     /* Adding callbacks */
     bool add_callback(const std::string& cbgroup, 
                       const std::string& event, 
@@ -104,7 +123,10 @@ class Pattern
     missing_t is_valid() const;
 
     /* Writing output */
-    void write_impl(std::FILE* fp) const;
+    void write_impl(std::FILE* fp, backend_t backend) const;
+    void write_fused_calls(std::FILE* fp,
+                           const std::string& group,
+                           const std::string& type) const;
     void write_html(std::FILE* fp, bool isFirst);
 
 
@@ -22,6 +22,7 @@
 #include <cctype>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <functional>
 #include <map>
 #include <string>
@@ -70,6 +71,8 @@ int    incLine;
 string prolog;
 string prefix("Patterns_gen");
 
+backend_t backend = BACKEND_CALLBACK;
+
 map<string,Pattern*> id2pattern;    // pattern id |-> pattern
 vector<Pattern*>     pattern;       // pattern list
 Pattern*             current;       // current pattern
@@ -81,6 +84,11 @@ int main(int argc, char** argv);
 
 void write_header();
 void write_impl();
+void write_fused_kernels(FILE* fp);
+vector<string> fused_groups();
+string fused_classname(const string& group);
+void fused_guards(const string& group, string& begin, string& end);
+void pattern_guards(const string& type, const char*& begin, const char*& end);
 void write_html();
 
 string uppercase(const string& str);
@@ -442,7 +450,7 @@ Text            : Text TEXT
 /*
  *---------------------------------------------------------------------------
  *
- * gen_pattern <description file>
+ * gen_pattern [-b callback|fused] <description file>
  *
  *---------------------------------------------------------------------------
  */
@@ -450,13 +458,26 @@ Text            : Text TEXT
 int main(int argc, char** argv)
 {
   /* Check command line arguments */
-  if (argc != 2) {
-    fprintf(stderr, "Usage: gen_patterns <description file>\n");
+  int argi = 1;
+  if (argc == 4 && string(argv[1]) == "-b") {
+    string name(argv[2]);
+    if (name == "callback")
+      backend = BACKEND_CALLBACK;
+    else if (name == "fused")
+      backend = BACKEND_FUSED;
+    else {
+      fprintf(stderr, "Unknown backend \"%s\".\n", name.c_str());
+      exit(EXIT_FAILURE);
+    }
+    argi += 2;
+  }
+  if (argc != argi + 1) {
+    fprintf(stderr, "Usage: gen_patterns [-b callback|fused] <description file>\n");
     exit(EXIT_FAILURE);
   }
 
   /* Store input filename */
-  inpFilename = argv[1];
+  inpFilename = argv[argi];
 
   /* Open input file */
   yyin = fopen(inpFilename.c_str(), "r");
@@ -590,15 +611,21 @@ void write_impl()
   /* Write class implementation */
   vector<Pattern*>::const_iterator it = pattern.begin();
   while (it != pattern.end()) {
-    (*it)->write_impl(fp);
+    (*it)->write_impl(fp, backend);
     ++it;
   }
 
+  /* Write fused replay kernels */
+  if (backend == BACKEND_FUSED)
+    write_fused_kernels(fp);
+
   /* Write function implementation */
   fprintf(fp, "//--- Implementation --------------------------------------------------------\n"
               "\n"
               "void scout::create_patterns(AnalyzeTask* analyzer)\n"
               "{\n");
+  if (backend == BACKEND_FUSED)
+    fprintf(fp, "  FusedPatterns patterns = FusedPatterns();\n\n");
   it = pattern.begin();
   while (it != pattern.end()) {
     if ((*it)->skip_impl()) {
@@ -606,64 +633,42 @@ void write_impl()
       continue;
     }
 
-    const struct guard {
-      const char *type, *begin, *end;
-    } guards[] = {
-      { "MPI",    
-        "#if defined(_MPI)\n", 
-        "#endif   /* _MPI */\n" 
-      },
-      { "MPIDEP", 
-        "#if defined(_MPI)\n", 
-        "#endif   /* _MPI */\n" 
-      },
-      { "MPI_RMA",
-        "#if defined(_MPI) && defined(HAS_MPI2_1SIDED)\n", 
-        "#endif   /* _MPI && HAS_MPI2_1SIDED */\n"
-      },
-      { "MPI_RMADEP",
-        "#if defined(_MPI) && defined(HAS_MPI2_1SIDED)\n", 
-        "#endif   /* _MPI && HAS_MPI2_1SIDED */\n"
-      },
-      { "OMP",
-        "#if defined(_OPENMP)\n",
-        "#endif   /* _OPENMP */\n"        
-      },
-      { "OMPDEP",
-        "#if defined(_OPENMP)\n",
-        "#endif   /* _OPENMP */\n"        
-      },
-      { "ARMCI",
-        "#if defined(HAS_ARMCI)\n",
-        "#endif   /* HAS_ARMCI */\n"
-      },
-      { "ARMCIDEP",
-        "#if defined(HAS_ARMCI)\n",
-        "#endif   /* HAS_ARMCI */\n"
-      },
-
-      { 0, 0, 0 }
-    };
-
-    const struct guard* g;
-
-    for (g = guards; g->type && (*it)->get_type() != g->type; ++g)
-      ;
-
-    if (g->begin)
-      fprintf(fp, "%s", g->begin);
+    const char* begin;
+    const char* end;
+    pattern_guards((*it)->get_type(), begin, end);
+
+    if (begin)
+      fprintf(fp, "%s", begin);
 
     if (!(*it)->get_condition().empty())
       fprintf(fp, "  if (%s)\n  ", (*it)->get_condition().c_str());
 
-    fprintf(fp, "  analyzer->addPattern(new %s());\n",
-                (*it)->get_classname().c_str());
+    if (backend == BACKEND_FUSED && (*it)->has_fused_callbacks())
+      fprintf(fp, "  analyzer->addPattern(patterns.%s = new %s());\n",
+                  (*it)->get_fused_member().c_str(),
+                  (*it)->get_classname().c_str());
+    else
+      fprintf(fp, "  analyzer->addPattern(new %s());\n",
+                  (*it)->get_classname().c_str());
 
-    if (g->end)
-      fprintf(fp, "%s", g->end);
+    if (end)
+      fprintf(fp, "%s", end);
 
     ++it;
   }
+  if (backend == BACKEND_FUSED) {
+    fprintf(fp, "\n  // Register fused replay kernels\n");
+    vector<string> groups = fused_groups();
+    for (vector<string>::const_iterator git = groups.begin(); git != groups.end(); ++git) {
+      string begin;
+      string end;
+      fused_guards(*git, begin, end);
+
+      fprintf(fp, "%s  register_kernel(analyzer, \"%s\", new %s(patterns));\n%s",
+                  begin.c_str(), git->c_str(), fused_classname(*git).c_str(),
+                  end.c_str());
+    }
+  }
   fprintf(fp, "}\n\n\n");
 
   /* Close file */
@@ -671,6 +676,300 @@ void write_impl()
 }
 
 
+void pattern_guards(const string& type, const char*& begin, const char*& end)
+{
+  const struct guard {
+    const char *type, *begin, *end;
+  } guards[] = {
+    { "MPI",    
+      "#if defined(_MPI)\n", 
+      "#endif   /* _MPI */\n" 
+    },
+    { "MPIDEP", 
+      "#if defined(_MPI)\n", 
+      "#endif   /* _MPI */\n" 
+    },
+    { "MPI_RMA",
+      "#if defined(_MPI) && defined(HAS_MPI2_1SIDED)\n", 
+      "#endif   /* _MPI && HAS_MPI2_1SIDED */\n"
+    },
+    { "MPI_RMADEP",
+      "#if defined(_MPI) && defined(HAS_MPI2_1SIDED)\n", 
+      "#endif   /* _MPI && HAS_MPI2_1SIDED */\n"
+    },
+    { "OMP",
+      "#if defined(_OPENMP)\n",
+      "#endif   /* _OPENMP */\n"        
+    },
+    { "OMPDEP",
+      "#if defined(_OPENMP)\n",
+      "#endif   /* _OPENMP */\n"        
+    },
+    { "ARMCI",
+      "#if defined(HAS_ARMCI)\n",
+      "#endif   /* HAS_ARMCI */\n"
+    },
+    { "ARMCIDEP",
+      "#if defined(HAS_ARMCI)\n",
+      "#endif   /* HAS_ARMCI */\n"
+    },
+
+    { 0, 0, 0 }
+  };
+
+  const struct guard* g;
+
+  for (g = guards; g->type && type != g->type; ++g)
+    ;
+
+  begin = g->begin;
+  end   = g->end;
+}
+
+
+vector<string> fused_groups()
+{
+  vector<string> groups;
+
+  vector<Pattern*>::const_iterator it = pattern.begin();
+  while (it != pattern.end()) {
+    if ((*it)->has_fused_callbacks()) {
+      vector<string> pgroups = (*it)->get_callback_groups();
+      for (vector<string>::const_iterator git = pgroups.begin(); git != pgroups.end(); ++git) {
+        if (find(groups.begin(), groups.end(), *git) != groups.end())
+          continue;
+
+        // Only consider groups with at least one trace-event callback
+        const vector<string>& types = trace_event_types();
+        for (vector<string>::const_iterator tit = types.begin(); tit != types.end(); ++tit) {
+          if ((*it)->has_fused_callbacks(*git, *tit)) {
+            groups.push_back(*git);
+            break;
+          }
+        }
+      }
+    }
+    ++it;
+  }
+  sort(groups.begin(), groups.end());
+
+  return groups;
+}
+
+
+string fused_classname(const string& group)
+{
+  if (group.empty())
+    return "FusedKernel";
+
+  return "FusedKernel_" + group;
+}
+
+
+/* Determines the preprocessor guard of the fused kernel for the given
+   replay group, i.e., the disjunction of the guards of all patterns it
+   dispatches to.  Both strings are empty if one of them is unguarded. */
+void fused_guards(const string& group, string& begin, string& end)
+{
+  const vector<string>& types = trace_event_types();
+  vector<string>        conditions;
+
+  begin.clear();
+  end.clear();
+
+  vector<Pattern*>::const_iterator it = pattern.begin();
+  for ( ; it != pattern.end(); ++it) {
+    vector<string>::const_iterator tit = types.begin();
+    while (tit != types.end() && !(*it)->has_fused_callbacks(group, *tit))
+      ++tit;
+    if (tit == types.end())
+      continue;
+
+    const char* pbegin;
+    const char* pend;
+    pattern_guards((*it)->get_type(), pbegin, pend);
+    if (!pbegin)
+      return;
+
+    // Strip "#if " and the trailing newline
+    string condition(pbegin + 4, strlen(pbegin) - 5);
+    if (find(conditions.begin(), conditions.end(), condition) == conditions.end()) {
+      conditions.push_back(condition);
+      end = pend;
+    }
+  }
+
+  if (conditions.empty())
+    return;
+
+  if (conditions.size() == 1) {
+    begin = "#if " + conditions.front() + "\n";
+    return;
+  }
+
+  begin = "#if (" + conditions.front() + ")";
+  for (vector<string>::const_iterator cit = conditions.begin() + 1; cit != conditions.end(); ++cit)
+    begin += " || (" + *cit + ")";
+  begin += "\n";
+  end    = "#endif\n";
+}
+
+
+void write_fused_kernels(FILE* fp)
+{
+  const vector<string>& types  = trace_event_types();
+  const vector<string>  groups = fused_groups();
+
+  fprintf(fp, "//--- Fused replay kernels --------------------------------------------------\n"
+              "\n"
+              "namespace\n"
+              "{\n"
+              "\n");
+
+  /***** Pattern instances *****/
+
+  fprintf(fp, "/*\n"
+              " *---------------------------------------------------------------------------\n"
+              " *\n"
+              " * struct FusedPatterns\n"
+              " *\n"
+              " *---------------------------------------------------------------------------\n"
+              " */\n"
+              "\n\n"
+              "// Pattern instances dispatched by the fused kernels (NULL if disabled)\n"
+              "struct FusedPatterns\n"
+              "{\n");
+  vector<Pattern*>::const_iterator it = pattern.begin();
+  while (it != pattern.end()) {
+    if ((*it)->has_fused_callbacks()) {
+      const char* begin;
+      const char* end;
+      pattern_guards((*it)->get_type(), begin, end);
+
+      if (begin)
+        fprintf(fp, "%s", begin);
+      fprintf(fp, "  %s* %s;\n",
+                  (*it)->get_classname().c_str(),
+                  (*it)->get_fused_member().c_str());
+      if (end)
+        fprintf(fp, "%s", end);
+    }
+    ++it;
+  }
+  fprintf(fp, "};\n\n\n");
+
+  /***** One kernel class per replay *****/
+
+  for (vector<string>::const_iterator git = groups.begin(); git != groups.end(); ++git) {
+    string classname = fused_classname(*git);
+
+    // Kernels only dispatching to guarded patterns are guarded as well;
+    // otherwise, their arguments would be unused in some configurations
+    string kbegin;
+    string kend;
+    fused_guards(*git, kbegin, kend);
+
+    fprintf(fp, "%s", kbegin.c_str());
+    fprintf(fp, "/*\n"
+                " *---------------------------------------------------------------------------\n"
+                " *\n"
+                " * class %s\n"
+                " *\n"
+                " *---------------------------------------------------------------------------\n"
+                " */\n"
+                "\n\n", classname.c_str());
+    fprintf(fp, "class %s : public pearl::Callback\n"
+                "{\n"
+                "  public:\n"
+                "    %s(const FusedPatterns& patterns)\n"
+                "      : m_patterns(patterns)\n"
+                "    {}\n\n"
+                "    bool handles(event_t type) const;\n\n"
+                "    virtual void execute(const pearl::CallbackManager& cbmanager, int user_event,\n"
+                "                         const pearl::Event& event, CallbackData* cdata);\n\n\n"
+                "  private:\n"
+                "    FusedPatterns m_patterns;\n"
+                "};\n\n\n",
+                classname.c_str(), classname.c_str());
+
+    /* handles() */
+    fprintf(fp, "bool %s::handles(event_t type) const\n"
+                "{\n"
+                "  switch (type) {\n", classname.c_str());
+    for (vector<string>::const_iterator tit = types.begin(); tit != types.end(); ++tit) {
+      bool found = false;
+      for (it = pattern.begin(); it != pattern.end(); ++it) {
+        if (!(*it)->has_fused_callbacks(*git, *tit))
+          continue;
+
+        if (!found)
+          fprintf(fp, "    case %s:\n", tit->c_str());
+        found = true;
+
+        const char* begin;
+        const char* end;
+        pattern_guards((*it)->get_type(), begin, end);
+
+        if (begin)
+          fprintf(fp, "%s", begin);
+        fprintf(fp, "      if (m_patterns.%s)\n"
+                    "        return true;\n",
+                    (*it)->get_fused_member().c_str());
+        if (end)
+          fprintf(fp, "%s", end);
+      }
+      if (found)
+        fprintf(fp, "      return false;\n\n");
+    }
+    fprintf(fp, "    default:\n"
+                "      return false;\n"
+                "  }\n"
+                "}\n\n\n");
+
+    /* execute() */
+    fprintf(fp, "void %s::execute(const pearl::CallbackManager& cbmanager, int user_event,\n"
+                "    const pearl::Event& event, CallbackData* cdata)\n"
+                "{\n"
+                "  switch (event->getType()) {\n", classname.c_str());
+    for (vector<string>::const_iterator tit = types.begin(); tit != types.end(); ++tit) {
+      bool found = false;
+      for (it = pattern.begin(); it != pattern.end(); ++it) {
+        if (!(*it)->has_fused_callbacks(*git, *tit))
+          continue;
+
+        if (!found)
+          fprintf(fp, "    case %s:\n", tit->c_str());
+        found = true;
+
+        (*it)->write_fused_calls(fp, *git, *tit);
+      }
+      if (found)
+        fprintf(fp, "      break;\n\n");
+    }
+    fprintf(fp, "    default:\n"
+                "      break;\n"
+                "  }\n"
+                "}\n");
+    fprintf(fp, "%s\n\n", kend.c_str());
+  }
+
+  /***** Registration helper *****/
+
+  fprintf(fp, "template<class KernelT>\n"
+              "void register_kernel(AnalyzeTask* analyzer, const string& replay, KernelT* kernel)\n"
+              "{\n"
+              "  CallbackPtr callback(kernel);\n"
+              "\n"
+              "  for (int type = 0; type < GROUP_ALL; ++type)\n"
+              "    if (kernel->handles(event_t(type)))\n"
+              "      analyzer->addCallback(replay, event_t(type), callback);\n"
+              "}\n"
+              "\n"
+              "}   // unnamed namespace\n"
+              "\n\n");
+}
+
+
 void write_html()
 {
   /* Open documentation file */
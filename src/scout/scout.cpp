@@ -44,16 +44,20 @@
 
 #include "AnalyzeTask.h"
 #include "CheckedTask.h"
+#include "CheckpointTask.h"
 #include "Logging.h"
 #include "OpenArchiveTask.h"
 #include "PreprocessTask.h"
 #include "ReadDefinitionsTask.h"
 #include "ReadTraceTask.h"
 #include "ReportWriterTask.h"
+#include "SelfProfile.h"
 #include "StatisticsTask.h"
 #include "TaskData.h"
 #include "TimedPhase.h"
 #include "Timer.h"
+#include "TraceCacheTask.h"
+#include "WindowTask.h"
 #include "scout_types.h"
 
 using namespace std;
@@ -84,6 +88,12 @@ int rank = 0;
 
   /// Flag indicating whether MPI has been finalized
   bool finalized = false;
+
+  #if defined(_OPENMP)
+    /// Flag indicating whether MPI has been initialized with the level of
+    /// thread support required by the thread-multiple replay
+    bool threadMultipleSupported = false;
+  #endif   // _OPENMP
 #endif   // _MPI
 
 }   // unnamed namespace
@@ -110,6 +120,32 @@ bool enableAsynchronous = false;
 /// Flag indicating whether only a single-pass replay should be used
 bool enableSinglePass = false;
 
+/// Flag indicating whether only the profile metrics should be computed
+/// without a trace replay
+bool enableProfileOnly = false;
+
+/// Flag indicating whether preprocessed trace data should be cached
+bool enableTraceCache = false;
+
+/// Flag indicating whether checkpoints should be written
+bool enableCheckpoint = false;
+
+/// Flag indicating whether the analysis should be resumed from a checkpoint
+bool enableResume = false;
+
+/// Flag indicating whether the analyzer should profile itself
+bool enableSelfProfile = false;
+
+/// Flag indicating whether the analysis should be restricted to a window
+bool enableWindow = false;
+
+/// Flag indicating whether MPI communication should be replayed by all
+/// threads instead of the master thread only
+bool enableThreadMultiple = false;
+
+/// Analysis window specification
+AnalysisWindow analysisWindow;
+
 //--- Function prototypes ---------------------------------------------------
 
 //----- Generic functions -----
@@ -126,6 +162,9 @@ void ReadDefinitions(TaskDataShared& sharedData);
 void SetupPhases(CompoundTask&    scout,
                  TaskDataShared&  sharedData,
                  TaskDataPrivate& privateData);
+void AddTimedPhase(CompoundTask&          scout,
+                   TimedPhase*            phase,
+                   const TaskDataPrivate& privateData);
 void Analyze();
 
 
@@ -278,11 +317,39 @@ void ProcessArguments(int argc, char** argv)
       enableDelayAnalysis = true;
     } else if ("--no-rootcause" == arg) {
       enableDelayAnalysis = false;
+    } else if ("--trace-cache" == arg) {
+      enableTraceCache = true;
+    } else if ("--no-trace-cache" == arg) {
+      enableTraceCache = false;
+    } else if ("--checkpoint" == arg) {
+      enableCheckpoint = true;
+    } else if ("--resume" == arg) {
+      enableResume = true;
+    } else if ("--self-profile" == arg) {
+      enableSelfProfile = true;
     } else if ("--single-pass" == arg) {
       enableSinglePass = true;
       LogMsg(0, "Using single-pass replay.\n"
                 "   Critical-path and root-cause analysis will be disabled.\n"
                 "   Late-receiver wait states can not be detected.\n\n");
+    } else if ("--profile-only" == arg) {
+      enableProfileOnly = true;
+      LogMsg(0, "Computing profile metrics only.\n"
+                "   Wait-state, critical-path and root-cause analysis as well as\n"
+                "   statistics will be disabled.\n\n");
+    } else if (0 == arg.compare(0, 9, "--window=")) {
+      if (!ParseTimeWindow(arg.substr(9), analysisWindow)) {
+        LogMsg(0, "Invalid time window '%s'.\n\n", arg.substr(9).c_str());
+        Usage(argv[0]);
+      }
+      enableWindow = true;
+    } else if (0 == arg.compare(0, 18, "--region-instance=")) {
+      if (!ParseRegionInstances(arg.substr(18), analysisWindow)) {
+        LogMsg(0, "Invalid region instance range '%s'.\n\n",
+               arg.substr(18).c_str());
+        Usage(argv[0]);
+      }
+      enableWindow = true;
     }
 
     // MPI-specific options
@@ -291,6 +358,20 @@ void ProcessArguments(int argc, char** argv)
       synchronize = true;
     } else if ("--no-time-correct" == arg) {
       synchronize = false;
+    } else if ("--thread-multiple" == arg) {
+      #if defined(_OPENMP)
+        if (threadMultipleSupported) {
+          enableThreadMultiple = true;
+        } else {
+          LogMsg(0, "Ignoring command-line option '%s':\n"
+                    "    MPI thread mode 'multiple' not available.\n\n",
+                 arg.c_str());
+        }
+      #else   // !_OPENMP
+        LogMsg(0, "Ignoring command-line option '%s':\n"
+                  "    only applicable to hybrid MPI/OpenMP analyses.\n\n",
+               arg.c_str());
+      #endif   // !_OPENMP
     }
 #endif   // _MPI
 
@@ -303,6 +384,13 @@ void ProcessArguments(int argc, char** argv)
           ++index;
           continue;
         }
+        if ("--thread-multiple" == arg) {
+          LogMsg(0, "Ignoring command-line option '%s':\n"
+                    "    only applicable to hybrid MPI/OpenMP analyses.\n\n",
+                 arg.c_str());
+          ++index;
+          continue;
+        }
       #endif   // !_MPI
 
       if (argc - index != 1) {
@@ -320,6 +408,30 @@ void ProcessArguments(int argc, char** argv)
     enableDelayAnalysis = false;
   }
 
+  // Disable everything requiring a replay if only the profile is requested
+  if (enableProfileOnly) {
+    enableCriticalPath  = false;
+    enableDelayAnalysis = false;
+    enableStatistics    = false;
+  }
+
+  // Timestamp correction and root-cause analysis assume MPI communication
+  // on master threads only
+  #if defined(_MPI)
+    if (enableThreadMultiple && (synchronize || enableDelayAnalysis)) {
+      LogMsg(0, "Using thread-multiple replay.\n"
+                "   Timestamp correction and root-cause analysis will be disabled.\n\n");
+      synchronize         = false;
+      enableDelayAnalysis = false;
+    }
+  #endif   // _MPI
+
+  // Checkpoints extend the trace cache by the analysis results
+  if (enableResume)
+    enableCheckpoint = true;
+  if (enableCheckpoint)
+    enableTraceCache = true;
+
   // Treat first remaining argument as experiment archive name
   anchorName = argv[index - 1];
 }
@@ -350,9 +462,25 @@ void Usage(const char* command)
             "  --rootcause        Enables root-cause analysis [default]\n"
             "  --no-rootcause     Disables root-cause analysis\n"
             "  --single-pass      Single-pass forward analysis only\n"
+            "  --profile-only     Computes profile metrics without trace replay\n"
+            "  --trace-cache      Reuses/stores preprocessed trace data in a cache\n"
+            "  --no-trace-cache   Disables the preprocessed trace cache [default]\n"
+            "  --checkpoint       Stores trace data and analysis results in checkpoints\n"
+            "                     (implies --trace-cache)\n"
+            "  --resume           Resumes from the last valid checkpoint\n"
+            "                     (implies --checkpoint)\n"
+            "  --self-profile     Writes a profile of the analysis itself\n"
+            "  --window=<t0>:<t1> Analyzes the given time interval [s] only\n"
+            "                     (the complete trace is still read)\n"
+            "  --region-instance=<region>:<n0>[-<n1>]\n"
+            "                     Analyzes the given region instances only\n"
+            "                     (the complete trace is still read)\n"
   #if defined(_MPI)
             "  --time-correct     Enables enhanced timestamp correction\n"
             "  --no-time-correct  Disables enhanced timestamp correction [default]\n"
+    #if defined(_OPENMP)
+            "  --thread-multiple  Replays MPI communication on all threads\n"
+    #endif   // _OPENMP
   #endif   // _MPI
             "  --verbose, -v      Increase verbosity\n"
             "  --help             Display this information and exit\n\n",
@@ -399,6 +527,9 @@ void ReadDefinitions(TaskDataShared& sharedData)
     exit(EXIT_FAILURE);
   }
 
+  // Keep only one copy of the process group member lists per node
+  PEARL_share_defs(*sharedData.mDefinitions);
+
   anchorName       = sharedData.mArchive->getAnchorName();
   archiveDirectory = sharedData.mArchive->getArchiveDirectory();
 }
@@ -418,45 +549,170 @@ void SetupPhases(CompoundTask&    scout,
                  TaskDataShared&  sharedData,
                  TaskDataPrivate& privateData)
 {
-  TimedPhase*    phase;
-  ReadTraceTask* reader;
-  phase  = new TimedPhase("Reading event trace data  ");
-  reader = new ReadTraceTask(sharedData, privateData);
-  phase->add_task(reader);
-  scout.add_task(phase);
-
-  PreprocessTask* prep;
-  phase = new TimedPhase("Preprocessing             ");
-  prep  = new PreprocessTask(sharedData, privateData);
-  phase->add_task(prep);
-  scout.add_task(phase);
+  TimedPhase* phase;
+
+  if (enableSelfProfile)
+    privateData.mSelfProfile = new SelfProfile;
+
+  // Check whether preprocessed trace data of a previous run can be reused
+  const string cacheDirectory = archiveDirectory + "/scout.cache";
+  uint64_t     cacheStamp     = 0;
+  bool         useCache       = false;
+  if (enableTraceCache) {
+    #if defined(_MPI)
+      cacheStamp = GetTraceCacheStamp(sharedData, synchronize);
+    #else   // !_MPI
+      cacheStamp = GetTraceCacheStamp(sharedData, false);
+    #endif   // !_MPI
+    useCache = !CheckGlobalError(
+                  !CheckTraceCache(sharedData, cacheDirectory, cacheStamp),
+                  "No valid trace cache found, reading trace data.");
+  }
 
   SynchronizeTask* synchronizer = NULL;
-  #if defined(_MPI)
-    if (synchronize) {
-      phase = new TimedPhase("Timestamp correction      ");
-      synchronizer = new SynchronizeTask(privateData);
-      phase->add_task(CheckedTask::make_checked(synchronizer));
-      scout.add_task(phase);
+  if (useCache) {
+    ReadCacheTask* loader;
+    phase  = new TimedPhase("Reading trace cache       ");
+    loader = new ReadCacheTask(sharedData, privateData, cacheDirectory);
+    phase->add_task(CheckedTask::make_checked(loader));
+    #if defined(_OPENMP)
+      // The OpenMP consistency requirements are not covered by the cache
+      // stamp, thus re-check them on the cached trace data
+      phase->add_task(CheckedTask::make_checked(
+                        new CheckTraceData(privateData)));
+    #endif   // _OPENMP
+    #if defined(_MPI)
+      phase->add_task(new CreateCommsTask(sharedData, privateData));
+    #endif   // _MPI
+    AddTimedPhase(scout, phase, privateData);
+  } else {
+    ReadTraceTask* reader;
+    phase  = new TimedPhase("Reading event trace data  ");
+    reader = new ReadTraceTask(sharedData, privateData);
+    phase->add_task(reader);
+    AddTimedPhase(scout, phase, privateData);
+
+    PreprocessTask* prep;
+    phase = new TimedPhase("Preprocessing             ");
+    prep  = new PreprocessTask(sharedData, privateData);
+    phase->add_task(prep);
+    AddTimedPhase(scout, phase, privateData);
+
+    #if defined(_MPI)
+      if (synchronize) {
+        phase = new TimedPhase("Timestamp correction      ");
+        synchronizer = new SynchronizeTask(privateData);
+        phase->add_task(CheckedTask::make_checked(synchronizer));
+        AddTimedPhase(scout, phase, privateData);
+      }
+    #endif
+
+    if (enableTraceCache) {
+      WriteCacheTask* cache;
+      phase = new TimedPhase("Writing trace cache       ");
+      cache = new WriteCacheTask(sharedData, privateData, cacheDirectory,
+                                 cacheStamp);
+      phase->add_task(cache);
+      AddTimedPhase(scout, phase, privateData);
     }
-  #endif
+  }
+
+  if (enableWindow) {
+    WindowTask* window;
+    phase  = new TimedPhase("Applying analysis window  ");
+    window = new WindowTask(sharedData, privateData, analysisWindow);
+    phase->add_task(CheckedTask::make_checked(window));
+    AddTimedPhase(scout, phase, privateData);
+  }
+
+  // Check whether the analysis results of a previous run can be reused
+  const string checkpointDirectory = archiveDirectory + "/scout.checkpoint";
+  uint64_t     checkpointStamp     = 0;
+  bool         useCheckpoint       = false;
+  if (enableCheckpoint) {
+    ostringstream settings;
+    settings.precision(17);
+    settings << enableStatistics << enableCriticalPath << enableDelayAnalysis
+             << enableAsynchronous << enableSinglePass << enableProfileOnly;
+    if (enableWindow)
+      settings << ':' << analysisWindow.mBegin
+               << ':' << analysisWindow.mEnd
+               << ':' << analysisWindow.mRegion
+               << ':' << analysisWindow.mFirstInstance
+               << ':' << analysisWindow.mLastInstance;
+    checkpointStamp = GetCheckpointStamp(cacheStamp, settings.str());
+    if (enableResume && useCache)
+      useCheckpoint = !CheckGlobalError(
+                         !CheckCheckpoint(sharedData, checkpointDirectory,
+                                          checkpointStamp),
+                         "No valid analysis checkpoint found, analyzing trace data.");
+  }
+
+  StatisticsTask* stats;
+  stats = new StatisticsTask(privateData, synchronizer);
 
   AnalyzeTask* analyzer;
-  phase    = new TimedPhase("Analyzing trace data      ");
   analyzer = new AnalyzeTask(sharedData, privateData);
-  phase->add_task(analyzer);
-  scout.add_task(phase);
+  analyzer->register_statistics_cbs(stats);
+  if (useCheckpoint) {
+    ReadCheckpointTask* restore;
+    phase   = new TimedPhase("Reading checkpoint        ");
+    restore = new ReadCheckpointTask(privateData, *analyzer,
+                                     checkpointDirectory, checkpointStamp);
+    analyzer->skipReplay();
+    phase->add_task(analyzer);
+    phase->add_task(CheckedTask::make_checked(restore));
+    AddTimedPhase(scout, phase, privateData);
+  } else {
+    phase = new TimedPhase("Analyzing trace data      ");
+    phase->add_task(analyzer);
+    AddTimedPhase(scout, phase, privateData);
+
+    if (enableCheckpoint) {
+      WriteCheckpointTask* checkpoint;
+      phase      = new TimedPhase("Writing checkpoint        ");
+      checkpoint = new WriteCheckpointTask(privateData, *analyzer,
+                                           checkpointDirectory,
+                                           checkpointStamp);
+      phase->add_task(checkpoint);
+      AddTimedPhase(scout, phase, privateData);
+    }
+  }
 
   ReportWriterTask* writer;
   phase  = new TimedPhase("Writing analysis report   ");
   writer = new ReportWriterTask(sharedData, analyzer, archiveDirectory, rank);
   phase->add_task(CheckedTask::make_checked(writer));
-  scout.add_task(phase);
+  AddTimedPhase(scout, phase, privateData);
 
-  StatisticsTask* stats;
-  stats = new StatisticsTask(privateData, synchronizer);
-  analyzer->register_statistics_cbs(stats);
   scout.add_task(stats);
+
+  if (enableSelfProfile) {
+    SelfProfileTask* profile;
+    profile = new SelfProfileTask(privateData,
+                                  archiveDirectory + "/scout.selfprofile.json");
+    scout.add_task(profile);
+  }
+}
+
+
+/**
+ *  @brief Adds a timed phase.
+ *
+ *  Adds the given timed @p phase to the compound task @p scout. If
+ *  self-profiling is enabled, the phase duration is recorded in the self
+ *  profile of the calling thread.
+ *
+ *  @param  scout        Compound task to be extended
+ *  @param  phase        Timed phase to be added
+ *  @param  privateData  Private task data object
+ **/
+void AddTimedPhase(CompoundTask&          scout,
+                   TimedPhase*            phase,
+                   const TaskDataPrivate& privateData)
+{
+  phase->set_profile(privateData.mSelfProfile);
+  scout.add_task(phase);
 }
 
 
@@ -546,6 +802,12 @@ void InitializeMPI(int* argc, char*** argv)
     int provided;
     #if defined(_OPENMP)
       required = MPI_THREAD_FUNNELED;
+
+      // The thread-multiple replay has to be detected before the regular
+      // processing of the command line, as it requires a higher level
+      for (int index = 1; index < *argc; ++index)
+        if (string((*argv)[index]) == "--thread-multiple")
+          required = MPI_THREAD_MULTIPLE;
     #else
       required = MPI_THREAD_SINGLE;
     #endif   // _OPENMP
@@ -569,7 +831,10 @@ void InitializeMPI(int* argc, char*** argv)
   #if defined(HAVE_DECL_MPI_INIT_THREAD)
 
     // Verify thread level
-    if (provided < required) {
+    #if defined(_OPENMP)
+      threadMultipleSupported = (provided >= MPI_THREAD_MULTIPLE);
+    #endif   // _OPENMP
+    if (provided < required && provided < MPI_THREAD_FUNNELED) {
       LogMsg(0, "MPI thread mode 'funneled' not supported!\n");
       LogMsg(0, "Continuing with analysis, but you might experience problems.\n\n");
     }
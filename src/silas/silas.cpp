@@ -414,10 +414,11 @@ void preprocess_trace(GlobalDefs& defs, LocalTrace& trace)
     }
     global_error(error, message);
 
-    // Unify call trees & check for errors
+    // Unify call trees, create MPI communicators & check for errors
     try 
     {
         PEARL_mpi_unify_calltree(defs);
+        PEARL_mpi_create_comms(defs);
     }
     catch (const exception& ex) 
     {
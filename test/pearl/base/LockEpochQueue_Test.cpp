@@ -0,0 +1,122 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+#include "LockEpochQueue.h"
+
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace testing;
+using namespace pearl;
+using namespace scout;
+
+
+//--- Helper functions ------------------------------------------------------
+
+namespace
+{
+void
+pushEpoch(LockEpochQueue& queue,
+          timestamp_t     lockTime,
+          timestamp_t     unlockTime,
+          bool            exclusive = true)
+{
+    LockEpoch epoch;
+    epoch.mLockTime   = lockTime;
+    epoch.mUnlockTime = unlockTime;
+    epoch.mExclusive  = exclusive;
+    queue.push(epoch);
+}
+}   // unnamed namespace
+
+
+//--- LockEpochQueue tests --------------------------------------------------
+
+TEST(LockEpochQueueT, testEmpty)
+{
+    LockEpochQueue queue;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(0u, queue.size());
+}
+
+
+TEST(LockEpochQueueT, testOrderedByUnlockTime)
+{
+    LockEpochQueue queue;
+
+    // Almost-ordered and out-of-order arrival
+    pushEpoch(queue, 1.0, 2.0);
+    pushEpoch(queue, 2.5, 4.0);
+    pushEpoch(queue, 0.5, 3.0);
+    pushEpoch(queue, 4.5, 5.0);
+    pushEpoch(queue, 0.0, 1.0);
+    EXPECT_FALSE(queue.empty());
+    ASSERT_EQ(5u, queue.size());
+
+    // top() refers to the latest unlock
+    const timestamp_t expected[] = { 5.0, 4.0, 3.0, 2.0, 1.0 };
+    for (size_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(expected[i], queue.top().mUnlockTime);
+        queue.pop();
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+
+TEST(LockEpochQueueT, testEqualUnlockTimes)
+{
+    LockEpochQueue queue;
+
+    // Epochs with equal unlock times keep their insertion order, i.e.,
+    // the one inserted last is on top
+    pushEpoch(queue, 1.0, 3.0);
+    pushEpoch(queue, 2.0, 3.0);
+    pushEpoch(queue, 0.0, 2.0);
+    pushEpoch(queue, 1.5, 3.0);
+
+    EXPECT_EQ(1.5, queue.top().mLockTime);
+    queue.pop();
+    EXPECT_EQ(2.0, queue.top().mLockTime);
+    queue.pop();
+    EXPECT_EQ(1.0, queue.top().mLockTime);
+    queue.pop();
+    EXPECT_EQ(0.0, queue.top().mLockTime);
+}
+
+
+TEST(LockEpochQueueT, testPopIntoEpoch)
+{
+    LockEpochQueue queue;
+
+    pushEpoch(queue, 1.0, 2.0, false);
+    pushEpoch(queue, 2.0, 3.0, true);
+
+    LockEpoch epoch;
+    queue.pop(epoch);
+    EXPECT_EQ(2.0, epoch.mLockTime);
+    EXPECT_EQ(3.0, epoch.mUnlockTime);
+    EXPECT_TRUE(epoch.mExclusive);
+    ASSERT_EQ(1u, queue.size());
+
+    // Popped epochs can be re-inserted
+    queue.push(epoch);
+    EXPECT_EQ(2u, queue.size());
+    EXPECT_EQ(3.0, queue.top().mUnlockTime);
+
+    queue.pop(epoch);
+    queue.pop(epoch);
+    EXPECT_EQ(1.0, epoch.mLockTime);
+    EXPECT_FALSE(epoch.mExclusive);
+    EXPECT_TRUE(queue.empty());
+}
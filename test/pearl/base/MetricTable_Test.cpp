@@ -0,0 +1,226 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+#include <pearl/MetricTable.h>
+
+#include <vector>
+
+#include <pearl/Buffer.h>
+#include <pearl/Error.h>
+
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace testing;
+using namespace pearl;
+
+
+//--- Helper functions ------------------------------------------------------
+
+namespace
+{
+/// Number of rows used by the tests, spanning multiple blocks of rows
+const uint32_t NUM_ROWS = 200;
+
+
+/// Event position of the given row (every third event has metric values)
+uint32_t
+positionOf(uint32_t row)
+{
+    return 3 * row + 1;
+}
+
+
+/// Values of the given row: an increasing counter, a counter with
+/// decreasing values, and a counter wrapping around
+void
+valuesOf(uint32_t  row,
+         uint64_t* values)
+{
+    values[0] = 1000 + 17 * static_cast<uint64_t>(row);
+    values[1] = 1000000 - 5 * static_cast<uint64_t>(row * row);
+    values[2] = (row % 2) ? 3 : static_cast<uint64_t>(-2);
+}
+
+
+void
+fillTable(MetricTable& table)
+{
+    uint64_t values[3];
+    for (uint32_t row = 0; row < NUM_ROWS; ++row) {
+        valuesOf(row, values);
+        table.append(positionOf(row), values);
+    }
+}
+
+
+void
+checkTable(const MetricTable& table)
+{
+    ASSERT_EQ(3u, table.numMetrics());
+    ASSERT_EQ(NUM_ROWS, table.numRows());
+
+    // Sequential access
+    MetricTable::Cursor cursor(table);
+    uint64_t            expected[3];
+    for (uint32_t row = 0; row < NUM_ROWS; ++row) {
+        ASSERT_TRUE(cursor.next());
+        valuesOf(row, expected);
+        EXPECT_EQ(positionOf(row), cursor.getPosition());
+        EXPECT_EQ(expected[0], cursor.getValue(0));
+        EXPECT_EQ(expected[1], cursor.getValue(1));
+        EXPECT_EQ(expected[2], cursor.getValues()[2]);
+    }
+    EXPECT_FALSE(cursor.next());
+
+    // Random access
+    uint64_t values[3];
+    for (uint32_t row = 0; row < NUM_ROWS; ++row) {
+        valuesOf(row, expected);
+        ASSERT_TRUE(table.getValues(positionOf(row), values));
+        EXPECT_EQ(expected[0], values[0]);
+        EXPECT_EQ(expected[1], values[1]);
+        EXPECT_EQ(expected[2], values[2]);
+    }
+}
+}   // unnamed namespace
+
+
+//--- MetricTable tests -----------------------------------------------------
+
+TEST(MetricTableT, testEmpty)
+{
+    MetricTable table(2);
+
+    EXPECT_EQ(2u, table.numMetrics());
+    EXPECT_EQ(0u, table.numRows());
+
+    uint64_t values[2];
+    EXPECT_FALSE(table.getValues(0, values));
+
+    MetricTable::Cursor cursor(table);
+    EXPECT_FALSE(cursor.next());
+}
+
+
+TEST(MetricTableT, testRoundTrip)
+{
+    MetricTable table(3);
+    fillTable(table);
+
+    checkTable(table);
+}
+
+
+TEST(MetricTableT, testNegativeDeltas)
+{
+    MetricTable table(1);
+
+    // Decreasing values and differences exceeding the signed 64-bit range
+    const uint64_t values[] = { 100, 99, 0, static_cast<uint64_t>(-1), 0,
+                                static_cast<uint64_t>(1) << 63, 1 };
+    const uint32_t count    = sizeof(values) / sizeof(values[0]);
+    for (uint32_t row = 0; row < count; ++row) {
+        table.append(row, &values[row]);
+    }
+
+    MetricTable::Cursor cursor(table);
+    for (uint32_t row = 0; row < count; ++row) {
+        ASSERT_TRUE(cursor.next());
+        EXPECT_EQ(values[row], cursor.getValue(0));
+    }
+}
+
+
+TEST(MetricTableT, testBlockBoundaries)
+{
+    MetricTable table(3);
+    fillTable(table);
+
+    // Positions without values, including the gaps next to the first and
+    // last rows of each block
+    uint64_t values[3];
+    EXPECT_FALSE(table.getValues(0, values));
+    for (uint32_t row = 0; row < NUM_ROWS; ++row) {
+        EXPECT_FALSE(table.getValues(positionOf(row) - 1, values));
+        EXPECT_FALSE(table.getValues(positionOf(row) + 1, values));
+    }
+    EXPECT_FALSE(table.getValues(positionOf(NUM_ROWS), values));
+
+    // Rows have to be appended in increasing order
+    valuesOf(NUM_ROWS, values);
+    EXPECT_THROW(table.append(positionOf(NUM_ROWS - 1), values), FatalError);
+    EXPECT_EQ(NUM_ROWS, table.numRows());
+}
+
+
+TEST(MetricTableT, testRemap)
+{
+    MetricTable table(3);
+    fillTable(table);
+
+    // Simulate the insertion of two events in front of each row with
+    // values, and the removal of every tenth row
+    vector<uint32_t> oldPositions;
+    vector<uint32_t> newPositions;
+    for (uint32_t row = 0; row < NUM_ROWS; ++row) {
+        if (row % 10 != 9) {
+            oldPositions.push_back(positionOf(row));
+            newPositions.push_back(positionOf(row) + 2 * (row + 1));
+        }
+    }
+    table.remap(oldPositions, newPositions);
+    EXPECT_EQ(oldPositions.size(), table.numRows());
+
+    uint64_t expected[3];
+    uint64_t values[3];
+    for (uint32_t row = 0; row < NUM_ROWS; ++row) {
+        const bool found = table.getValues(positionOf(row) + 2 * (row + 1),
+                                           values);
+        if (row % 10 == 9) {
+            EXPECT_FALSE(found);
+        } else {
+            ASSERT_TRUE(found);
+            valuesOf(row, expected);
+            EXPECT_EQ(expected[0], values[0]);
+            EXPECT_EQ(expected[1], values[1]);
+            EXPECT_EQ(expected[2], values[2]);
+        }
+    }
+}
+
+
+TEST(MetricTableT, testSerialization)
+{
+    MetricTable table(3);
+    fillTable(table);
+
+    Buffer buffer;
+    table.pack(buffer);
+    buffer.put_uint32(42);
+
+    MetricTable copy(buffer);
+    EXPECT_EQ(42u, buffer.get_uint32());
+    checkTable(copy);
+
+    // Appending to a restored table continues the encoding
+    uint64_t values[3] = { 7, 8, 9 };
+    copy.append(positionOf(NUM_ROWS), values);
+    EXPECT_EQ(NUM_ROWS + 1, copy.numRows());
+
+    uint64_t result[3];
+    ASSERT_TRUE(copy.getValues(positionOf(NUM_ROWS), result));
+    EXPECT_EQ(7u, result[0]);
+    EXPECT_EQ(8u, result[1]);
+    EXPECT_EQ(9u, result[2]);
+}
@@ -0,0 +1,123 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+#include <pearl/ProcessGroup.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pearl/Error.h>
+#include <pearl/String.h>
+
+using namespace std;
+using namespace testing;
+using namespace pearl;
+
+
+//--- Helper functions ------------------------------------------------------
+
+namespace
+{
+// Verifies that the local/global rank translation of the given process
+// group is consistent with the rank list @a ranks.
+void
+checkRanks(const ProcessGroup& group,
+           const vector<int>&  ranks)
+{
+    ASSERT_EQ(ranks.size(), group.numRanks());
+    for (size_t i = 0; i < ranks.size(); ++i) {
+        EXPECT_EQ(ranks[i], group.getGlobalRank(i));
+        EXPECT_EQ(static_cast<int>(i), group.getLocalRank(ranks[i]));
+    }
+    EXPECT_THROW(group.getGlobalRank(ranks.size()), RuntimeError);
+}
+}   // unnamed namespace
+
+
+//--- ProcessGroup tests ----------------------------------------------------
+
+TEST(ProcessGroupT, testWorld)
+{
+    vector<int> ranks;
+    for (int i = 0; i < 100; ++i) {
+        ranks.push_back(i);
+    }
+    ProcessGroup group(0, String::UNDEFINED, ranks, false, true);
+
+    checkRanks(group, ranks);
+    EXPECT_THROW(group.getLocalRank(100), RuntimeError);
+    EXPECT_THROW(group.getLocalRank(-1), RuntimeError);
+}
+
+
+TEST(ProcessGroupT, testStrided)
+{
+    vector<int> ranks;
+    for (int i = 90; i >= 0; i -= 3) {
+        ranks.push_back(i);
+    }
+    ProcessGroup group(0, String::UNDEFINED, ranks, false, false);
+
+    checkRanks(group, ranks);
+    EXPECT_THROW(group.getLocalRank(1), RuntimeError);
+    EXPECT_THROW(group.getLocalRank(-3), RuntimeError);
+    EXPECT_THROW(group.getLocalRank(93), RuntimeError);
+}
+
+
+TEST(ProcessGroupT, testBitmap)
+{
+    vector<int> ranks;
+    for (int i = 5; i < 300; ++i) {
+        if ((i % 7) && (i % 11)) {
+            ranks.push_back(i);
+        }
+    }
+    ProcessGroup group(0, String::UNDEFINED, ranks, false, false);
+
+    checkRanks(group, ranks);
+    EXPECT_THROW(group.getLocalRank(4), RuntimeError);
+    EXPECT_THROW(group.getLocalRank(7), RuntimeError);
+    EXPECT_THROW(group.getLocalRank(300), RuntimeError);
+}
+
+
+TEST(ProcessGroupT, testSorted)
+{
+    vector<int> ranks;
+    ranks.push_back(1);
+    ranks.push_back(1000);
+    ranks.push_back(100000);
+    ProcessGroup group(0, String::UNDEFINED, ranks, false, false);
+
+    checkRanks(group, ranks);
+    EXPECT_THROW(group.getLocalRank(0), RuntimeError);
+    EXPECT_THROW(group.getLocalRank(999), RuntimeError);
+    EXPECT_THROW(group.getLocalRank(100001), RuntimeError);
+}
+
+
+TEST(ProcessGroupT, testUnordered)
+{
+    vector<int> ranks;
+    ranks.push_back(7);
+    ranks.push_back(3);
+    ranks.push_back(12);
+    ranks.push_back(0);
+    ProcessGroup group(0, String::UNDEFINED, ranks, false, false);
+
+    checkRanks(group, ranks);
+    EXPECT_THROW(group.getLocalRank(1), RuntimeError);
+    EXPECT_THROW(group.getLocalRank(13), RuntimeError);
+}
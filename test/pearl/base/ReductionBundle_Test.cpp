@@ -0,0 +1,70 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+#include <pearl/ReductionBundle.h>
+
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace testing;
+using namespace pearl;
+
+
+//--- ReductionBundle tests -------------------------------------------------
+
+TEST(ReductionBundleT, testEmpty)
+{
+    ReductionBundle bundle;
+
+    EXPECT_EQ(0u, bundle.size());
+    bundle.flush();
+    EXPECT_EQ(0u, bundle.size());
+}
+
+
+TEST(ReductionBundleT, testSingleProcess)
+{
+    ReductionBundle bundle;
+
+    const uint32_t sum    = bundle.add(ReductionBundle::SUM, 1.5);
+    const uint32_t maxloc = bundle.add(ReductionBundle::MAXLOC, 2.5, 42);
+    EXPECT_EQ(0u, sum);
+    EXPECT_EQ(1u, maxloc);
+    EXPECT_EQ(2u, bundle.size());
+
+    // Single (serial) process => results equal local contributions
+    bundle.flush();
+    EXPECT_EQ(1.5, bundle.getValue(sum));
+    EXPECT_EQ(2.5, bundle.getValue(maxloc));
+    EXPECT_EQ(42u, bundle.getLocation(maxloc));
+}
+
+
+TEST(ReductionBundleT, testPhases)
+{
+    ReductionBundle bundle;
+
+    const uint32_t min = bundle.add(ReductionBundle::MIN, -1.0);
+    bundle.flush();
+
+    // Values added after a flush are reduced by the next one
+    const uint32_t sum = bundle.add(ReductionBundle::SUM, bundle.getValue(min));
+    EXPECT_EQ(1u, sum);
+    bundle.flush();
+    EXPECT_EQ(-1.0, bundle.getValue(min));
+    EXPECT_EQ(-1.0, bundle.getValue(sum));
+
+    bundle.clear();
+    EXPECT_EQ(0u, bundle.size());
+    EXPECT_EQ(0u, bundle.add(ReductionBundle::MAX, 3.0));
+}
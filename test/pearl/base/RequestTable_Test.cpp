@@ -0,0 +1,180 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+#include "RequestTable.h"
+
+#include <pearl/Event_rep.h>
+
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace testing;
+using namespace pearl;
+using namespace pearl::detail;
+
+
+//--- Helper classes --------------------------------------------------------
+
+namespace
+{
+/// Minimal event representation recording the request offsets set by
+/// the RequestTable
+class TestEvent_rep
+    : public Event_rep
+{
+    public:
+        TestEvent_rep(event_t  type,
+                      uint64_t requestId)
+            : Event_rep(0.0),
+              mType(type),
+              mRequestId(requestId),
+              mPrevOffset(0),
+              mNextOffset(0)
+        {
+        }
+
+        event_t
+        getType() const
+        {
+            return mType;
+        }
+
+        bool
+        isOfType(event_t type) const
+        {
+            return ((mType == type)
+                    || (GROUP_ALL == type)
+                    || ((GROUP_NONBLOCK == type) && (ENTER != mType)));
+        }
+
+        uint64_t
+        getRequestId() const
+        {
+            return mRequestId;
+        }
+
+
+    protected:
+        void
+        set_prev_reqoffs(uint32_t offset)
+        {
+            mPrevOffset = offset;
+        }
+
+        void
+        set_next_reqoffs(uint32_t offset)
+        {
+            mNextOffset = offset;
+        }
+
+
+    private:
+        event_t  mType;
+        uint64_t mRequestId;
+
+
+    public:
+        /// Offsets set by the RequestTable
+        uint32_t mPrevOffset;
+        uint32_t mNextOffset;
+};
+}   // unnamed namespace
+
+
+//--- RequestTable tests ----------------------------------------------------
+
+TEST(RequestTableT, testRequestCompletion)
+{
+    RequestTable  table;
+    TestEvent_rep request(MPI_SEND_REQUEST, 7);
+    TestEvent_rep enter(ENTER, 7);
+    TestEvent_rep complete(MPI_SEND_COMPLETE, 7);
+
+    table.link(request, 3);
+    table.link(enter, 4);
+    table.link(complete, 10);
+
+    EXPECT_EQ(0u, request.mPrevOffset);
+    EXPECT_EQ(7u, request.mNextOffset);
+    EXPECT_EQ(7u, complete.mPrevOffset);
+    EXPECT_EQ(0u, complete.mNextOffset);
+
+    // Events unrelated to requests are ignored
+    EXPECT_EQ(0u, enter.mPrevOffset);
+    EXPECT_EQ(0u, enter.mNextOffset);
+}
+
+
+TEST(RequestTableT, testTestedRequest)
+{
+    RequestTable  table;
+    TestEvent_rep request(MPI_RECV_REQUEST, 1);
+    TestEvent_rep tested1(MPI_REQUEST_TESTED, 1);
+    TestEvent_rep tested2(MPI_REQUEST_TESTED, 1);
+    TestEvent_rep complete(MPI_RECV_COMPLETE, 1);
+
+    // Unsuccessful tests form a chain between request and completion
+    table.link(request, 0);
+    table.link(tested1, 2);
+    table.link(tested2, 5);
+    table.link(complete, 9);
+
+    EXPECT_EQ(2u, request.mNextOffset);
+    EXPECT_EQ(2u, tested1.mPrevOffset);
+    EXPECT_EQ(3u, tested1.mNextOffset);
+    EXPECT_EQ(3u, tested2.mPrevOffset);
+    EXPECT_EQ(4u, tested2.mNextOffset);
+    EXPECT_EQ(4u, complete.mPrevOffset);
+}
+
+
+TEST(RequestTableT, testInterleavedRequests)
+{
+    RequestTable  table;
+    TestEvent_rep request1(MPI_SEND_REQUEST, 1);
+    TestEvent_rep request2(MPI_RECV_REQUEST, 2);
+    TestEvent_rep complete2(MPI_RECV_COMPLETE, 2);
+    TestEvent_rep complete1(MPI_SEND_COMPLETE, 1);
+
+    table.link(request1, 0);
+    table.link(request2, 1);
+    table.link(complete2, 2);
+    table.link(complete1, 3);
+
+    EXPECT_EQ(3u, request1.mNextOffset);
+    EXPECT_EQ(3u, complete1.mPrevOffset);
+    EXPECT_EQ(1u, request2.mNextOffset);
+    EXPECT_EQ(1u, complete2.mPrevOffset);
+}
+
+
+TEST(RequestTableT, testReusedRequestId)
+{
+    RequestTable  table;
+    TestEvent_rep request1(MPI_SEND_REQUEST, 5);
+    TestEvent_rep complete1(MPI_SEND_COMPLETE, 5);
+    TestEvent_rep request2(MPI_SEND_REQUEST, 5);
+    TestEvent_rep complete2(MPI_SEND_COMPLETE, 5);
+
+    // A completed request ID may be reused by a new request
+    table.link(request1, 0);
+    table.link(complete1, 1);
+    table.link(request2, 4);
+    table.link(complete2, 6);
+
+    EXPECT_EQ(1u, complete1.mPrevOffset);
+    EXPECT_EQ(0u, complete1.mNextOffset);
+    EXPECT_EQ(0u, request2.mPrevOffset);
+    EXPECT_EQ(2u, request2.mNextOffset);
+    EXPECT_EQ(2u, complete2.mPrevOffset);
+}
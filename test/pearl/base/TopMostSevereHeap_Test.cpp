@@ -0,0 +1,149 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+#include "TopMostSevereHeap.h"
+
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace testing;
+using namespace pearl;
+using namespace scout;
+
+
+//--- Helper functions ------------------------------------------------------
+
+namespace
+{
+TopMostSevere
+instance(timestamp_t idletime,
+         ident_t     cnode,
+         ident_t     rank = 0)
+{
+    return TopMostSevere(idletime, 1.0, 2.0, cnode, rank);
+}
+}   // unnamed namespace
+
+
+//--- TopMostSevereHeap tests -----------------------------------------------
+
+TEST(TopMostSevereHeapT, testEmpty)
+{
+    TopMostSevereHeap heap;
+
+    EXPECT_TRUE(heap.empty());
+    EXPECT_EQ(0u, heap.size());
+
+    // Instances without idle time are ignored
+    heap.insert(instance(0.0, 1));
+    heap.insert(instance(-1.0, 2));
+    EXPECT_TRUE(heap.empty());
+}
+
+
+TEST(TopMostSevereHeapT, testBounded)
+{
+    TopMostSevereHeap heap;
+
+    // Insert more instances than retained, in arbitrary order
+    const timestamp_t idle[] = { 3.0, 9.0, 1.0, 7.0, 5.0, 8.0, 2.0, 6.0 };
+    const size_t      count  = sizeof(idle) / sizeof(idle[0]);
+    for (size_t i = 0; i < count; ++i) {
+        heap.insert(instance(idle[i], i));
+    }
+    ASSERT_EQ(static_cast<size_t>(TOP_SEVERE_INSTANCES), heap.size());
+
+    TopMostSevereHeap::InstanceList sorted;
+    heap.getSorted(sorted);
+    ASSERT_EQ(heap.size(), sorted.size());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        EXPECT_EQ(9.0 - i, sorted[i].idletime);
+    }
+
+    // Less severe instances are rejected once the heap is full
+    heap.insert(instance(4.0, 42));
+    heap.getSorted(sorted);
+    EXPECT_EQ(5.0, sorted.back().idletime);
+}
+
+
+TEST(TopMostSevereHeapT, testUniqueCallpaths)
+{
+    TopMostSevereHeap heap;
+
+    // Only the most severe instance of each call path is kept
+    heap.insert(instance(2.0, 1, 0));
+    heap.insert(instance(5.0, 1, 1));
+    heap.insert(instance(3.0, 1, 2));
+    heap.insert(instance(4.0, 2, 3));
+    ASSERT_EQ(2u, heap.size());
+
+    TopMostSevereHeap::InstanceList sorted;
+    heap.getSorted(sorted);
+    EXPECT_EQ(1u, sorted[0].cnode);
+    EXPECT_EQ(5.0, sorted[0].idletime);
+    EXPECT_EQ(1u, sorted[0].rank);
+    EXPECT_EQ(2u, sorted[1].cnode);
+    EXPECT_EQ(4.0, sorted[1].idletime);
+
+    // Updating the least severe instance restores the heap order
+    heap.insert(instance(6.0, 2, 4));
+    heap.getSorted(sorted);
+    EXPECT_EQ(2u, sorted[0].cnode);
+    EXPECT_EQ(4u, sorted[0].rank);
+}
+
+
+TEST(TopMostSevereHeapT, testTies)
+{
+    TopMostSevereHeap heap;
+
+    // Equal idle times are reported in order of call path identifiers
+    heap.insert(instance(1.0, 3));
+    heap.insert(instance(1.0, 1));
+    heap.insert(instance(1.0, 2));
+
+    TopMostSevereHeap::InstanceList sorted;
+    heap.getSorted(sorted);
+    ASSERT_EQ(3u, sorted.size());
+    EXPECT_EQ(1u, sorted[0].cnode);
+    EXPECT_EQ(2u, sorted[1].cnode);
+    EXPECT_EQ(3u, sorted[2].cnode);
+}
+
+
+TEST(TopMostSevereHeapT, testMerge)
+{
+    TopMostSevereHeap lhs;
+    TopMostSevereHeap rhs;
+
+    lhs.insert(instance(1.0, 1));
+    lhs.insert(instance(4.0, 2));
+    rhs.insert(instance(3.0, 1));
+    rhs.insert(instance(2.0, 2));
+    rhs.insert(instance(5.0, 3));
+
+    lhs.merge(rhs);
+    ASSERT_EQ(3u, lhs.size());
+
+    TopMostSevereHeap::InstanceList sorted;
+    lhs.getSorted(sorted);
+    EXPECT_EQ(3u, sorted[0].cnode);
+    EXPECT_EQ(2u, sorted[1].cnode);
+    EXPECT_EQ(4.0, sorted[1].idletime);
+    EXPECT_EQ(1u, sorted[2].cnode);
+    EXPECT_EQ(3.0, sorted[2].idletime);
+
+    lhs.clear();
+    EXPECT_TRUE(lhs.empty());
+}
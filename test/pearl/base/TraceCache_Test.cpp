@@ -0,0 +1,170 @@
+/****************************************************************************
+**  SCALASCA    http://www.scalasca.org/                                   **
+*****************************************************************************
+**  Copyright (c) 2016                                                     **
+**  Forschungszentrum Juelich GmbH, Juelich Supercomputing Centre          **
+**                                                                         **
+**  This software may be modified and distributed under the terms of       **
+**  a BSD-style license.  See the COPYING file in the package base         **
+**  directory for details.                                                 **
+****************************************************************************/
+
+
+#include <config.h>
+#include <pearl/pearl.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+#include <pearl/Buffer.h>
+#include <pearl/Location.h>
+
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace testing;
+using namespace pearl;
+
+
+//--- Helper classes & functions --------------------------------------------
+
+namespace
+{
+/// Cache file header values of the current format. They have to be updated
+/// whenever the cache file format changes.
+const uint32_t CACHE_MAGIC   = 0x50544331;
+const uint32_t CACHE_VERSION = 2;
+
+/// Validation stamp used by the tests
+const uint64_t STAMP = 0x0123456789abcdefULL;
+
+/// Location identifier not matching Location::UNDEFINED
+const uint64_t OTHER_LOCATION = 42;
+
+
+/// Buffer providing raw access to the serialized data
+class FileBuffer
+    : public Buffer
+{
+    public:
+        bool
+        write(const string& filename,
+              size_t        nbytes) const
+        {
+            FILE* fp = fopen(filename.c_str(), "wb");
+            if (!fp)
+                return false;
+
+            const size_t count = min(nbytes, m_size);
+            const bool   ok    = (fwrite(m_data, 1, count, fp) == count);
+
+            return (fclose(fp) == 0) && ok;
+        }
+};
+
+
+/// Test fixture writing trace cache file headers
+class TraceCacheT
+    : public Test
+{
+    protected:
+        TraceCacheT()
+            : mFilename("TraceCache_Test.cache")
+        {
+        }
+
+        virtual void
+        TearDown()
+        {
+            remove(mFilename.c_str());
+        }
+
+        /// Writes a cache file header with the given values, truncated to
+        /// @a nbytes bytes. No call tree and event data is written, as it
+        /// is not examined by PEARL_check_trace_cache().
+        void
+        writeHeader(uint32_t magic,
+                    uint32_t version,
+                    uint64_t stamp,
+                    uint64_t location,
+                    size_t   nbytes = ~static_cast<size_t>(0))
+        {
+            FileBuffer buffer;
+            buffer.put_uint32(magic);
+            buffer.put_uint32(version);
+            buffer.put_uint64(stamp);
+            buffer.put_uint64(location);
+            buffer.putTimestamp(0.0);
+            buffer.put_uint32(0);
+            buffer.put_uint32(0);
+            buffer.put_uint32(0);
+
+            ASSERT_TRUE(buffer.write(mFilename, nbytes));
+        }
+
+        bool
+        isValid(uint64_t stamp = STAMP) const
+        {
+            return PEARL_check_trace_cache(Location::UNDEFINED, mFilename,
+                                           stamp);
+        }
+
+
+        /// Name of the cache file
+        string mFilename;
+};
+}   // unnamed namespace
+
+
+//--- Trace cache tests -----------------------------------------------------
+
+TEST_F(TraceCacheT, testMissingFile)
+{
+    EXPECT_FALSE(isValid());
+}
+
+
+TEST_F(TraceCacheT, testMatchingHeader)
+{
+    writeHeader(CACHE_MAGIC, CACHE_VERSION, STAMP, Location::NO_ID);
+    EXPECT_TRUE(isValid());
+}
+
+
+TEST_F(TraceCacheT, testStampMismatch)
+{
+    // The stamp changes whenever the trace data or analysis options
+    // influencing the preprocessed trace change
+    writeHeader(CACHE_MAGIC, CACHE_VERSION, STAMP, Location::NO_ID);
+    EXPECT_FALSE(isValid(STAMP + 1));
+    EXPECT_FALSE(isValid(0));
+}
+
+
+TEST_F(TraceCacheT, testLocationMismatch)
+{
+    writeHeader(CACHE_MAGIC, CACHE_VERSION, STAMP, OTHER_LOCATION);
+    EXPECT_FALSE(isValid());
+}
+
+
+TEST_F(TraceCacheT, testFormatMismatch)
+{
+    writeHeader(CACHE_MAGIC, CACHE_VERSION + 1, STAMP, Location::NO_ID);
+    EXPECT_FALSE(isValid());
+    writeHeader(CACHE_MAGIC, CACHE_VERSION - 1, STAMP, Location::NO_ID);
+    EXPECT_FALSE(isValid());
+    writeHeader(~CACHE_MAGIC, CACHE_VERSION, STAMP, Location::NO_ID);
+    EXPECT_FALSE(isValid());
+}
+
+
+TEST_F(TraceCacheT, testTruncatedFile)
+{
+    // Byte-order marker, magic number, version, and half of the stamp
+    writeHeader(CACHE_MAGIC, CACHE_VERSION, STAMP, Location::NO_ID, 13);
+    EXPECT_FALSE(isValid());
+    writeHeader(CACHE_MAGIC, CACHE_VERSION, STAMP, Location::NO_ID, 0);
+    EXPECT_FALSE(isValid());
+}
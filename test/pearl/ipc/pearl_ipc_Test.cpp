@@ -399,3 +399,62 @@ COLLECTIVE_TESTS(float)
 COLLECTIVE_TESTS(double)
 
 #undef COLLECTIVE_TESTS
+
+
+// Combined reduction test:
+// Reduces one item per operation, where each rank contributes its rank
+// number as value and 100 + rank as location, and verifies the results.
+TEST(IpcAllreduce, testAllreduce)
+{
+    const uint32_t rank     = ipcGetRank();
+    const uint32_t numRanks = ipcGetSize();
+
+    IpcReduceItem  items[6];
+    const uint32_t operations[6] = {
+        PEARL_SUM, PEARL_MIN, PEARL_MAX, PEARL_MINLOC, PEARL_MAXLOC,
+        PEARL_MAXLOC
+    };
+    for (uint32_t i = 0; i < 6; ++i) {
+        items[i].mValue     = rank;
+        items[i].mLocation  = 100 + rank;
+        items[i].mOperation = operations[i];
+    }
+    items[5].mValue = 1.0;    // Tie => lowest location wins
+
+    ipcAllreduce(items, 6);
+    EXPECT_EQ(numRanks * (numRanks - 1) / 2.0, items[0].mValue);
+    EXPECT_EQ(0.0, items[1].mValue);
+    EXPECT_EQ(numRanks - 1.0, items[2].mValue);
+    EXPECT_EQ(0.0, items[3].mValue);
+    EXPECT_EQ(100u, items[3].mLocation);
+    EXPECT_EQ(numRanks - 1.0, items[4].mValue);
+    EXPECT_EQ(100u + numRanks - 1, items[4].mLocation);
+    EXPECT_EQ(1.0, items[5].mValue);
+    EXPECT_EQ(100u, items[5].mLocation);
+}
+
+
+//--- IPC node-level shared memory tests ------------------------------------
+
+// Shared memory test:
+// Allocates a shared segment, fills it with [0, CHUNK_SIZE-1] on the
+// initializing rank, and verifies the contents on all ranks.
+TEST(IpcSharedMemory, testAllocShared)
+{
+    bool      initialize = false;
+    uint32_t* segment    = static_cast<uint32_t*>(
+        ipcAllocShared(CHUNK_SIZE * sizeof(uint32_t), initialize));
+    ASSERT_TRUE(segment != 0);
+
+    if (initialize) {
+        for (uint32_t i = 0; i < CHUNK_SIZE; ++i) {
+            segment[i] = i;
+        }
+    }
+    ipcSyncShared(segment);
+
+    for (uint32_t i = 0; i < CHUNK_SIZE; ++i) {
+        EXPECT_EQ(i, segment[i]);
+    }
+    ipcFreeShared(segment);
+}